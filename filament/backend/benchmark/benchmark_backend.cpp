@@ -0,0 +1,390 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PlatformRunner.h"
+#include "ShaderGenerator.h"
+#include "TrianglePrimitive.h"
+
+#include <benchmark/benchmark.h>
+
+#include <backend/DriverEnums.h>
+#include <backend/Handle.h>
+#include <backend/PipelineState.h>
+#include <backend/Platform.h>
+#include <backend/Program.h>
+
+#include "private/backend/CommandBufferQueue.h"
+#include "private/backend/CommandStream.h"
+#include "private/backend/DriverApi.h"
+#include "private/backend/PlatformFactory.h"
+
+#include <getopt/getopt.h>
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <stddef.h>
+#include <stdint.h>
+
+using namespace filament;
+using namespace filament::backend;
+
+/*
+ * Measures the per-draw CPU cost of the CommandStream encoder and of the driver-side command
+ * execution, for command sequences of varying state-change frequency. Everything runs on a single
+ * thread with a headless swap chain, so the numbers isolate the submission cost from GPU work;
+ * with the noop backend they isolate the CommandStream dispatch overhead itself.
+ *
+ * The backend is selected with the same flag as the backend tests:
+ *     benchmark_backend -a [opengl|vulkan|metal|noop] [--benchmark_... flags]
+ * and defaults to noop so the benchmark can run on CI machines without a GPU.
+ */
+
+static constexpr size_t CONFIG_MIN_COMMAND_BUFFERS_SIZE = 1 * 1024 * 1024;
+static constexpr size_t CONFIG_COMMAND_BUFFERS_SIZE     = 3 * CONFIG_MIN_COMMAND_BUFFERS_SIZE;
+
+// number of draws encoded per iteration ("frame")
+static constexpr size_t DRAWS_PER_PASS = 1024;
+
+static test::Backend sBackend = test::Backend::NOOP;
+
+static const char* const triangleVs = R"(#version 450 core
+layout(location = 0) in vec4 mesh_position;
+void main() {
+    gl_Position = vec4(mesh_position.xy, 0.0, 1.0);
+#if defined(TARGET_VULKAN_ENVIRONMENT)
+    // In Vulkan, clip space is Y-down. In OpenGL and Metal, clip space is Y-up.
+    gl_Position.y = -gl_Position.y;
+#endif
+})";
+
+static const char* const triangleFs = R"(#version 450 core
+precision mediump int; precision highp float;
+layout(location = 0) out vec4 fragColor;
+void main() {
+    fragColor = vec4(1.0f);
+})";
+
+// A second fragment shader, so that the pipeline-change scenarios alternate between two
+// genuinely distinct pipelines.
+static const char* const triangleFsAlt = R"(#version 450 core
+precision mediump int; precision highp float;
+layout(location = 0) out vec4 fragColor;
+void main() {
+    fragColor = vec4(1.0f, 0.0f, 0.0f, 1.0f);
+})";
+
+static const char* const uniformFs = R"(#version 450 core
+precision mediump int; precision highp float;
+layout(location = 0) out vec4 fragColor;
+layout(binding = 0, set = 1) uniform Params {
+    highp vec4 color;
+} params;
+void main() {
+    fragColor = params.color;
+})";
+
+class BackendBenchmark : public benchmark::Fixture {
+protected:
+    void SetUp(benchmark::State&) override {
+        auto backend = static_cast<Backend>(sBackend);
+        mPlatform = PlatformFactory::create(&backend);
+        mDriver = mPlatform->createDriver(nullptr, Platform::DriverConfig{});
+        mCommandBufferQueue = std::make_unique<CommandBufferQueue>(
+                CONFIG_MIN_COMMAND_BUFFERS_SIZE, CONFIG_COMMAND_BUFFERS_SIZE, /*paused=*/false);
+        mCommandStream = std::make_unique<CommandStream>(*mDriver,
+                mCommandBufferQueue->getCircularBuffer());
+
+        auto& api = getDriverApi();
+        mSwapChain = api.createSwapChainHeadless(WIDTH, HEIGHT, 0);
+        api.makeCurrent(mSwapChain, mSwapChain);
+        mRenderTarget = api.createDefaultRenderTarget();
+
+        mTriangle = std::make_unique<test::TrianglePrimitive>(api);
+
+        test::ShaderGenerator shaderGenA(triangleVs, triangleFs, sBackend, /*isMobile=*/false);
+        Program pa = shaderGenA.getProgram(api);
+        mProgramA = api.createProgram(std::move(pa));
+
+        test::ShaderGenerator shaderGenB(triangleVs, triangleFsAlt, sBackend, /*isMobile=*/false);
+        Program pb = shaderGenB.getProgram(api);
+        mProgramB = api.createProgram(std::move(pb));
+
+        // a program consuming one uniform-buffer descriptor, for the descriptor-churn scenario
+        filamat::DescriptorSets descriptors;
+        descriptors[1] = { { "Params",
+                { DescriptorType::UNIFORM_BUFFER, ShaderStageFlags::FRAGMENT, 0 }, {} } };
+        test::ShaderGenerator shaderGenU(triangleVs, uniformFs, sBackend, /*isMobile=*/false,
+                std::move(descriptors));
+        Program pu = shaderGenU.getProgram(api);
+        pu.descriptorBindings(1, {{ "Params", DescriptorType::UNIFORM_BUFFER, 0 }});
+        mProgramUniform = api.createProgram(std::move(pu));
+
+        mDescriptorSetLayout = api.createDescriptorSetLayout({
+                {{
+                         DescriptorType::UNIFORM_BUFFER,
+                         ShaderStageFlags::ALL_SHADER_STAGE_FLAGS, 0,
+                         DescriptorFlags::NONE, 0
+                 }}});
+
+        mUniformBuffer = api.createBufferObject(sizeof(float) * 4,
+                BufferObjectBinding::UNIFORM, BufferUsage::STATIC);
+
+        // two identical sets, alternated per draw to defeat redundant-bind elision
+        for (auto& set : mDescriptorSets) {
+            set = api.createDescriptorSet(mDescriptorSetLayout);
+            api.updateDescriptorSetBuffer(set, 0, mUniformBuffer, 0, sizeof(float) * 4);
+        }
+
+        mParams = {};
+        mParams.viewport = { 0, 0, WIDTH, HEIGHT };
+        mParams.flags.clear = TargetBufferFlags::COLOR;
+        mParams.clearColor = { 0.f, 0.f, 1.f, 1.f };
+        mParams.flags.discardStart = TargetBufferFlags::ALL;
+        mParams.flags.discardEnd = TargetBufferFlags::NONE;
+
+        executeCommands();
+    }
+
+    void TearDown(benchmark::State&) override {
+        auto& api = getDriverApi();
+        for (auto& set : mDescriptorSets) {
+            api.destroyDescriptorSet(set);
+        }
+        api.destroyDescriptorSetLayout(mDescriptorSetLayout);
+        api.destroyBufferObject(mUniformBuffer);
+        api.destroyProgram(mProgramUniform);
+        api.destroyProgram(mProgramB);
+        api.destroyProgram(mProgramA);
+        mTriangle.reset();
+        api.destroyRenderTarget(mRenderTarget);
+        api.destroySwapChain(mSwapChain);
+        api.finish();
+        executeCommands();
+        mDriver->purge();
+
+        mCommandStream.reset();
+        mCommandBufferQueue.reset();
+        mDriver->terminate();
+        delete mDriver;
+        PlatformFactory::destroy(&mPlatform);
+    }
+
+    DriverApi& getDriverApi() noexcept {
+        return *mCommandStream;
+    }
+
+    // flushes the CommandStream and executes the commands on this thread, as FEngine's driver
+    // loop would
+    void executeCommands() {
+        mCommandBufferQueue->flush();
+        auto buffers = mCommandBufferQueue->waitForCommands();
+        for (auto& item : buffers) {
+            if (UTILS_LIKELY(item.begin)) {
+                getDriverApi().execute(item.begin);
+                mCommandBufferQueue->releaseBuffer(item);
+            }
+        }
+    }
+
+    PipelineState makePipelineState(Handle<HwProgram> program) const noexcept {
+        PipelineState state;
+        state.program = program;
+        state.vertexBufferInfo = mTriangle->getVertexBufferInfo();
+        state.rasterState.colorWrite = true;
+        state.rasterState.depthWrite = false;
+        state.rasterState.depthFunc = RasterState::DepthFunc::A;
+        state.rasterState.culling = CullingMode::NONE;
+        return state;
+    }
+
+    static constexpr uint32_t WIDTH = 256;
+    static constexpr uint32_t HEIGHT = 256;
+
+    Platform* mPlatform = nullptr;
+    Driver* mDriver = nullptr;
+    std::unique_ptr<CommandBufferQueue> mCommandBufferQueue;
+    std::unique_ptr<CommandStream> mCommandStream;
+    std::unique_ptr<test::TrianglePrimitive> mTriangle;
+
+    Handle<HwSwapChain> mSwapChain;
+    Handle<HwRenderTarget> mRenderTarget;
+    Handle<HwProgram> mProgramA;
+    Handle<HwProgram> mProgramB;
+    Handle<HwProgram> mProgramUniform;
+    Handle<HwDescriptorSetLayout> mDescriptorSetLayout;
+    Handle<HwDescriptorSet> mDescriptorSets[2];
+    Handle<HwBufferObject> mUniformBuffer;
+    RenderPassParams mParams;
+};
+
+// Encodes and executes one render pass of DRAWS_PER_PASS draws, rebinding the pipeline every
+// range(0) draws (alternating between two pipelines). range(0) == DRAWS_PER_PASS is the
+// steady-state lower bound: one pipeline bind per pass.
+BENCHMARK_DEFINE_F(BackendBenchmark, pipelineChange)(benchmark::State& state) {
+    size_t const drawsPerPipeline = state.range(0);
+    auto& api = getDriverApi();
+    PipelineState const pipelineA = makePipelineState(mProgramA);
+    PipelineState const pipelineB = makePipelineState(mProgramB);
+    auto const rph = mTriangle->getRenderPrimitive();
+    for (auto _ : state) {
+        api.makeCurrent(mSwapChain, mSwapChain);
+        api.beginRenderPass(mRenderTarget, mParams);
+        api.bindRenderPrimitive(rph);
+        bool alt = false;
+        for (size_t i = 0; i < DRAWS_PER_PASS; i++) {
+            if (i % drawsPerPipeline == 0) {
+                api.bindPipeline(alt ? pipelineB : pipelineA);
+                alt = !alt;
+            }
+            api.draw2(0, 3, 1);
+        }
+        api.endRenderPass();
+        api.commit(mSwapChain);
+        executeCommands();
+    }
+    state.SetItemsProcessed(state.iterations() * DRAWS_PER_PASS);
+}
+
+// Same as pipelineChange, but the encoding is timed and the driver-side execution is not, to
+// separate the producer-side CommandStream cost from the driver cost.
+BENCHMARK_DEFINE_F(BackendBenchmark, pipelineChangeEncodeOnly)(benchmark::State& state) {
+    size_t const drawsPerPipeline = state.range(0);
+    auto& api = getDriverApi();
+    PipelineState const pipelineA = makePipelineState(mProgramA);
+    PipelineState const pipelineB = makePipelineState(mProgramB);
+    auto const rph = mTriangle->getRenderPrimitive();
+    for (auto _ : state) {
+        api.makeCurrent(mSwapChain, mSwapChain);
+        api.beginRenderPass(mRenderTarget, mParams);
+        api.bindRenderPrimitive(rph);
+        bool alt = false;
+        for (size_t i = 0; i < DRAWS_PER_PASS; i++) {
+            if (i % drawsPerPipeline == 0) {
+                api.bindPipeline(alt ? pipelineB : pipelineA);
+                alt = !alt;
+            }
+            api.draw2(0, 3, 1);
+        }
+        api.endRenderPass();
+        api.commit(mSwapChain);
+        state.PauseTiming();
+        executeCommands();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * DRAWS_PER_PASS);
+}
+
+// One pipeline for the whole pass, but the scissor rectangle changes every range(0) draws.
+// Scissor is the cheapest piece of dynamic state, so this bounds the cost of any per-draw
+// dynamic state change.
+BENCHMARK_DEFINE_F(BackendBenchmark, scissorChange)(benchmark::State& state) {
+    size_t const drawsPerScissor = state.range(0);
+    auto& api = getDriverApi();
+    PipelineState const pipeline = makePipelineState(mProgramA);
+    auto const rph = mTriangle->getRenderPrimitive();
+    for (auto _ : state) {
+        api.makeCurrent(mSwapChain, mSwapChain);
+        api.beginRenderPass(mRenderTarget, mParams);
+        api.bindPipeline(pipeline);
+        api.bindRenderPrimitive(rph);
+        bool alt = false;
+        for (size_t i = 0; i < DRAWS_PER_PASS; i++) {
+            if (i % drawsPerScissor == 0) {
+                api.scissor(alt ? Viewport{ 0, 0, WIDTH / 2, HEIGHT / 2 }
+                                : Viewport{ 0, 0, WIDTH, HEIGHT });
+                alt = !alt;
+            }
+            api.draw2(0, 3, 1);
+        }
+        api.endRenderPass();
+        api.commit(mSwapChain);
+        executeCommands();
+    }
+    state.SetItemsProcessed(state.iterations() * DRAWS_PER_PASS);
+}
+
+// The renderer's hot loop: a fused descriptor-set bind + draw per draw call, alternating between
+// two sets so the backend can't elide the rebind.
+BENCHMARK_DEFINE_F(BackendBenchmark, descriptorSetChange)(benchmark::State& state) {
+    auto& api = getDriverApi();
+    PipelineState pipeline = makePipelineState(mProgramUniform);
+    pipeline.pipelineLayout.setLayout[1] = { mDescriptorSetLayout };
+    auto const rph = mTriangle->getRenderPrimitive();
+    for (auto _ : state) {
+        api.makeCurrent(mSwapChain, mSwapChain);
+        api.beginRenderPass(mRenderTarget, mParams);
+        api.bindPipeline(pipeline);
+        api.bindRenderPrimitive(rph);
+        for (size_t i = 0; i < DRAWS_PER_PASS; i++) {
+            api.bindDescriptorSetAndDraw(mDescriptorSets[i & 1u], 1, {}, 0, 3, 1);
+        }
+        api.endRenderPass();
+        api.commit(mSwapChain);
+        executeCommands();
+    }
+    state.SetItemsProcessed(state.iterations() * DRAWS_PER_PASS);
+}
+
+BENCHMARK_REGISTER_F(BackendBenchmark, pipelineChange)
+        ->Arg(1)->Arg(16)->Arg(DRAWS_PER_PASS);
+BENCHMARK_REGISTER_F(BackendBenchmark, pipelineChangeEncodeOnly)
+        ->Arg(1)->Arg(DRAWS_PER_PASS);
+BENCHMARK_REGISTER_F(BackendBenchmark, scissorChange)
+        ->Arg(1)->Arg(16)->Arg(DRAWS_PER_PASS);
+BENCHMARK_REGISTER_F(BackendBenchmark, descriptorSetChange);
+
+int main(int argc, char* argv[]) {
+    // Mirrors test/Arguments.cpp, with "noop" added; the silent-error ':' prefix lets the
+    // google-benchmark flags pass through getopt untouched.
+    static constexpr const char* OPTSTR = ":a:";
+    static const struct option OPTIONS[] = {
+            { "api", required_argument, nullptr, 'a' },
+            { nullptr, 0, nullptr, 0 }
+    };
+    int opt;
+    int optionIndex = 0;
+    while ((opt = getopt_long(argc, argv, OPTSTR, OPTIONS, &optionIndex)) >= 0) {
+        std::string arg(optarg ? optarg : "");
+        switch (opt) {
+            case 'a':
+                if (arg == "opengl") {
+                    sBackend = test::Backend::OPENGL;
+                } else if (arg == "vulkan") {
+                    sBackend = test::Backend::VULKAN;
+                } else if (arg == "metal") {
+                    sBackend = test::Backend::METAL;
+                } else if (arg == "noop") {
+                    sBackend = test::Backend::NOOP;
+                } else {
+                    std::cerr << "Unrecognized target API. "
+                                 "Must be 'opengl'|'vulkan'|'metal'|'noop'." << std::endl;
+                    return 1;
+                }
+                break;
+        }
+    }
+
+    test::ShaderGenerator::init();
+
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+
+    test::ShaderGenerator::shutdown();
+    return 0;
+}
@@ -96,6 +96,41 @@ static constexpr uint64_t SWAP_CHAIN_HAS_STENCIL_BUFFER         = SWAP_CHAIN_CON
  */
 static constexpr uint64_t SWAP_CHAIN_CONFIG_PROTECTED_CONTENT   = 0x40;
 
+/**
+ * The headless SwapChain is backed by an image that can be exported as an OS-native sharable
+ * handle, so frames can be consumed zero-copy by another API or device on the same machine
+ * (typically a hardware video encoder), without going through readPixels().
+ *
+ * Currently only supported by PlatformEGL, which backs the SwapChain with an EGLImage and
+ * exports it as a dmabuf, see PlatformEGL::exportSwapChainImage(). On Metal, pass a
+ * CVPixelBuffer (IOSurface-backed) via SWAP_CHAIN_CONFIG_APPLE_CVPIXELBUFFER instead.
+ * Ignored by platforms without an export path.
+ */
+static constexpr uint64_t SWAP_CHAIN_CONFIG_EXPORTABLE_IMAGE    = 0x80;
+
+/**
+ * The SwapChain's frame-latency policy, encoded as a 2-bit field: how many frames may be
+ * in flight before Renderer::beginFrame() throttles. 0 means "engine default" (currently 2),
+ * 1 gives the lowest input latency at the cost of CPU / GPU overlap, 3 fully pipelines the
+ * main thread, the driver thread and the GPU. Backends additionally use the policy to size
+ * their image / drawable pools where the platform allows it.
+ */
+static constexpr uint64_t SWAP_CHAIN_CONFIG_FRAME_LATENCY_SHIFT = 8;
+static constexpr uint64_t SWAP_CHAIN_CONFIG_FRAME_LATENCY_MASK  =
+        0x3ull << SWAP_CHAIN_CONFIG_FRAME_LATENCY_SHIFT;
+
+//! encodes a frame-latency policy into SwapChain configuration flags
+constexpr uint64_t swapChainConfigFrameLatency(uint64_t latency) noexcept {
+    return (latency << SWAP_CHAIN_CONFIG_FRAME_LATENCY_SHIFT)
+            & SWAP_CHAIN_CONFIG_FRAME_LATENCY_MASK;
+}
+
+//! decodes the frame-latency policy from SwapChain configuration flags, 0 if unset
+constexpr size_t getSwapChainConfigFrameLatency(uint64_t flags) noexcept {
+    return size_t((flags & SWAP_CHAIN_CONFIG_FRAME_LATENCY_MASK)
+            >> SWAP_CHAIN_CONFIG_FRAME_LATENCY_SHIFT);
+}
+
 static constexpr size_t MAX_VERTEX_ATTRIBUTE_COUNT  = 16;   // This is guaranteed by OpenGL ES.
 static constexpr size_t MAX_SAMPLER_COUNT           = 62;   // Maximum needed at feature level 3.
 static constexpr size_t MAX_VERTEX_BUFFER_COUNT     = 16;   // Max number of bound buffer objects.
@@ -232,7 +267,11 @@ enum class DescriptorType : uint8_t {
 
 enum class DescriptorFlags : uint8_t {
     NONE = 0x00,
-    DYNAMIC_OFFSET = 0x01
+    DYNAMIC_OFFSET = 0x01,
+    // The sampler parameters of this SAMPLER binding are fixed and given by
+    // DescriptorSetLayoutBinding::immutableSamplerParams. Backends that support it (e.g. Vulkan)
+    // bake the sampler into the set layout, shrinking descriptor updates on that binding.
+    IMMUTABLE_SAMPLER = 0x02
 };
 
 using descriptor_set_t = uint8_t;
@@ -246,15 +285,28 @@ struct DescriptorSetLayoutBinding {
     DescriptorFlags flags = DescriptorFlags::NONE;
     uint16_t count = 0;
 
+    // Keeps the struct free of implicit padding; layouts are hashed as raw bytes (see
+    // HwDescriptorSetLayoutFactory and MaterialDescriptorSetLayoutChunk). Must be 0.
+    uint16_t reserved = 0;
+
+    // Raw 32-bit encoding of the SamplerParams baked into this binding. Only meaningful when
+    // DescriptorFlags::IMMUTABLE_SAMPLER is set (the default, 0, encodes SamplerParams{}).
+    // SamplerParams is declared further down in this header, so the raw encoding is used here;
+    // see samplerParamsToRaw() / samplerParamsFromRaw().
+    uint32_t immutableSamplerParams = 0;
+
     friend inline bool operator==(
             DescriptorSetLayoutBinding const& lhs,
             DescriptorSetLayoutBinding const& rhs) noexcept {
         return lhs.type == rhs.type &&
                lhs.flags == rhs.flags &&
                lhs.count == rhs.count &&
-               lhs.stageFlags == rhs.stageFlags;
+               lhs.stageFlags == rhs.stageFlags &&
+               lhs.immutableSamplerParams == rhs.immutableSamplerParams;
     }
 };
+static_assert(sizeof(DescriptorSetLayoutBinding) == 12,
+        "DescriptorSetLayoutBinding must not contain implicit padding, it is hashed as raw bytes");
 
 struct DescriptorSetLayout {
     utils::FixedCapacityVector<DescriptorSetLayoutBinding> bindings;
@@ -501,7 +553,21 @@ enum class ElementType : uint8_t {
 enum class BufferObjectBinding : uint8_t {
     VERTEX,
     UNIFORM,
-    SHADER_STORAGE
+    SHADER_STORAGE,
+    INDIRECT        //!< holds DrawIndexedIndirectCommand entries, see drawIndexedIndirect()
+};
+
+/**
+ * A single entry of an indirect draw buffer, see DriverApi::drawIndexedIndirect().
+ * The layout matches VkDrawIndexedIndirectCommand, MTLDrawIndexedPrimitivesIndirectArguments and
+ * OpenGL's DrawElementsIndirectCommand, so the same buffer content works on all backends.
+ */
+struct DrawIndexedIndirectCommand {
+    uint32_t indexCount;
+    uint32_t instanceCount;
+    uint32_t firstIndex;
+    int32_t vertexOffset;
+    uint32_t firstInstance;     //!< must be 0 on OpenGL ES
 };
 
 //! Face culling Mode
@@ -544,6 +610,24 @@ enum class PixelDataType : uint8_t {
     UINT_2_10_10_10_REV,  //!< unsigned normalized 10 bits RGB, 2 bits alpha
 };
 
+/**
+ * A sub-region of a texture updated by a batched image upload. All regions of a batch share a
+ * single PixelBufferDescriptor; each region's texels start at \p bufferOffset bytes into it and
+ * are tightly packed (stride == width).
+ *
+ * @see Texture::setImages()
+ */
+struct TextureUpdateRegion {
+    uint32_t level;         //!< mip level to update
+    uint32_t xoffset;       //!< left offset of the sub-region
+    uint32_t yoffset;       //!< bottom offset of the sub-region
+    uint32_t zoffset;       //!< depth offset, or first layer/face for array/cubemap textures
+    uint32_t width;         //!< width of the sub-region
+    uint32_t height;        //!< height of the sub-region
+    uint32_t depth;         //!< depth, or number of layers/faces for array/cubemap textures
+    uint32_t bufferOffset;  //!< byte offset of the region's texels in the shared buffer
+};
+
 //! Compressed pixel data types
 enum class CompressedPixelDataType : uint16_t {
     // Mandatory in GLES 3.0 and GL 4.3
@@ -777,6 +861,7 @@ enum class TextureUsage : uint16_t {
     BLIT_SRC            = 0x0040,            //!< Texture can be used the source of a blit()
     BLIT_DST            = 0x0080,            //!< Texture can be used the destination of a blit()
     PROTECTED           = 0x0100,            //!< Texture can be used for protected content
+    TRANSIENT_ATTACHMENT= 0x0200,            //!< Texture contents don't outlive a render pass, backends may use tile-only (memoryless) storage
     DEFAULT             = UPLOADABLE | SAMPLEABLE,   //!< Default texture usage
     ALL_ATTACHMENTS     = COLOR_ATTACHMENT | DEPTH_ATTACHMENT | STENCIL_ATTACHMENT | SUBPASS_INPUT,   //!< Mask of all attachments
 };
@@ -793,6 +878,7 @@ inline const char* stringify(TextureUsage usage) {
         case TextureUsage::BLIT_SRC: return "BLIT_SRC";
         case TextureUsage::BLIT_DST: return "BLIT_DST";
         case TextureUsage::PROTECTED: return "PROTECTED";
+        case TextureUsage::TRANSIENT_ATTACHMENT: return "TRANSIENT_ATTACHMENT";
         case TextureUsage::DEFAULT: return "DEFAULT";
         default: return "UNKNOWN";
     }
@@ -1027,6 +1113,19 @@ static_assert(sizeof(SamplerParams) == 4);
 static_assert(sizeof(SamplerParams) <= sizeof(uint64_t),
         "SamplerParams must be no more than 64 bits");
 
+//! Raw 32-bit encoding of SamplerParams, for places where SamplerParams is not yet declared
+//! (e.g. DescriptorSetLayoutBinding::immutableSamplerParams).
+inline uint32_t samplerParamsToRaw(SamplerParams params) noexcept {
+    return *reinterpret_cast<uint32_t const*>(reinterpret_cast<char const*>(&params));
+}
+
+//! Decodes a raw 32-bit encoding produced by samplerParamsToRaw().
+inline SamplerParams samplerParamsFromRaw(uint32_t rawParams) noexcept {
+    SamplerParams params = {};
+    *reinterpret_cast<uint32_t*>(reinterpret_cast<char*>(&params)) = rawParams;
+    return params;
+}
+
 //! blending equation function
 enum class BlendEquation : uint8_t {
     ADD,                    //!< the fragment is added to the color buffer
@@ -1322,6 +1421,22 @@ static_assert(sizeof(StencilState) == 12u,
 
 using FrameScheduledCallback = utils::Invocable<void(backend::PresentCallable)>;
 
+//! Occupancy of the backend's handle arena, see DriverApi::getHandleAllocatorStats()
+struct HandleAllocatorStats {
+    struct Pool {
+        uint32_t handleSize;    //!< size in bytes of the handles this pool holds
+        uint32_t capacity;      //!< total number of handles this pool can hold
+        uint32_t used;          //!< number of handles currently allocated from this pool
+        uint32_t watermark;     //!< largest number of handles ever allocated from this pool
+    };
+    //! per size-class pools, ordered by increasing handle size
+    Pool pools[3] = {};
+    //! number of heap (slow path) handles currently allocated
+    uint32_t overflowUsed = 0;
+    //! total heap allocations since startup; non-zero means a pool has run out of space
+    uint32_t overflowTotal = 0;
+};
+
 enum class Workaround : uint16_t {
     // The EASU pass must split because shader compiler flattens early-exit branch
     SPLIT_EASU,
@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_FILAMENT_BACKEND_FILEBLOBCACHE_H
+#define TNT_FILAMENT_BACKEND_FILEBLOBCACHE_H
+
+#include <utils/compiler.h>
+#include <utils/CString.h>
+#include <utils/Mutex.h>
+
+#include <memory>
+#include <vector>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace filament::backend {
+
+class Platform;
+
+/**
+ * A warm-start snapshot for the Platform blob cache, stored in a single mappable file.
+ *
+ * Backends use Platform::insertBlob() / Platform::retrieveBlob() to cache compiled program
+ * binaries (see OpenGLBlobCache). FileBlobCache persists that cache across runs, so programs --
+ * including the default material variants compiled during Engine::create() -- are restored from
+ * disk instead of recompiled, which dominates cold start on slow devices.
+ *
+ * Usage:
+ * ~~~~{.cpp}
+ * FileBlobCache cache("/path/to/app/cache/filament.blob");
+ * cache.load();                    // maps the snapshot, if one exists
+ * Platform* platform = ...;        // the Platform passed to Engine::Builder::platform()
+ * cache.bind(platform);
+ * Engine* engine = Engine::Builder().platform(platform).build();
+ * ...
+ * Engine::destroy(&engine);
+ * cache.save();                    // persists blobs inserted during this run
+ * ~~~~
+ *
+ * The insert/retrieve hooks installed by bind() are thread-safe, as required by
+ * Platform::setBlobFunc(). Retrievals are served directly out of the file mapping without
+ * copying the whole cache; blobs inserted during the run are kept in memory until save(),
+ * which atomically rewrites the snapshot.
+ *
+ * A single cache can be bound to several Platforms, which shares compiled programs across all
+ * Engines in the process: the first Engine to compile a program inserts it, every other Engine
+ * retrieves the binary instead of invoking the compiler. This is the recommended setup for
+ * processes running many Engines concurrently (e.g. offscreen render farms), where each Engine
+ * would otherwise recompile the same default material variants and app programs:
+ * ~~~~{.cpp}
+ * FileBlobCache cache;             // in-memory; pass a path to also persist across runs
+ * for (size_t i = 0; i < engineCount; i++) {
+ *     Platform* platform = ...;    // one Platform per Engine
+ *     cache.bind(platform);
+ *     engines[i] = Engine::Builder().platform(platform).build();
+ * }
+ * ~~~~
+ * Note that sharing GPU memory (as opposed to compilation work) between Engines additionally
+ * requires the backend contexts themselves to be shared, see Engine::Builder::sharedContext().
+ */
+class UTILS_PUBLIC FileBlobCache {
+public:
+    /**
+     * Creates an in-memory cache: load() and save() are no-ops, blobs are only shared between
+     * the Platforms this cache is bound to, for the lifetime of the cache.
+     */
+    FileBlobCache() noexcept;
+
+    explicit FileBlobCache(utils::CString path) noexcept;
+    ~FileBlobCache() noexcept;
+
+    FileBlobCache(FileBlobCache const&) = delete;
+    FileBlobCache& operator=(FileBlobCache const&) = delete;
+
+    /**
+     * Maps the snapshot file into memory and indexes its entries.
+     * @return false if the file doesn't exist or doesn't hold a valid snapshot, in which case
+     *         the cache simply starts out empty.
+     */
+    bool load() noexcept;
+
+    /**
+     * Installs this cache's insert/retrieve functions on \p platform. Must be called before the
+     * Platform is used to create a Driver (i.e. before Engine::create()).
+     */
+    void bind(Platform* UTILS_NONNULL platform) noexcept;
+
+    /**
+     * Atomically rewrites the snapshot file if any blob was inserted or replaced since load().
+     * Must not be called while the engine is running, as backends may insert blobs from the
+     * driver thread.
+     * @return false if the file couldn't be written.
+     */
+    bool save() noexcept;
+
+    /**
+     * Number of blobs currently held, mapped and in-memory combined.
+     */
+    size_t getEntryCount() const noexcept;
+
+private:
+    // a view on a blob, pointing either into the file mapping or into a heap copy
+    struct Entry {
+        void const* key;
+        void const* value;
+        uint32_t keySize;
+        uint32_t valueSize;
+    };
+
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t entryCount;
+        uint32_t reserved;
+    };
+
+    static constexpr uint32_t MAGIC = 'F' | ('B' << 8) | ('L' << 16) | ('B' << 24);
+    static constexpr uint32_t VERSION = 1;
+
+    // these implement Platform::InsertBlobFunc / Platform::RetrieveBlobFunc
+    void insert(void const* key, size_t keySize, void const* value, size_t valueSize);
+    size_t retrieve(void const* key, size_t keySize, void* value, size_t valueSize) const;
+
+    // mLock must be held
+    Entry* find(void const* key, size_t keySize) noexcept;
+    Entry const* find(void const* key, size_t keySize) const noexcept;
+
+    void unload() noexcept;
+
+    utils::CString mPath;
+    void* mMapping = nullptr;
+    size_t mMappingSize = 0;
+    bool mMapped = false;       // whether mMapping came from mmap() or malloc()
+    bool mDirty = false;
+
+    mutable utils::Mutex mLock;
+    // entry counts are small (one blob per compiled program), a linear scan is fine
+    std::vector<Entry> mEntries;
+    // owns the storage of entries added or replaced since load()
+    std::vector<std::unique_ptr<char[]>> mHeapBlobs;
+};
+
+} // namespace filament::backend
+
+#endif // TNT_FILAMENT_BACKEND_FILEBLOBCACHE_H
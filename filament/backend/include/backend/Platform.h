@@ -22,6 +22,8 @@
 #include <utils/compiler.h>
 #include <utils/Invocable.h>
 
+#include <array>
+
 #include <stddef.h>
 #include <stdint.h>
 
@@ -68,8 +70,22 @@ public:
          */
         size_t handleArenaSize = 0;
 
+        /**
+         * Relative weights of the handle arena's three size-class pools, ordered by increasing
+         * handle size. By default each pool holds the same number of handles; workloads that are
+         * heavy on one size class can skew the split. A weight of 0 is treated as 1.
+         */
+        std::array<uint8_t, 3> handleArenaPoolWeights = { 1, 1, 1 };
+
         size_t metalUploadBufferSizeBytes = 512 * 1024;
 
+        /**
+         * Number of bytes of free staging memory the Vulkan backend keeps pooled between
+         * frames. 0 tracks a decaying high-water mark of recent staging demand instead.
+         * Only honored by the Vulkan backend.
+         */
+        size_t vulkanStagingRetentionBytes = 0;
+
         /**
          * Set to `true` to forcibly disable parallel shader compilation in the backend.
          * Currently only honored by the GL and Metal backends.
@@ -81,6 +97,14 @@ public:
          */
         bool disableHandleUseAfterFreeCheck = false;
 
+        /**
+         * Enable the backend handle sanitizer: freed handle slots are quarantined instead of
+         * being recycled immediately, so stale handles reliably trip the use-after-free check
+         * (which this implies) instead of silently aliasing a newly allocated object. Meant for
+         * internal/dogfood builds; costs a small amount of handle arena head-room.
+         */
+        bool enableHandleSanitizer = false;
+
         /**
          * Force GLES2 context if supported, or pretend the context is ES2. Only meaningful on
          * GLES 3.x backends.
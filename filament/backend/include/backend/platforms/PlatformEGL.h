@@ -47,6 +47,41 @@ public:
     // Return true if we're on an OpenGL platform (as opposed to OpenGL ES). false by default.
     virtual bool isOpenGL() const noexcept;
 
+    /**
+     * A dmabuf export of the image backing an exportable headless SwapChain (see
+     * SWAP_CHAIN_CONFIG_EXPORTABLE_IMAGE), suitable for zero-copy import into another API or
+     * device on the same machine, e.g. a hardware video encoder through VA-API or a Vulkan
+     * instance through VK_EXT_external_memory_dma_buf. Single-plane images only.
+     */
+    struct ExportedSharedImage {
+        int fd = -1;            //!< dmabuf file descriptor, ownership transfers to the caller
+        uint32_t fourcc = 0;    //!< DRM format (fourcc) of the backing image
+        uint64_t modifier = 0;  //!< DRM format modifier
+        int stride = 0;         //!< row stride of the plane, in bytes
+        int offset = 0;         //!< offset of the plane, in bytes
+    };
+
+    /**
+     * Whether SWAP_CHAIN_CONFIG_EXPORTABLE_IMAGE SwapChains can be created. Requires
+     * EGL_KHR_gl_renderbuffer_image and EGL_MESA_image_dma_buf_export. Can only be called
+     * once the driver has been created.
+     */
+    bool isExportableSwapChainSupported() const noexcept;
+
+    /**
+     * Exports the image backing an exportable headless SwapChain as a dmabuf. The SwapChain
+     * renders into a single persistent image, so one export is valid for the SwapChain's whole
+     * lifetime; per-frame synchronization is the dmabuf's implicit fencing, frames are complete
+     * when the SwapChain is committed. Applications get hold of the Platform::SwapChain pointer
+     * by overriding createSwapChain() in a PlatformEGL subclass passed to
+     * Engine::Builder::platform().
+     *
+     * @param swapChain a SwapChain created with SWAP_CHAIN_CONFIG_EXPORTABLE_IMAGE
+     * @param outImage  set on success; the caller owns the returned fd
+     * @return true on success
+     */
+    bool exportSwapChainImage(SwapChain* swapChain, ExportedSharedImage* outImage) noexcept;
+
 protected:
     // --------------------------------------------------------------------------------------------
     // Helper for EGL configs and attributes parameters
@@ -172,9 +207,11 @@ protected:
             bool ANDROID_recordable = false;
             bool KHR_create_context = false;
             bool KHR_gl_colorspace = false;
+            bool KHR_gl_renderbuffer_image = false;
             bool KHR_no_config_context = false;
             bool KHR_surfaceless_context = false;
             bool EXT_protected_content = false;
+            bool MESA_image_dma_buf_export = false;
         } egl;
     } ext;
 
@@ -184,13 +221,27 @@ protected:
         EGLNativeWindowType nativeWindow{};
         EGLConfig config{};
         uint64_t flags{};
+        // Only set for SWAP_CHAIN_CONFIG_EXPORTABLE_IMAGE SwapChains, which render into a GL
+        // renderbuffer wrapped in an EGLImage instead of an EGL surface.
+        EGLImageKHR image = EGL_NO_IMAGE_KHR;
+        uint32_t fbo = 0;
+        uint32_t rbo = 0;
+        uint32_t depthRbo = 0;
     };
 
+    // the exportable image path uses an FBO instead of the EGL surface's default framebuffer
+    uint32_t getDefaultFramebufferObject() noexcept override;
+
     void initializeGlExtensions() noexcept;
 
 protected:
     EGLConfig findSwapChainConfig(uint64_t flags, bool window, bool pbuffer) const;
 
+private:
+    SwapChain* createExportableSwapChain(uint32_t width, uint32_t height, uint64_t flags) noexcept;
+    void destroyExportableSwapChain(SwapChainEGL const* sc) noexcept;
+    SwapChainEGL const* mCurrentDrawSwapChain = nullptr;
+
 private:
     class EGL {
         EGLDisplay& mEGLDisplay;
@@ -19,6 +19,8 @@
 
 #include <utils/debug.h>
 
+#include <vector>
+
 #include <stddef.h>
 #include <stdint.h>
 
@@ -42,9 +44,19 @@ public:
 
     static size_t getBlockSize() noexcept { return sPageSize; }
 
-    // Total size of circular buffer. This is a constant.
+    // Total size of circular buffer. This can only change through grow().
     size_t size() const noexcept { return mSize; }
 
+    // Replaces the backing storage with a fresh one of `newSize` bytes. The buffer must be
+    // empty, i.e. this must be called right after getBuffer(). The old storage -- which
+    // ranges previously returned by getBuffer() may still point into -- is kept alive until
+    // freeOldestRetiredStorage() is called.
+    void grow(size_t newSize) noexcept;
+
+    // Frees the oldest storage retired by grow(). The caller must guarantee that no range
+    // pointing into it is still in use.
+    void freeOldestRetiredStorage() noexcept;
+
     // Allocates `s` bytes in the circular buffer and returns a pointer to the memory. All
     // allocations must not exceed size() bytes.
     inline void* allocate(size_t s) noexcept {
@@ -72,15 +84,21 @@ public:
     Range getBuffer() noexcept;
 
 private:
+    struct Storage {
+        void* data = nullptr;
+        size_t size = 0;
+        int ashmemFd = -1;
+    };
+
     void* alloc(size_t size) noexcept;
-    void dealloc() noexcept;
+    void dealloc(Storage storage) noexcept;
 
-    // pointer to the beginning of the circular buffer (constant)
+    // pointer to the beginning of the circular buffer
     void* mData = nullptr;
     int mAshmemFd = -1;
 
-    // size of the circular buffer (constant)
-    size_t const mSize;
+    // size of the circular buffer
+    size_t mSize;
 
     // pointer to the beginning of recorded data
     void* mTail = nullptr;
@@ -88,6 +106,9 @@ private:
     // pointer to the next available command
     void* mHead = nullptr;
 
+    // storages retired by grow(), oldest first, awaiting release by the driver
+    std::vector<Storage> mRetiredStorages;
+
     // system page size
     static size_t sPageSize;
 };
@@ -22,6 +22,7 @@
 #include <utils/Condition.h>
 #include <utils/Mutex.h>
 
+#include <chrono>
 #include <vector>
 
 #include <stddef.h>
@@ -40,6 +41,9 @@ class CommandBufferQueue {
 
     const size_t mRequiredSize;
 
+    // the buffer stops growing once it has reached this size; flush() blocks instead
+    const size_t mMaxBufferSize;
+
     CircularBuffer mCircularBuffer;
 
     // space available in the circular buffer
@@ -49,9 +53,24 @@ class CommandBufferQueue {
     mutable std::vector<Range> mCommandBuffersToExecute;
     size_t mFreeSpace = 0;
     size_t mHighWatermark = 0;
+    size_t mFrameHighWatermark = 0;
+    // ranges returned by flush() and not yet returned through releaseBuffer()
+    size_t mOutstandingRanges = 0;
+    // unreleased range counts of the storages retired by CircularBuffer::grow(), oldest first
+    std::vector<size_t> mRetiredEpochs;
+    uint32_t mGrowthCount = 0;
     uint32_t mExitRequested = 0;
     bool mPaused = false;
 
+    // Batching window (0 = disabled): waitForCommands() coalesces wakeups until either
+    // mBatchSizeBytes are queued or mBatchWindow has elapsed since the first pending
+    // buffer. Urgent flushes (fences, present, buffer pressure) drain immediately.
+    size_t mBatchSizeBytes = 0;
+    std::chrono::microseconds mBatchWindow{ 0 };
+    mutable std::chrono::steady_clock::time_point mBatchStart{};
+    mutable size_t mPendingBytes = 0;
+    mutable bool mUrgent = false;
+
     static constexpr uint32_t EXIT_REQUESTED = 0x31415926;
 
 public:
@@ -66,6 +85,17 @@ public:
 
     size_t getHighWatermark() const noexcept { return mHighWatermark; }
 
+    struct Stats {
+        size_t bufferSizeBytes = 0;     // current capacity of the circular buffer
+        size_t peakUsedBytes = 0;       // peak occupancy since the last call to getStats()
+        size_t highWatermarkBytes = 0;  // peak occupancy since creation
+        uint32_t growthCount = 0;       // number of times the buffer storage was grown
+    };
+
+    // Occupancy statistics of the circular buffer. Resets the running peak, so this is
+    // meant to be called once per frame.
+    Stats getStats() noexcept;
+
     // wait for commands to be available and returns an array containing these commands
     std::vector<Range> waitForCommands() const;
 
@@ -76,7 +106,13 @@ public:
 
     // all commands buffers (Slices) written to this point are returned by waitForCommand(). This
     // call blocks until the CircularBuffer has at least mRequiredSize bytes available.
-    void flush() noexcept;
+    // `urgent` bypasses the batching window so that the driver thread drains right away;
+    // non-urgent flushes may be coalesced (see setBatchingWindow()).
+    void flush(bool urgent = true) noexcept;
+
+    // Configures the wakeup batching window, see the member documentation. Either value
+    // set to zero disables batching, which is the default.
+    void setBatchingWindow(size_t sizeBytes, std::chrono::microseconds window) noexcept;
 
     // returns from waitForCommands() immediately.
     void requestExit();
@@ -17,6 +17,7 @@
 #ifndef TNT_FILAMENT_BACKEND_PRIVATE_HANDLEALLOCATOR_H
 #define TNT_FILAMENT_BACKEND_PRIVATE_HANDLEALLOCATOR_H
 
+#include <backend/DriverEnums.h>
 #include <backend/Handle.h>
 
 #include <utils/Allocator.h>
@@ -29,11 +30,14 @@
 
 #include <tsl/robin_map.h>
 
+#include <array>
+#include <atomic>
 #include <cstddef>
 #include <exception>
 #include <type_traits>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include <stddef.h>
 #include <stdint.h>
@@ -50,7 +54,13 @@ namespace filament::backend {
 template<size_t P0, size_t P1, size_t P2>
 class HandleAllocator {
 public:
-    HandleAllocator(const char* name, size_t size, bool disableUseAfterFreeCheck) noexcept;
+    // poolWeights skews how the arena is split between the three size-class pools. By default
+    // each pool holds the same number of handles; a weight of 0 is treated as 1.
+    // enableHandleSanitizer turns on quarantined recycling of freed pool slots (see
+    // quarantineHandle()) and forces the use-after-free check on.
+    HandleAllocator(const char* name, size_t size, bool disableUseAfterFreeCheck,
+            bool enableHandleSanitizer,
+            std::array<uint8_t, 3> poolWeights = { 1, 1, 1 }) noexcept;
     HandleAllocator(HandleAllocator const& rhs) = delete;
     HandleAllocator& operator=(HandleAllocator const& rhs) = delete;
     ~HandleAllocator();
@@ -247,6 +257,13 @@ public:
         return "(no tag)";
     }
 
+    /*
+     * Returns per size-class occupancy and overflow (slow path) counters. Can be called from any
+     * thread; the counters are only approximate with respect to each other since allocations can
+     * proceed concurrently.
+     */
+    HandleAllocatorStats getStats() const noexcept;
+
 private:
 
     template<typename D>
@@ -268,13 +285,18 @@ private:
         Pool<P0> mPool0;
         Pool<P1> mPool1;
         Pool<P2> mPool2;
+        uint32_t mPoolCapacity[3] = {};
         UTILS_UNUSED_IN_RELEASE const utils::AreaPolicy::HeapArea& mArea;
         bool mUseAfterFreeCheckDisabled;
     public:
-        explicit Allocator(const utils::AreaPolicy::HeapArea& area, bool disableUseAfterFreeCheck);
+        Allocator(const utils::AreaPolicy::HeapArea& area, bool disableUseAfterFreeCheck,
+                std::array<uint8_t, 3> poolWeights);
 
         static constexpr size_t getAlignment() noexcept { return MIN_ALIGNMENT; }
 
+        // number of handles the given size-class pool can hold
+        uint32_t getPoolCapacity(size_t pool) const noexcept { return mPoolCapacity[pool]; }
+
         // this is in fact always called with a constexpr size argument
         [[nodiscard]] inline void* alloc(size_t size, size_t, size_t, uint8_t* outAge) noexcept {
             void* p = nullptr;
@@ -345,6 +367,7 @@ private:
         uint8_t age;
         void* p = mHandleArena.alloc(SIZE, alignof(std::max_align_t), 0, &age);
         if (UTILS_LIKELY(p)) {
+            trackPoolAlloc(poolIndex<SIZE>());
             uint32_t const tag = (uint32_t(age) << HANDLE_AGE_SHIFT) & HANDLE_AGE_MASK;
             return arenaPointerToHandle(p, tag);
         } else {
@@ -358,12 +381,31 @@ private:
         if (UTILS_LIKELY(isPoolHandle(id))) {
             auto [p, tag] = handleToPointer(id);
             uint8_t const age = (tag & HANDLE_AGE_MASK) >> HANDLE_AGE_SHIFT;
-            mHandleArena.free(p, SIZE, age);
+            if (UTILS_UNLIKELY(mHandleSanitizerEnabled)) {
+                quarantineHandle(p, SIZE, age, poolIndex<SIZE>());
+            } else {
+                mHandleArena.free(p, SIZE, age);
+            }
+            mPoolUsed[poolIndex<SIZE>()].fetch_sub(1, std::memory_order_relaxed);
         } else {
             deallocateHandleSlow(id, SIZE);
         }
     }
 
+    // index of the size-class pool an allocation of the given size comes from
+    template<size_t SIZE>
+    static constexpr size_t poolIndex() noexcept {
+        return SIZE <= P0 ? 0 : (SIZE <= P1 ? 1 : 2);
+    }
+
+    void trackPoolAlloc(size_t pool) noexcept {
+        uint32_t const used = mPoolUsed[pool].fetch_add(1, std::memory_order_relaxed) + 1;
+        uint32_t watermark = mPoolWatermark[pool].load(std::memory_order_relaxed);
+        while (used > watermark && !mPoolWatermark[pool].compare_exchange_weak(
+                watermark, used, std::memory_order_relaxed)) {
+        }
+    }
+
     // number if bits allotted to the handle's age (currently 4 max)
     static constexpr uint32_t HANDLE_AGE_BIT_COUNT = 4;
     // number if bits allotted to the handle's debug tag (HANDLE_AGE_BIT_COUNT max)
@@ -390,6 +432,13 @@ private:
     HandleBase::HandleId allocateHandleSlow(size_t size);
     void deallocateHandleSlow(HandleBase::HandleId id, size_t size) noexcept;
 
+    // Handle sanitizer: instead of returning a freed slot to its pool immediately -- where the
+    // very next allocation of that size class would reuse it, letting a stale handle silently
+    // alias the new object -- the slot's age is bumped right away (so any further access through
+    // an old handle is caught) and the slot is parked in a FIFO quarantine; only the slot that
+    // has been quarantined the longest is actually recycled.
+    void quarantineHandle(void* p, size_t size, uint8_t age, size_t pool) noexcept;
+
     // We inline this because it's just 4 instructions in the fast case
     inline std::pair<void*, uint32_t> handleToPointer(HandleBase::HandleId id) const noexcept {
         // note: the null handle will end-up returning nullptr b/c it'll be handled as
@@ -418,12 +467,31 @@ private:
 
     HandleArena mHandleArena;
 
+    // Occupancy counters, see getStats(). These are atomics because handles are allocated and
+    // freed from both the application and driver threads.
+    std::atomic<uint32_t> mPoolUsed[3] = {};
+    std::atomic<uint32_t> mPoolWatermark[3] = {};
+    std::atomic<uint32_t> mOverflowUsed = {};
+    std::atomic<uint32_t> mOverflowTotal = {};
+
     // Below is only used when running out of space in the HandleArena
     mutable utils::Mutex mLock;
     tsl::robin_map<HandleBase::HandleId, void*> mOverflowMap;
     tsl::robin_map<HandleBase::HandleId, utils::CString> mDebugTags;
     HandleBase::HandleId mId = 0;
     bool mUseAfterFreeCheckDisabled = false;
+    bool mHandleSanitizerEnabled = false;
+
+    // Handle-sanitizer quarantine, one FIFO ring per size-class pool. Only touched when the
+    // sanitizer is enabled (see quarantineHandle()).
+    static constexpr size_t QUARANTINE_CAPACITY = 1024;
+    struct QuarantineEntry {
+        void* p;
+        uint8_t age;
+    };
+    mutable utils::Mutex mQuarantineLock;
+    std::vector<QuarantineEntry> mQuarantine[3];
+    uint32_t mQuarantineHead[3] = {};
 };
 
 } // namespace filament::backend
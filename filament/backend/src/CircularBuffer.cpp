@@ -52,7 +52,33 @@ CircularBuffer::CircularBuffer(size_t size)
 }
 
 CircularBuffer::~CircularBuffer() noexcept {
-    dealloc();
+    // by now the driver must have drained all command ranges, including those pointing into
+    // storages retired by grow()
+    while (!mRetiredStorages.empty()) {
+        freeOldestRetiredStorage();
+    }
+    dealloc({ mData, mSize, mAshmemFd });
+    mData = nullptr;
+    mAshmemFd = -1;
+}
+
+void CircularBuffer::grow(size_t newSize) noexcept {
+    assert_invariant(empty());
+    // Keep the old storage alive: ranges previously returned by getBuffer() may still be
+    // queued or executing on the driver thread. It is freed by freeOldestRetiredStorage()
+    // once the caller knows all of those ranges have been released.
+    mRetiredStorages.push_back({ mData, mSize, mAshmemFd });
+    mAshmemFd = -1;
+    mData = alloc(newSize);
+    mSize = newSize;
+    mTail = mData;
+    mHead = mData;
+}
+
+void CircularBuffer::freeOldestRetiredStorage() noexcept {
+    assert_invariant(!mRetiredStorages.empty());
+    dealloc(mRetiredStorages.front());
+    mRetiredStorages.erase(mRetiredStorages.begin());
 }
 
 // If the system support mmap(), use it for creating a "hard circular buffer" where two virtual
@@ -140,20 +166,18 @@ void* CircularBuffer::alloc(size_t size) noexcept {
 }
 
 UTILS_NOINLINE
-void CircularBuffer::dealloc() noexcept {
+void CircularBuffer::dealloc(Storage const storage) noexcept {
 #if HAS_MMAP
-    if (mData) {
+    if (storage.data) {
         size_t const BLOCK_SIZE = getBlockSize();
-        munmap(mData, mSize * 2 + BLOCK_SIZE);
-        if (mAshmemFd >= 0) {
-            close(mAshmemFd);
-            mAshmemFd = -1;
+        munmap(storage.data, storage.size * 2 + BLOCK_SIZE);
+        if (storage.ashmemFd >= 0) {
+            close(storage.ashmemFd);
         }
     }
 #else
-    ::free(mData);
+    ::free(storage.data);
 #endif
-    mData = nullptr;
 }
 
 
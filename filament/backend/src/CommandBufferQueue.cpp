@@ -41,6 +41,7 @@ namespace filament::backend {
 
 CommandBufferQueue::CommandBufferQueue(size_t requiredSize, size_t bufferSize, bool paused)
         : mRequiredSize((requiredSize + (CircularBuffer::getBlockSize() - 1u)) & ~(CircularBuffer::getBlockSize() -1u)),
+          mMaxBufferSize(bufferSize * 16),
           mCircularBuffer(bufferSize),
           mFreeSpace(mCircularBuffer.size()),
           mPaused(paused) {
@@ -78,7 +79,16 @@ bool CommandBufferQueue::isExitRequested() const {
 }
 
 
-void CommandBufferQueue::flush() noexcept {
+void CommandBufferQueue::setBatchingWindow(size_t sizeBytes,
+        std::chrono::microseconds window) noexcept {
+    std::lock_guard<utils::Mutex> const lock(mLock);
+    mBatchSizeBytes = sizeBytes;
+    mBatchWindow = window;
+    // wake the consumer so it re-evaluates its wait with the new policy
+    mCondition.notify_one();
+}
+
+void CommandBufferQueue::flush(bool urgent) noexcept {
     SYSTRACE_CALL();
 
     CircularBuffer& circularBuffer = mCircularBuffer;
@@ -113,32 +123,64 @@ void CommandBufferQueue::flush() noexcept {
 
     mFreeSpace -= used;
     mCommandBuffersToExecute.push_back({ begin, end });
-    mCondition.notify_one();
-
-    // wait until there is enough space in the buffer
-    if (UTILS_UNLIKELY(mFreeSpace < requiredSize)) {
-
-#ifndef NDEBUG
-        size_t const totalUsed = circularBuffer.size() - mFreeSpace;
-        slog.d << "CommandStream used too much space (will block): "
-                << "needed space " << requiredSize << " out of " << mFreeSpace
-                << ", totalUsed=" << totalUsed << ", current=" << used
-                << ", queue size=" << mCommandBuffersToExecute.size() << " buffers"
-                << io::endl;
+    mOutstandingRanges++;
 
-        mHighWatermark = std::max(mHighWatermark, totalUsed);
-#endif
+    size_t const totalUsed = circularBuffer.size() - mFreeSpace;
+    mHighWatermark = std::max(mHighWatermark, totalUsed);
+    mFrameHighWatermark = std::max(mFrameHighWatermark, totalUsed);
 
-        SYSTRACE_NAME("waiting: CircularBuffer::flush()");
+    if (urgent) {
+        mUrgent = true;
+    } else if (mPendingBytes == 0) {
+        // first buffer of a batch, this starts the batching window
+        mBatchStart = std::chrono::steady_clock::now();
+    }
+    mPendingBytes += used;
 
-        FILAMENT_CHECK_POSTCONDITION(!mPaused) <<
-                "CommandStream is full, but since the rendering thread is paused, "
-                "the buffer cannot flush and we will deadlock. Instead, abort.";
+    mCondition.notify_one();
 
-        mCondition.wait(lock, [this, requiredSize]() -> bool {
-            // TODO: on macOS, we need to call pumpEvents from time to time
-            return mFreeSpace >= requiredSize;
-        });
+    if (UTILS_UNLIKELY(mFreeSpace < requiredSize)) {
+        // The next batch of commands may not fit. Rather than blocking the main thread until
+        // the driver catches up, replace the backing storage with a larger one (up to a
+        // limit). Ranges already queued keep pointing into the old storage, which is retired
+        // once the driver has released all of them (see releaseBuffer()).
+        size_t const oldSize = circularBuffer.size();
+        if (UTILS_LIKELY(oldSize < mMaxBufferSize)) {
+            size_t const newSize = std::min(oldSize * 3, mMaxBufferSize);
+            size_t alreadyRetired = 0;
+            for (size_t const count : mRetiredEpochs) {
+                alreadyRetired += count;
+            }
+            // ranges still unreleased that live in the storage we're about to retire
+            size_t const unreleased = mOutstandingRanges - alreadyRetired;
+            circularBuffer.grow(newSize);
+            if (UTILS_UNLIKELY(unreleased == 0)) {
+                circularBuffer.freeOldestRetiredStorage();
+            } else {
+                mRetiredEpochs.push_back(unreleased);
+            }
+            mFreeSpace = newSize;
+            mGrowthCount++;
+            slog.w << "CommandStream: circular buffer grown from " << (oldSize / 1024)
+                   << " KiB to " << (newSize / 1024) << " KiB" << io::endl;
+        } else {
+            // we've hit the growth limit, fall back to waiting for the driver
+            SYSTRACE_NAME("waiting: CircularBuffer::flush()");
+
+            FILAMENT_CHECK_POSTCONDITION(!mPaused) <<
+                    "CommandStream is full, but since the rendering thread is paused, "
+                    "the buffer cannot flush and we will deadlock. Instead, abort.";
+
+            // we're about to block on the driver thread, it must not sit in its
+            // batching window while we wait
+            mUrgent = true;
+            mCondition.notify_one();
+
+            mCondition.wait(lock, [this, requiredSize]() -> bool {
+                // TODO: on macOS, we need to call pumpEvents from time to time
+                return mFreeSpace >= requiredSize;
+            });
+        }
     }
 }
 
@@ -147,9 +189,27 @@ std::vector<CommandBufferQueue::Range> CommandBufferQueue::waitForCommands() con
         return std::move(mCommandBuffersToExecute);
     }
     std::unique_lock<utils::Mutex> lock(mLock);
-    while ((mCommandBuffersToExecute.empty() || mPaused) && !mExitRequested) {
-        mCondition.wait(lock);
+    while (!mExitRequested) {
+        if (mCommandBuffersToExecute.empty() || mPaused) {
+            mCondition.wait(lock);
+            continue;
+        }
+        // Batching window: when only a small amount of non-urgent work is queued, keep
+        // sleeping a little longer so that several command buffers are drained with a
+        // single wakeup. An urgent flush, enough queued bytes, or the window elapsing
+        // ends the wait.
+        if (mBatchWindow.count() > 0 && mBatchSizeBytes > 0 &&
+                !mUrgent && mPendingBytes < mBatchSizeBytes) {
+            if (mCondition.wait_until(lock, mBatchStart + mBatchWindow) ==
+                    std::cv_status::timeout) {
+                break; // window elapsed, drain what we have
+            }
+            continue;
+        }
+        break;
     }
+    mUrgent = false;
+    mPendingBytes = 0;
     return std::move(mCommandBuffersToExecute);
 }
 
@@ -157,8 +217,32 @@ void CommandBufferQueue::releaseBuffer(CommandBufferQueue::Range const& buffer)
     size_t const used = std::distance(
             static_cast<char const*>(buffer.begin), static_cast<char const*>(buffer.end));
     std::lock_guard<utils::Mutex> const lock(mLock);
+    assert_invariant(mOutstandingRanges > 0);
+    mOutstandingRanges--;
+    if (UTILS_UNLIKELY(!mRetiredEpochs.empty())) {
+        // Ranges are released in the order they were flushed, so this one belongs to the
+        // oldest storage that still has unreleased ranges. Its bytes don't come back to the
+        // current buffer; instead, free the retired storage once it is fully drained.
+        if (--mRetiredEpochs.front() == 0) {
+            mRetiredEpochs.erase(mRetiredEpochs.begin());
+            mCircularBuffer.freeOldestRetiredStorage();
+        }
+        return;
+    }
     mFreeSpace += used;
     mCondition.notify_one();
 }
 
+CommandBufferQueue::Stats CommandBufferQueue::getStats() noexcept {
+    std::lock_guard<utils::Mutex> const lock(mLock);
+    Stats const stats{
+            .bufferSizeBytes = mCircularBuffer.size(),
+            .peakUsedBytes = mFrameHighWatermark,
+            .highWatermarkBytes = mHighWatermark,
+            .growthCount = mGrowthCount,
+    };
+    mFrameHighWatermark = 0;
+    return stats;
+}
+
 } // namespace filament::backend
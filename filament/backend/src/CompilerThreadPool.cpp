@@ -108,6 +108,22 @@ auto CompilerThreadPool::dequeue(program_token_t const& token) -> Job {
     return job;
 }
 
+bool CompilerThreadPool::makeUrgent(program_token_t const& token) {
+    std::unique_lock const lock(mQueueLock);
+    auto&& [q, pos] = find(token);
+    if (pos == q.end()) {
+        // the job is being executed right now, or has already completed
+        return false;
+    }
+    auto& urgentQueue = mQueues[size_t(CompilerPriorityQueue::HIGH)];
+    if (&q != &urgentQueue || pos != urgentQueue.begin()) {
+        auto item = std::move(*pos);
+        q.erase(pos);
+        urgentQueue.emplace_front(std::move(item));
+    }
+    return true;
+}
+
 void CompilerThreadPool::queue(CompilerPriorityQueue priorityQueue,
         program_token_t const& token, Job&& job) {
     std::unique_lock const lock(mQueueLock);
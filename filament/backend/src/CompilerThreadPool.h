@@ -53,6 +53,11 @@ public:
     void queue(CompilerPriorityQueue priorityQueue, program_token_t const& token, Job&& job);
     Job dequeue(program_token_t const& token);
 
+    // Moves a queued job to the front of the high-priority queue, ahead of any pending
+    // lower-priority work. Returns false if the job is not queued anymore (i.e. it is being
+    // executed right now, or has already completed).
+    bool makeUrgent(program_token_t const& token);
+
 private:
     using Queue = std::deque<std::pair<program_token_t, Job>>;
     std::vector<std::thread> mCompilerThreads;
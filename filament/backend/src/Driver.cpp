@@ -46,6 +46,51 @@ using namespace filament::math;
 
 namespace filament::backend {
 
+// ------------------------------------------------------------------------------------------------
+
+void GcScheduler::registerCache(const char* name, GcFn fn) noexcept {
+    mEntries.push_back({ name, std::move(fn) });
+}
+
+void GcScheduler::run(std::chrono::microseconds budget) noexcept {
+    using clock = std::chrono::steady_clock;
+    size_t const count = mEntries.size();
+    if (UTILS_UNLIKELY(count == 0)) {
+        return;
+    }
+    auto const deadline = clock::now() + budget;
+    for (size_t i = 0; i < count; i++) {
+        Entry& entry = mEntries[mNextEntry];
+        auto const t0 = clock::now();
+        if (i > 0) {
+            // Frame-time smoothing: don't start a sweep the remaining budget likely can't
+            // absorb, based on this cache's average sweep cost so far.
+            auto const averageNs = entry.runs ? entry.totalTimeNs / entry.runs : 0;
+            if (t0 + std::chrono::nanoseconds(averageNs) > deadline) {
+                break;
+            }
+        }
+        entry.evicted += entry.fn();
+        auto const t1 = clock::now();
+        entry.totalTimeNs += std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+        entry.runs++;
+        mNextEntry = (mNextEntry + 1) % count;
+        if (t1 >= deadline) {
+            break;
+        }
+    }
+}
+
+utils::FixedCapacityVector<GcScheduler::Stats> GcScheduler::getStats() const noexcept {
+    auto stats = utils::FixedCapacityVector<Stats>::with_capacity(mEntries.size());
+    for (auto const& entry : mEntries) {
+        stats.push_back({ entry.name, entry.evicted, entry.runs, entry.totalTimeNs });
+    }
+    return stats;
+}
+
+// ------------------------------------------------------------------------------------------------
+
 DriverBase::DriverBase() noexcept {
     if constexpr (UTILS_HAS_THREADING) {
         // This thread services user callbacks
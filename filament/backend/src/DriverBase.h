@@ -29,7 +29,11 @@
 #include "private/backend/Dispatcher.h"
 #include "private/backend/Driver.h"
 
+#include <utils/FixedCapacityVector.h>
+
+#include <chrono>
 #include <condition_variable>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <thread>
@@ -163,6 +167,50 @@ struct HwStream : public HwBase {
 struct HwTimerQuery : public HwBase {
 };
 
+/*
+ * Budgeted incremental garbage collection for backend caches.
+ *
+ * Each cache registers an eviction callback once; the driver then calls run() about once per
+ * frame, which services the callbacks round-robin under a time budget. Sweeps that used to all
+ * land in the same frame are thereby staggered across frames, bounding the per-frame cleanup
+ * cost. Because the caches' eviction clocks only advance when their sweep runs, deferring a
+ * sweep only makes eviction more conservative, never less safe.
+ */
+class GcScheduler {
+public:
+    // An increment of eviction work. Returns the number of entries evicted.
+    using GcFn = std::function<size_t()>;
+
+    struct Stats {
+        const char* name;           // name the cache was registered under
+        uint64_t evicted;           // total number of entries evicted
+        uint64_t runs;              // number of times the callback has run
+        uint64_t totalTimeNs;       // total time spent in the callback
+    };
+
+    // Registers a cache's eviction callback. `name` must outlive the scheduler.
+    void registerCache(const char* name, GcFn fn) noexcept;
+
+    // Services the registered callbacks round-robin, stopping once the budget is exhausted or
+    // every callback has run once. The first callback serviced always runs, even when its
+    // predicted cost exceeds the remaining budget, so every cache makes progress eventually.
+    void run(std::chrono::microseconds budget) noexcept;
+
+    // Per-cache eviction statistics, in registration order.
+    utils::FixedCapacityVector<Stats> getStats() const noexcept;
+
+private:
+    struct Entry {
+        const char* name;
+        GcFn fn;
+        uint64_t evicted = 0;
+        uint64_t runs = 0;
+        uint64_t totalTimeNs = 0;
+    };
+    std::vector<Entry> mEntries;
+    size_t mNextEntry = 0;
+};
+
 /*
  * Base class of all Driver implementations
  */
@@ -224,6 +272,10 @@ protected:
     void debugCommandBegin(CommandStream* cmds, bool synchronous, const char* methodName) noexcept override;
     void debugCommandEnd(CommandStream* cmds, bool synchronous, const char* methodName) noexcept override;
 
+    // Centralized budgeted GC scheduler. Concrete drivers register their caches' eviction
+    // callbacks and call mGcScheduler.run() once per frame.
+    GcScheduler mGcScheduler;
+
 private:
     std::mutex mPurgeLock;
     std::vector<std::pair<void*, CallbackHandler::Callback>> mCallbacks;
@@ -0,0 +1,302 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <backend/FileBlobCache.h>
+
+#include <backend/Platform.h>
+
+#include <utils/compiler.h>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include <stdio.h>
+#include <string.h>
+
+#if !defined(WIN32) && !defined(__EMSCRIPTEN__)
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#   define HAS_MMAP 1
+#else
+#   include <stdlib.h>
+#   define HAS_MMAP 0
+#endif
+
+namespace filament::backend {
+
+namespace {
+constexpr size_t align8(size_t v) noexcept {
+    return (v + 7) & ~size_t(7);
+}
+} // anonymous namespace
+
+FileBlobCache::FileBlobCache() noexcept = default;
+
+FileBlobCache::FileBlobCache(utils::CString path) noexcept
+    : mPath(std::move(path)) {
+}
+
+FileBlobCache::~FileBlobCache() noexcept {
+    unload();
+}
+
+void FileBlobCache::unload() noexcept {
+    if (mMapping) {
+#if HAS_MMAP
+        if (mMapped) {
+            munmap(mMapping, mMappingSize);
+        } else {
+            free(mMapping);
+        }
+#else
+        free(mMapping);
+#endif
+        mMapping = nullptr;
+        mMappingSize = 0;
+        mMapped = false;
+    }
+}
+
+bool FileBlobCache::load() noexcept {
+    std::lock_guard const lock(mLock);
+
+    if (mPath.empty()) {
+        // in-memory cache, nothing to load
+        return false;
+    }
+
+    size_t size = 0;
+    void* data = nullptr;
+    bool mapped = false;
+
+#if HAS_MMAP
+    int const fd = open(mPath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st{};
+    if (fstat(fd, &st) < 0 || st.st_size < off_t(sizeof(Header))) {
+        close(fd);
+        return false;
+    }
+    size = size_t(st.st_size);
+    data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        return false;
+    }
+    mapped = true;
+#else
+    FILE* const file = fopen(mPath.c_str(), "rb");
+    if (!file) {
+        return false;
+    }
+    fseek(file, 0, SEEK_END);
+    long const fileSize = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (fileSize < long(sizeof(Header))) {
+        fclose(file);
+        return false;
+    }
+    size = size_t(fileSize);
+    data = malloc(size);
+    if (!data || fread(data, 1, size, file) != size) {
+        free(data);
+        fclose(file);
+        return false;
+    }
+    fclose(file);
+#endif
+
+    Header const* const header = static_cast<Header const*>(data);
+    char const* const base = static_cast<char const*>(data);
+    char const* const end = base + size;
+
+    bool valid = header->magic == MAGIC && header->version == VERSION;
+    std::vector<Entry> entries;
+    if (valid) {
+        entries.reserve(header->entryCount);
+        char const* p = base + sizeof(Header);
+        for (uint32_t i = 0; i < header->entryCount; i++) {
+            if (p + 2 * sizeof(uint32_t) > end) {
+                valid = false;
+                break;
+            }
+            uint32_t sizes[2];
+            memcpy(sizes, p, sizeof(sizes));
+            uint32_t const keySize = sizes[0];
+            uint32_t const valueSize = sizes[1];
+            char const* const key = p + 2 * sizeof(uint32_t);
+            char const* const value = key + align8(keySize);
+            char const* const next = value + align8(valueSize);
+            if (next > end) {
+                valid = false;
+                break;
+            }
+            entries.push_back({ key, value, keySize, valueSize });
+            p = next;
+        }
+    }
+
+    if (!valid) {
+#if HAS_MMAP
+        if (mapped) {
+            munmap(data, size);
+        } else {
+            free(data);
+        }
+#else
+        free(data);
+#endif
+        return false;
+    }
+
+    unload();
+    mMapping = data;
+    mMappingSize = size;
+    mMapped = mapped;
+    mEntries = std::move(entries);
+    mHeapBlobs.clear();
+    mDirty = false;
+    return true;
+}
+
+void FileBlobCache::bind(Platform* platform) noexcept {
+    platform->setBlobFunc(
+            [this](void const* key, size_t keySize, void const* value, size_t valueSize) {
+                insert(key, keySize, value, valueSize);
+            },
+            [this](void const* key, size_t keySize, void* value, size_t valueSize) {
+                return retrieve(key, keySize, value, valueSize);
+            });
+}
+
+FileBlobCache::Entry* FileBlobCache::find(void const* key, size_t keySize) noexcept {
+    for (Entry& entry : mEntries) {
+        if (entry.keySize == keySize && !memcmp(entry.key, key, keySize)) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+FileBlobCache::Entry const* FileBlobCache::find(void const* key, size_t keySize) const noexcept {
+    return const_cast<FileBlobCache*>(this)->find(key, keySize);
+}
+
+void FileBlobCache::insert(void const* key, size_t keySize, void const* value, size_t valueSize) {
+    std::lock_guard const lock(mLock);
+
+    Entry* const existing = find(key, keySize);
+    if (existing && existing->valueSize == valueSize &&
+            !memcmp(existing->value, value, valueSize)) {
+        // unchanged, nothing to do
+        return;
+    }
+
+    // copy the blob, the caller's pointers are only valid for the duration of this call
+    auto blob = std::make_unique<char[]>(keySize + valueSize);
+    memcpy(blob.get(), key, keySize);
+    memcpy(blob.get() + keySize, value, valueSize);
+
+    Entry const entry = {
+            blob.get(), blob.get() + keySize,
+            uint32_t(keySize), uint32_t(valueSize) };
+    if (existing) {
+        *existing = entry;
+    } else {
+        mEntries.push_back(entry);
+    }
+    mHeapBlobs.push_back(std::move(blob));
+    mDirty = true;
+}
+
+size_t FileBlobCache::retrieve(
+        void const* key, size_t keySize, void* value, size_t valueSize) const {
+    std::lock_guard const lock(mLock);
+
+    Entry const* const entry = find(key, keySize);
+    if (!entry) {
+        return 0;
+    }
+    // per blob-cache convention, if the destination is too small we only report the size needed
+    if (valueSize >= entry->valueSize) {
+        memcpy(value, entry->value, entry->valueSize);
+    }
+    return entry->valueSize;
+}
+
+bool FileBlobCache::save() noexcept {
+    std::lock_guard const lock(mLock);
+
+    if (!mDirty || mPath.empty()) {
+        return true;
+    }
+
+    std::string const tmpPath = std::string(mPath.c_str()) + ".tmp";
+    FILE* const file = fopen(tmpPath.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+
+    bool ok = true;
+    Header const header = { MAGIC, VERSION, uint32_t(mEntries.size()), 0 };
+    ok = ok && fwrite(&header, sizeof(Header), 1, file) == 1;
+
+    constexpr char padding[8] = {};
+    for (Entry const& entry : mEntries) {
+        uint32_t const sizes[2] = { entry.keySize, entry.valueSize };
+        ok = ok && fwrite(sizes, sizeof(sizes), 1, file) == 1;
+        ok = ok && fwrite(entry.key, 1, entry.keySize, file) == entry.keySize;
+        ok = ok && fwrite(padding, 1, align8(entry.keySize) - entry.keySize, file)
+                == align8(entry.keySize) - entry.keySize;
+        ok = ok && fwrite(entry.value, 1, entry.valueSize, file) == entry.valueSize;
+        ok = ok && fwrite(padding, 1, align8(entry.valueSize) - entry.valueSize, file)
+                == align8(entry.valueSize) - entry.valueSize;
+        if (!ok) {
+            break;
+        }
+    }
+    ok = (fclose(file) == 0) && ok;
+
+    if (!ok) {
+        remove(tmpPath.c_str());
+        return false;
+    }
+
+#if defined(WIN32)
+    // rename() doesn't replace an existing file on Windows
+    remove(mPath.c_str());
+#endif
+    if (rename(tmpPath.c_str(), mPath.c_str()) != 0) {
+        remove(tmpPath.c_str());
+        return false;
+    }
+
+    mDirty = false;
+    return true;
+}
+
+size_t FileBlobCache::getEntryCount() const noexcept {
+    std::lock_guard const lock(mLock);
+    return mEntries.size();
+}
+
+} // namespace filament::backend
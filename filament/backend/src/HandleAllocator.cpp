@@ -40,7 +40,7 @@ using namespace utils;
 template <size_t P0, size_t P1, size_t P2>
 UTILS_NOINLINE
 HandleAllocator<P0, P1, P2>::Allocator::Allocator(AreaPolicy::HeapArea const& area,
-        bool disableUseAfterFreeCheck)
+        bool disableUseAfterFreeCheck, std::array<uint8_t, 3> poolWeights)
         : mArea(area),
           mUseAfterFreeCheckDisabled(disableUseAfterFreeCheck) {
 
@@ -62,27 +62,51 @@ HandleAllocator<P0, P1, P2>::Allocator::Allocator(AreaPolicy::HeapArea const& ar
     // with an age of 0.
     memset(area.data(), 0, maxHeapSize);
 
-    // size the different pools so that they can all contain the same number of handles
-    size_t const count = maxHeapSize / (P0 + P1 + P2);
+    // Size the different pools so that they hold handle counts proportional to their weights;
+    // with the default weights they all contain the same number of handles.
+    size_t const w0 = std::max(poolWeights[0], uint8_t(1));
+    size_t const w1 = std::max(poolWeights[1], uint8_t(1));
+    size_t const w2 = std::max(poolWeights[2], uint8_t(1));
+    size_t const count = maxHeapSize / (P0 * w0 + P1 * w1 + P2 * w2);
     char* const p0 = static_cast<char*>(area.begin());
-    char* const p1 = p0 + count * P0;
-    char* const p2 = p1 + count * P1;
-
-    mPool0 = Pool<P0>(p0, count * P0);
-    mPool1 = Pool<P1>(p1, count * P1);
-    mPool2 = Pool<P2>(p2, count * P2);
+    char* const p1 = p0 + count * w0 * P0;
+    char* const p2 = p1 + count * w1 * P1;
+
+    mPool0 = Pool<P0>(p0, count * w0 * P0);
+    mPool1 = Pool<P1>(p1, count * w1 * P1);
+    mPool2 = Pool<P2>(p2, count * w2 * P2);
+
+    // Effective handle counts, mirroring FreeList's layout: each slot is the handle size plus the
+    // Node header, rounded up to the alignment, and each pool loses one alignment's worth of bytes
+    // to the header of its first slot (the pools' base addresses are always aligned).
+    auto const effectiveCapacity = [](size_t poolBytes, size_t handleSize) {
+        size_t const stride =
+                (handleSize + sizeof(Node) + MIN_ALIGNMENT - 1) & ~(MIN_ALIGNMENT - 1);
+        return uint32_t((poolBytes - MIN_ALIGNMENT) / stride);
+    };
+    mPoolCapacity[0] = effectiveCapacity(count * w0 * P0, P0);
+    mPoolCapacity[1] = effectiveCapacity(count * w1 * P1, P1);
+    mPoolCapacity[2] = effectiveCapacity(count * w2 * P2, P2);
 }
 
 // ------------------------------------------------------------------------------------------------
 
 template <size_t P0, size_t P1, size_t P2>
 HandleAllocator<P0, P1, P2>::HandleAllocator(const char* name, size_t size,
-        bool disableUseAfterFreeCheck) noexcept
-    : mHandleArena(name, size, disableUseAfterFreeCheck),
-      mUseAfterFreeCheckDisabled(disableUseAfterFreeCheck) {
+        bool disableUseAfterFreeCheck, bool enableHandleSanitizer,
+        std::array<uint8_t, 3> poolWeights) noexcept
+      // the sanitizer is pointless without the use-after-free check, so it forces it on
+    : mHandleArena(name, size, disableUseAfterFreeCheck && !enableHandleSanitizer, poolWeights),
+      mUseAfterFreeCheckDisabled(disableUseAfterFreeCheck && !enableHandleSanitizer),
+      mHandleSanitizerEnabled(enableHandleSanitizer) {
     // Reserve initial space for debug tags. This prevents excessive calls to malloc when the first
     // few tags are set.
     mDebugTags.reserve(512);
+    if (UTILS_UNLIKELY(enableHandleSanitizer)) {
+        for (auto& ring : mQuarantine) {
+            ring.reserve(QUARANTINE_CAPACITY);
+        }
+    }
 }
 
 template <size_t P0, size_t P1, size_t P2>
@@ -123,6 +147,9 @@ HandleBase::HandleId HandleAllocator<P0, P1, P2>::allocateHandleSlow(size_t size
     mOverflowMap.emplace(id, p);
     lock.unlock();
 
+    mOverflowUsed.fetch_add(1, std::memory_order_relaxed);
+    mOverflowTotal.fetch_add(1, std::memory_order_relaxed);
+
     if (UTILS_UNLIKELY(id == (HANDLE_HEAP_FLAG | 1u))) { // meaning id was zero
         PANIC_LOG("HandleAllocator arena is full, using slower system heap. Please increase "
                   "the appropriate constant (e.g. FILAMENT_OPENGL_HANDLE_ARENA_SIZE_IN_MB).");
@@ -144,9 +171,65 @@ void HandleAllocator<P0, P1, P2>::deallocateHandleSlow(HandleBase::HandleId id,
     }
     lock.unlock();
 
+    if (p) {
+        mOverflowUsed.fetch_sub(1, std::memory_order_relaxed);
+    }
     ::free(p);
 }
 
+template <size_t P0, size_t P1, size_t P2>
+UTILS_NOINLINE
+void HandleAllocator<P0, P1, P2>::quarantineHandle(void* p, size_t size,
+        uint8_t age, size_t pool) noexcept {
+    // Same double-free check as Allocator::free(), but the age is bumped here, while the slot
+    // sits in quarantine, so a stale handle_cast on it faults immediately instead of waiting
+    // for the slot to be recycled.
+    auto* const pNode = static_cast<typename Allocator::Node*>(p);
+    uint8_t& slotAge = pNode[-1].age;
+    FILAMENT_CHECK_POSTCONDITION(slotAge == age)
+            << "double-free of Handle of size " << size << " at " << p;
+    slotAge = (slotAge + 1) & 0xF; // fixme (see Allocator::free)
+
+    // park the slot and, once the ring is full, recycle the oldest quarantined slot. The evicted
+    // entry's age was already bumped above, so Allocator::free()'s own check passes.
+    QuarantineEntry evicted = {};
+    bool hasEvicted = false;
+    {
+        std::lock_guard const lock(mQuarantineLock);
+        auto& ring = mQuarantine[pool];
+        uint32_t& head = mQuarantineHead[pool];
+        if (UTILS_LIKELY(ring.size() == QUARANTINE_CAPACITY)) {
+            evicted = ring[head];
+            ring[head] = { p, slotAge };
+            head = (head + 1) % QUARANTINE_CAPACITY;
+            hasEvicted = true;
+        } else {
+            ring.push_back({ p, slotAge });
+        }
+    }
+    if (hasEvicted) {
+        mHandleArena.free(evicted.p, size, evicted.age);
+    }
+}
+
+template <size_t P0, size_t P1, size_t P2>
+HandleAllocatorStats HandleAllocator<P0, P1, P2>::getStats() const noexcept {
+    HandleAllocatorStats stats;
+    auto const& allocator = mHandleArena.getAllocator();
+    constexpr uint32_t handleSizes[3] = { P0, P1, P2 };
+    for (size_t i = 0; i < 3; i++) {
+        stats.pools[i] = {
+                .handleSize = handleSizes[i],
+                .capacity = allocator.getPoolCapacity(i),
+                .used = mPoolUsed[i].load(std::memory_order_relaxed),
+                .watermark = mPoolWatermark[i].load(std::memory_order_relaxed),
+        };
+    }
+    stats.overflowUsed = mOverflowUsed.load(std::memory_order_relaxed);
+    stats.overflowTotal = mOverflowTotal.load(std::memory_order_relaxed);
+    return stats;
+}
+
 // Explicit template instantiations.
 #if defined (FILAMENT_SUPPORTS_OPENGL)
 template class HandleAllocatorGL;
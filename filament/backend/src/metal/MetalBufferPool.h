@@ -63,7 +63,11 @@ private:
 // Manages a pool of Metal buffers, periodically releasing ones that have been unused for awhile.
 class MetalBufferPool {
 public:
-    explicit MetalBufferPool(MetalContext& context) noexcept : mContext(context) {}
+    // timerName tags allocations for ScopedAllocationTimer, and bufferType determines how the
+    // pool's buffers are accounted for by TrackedMetalBuffer.
+    MetalBufferPool(MetalContext& context, const char* timerName,
+            TrackedMetalBuffer::Type bufferType) noexcept
+        : mContext(context), mTimerName(timerName), mBufferType(bufferType) {}
 
     // Finds or creates a buffer whose capacity is at least the given number of bytes.
     MetalBufferPoolEntry const* acquireBuffer(size_t numBytes);
@@ -75,14 +79,17 @@ public:
     // the count is 0.
     void releaseBuffer(MetalBufferPoolEntry const *stage) noexcept;
 
-    // Evicts old unused buffers and bumps the current frame number.
-    void gc() noexcept;
+    // Evicts old unused buffers and bumps the current frame number. Returns the number of
+    // buffers destroyed.
+    size_t gc() noexcept;
 
     // Destroys all unused buffers.
     void reset() noexcept;
 
 private:
     MetalContext& mContext;
+    const char* mTimerName;
+    TrackedMetalBuffer::Type mBufferType;
 
     // Synchronizes access to mFreeStages, mUsedStages, and mutable data inside MetalBufferPoolEntrys.
     // acquireBuffer and releaseBuffer may be called on separate threads (the engine thread and a
@@ -44,14 +44,14 @@ MetalBufferPoolEntry const* MetalBufferPool::acquireBuffer(size_t numBytes) {
     // We were not able to find a sufficiently large stage, so create a new one.
     id<MTLBuffer> buffer = nil;
     {
-        ScopedAllocationTimer timer("staging");
+        ScopedAllocationTimer timer(mTimerName);
         buffer = [mContext.device newBufferWithLength:numBytes
                                               options:MTLResourceStorageModeShared];
     }
     FILAMENT_CHECK_POSTCONDITION(buffer)
-            << "Could not allocate Metal staging buffer of size " << numBytes << ".";
+            << "Could not allocate Metal " << mTimerName << " buffer of size " << numBytes << ".";
     MetalBufferPoolEntry* stage = new MetalBufferPoolEntry {
-        .buffer = { buffer, TrackedMetalBuffer::Type::STAGING },
+        .buffer = { buffer, mBufferType },
         .capacity = numBytes,
         .lastAccessed = mCurrentFrame,
         .referenceCount = 1
@@ -86,24 +86,27 @@ void MetalBufferPool::releaseBuffer(MetalBufferPoolEntry const *stage) noexcept
     mFreeStages.insert(std::make_pair(stage->capacity, stage));
 }
 
-void MetalBufferPool::gc() noexcept {
+size_t MetalBufferPool::gc() noexcept {
     // If this is one of the first few frames, return early to avoid wrapping unsigned integers.
     if (++mCurrentFrame <= TIME_BEFORE_EVICTION) {
-        return;
+        return 0;
     }
     const uint64_t evictionTime = mCurrentFrame - TIME_BEFORE_EVICTION;
 
     std::lock_guard<std::mutex> lock(mMutex);
 
+    size_t evicted = 0;
     decltype(mFreeStages) stages;
     stages.swap(mFreeStages);
     for (auto pair : stages) {
         if (pair.second->lastAccessed < evictionTime) {
             delete pair.second;
+            evicted++;
         } else {
             mFreeStages.insert(pair);
         }
     }
+    return evicted;
 }
 
 void MetalBufferPool::reset() noexcept {
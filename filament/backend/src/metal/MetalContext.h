@@ -186,6 +186,9 @@ struct MetalContext {
     tsl::robin_set<MetalTexture*> textures;
 
     MetalBufferPool* bufferPool;
+    // Recycles descriptor set argument buffers, which are small and allocated every time a
+    // descriptor set's content changes.
+    MetalBufferPool* argumentBufferPool;
     MetalBumpAllocator* bumpAllocator;
 
     MetalSwapChain* currentDrawSwapChain = nil;
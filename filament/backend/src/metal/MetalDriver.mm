@@ -57,6 +57,9 @@
 namespace filament {
 namespace backend {
 
+// Per-frame time budget for the buffer pool eviction sweeps serviced by the GC scheduler.
+constexpr std::chrono::microseconds GC_TIME_BUDGET{ 500 };
+
 Driver* MetalDriverFactory::create(MetalPlatform* const platform, const Platform::DriverConfig& driverConfig) {
 #if 0
     // this is useful for development, but too verbose even for debug builds
@@ -112,8 +115,9 @@ MetalDriver::MetalDriver(
         MetalPlatform* platform, const Platform::DriverConfig& driverConfig) noexcept
     : mPlatform(*platform),
       mContext(new MetalContext),
-      mHandleAllocator(
-              "Handles", driverConfig.handleArenaSize, driverConfig.disableHandleUseAfterFreeCheck),
+      mHandleAllocator("Handles", driverConfig.handleArenaSize,
+              driverConfig.disableHandleUseAfterFreeCheck, driverConfig.enableHandleSanitizer,
+              driverConfig.handleArenaPoolWeights),
       mStereoscopicType(driverConfig.stereoscopicType) {
     mContext->driver = this;
 
@@ -186,7 +190,16 @@ MetalDriver::MetalDriver(
     mContext->depthStencilStateCache.setDevice(mContext->device);
     mContext->samplerStateCache.setDevice(mContext->device);
     mContext->argumentEncoderCache.setDevice(mContext->device);
-    mContext->bufferPool = new MetalBufferPool(*mContext);
+    mContext->bufferPool =
+            new MetalBufferPool(*mContext, "staging", TrackedMetalBuffer::Type::STAGING);
+    mContext->argumentBufferPool =
+            new MetalBufferPool(*mContext, "descriptor_set", TrackedMetalBuffer::Type::DESCRIPTOR_SET);
+
+    // Register the pools' eviction sweeps with the budgeted GC scheduler, which staggers them
+    // across frames in endFrame().
+    mGcScheduler.registerCache("staging", [this] { return mContext->bufferPool->gc(); });
+    mGcScheduler.registerCache("descriptor_set",
+            [this] { return mContext->argumentBufferPool->gc(); });
     mContext->bumpAllocator =
             new MetalBumpAllocator(mContext->device, driverConfig.metalUploadBufferSizeBytes);
     mContext->blitter = new MetalBlitter(*mContext);
@@ -227,6 +240,7 @@ MetalDriver::~MetalDriver() noexcept {
     mContext->emptyTexture = nil;
     CFRelease(mContext->textureCache);
     delete mContext->bufferPool;
+    delete mContext->argumentBufferPool;
     delete mContext->bumpAllocator;
     delete mContext->blitter;
     delete mContext->timerQueryImpl;
@@ -275,6 +289,16 @@ void MetalDriver::setFrameCompletedCallback(
     swapChain->setFrameCompletedCallback(handler, std::move(callback));
 }
 
+void MetalDriver::queueCallback(CallbackHandler* handler,
+        CallbackHandler::Callback callback, void* user) {
+    if (!callback) {
+        return;
+    }
+    executeAfterCurrentCommandBufferCompletes([this, handler, callback, user]() {
+        scheduleCallback(handler, user, callback);
+    });
+}
+
 void MetalDriver::execute(std::function<void(void)> const& fn) noexcept {
     @autoreleasepool {
         fn();
@@ -290,7 +314,9 @@ void MetalDriver::endFrame(uint32_t frameId) {
     // be commands in it (like fence signaling) that need to execute.
     submitPendingCommands(mContext);
 
-    mContext->bufferPool->gc();
+    // Service the pools' eviction sweeps round-robin under a time budget, so their cost is
+    // spread across frames rather than spiking when they coincide.
+    mGcScheduler.run(GC_TIME_BUDGET);
 
     // If we acquired a drawable for this frame, ensure that we release it here.
     if (mContext->currentDrawSwapChain) {
@@ -866,6 +892,7 @@ void MetalDriver::terminate() {
     finish();
 
     mContext->bufferPool->reset();
+    mContext->argumentBufferPool->reset();
     mContext->commandQueue = nil;
 
     MetalExternalImage::shutdown(*mContext);
@@ -1082,6 +1109,10 @@ size_t MetalDriver::getMaxUniformBufferSize() {
     return 256 * 1024 * 1024;   // TODO: return the actual size instead of hardcoding the minspec
 }
 
+HandleAllocatorStats MetalDriver::getHandleAllocatorStats() {
+    return mHandleAllocator.getStats();
+}
+
 void MetalDriver::updateIndexBuffer(Handle<HwIndexBuffer> ibh, BufferDescriptor&& data,
         uint32_t byteOffset) {
     FILAMENT_CHECK_PRECONDITION(data.buffer)
@@ -1148,6 +1179,31 @@ void MetalDriver::update3DImage(Handle<HwTexture> th, uint32_t level,
             th.getId(), level, xoffset, yoffset, zoffset, width, height, depth);
 }
 
+void MetalDriver::update3DImageBatch(Handle<HwTexture> th,
+        uint32_t regionCount, BufferDescriptor&& regions, PixelBufferDescriptor&& data) {
+    FILAMENT_CHECK_PRECONDITION(!isInRenderPass(mContext))
+            << "update3DImageBatch must be called outside of a render pass.";
+    auto tex = handle_cast<MetalTexture>(th);
+    auto const* region = static_cast<TextureUpdateRegion const*>(regions.buffer);
+    // All the blits are encoded back-to-back from a single client buffer; loadImage draws its
+    // staging memory from the shared MetalBufferPool, which recycles it across regions.
+    for (uint32_t i = 0; i < regionCount; i++, region++) {
+        size_t const size = PixelBufferDescriptor::computeDataSize(data.format, data.type,
+                region->width, region->height, data.alignment) * region->depth;
+        PixelBufferDescriptor view(
+                static_cast<char const*>(data.buffer) + region->bufferOffset, size,
+                data.format, data.type, data.alignment);
+        tex->loadImage(region->level,
+                MTLRegionMake3D(region->xoffset, region->yoffset, region->zoffset,
+                        region->width, region->height, region->depth), view);
+    }
+    scheduleDestroy(std::move(regions));
+    scheduleDestroy(std::move(data));
+
+    DEBUG_LOG("update3DImageBatch(th = %d, regionCount = %d, data = ?)\n",
+            th.getId(), regionCount);
+}
+
 void MetalDriver::setupExternalImage(void* image) {
     // setupExternalImage is called on the Filament thread when creating a Texture or SwapChain from
     // a CVPixelBuffer external image. Here we take ownership of the passed in buffer by calling
@@ -1187,6 +1243,74 @@ void MetalDriver::compilePrograms(CompilerPriorityQueue priority,
     }
 }
 
+void MetalDriver::precachePipeline(PipelineState state, Handle<HwRenderTarget> rth) {
+    DEBUG_LOG("precachePipeline(state = { program = %d }, rth = %d)\n",
+            state.program.getId(), rth.getId());
+
+    auto renderTarget = handle_cast<MetalRenderTarget>(rth);
+    MetalVertexBufferInfo const* const vbi =
+            handle_cast<MetalVertexBufferInfo>(state.vertexBufferInfo);
+    auto program = handle_cast<MetalProgram>(state.program);
+    const auto& rs = state.rasterState;
+
+    // This might block until the shader compilation has finished, which is acceptable at load
+    // time (the point of pre-caching is to pay these costs before the first draw).
+    auto functions = program->getFunctions();
+    if (UTILS_UNLIKELY(!functions)) {
+        return;
+    }
+    auto [fragment, vertex] = functions.getRasterFunctions();
+
+    MTLPixelFormat colorPixelFormat[MRT::MAX_SUPPORTED_RENDER_TARGET_COUNT] = { MTLPixelFormatInvalid };
+    for (size_t i = 0; i < MRT::MAX_SUPPORTED_RENDER_TARGET_COUNT; i++) {
+        const auto& attachment = renderTarget->getDrawColorAttachment(i);
+        if (!attachment) {
+            continue;
+        }
+        colorPixelFormat[i] = attachment.getPixelFormat();
+    }
+    MTLPixelFormat depthPixelFormat = MTLPixelFormatInvalid;
+    const auto& depthAttachment = renderTarget->getDepthAttachment();
+    if (depthAttachment) {
+        depthPixelFormat = depthAttachment.getPixelFormat();
+    }
+    MTLPixelFormat stencilPixelFormat = MTLPixelFormatInvalid;
+    const auto& stencilAttachment = renderTarget->getStencilAttachment();
+    if (stencilAttachment) {
+        stencilPixelFormat = stencilAttachment.getPixelFormat();
+    }
+    MetalPipelineState const pipelineState {
+        .vertexFunction = vertex,
+        .fragmentFunction = fragment,
+        .vertexDescription = vbi->vertexDescription,
+        .colorAttachmentPixelFormat = {
+            colorPixelFormat[0],
+            colorPixelFormat[1],
+            colorPixelFormat[2],
+            colorPixelFormat[3],
+            colorPixelFormat[4],
+            colorPixelFormat[5],
+            colorPixelFormat[6],
+            colorPixelFormat[7]
+        },
+        .depthAttachmentPixelFormat = depthPixelFormat,
+        .stencilAttachmentPixelFormat = stencilPixelFormat,
+        .sampleCount = renderTarget->getSamples(),
+        .blendState = BlendState {
+            .alphaBlendOperation = getMetalBlendOperation(rs.blendEquationAlpha),
+            .rgbBlendOperation = getMetalBlendOperation(rs.blendEquationRGB),
+            .destinationAlphaBlendFactor = getMetalBlendFactor(rs.blendFunctionDstAlpha),
+            .destinationRGBBlendFactor = getMetalBlendFactor(rs.blendFunctionDstRGB),
+            .sourceAlphaBlendFactor = getMetalBlendFactor(rs.blendFunctionSrcAlpha),
+            .sourceRGBBlendFactor = getMetalBlendFactor(rs.blendFunctionSrcRGB),
+            .blendingEnabled = rs.hasBlending(),
+        },
+        .colorWrite = rs.colorWrite
+    };
+    // Populates the MTLRenderPipelineState cache without touching any encoder state.
+    mContext->pipelineStateCache.getOrCreateState(pipelineState);
+}
+
 void MetalDriver::beginRenderPass(Handle<HwRenderTarget> rth,
         const RenderPassParams& params) {
     DEBUG_LOG("beginRenderPass(rth = %d, params = {...})\n", rth.getId());
@@ -1845,6 +1969,15 @@ void MetalDriver::bindDescriptorSet(
     }
 }
 
+void MetalDriver::bindDescriptorSetAndDraw(
+        backend::DescriptorSetHandle dsh,
+        backend::descriptor_set_t set,
+        backend::DescriptorSetOffsetArray&& offsets,
+        uint32_t indexOffset, uint32_t indexCount, uint32_t instanceCount) {
+    bindDescriptorSet(dsh, set, std::move(offsets));
+    draw2(indexOffset, indexCount, instanceCount);
+}
+
 void MetalDriver::draw2(uint32_t indexOffset, uint32_t indexCount, uint32_t instanceCount) {
     FILAMENT_CHECK_PRECONDITION(mContext->currentRenderPassEncoder != nullptr)
             << "draw() without a valid command encoder.";
@@ -1883,6 +2016,53 @@ void MetalDriver::draw2(uint32_t indexOffset, uint32_t indexCount, uint32_t inst
                                                 instanceCount:instanceCount];
 }
 
+void MetalDriver::drawIndexedIndirect(Handle<HwBufferObject> indirectBuffer,
+        uint32_t const offset, uint32_t const drawCount, uint32_t const stride) {
+    FILAMENT_CHECK_PRECONDITION(mContext->currentRenderPassEncoder != nullptr)
+            << "drawIndexedIndirect() without a valid command encoder.";
+    DEBUG_LOG("drawIndexedIndirect(...)\n");
+
+    // Bind the offset data.
+    if (mContext->dynamicOffsets.isDirty()) {
+        const auto [size, data] = mContext->dynamicOffsets.getOffsets();
+        [mContext->currentRenderPassEncoder setFragmentBytes:data
+                                                      length:size * sizeof(uint32_t)
+                                                     atIndex:DYNAMIC_OFFSET_BINDING];
+        [mContext->currentRenderPassEncoder setVertexBytes:data
+                                                    length:size * sizeof(uint32_t)
+                                                   atIndex:DYNAMIC_OFFSET_BINDING];
+        mContext->dynamicOffsets.setDirty(false);
+    }
+
+    // Update push constants.
+    for (size_t i = 0; i < Program::SHADER_TYPE_COUNT; i++) {
+        auto& pushConstants = mContext->currentPushConstants[i];
+        if (UTILS_UNLIKELY(pushConstants.isDirty())) {
+            pushConstants.setBytes(mContext->currentRenderPassEncoder, static_cast<ShaderStage>(i));
+        }
+    }
+
+    auto primitive = handle_cast<MetalRenderPrimitive>(mContext->currentRenderPrimitive);
+
+    MetalIndexBuffer* indexBuffer = primitive->indexBuffer;
+    id<MTLBuffer> metalIndexBuffer = indexBuffer->buffer.getGpuBufferForDraw();
+
+    auto* bo = handle_cast<MetalBufferObject>(indirectBuffer);
+    id<MTLBuffer> metalIndirectBuffer = bo->getBuffer()->getGpuBufferForDraw();
+
+    // Metal has no multi-draw primitive short of MTLIndirectCommandBuffer, so each draw is
+    // encoded separately; the parameters are still sourced from the GPU buffer.
+    for (uint32_t i = 0; i < drawCount; i++) {
+        [mContext->currentRenderPassEncoder
+                drawIndexedPrimitives:getMetalPrimitiveType(primitive->type)
+                            indexType:getIndexType(indexBuffer->elementSize)
+                          indexBuffer:metalIndexBuffer
+                    indexBufferOffset:0
+                       indirectBuffer:metalIndirectBuffer
+                 indirectBufferOffset:offset + i * stride];
+    }
+}
+
 void MetalDriver::draw(PipelineState ps, Handle<HwRenderPrimitive> rph,
         uint32_t const indexOffset, uint32_t const indexCount, uint32_t const instanceCount) {
     MetalRenderPrimitive const* const rp = handle_cast<MetalRenderPrimitive>(rph);
@@ -49,6 +49,8 @@
 namespace filament {
 namespace backend {
 
+struct MetalBufferPoolEntry;
+
 class MetalSwapChain : public HwSwapChain {
 public:
 
@@ -471,6 +473,7 @@ private:
 
 struct MetalDescriptorSet : public HwDescriptorSet {
     MetalDescriptorSet(MetalDescriptorSetLayout* layout) noexcept;
+    ~MetalDescriptorSet();
 
     void finalize(MetalDriver* driver);
 
@@ -495,7 +498,12 @@ struct MetalDescriptorSet : public HwDescriptorSet {
 
     std::vector<std::shared_ptr<MetalExternalImage>> externalImages;
 
-    std::array<TrackedMetalBuffer, Program::SHADER_TYPE_COUNT> cachedBuffer = { nil };
+    // Argument buffers are recycled through the driver's argumentBufferPool rather than allocated
+    // per set; a new descriptor set is created every time its content changes, so per-set
+    // allocations add up quickly. The entries are released back to the pool by the destructor,
+    // which destroyDescriptorSet defers until the current command buffer has completed.
+    std::array<MetalBufferPoolEntry const*, Program::SHADER_TYPE_COUNT> cachedBuffer = { nullptr };
+    MetalBufferPool* argumentBufferPool = nullptr;
 };
 
 } // namespace backend
@@ -92,6 +92,12 @@ MetalSwapChain::MetalSwapChain(MetalContext& context, CAMetalLayer* nativeWindow
     nativeWindow.framebufferOnly = NO;
 
     layer.device = context.device;
+
+    // Apply the frame-latency policy by sizing the drawable pool. The pool defaults to 3
+    // drawables; 2 is the platform minimum and gives the lowest input latency.
+    if (uint64_t const latency = getSwapChainConfigFrameLatency(flags); latency) {
+        layer.maximumDrawableCount = (latency <= 2) ? 2 : 3;
+    }
 }
 
 MetalSwapChain::MetalSwapChain(MetalContext& context, int32_t width, int32_t height, uint64_t flags)
@@ -553,6 +559,14 @@ MetalTexture::MetalTexture(MetalContext& context, SamplerType target, uint8_t le
             descriptor.sampleCount = multisampled ? samples : 1;
             descriptor.usage = getMetalTextureUsage(usage);
             descriptor.storageMode = MTLStorageModePrivate;
+            // Transient attachments never need system-memory backing on Apple GPUs: their
+            // contents live and die in tile memory within a single render pass.
+            if (any(usage & TextureUsage::TRANSIENT_ATTACHMENT) &&
+                    context.supportsMemorylessRenderTargets) {
+                if (@available(macOS 11.0, *)) {
+                    descriptor.storageMode = MTLStorageModeMemoryless;
+                }
+            }
             texture = [context.device newTextureWithDescriptor:descriptor];
             break;
         case SamplerType::SAMPLER_CUBEMAP:
@@ -1322,6 +1336,16 @@ id<MTLArgumentEncoder> MetalDescriptorSetLayout::getArgumentEncoderSlow(id<MTLDe
 MetalDescriptorSet::MetalDescriptorSet(MetalDescriptorSetLayout* layout) noexcept
     : layout(layout) {}
 
+MetalDescriptorSet::~MetalDescriptorSet() {
+    // destroyDescriptorSet defers destruction until the current command buffer has completed, so
+    // the GPU is guaranteed to be finished with these argument buffers.
+    for (auto const* entry : cachedBuffer) {
+        if (entry) {
+            argumentBufferPool->releaseBuffer(entry);
+        }
+    }
+}
+
 void MetalDescriptorSet::finalize(MetalDriver* driver) {
     [driver->mContext->currentRenderPassEncoder useResource:driver->mContext->emptyBuffer
                                                       usage:MTLResourceUsageRead];
@@ -1354,7 +1378,7 @@ id<MTLBuffer> MetalDescriptorSet::finalizeAndGetBuffer(MetalDriver* driver, Shad
     auto& buffer = cachedBuffer[index];
 
     if (buffer) {
-        return buffer.get();
+        return buffer->buffer.get();
     }
 
     // Map all the texture bindings to their respective texture types.
@@ -1377,13 +1401,11 @@ id<MTLBuffer> MetalDescriptorSet::finalizeAndGetBuffer(MetalDriver* driver, Shad
     id<MTLArgumentEncoder> encoder =
             layout->getArgumentEncoder(context.device, stage, textureTypes);
 
-    {
-        ScopedAllocationTimer timer("descriptor_set");
-        buffer = { [context.device newBufferWithLength:encoder.encodedLength
-                                               options:MTLResourceStorageModeShared],
-            TrackedMetalBuffer::Type::DESCRIPTOR_SET };
-    }
-    [encoder setArgumentBuffer:buffer.get() offset:0];
+    // The pool may hand back a recycled buffer; the encoder below overwrites every binding, so no
+    // stale content can leak through.
+    argumentBufferPool = driver->mContext->argumentBufferPool;
+    buffer = argumentBufferPool->acquireBuffer(encoder.encodedLength);
+    [encoder setArgumentBuffer:buffer->buffer.get() offset:0];
 
     for (auto const& binding : bindings) {
         if (!hasShaderType(binding.stageFlags, stage)) {
@@ -1431,7 +1453,7 @@ id<MTLBuffer> MetalDescriptorSet::finalizeAndGetBuffer(MetalDriver* driver, Shad
         }
     }
 
-    return buffer.get();
+    return buffer->buffer.get();
 }
 
 } // namespace backend
@@ -229,6 +229,10 @@ size_t NoopDriver::getMaxUniformBufferSize() {
     return 16384u;
 }
 
+HandleAllocatorStats NoopDriver::getHandleAllocatorStats() {
+    return {};
+}
+
 void NoopDriver::updateIndexBuffer(Handle<HwIndexBuffer> ibh, BufferDescriptor&& p,
         uint32_t byteOffset) {
     scheduleDestroy(std::move(p));
@@ -258,6 +262,12 @@ void NoopDriver::update3DImage(Handle<HwTexture> th,
     scheduleDestroy(std::move(data));
 }
 
+void NoopDriver::update3DImageBatch(Handle<HwTexture> th,
+        uint32_t regionCount, BufferDescriptor&& regions, PixelBufferDescriptor&& data) {
+    scheduleDestroy(std::move(regions));
+    scheduleDestroy(std::move(data));
+}
+
 void NoopDriver::setupExternalImage(void* image) {
 }
 
@@ -283,6 +293,16 @@ void NoopDriver::compilePrograms(CompilerPriorityQueue priority,
     }
 }
 
+void NoopDriver::precachePipeline(PipelineState state, Handle<HwRenderTarget> rth) {
+}
+
+void NoopDriver::queueCallback(CallbackHandler* handler,
+        CallbackHandler::Callback callback, void* user) {
+    if (callback) {
+        scheduleCallback(handler, user, callback);
+    }
+}
+
 void NoopDriver::beginRenderPass(Handle<HwRenderTarget> rth, const RenderPassParams& params) {
 }
 
@@ -354,10 +374,21 @@ void NoopDriver::bindRenderPrimitive(Handle<HwRenderPrimitive> rph) {
 void NoopDriver::draw2(uint32_t indexOffset, uint32_t indexCount, uint32_t instanceCount) {
 }
 
+void NoopDriver::bindDescriptorSetAndDraw(
+        backend::DescriptorSetHandle dsh,
+        backend::descriptor_set_t set,
+        backend::DescriptorSetOffsetArray&& offsets,
+        uint32_t indexOffset, uint32_t indexCount, uint32_t instanceCount) {
+}
+
 void NoopDriver::draw(PipelineState pipelineState, Handle<HwRenderPrimitive> rph,
         uint32_t indexOffset, uint32_t indexCount, uint32_t instanceCount) {
 }
 
+void NoopDriver::drawIndexedIndirect(Handle<HwBufferObject> indirectBuffer,
+        uint32_t offset, uint32_t drawCount, uint32_t stride) {
+}
+
 void NoopDriver::dispatchCompute(Handle<HwProgram> program, math::uint3 workGroupCount) {
 }
 
@@ -676,6 +676,7 @@ void OpenGLContext::initExtensionsGLES(Extensions* ext, GLint major, GLint minor
     using namespace std::literals;
     ext->APPLE_color_buffer_packed_float = exts.has("GL_APPLE_color_buffer_packed_float"sv);
 #ifndef __EMSCRIPTEN__
+    ext->EXT_buffer_storage = exts.has("GL_EXT_buffer_storage"sv);
     ext->EXT_clip_control = exts.has("GL_EXT_clip_control"sv);
 #endif
     ext->EXT_clip_cull_distance = exts.has("GL_EXT_clip_cull_distance"sv);
@@ -751,6 +752,7 @@ void OpenGLContext::initExtensionsGL(Extensions* ext, GLint major, GLint minor)
     using namespace std::literals;
     ext->APPLE_color_buffer_packed_float = true;  // Assumes core profile.
     ext->ARB_shading_language_packing = exts.has("GL_ARB_shading_language_packing"sv);
+    ext->EXT_buffer_storage = exts.has("GL_ARB_buffer_storage"sv);
     ext->EXT_color_buffer_float = true;  // Assumes core profile.
     ext->EXT_color_buffer_half_float = true;  // Assumes core profile.
     ext->EXT_clip_cull_distance = true;
@@ -794,6 +796,10 @@ void OpenGLContext::initExtensionsGL(Extensions* ext, GLint major, GLint minor)
         ext->EXT_discard_framebuffer = true;
         ext->KHR_debug = true;
     }
+    // OpenGL 4.4 implies ARB_buffer_storage
+    if (major > 4 || (major == 4 && minor >= 4)) {
+        ext->EXT_buffer_storage = true;
+    }
     // OpenGL 4.5 implies EXT_clip_control
     if (major > 4 || (major == 4 && minor >= 5)) {
         ext->EXT_clip_control = true;
@@ -1193,6 +1199,35 @@ void OpenGLContext::resetState() noexcept {
     glDepthRangef(state.window.depthRange.x, state.window.depthRange.y);
 }
 
+#if FILAMENT_BACKEND_OPENGL_STATE_STATS
+void OpenGLContext::dumpStateStats(uint32_t frameId) noexcept {
+    constexpr uint32_t LOG_INTERVAL = 600;  // frames, i.e. ~10s at 60Hz
+    if (frameId % LOG_INTERVAL) {
+        return;
+    }
+    auto const hitRate = [](uint32_t filtered, uint32_t issued) -> uint32_t {
+        uint32_t const total = filtered + issued;
+        return total ? uint32_t(uint64_t(filtered) * 100 / total) : 0;
+    };
+    StateStats const& s = mStateStats;
+    slog.d << "OpenGL state cache, redundant calls filtered over the last "
+           << LOG_INTERVAL << " frames:\n"
+           << "  texture units:   " << hitRate(s.texturesFiltered, s.texturesIssued)
+           << "% of " << (s.texturesFiltered + s.texturesIssued) << '\n'
+           << "  enable/disable:  " << hitRate(s.capsFiltered, s.capsIssued)
+           << "% of " << (s.capsFiltered + s.capsIssued) << '\n'
+           << "  vertex attribs:  " << hitRate(s.attribsFiltered, s.attribsIssued)
+           << "% of " << (s.attribsFiltered + s.attribsIssued) << '\n'
+           << "  all shadowed:    "
+           << hitRate(s.filtered + s.capsFiltered + s.attribsFiltered,
+                   s.issued + s.capsIssued + s.attribsIssued)
+           << "% of " << (s.filtered + s.issued + s.capsFiltered + s.capsIssued
+                   + s.attribsFiltered + s.attribsIssued)
+           << io::endl;
+    mStateStats = {};
+}
+#endif
+
 void OpenGLContext::createTimerQuery(GLTimerQuery* query) {
     mTimerQueryFactory->createTimerQuery(query);
 }
@@ -45,6 +45,22 @@
 #include <stddef.h>
 #include <stdint.h>
 
+// Set to 1 to count how many state-setting calls the shadow-state cache filters out as
+// redundant vs actually issues to the driver (see OpenGLContext::dumpStateStats()). Off by
+// default because the counters dirty a cache line on every state call.
+#ifndef FILAMENT_BACKEND_OPENGL_STATE_STATS
+#   define FILAMENT_BACKEND_OPENGL_STATE_STATS 0
+#endif
+
+#if FILAMENT_BACKEND_OPENGL_STATE_STATS
+#   define STATE_STATS_COUNT(counter) (++mStateStats.counter)
+#   define STATE_STATS_COUNT_IF(cond, hit, miss) \
+        ((cond) ? ++mStateStats.hit : ++mStateStats.miss)
+#else
+#   define STATE_STATS_COUNT(counter) ((void)0)
+#   define STATE_STATS_COUNT_IF(cond, hit, miss) ((void)0)
+#endif
+
 namespace filament::backend {
 
 class OpenGLPlatform;
@@ -219,6 +235,7 @@ public:
     struct Extensions {
         bool APPLE_color_buffer_packed_float;
         bool ARB_shading_language_packing;
+        bool EXT_buffer_storage;
         bool EXT_clip_control;
         bool EXT_clip_cull_distance;
         bool EXT_color_buffer_float;
@@ -343,6 +360,25 @@ public:
     }
     void resetProgram() noexcept { state.program.use = 0; }
 
+#if FILAMENT_BACKEND_OPENGL_STATE_STATS
+    // Telemetry for the shadow-state cache. "filtered" calls were dropped because the
+    // shadow state already matched, "issued" calls were forwarded to the driver.
+    struct StateStats {
+        uint32_t issued = 0;            // calls guarded by update_state()
+        uint32_t filtered = 0;
+        uint32_t texturesIssued = 0;    // glActiveTexture/glBindTexture/glBindSampler
+        uint32_t texturesFiltered = 0;
+        uint32_t capsIssued = 0;        // glEnable/glDisable
+        uint32_t capsFiltered = 0;
+        uint32_t attribsIssued = 0;     // glEnableVertexAttribArray/glDisableVertexAttribArray
+        uint32_t attribsFiltered = 0;
+    };
+    StateStats const& getStateStats() const noexcept { return mStateStats; }
+    // logs the filtering hit rates at a fixed frame interval and resets the counters.
+    // Called once per frame from OpenGLDriver::endFrame().
+    void dumpStateStats(uint32_t frameId) noexcept;
+#endif
+
     FeatureLevel getFeatureLevel() const noexcept { return mFeatureLevel; }
 
     // This is the index of the context in use. Must be 0 or 1. This is used to manange the
@@ -435,7 +471,7 @@ public:
                     GLsizeiptr size = 0;
                 } buffers[MAX_BUFFER_BINDINGS];
             } targets[3];   // there are only 3 indexed buffer targets
-            GLuint genericBinding[7] = {};
+            GLuint genericBinding[8] = {};
         } buffers;
 
         struct {
@@ -600,6 +636,21 @@ private:
             Gets const& gets,
             Bugs const& bugs) noexcept;
 
+#if FILAMENT_BACKEND_OPENGL_STATE_STATS
+    // non-static so it can update the counters
+    template <typename T, typename F>
+    inline void update_state(T& state, T const& expected, F functor, bool force = false) noexcept {
+        if (UTILS_UNLIKELY(force || state != expected)) {
+            STATE_STATS_COUNT(issued);
+            state = expected;
+            functor();
+        } else {
+            STATE_STATS_COUNT(filtered);
+        }
+    }
+
+    StateStats mStateStats{};
+#else
     template <typename T, typename F>
     static inline void update_state(T& state, T const& expected, F functor, bool force = false) noexcept {
         if (UTILS_UNLIKELY(force || state != expected)) {
@@ -607,6 +658,7 @@ private:
             functor();
         }
     }
+#endif
 
     void setDefaultState() noexcept;
 };
@@ -654,6 +706,9 @@ constexpr size_t OpenGLContext::getIndexForBufferTarget(GLenum target) noexcept
 #ifndef FILAMENT_SILENCE_NOT_SUPPORTED_BY_ES2
         case GL_PIXEL_PACK_BUFFER:          index = 5; break;
         case GL_PIXEL_UNPACK_BUFFER:        index = 6; break;
+#if defined(BACKEND_OPENGL_LEVEL_GLES31)
+        case GL_DRAW_INDIRECT_BUFFER:       index = 7; break;
+#endif
 #endif
         default: break;
     }
@@ -665,6 +720,7 @@ constexpr size_t OpenGLContext::getIndexForBufferTarget(GLenum target) noexcept
 
 void OpenGLContext::activeTexture(GLuint unit) noexcept {
     assert_invariant(unit < MAX_TEXTURE_UNIT_COUNT);
+    STATE_STATS_COUNT_IF(state.textures.active == unit, texturesFiltered, texturesIssued);
     update_state(state.textures.active, unit, [&]() {
         glActiveTexture(GL_TEXTURE0 + unit);
     });
@@ -674,6 +730,8 @@ void OpenGLContext::bindSampler(GLuint unit, GLuint sampler) noexcept {
     assert_invariant(unit < MAX_TEXTURE_UNIT_COUNT);
     assert_invariant(mFeatureLevel >= FeatureLevel::FEATURE_LEVEL_1);
 #ifndef FILAMENT_SILENCE_NOT_SUPPORTED_BY_ES2
+    STATE_STATS_COUNT_IF(state.textures.units[unit].sampler == sampler,
+            texturesFiltered, texturesIssued);
     update_state(state.textures.units[unit].sampler, sampler, [&]() {
         glBindSampler(unit, sampler);
     });
@@ -762,6 +820,9 @@ void OpenGLContext::bindBufferRange(GLenum target, GLuint index, GLuint buffer,
 }
 
 void OpenGLContext::bindTexture(GLuint unit, GLuint target, GLuint texId) noexcept {
+    STATE_STATS_COUNT_IF(state.textures.units[unit].target == target
+            && state.textures.units[unit].id == texId
+            && target != GL_TEXTURE_EXTERNAL_OES, texturesFiltered, texturesIssued);
     update_state(state.textures.units[unit].target, target, [&]() {
         activeTexture(unit);
         glBindTexture(state.textures.units[unit].target, 0);
@@ -783,8 +844,11 @@ void OpenGLContext::enableVertexAttribArray(RenderPrimitive const* rp, GLuint in
     assert_invariant(index < rp->vertexAttribArray.size());
     bool const force = rp->stateVersion != state.age;
     if (UTILS_UNLIKELY(force || !rp->vertexAttribArray[index])) {
+        STATE_STATS_COUNT(attribsIssued);
         rp->vertexAttribArray.set(index);
         glEnableVertexAttribArray(index);
+    } else {
+        STATE_STATS_COUNT(attribsFiltered);
     }
 }
 
@@ -793,24 +857,33 @@ void OpenGLContext::disableVertexAttribArray(RenderPrimitive const* rp, GLuint i
     assert_invariant(index < rp->vertexAttribArray.size());
     bool const force = rp->stateVersion != state.age;
     if (UTILS_UNLIKELY(force || rp->vertexAttribArray[index])) {
+        STATE_STATS_COUNT(attribsIssued);
         rp->vertexAttribArray.unset(index);
         glDisableVertexAttribArray(index);
+    } else {
+        STATE_STATS_COUNT(attribsFiltered);
     }
 }
 
 void OpenGLContext::enable(GLenum cap) noexcept {
     size_t const index = getIndexForCap(cap);
     if (UTILS_UNLIKELY(!state.enables.caps[index])) {
+        STATE_STATS_COUNT(capsIssued);
         state.enables.caps.set(index);
         glEnable(cap);
+    } else {
+        STATE_STATS_COUNT(capsFiltered);
     }
 }
 
 void OpenGLContext::disable(GLenum cap) noexcept {
     size_t const index = getIndexForCap(cap);
     if (UTILS_UNLIKELY(state.enables.caps[index])) {
+        STATE_STATS_COUNT(capsIssued);
         state.enables.caps.unset(index);
         glDisable(cap);
+    } else {
+        STATE_STATS_COUNT(capsFiltered);
     }
 }
 
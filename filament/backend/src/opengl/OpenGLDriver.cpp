@@ -248,7 +248,9 @@ OpenGLDriver::OpenGLDriver(OpenGLPlatform* platform, const Platform::DriverConfi
           mShaderCompilerService(*this),
           mHandleAllocator("Handles",
                   driverConfig.handleArenaSize,
-                  driverConfig.disableHandleUseAfterFreeCheck),
+                  driverConfig.disableHandleUseAfterFreeCheck,
+                  driverConfig.enableHandleSanitizer,
+                  driverConfig.handleArenaPoolWeights),
           mDriverConfig(driverConfig),
           mCurrentPushConstants(new(std::nothrow) PushConstantBundle{}) {
 
@@ -311,6 +313,8 @@ void OpenGLDriver::terminate() {
 
     // because we called glFinish(), all callbacks should have been executed
     assert_invariant(mGpuCommandCompleteOps.empty());
+
+    terminateUniformStagingRing();
 #endif
 
     delete mCurrentPushConstants;
@@ -1685,6 +1689,13 @@ void OpenGLDriver::createSwapChainHeadlessR(Handle<HwSwapChain> sch,
         sc->rec709 = (flags & SWAP_CHAIN_CONFIG_SRGB_COLORSPACE &&
                       !mPlatform.isSRGBSwapChainSupported());
     }
+
+    if (UTILS_UNLIKELY(flags & SWAP_CHAIN_CONFIG_EXPORTABLE_IMAGE)) {
+        // the platform issued GL commands behind our back to create the backing image,
+        // resynchronize the GL state with our shadow state
+        sc->hasPlatformGLObjects = true;
+        mContext.resetState();
+    }
 }
 
 void OpenGLDriver::createTimerQueryR(Handle<HwTimerQuery> tqh, int) {
@@ -1879,7 +1890,12 @@ void OpenGLDriver::destroySwapChain(Handle<HwSwapChain> sch) {
 
     if (sch) {
         GLSwapChain* sc = handle_cast<GLSwapChain*>(sch);
+        bool const hasPlatformGLObjects = sc->hasPlatformGLObjects;
         mPlatform.destroySwapChain(sc->swapChain);
+        if (UTILS_UNLIKELY(hasPlatformGLObjects)) {
+            // the platform deleted GL objects, resynchronize with our shadow state
+            mContext.resetState();
+        }
         destruct(sch, sc);
     }
 }
@@ -2325,6 +2341,10 @@ size_t OpenGLDriver::getMaxUniformBufferSize() {
     return mContext.gets.max_uniform_block_size;
 }
 
+HandleAllocatorStats OpenGLDriver::getHandleAllocatorStats() {
+    return mHandleAllocator.getStats();
+}
+
 // ------------------------------------------------------------------------------------------------
 // Swap chains
 // ------------------------------------------------------------------------------------------------
@@ -2422,6 +2442,113 @@ void OpenGLDriver::updateIndexBuffer(
     CHECK_GL_ERROR(utils::slog.e)
 }
 
+#ifndef FILAMENT_SILENCE_NOT_SUPPORTED_BY_ES2
+
+void OpenGLDriver::initUniformStagingRing() noexcept {
+    auto& ring = mUniformStagingRing;
+    ring.initialized = true;
+#if defined(BACKEND_OPENGL_VERSION_GL) || (defined(GL_EXT_buffer_storage) && !defined(__EMSCRIPTEN__))
+    auto& gl = mContext;
+    if (!gl.ext.EXT_buffer_storage) {
+        return;
+    }
+    constexpr uint32_t RING_SIZE = 4u * 1024u * 1024u;
+    constexpr GLbitfield ACCESS = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    GLuint id;
+    glGenBuffers(1, &id);
+    // GL_COPY_READ_BUFFER is not tracked by OpenGLContext's binding cache, so it is safe
+    // to bind it directly.
+    glBindBuffer(GL_COPY_READ_BUFFER, id);
+#if defined(BACKEND_OPENGL_VERSION_GL)
+    glBufferStorage(GL_COPY_READ_BUFFER, RING_SIZE, nullptr, ACCESS);
+#else
+    glBufferStorageEXT(GL_COPY_READ_BUFFER, RING_SIZE, nullptr, ACCESS);
+#endif
+    void* const base = glMapBufferRange(GL_COPY_READ_BUFFER, 0, RING_SIZE, ACCESS);
+    if (UTILS_UNLIKELY(!base)) {
+        glDeleteBuffers(1, &id);
+        CHECK_GL_ERROR(utils::slog.e)
+        return;
+    }
+    ring.id = id;
+    ring.base = static_cast<uint8_t*>(base);
+    ring.size = RING_SIZE;
+    CHECK_GL_ERROR(utils::slog.e)
+#endif
+}
+
+void OpenGLDriver::terminateUniformStagingRing() noexcept {
+    auto& ring = mUniformStagingRing;
+    for (GLsync& fence: ring.fences) {
+        if (fence) {
+            glDeleteSync(fence);
+            fence = {};
+        }
+    }
+    if (ring.id) {
+        glBindBuffer(GL_COPY_READ_BUFFER, ring.id);
+        glUnmapBuffer(GL_COPY_READ_BUFFER);
+        glDeleteBuffers(1, &ring.id);
+        ring.id = 0;
+        ring.base = nullptr;
+        ring.size = 0;
+    }
+}
+
+bool OpenGLDriver::updateBufferObjectFromStagingRing(GLBufferObject* bo,
+        BufferDescriptor const& bd, uint32_t const byteOffset) noexcept {
+    auto& ring = mUniformStagingRing;
+    if (UTILS_UNLIKELY(!ring.initialized)) {
+        initUniformStagingRing();
+    }
+    size_t const segmentSize = ring.size / UniformStagingRing::SEGMENT_COUNT;
+    if (UTILS_UNLIKELY(!ring.id || bd.size > segmentSize)) {
+        return false; // unsupported, or too large for the ring; caller falls back
+    }
+
+    // glCopyBufferSubData requires 4-byte alignment of the source offset
+    uint32_t head = (ring.head + 3u) & ~3u;
+    // an allocation never straddles a segment boundary, so each one is protected by
+    // exactly one fence
+    if (head / segmentSize != (head + bd.size - 1) / segmentSize) {
+        head = uint32_t((head / segmentSize + 1) * segmentSize);
+    }
+    if (head + bd.size > ring.size) {
+        head = 0; // wrap around
+    }
+
+    size_t const segment = head / segmentSize;
+    if (segment != ring.currentSegment) {
+        // We're leaving a segment, fence it so we know when the GPU is done reading from it.
+        assert_invariant(!ring.fences[ring.currentSegment]);
+        ring.fences[ring.currentSegment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        // Then wait until the GPU has consumed the previous contents of the segment we're
+        // entering. This only stalls if the CPU gets more than SEGMENT_COUNT-1 segments
+        // ahead of the GPU.
+        if (GLsync const sync = ring.fences[segment]) {
+            glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT,
+                    std::numeric_limits<GLuint64>::max());
+            glDeleteSync(sync);
+            ring.fences[segment] = nullptr;
+        }
+        ring.currentSegment = segment;
+    }
+
+    memcpy(ring.base + head, bd.buffer, bd.size);
+    ring.head = head + uint32_t(bd.size);
+
+    // The copy executes on the GPU timeline, after any draw already submitted against the
+    // destination buffer, so the destination is neither orphaned nor ghosted by the driver.
+    auto& gl = mContext;
+    glBindBuffer(GL_COPY_READ_BUFFER, ring.id);
+    gl.bindBuffer(bo->gl.binding, bo->gl.id);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, bo->gl.binding,
+            head, byteOffset, (GLsizeiptr)bd.size);
+    return true;
+}
+
+#endif // FILAMENT_SILENCE_NOT_SUPPORTED_BY_ES2
+
 void OpenGLDriver::updateBufferObject(
         Handle<HwBufferObject> boh, BufferDescriptor&& bd, uint32_t byteOffset) {
     DEBUG_MARKER()
@@ -2441,14 +2568,24 @@ void OpenGLDriver::updateBufferObject(
         bo->age++;
     } else {
         assert_invariant(bo->gl.id);
-        gl.bindBuffer(bo->gl.binding, bo->gl.id);
-        if (byteOffset == 0 && bd.size == bo->byteCount) {
-            // it looks like it's generally faster (or not worse) to use glBufferData()
-            glBufferData(bo->gl.binding, (GLsizeiptr)bd.size, bd.buffer, getBufferUsage(bo->usage));
-        } else {
-            // glBufferSubData() could be catastrophically inefficient if several are
-            // issued during the same frame. Currently, we're not doing that though.
-            glBufferSubData(bo->gl.binding, byteOffset, (GLsizeiptr)bd.size, bd.buffer);
+#ifndef FILAMENT_SILENCE_NOT_SUPPORTED_BY_ES2
+        if (bo->bindingType == BufferObjectBinding::UNIFORM &&
+                bo->usage == BufferUsage::DYNAMIC &&
+                updateBufferObjectFromStagingRing(bo, bd, byteOffset)) {
+            // updated through the persistent staging ring, nothing else to do
+        } else
+#endif
+        {
+            gl.bindBuffer(bo->gl.binding, bo->gl.id);
+            if (byteOffset == 0 && bd.size == bo->byteCount) {
+                // it looks like it's generally faster (or not worse) to use glBufferData()
+                glBufferData(bo->gl.binding, (GLsizeiptr)bd.size, bd.buffer,
+                        getBufferUsage(bo->usage));
+            } else {
+                // glBufferSubData() could be catastrophically inefficient if several are
+                // issued during the same frame. Currently, we're not doing that though.
+                glBufferSubData(bo->gl.binding, byteOffset, (GLsizeiptr)bd.size, bd.buffer);
+            }
         }
     }
 
@@ -2536,6 +2673,27 @@ void OpenGLDriver::update3DImage(Handle<HwTexture> th,
     }
 }
 
+void OpenGLDriver::update3DImageBatch(Handle<HwTexture> th,
+        uint32_t regionCount, BufferDescriptor&& regions, PixelBufferDescriptor&& data) {
+    DEBUG_MARKER()
+
+    GLTexture* t = handle_cast<GLTexture*>(th);
+    auto const* region = static_cast<TextureUpdateRegion const*>(regions.buffer);
+    // GL has no multi-region upload, but issuing all the glTexSubImage calls back-to-back from a
+    // single client buffer still amortizes the texture binding and pixel-store setup.
+    for (uint32_t i = 0; i < regionCount; i++, region++) {
+        size_t const size = PixelBufferDescriptor::computeDataSize(data.format, data.type,
+                region->width, region->height, data.alignment) * region->depth;
+        setTextureData(t, region->level,
+                region->xoffset, region->yoffset, region->zoffset,
+                region->width, region->height, region->depth,
+                { static_cast<char const*>(data.buffer) + region->bufferOffset, size,
+                        data.format, data.type, data.alignment });
+    }
+    scheduleDestroy(std::move(regions));
+    scheduleDestroy(std::move(data));
+}
+
 void OpenGLDriver::generateMipmaps(Handle<HwTexture> th) {
     DEBUG_MARKER()
 
@@ -2890,6 +3048,17 @@ void OpenGLDriver::compilePrograms(CompilerPriorityQueue,
     }
 }
 
+void OpenGLDriver::precachePipeline(PipelineState state, Handle<HwRenderTarget> rth) {
+    // There is no monolithic pipeline object in GL; the program *is* the pipeline. But a
+    // pre-warm request means a draw using this program is imminent, so if its compilation is
+    // still pending, move it ahead of any queued background compiles instead of letting the
+    // draw block behind them.
+    if (state.program) {
+        OpenGLProgram const* const p = handle_cast<OpenGLProgram*>(state.program);
+        p->prioritize(getShaderCompilerService());
+    }
+}
+
 void OpenGLDriver::beginRenderPass(Handle<HwRenderTarget> rth,
         const RenderPassParams& params) {
     DEBUG_MARKER()
@@ -3477,6 +3646,25 @@ void OpenGLDriver::setFrameCompletedCallback(Handle<HwSwapChain> sch,
     DEBUG_MARKER()
 }
 
+void OpenGLDriver::queueCallback(CallbackHandler* handler,
+        CallbackHandler::Callback callback, void* user) {
+    DEBUG_MARKER()
+    if (!callback) {
+        return;
+    }
+#ifndef FILAMENT_SILENCE_NOT_SUPPORTED_BY_ES2
+    if (!mContext.isES2()) {
+        whenGpuCommandsComplete([this, handler, callback, user]() {
+            scheduleCallback(handler, user, callback);
+        });
+        return;
+    }
+#endif
+    // Without fence syncs we can't observe GPU completion; wait for command execution instead.
+    glFinish();
+    scheduleCallback(handler, user, callback);
+}
+
 void OpenGLDriver::setPresentationTime(int64_t monotonic_clock_ns) {
     DEBUG_MARKER()
     mPlatform.setPresentationTime(monotonic_clock_ns);
@@ -3499,6 +3687,9 @@ void OpenGLDriver::endFrame(UTILS_UNUSED uint32_t frameId) {
 #endif
     //SYSTRACE_NAME("glFinish");
     //glFinish();
+#if FILAMENT_BACKEND_OPENGL_STATE_STATS
+    mContext.dumpStateStats(frameId);
+#endif
     mPlatform.endFrame(frameId);
     insertEventMarker("endFrame");
 }
@@ -3998,6 +4189,63 @@ void OpenGLDriver::draw2GLES2(uint32_t indexOffset, uint32_t indexCount, uint32_
 #endif
 }
 
+void OpenGLDriver::drawIndexedIndirect(Handle<HwBufferObject> indirectBuffer,
+        uint32_t const offset, uint32_t const drawCount, uint32_t const stride) {
+    DEBUG_MARKER()
+    assert_invariant(!mContext.isES2());
+    assert_invariant(mBoundRenderPrimitive);
+#if FILAMENT_ENABLE_MATDBG
+    if (UTILS_UNLIKELY(!mValidProgram)) {
+        return;
+    }
+#endif
+    assert_invariant(mBoundProgram);
+    assert_invariant(mValidProgram);
+
+    // When the program changes, we might have to rebind all or some descriptors
+    auto const invalidDescriptorSets =
+            mInvalidDescriptorSetBindings | mInvalidDescriptorSetBindingOffsets;
+    if (UTILS_UNLIKELY(invalidDescriptorSets.any())) {
+        updateDescriptors(invalidDescriptorSets);
+    }
+
+#if defined(BACKEND_OPENGL_LEVEL_GLES31)
+
+#if defined(__ANDROID__)
+    // on Android, GLES3.1 and above entry-points are defined in glext
+    // (this is temporary, until we phase-out API < 21)
+    using glext::glDrawElementsIndirect;
+#endif
+
+    GLRenderPrimitive const* const rp = mBoundRenderPrimitive;
+    GLBufferObject const* const bo = handle_cast<GLBufferObject*>(indirectBuffer);
+    assert_invariant(bo->gl.binding == GL_DRAW_INDIRECT_BUFFER);
+    mContext.bindBuffer(GL_DRAW_INDIRECT_BUFFER, bo->gl.id);
+
+#if defined(BACKEND_OPENGL_VERSION_GL)
+    if (mContext.isAtLeastGL<4, 3>()) {
+        glMultiDrawElementsIndirect(GLenum(rp->type), rp->gl.getIndicesType(),
+                reinterpret_cast<const void*>(uintptr_t(offset)),
+                (GLsizei)drawCount, (GLsizei)stride);
+    } else
+#endif
+    {
+        // ES 3.1 has no multi-draw entry point, issue each draw individually; the draw
+        // parameters are still sourced from the GPU buffer.
+        for (uint32_t i = 0; i < drawCount; i++) {
+            glDrawElementsIndirect(GLenum(rp->type), rp->gl.getIndicesType(),
+                    reinterpret_cast<const void*>(uintptr_t(offset) + i * stride));
+        }
+    }
+#endif // BACKEND_OPENGL_LEVEL_GLES31
+
+#if FILAMENT_ENABLE_MATDBG
+    CHECK_GL_ERROR_NON_FATAL(utils::slog.e)
+#else
+    CHECK_GL_ERROR(utils::slog.e)
+#endif
+}
+
 void OpenGLDriver::scissor(Viewport scissor) {
     DEBUG_MARKER()
     setScissor(scissor);
@@ -4018,6 +4266,20 @@ void OpenGLDriver::draw(PipelineState state, Handle<HwRenderPrimitive> rph,
     }
 }
 
+void OpenGLDriver::bindDescriptorSetAndDraw(
+        backend::DescriptorSetHandle dsh,
+        backend::descriptor_set_t set,
+        backend::DescriptorSetOffsetArray&& offsets,
+        uint32_t const indexOffset, uint32_t const indexCount, uint32_t const instanceCount) {
+    DEBUG_MARKER()
+    bindDescriptorSet(dsh, set, std::move(offsets));
+    if (UTILS_UNLIKELY(mContext.isES2())) {
+        draw2GLES2(indexOffset, indexCount, instanceCount);
+    } else {
+        draw2(indexOffset, indexCount, instanceCount);
+    }
+}
+
 void OpenGLDriver::dispatchCompute(Handle<HwProgram> program, math::uint3 workGroupCount) {
     DEBUG_MARKER()
     getShaderCompilerService().tick();
@@ -96,6 +96,8 @@ public:
     struct GLSwapChain : public HwSwapChain {
         using HwSwapChain::HwSwapChain;
         bool rec709 = false;
+        // the platform created GL objects for this swapchain (exportable image path)
+        bool hasPlatformGLObjects = false;
     };
 
     struct GLVertexBufferInfo : public HwVertexBufferInfo {
@@ -366,6 +368,26 @@ private:
 
     void whenFrameComplete(const std::function<void()>& fn) noexcept;
     std::vector<std::function<void()>> mFrameCompleteOps;
+
+    // Persistently mapped staging ring for uniform buffer updates. Data is written to the
+    // ring on the CPU and copied into the destination buffer on the GPU, which avoids both
+    // the CPU cost of orphaning (glBufferData) and driver-side ghost allocations when the
+    // destination buffer is still referenced by in-flight draws. Requires EXT_buffer_storage
+    // (core in GL 4.4).
+    struct UniformStagingRing {
+        static constexpr size_t SEGMENT_COUNT = 4;
+        GLuint id = 0;                      // 0 if unsupported or creation failed
+        uint8_t* base = nullptr;            // persistent coherent mapping
+        uint32_t size = 0;                  // total size in bytes
+        uint32_t head = 0;                  // current write offset
+        size_t currentSegment = 0;
+        GLsync fences[SEGMENT_COUNT] = {};  // protects each segment from premature reuse
+        bool initialized = false;           // creation was attempted
+    } mUniformStagingRing;
+    void initUniformStagingRing() noexcept;
+    void terminateUniformStagingRing() noexcept;
+    bool updateBufferObjectFromStagingRing(GLBufferObject* bo,
+            BufferDescriptor const& bd, uint32_t byteOffset) noexcept;
 #endif
 
     // tasks regularly executed on the main thread at until they return true
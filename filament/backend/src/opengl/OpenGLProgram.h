@@ -75,6 +75,13 @@ public:
         return true;
     }
 
+    // moves this program's pending compilation, if any, ahead of queued background work
+    void prioritize(ShaderCompilerService& compiler) const noexcept {
+        if (UTILS_UNLIKELY(mToken)) {
+            compiler.prioritize(mToken);
+        }
+    }
+
     GLuint getBufferBinding(descriptor_set_t set, descriptor_binding_t binding) const noexcept {
         return mBindingMap.get(set, binding);
     }
@@ -423,6 +423,35 @@ void ShaderCompilerService::tick() {
     }
 }
 
+void ShaderCompilerService::prioritize(program_token_t const& token) noexcept {
+    if (UTILS_UNLIKELY(!token || token->canceled)) {
+        return;
+    }
+    if (mMode == Mode::THREAD_POOL) {
+        mCompilerThreadPool.makeUrgent(token);
+    } else if (mMode == Mode::ASYNCHRONOUS) {
+        // Move this token's tick op into the high-priority bucket, so its completion status is
+        // polled -- and the program linked -- before any queued background work. The op itself
+        // keeps polling GL_COMPLETION_STATUS, we never block here.
+        auto& ops = mRunAtNextTickOps;
+        auto const pos = std::find_if(ops.begin(), ops.end(), [&](const auto& item) {
+            return std::get<1>(item) == token;
+        });
+        if (pos != ops.end() && std::get<0>(*pos) != CompilerPriorityQueue::HIGH) {
+            ContainerType item = std::move(*pos);
+            ops.erase(pos);
+            std::get<0>(item) = CompilerPriorityQueue::HIGH;
+            // reinsert while keeping the priority ordering invariant of mRunAtNextTickOps
+            auto const ipos = std::lower_bound(ops.begin(), ops.end(),
+                    CompilerPriorityQueue::HIGH,
+                    [](ContainerType const& lhs, CompilerPriorityQueue priorityQueue) {
+                        return std::get<0>(lhs) < priorityQueue;
+                    });
+            ops.insert(ipos, std::move(item));
+        }
+    }
+}
+
 void ShaderCompilerService::notifyWhenAllProgramsAreReady(
         CallbackHandler* handler, CallbackHandler::Callback callback, void* user) {
     if (callback) {
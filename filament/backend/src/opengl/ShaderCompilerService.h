@@ -81,6 +81,11 @@ public:
     // Must be called at least once per frame.
     void tick();
 
+    // Moves a pending compilation ahead of any queued lower-priority work. Called when we learn
+    // that the program is about to be needed for a draw (see precachePipeline), so it doesn't
+    // sit behind long-running background precompiles.
+    void prioritize(program_token_t const& token) noexcept;
+
     // Destroys a valid token and all associated resources. Used to "cancel" a program compilation.
     static void terminate(program_token_t& token);
 
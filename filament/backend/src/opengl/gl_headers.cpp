@@ -64,6 +64,9 @@ PFNGLCLIPCONTROLEXTPROC glClipControlEXT;
 #ifdef GL_EXT_discard_framebuffer
 PFNGLDISCARDFRAMEBUFFEREXTPROC glDiscardFramebufferEXT;
 #endif
+#ifdef GL_EXT_buffer_storage
+PFNGLBUFFERSTORAGEEXTPROC glBufferStorageEXT;
+#endif
 #ifdef GL_KHR_parallel_shader_compile
 PFNGLMAXSHADERCOMPILERTHREADSKHRPROC glMaxShaderCompilerThreadsKHR;
 #endif
@@ -75,6 +78,7 @@ PFNGLFRAMEBUFFERTEXTUREMULTIVIEWOVRPROC glFramebufferTextureMultiviewOVR;
 // On Android, If we want to support a build system less than ANDROID_API 21, we need to
 // use getProcAddress for ES3.1 and above entry points.
 PFNGLDISPATCHCOMPUTEPROC glDispatchCompute;
+PFNGLDRAWELEMENTSINDIRECTPROC glDrawElementsIndirect;
 #endif
 static std::once_flag sGlExtInitialized;
 #endif // __EMSCRIPTEN__
@@ -117,6 +121,9 @@ void importGLESExtensionsEntryPoints() {
 #ifdef GL_EXT_discard_framebuffer
         getProcAddress(glDiscardFramebufferEXT, "glDiscardFramebufferEXT");
 #endif
+#ifdef GL_EXT_buffer_storage
+        getProcAddress(glBufferStorageEXT, "glBufferStorageEXT");
+#endif
 #ifdef GL_KHR_parallel_shader_compile
         getProcAddress(glMaxShaderCompilerThreadsKHR, "glMaxShaderCompilerThreadsKHR");
 #endif
@@ -125,6 +132,7 @@ void importGLESExtensionsEntryPoints() {
 #endif
 #if defined(__ANDROID__) && !defined(FILAMENT_SILENCE_NOT_SUPPORTED_BY_ES2)
         getProcAddress(glDispatchCompute, "glDispatchCompute");
+        getProcAddress(glDrawElementsIndirect, "glDrawElementsIndirect");
 #endif
     });
 #endif // __EMSCRIPTEN__
@@ -148,6 +148,9 @@ extern PFNGLGENVERTEXARRAYSOESPROC glGenVertexArraysOES;
 #ifdef GL_EXT_discard_framebuffer
 extern PFNGLDISCARDFRAMEBUFFEREXTPROC glDiscardFramebufferEXT;
 #endif
+#ifdef GL_EXT_buffer_storage
+extern PFNGLBUFFERSTORAGEEXTPROC glBufferStorageEXT;
+#endif
 #ifdef GL_KHR_parallel_shader_compile
 extern PFNGLMAXSHADERCOMPILERTHREADSKHRPROC glMaxShaderCompilerThreadsKHR;
 #endif
@@ -156,6 +159,7 @@ extern PFNGLFRAMEBUFFERTEXTUREMULTIVIEWOVRPROC glFramebufferTextureMultiviewOVR;
 #endif
 #if defined(__ANDROID__) && !defined(FILAMENT_SILENCE_NOT_SUPPORTED_BY_ES2)
 extern PFNGLDISPATCHCOMPUTEPROC glDispatchCompute;
+extern PFNGLDRAWELEMENTSINDIRECTPROC glDrawElementsIndirect;
 #endif
 #endif // __EMSCRIPTEN__
 } // namespace glext
@@ -179,6 +183,14 @@ using namespace glext;
 #   define GL_ZERO_TO_ONE                           GL_ZERO_TO_ONE_EXT
 #endif
 
+#ifdef GL_EXT_buffer_storage
+#   ifndef GL_MAP_PERSISTENT_BIT
+#       define GL_MAP_PERSISTENT_BIT                GL_MAP_PERSISTENT_BIT_EXT
+#       define GL_MAP_COHERENT_BIT                  GL_MAP_COHERENT_BIT_EXT
+#       define GL_DYNAMIC_STORAGE_BIT               GL_DYNAMIC_STORAGE_BIT_EXT
+#   endif
+#endif
+
 #ifdef GL_KHR_parallel_shader_compile
 #   define GL_COMPLETION_STATUS                     GL_COMPLETION_STATUS_KHR
 #else
@@ -62,6 +62,10 @@ UTILS_PRIVATE PFNEGLDESTROYSYNCKHRPROC eglDestroySyncKHR = {};
 UTILS_PRIVATE PFNEGLCLIENTWAITSYNCKHRPROC eglClientWaitSyncKHR = {};
 UTILS_PRIVATE PFNEGLCREATEIMAGEKHRPROC eglCreateImageKHR = {};
 UTILS_PRIVATE PFNEGLDESTROYIMAGEKHRPROC eglDestroyImageKHR = {};
+#ifdef EGL_MESA_image_dma_buf_export
+UTILS_PRIVATE PFNEGLEXPORTDMABUFIMAGEQUERYMESAPROC eglExportDMABUFImageQueryMESA = {};
+UTILS_PRIVATE PFNEGLEXPORTDMABUFIMAGEMESAPROC eglExportDMABUFImageMESA = {};
+#endif
 }
 using namespace glext;
 
@@ -152,9 +156,11 @@ Driver* PlatformEGL::createDriver(void* sharedContext, const Platform::DriverCon
     ext.egl.ANDROID_recordable = extensions.has("EGL_ANDROID_recordable");
     ext.egl.KHR_gl_colorspace = extensions.has("EGL_KHR_gl_colorspace");
     ext.egl.KHR_create_context = extensions.has("EGL_KHR_create_context");
+    ext.egl.KHR_gl_renderbuffer_image = extensions.has("EGL_KHR_gl_renderbuffer_image");
     ext.egl.KHR_no_config_context = extensions.has("EGL_KHR_no_config_context");
     ext.egl.KHR_surfaceless_context = extensions.has("EGL_KHR_surfaceless_context");
     ext.egl.EXT_protected_content = extensions.has("EGL_EXT_protected_content");
+    ext.egl.MESA_image_dma_buf_export = extensions.has("EGL_MESA_image_dma_buf_export");
 
     eglCreateSyncKHR = (PFNEGLCREATESYNCKHRPROC) eglGetProcAddress("eglCreateSyncKHR");
     eglDestroySyncKHR = (PFNEGLDESTROYSYNCKHRPROC) eglGetProcAddress("eglDestroySyncKHR");
@@ -163,6 +169,13 @@ Driver* PlatformEGL::createDriver(void* sharedContext, const Platform::DriverCon
     eglCreateImageKHR = (PFNEGLCREATEIMAGEKHRPROC) eglGetProcAddress("eglCreateImageKHR");
     eglDestroyImageKHR = (PFNEGLDESTROYIMAGEKHRPROC) eglGetProcAddress("eglDestroyImageKHR");
 
+#ifdef EGL_MESA_image_dma_buf_export
+    eglExportDMABUFImageQueryMESA = (PFNEGLEXPORTDMABUFIMAGEQUERYMESAPROC)
+            eglGetProcAddress("eglExportDMABUFImageQueryMESA");
+    eglExportDMABUFImageMESA = (PFNEGLEXPORTDMABUFIMAGEMESAPROC)
+            eglGetProcAddress("eglExportDMABUFImageMESA");
+#endif
+
     EGLint const pbufferAttribs[] = {
             EGL_WIDTH,  1,
             EGL_HEIGHT, 1,
@@ -502,6 +515,17 @@ Platform::SwapChain* PlatformEGL::createSwapChain(
 Platform::SwapChain* PlatformEGL::createSwapChain(
         uint32_t width, uint32_t height, uint64_t flags) noexcept {
 
+    if (UTILS_UNLIKELY(flags & SWAP_CHAIN_CONFIG_EXPORTABLE_IMAGE)) {
+        if (isExportableSwapChainSupported()) {
+            return createExportableSwapChain(width, height, flags);
+        }
+        // fall through to a regular pbuffer swapchain, frames won't be exportable
+        slog.w << "SWAP_CHAIN_CONFIG_EXPORTABLE_IMAGE requested but "
+                  "EGL_KHR_gl_renderbuffer_image / EGL_MESA_image_dma_buf_export "
+                  "are not available" << io::endl;
+        flags &= ~SWAP_CHAIN_CONFIG_EXPORTABLE_IMAGE;
+    }
+
     Config attribs = {
             { EGL_WIDTH,  EGLint(width) },
             { EGL_HEIGHT, EGLint(height) },
@@ -549,9 +573,132 @@ Platform::SwapChain* PlatformEGL::createSwapChain(
     return sc;
 }
 
+Platform::SwapChain* PlatformEGL::createExportableSwapChain(
+        uint32_t width, uint32_t height, uint64_t flags) noexcept {
+#if defined(EGL_KHR_gl_renderbuffer_image) && defined(EGL_MESA_image_dma_buf_export)
+    // We're on the driver thread with the context current. Render into a GL renderbuffer
+    // wrapped in an EGLImage: unlike a pbuffer, the EGLImage can be exported as a dmabuf.
+    GLuint rbo = 0;
+    glGenRenderbuffers(1, &rbo);
+    glBindRenderbuffer(GL_RENDERBUFFER, rbo);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, GLsizei(width), GLsizei(height));
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    EGLImageKHR const image = eglCreateImageKHR(mEGLDisplay, mEGLContext,
+            EGL_GL_RENDERBUFFER_KHR, (EGLClientBuffer)(uintptr_t)rbo, nullptr);
+    if (UTILS_UNLIKELY(image == EGL_NO_IMAGE_KHR)) {
+        logEglError("PlatformEGL::createExportableSwapChain: eglCreateImageKHR");
+        glDeleteRenderbuffers(1, &rbo);
+        return nullptr;
+    }
+
+    // the depth/stencil buffer stays private, only the color plane is exported
+    GLuint depthRbo = 0;
+    glGenRenderbuffers(1, &depthRbo);
+    glBindRenderbuffer(GL_RENDERBUFFER, depthRbo);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, GLsizei(width), GLsizei(height));
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    GLuint fbo = 0;
+    glGenFramebuffers(1, &fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, rbo);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT,
+            GL_RENDERBUFFER, depthRbo);
+    GLenum const status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    if (UTILS_UNLIKELY(status != GL_FRAMEBUFFER_COMPLETE)) {
+        slog.e << "PlatformEGL::createExportableSwapChain: framebuffer incomplete, status="
+               << io::hex << status << io::endl;
+        glDeleteFramebuffers(1, &fbo);
+        glDeleteRenderbuffers(1, &depthRbo);
+        eglDestroyImageKHR(mEGLDisplay, image);
+        glDeleteRenderbuffers(1, &rbo);
+        return nullptr;
+    }
+
+    SwapChainEGL* const sc = new(std::nothrow) SwapChainEGL({
+            .flags = flags,
+            .image = image,
+            .fbo = fbo,
+            .rbo = rbo,
+            .depthRbo = depthRbo,
+    });
+    return sc;
+#else
+    return nullptr;
+#endif
+}
+
+void PlatformEGL::destroyExportableSwapChain(SwapChainEGL const* sc) noexcept {
+    if (mCurrentDrawSwapChain == sc) {
+        mCurrentDrawSwapChain = nullptr;
+    }
+    GLuint const buffers[2] = { sc->rbo, sc->depthRbo };
+    GLuint const fbo = sc->fbo;
+    glDeleteFramebuffers(1, &fbo);
+    if (sc->image != EGL_NO_IMAGE_KHR) {
+        eglDestroyImageKHR(mEGLDisplay, sc->image);
+    }
+    glDeleteRenderbuffers(2, buffers);
+    delete sc;
+}
+
+bool PlatformEGL::isExportableSwapChainSupported() const noexcept {
+    return ext.egl.KHR_gl_renderbuffer_image && ext.egl.MESA_image_dma_buf_export;
+}
+
+bool PlatformEGL::exportSwapChainImage(
+        Platform::SwapChain* swapChain, ExportedSharedImage* outImage) noexcept {
+#ifdef EGL_MESA_image_dma_buf_export
+    SwapChainEGL const* const sc = static_cast<SwapChainEGL const*>(swapChain);
+    if (UTILS_UNLIKELY(!sc || sc->image == EGL_NO_IMAGE_KHR || !eglExportDMABUFImageMESA)) {
+        return false;
+    }
+    int fourcc = 0;
+    int numPlanes = 0;
+    EGLuint64KHR modifier = 0;
+    if (eglExportDMABUFImageQueryMESA(mEGLDisplay, sc->image,
+            &fourcc, &numPlanes, &modifier) != EGL_TRUE) {
+        logEglError("PlatformEGL::exportSwapChainImage: eglExportDMABUFImageQueryMESA");
+        return false;
+    }
+    if (UTILS_UNLIKELY(numPlanes != 1)) {
+        // we created a single-plane RGBA image, anything else is unexpected
+        return false;
+    }
+    int fd = -1;
+    int stride = 0;
+    int offset = 0;
+    if (eglExportDMABUFImageMESA(mEGLDisplay, sc->image, &fd, &stride, &offset) != EGL_TRUE) {
+        logEglError("PlatformEGL::exportSwapChainImage: eglExportDMABUFImageMESA");
+        return false;
+    }
+    outImage->fd = fd;
+    outImage->fourcc = uint32_t(fourcc);
+    outImage->modifier = modifier;
+    outImage->stride = stride;
+    outImage->offset = offset;
+    return true;
+#else
+    return false;
+#endif
+}
+
+uint32_t PlatformEGL::getDefaultFramebufferObject() noexcept {
+    if (mCurrentDrawSwapChain && mCurrentDrawSwapChain->fbo) {
+        return mCurrentDrawSwapChain->fbo;
+    }
+    return OpenGLPlatform::getDefaultFramebufferObject();
+}
+
 void PlatformEGL::destroySwapChain(Platform::SwapChain* swapChain) noexcept {
     if (swapChain) {
         SwapChainEGL const* const sc = static_cast<SwapChainEGL const*>(swapChain);
+        if (UTILS_UNLIKELY(sc->flags & SWAP_CHAIN_CONFIG_EXPORTABLE_IMAGE)) {
+            destroyExportableSwapChain(sc);
+            return;
+        }
         if (sc->sur != EGL_NO_SURFACE) {
             // - if EGL_KHR_surfaceless_context is supported, mEGLDummySurface is EGL_NO_SURFACE.
             // - this is actually a bit too aggressive, but it is a rare operation.
@@ -579,7 +726,14 @@ bool PlatformEGL::makeCurrent(ContextType type,
     SwapChainEGL const* const dsc = static_cast<SwapChainEGL const*>(drawSwapChain);
     SwapChainEGL const* const rsc = static_cast<SwapChainEGL const*>(readSwapChain);
     EGLContext context = getContextForType(type);
-    EGLBoolean const success = egl.makeCurrent(context, dsc->sur, rsc->sur);
+    // exportable swapchains have no EGL surface, they render into an FBO
+    // (see getDefaultFramebufferObject()), so the dummy surface is made current instead
+    EGLSurface const drawSurface = dsc->sur != EGL_NO_SURFACE ? dsc->sur : mEGLDummySurface;
+    EGLSurface const readSurface = rsc->sur != EGL_NO_SURFACE ? rsc->sur : mEGLDummySurface;
+    EGLBoolean const success = egl.makeCurrent(context, drawSurface, readSurface);
+    if (success == EGL_TRUE) {
+        mCurrentDrawSwapChain = dsc;
+    }
     return success == EGL_TRUE ? true : false;
 }
 
@@ -650,6 +804,10 @@ void PlatformEGL::commit(Platform::SwapChain* swapChain) noexcept {
         SwapChainEGL const* const sc = static_cast<SwapChainEGL const*>(swapChain);
         if (sc->sur != EGL_NO_SURFACE) {
             eglSwapBuffers(mEGLDisplay, sc->sur);
+        } else if (UTILS_UNLIKELY(sc->flags & SWAP_CHAIN_CONFIG_EXPORTABLE_IMAGE)) {
+            // no surface to swap; flush so external consumers of the dmabuf observe the
+            // frame through the buffer's implicit fencing
+            glFlush();
         }
     }
 }
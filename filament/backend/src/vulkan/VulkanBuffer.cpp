@@ -17,6 +17,7 @@
 #include "VulkanBuffer.h"
 #include "VulkanMemory.h"
 
+#include <utils/compiler.h>
 #include <utils/Panic.h>
 
 using namespace bluevk;
@@ -24,7 +25,7 @@ using namespace bluevk;
 namespace filament::backend {
 
 VulkanBuffer::VulkanBuffer(VmaAllocator allocator, VulkanStagePool& stagePool,
-        VkBufferUsageFlags usage, uint32_t numBytes)
+        VkBufferUsageFlags usage, uint32_t numBytes, bool mappable)
     : mAllocator(allocator),
       mStagePool(stagePool),
       mUsage(usage),
@@ -41,6 +42,26 @@ VulkanBuffer::VulkanBuffer(VmaAllocator allocator, VulkanStagePool& stagePool,
         .usage = usage | VK_BUFFER_USAGE_TRANSFER_DST_BIT
     };
 
+    if (mappable) {
+        // Try device-local host-visible memory first (UMA, or resizable BAR on desktop GPUs)
+        // and keep it persistently mapped, so that loadFromCpuUnsynchronized() can write the
+        // buffer directly. Falls through to plain device-local memory when no such memory
+        // type exists or the BAR heap is exhausted.
+        VmaAllocationCreateInfo directInfo {
+            .flags = VMA_ALLOCATION_CREATE_MAPPED_BIT,
+            .usage = VMA_MEMORY_USAGE_GPU_ONLY,
+            .requiredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+                    | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT
+                    | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+        };
+        VmaAllocationInfo info = {};
+        if (vmaCreateBuffer(mAllocator, &bufferInfo, &directInfo, &mGpuBuffer, &mGpuMemory,
+                &info) == VK_SUCCESS) {
+            mMapped = info.pMappedData;
+            return;
+        }
+    }
+
     VmaAllocationCreateInfo allocInfo { .usage = VMA_MEMORY_USAGE_GPU_ONLY };
     vmaCreateBuffer(mAllocator, &bufferInfo, &allocInfo, &mGpuBuffer, &mGpuMemory, nullptr);
 }
@@ -72,6 +93,9 @@ void VulkanBuffer::loadFromCpu(VkCommandBuffer cmdbuf, const void* cpuData, uint
         } else if (mUsage & VK_BUFFER_USAGE_INDEX_BUFFER_BIT) {
             srcAccess = VK_ACCESS_INDEX_READ_BIT;
             srcStage = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
+        } else if (mUsage & VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT) {
+            srcAccess = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+            srcStage = VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
         }
 
         VkBufferMemoryBarrier barrier{
@@ -115,6 +139,9 @@ void VulkanBuffer::loadFromCpu(VkCommandBuffer cmdbuf, const void* cpuData, uint
         dstAccessMask |= VK_ACCESS_UNIFORM_READ_BIT;
         dstStageMask |=
                 (VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+    } else if (mUsage & VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT) {
+        dstAccessMask |= VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+        dstStageMask |= VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
     } else if (mUsage & VK_BUFFER_USAGE_STORAGE_BUFFER_BIT) {
         // TODO: implement me
     }
@@ -133,4 +160,17 @@ void VulkanBuffer::loadFromCpu(VkCommandBuffer cmdbuf, const void* cpuData, uint
             &barrier, 0, nullptr);
 }
 
+void VulkanBuffer::loadFromCpuUnsynchronized(VkCommandBuffer cmdbuf, const void* cpuData,
+        uint32_t byteOffset, uint32_t numBytes) {
+    if (UTILS_LIKELY(mMapped)) {
+        // The caller guarantees the GPU is not accessing this range, so we can write device
+        // memory directly. The memory is host-coherent and the write happens before the
+        // current command buffer is submitted, so the implicit host domain operation performed
+        // by vkQueueSubmit() makes it visible to the GPU without any barrier.
+        memcpy(static_cast<uint8_t*>(mMapped) + byteOffset, cpuData, numBytes);
+        return;
+    }
+    loadFromCpu(cmdbuf, cpuData, byteOffset, numBytes);
+}
+
 } // namespace filament::backend
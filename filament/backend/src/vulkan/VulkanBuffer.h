@@ -26,11 +26,21 @@ namespace filament::backend {
 // Encapsulates a Vulkan buffer, its attached DeviceMemory and a staging area.
 class VulkanBuffer {
 public:
+    // When `mappable` is true, the buffer is allocated from device-local host-visible memory
+    // if such a memory type exists (UMA, resizable BAR) and kept persistently mapped, which
+    // enables the direct-write path of loadFromCpuUnsynchronized().
     VulkanBuffer(VmaAllocator allocator, VulkanStagePool& stagePool, VkBufferUsageFlags usage,
-            uint32_t numBytes);
+            uint32_t numBytes, bool mappable = false);
     ~VulkanBuffer();
     void loadFromCpu(VkCommandBuffer cmdbuf, const void* cpuData, uint32_t byteOffset,
             uint32_t numBytes);
+
+    // Same as loadFromCpu(), but the caller guarantees that the GPU is not accessing the
+    // updated range (e.g. the frontend orphans or round-robins the buffer). On mapped
+    // device-local memory this is a plain memcpy: no staging buffer, no copy, no barrier.
+    void loadFromCpuUnsynchronized(VkCommandBuffer cmdbuf, const void* cpuData,
+            uint32_t byteOffset, uint32_t numBytes);
+
     VkBuffer getGpuBuffer() const {
         return mGpuBuffer;
     }
@@ -41,6 +51,7 @@ private:
 
     VmaAllocation mGpuMemory = VK_NULL_HANDLE;
     VkBuffer mGpuBuffer = VK_NULL_HANDLE;
+    void* mMapped = nullptr;
     VkBufferUsageFlags mUsage = {};
 	uint32_t mUpdatedOffset = 0;
     uint32_t mUpdatedBytes = 0;
@@ -28,6 +28,8 @@
 #include <utils/Panic.h>
 #include <utils/debug.h>
 
+#include <algorithm>
+
 using namespace bluevk;
 using namespace utils;
 
@@ -76,6 +78,71 @@ static VkCommandPool createPool(VkDevice device, uint32_t queueFamilyIndex) {
     return pool;
 }
 
+#if FVK_FEATURE_SECONDARY_COMMAND_BUFFERS
+
+VulkanSecondaryCommandPool::VulkanSecondaryCommandPool(VkDevice device, uint32_t queueFamilyIndex)
+    : mDevice(device) {
+    // Note the absence of VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT: secondaries are
+    // recycled in bulk via vkResetCommandPool, which lets the driver keep a single allocator
+    // behind the whole pool.
+    VkCommandPoolCreateInfo const createInfo = {
+            .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+            .flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT,
+            .queueFamilyIndex = queueFamilyIndex,
+    };
+    vkCreateCommandPool(mDevice, &createInfo, VKALLOC, &mPool);
+}
+
+VulkanSecondaryCommandPool::~VulkanSecondaryCommandPool() {
+    // Destroying the pool frees all of the buffers allocated from it.
+    vkDestroyCommandPool(mDevice, mPool, VKALLOC);
+}
+
+VkCommandBuffer VulkanSecondaryCommandPool::begin(VkRenderPass renderPass, uint32_t subpass,
+        VkFramebuffer framebuffer) {
+    VkCommandBuffer buffer;
+    if (!mFree.empty()) {
+        buffer = mFree.back();
+        mFree.pop_back();
+    } else {
+        VkCommandBufferAllocateInfo const allocateInfo = {
+                .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+                .commandPool = mPool,
+                .level = VK_COMMAND_BUFFER_LEVEL_SECONDARY,
+                .commandBufferCount = 1,
+        };
+        vkAllocateCommandBuffers(mDevice, &allocateInfo, &buffer);
+    }
+    mUsed.push_back(buffer);
+
+    VkCommandBufferInheritanceInfo const inheritance = {
+            .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO,
+            .renderPass = renderPass,
+            .subpass = subpass,
+            .framebuffer = framebuffer,
+    };
+    VkCommandBufferBeginInfo const beginInfo = {
+            .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+            .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT
+                     | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT,
+            .pInheritanceInfo = &inheritance,
+    };
+    vkBeginCommandBuffer(buffer, &beginInfo);
+    return buffer;
+}
+
+void VulkanSecondaryCommandPool::end(VkCommandBuffer buffer) {
+    vkEndCommandBuffer(buffer);
+}
+
+void VulkanSecondaryCommandPool::reset() noexcept {
+    vkResetCommandPool(mDevice, mPool, 0);
+    mFree.insert(mFree.end(), mUsed.begin(), mUsed.end());
+    mUsed.clear();
+}
+
+#endif // FVK_FEATURE_SECONDARY_COMMAND_BUFFERS
+
 #if FVK_ENABLED(FVK_DEBUG_GROUP_MARKERS)
 void VulkanGroupMarkers::push(std::string const& marker, Timestamp start) noexcept {
     mMarkers.push_back(marker);
@@ -147,6 +214,19 @@ VulkanCommands::VulkanCommands(VkDevice device, VkQueue queue, uint32_t queueFam
         vkCreateFence(device, &fenceCreateInfo, VKALLOC, &fence);
     }
 
+    if (context->isTimelineSemaphoresSupported()) {
+        VkSemaphoreTypeCreateInfoKHR timelineCreateInfo{
+                .sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO_KHR,
+                .semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE_KHR,
+                .initialValue = 0,
+        };
+        VkSemaphoreCreateInfo timelineSci{
+                .sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+                .pNext = &timelineCreateInfo,
+        };
+        vkCreateSemaphore(mDevice, &timelineSci, VKALLOC, &mTimelineSemaphore);
+    }
+
     for (size_t i = 0; i < CAPACITY; ++i) {
         mStorage[i] = std::make_unique<VulkanCommandBuffer>(allocator, mDevice, mPool);
     }
@@ -166,6 +246,9 @@ void VulkanCommands::terminate() {
     for (VkFence fence: mFences) {
         vkDestroyFence(mDevice, fence, VKALLOC);
     }
+    if (mTimelineSemaphore != VK_NULL_HANDLE) {
+        vkDestroySemaphore(mDevice, mTimelineSemaphore, VKALLOC);
+    }
 }
 
 VulkanCommandBuffer& VulkanCommands::get() {
@@ -182,7 +265,26 @@ VulkanCommandBuffer& VulkanCommands::get() {
                << "If this occurs frequently, consider increasing VK_MAX_COMMAND_BUFFERS."
                << io::endl;
 #endif
-        wait();
+        if (mTimelineSemaphore != VK_NULL_HANDLE) {
+            // Wait for the oldest in-flight submission only; a single retired command buffer
+            // is enough to continue, so there is no need to drain the whole queue here.
+            uint64_t oldest = UINT64_MAX;
+            for (size_t i = 0; i < CAPACITY; i++) {
+                if (mStorage[i]->buffer() != VK_NULL_HANDLE) {
+                    oldest = std::min(oldest, mSubmissionValues[i]);
+                }
+            }
+            VkSemaphoreWaitInfoKHR waitInfo{
+                    .sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO_KHR,
+                    .semaphoreCount = 1,
+                    .pSemaphores = &mTimelineSemaphore,
+                    .pValues = &oldest,
+            };
+            vkWaitSemaphoresKHR(mDevice, &waitInfo, UINT64_MAX);
+            updateFences();
+        } else {
+            wait();
+        }
         gc();
     }
 
@@ -277,6 +379,18 @@ bool VulkanCommands::flush() {
         signals[waitSemaphoreCount++] = mInjectedSignal;
     }
     VkCommandBuffer const cmdbuffer = currentbuf->buffer();
+
+    // In addition to the binary "rendering finished" semaphore, signal the submission timeline
+    // so that resource pools can track exactly which submissions have retired. The value entry
+    // for the binary semaphore is ignored by the driver.
+    VkSemaphore signalSemaphores[2] = { renderingFinished, mTimelineSemaphore };
+    uint64_t const signalValues[2] = { 0, mNextSubmissionValue };
+    VkTimelineSemaphoreSubmitInfoKHR timelineSubmitInfo{
+            .sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR,
+            .signalSemaphoreValueCount = 2,
+            .pSignalSemaphoreValues = signalValues,
+    };
+
     VkSubmitInfo submitInfo{
             .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
             .waitSemaphoreCount = waitSemaphoreCount,
@@ -287,6 +401,11 @@ bool VulkanCommands::flush() {
             .signalSemaphoreCount = 1u,
             .pSignalSemaphores = &renderingFinished,
     };
+    if (mTimelineSemaphore != VK_NULL_HANDLE) {
+        submitInfo.pNext = &timelineSubmitInfo;
+        submitInfo.signalSemaphoreCount = 2u;
+        submitInfo.pSignalSemaphores = signalSemaphores;
+    }
 
 #if FVK_ENABLED(FVK_DEBUG_COMMAND_BUFFER)
     FVK_LOGI << "Submitting cmdbuffer=" << cmdbuffer
@@ -310,6 +429,7 @@ bool VulkanCommands::flush() {
 #endif
     assert_invariant(result == VK_SUCCESS);
 
+    mSubmissionValues[index] = mNextSubmissionValue++;
     mSubmissionSignal = renderingFinished;
     mInjectedSignal = VK_NULL_HANDLE;
     mCurrentCommandBufferIndex = -1;
@@ -392,6 +512,14 @@ void VulkanCommands::updateFences() {
     }
 }
 
+uint64_t VulkanCommands::getCompletedSubmissionValue() {
+    if (mTimelineSemaphore != VK_NULL_HANDLE) {
+        // The counter can only move forward, so a stale read is merely conservative.
+        vkGetSemaphoreCounterValueKHR(mDevice, mTimelineSemaphore, &mCompletedSubmissionValue);
+    }
+    return mCompletedSubmissionValue;
+}
+
 #if FVK_ENABLED(FVK_DEBUG_GROUP_MARKERS)
 
 void VulkanCommands::pushGroupMarker(char const* str, VulkanGroupMarkers::Timestamp timestamp) {
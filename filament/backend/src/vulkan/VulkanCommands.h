@@ -34,6 +34,7 @@
 #include <list>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace filament::backend {
 
@@ -147,6 +148,42 @@ private:
     VkPipeline mPipeline;
 };
 
+#if FVK_FEATURE_SECONDARY_COMMAND_BUFFERS
+
+// A thread-confined pool of VK_COMMAND_BUFFER_LEVEL_SECONDARY buffers. Command pools are
+// externally synchronized in Vulkan, so recording a render pass in parallel requires one instance
+// per recording thread; each recorder fills its segment of the pass through its own pool and the
+// resulting buffers are stitched into the primary with vkCmdExecuteCommands (the pass must then be
+// begun with VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS).
+class VulkanSecondaryCommandPool {
+public:
+    VulkanSecondaryCommandPool(VkDevice device, uint32_t queueFamilyIndex);
+    ~VulkanSecondaryCommandPool();
+
+    VulkanSecondaryCommandPool(VulkanSecondaryCommandPool const&) = delete;
+    VulkanSecondaryCommandPool& operator=(VulkanSecondaryCommandPool const&) = delete;
+
+    // Allocates (or recycles) a secondary buffer and begins recording with render pass
+    // inheritance, ready to receive draw commands for the given subpass.
+    VkCommandBuffer begin(VkRenderPass renderPass, uint32_t subpass, VkFramebuffer framebuffer);
+
+    // Ends recording on a buffer returned by begin().
+    void end(VkCommandBuffer buffer);
+
+    // Makes every buffer handed out by begin() available for reuse. Only call this once the
+    // primary buffer that executed them has finished on the GPU (i.e. alongside
+    // VulkanCommandBuffer::reset()).
+    void reset() noexcept;
+
+private:
+    VkDevice const mDevice;
+    VkCommandPool mPool;
+    std::vector<VkCommandBuffer> mUsed;
+    std::vector<VkCommandBuffer> mFree;
+};
+
+#endif // FVK_FEATURE_SECONDARY_COMMAND_BUFFERS
+
 // Allows classes to be notified after a new command buffer has been activated.
 class CommandBufferObserver {
 public:
@@ -180,6 +217,12 @@ public:
 //    - Users can examine these atomic variables (see VulkanCmdFence) to determine status.
 //    - We do this because vkGetFenceStatus must be called from the rendering thread.
 //
+// - Maintains a monotonic submission timeline when VK_KHR_timeline_semaphore is available.
+//    - Every flush signals the next value on a single timeline semaphore.
+//    - Resource pools compare a recorded value against getCompletedSubmissionValue() to
+//      find out whether the GPU retired a specific submission, instead of waiting for the
+//      whole queue to drain or aging resources by a conservative frame count.
+//
 class VulkanCommands {
 public:
     VulkanCommands(VkDevice device, VkQueue queue, uint32_t queueFamilyIndex,
@@ -212,6 +255,15 @@ public:
     // Updates the atomic "status" variable in every extant fence.
     void updateFences();
 
+    // Returns the value that the next flush() will signal on the submission timeline. A
+    // resource referenced by the current command buffer is in use until this value retires.
+    uint64_t getNextSubmissionValue() const { return mNextSubmissionValue; }
+
+    // Returns the latest value the GPU has signaled on the submission timeline, or 0 when
+    // timeline semaphores are unavailable (in which case callers must fall back to their
+    // fence or frame-count based heuristics).
+    uint64_t getCompletedSubmissionValue();
+
     // Sets an observer who is notified every time a new command buffer has been made "current".
     // The observer's event handler can only be called during get().
     void setObserver(CommandBufferObserver* observer) { mObserver = observer; }
@@ -241,6 +293,13 @@ private:
     utils::FixedCapacityVector<std::unique_ptr<VulkanCommandBuffer>> mStorage;
     VkFence mFences[CAPACITY] = {};
     VkSemaphore mSubmissionSignals[CAPACITY] = {};
+
+    // Submission timeline, VK_NULL_HANDLE when VK_KHR_timeline_semaphore is unavailable.
+    VkSemaphore mTimelineSemaphore = VK_NULL_HANDLE;
+    uint64_t mNextSubmissionValue = 1;
+    uint64_t mCompletedSubmissionValue = 0;
+    uint64_t mSubmissionValues[CAPACITY] = {};
+
     uint8_t mAvailableBufferCount = CAPACITY;
     CommandBufferObserver* mObserver = nullptr;
 
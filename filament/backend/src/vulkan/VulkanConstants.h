@@ -123,6 +123,18 @@ static_assert(FVK_ENABLED(FVK_DEBUG_VALIDATION));
 
 // end shorthands
 
+// Feature flags. Unlike the debug flags above, these change behavior rather than logging or
+// validation.
+//
+// When enabled, render pass contents may be recorded into secondary command buffers (potentially
+// on several threads, each owning its own VulkanSecondaryCommandPool) and stitched into the
+// primary with vkCmdExecuteCommands. Off by default: the DriverApi command stream is consumed by a
+// single thread today, so this only pays off once the caller actually splits a pass's draw stream
+// across recorders.
+#ifndef FVK_FEATURE_SECONDARY_COMMAND_BUFFERS
+#define FVK_FEATURE_SECONDARY_COMMAND_BUFFERS 0
+#endif
+
 #if FVK_ENABLED(FVK_DEBUG_SYSTRACE)
 
 #include <utils/Systrace.h>
@@ -119,6 +119,10 @@ public:
         return mPhysicalDeviceProperties.properties.limits;
     }
 
+    inline VkPhysicalDeviceProperties const& getPhysicalDeviceProperties() const noexcept {
+        return mPhysicalDeviceProperties.properties;
+    }
+
     inline uint32_t getPhysicalDeviceVendorId() const noexcept {
         return mPhysicalDeviceProperties.properties.vendorID;
     }
@@ -151,10 +155,25 @@ public:
         return mLazilyAllocatedMemorySupported;
     }
 
+    // True when a DEVICE_LOCAL|HOST_VISIBLE|HOST_COHERENT memory type exists, i.e. on UMA
+    // devices and on desktop GPUs with resizable BAR, where the host can write device memory
+    // directly without a staging copy.
+    inline bool isDeviceLocalHostVisibleSupported() const noexcept {
+        return mDeviceLocalHostVisibleSupported;
+    }
+
     inline bool isProtectedMemorySupported() const noexcept {
         return mProtectedMemorySupported;
     }
 
+    inline bool isTimelineSemaphoresSupported() const noexcept {
+        return mTimelineSemaphoresSupported;
+    }
+
+    inline bool isGraphicsPipelineLibrarySupported() const noexcept {
+        return mGraphicsPipelineLibrarySupported;
+    }
+
 private:
     VkPhysicalDeviceMemoryProperties mMemoryProperties = {};
     VkPhysicalDeviceProperties2 mPhysicalDeviceProperties = {
@@ -167,7 +186,10 @@ private:
     bool mDebugUtilsSupported = false;
     bool mMultiviewEnabled = false;
     bool mLazilyAllocatedMemorySupported = false;
+    bool mDeviceLocalHostVisibleSupported = false;
     bool mProtectedMemorySupported = false;
+    bool mTimelineSemaphoresSupported = false;
+    bool mGraphicsPipelineLibrarySupported = false;
 
     VkFormatList mDepthStencilFormats;
     VkFormatList mBlittableDepthStencilFormats;
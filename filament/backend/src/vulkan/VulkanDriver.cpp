@@ -49,6 +49,9 @@ namespace filament::backend {
 
 namespace {
 
+// Per-frame time budget for the cache eviction sweeps serviced by the GC scheduler.
+constexpr std::chrono::microseconds GC_TIME_BUDGET{ 500 };
+
 VmaAllocator createAllocator(VkInstance instance, VkPhysicalDevice physicalDevice,
         VkDevice device) {
     VmaAllocator allocator;
@@ -195,19 +198,20 @@ VulkanDriver::VulkanDriver(VulkanPlatform* platform, VulkanContext const& contex
       mAllocator(createAllocator(mPlatform->getInstance(), mPlatform->getPhysicalDevice(),
               mPlatform->getDevice())),
       mContext(context),
-      mResourceAllocator(driverConfig.handleArenaSize, driverConfig.disableHandleUseAfterFreeCheck),
+      mResourceAllocator(driverConfig.handleArenaSize, driverConfig.disableHandleUseAfterFreeCheck,
+              driverConfig.enableHandleSanitizer, driverConfig.handleArenaPoolWeights),
       mResourceManager(&mResourceAllocator),
       mThreadSafeResourceManager(&mResourceAllocator),
       mCommands(mPlatform->getDevice(), mPlatform->getGraphicsQueue(),
               mPlatform->getGraphicsQueueFamilyIndex(), &mContext, &mResourceAllocator),
       mPipelineLayoutCache(mPlatform->getDevice(), &mResourceAllocator),
       mPipelineCache(mPlatform->getDevice(), mAllocator),
-      mStagePool(mAllocator, &mCommands),
+      mStagePool(mAllocator, &mCommands, driverConfig.vulkanStagingRetentionBytes),
       mFramebufferCache(mPlatform->getDevice()),
       mSamplerCache(mPlatform->getDevice()),
       mBlitter(mPlatform->getPhysicalDevice(), &mCommands),
       mReadPixels(mPlatform->getDevice()),
-      mDescriptorSetManager(mPlatform->getDevice(), &mResourceAllocator),
+      mDescriptorSetManager(mPlatform->getDevice(), &mResourceAllocator, &mSamplerCache),
       mIsSRGBSwapChainSupported(mPlatform->getCustomization().isSRGBSwapChainSupported),
       mStereoscopicType(driverConfig.stereoscopicType) {
 
@@ -233,6 +237,16 @@ VulkanDriver::VulkanDriver(VulkanPlatform* platform, VulkanContext const& contex
 #endif
 
     mTimestamps = std::make_unique<VulkanTimestamps>(mPlatform->getDevice());
+
+    mPipelineCache.initCache(mPlatform, mContext.getPhysicalDeviceProperties());
+    mPipelineCache.setGraphicsPipelineLibraryEnabled(
+            mContext.isGraphicsPipelineLibrarySupported());
+
+    // Register the cache eviction sweeps with the budgeted GC scheduler, which staggers them
+    // across frames in collectGarbage() instead of running them all back-to-back.
+    mGcScheduler.registerCache("stagepool", [this] { return mStagePool.gc(); });
+    mGcScheduler.registerCache("fbocache", [this] { return mFramebufferCache.gc(); });
+    mGcScheduler.registerCache("pipelinecache", [this] { return mPipelineCache.gc(); });
 }
 
 VulkanDriver::~VulkanDriver() noexcept = default;
@@ -297,6 +311,12 @@ void VulkanDriver::terminate() {
     // to those commands are no longer referenced.
     finish(0);
 
+    // We just waited for the queue to drain, so all pending queueCallback() conditions are met.
+    for (auto const& queued: mQueuedCallbacks) {
+        scheduleCallback(queued.handler, queued.user, queued.callback);
+    }
+    mQueuedCallbacks.clear();
+
     // Command buffers should come first since it might have commands depending on resources that
     // are about to be destroyed.
     mCommands.terminate();
@@ -349,9 +369,28 @@ void VulkanDriver::collectGarbage() {
     // Command buffers need to be submitted and completed before other resources can be gc'd. And
     // its gc() function carrys out the *wait*.
     mCommands.gc();
-    mStagePool.gc();
-    mFramebufferCache.gc();
-    mPipelineCache.gc();
+
+    // The pipeline cache's frame clock and bound state must advance every frame, even on frames
+    // where the scheduler doesn't service its eviction sweep.
+    mPipelineCache.advanceFrame();
+
+    // Service the registered cache sweeps round-robin under a time budget, so their cost is
+    // spread across frames rather than spiking when they all coincide.
+    mGcScheduler.run(GC_TIME_BUDGET);
+
+    // Schedule the callbacks whose submission fence has retired. mCommands.gc() above has
+    // already refreshed every fence's status.
+    if (UTILS_UNLIKELY(!mQueuedCallbacks.empty())) {
+        auto it = mQueuedCallbacks.begin();
+        while (it != mQueuedCallbacks.end()) {
+            if (it->fence->getStatus() == VK_SUCCESS) {
+                scheduleCallback(it->handler, it->user, it->callback);
+                it = mQueuedCallbacks.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
 
 #if FVK_ENABLED(FVK_DEBUG_RESOURCE_LEAK)
     mResourceAllocator.print();
@@ -375,6 +414,16 @@ void VulkanDriver::setFrameCompletedCallback(Handle<HwSwapChain> sch,
         CallbackHandler* handler, utils::Invocable<void(void)>&& callback) {
 }
 
+void VulkanDriver::queueCallback(CallbackHandler* handler,
+        CallbackHandler::Callback callback, void* user) {
+    if (!callback) {
+        return;
+    }
+    // The current command buffer contains all work recorded so far; its fence reaches
+    // VK_SUCCESS once the GPU retires the submission.
+    mQueuedCallbacks.push_back({ mCommands.get().fence, handler, callback, user });
+}
+
 void VulkanDriver::setPresentationTime(int64_t monotonic_clock_ns) {
 }
 
@@ -410,7 +459,10 @@ void VulkanDriver::updateDescriptorSetTexture(
     FVK_SYSTRACE_START("updateDescriptorSetTexture");
     VulkanDescriptorSet* set = mResourceAllocator.handle_cast<VulkanDescriptorSet*>(dsh);
     VulkanTexture* texture = mResourceAllocator.handle_cast<VulkanTexture*>(th);
-    VkSampler const vksampler = mSamplerCache.getSampler(params);
+    // For bindings with an immutable sampler baked into the set layout, the sampler member of the
+    // descriptor write is ignored, so don't bother resolving one.
+    VkSampler const vksampler = set->immutableSamplerMask.test(binding)
+            ? VK_NULL_HANDLE : mSamplerCache.getSampler(params);
     mDescriptorSetManager.updateSampler(set, binding, texture, vksampler);
     FVK_SYSTRACE_END();
 }
@@ -498,8 +550,13 @@ void VulkanDriver::destroyIndexBuffer(Handle<HwIndexBuffer> ibh) {
 
 void VulkanDriver::createBufferObjectR(Handle<HwBufferObject> boh, uint32_t byteCount,
         BufferObjectBinding bindingType, BufferUsage usage) {
+    // Uniform buffers (this includes per-renderable bone/skinning data) are updated every
+    // frame; on devices with host-visible device-local memory they can be written directly,
+    // bypassing the staging copy.
+    bool const mappable = mContext.isDeviceLocalHostVisibleSupported()
+            && bindingType == BufferObjectBinding::UNIFORM;
     auto bufferObject = mResourceAllocator.construct<VulkanBufferObject>(boh, mAllocator,
-            mStagePool, byteCount, bindingType);
+            mStagePool, byteCount, bindingType, mappable);
     mResourceManager.acquire(bufferObject);
 }
 
@@ -1094,6 +1151,10 @@ size_t VulkanDriver::getMaxUniformBufferSize() {
     return 32768;
 }
 
+HandleAllocatorStats VulkanDriver::getHandleAllocatorStats() {
+    return mResourceAllocator.getStats();
+}
+
 void VulkanDriver::setVertexBufferObject(Handle<HwVertexBuffer> vbh, uint32_t index,
         Handle<HwBufferObject> boh) {
     auto vb = mResourceAllocator.handle_cast<VulkanVertexBuffer*>(vbh);
@@ -1128,8 +1189,9 @@ void VulkanDriver::updateBufferObjectUnsynchronized(Handle<HwBufferObject> boh,
     VulkanCommandBuffer& commands = mCommands.get();
     auto bo = mResourceAllocator.handle_cast<VulkanBufferObject*>(boh);
     commands.acquire(bo);
-    // TODO: implement unsynchronized version
-    bo->buffer.loadFromCpu(commands.buffer(), bd.buffer, byteOffset, bd.size);
+    // The unsynchronized contract means the caller guarantees the GPU is not accessing the
+    // updated range, so this can write mapped device-local memory directly when available.
+    bo->buffer.loadFromCpuUnsynchronized(commands.buffer(), bd.buffer, byteOffset, bd.size);
     mResourceManager.acquire(bo);
     scheduleDestroy(std::move(bd));
 }
@@ -1151,6 +1213,14 @@ void VulkanDriver::update3DImage(Handle<HwTexture> th, uint32_t level, uint32_t
     scheduleDestroy(std::move(data));
 }
 
+void VulkanDriver::update3DImageBatch(Handle<HwTexture> th,
+        uint32_t regionCount, BufferDescriptor&& regions, PixelBufferDescriptor&& data) {
+    mResourceAllocator.handle_cast<VulkanTexture*>(th)->updateImageBatch(
+            static_cast<TextureUpdateRegion const*>(regions.buffer), regionCount, data);
+    scheduleDestroy(std::move(regions));
+    scheduleDestroy(std::move(data));
+}
+
 void VulkanDriver::setupExternalImage(void* image) {
 }
 
@@ -1651,24 +1721,13 @@ void VulkanDriver::blitDEPRECATED(TargetBufferFlags buffers,
     FVK_SYSTRACE_END();
 }
 
-void VulkanDriver::bindPipeline(PipelineState const& pipelineState) {
-    FVK_SYSTRACE_CONTEXT();
-    FVK_SYSTRACE_START("draw");
-
-    VulkanCommandBuffer* commands = &mCommands.get();
-    const VulkanVertexBufferInfo& vbi =
-            *mResourceAllocator.handle_cast<VulkanVertexBufferInfo*>(pipelineState.vertexBufferInfo);
-
-    Handle<HwProgram> programHandle = pipelineState.program;
+// Builds the pipeline cache's raster state from the frontend's pipeline description. The sample
+// count and color target count come from the render target, which is the current one at draw time
+// but can be any target when pre-warming the cache (see precachePipeline).
+static VulkanPipelineCache::RasterState makeVulkanRasterState(PipelineState const& pipelineState,
+        uint8_t rasterizationSamples, uint8_t colorTargetCount) noexcept {
     RasterState const& rasterState = pipelineState.rasterState;
     PolygonOffset const& depthOffset = pipelineState.polygonOffset;
-
-    auto* program = mResourceAllocator.handle_cast<VulkanProgram*>(programHandle);
-    commands->acquire(program);
-
-    // Update the VK raster state.
-    const VulkanRenderTarget* rt = mCurrentRenderPass.renderTarget;
-
     VulkanPipelineCache::RasterState const vulkanRasterState{
         .cullMode = getCullMode(rasterState.culling),
         .frontFace = getFrontFace(rasterState.inverseFrontFaces),
@@ -1681,15 +1740,90 @@ void VulkanDriver::bindPipeline(PipelineState const& pipelineState) {
         .srcAlphaBlendFactor = getBlendFactor(rasterState.blendFunctionSrcAlpha),
         .dstAlphaBlendFactor = getBlendFactor(rasterState.blendFunctionDstAlpha),
         .colorWriteMask = (VkColorComponentFlags) (rasterState.colorWrite ? 0xf : 0x0),
-        .rasterizationSamples = rt->getSamples(),
+        .rasterizationSamples = rasterizationSamples,
         .depthClamp = rasterState.depthClamp,
-        .colorTargetCount = rt->getColorTargetCount(mCurrentRenderPass),
+        .colorTargetCount = colorTargetCount,
         .colorBlendOp = rasterState.blendEquationRGB,
         .alphaBlendOp =  rasterState.blendEquationAlpha,
         .depthCompareOp = rasterState.depthFunc,
         .depthBiasConstantFactor = depthOffset.constant,
         .depthBiasSlopeFactor = depthOffset.slope
     };
+    return vulkanRasterState;
+}
+
+void VulkanDriver::precachePipeline(PipelineState state, Handle<HwRenderTarget> rth) {
+    FVK_SYSTRACE_CONTEXT();
+    FVK_SYSTRACE_START("precachePipeline");
+
+    VulkanRenderTarget* const rt = mResourceAllocator.handle_cast<VulkanRenderTarget*>(rth);
+    VulkanVertexBufferInfo const& vbi =
+            *mResourceAllocator.handle_cast<VulkanVertexBufferInfo*>(state.vertexBufferInfo);
+    auto* program = mResourceAllocator.handle_cast<VulkanProgram*>(state.program);
+
+    // Pipelines only depend on render pass *compatibility*, which is a function of the attachment
+    // formats and sample counts; the load/store behavior baked into the key below is irrelevant,
+    // so default flags are good enough, and whichever pass actually gets used at draw time will
+    // accept the pipeline created here.
+    VulkanFboCache::RenderPassKey rpkey = rt->getRenderPassKey();
+    rpkey.clear = TargetBufferFlags::NONE;
+    rpkey.discardStart = TargetBufferFlags::NONE;
+    rpkey.discardEnd = TargetBufferFlags::NONE;
+    rpkey.initialDepthLayout =
+            rt->hasDepth() ? VulkanLayout::DEPTH_ATTACHMENT : VulkanLayout::UNDEFINED;
+    rpkey.subpassMask = 0;
+    VkRenderPass const renderPass = mFramebufferCache.getRenderPass(rpkey);
+
+    VulkanRenderPass const pass{
+        .renderTarget = rt,
+        .renderPass = renderPass,
+        .params = {},
+        .currentSubpass = 0,
+    };
+
+    mPipelineCache.bindRenderPass(renderPass, 0);
+    mPipelineCache.bindProgram(program);
+    mPipelineCache.bindRasterState(
+            makeVulkanRasterState(state, rt->getSamples(), rt->getColorTargetCount(pass)));
+    mPipelineCache.bindPrimitiveTopology(
+            VulkanPipelineCache::getPrimitiveTopology(state.primitiveType));
+    mPipelineCache.bindVertexArray(vbi.getAttribDescriptions(), vbi.getBufferDescriptions(),
+            vbi.getAttributeCount());
+
+    auto& setLayouts = state.pipelineLayout.setLayout;
+    VulkanDescriptorSetLayout::DescriptorSetLayoutArray layoutList;
+    std::transform(setLayouts.begin(), setLayouts.end(), layoutList.begin(),
+            [&](Handle<HwDescriptorSetLayout> handle) -> VkDescriptorSetLayout {
+                if (!handle) {
+                    return VK_NULL_HANDLE;
+                }
+                auto layout = mResourceAllocator.handle_cast<VulkanDescriptorSetLayout*>(handle);
+                return layout->getVkLayout();
+            });
+    mPipelineCache.bindLayout(mPipelineLayoutCache.getLayout(layoutList, program));
+    mPipelineCache.precachePipeline();
+
+    FVK_SYSTRACE_END();
+}
+
+void VulkanDriver::bindPipeline(PipelineState const& pipelineState) {
+    FVK_SYSTRACE_CONTEXT();
+    FVK_SYSTRACE_START("draw");
+
+    VulkanCommandBuffer* commands = &mCommands.get();
+    const VulkanVertexBufferInfo& vbi =
+            *mResourceAllocator.handle_cast<VulkanVertexBufferInfo*>(pipelineState.vertexBufferInfo);
+
+    Handle<HwProgram> programHandle = pipelineState.program;
+
+    auto* program = mResourceAllocator.handle_cast<VulkanProgram*>(programHandle);
+    commands->acquire(program);
+
+    // Update the VK raster state.
+    const VulkanRenderTarget* rt = mCurrentRenderPass.renderTarget;
+
+    VulkanPipelineCache::RasterState const vulkanRasterState = makeVulkanRasterState(pipelineState,
+            rt->getSamples(), rt->getColorTargetCount(mCurrentRenderPass));
 
     // unfortunately in Vulkan the topology is per pipeline
     VkPrimitiveTopology const topology =
@@ -1794,6 +1928,35 @@ void VulkanDriver::draw2(uint32_t indexOffset, uint32_t indexCount, uint32_t ins
     FVK_SYSTRACE_END();
 }
 
+void VulkanDriver::bindDescriptorSetAndDraw(
+        backend::DescriptorSetHandle dsh,
+        backend::descriptor_set_t setIndex,
+        backend::DescriptorSetOffsetArray&& offsets,
+        uint32_t indexOffset, uint32_t indexCount, uint32_t instanceCount) {
+    bindDescriptorSet(dsh, setIndex, std::move(offsets));
+    draw2(indexOffset, indexCount, instanceCount);
+}
+
+void VulkanDriver::drawIndexedIndirect(Handle<HwBufferObject> indirectBuffer,
+        uint32_t const offset, uint32_t const drawCount, uint32_t const stride) {
+    FVK_SYSTRACE_CONTEXT();
+    FVK_SYSTRACE_START("drawIndexedIndirect");
+
+    VulkanCommandBuffer& commands = mCommands.get();
+    VkCommandBuffer cmdbuffer = commands.buffer();
+
+    VulkanBufferObject* const bo =
+            mResourceAllocator.handle_cast<VulkanBufferObject*>(indirectBuffer);
+    commands.acquire(bo);
+
+    mDescriptorSetManager.commit(&commands, mBoundPipeline.pipelineLayout,
+            mBoundPipeline.descriptorSetMask);
+
+    vkCmdDrawIndexedIndirect(cmdbuffer, bo->buffer.getGpuBuffer(), offset, drawCount, stride);
+
+    FVK_SYSTRACE_END();
+}
+
 void VulkanDriver::draw(PipelineState state, Handle<HwRenderPrimitive> rph,
         uint32_t const indexOffset, uint32_t const indexCount, uint32_t const instanceCount) {
     VulkanRenderPrimitive* const rp = mResourceAllocator.handle_cast<VulkanRenderPrimitive*>(rph);
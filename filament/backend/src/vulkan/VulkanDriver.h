@@ -18,6 +18,7 @@
 #define TNT_FILAMENT_BACKEND_VULKANDRIVER_H
 
 #include "VulkanBlitter.h"
+#include "VulkanCommands.h"
 #include "VulkanConstants.h"
 #include "VulkanContext.h"
 #include "VulkanFboCache.h"
@@ -38,6 +39,9 @@
 #include <utils/Allocator.h>
 #include <utils/compiler.h>
 
+#include <memory>
+#include <vector>
+
 namespace filament::backend {
 
 class VulkanPlatform;
@@ -154,6 +158,16 @@ private:
         AttachmentArray attachments;
     } mRenderPassFboInfo = {};
 
+    // Callbacks registered through queueCallback(), waiting on their submission fence. Drained
+    // in collectGarbage() once the fence reports VK_SUCCESS.
+    struct QueuedCallback {
+        std::shared_ptr<VulkanCmdFence> fence;
+        CallbackHandler* handler;
+        CallbackHandler::Callback callback;
+        void* user;
+    };
+    std::vector<QueuedCallback> mQueuedCallbacks;
+
     bool const mIsSRGBSwapChainSupported;
     backend::StereoscopicType const mStereoscopicType;
 };
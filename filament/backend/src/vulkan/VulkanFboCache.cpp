@@ -251,11 +251,20 @@ VkRenderPass VulkanFboCache::getRenderPass(RenderPassKey const& config) noexcept
         const bool clear = any(config.clear & flag);
         const bool discard = any(config.discardStart & flag);
 
+        // Skip the tile writeback when the contents are dead at the end of the pass, either
+        // because the attachment lives in lazily allocated (tile-only) memory, or because the
+        // engine discards it (e.g. a multisampled attachment that is resolved in this pass, or
+        // a transient target with no reader). On tiler GPUs the store is where the bandwidth
+        // goes, so this matters a lot more than the load op. This mirrors what the OpenGL
+        // backend does with glInvalidateFramebuffer.
+        const bool discardEnd = any(config.discardEnd & flag);
+
         attachments[attachmentIndex++] = {
             .format = config.colorFormat[i],
             .samples = (VkSampleCountFlagBits) config.samples,
             .loadOp = clear ? kClear : (discard ? kDontCare : kKeep),
-            .storeOp = (config.usesLazilyAllocatedMemory & (1 << i)) ? kDisableStore : kEnableStore,
+            .storeOp = (discardEnd || (config.usesLazilyAllocatedMemory & (1 << i)))
+                    ? kDisableStore : kEnableStore,
             .stencilLoadOp = kDontCare,
             .stencilStoreOp = kDisableStore,
             .initialLayout = imgutil::getVkLayout(VulkanLayout::COLOR_ATTACHMENT),
@@ -352,22 +361,25 @@ void VulkanFboCache::reset() noexcept {
 
 // Frees up old framebuffers and render passes, then nulls out their key.  Doesn't bother removing
 // the actual map entry since it is fairly small.
-void VulkanFboCache::gc() noexcept {
+size_t VulkanFboCache::gc() noexcept {
     FVK_SYSTRACE_CONTEXT();
     FVK_SYSTRACE_START("fbocache::gc");
 
     // If this is one of the first few frames, return early to avoid wrapping unsigned integers.
     if (++mCurrentTime <= TIME_BEFORE_EVICTION) {
-        return;
+        FVK_SYSTRACE_END();
+        return 0;
     }
     const uint32_t evictTime = mCurrentTime - TIME_BEFORE_EVICTION;
 
+    size_t evicted = 0;
     for (FboMap::iterator iter = mFramebufferCache.begin(); iter != mFramebufferCache.end(); ++iter) {
         const FboVal fbo = iter->second;
         if (fbo.timestamp < evictTime && fbo.handle) {
             mRenderPassRefCount[iter->first.renderPass]--;
             vkDestroyFramebuffer(mDevice, fbo.handle, VKALLOC);
             iter.value().handle = VK_NULL_HANDLE;
+            evicted++;
         }
     }
     for (auto iter = mRenderPassCache.begin(); iter != mRenderPassCache.end(); ++iter) {
@@ -375,9 +387,11 @@ void VulkanFboCache::gc() noexcept {
         if (iter->second.timestamp < evictTime && handle && mRenderPassRefCount[handle] == 0) {
             vkDestroyRenderPass(mDevice, handle, VKALLOC);
             iter.value().handle = VK_NULL_HANDLE;
+            evicted++;
         }
     }
     FVK_SYSTRACE_END();
+    return evicted;
 }
 
 } // namespace filament::backend
@@ -103,8 +103,9 @@ public:
     // Retrieves or creates a VkRenderPass handle.
     VkRenderPass getRenderPass(RenderPassKey const& config) noexcept;
 
-    // Evicts old unused Vulkan objects. Call this once per frame.
-    void gc() noexcept;
+    // Evicts old unused Vulkan objects, returning the number of objects destroyed.
+    // Call this about once per frame.
+    size_t gc() noexcept;
 
     // Frees all Vulkan objects. Call this during shutdown before the device is destroyed.
     void reset() noexcept;
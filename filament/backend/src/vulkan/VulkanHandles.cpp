@@ -107,6 +107,22 @@ BitmaskGroup fromBackendLayout(DescriptorSetLayout const& layout) {
     return mask;
 }
 
+// Collects the sampler parameters of the bindings flagged IMMUTABLE_SAMPLER, keyed by the
+// collapsed binding number (which is what the VkDescriptorSetLayout bindings end up using).
+VulkanDescriptorSetLayout::ImmutableSamplers fromBackendLayoutImmutableSamplers(
+        DescriptorSetLayout const& layout) {
+    VulkanDescriptorSetLayout::ImmutableSamplers immutables = {};
+    for (auto const& binding: layout.bindings) {
+        if (binding.type == DescriptorType::SAMPLER &&
+                (binding.flags & DescriptorFlags::IMMUTABLE_SAMPLER) != DescriptorFlags::NONE) {
+            immutables.mask.set(binding.binding);
+            immutables.params[binding.binding] =
+                    samplerParamsFromRaw(binding.immutableSamplerParams);
+        }
+    }
+    return immutables;
+}
+
 VulkanTexture* initMsaaTexture(VulkanTexture* texture, VkDevice device,
         VkPhysicalDevice physicalDevice, VulkanContext const& context, VmaAllocator allocator,
         VulkanCommands* commands, VulkanResourceAllocator* handleAllocator, uint8_t levels,
@@ -133,7 +149,8 @@ VulkanTexture* initMsaaTexture(VulkanTexture* texture, VkDevice device,
 VulkanDescriptorSetLayout::VulkanDescriptorSetLayout(DescriptorSetLayout const& layout)
     : VulkanResource(VulkanResourceType::DESCRIPTOR_SET_LAYOUT),
       bitmask(fromBackendLayout(layout)),
-      count(Count::fromLayoutBitmask(bitmask)) {}
+      count(Count::fromLayoutBitmask(bitmask)),
+      immutableSamplers(fromBackendLayoutImmutableSamplers(layout)) {}
 
 void VulkanDescriptorSet::acquire(VulkanTexture* texture) {
     mResources.acquire(texture);
@@ -558,10 +575,10 @@ void VulkanVertexBuffer::setBuffer(VulkanResourceAllocator const& allocator,
 }
 
 VulkanBufferObject::VulkanBufferObject(VmaAllocator allocator, VulkanStagePool& stagePool,
-        uint32_t byteCount, BufferObjectBinding bindingType)
+        uint32_t byteCount, BufferObjectBinding bindingType, bool mappable)
     : HwBufferObject(byteCount),
       VulkanResource(VulkanResourceType::BUFFER_OBJECT),
-      buffer(allocator, stagePool, getBufferObjectUsage(bindingType), byteCount),
+      buffer(allocator, stagePool, getBufferObjectUsage(bindingType), byteCount, mappable),
       bindingType(bindingType) {}
 
 VulkanTimerQuery::VulkanTimerQuery(std::tuple<uint32_t, uint32_t> indices)
@@ -115,6 +115,15 @@ struct VulkanDescriptorSetLayout : public VulkanResource, HwDescriptorSetLayout
         }
     };
 
+    // Sampler parameters baked into the VkDescriptorSetLayout. `mask` has a bit set for each
+    // (collapsed) sampler binding flagged DescriptorFlags::IMMUTABLE_SAMPLER; `params[binding]` is
+    // only meaningful when the corresponding bit is set. Per the Vulkan spec, descriptor writes to
+    // these bindings update the image view but leave the sampler unchanged.
+    struct ImmutableSamplers {
+        utils::bitset32 mask;
+        SamplerParams params[MAX_BINDINGS] = {};
+    };
+
     VulkanDescriptorSetLayout(DescriptorSetLayout const& layout);
 
     ~VulkanDescriptorSetLayout() = default;
@@ -124,6 +133,7 @@ struct VulkanDescriptorSetLayout : public VulkanResource, HwDescriptorSetLayout
 
     Bitmask const bitmask;
     Count const count;
+    ImmutableSamplers const immutableSamplers;
 
 private:
     VkDescriptorSetLayout mVkLayout = VK_NULL_HANDLE;
@@ -138,11 +148,13 @@ public:
     VulkanDescriptorSet(VulkanResourceAllocator* allocator, VkDescriptorSet rawSet,
             UniformBufferBitmask const& dynamicUboMask,
             uint8_t uniqueDynamicUboCount,
+            utils::bitset32 immutableSamplerMask,
             OnRecycle&& onRecycleFn)
         : VulkanResource(VulkanResourceType::DESCRIPTOR_SET),
           vkSet(rawSet),
           dynamicUboMask(dynamicUboMask),
           uniqueDynamicUboCount(uniqueDynamicUboCount),
+          immutableSamplerMask(immutableSamplerMask),
           mResources(allocator),
           mOnRecycleFn(std::move(onRecycleFn)) {}
 
@@ -164,14 +176,29 @@ public:
 
     void acquire(VulkanBufferObject* texture);
 
+    // Returns true if `contentHash` matches the hash of the write last applied to `binding`, in
+    // which case the corresponding vkUpdateDescriptorSets call can be skipped entirely; otherwise
+    // records the new hash. A zero hash means the binding has never been written (newly created or
+    // recycled sets start out with all-zero hashes, so their first writes always go through).
+    bool isWriteRedundant(uint8_t binding, uint32_t contentHash) noexcept {
+        assert_invariant(binding < VulkanDescriptorSetLayout::MAX_BINDINGS);
+        if (mBindingContentHash[binding] == contentHash) {
+            return true;
+        }
+        mBindingContentHash[binding] = contentHash;
+        return false;
+    }
+
     VkDescriptorSet const vkSet;
     UniformBufferBitmask const dynamicUboMask;
     uint8_t const uniqueDynamicUboCount;
+    utils::bitset32 const immutableSamplerMask;
 
 private:
     backend::DescriptorSetOffsetArray mOffsets;
     VulkanAcquireOnlyResourceManager mResources;
     OnRecycle mOnRecycleFn;
+    std::array<uint32_t, VulkanDescriptorSetLayout::MAX_BINDINGS> mBindingContentHash = {};
 };
 
 using PushConstantNameArray = utils::FixedCapacityVector<char const*>;
@@ -420,7 +447,7 @@ struct VulkanIndexBuffer : public HwIndexBuffer, VulkanResource {
 
 struct VulkanBufferObject : public HwBufferObject, VulkanResource {
     VulkanBufferObject(VmaAllocator allocator, VulkanStagePool& stagePool, uint32_t byteCount,
-            BufferObjectBinding bindingType);
+            BufferObjectBinding bindingType, bool mappable);
 
     VulkanBuffer buffer;
     const BufferObjectBinding bindingType;
@@ -495,6 +522,8 @@ inline constexpr VkBufferUsageFlagBits getBufferObjectUsage(
             return VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
         case BufferObjectBinding::SHADER_STORAGE:
             return VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+        case BufferObjectBinding::INDIRECT:
+            return VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
         // when adding more buffer-types here, make sure to update VulkanBuffer::loadFromCpu()
         // if necessary.
     }
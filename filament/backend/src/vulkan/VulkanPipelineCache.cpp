@@ -18,9 +18,13 @@
 #include "VulkanMemory.h"
 #include "caching/VulkanDescriptorSetManager.h"
 
+#include <backend/Platform.h>
+
 #include <utils/Log.h>
 #include <utils/Panic.h>
 
+#include <memory>
+
 #include "VulkanConstants.h"
 #include "VulkanHandles.h"
 #include "VulkanTexture.h"
@@ -45,6 +49,52 @@ VulkanPipelineCache::~VulkanPipelineCache() {
     // be explicit about teardown order of various components.
 }
 
+void VulkanPipelineCache::initCache(Platform* platform,
+        VkPhysicalDeviceProperties const& properties) noexcept {
+    assert_invariant(mPipelineCacheObject == VK_NULL_HANDLE);
+    mPlatform = platform;
+
+    constexpr char TAG[8] = { 'F', 'V', 'K', 'P', 'I', 'P', 'E', '\0' };
+    mCacheKey = {};
+    memcpy(mCacheKey.tag, TAG, sizeof(TAG));
+    mCacheKey.version = 1;
+    mCacheKey.vendorId = properties.vendorID;
+    mCacheKey.deviceId = properties.deviceID;
+    mCacheKey.driverVersion = properties.driverVersion;
+    memcpy(mCacheKey.uuid, properties.pipelineCacheUUID, VK_UUID_SIZE);
+
+    VkPipelineCacheCreateInfo createInfo = {
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+    };
+
+    std::unique_ptr<char[]> initialData;
+    if (platform && platform->hasRetrieveBlobFunc()) {
+        size_t const size = platform->retrieveBlob(&mCacheKey, sizeof(mCacheKey), nullptr, 0);
+        if (size > 0) {
+            initialData = std::make_unique<char[]>(size);
+            size_t const retrieved = platform->retrieveBlob(
+                    &mCacheKey, sizeof(mCacheKey), initialData.get(), size);
+            if (retrieved == size) {
+                createInfo.initialDataSize = size;
+                createInfo.pInitialData = initialData.get();
+            }
+        }
+    }
+
+    VkResult result = vkCreatePipelineCache(mDevice, &createInfo, VKALLOC,
+            &mPipelineCacheObject);
+    if (result != VK_SUCCESS && createInfo.pInitialData) {
+        // a stale or corrupt blob must not cost us the cache altogether
+        createInfo.initialDataSize = 0;
+        createInfo.pInitialData = nullptr;
+        result = vkCreatePipelineCache(mDevice, &createInfo, VKALLOC, &mPipelineCacheObject);
+    }
+    if (result != VK_SUCCESS) {
+        FVK_LOGW << "vkCreatePipelineCache error " << result << utils::io::endl;
+        mPipelineCacheObject = VK_NULL_HANDLE;
+    }
+}
+
 void VulkanPipelineCache::bindLayout(VkPipelineLayout layout) noexcept {
     mPipelineRequirements.layout = layout;
 }
@@ -57,7 +107,18 @@ VulkanPipelineCache::PipelineCacheEntry* VulkanPipelineCache::getOrCreatePipelin
         pipeline.lastUsed = mCurrentTime;
         return &pipeline;
     }
-    auto ret = createPipeline();
+    // When graphics pipeline libraries are available, assemble pipelines that have a fragment
+    // shader by fast-linking independently cached state libraries; a state combination seen for
+    // the first time mid-frame then only pays for the slices it has not seen before, instead of
+    // a full monolithic compile. Depth-only pipelines (e.g. shadow map generation) keep the
+    // monolithic path, which already handles the missing fragment stage.
+    PipelineCacheEntry* ret = nullptr;
+    if (mGraphicsPipelineLibraryEnabled && mPipelineRequirements.shaders[1] != VK_NULL_HANDLE) {
+        ret = createPipelineFromLibraries();
+    }
+    if (ret == nullptr) {
+        ret = createPipeline();
+    }
     ret->lastUsed = mCurrentTime;
     return ret;
 }
@@ -235,8 +296,8 @@ VulkanPipelineCache::PipelineCacheEntry* VulkanPipelineCache::createPipeline() n
                  << shaderStages[0].module << ", " << shaderStages[1].module << ")"
                  << utils::io::endl;
     #endif
-    VkResult error = vkCreateGraphicsPipelines(mDevice, VK_NULL_HANDLE, 1, &pipelineCreateInfo,
-            VKALLOC, &cacheEntry.handle);
+    VkResult error = vkCreateGraphicsPipelines(mDevice, mPipelineCacheObject, 1,
+            &pipelineCreateInfo, VKALLOC, &cacheEntry.handle);
     assert_invariant(error == VK_SUCCESS);
     if (error != VK_SUCCESS) {
         FVK_LOGE << "vkCreateGraphicsPipelines error " << error << utils::io::endl;
@@ -246,6 +307,345 @@ VulkanPipelineCache::PipelineCacheEntry* VulkanPipelineCache::createPipeline() n
     return &mPipelines.emplace(mPipelineRequirements, cacheEntry).first.value();
 }
 
+VkPipeline VulkanPipelineCache::getOrCreateVertexInputLibrary() noexcept {
+    VertexInputKey key = {};
+    memcpy(key.vertexAttributes, mPipelineRequirements.vertexAttributes,
+            sizeof(key.vertexAttributes));
+    memcpy(key.vertexBuffers, mPipelineRequirements.vertexBuffers, sizeof(key.vertexBuffers));
+    key.topology = mPipelineRequirements.topology;
+
+    if (auto iter = mVertexInputLibraries.find(key); iter != mVertexInputLibraries.end()) {
+        iter.value().lastUsed = mCurrentTime;
+        return iter.value().handle;
+    }
+
+    // Expand our size-optimized structs into the proper Vk structs.
+    uint32_t numVertexAttribs = 0;
+    uint32_t numVertexBuffers = 0;
+    VkVertexInputAttributeDescription vertexAttributes[VERTEX_ATTRIBUTE_COUNT];
+    VkVertexInputBindingDescription vertexBuffers[VERTEX_ATTRIBUTE_COUNT];
+    for (uint32_t i = 0; i < VERTEX_ATTRIBUTE_COUNT; i++) {
+        if (mPipelineRequirements.vertexAttributes[i].format > 0) {
+            vertexAttributes[numVertexAttribs++] = mPipelineRequirements.vertexAttributes[i];
+        }
+        if (mPipelineRequirements.vertexBuffers[i].stride > 0) {
+            vertexBuffers[numVertexBuffers++] = mPipelineRequirements.vertexBuffers[i];
+        }
+    }
+
+    VkPipelineVertexInputStateCreateInfo vertexInputState = {};
+    vertexInputState.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+    vertexInputState.vertexBindingDescriptionCount = numVertexBuffers;
+    vertexInputState.pVertexBindingDescriptions = vertexBuffers;
+    vertexInputState.vertexAttributeDescriptionCount = numVertexAttribs;
+    vertexInputState.pVertexAttributeDescriptions = vertexAttributes;
+
+    VkPipelineInputAssemblyStateCreateInfo inputAssemblyState = {};
+    inputAssemblyState.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+    inputAssemblyState.topology = (VkPrimitiveTopology) mPipelineRequirements.topology;
+
+    VkGraphicsPipelineLibraryCreateInfoEXT libraryInfo = {};
+    libraryInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT;
+    libraryInfo.flags = VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT;
+
+    VkGraphicsPipelineCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    createInfo.pNext = &libraryInfo;
+    createInfo.flags = VK_PIPELINE_CREATE_LIBRARY_BIT_KHR;
+    createInfo.pVertexInputState = &vertexInputState;
+    createInfo.pInputAssemblyState = &inputAssemblyState;
+
+    PipelineCacheEntry cacheEntry = {};
+    cacheEntry.lastUsed = mCurrentTime;
+    VkResult error = vkCreateGraphicsPipelines(mDevice, mPipelineCacheObject, 1, &createInfo,
+            VKALLOC, &cacheEntry.handle);
+    if (error != VK_SUCCESS) {
+        FVK_LOGE << "vertex-input library creation error " << error << utils::io::endl;
+        return VK_NULL_HANDLE;
+    }
+    mVertexInputLibraries.emplace(key, cacheEntry);
+    return cacheEntry.handle;
+}
+
+VkPipeline VulkanPipelineCache::getOrCreatePreRasterizationLibrary() noexcept {
+    const auto& raster = mPipelineRequirements.rasterState;
+
+    PreRasterizationKey key = {};
+    key.vertexShader = mPipelineRequirements.shaders[0];
+    key.layout = mPipelineRequirements.layout;
+    key.renderPass = mPipelineRequirements.renderPass;
+    key.subpassIndex = mPipelineRequirements.subpassIndex;
+    key.cullMode = uint8_t(raster.cullMode);
+    key.frontFace = uint8_t(raster.frontFace);
+    key.depthBiasEnable = uint8_t(raster.depthBiasEnable);
+    key.depthClamp = raster.depthClamp;
+    key.depthBiasConstantFactor = raster.depthBiasConstantFactor;
+    key.depthBiasSlopeFactor = raster.depthBiasSlopeFactor;
+
+    if (auto iter = mPreRasterizationLibraries.find(key);
+            iter != mPreRasterizationLibraries.end()) {
+        iter.value().lastUsed = mCurrentTime;
+        return iter.value().handle;
+    }
+
+    VkPipelineShaderStageCreateInfo vertexStage = {};
+    vertexStage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    vertexStage.stage = VK_SHADER_STAGE_VERTEX_BIT;
+    vertexStage.module = mPipelineRequirements.shaders[0];
+    vertexStage.pName = "main";
+
+    VkPipelineViewportStateCreateInfo viewportState = {};
+    viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+    viewportState.viewportCount = 1;
+    viewportState.scissorCount = 1;
+
+    VkDynamicState dynamicStateEnables[] = {
+        VK_DYNAMIC_STATE_VIEWPORT,
+        VK_DYNAMIC_STATE_SCISSOR,
+    };
+    VkPipelineDynamicStateCreateInfo dynamicState = {};
+    dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+    dynamicState.pDynamicStates = dynamicStateEnables;
+    dynamicState.dynamicStateCount = 2;
+
+    VkPipelineRasterizationStateCreateInfo vkRaster = {};
+    vkRaster.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+    vkRaster.polygonMode = VK_POLYGON_MODE_FILL;
+    vkRaster.cullMode = raster.cullMode;
+    vkRaster.frontFace = raster.frontFace;
+    vkRaster.depthClampEnable = raster.depthClamp;
+    vkRaster.depthBiasEnable = raster.depthBiasEnable;
+    vkRaster.depthBiasConstantFactor = raster.depthBiasConstantFactor;
+    vkRaster.depthBiasClamp = 0.0f;
+    vkRaster.depthBiasSlopeFactor = raster.depthBiasSlopeFactor;
+    vkRaster.lineWidth = 1.0f;
+
+    VkGraphicsPipelineLibraryCreateInfoEXT libraryInfo = {};
+    libraryInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT;
+    libraryInfo.flags = VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT;
+
+    VkGraphicsPipelineCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    createInfo.pNext = &libraryInfo;
+    createInfo.flags = VK_PIPELINE_CREATE_LIBRARY_BIT_KHR;
+    createInfo.stageCount = 1;
+    createInfo.pStages = &vertexStage;
+    createInfo.pViewportState = &viewportState;
+    createInfo.pRasterizationState = &vkRaster;
+    createInfo.pDynamicState = &dynamicState;
+    createInfo.layout = mPipelineRequirements.layout;
+    createInfo.renderPass = mPipelineRequirements.renderPass;
+    createInfo.subpass = mPipelineRequirements.subpassIndex;
+
+    PipelineCacheEntry cacheEntry = {};
+    cacheEntry.lastUsed = mCurrentTime;
+    VkResult error = vkCreateGraphicsPipelines(mDevice, mPipelineCacheObject, 1, &createInfo,
+            VKALLOC, &cacheEntry.handle);
+    if (error != VK_SUCCESS) {
+        FVK_LOGE << "pre-rasterization library creation error " << error << utils::io::endl;
+        return VK_NULL_HANDLE;
+    }
+    mPreRasterizationLibraries.emplace(key, cacheEntry);
+    return cacheEntry.handle;
+}
+
+VkPipeline VulkanPipelineCache::getOrCreateFragmentShaderLibrary() noexcept {
+    const auto& raster = mPipelineRequirements.rasterState;
+
+    FragmentShaderKey key = {};
+    key.fragmentShader = mPipelineRequirements.shaders[1];
+    key.layout = mPipelineRequirements.layout;
+    key.renderPass = mPipelineRequirements.renderPass;
+    key.subpassIndex = mPipelineRequirements.subpassIndex;
+    key.depthWriteEnable = uint8_t(raster.depthWriteEnable);
+    key.depthCompareOp = uint8_t(raster.depthCompareOp);
+    key.rasterizationSamples = raster.rasterizationSamples;
+    key.alphaToCoverageEnable = uint8_t(raster.alphaToCoverageEnable);
+
+    if (auto iter = mFragmentShaderLibraries.find(key); iter != mFragmentShaderLibraries.end()) {
+        iter.value().lastUsed = mCurrentTime;
+        return iter.value().handle;
+    }
+
+    VkPipelineShaderStageCreateInfo fragmentStage = {};
+    fragmentStage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    fragmentStage.stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+    fragmentStage.module = mPipelineRequirements.shaders[1];
+    fragmentStage.pName = "main";
+
+    VkPipelineDepthStencilStateCreateInfo vkDs = {};
+    vkDs.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+    vkDs.front = vkDs.back = {
+            .failOp = VK_STENCIL_OP_KEEP,
+            .passOp = VK_STENCIL_OP_KEEP,
+            .depthFailOp = VK_STENCIL_OP_KEEP,
+            .compareOp = VK_COMPARE_OP_ALWAYS,
+            .compareMask = 0u,
+            .writeMask = 0u,
+            .reference = 0u,
+    };
+    vkDs.depthTestEnable = VK_TRUE;
+    vkDs.depthWriteEnable = raster.depthWriteEnable;
+    vkDs.depthCompareOp = getCompareOp(raster.depthCompareOp);
+    vkDs.depthBoundsTestEnable = VK_FALSE;
+    vkDs.stencilTestEnable = VK_FALSE;
+    vkDs.minDepthBounds = 0.0f;
+    vkDs.maxDepthBounds = 0.0f;
+
+    // The multisample state belongs to both the fragment-shader and the fragment-output
+    // libraries; the spec requires it to match between them, so both keys include it.
+    VkPipelineMultisampleStateCreateInfo vkMs = {};
+    vkMs.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+    vkMs.rasterizationSamples = (VkSampleCountFlagBits) raster.rasterizationSamples;
+    vkMs.sampleShadingEnable = VK_FALSE;
+    vkMs.minSampleShading = 0.0f;
+    vkMs.alphaToCoverageEnable = raster.alphaToCoverageEnable;
+    vkMs.alphaToOneEnable = VK_FALSE;
+
+    VkGraphicsPipelineLibraryCreateInfoEXT libraryInfo = {};
+    libraryInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT;
+    libraryInfo.flags = VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT;
+
+    VkGraphicsPipelineCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    createInfo.pNext = &libraryInfo;
+    createInfo.flags = VK_PIPELINE_CREATE_LIBRARY_BIT_KHR;
+    createInfo.stageCount = 1;
+    createInfo.pStages = &fragmentStage;
+    createInfo.pDepthStencilState = &vkDs;
+    createInfo.pMultisampleState = &vkMs;
+    createInfo.layout = mPipelineRequirements.layout;
+    createInfo.renderPass = mPipelineRequirements.renderPass;
+    createInfo.subpass = mPipelineRequirements.subpassIndex;
+
+    PipelineCacheEntry cacheEntry = {};
+    cacheEntry.lastUsed = mCurrentTime;
+    VkResult error = vkCreateGraphicsPipelines(mDevice, mPipelineCacheObject, 1, &createInfo,
+            VKALLOC, &cacheEntry.handle);
+    if (error != VK_SUCCESS) {
+        FVK_LOGE << "fragment-shader library creation error " << error << utils::io::endl;
+        return VK_NULL_HANDLE;
+    }
+    mFragmentShaderLibraries.emplace(key, cacheEntry);
+    return cacheEntry.handle;
+}
+
+VkPipeline VulkanPipelineCache::getOrCreateFragmentOutputLibrary() noexcept {
+    const auto& raster = mPipelineRequirements.rasterState;
+
+    FragmentOutputKey key = {};
+    key.renderPass = mPipelineRequirements.renderPass;
+    key.subpassIndex = mPipelineRequirements.subpassIndex;
+    key.blendEnable = uint8_t(raster.blendEnable);
+    key.srcColorBlendFactor = uint8_t(raster.srcColorBlendFactor);
+    key.dstColorBlendFactor = uint8_t(raster.dstColorBlendFactor);
+    key.srcAlphaBlendFactor = uint8_t(raster.srcAlphaBlendFactor);
+    key.dstAlphaBlendFactor = uint8_t(raster.dstAlphaBlendFactor);
+    key.colorBlendOp = uint8_t(raster.colorBlendOp);
+    key.alphaBlendOp = uint8_t(raster.alphaBlendOp);
+    key.colorWriteMask = uint8_t(raster.colorWriteMask);
+    key.colorTargetCount = raster.colorTargetCount;
+    key.rasterizationSamples = raster.rasterizationSamples;
+    key.alphaToCoverageEnable = uint8_t(raster.alphaToCoverageEnable);
+
+    if (auto iter = mFragmentOutputLibraries.find(key); iter != mFragmentOutputLibraries.end()) {
+        iter.value().lastUsed = mCurrentTime;
+        return iter.value().handle;
+    }
+
+    VkPipelineColorBlendAttachmentState colorBlendAttachments[MRT::MAX_SUPPORTED_RENDER_TARGET_COUNT];
+    VkPipelineColorBlendStateCreateInfo colorBlendState = {};
+    colorBlendState.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+    colorBlendState.attachmentCount = raster.colorTargetCount;
+    colorBlendState.pAttachments = colorBlendAttachments;
+
+    // Filament assumes consistent blend state across all color attachments.
+    for (uint8_t i = 0; i < colorBlendState.attachmentCount; ++i) {
+        auto& target = colorBlendAttachments[i];
+        target.blendEnable = raster.blendEnable;
+        target.srcColorBlendFactor = raster.srcColorBlendFactor;
+        target.dstColorBlendFactor = raster.dstColorBlendFactor;
+        target.colorBlendOp = (VkBlendOp) raster.colorBlendOp;
+        target.srcAlphaBlendFactor = raster.srcAlphaBlendFactor;
+        target.dstAlphaBlendFactor = raster.dstAlphaBlendFactor;
+        target.alphaBlendOp = (VkBlendOp) raster.alphaBlendOp;
+        target.colorWriteMask = raster.colorWriteMask;
+    }
+
+    VkPipelineMultisampleStateCreateInfo vkMs = {};
+    vkMs.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+    vkMs.rasterizationSamples = (VkSampleCountFlagBits) raster.rasterizationSamples;
+    vkMs.sampleShadingEnable = VK_FALSE;
+    vkMs.minSampleShading = 0.0f;
+    vkMs.alphaToCoverageEnable = raster.alphaToCoverageEnable;
+    vkMs.alphaToOneEnable = VK_FALSE;
+
+    VkGraphicsPipelineLibraryCreateInfoEXT libraryInfo = {};
+    libraryInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT;
+    libraryInfo.flags = VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT;
+
+    VkGraphicsPipelineCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    createInfo.pNext = &libraryInfo;
+    createInfo.flags = VK_PIPELINE_CREATE_LIBRARY_BIT_KHR;
+    createInfo.pColorBlendState = &colorBlendState;
+    createInfo.pMultisampleState = &vkMs;
+    createInfo.renderPass = mPipelineRequirements.renderPass;
+    createInfo.subpass = mPipelineRequirements.subpassIndex;
+
+    PipelineCacheEntry cacheEntry = {};
+    cacheEntry.lastUsed = mCurrentTime;
+    VkResult error = vkCreateGraphicsPipelines(mDevice, mPipelineCacheObject, 1, &createInfo,
+            VKALLOC, &cacheEntry.handle);
+    if (error != VK_SUCCESS) {
+        FVK_LOGE << "fragment-output library creation error " << error << utils::io::endl;
+        return VK_NULL_HANDLE;
+    }
+    mFragmentOutputLibraries.emplace(key, cacheEntry);
+    return cacheEntry.handle;
+}
+
+VulkanPipelineCache::PipelineCacheEntry*
+VulkanPipelineCache::createPipelineFromLibraries() noexcept {
+    assert_invariant(mPipelineRequirements.shaders[0] && "Vertex shader is not bound.");
+    assert_invariant(mPipelineRequirements.layout && "No pipeline layout specified");
+
+    VkPipeline const libraries[4] = {
+        getOrCreateVertexInputLibrary(),
+        getOrCreatePreRasterizationLibrary(),
+        getOrCreateFragmentShaderLibrary(),
+        getOrCreateFragmentOutputLibrary(),
+    };
+    for (VkPipeline library : libraries) {
+        if (library == VK_NULL_HANDLE) {
+            // A library failed to compile; let the caller fall back to the monolithic path.
+            return nullptr;
+        }
+    }
+
+    // Link without VK_PIPELINE_CREATE_LINK_TIME_OPTIMIZATION_BIT_EXT: fast linking is the whole
+    // point here, and the driver-level VkPipelineCache still deduplicates the compiled slices.
+    VkPipelineLibraryCreateInfoKHR libraryInfo = {};
+    libraryInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LIBRARY_CREATE_INFO_KHR;
+    libraryInfo.libraryCount = 4;
+    libraryInfo.pLibraries = libraries;
+
+    VkGraphicsPipelineCreateInfo pipelineCreateInfo = {};
+    pipelineCreateInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    pipelineCreateInfo.pNext = &libraryInfo;
+    pipelineCreateInfo.layout = mPipelineRequirements.layout;
+
+    PipelineCacheEntry cacheEntry = {};
+    VkResult error = vkCreateGraphicsPipelines(mDevice, mPipelineCacheObject, 1,
+            &pipelineCreateInfo, VKALLOC, &cacheEntry.handle);
+    if (error != VK_SUCCESS) {
+        FVK_LOGE << "pipeline library link error " << error << utils::io::endl;
+        return nullptr;
+    }
+
+    return &mPipelines.emplace(mPipelineRequirements, cacheEntry).first.value();
+}
+
 void VulkanPipelineCache::bindProgram(VulkanProgram* program) noexcept {
     mPipelineRequirements.shaders[0] = program->getVertexShader();
     mPipelineRequirements.shaders[1] = program->getFragmentShader();
@@ -292,9 +692,37 @@ void VulkanPipelineCache::terminate() noexcept {
     }
     mPipelines.clear();
     mBoundPipeline = {};
+
+    auto destroyLibraries = [this](auto& cache) {
+        for (auto& iter : cache) {
+            vkDestroyPipeline(mDevice, iter.second.handle, VKALLOC);
+        }
+        cache.clear();
+    };
+    destroyLibraries(mVertexInputLibraries);
+    destroyLibraries(mPreRasterizationLibraries);
+    destroyLibraries(mFragmentShaderLibraries);
+    destroyLibraries(mFragmentOutputLibraries);
+
+    if (mPipelineCacheObject != VK_NULL_HANDLE) {
+        // persist the pipeline binaries so the next run skips compilation entirely
+        if (mPlatform && mPlatform->hasInsertBlobFunc()) {
+            size_t size = 0;
+            if (vkGetPipelineCacheData(mDevice, mPipelineCacheObject, &size, nullptr)
+                    == VK_SUCCESS && size > 0) {
+                auto data = std::make_unique<char[]>(size);
+                if (vkGetPipelineCacheData(mDevice, mPipelineCacheObject, &size, data.get())
+                        == VK_SUCCESS) {
+                    mPlatform->insertBlob(&mCacheKey, sizeof(mCacheKey), data.get(), size);
+                }
+            }
+        }
+        vkDestroyPipelineCache(mDevice, mPipelineCacheObject, VKALLOC);
+        mPipelineCacheObject = VK_NULL_HANDLE;
+    }
 }
 
-void VulkanPipelineCache::gc() noexcept {
+void VulkanPipelineCache::advanceFrame() noexcept {
     // The timestamp associated with a given cache entry represents "time" as a count of flush
     // events since the cache was constructed. If any cache entry was most recently used over
     // FVK_MAX_PIPELINE_AGE flush events in the past, then we can be sure that it is no longer
@@ -304,6 +732,10 @@ void VulkanPipelineCache::gc() noexcept {
     // The Vulkan spec says: "When a command buffer begins recording, all state in that command
     // buffer is undefined." Therefore, we need to clear all bindings at this time.
     mBoundPipeline = {};
+}
+
+size_t VulkanPipelineCache::gc() noexcept {
+    size_t evicted = 0;
 
     // NOTE: Due to robin_map restrictions, we cannot use auto or range-based loops.
 
@@ -315,10 +747,34 @@ void VulkanPipelineCache::gc() noexcept {
        if (cacheEntry.lastUsed + FVK_MAX_PIPELINE_AGE < mCurrentTime) {
            vkDestroyPipeline(mDevice, iter->second.handle, VKALLOC);
            iter = mPipelines.erase(iter);
+           evicted++;
        } else {
            ++iter;
        }
    }
+
+    // Pipeline libraries age out with the same policy. Fully linked pipelines do not keep
+    // references to the libraries they were linked from, so a library can be destroyed even
+    // while pipelines built from it are still alive.
+    auto evictLibraries = [this, &evicted](auto& cache) {
+        using ConstIterator = typename std::decay_t<decltype(cache)>::const_iterator;
+        for (ConstIterator iter = cache.begin(); iter != cache.end();) {
+            const PipelineCacheEntry& cacheEntry = iter.value();
+            if (cacheEntry.lastUsed + FVK_MAX_PIPELINE_AGE < mCurrentTime) {
+                vkDestroyPipeline(mDevice, iter->second.handle, VKALLOC);
+                iter = cache.erase(iter);
+                evicted++;
+            } else {
+                ++iter;
+            }
+        }
+    };
+    evictLibraries(mVertexInputLibraries);
+    evictLibraries(mPreRasterizationLibraries);
+    evictLibraries(mFragmentShaderLibraries);
+    evictLibraries(mFragmentOutputLibraries);
+
+    return evicted;
 }
 
 bool VulkanPipelineCache::PipelineEqual::operator()(const PipelineKey& k1,
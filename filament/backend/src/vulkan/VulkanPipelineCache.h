@@ -33,6 +33,8 @@
 #include <utils/compiler.h>
 #include <utils/Hash.h>
 
+#include <string.h>
+
 #include <list>
 #include <tsl/robin_map.h>
 #include <type_traits>
@@ -41,6 +43,7 @@
 
 namespace filament::backend {
 
+class Platform;
 struct VulkanProgram;
 struct VulkanBufferObject;
 struct VulkanTexture;
@@ -116,11 +119,30 @@ public:
     VulkanPipelineCache(VkDevice device, VmaAllocator allocator);
     ~VulkanPipelineCache();
 
+    // Creates the driver-level VkPipelineCache, seeded from the Platform blob cache (the same
+    // interface the GL backend persists program binaries through, see OpenGLBlobCache), so that
+    // pipelines compiled in a previous run are rebuilt from their cached binaries. Must be
+    // called before the first pipeline is created; terminate() persists the cache data back
+    // through Platform::insertBlob().
+    void initCache(Platform* platform, VkPhysicalDeviceProperties const& properties) noexcept;
+
+    // Enables assembly of pipelines by fast-linking the four VK_EXT_graphics_pipeline_library
+    // state libraries (vertex input, pre-rasterization, fragment shader, fragment output)
+    // instead of compiling each pipeline monolithically. The caller is responsible for checking
+    // device support (see VulkanContext::isGraphicsPipelineLibrarySupported).
+    void setGraphicsPipelineLibraryEnabled(bool enabled) noexcept {
+        mGraphicsPipelineLibraryEnabled = enabled;
+    }
+
     void bindLayout(VkPipelineLayout layout) noexcept;
 
     // Creates a new pipeline if necessary and binds it using vkCmdBindPipeline.
     void bindPipeline(VulkanCommandBuffer* commands);
 
+    // Creates (or finds) a pipeline matching the current requirements without binding it. This is
+    // used to pre-warm the cache outside of a render pass (see DriverApi::precachePipeline).
+    void precachePipeline() noexcept { getOrCreatePipeline(); }
+
     // Each of the following methods are fast and do not make Vulkan calls.
     void bindProgram(VulkanProgram* program) noexcept;
     void bindRasterState(const RasterState& rasterState) noexcept;
@@ -148,7 +170,15 @@ public:
         }
     }
 
-    void gc() noexcept;
+    // Advances the cache's frame clock and clears the bound state; must be called once per
+    // frame. The Vulkan spec says "when a command buffer begins recording, all state in that
+    // command buffer is undefined", so bindings cannot carry over from one frame to the next.
+    void advanceFrame() noexcept;
+
+    // Evicts pipelines and pipeline libraries that have not been used in a while, returning
+    // the number of objects destroyed. Eviction ages are measured in advanceFrame() ticks, so
+    // deferring a sweep only retains entries longer.
+    size_t gc() noexcept;
 
 private:
     // PIPELINE CACHE KEY
@@ -214,6 +244,82 @@ private:
         bool operator()(const PipelineKey& k1, const PipelineKey& k2) const;
     };
 
+    // PIPELINE LIBRARY KEYS
+    // ---------------------
+
+    // Each key below captures the subset of PipelineKey that feeds exactly one of the four
+    // VK_EXT_graphics_pipeline_library state libraries, so that the slices can be cached and
+    // reused independently: e.g. every pipeline drawing a given vertex layout shares one
+    // vertex-input library regardless of shaders, blending or render pass.
+
+    struct VertexInputKey {                                                   // size : offset
+        VertexInputAttributeDescription vertexAttributes[VERTEX_ATTRIBUTE_COUNT]; // 128 : 0
+        VertexInputBindingDescription vertexBuffers[VERTEX_ATTRIBUTE_COUNT];  //  128 : 128
+        uint16_t topology;                                                    //  2   : 256
+        uint16_t padding[3];                                                  //  6   : 258
+    };
+
+    static_assert(sizeof(VertexInputKey) == 264, "VertexInputKey must not have implicit padding.");
+
+    struct PreRasterizationKey {      // size : offset
+        VkShaderModule vertexShader;  //  8   : 0
+        VkPipelineLayout layout;      //  8   : 8
+        VkRenderPass renderPass;      //  8   : 16
+        uint16_t subpassIndex;        //  2   : 24
+        uint8_t cullMode;             //  1   : 26
+        uint8_t frontFace;            //  1   : 27
+        uint8_t depthBiasEnable;      //  1   : 28
+        uint8_t depthClamp;           //  1   : 29
+        uint16_t padding;             //  2   : 30
+        float depthBiasConstantFactor;//  4   : 32
+        float depthBiasSlopeFactor;   //  4   : 36
+    };
+
+    static_assert(sizeof(PreRasterizationKey) == 40,
+            "PreRasterizationKey must not have implicit padding.");
+
+    struct FragmentShaderKey {          // size : offset
+        VkShaderModule fragmentShader;  //  8   : 0
+        VkPipelineLayout layout;        //  8   : 8
+        VkRenderPass renderPass;        //  8   : 16
+        uint16_t subpassIndex;          //  2   : 24
+        uint8_t depthWriteEnable;       //  1   : 26
+        uint8_t depthCompareOp;         //  1   : 27
+        uint8_t rasterizationSamples;   //  1   : 28
+        uint8_t alphaToCoverageEnable;  //  1   : 29
+        uint16_t padding;               //  2   : 30
+    };
+
+    static_assert(sizeof(FragmentShaderKey) == 32,
+            "FragmentShaderKey must not have implicit padding.");
+
+    struct FragmentOutputKey {          // size : offset
+        VkRenderPass renderPass;        //  8   : 0
+        uint16_t subpassIndex;          //  2   : 8
+        uint8_t blendEnable;            //  1   : 10
+        uint8_t srcColorBlendFactor;    //  1   : 11
+        uint8_t dstColorBlendFactor;    //  1   : 12
+        uint8_t srcAlphaBlendFactor;    //  1   : 13
+        uint8_t dstAlphaBlendFactor;    //  1   : 14
+        uint8_t colorBlendOp;           //  1   : 15
+        uint8_t alphaBlendOp;           //  1   : 16
+        uint8_t colorWriteMask;         //  1   : 17
+        uint8_t colorTargetCount;       //  1   : 18
+        uint8_t rasterizationSamples;   //  1   : 19
+        uint8_t alphaToCoverageEnable;  //  1   : 20
+        uint8_t padding[3];             //  3   : 21
+    };
+
+    static_assert(sizeof(FragmentOutputKey) == 24,
+            "FragmentOutputKey must not have implicit padding.");
+
+    template <typename K>
+    struct LibraryKeyEqual {
+        bool operator()(const K& k1, const K& k2) const {
+            return 0 == memcmp((const void*) &k1, (const void*) &k2, sizeof(K));
+        }
+    };
+
     #pragma clang diagnostic pop
 
     // CACHE ENTRY STRUCTS
@@ -242,20 +348,55 @@ private:
     using PipelineMap = tsl::robin_map<PipelineKey, PipelineCacheEntry,
             PipelineHashFn, PipelineEqual>;
 
+    template <typename K>
+    using LibraryMap = tsl::robin_map<K, PipelineCacheEntry,
+            utils::hash::MurmurHashFn<K>, LibraryKeyEqual<K>>;
+
 private:
 
     PipelineCacheEntry* getOrCreatePipeline() noexcept;
 
     PipelineMap mPipelines;
 
+    LibraryMap<VertexInputKey> mVertexInputLibraries;
+    LibraryMap<PreRasterizationKey> mPreRasterizationLibraries;
+    LibraryMap<FragmentShaderKey> mFragmentShaderLibraries;
+    LibraryMap<FragmentOutputKey> mFragmentOutputLibraries;
+
     // These helpers all return unstable pointers that should not be stored.
     PipelineCacheEntry* createPipeline() noexcept;
+    PipelineCacheEntry* createPipelineFromLibraries() noexcept;
     PipelineLayoutCacheEntry* getOrCreatePipelineLayout() noexcept;
 
+    // Each of these compiles (or reuses) one independent slice of the currently bound pipeline
+    // state; createPipelineFromLibraries() links the four slices into a complete pipeline.
+    VkPipeline getOrCreateVertexInputLibrary() noexcept;
+    VkPipeline getOrCreatePreRasterizationLibrary() noexcept;
+    VkPipeline getOrCreateFragmentShaderLibrary() noexcept;
+    VkPipeline getOrCreateFragmentOutputLibrary() noexcept;
+
+    bool mGraphicsPipelineLibraryEnabled = false;
+
     // Immutable state.
     VkDevice mDevice = VK_NULL_HANDLE;
     VmaAllocator mAllocator = VK_NULL_HANDLE;
 
+    // Versioned blob-cache key identifying the device the cached pipeline data belongs to; the
+    // driver additionally validates the blob's own header against the pipelineCacheUUID.
+    struct CacheBlobKey {
+        char tag[8];
+        uint32_t version;
+        uint32_t vendorId;
+        uint32_t deviceId;
+        uint32_t driverVersion;
+        uint8_t uuid[VK_UUID_SIZE];
+    };
+    static_assert(std::is_trivially_copyable<CacheBlobKey>::value);
+
+    Platform* mPlatform = nullptr;
+    CacheBlobKey mCacheKey = {};
+    VkPipelineCache mPipelineCacheObject = VK_NULL_HANDLE;
+
     // Current requirements for the pipeline layout, pipeline, and descriptor sets.
     PipelineKey mPipelineRequirements = {};
 
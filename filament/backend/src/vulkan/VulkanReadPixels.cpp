@@ -24,6 +24,8 @@
 
 #include <utils/Log.h>
 
+#include <algorithm>
+
 using namespace bluevk;
 
 namespace filament::backend {
@@ -107,53 +109,42 @@ void VulkanReadPixels::terminate() noexcept {
     if (mCommandPool == VK_NULL_HANDLE) {
         return;
     }
-    vkDestroyCommandPool(mDevice, mCommandPool, VKALLOC);
+    VkDevice const device = mDevice;
+    vkDestroyCommandPool(device, mCommandPool, VKALLOC);
     mDevice = VK_NULL_HANDLE;
 
     mTaskHandler->shutdown();
     mTaskHandler.reset();
-}
-
-VulkanReadPixels::VulkanReadPixels(VkDevice device)
-    : mDevice(device) {}
-
-void VulkanReadPixels::run(VulkanRenderTarget* srcTarget, uint32_t const x, uint32_t const y,
-        uint32_t const width, uint32_t const height, uint32_t const graphicsQueueFamilyIndex,
-        PixelBufferDescriptor&& pbd, SelecteMemoryFunction const& selectMemoryFunc,
-        OnReadCompleteFunction const& readCompleteFunc) {
-    assert_invariant(mDevice != VK_NULL_HANDLE);
 
-    VkDevice& device = mDevice;
-
-    if (mCommandPool == VK_NULL_HANDLE) {
-        // Create a command pool if one has not been created.
-        VkCommandPoolCreateInfo createInfo = {
-                .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
-                .flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT
-                         | VK_COMMAND_POOL_CREATE_TRANSIENT_BIT,
-                .queueFamilyIndex = graphicsQueueFamilyIndex,
-        };
-        vkCreateCommandPool(device, &createInfo, VKALLOC, &mCommandPool);
+    // The task handler's thread has been joined, so no stage can be in flight anymore.
+    for (auto const& stage: mFreeStages) {
+        vkDestroyImage(device, stage.image, VKALLOC);
+        vkFreeMemory(device, stage.memory, VKALLOC);
     }
+    mFreeStages.clear();
+}
 
-    // We don't create a task handler (start a thread) unless readPixels is called.
-    if (!mTaskHandler) {
-        mTaskHandler = std::make_unique<TaskHandler>();
+VulkanReadPixels::StagingImage VulkanReadPixels::acquireStage(VkDevice device,
+        VkFormat const format, uint32_t const width, uint32_t const height,
+        SelecteMemoryFunction const& selectMemoryFunc) {
+    {
+        std::lock_guard<std::mutex> const lock(mFreeStagesMutex);
+        auto const it = std::find_if(mFreeStages.begin(), mFreeStages.end(),
+                [&](StagingImage const& stage) {
+                    return stage.format == format && stage.width == width
+                           && stage.height == height;
+                });
+        if (it != mFreeStages.end()) {
+            StagingImage const stage = *it;
+            mFreeStages.erase(it);
+            return stage;
+        }
     }
 
-    VkCommandPool& cmdpool = mCommandPool;
-
-    VulkanTexture* srcTexture = srcTarget->getColor0().texture;
-    assert_invariant(srcTexture);
-    VkFormat const srcFormat = srcTexture->getVkFormat();
-    bool const swizzle
-            = srcFormat == VK_FORMAT_B8G8R8A8_UNORM || srcFormat == VK_FORMAT_B8G8R8A8_SRGB;
-
-    // Create a host visible, linearly tiled image as a staging area.
     VkImageCreateInfo const imageInfo{
             .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
             .imageType = VK_IMAGE_TYPE_2D,
-            .format = srcFormat,
+            .format = format,
             .extent = {width, height, 1},
             .mipLevels = 1,
             .arrayLayers = 1,
@@ -163,18 +154,12 @@ void VulkanReadPixels::run(VulkanRenderTarget* srcTarget, uint32_t const x, uint
             .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
     };
 
-    VkImage stagingImage;
-    vkCreateImage(device, &imageInfo, VKALLOC, &stagingImage);
-
-#if FVK_ENABLED(FVK_DEBUG_READ_PIXELS)
-    FVK_LOGD << "readPixels created image=" << stagingImage
-             << " to copy from image=" << srcTexture->getVkImage()
-             << " src-layout=" << srcTexture->getLayout(0, 0) << utils::io::endl;
-#endif
+    VkImage image;
+    vkCreateImage(device, &imageInfo, VKALLOC, &image);
 
     VkMemoryRequirements memReqs;
-    VkDeviceMemory stagingMemory;
-    vkGetImageMemoryRequirements(device, stagingImage, &memReqs);
+    VkDeviceMemory memory;
+    vkGetImageMemoryRequirements(device, image, &memReqs);
 
     uint32_t memoryTypeIndex = selectMemoryFunc(memReqs.memoryTypeBits,
             VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
@@ -199,8 +184,79 @@ void VulkanReadPixels::run(VulkanRenderTarget* srcTarget, uint32_t const x, uint
             .memoryTypeIndex = memoryTypeIndex,
     };
 
-    vkAllocateMemory(device, &allocInfo, VKALLOC, &stagingMemory);
-    vkBindImageMemory(device, stagingImage, stagingMemory, 0);
+    vkAllocateMemory(device, &allocInfo, VKALLOC, &memory);
+    vkBindImageMemory(device, image, memory, 0);
+
+    return {
+        .image = image,
+        .memory = memory,
+        .format = format,
+        .width = width,
+        .height = height,
+    };
+}
+
+void VulkanReadPixels::releaseStage(VkDevice device, StagingImage const& stage) noexcept {
+    // Keep a handful of stages around; anything beyond that is returned to the driver. The cap
+    // mostly matters when the read-back size changes, e.g. after a window resize.
+    constexpr size_t MAX_FREE_STAGES = 4;
+    {
+        std::lock_guard<std::mutex> const lock(mFreeStagesMutex);
+        if (mFreeStages.size() < MAX_FREE_STAGES) {
+            mFreeStages.push_back(stage);
+            return;
+        }
+    }
+    vkDestroyImage(device, stage.image, VKALLOC);
+    vkFreeMemory(device, stage.memory, VKALLOC);
+}
+
+VulkanReadPixels::VulkanReadPixels(VkDevice device)
+    : mDevice(device) {}
+
+void VulkanReadPixels::run(VulkanRenderTarget* srcTarget, uint32_t const x, uint32_t const y,
+        uint32_t const width, uint32_t const height, uint32_t const graphicsQueueFamilyIndex,
+        PixelBufferDescriptor&& pbd, SelecteMemoryFunction const& selectMemoryFunc,
+        OnReadCompleteFunction const& readCompleteFunc) {
+    assert_invariant(mDevice != VK_NULL_HANDLE);
+
+    VkDevice& device = mDevice;
+
+    if (mCommandPool == VK_NULL_HANDLE) {
+        // Create a command pool if one has not been created.
+        VkCommandPoolCreateInfo createInfo = {
+                .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+                .flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT
+                         | VK_COMMAND_POOL_CREATE_TRANSIENT_BIT,
+                .queueFamilyIndex = graphicsQueueFamilyIndex,
+        };
+        vkCreateCommandPool(device, &createInfo, VKALLOC, &mCommandPool);
+    }
+
+    // We don't create a task handler (start a thread) unless readPixels is called.
+    if (!mTaskHandler) {
+        mTaskHandler = std::make_unique<TaskHandler>();
+    }
+
+    VkCommandPool& cmdpool = mCommandPool;
+
+    VulkanTexture* srcTexture = srcTarget->getColor0().texture;
+    assert_invariant(srcTexture);
+    VkFormat const srcFormat = srcTexture->getVkFormat();
+    bool const swizzle
+            = srcFormat == VK_FORMAT_B8G8R8A8_UNORM || srcFormat == VK_FORMAT_B8G8R8A8_SRGB;
+
+    // Acquire a host visible, linearly tiled image as a staging area, recycling a previous one
+    // when the format and size match.
+    StagingImage const stage = acquireStage(device, srcFormat, width, height, selectMemoryFunc);
+    VkImage const stagingImage = stage.image;
+    VkDeviceMemory const stagingMemory = stage.memory;
+
+#if FVK_ENABLED(FVK_DEBUG_READ_PIXELS)
+    FVK_LOGD << "readPixels acquired image=" << stagingImage
+             << " to copy from image=" << srcTexture->getVkImage()
+             << " src-layout=" << srcTexture->getLayout(0, 0) << utils::io::endl;
+#endif
 
     VkCommandBuffer cmdbuffer;
     VkCommandBufferAllocateInfo const allocateInfo{
@@ -297,9 +353,8 @@ void VulkanReadPixels::run(VulkanRenderTarget* srcTarget, uint32_t const x, uint
         readCompleteFunc(std::move(p));
         delete pUserBuffer;
     };
-    auto waitFenceFunc = [device, width, height, swizzle, srcFormat, stagingImage, stagingMemory,
-                                 cmdpool, cmdbuffer, pUserBuffer,
-                                 fence = readCompleteFence]() mutable {
+    auto waitFenceFunc = [this, device, width, height, swizzle, srcFormat, stage, cmdpool,
+                                 cmdbuffer, pUserBuffer, fence = readCompleteFence]() mutable {
         VkResult status = vkWaitForFences(device, 1, &fence, VK_TRUE, UINT64_MAX);
         // Fence hasn't been reached. Try waiting again.
         if (status != VK_SUCCESS) {
@@ -310,11 +365,11 @@ void VulkanReadPixels::run(VulkanRenderTarget* srcTarget, uint32_t const x, uint
         PixelBufferDescriptor& p = *pUserBuffer;
         VkImageSubresource subResource{.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT};
         VkSubresourceLayout subResourceLayout;
-        vkGetImageSubresourceLayout(device, stagingImage, &subResource, &subResourceLayout);
+        vkGetImageSubresourceLayout(device, stage.image, &subResource, &subResourceLayout);
 
         // Map image memory so that we can start copying from it.
         uint8_t const* srcPixels;
-        vkMapMemory(device, stagingMemory, 0, VK_WHOLE_SIZE, 0, (void**) &srcPixels);
+        vkMapMemory(device, stage.memory, 0, VK_WHOLE_SIZE, 0, (void**) &srcPixels);
         srcPixels += subResourceLayout.offset;
 
         if (!DataReshaper::reshapeImage(&p, getComponentType(srcFormat),
@@ -324,9 +379,8 @@ void VulkanReadPixels::run(VulkanRenderTarget* srcTarget, uint32_t const x, uint
             FVK_LOGE << "Unsupported PixelDataFormat or PixelDataType" << utils::io::endl;
         }
 
-        vkUnmapMemory(device, stagingMemory);
-        vkDestroyImage(device, stagingImage, VKALLOC);
-        vkFreeMemory(device, stagingMemory, VKALLOC);
+        vkUnmapMemory(device, stage.memory);
+        releaseStage(device, stage);
         vkDestroyFence(device, fence, VKALLOC);
         vkFreeCommandBuffers(device, cmdpool, 1, &cmdbuffer);
     };
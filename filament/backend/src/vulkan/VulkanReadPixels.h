@@ -27,6 +27,7 @@
 #include <mutex>
 #include <queue>
 #include <thread>
+#include <vector>
 
 namespace filament::backend {
 
@@ -81,9 +82,33 @@ public:
     void runUntilComplete() noexcept;
 
 private:
+    // A host-visible, linearly-tiled staging image and its backing memory. Stages are recycled
+    // across readPixels calls to avoid per-request allocation churn: in-game screenshots and GPU
+    // picking tend to read back the same region size every frame.
+    struct StagingImage {
+        VkImage image = VK_NULL_HANDLE;
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        VkFormat format = VK_FORMAT_UNDEFINED;
+        uint32_t width = 0;
+        uint32_t height = 0;
+    };
+
+    // Returns a recycled stage matching the requested format and size, or creates a new one.
+    StagingImage acquireStage(VkDevice device, VkFormat format, uint32_t width, uint32_t height,
+            SelecteMemoryFunction const& selectMemoryFunc);
+
+    // Returns a stage to the free list (or destroys it if the list is full). Called from the task
+    // handler's thread once the readback has been consumed.
+    void releaseStage(VkDevice device, StagingImage const& stage) noexcept;
+
     VkDevice mDevice = VK_NULL_HANDLE;
     VkCommandPool mCommandPool = VK_NULL_HANDLE;
     std::unique_ptr<TaskHandler> mTaskHandler;
+
+    // Guards mFreeStages, which is accessed from both the driver thread (acquire) and the task
+    // handler's thread (release).
+    std::mutex mFreeStagesMutex;
+    std::vector<StagingImage> mFreeStages;
 };
 
 }// namespace filament::backend
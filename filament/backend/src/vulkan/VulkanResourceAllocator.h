@@ -25,6 +25,7 @@
 #include <utils/FixedCapacityVector.h>
 #include <utils/Log.h>
 
+#include <array>
 #include <type_traits>
 #include <unordered_set>
 
@@ -51,8 +52,10 @@ namespace filament::backend {
 class VulkanResourceAllocator {
 public:
     using AllocatorImpl = HandleAllocatorVK;
-    VulkanResourceAllocator(size_t arenaSize, bool disableUseAfterFreeCheck)
-        : mHandleAllocatorImpl("Handles", arenaSize, disableUseAfterFreeCheck)
+    VulkanResourceAllocator(size_t arenaSize, bool disableUseAfterFreeCheck,
+            bool enableHandleSanitizer, std::array<uint8_t, 3> poolWeights)
+        : mHandleAllocatorImpl("Handles", arenaSize, disableUseAfterFreeCheck,
+                enableHandleSanitizer, poolWeights)
 #if DEBUG_RESOURCE_LEAKS
         , mDebugOnlyResourceCount(RESOURCE_TYPE_COUNT) {
         std::memset(mDebugOnlyResourceCount.data(), 0, sizeof(size_t) * RESOURCE_TYPE_COUNT);
@@ -109,6 +112,10 @@ public:
         mHandleAllocatorImpl.associateTagToHandle(id, std::move(tag));
     }
 
+    inline HandleAllocatorStats getStats() const noexcept {
+        return mHandleAllocatorImpl.getStats();
+    }
+
 private:
     AllocatorImpl mHandleAllocatorImpl;
 
@@ -22,14 +22,29 @@
 #include "VulkanUtility.h"
 
 #include <utils/Panic.h>
+#include <utils/algorithm.h>
+
+#include <algorithm>
 
 static constexpr uint32_t TIME_BEFORE_EVICTION = FVK_MAX_COMMAND_BUFFERS;
 
+// Smallest stage we ever allocate; tiny uploads all share the same size class.
+static constexpr uint32_t MIN_STAGE_CAPACITY = 1024;
+
+// Round stage capacities up to power-of-two size classes, much like HandleAllocator's pools,
+// so a recycled stage can serve any request in its class instead of only exact-size matches.
+static uint32_t roundUpToSizeClass(uint32_t numBytes) noexcept {
+    uint32_t const v = std::max(numBytes, MIN_STAGE_CAPACITY);
+    return 1u << (32u - utils::clz(v - 1u));
+}
+
 namespace filament::backend {
 
-VulkanStagePool::VulkanStagePool(VmaAllocator allocator, VulkanCommands* commands)
+VulkanStagePool::VulkanStagePool(VmaAllocator allocator, VulkanCommands* commands,
+        size_t retentionBytes)
     : mAllocator(allocator),
-      mCommands(commands) {}
+      mCommands(commands),
+      mRetentionBytes(retentionBytes) {}
 
 VulkanStage const* VulkanStagePool::acquireStage(uint32_t numBytes) {
     // First check if a stage exists whose capacity is greater than or equal to the requested size.
@@ -38,21 +53,33 @@ VulkanStage const* VulkanStagePool::acquireStage(uint32_t numBytes) {
         auto stage = iter->second;
         mFreeStages.erase(iter);
         mUsedStages.insert(stage);
+        mFreeBytes -= stage->capacity;
+        mUsedBytes += stage->capacity;
+        mHighWaterBytes = std::max(mHighWaterBytes, mUsedBytes);
+        mStageHits++;
+        stage->lastAccessed = mCurrentFrame;
+        stage->lastSubmission = mCommands->getNextSubmissionValue();
         return stage;
     }
     // We were not able to find a sufficiently large stage, so create a new one.
+    mStageMisses++;
+    uint32_t const capacity = roundUpToSizeClass(numBytes);
     VulkanStage* stage = new VulkanStage({
         .memory = VK_NULL_HANDLE,
         .buffer = VK_NULL_HANDLE,
-        .capacity = numBytes,
+        .capacity = capacity,
         .lastAccessed = mCurrentFrame,
+        .lastSubmission = mCommands->getNextSubmissionValue(),
     });
 
     // Create the VkBuffer.
     mUsedStages.insert(stage);
+    mUsedBytes += capacity;
+    mHighWaterBytes = std::max(mHighWaterBytes, mUsedBytes);
+    mStageAllocatedBytes += capacity;
     VkBufferCreateInfo bufferInfo {
         .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
-        .size = numBytes,
+        .size = capacity,
         .usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
     };
     VmaAllocationCreateInfo allocInfo { .usage = VMA_MEMORY_USAGE_CPU_ONLY };
@@ -75,6 +102,8 @@ VulkanStageImage const* VulkanStagePool::acquireImage(PixelDataFormat format, Pi
         if (image->format == vkformat && image->width == width && image->height == height) {
             mFreeImages.erase(image);
             mUsedImages.insert(image);
+            image->lastAccessed = mCurrentFrame;
+            image->lastSubmission = mCommands->getNextSubmissionValue();
             return image;
         }
     }
@@ -84,6 +113,7 @@ VulkanStageImage const* VulkanStagePool::acquireImage(PixelDataFormat format, Pi
         .width = width,
         .height = height,
         .lastAccessed = mCurrentFrame,
+        .lastSubmission = mCommands->getNextSubmissionValue(),
     });
 
     mUsedImages.insert(image);
@@ -128,25 +158,39 @@ VulkanStageImage const* VulkanStagePool::acquireImage(PixelDataFormat format, Pi
     return image;
 }
 
-void VulkanStagePool::gc() noexcept {
+size_t VulkanStagePool::gc() noexcept {
     FVK_SYSTRACE_CONTEXT();
     FVK_SYSTRACE_START("stagepool::gc");
 
     // If this is one of the first few frames, return early to avoid wrapping unsigned integers.
     if (++mCurrentFrame <= TIME_BEFORE_EVICTION) {
-        return;
+        FVK_SYSTRACE_END();
+        return 0;
     }
+    size_t evicted = 0;
     const uint64_t evictionTime = mCurrentFrame - TIME_BEFORE_EVICTION;
 
-    // Destroy buffers that have not been used for several frames.
+    // When timeline semaphores are available this is the exact set of retired submissions;
+    // otherwise it stays 0 and reclamation falls back to the frame-count heuristic below.
+    const uint64_t completed = mCommands->getCompletedSubmissionValue();
+
+    // Retention target: keep free stages alive up to the configured cap, or up to a decaying
+    // high-water mark of recent demand, so steady-state streaming stops reallocating.
+    mHighWaterBytes -= mHighWaterBytes / 16;
+    uint64_t const targetBytes = mRetentionBytes ? mRetentionBytes : mHighWaterBytes;
+
+    // Destroy stale buffers, largest first, but only while the pool exceeds its retention target.
     decltype(mFreeStages) freeStages;
     freeStages.swap(mFreeStages);
-    for (auto pair : freeStages) {
-        if (pair.second->lastAccessed < evictionTime) {
-            vmaDestroyBuffer(mAllocator, pair.second->buffer, pair.second->memory);
-            delete pair.second;
+    for (auto it = freeStages.rbegin(); it != freeStages.rend(); ++it) {
+        auto stage = it->second;
+        if (stage->lastAccessed < evictionTime && mFreeBytes > targetBytes) {
+            mFreeBytes -= stage->capacity;
+            vmaDestroyBuffer(mAllocator, stage->buffer, stage->memory);
+            delete stage;
+            evicted++;
         } else {
-            mFreeStages.insert(pair);
+            mFreeStages.insert(*it);
         }
     }
 
@@ -154,9 +198,11 @@ void VulkanStagePool::gc() noexcept {
     decltype(mUsedStages) usedStages;
     usedStages.swap(mUsedStages);
     for (auto stage : usedStages) {
-        if (stage->lastAccessed < evictionTime) {
+        if (stage->lastSubmission <= completed || stage->lastAccessed < evictionTime) {
             stage->lastAccessed = mCurrentFrame;
             mFreeStages.insert(std::make_pair(stage->capacity, stage));
+            mFreeBytes += stage->capacity;
+            mUsedBytes -= stage->capacity;
         } else {
             mUsedStages.insert(stage);
         }
@@ -169,6 +215,7 @@ void VulkanStagePool::gc() noexcept {
         if (image->lastAccessed < evictionTime) {
             vmaDestroyImage(mAllocator, image->image, image->memory);
             delete image;
+            evicted++;
         } else {
             mFreeImages.insert(image);
         }
@@ -178,14 +225,25 @@ void VulkanStagePool::gc() noexcept {
     decltype(mUsedImages) usedImages;
     usedImages.swap(mUsedImages);
     for (auto image : usedImages) {
-        if (image->lastAccessed < evictionTime) {
+        if (image->lastSubmission <= completed || image->lastAccessed < evictionTime) {
             image->lastAccessed = mCurrentFrame;
             mFreeImages.insert(image);
         } else {
             mUsedImages.insert(image);
         }
     }
+
+#if FVK_ENABLED(FVK_DEBUG_ALLOCATION)
+    if ((mCurrentFrame & 0xFFu) == 0) {
+        FVK_LOGD << "VulkanStagePool: hits=" << mStageHits << " misses=" << mStageMisses
+                 << " allocated=" << (mStageAllocatedBytes / 1024) << " KiB"
+                 << " free=" << (mFreeBytes / 1024) << " KiB"
+                 << " target=" << (targetBytes / 1024) << " KiB" << utils::io::endl;
+    }
+#endif
+
     FVK_SYSTRACE_END();
+    return evicted;
 }
 
 void VulkanStagePool::terminate() noexcept {
@@ -205,13 +263,16 @@ void VulkanStagePool::terminate() noexcept {
         vmaDestroyImage(mAllocator, image->image, image->memory);
         delete image;
     }
-    mUsedStages.clear();
+    mUsedImages.clear();
 
     for (auto image : mFreeImages) {
         vmaDestroyImage(mAllocator, image->image, image->memory);
         delete image;
     }
-    mFreeStages.clear();
+    mFreeImages.clear();
+
+    mFreeBytes = 0;
+    mUsedBytes = 0;
 }
 
 } // namespace filament::backend
@@ -32,6 +32,8 @@ struct VulkanStage {
     VkBuffer buffer;
     uint32_t capacity;
     mutable uint64_t lastAccessed;
+    // Submission timeline value of the last command buffer that may reference this stage.
+    mutable uint64_t lastSubmission;
 };
 
 struct VulkanStageImage {
@@ -39,6 +41,7 @@ struct VulkanStageImage {
     uint32_t width;
     uint32_t height;
     mutable uint64_t lastAccessed;
+    mutable uint64_t lastSubmission;
     VmaAllocation memory;
     VkImage image;
 };
@@ -47,18 +50,25 @@ struct VulkanStageImage {
 // This class manages two types of host-mappable staging areas: buffer stages and image stages.
 class VulkanStagePool {
 public:
-    VulkanStagePool(VmaAllocator allocator, VulkanCommands* commands);
-
-    // Finds or creates a stage whose capacity is at least the given number of bytes.
-    // The stage is automatically released back to the pool after TIME_BEFORE_EVICTION frames.
+    // `retentionBytes` caps the free staging memory kept pooled between frames; 0 tracks a
+    // decaying high-water mark of recent demand instead. See
+    // Engine::Config::vulkanStagingRetentionBytes.
+    VulkanStagePool(VmaAllocator allocator, VulkanCommands* commands, size_t retentionBytes);
+
+    // Finds or creates a stage whose capacity is at least the given number of bytes. New stages
+    // are rounded up to power-of-two size classes so they can be recycled for any request in
+    // the same class. The stage is released back to the pool once the submission that consumes
+    // it retires on the timeline, or after TIME_BEFORE_EVICTION frames when timeline semaphores
+    // are unavailable.
     VulkanStage const* acquireStage(uint32_t numBytes);
 
     // Images have VK_IMAGE_LAYOUT_GENERAL and must not be transitioned to any other layout
     VulkanStageImage const* acquireImage(PixelDataFormat format, PixelDataType type,
             uint32_t width, uint32_t height);
 
-    // Evicts old unused stages and bumps the current frame number.
-    void gc() noexcept;
+    // Evicts old unused stages and bumps the current frame number. Returns the number of
+    // stages and images destroyed.
+    size_t gc() noexcept;
 
     // Destroys all unused stages and asserts that there are no stages currently in use.
     // This should be called while the context's VkDevice is still alive.
@@ -79,6 +89,19 @@ private:
 
     // Store the current "time" (really just a frame count) and LRU eviction parameters.
     uint64_t mCurrentFrame = 0;
+
+    // Retention policy: free buffer stages stale enough for eviction are destroyed only while
+    // the pool holds more than this many free bytes (the configured cap, or a decaying
+    // high-water mark of recent demand when the cap is 0).
+    size_t const mRetentionBytes;
+    uint64_t mFreeBytes = 0;
+    uint64_t mUsedBytes = 0;
+    uint64_t mHighWaterBytes = 0;
+
+    // Telemetry, logged periodically by gc() when FVK_DEBUG_ALLOCATION is enabled.
+    uint64_t mStageHits = 0;
+    uint64_t mStageMisses = 0;
+    uint64_t mStageAllocatedBytes = 0;
 };
 
 } // namespace filament::backend
@@ -23,8 +23,11 @@
 #include <backend/DriverEnums.h>
 #include <private/backend/BackendUtils.h>
 
+#include <utils/FixedCapacityVector.h>
 #include <utils/Panic.h>
 
+#include <algorithm>
+
 using namespace bluevk;
 
 namespace filament::backend {
@@ -508,6 +511,103 @@ void VulkanTexture::updateImage(const PixelBufferDescriptor& data, uint32_t widt
     transitionLayout(&commands, transitionRange, nextLayout);
 }
 
+void VulkanTexture::updateImageBatch(TextureUpdateRegion const* regions, uint32_t regionCount,
+        const PixelBufferDescriptor& data) {
+    assert_invariant(regionCount > 0);
+    auto* const state = getSharedState();
+    assert_invariant(state->mIsProtected == false);
+
+    // Reshaping and blit-based format conversion work one region at a time, so when either is
+    // required fall back to discrete updates; the batch then degrades gracefully instead of
+    // rejecting the upload.
+    const VkFormat hostFormat = backend::getVkFormat(data.format, data.type);
+    const VkFormat deviceFormat = getVkFormatLinear(state->mVkFormat);
+    if (UTILS_UNLIKELY(hostFormat != deviceFormat)) {
+        for (uint32_t i = 0; i < regionCount; i++) {
+            TextureUpdateRegion const& r = regions[i];
+            size_t const size = PixelBufferDescriptor::computeDataSize(data.format, data.type,
+                    r.width, r.height, data.alignment) * r.depth;
+            PixelBufferDescriptor const view(
+                    static_cast<char const*>(data.buffer) + r.bufferOffset, size,
+                    data.format, data.type, data.alignment);
+            updateImage(view, r.width, r.height, r.depth,
+                    r.xoffset, r.yoffset, r.zoffset, r.level);
+        }
+        return;
+    }
+
+    assert_invariant(data.size > 0 && "Data is empty");
+
+    // One staging buffer and one copy for the whole batch; every region addresses the stage
+    // through its bufferOffset.
+    void* mapped = nullptr;
+    VulkanStage const* stage = state->mStagePool.acquireStage(data.size);
+    assert_invariant(stage->memory);
+    vmaMapMemory(state->mAllocator, stage->memory, &mapped);
+    memcpy(mapped, data.buffer, data.size);
+    vmaUnmapMemory(state->mAllocator, stage->memory);
+    vmaFlushAllocation(state->mAllocator, stage->memory, 0, data.size);
+
+    VulkanCommandBuffer& commands = state->mCommands->get();
+    VkCommandBuffer const cmdbuf = commands.buffer();
+    commands.acquire(this);
+
+    // Vulkan specifies subregions for 3D textures differently than from 2D arrays.
+    bool const layered = target == SamplerType::SAMPLER_2D_ARRAY ||
+            target == SamplerType::SAMPLER_CUBEMAP ||
+            target == SamplerType::SAMPLER_CUBEMAP_ARRAY;
+
+    auto copyRegions = utils::FixedCapacityVector<VkBufferImageCopy>::with_capacity(regionCount);
+    uint32_t minMip = UINT32_MAX, maxMip = 0;
+    uint32_t minLayer = UINT32_MAX, maxLayer = 0;
+    for (uint32_t i = 0; i < regionCount; i++) {
+        TextureUpdateRegion const& r = regions[i];
+        assert_invariant(r.width <= this->width && r.height <= this->height);
+        copyRegions.push_back({
+            .bufferOffset = r.bufferOffset,
+            .bufferRowLength = {},
+            .bufferImageHeight = {},
+            .imageSubresource = {
+                .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                .mipLevel = r.level,
+                .baseArrayLayer = layered ? r.zoffset : 0,
+                .layerCount = layered ? r.depth : 1,
+            },
+            .imageOffset = { int32_t(r.xoffset), int32_t(r.yoffset),
+                    layered ? 0 : int32_t(r.zoffset) },
+            .imageExtent = { r.width, r.height, layered ? 1 : r.depth },
+        });
+        minMip = std::min(minMip, r.level);
+        maxMip = std::max(maxMip, r.level);
+        if (layered) {
+            minLayer = std::min(minLayer, r.zoffset);
+            maxLayer = std::max(maxLayer, r.zoffset + r.depth - 1);
+        }
+    }
+
+    // A single pair of transitions covering the union of the touched subresources.
+    VkImageSubresourceRange const transitionRange = {
+        .aspectMask = getImageAspect(),
+        .baseMipLevel = minMip,
+        .levelCount = maxMip - minMip + 1,
+        .baseArrayLayer = layered ? minLayer : 0,
+        .layerCount = layered ? maxLayer - minLayer + 1 : 1,
+    };
+
+    VulkanLayout const newLayout = VulkanLayout::TRANSFER_DST;
+    VulkanLayout nextLayout = getLayout(transitionRange.baseArrayLayer, minMip);
+    if (nextLayout == VulkanLayout::UNDEFINED) {
+        nextLayout = getDefaultLayout();
+    }
+
+    transitionLayout(&commands, transitionRange, newLayout);
+
+    vkCmdCopyBufferToImage(cmdbuf, stage->buffer, state->mTextureImage,
+            imgutil::getVkLayout(newLayout), regionCount, copyRegions.data());
+
+    transitionLayout(&commands, transitionRange, nextLayout);
+}
+
 void VulkanTexture::updateImageWithBlit(const PixelBufferDescriptor& hostData, uint32_t width,
         uint32_t height, uint32_t depth, uint32_t miplevel) {
     auto* const state = getSharedState();
@@ -119,6 +119,12 @@ struct VulkanTexture : public HwTexture, VulkanResource {
     void updateImage(const PixelBufferDescriptor& data, uint32_t width, uint32_t height,
             uint32_t depth, uint32_t xoffset, uint32_t yoffset, uint32_t zoffset, uint32_t miplevel);
 
+    // Uploads several subregions (possibly across mips and layers) in one shot: one staging
+    // buffer, one vkCmdCopyBufferToImage, and one pair of layout transitions covering the
+    // union of the touched subresources.
+    void updateImageBatch(TextureUpdateRegion const* regions, uint32_t regionCount,
+            const PixelBufferDescriptor& data);
+
     // Returns the primary image view, which is used for shader sampling.
     VkImageView getPrimaryImageView() {
         VulkanTextureState* state = getSharedState();
@@ -17,11 +17,13 @@
 #include "VulkanDescriptorSetManager.h"
 
 #include <vulkan/VulkanHandles.h>
+#include <vulkan/VulkanSamplerCache.h>
 #include <vulkan/VulkanUtility.h>
 #include <vulkan/VulkanConstants.h>
 #include <vulkan/VulkanImageUtility.h>
 #include <vulkan/VulkanResources.h>
 #include <utils/FixedCapacityVector.h>
+#include <utils/Hash.h>
 #include <utils/Panic.h>
 
 #include <math.h>
@@ -38,12 +40,6 @@ namespace {
 using BitmaskGroup = VulkanDescriptorSetLayout::Bitmask;
 using DescriptorCount = VulkanDescriptorSetLayout::Count;
 using DescriptorSetLayoutArray = VulkanDescriptorSetManager::DescriptorSetLayoutArray;
-using BitmaskGroupHashFn = utils::hash::MurmurHashFn<BitmaskGroup>;
-struct BitmaskGroupEqual {
-    bool operator()(BitmaskGroup const& k1, BitmaskGroup const& k2) const {
-        return k1 == k2;
-    }
-};
 
 // We create a pool for each layout as defined by the number of descriptors of each type. For
 // example, a layout of
@@ -200,6 +196,19 @@ struct Equal {
     }
 };
 
+// Key for the VkDescriptorSetLayout cache. Two backend layouts map to the same VkDescriptorSetLayout
+// only if both their bitmasks and their immutable sampler parameters match. Hashed and compared as
+// raw bytes, so it must be fully zero-initialized before filling in the set bits.
+struct LayoutKey {
+    BitmaskGroup bitmask;                                                      // 32 bytes
+    uint32_t immutableSamplerMask;                                             //  4 bytes
+    SamplerParams immutableSamplers[VulkanDescriptorSetLayout::MAX_BINDINGS];  // 100 bytes
+};
+static_assert(sizeof(LayoutKey) == 136);
+
+using LayoutKeyHashFn = utils::hash::MurmurHashFn<LayoutKey>;
+using LayoutKeyEqual = Equal<LayoutKey>;
+
 template<typename Bitmask>
 uint32_t createBindings(VkDescriptorSetLayoutBinding* toBind, uint32_t count, VkDescriptorType type,
         Bitmask const& mask) {
@@ -233,10 +242,13 @@ uint32_t createBindings(VkDescriptorSetLayoutBinding* toBind, uint32_t count, Vk
     return count;
 }
 
-inline VkDescriptorSetLayout createLayout(VkDevice device, BitmaskGroup const& bitmaskGroup) {
-    // Note that the following *needs* to be static so that VkDescriptorSetLayoutCreateInfo will not
-    // refer to stack memory.
+inline VkDescriptorSetLayout createLayout(VkDevice device, VulkanSamplerCache* samplerCache,
+        BitmaskGroup const& bitmaskGroup,
+        VulkanDescriptorSetLayout::ImmutableSamplers const& immutables) {
+    // The following arrays live on the stack; vkCreateDescriptorSetLayout consumes them before
+    // returning.
     VkDescriptorSetLayoutBinding toBind[VulkanDescriptorSetLayout::MAX_BINDINGS];
+    VkSampler samplerHandles[VulkanDescriptorSetLayout::MAX_BINDINGS];
     uint32_t count = 0;
 
     count = createBindings(toBind, count, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
@@ -247,6 +259,21 @@ inline VkDescriptorSetLayout createLayout(VkDevice device, BitmaskGroup const& b
     count = createBindings(toBind, count, VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT,
             bitmaskGroup.inputAttachment);
 
+    // Bake immutable samplers into the sampler bindings that declared fixed parameters. This lets
+    // the driver specialize the layout, and makes the sampler member of subsequent descriptor
+    // writes on these bindings irrelevant.
+    if (immutables.mask.any()) {
+        for (uint32_t i = 0; i < count; ++i) {
+            VkDescriptorSetLayoutBinding& bindInfo = toBind[i];
+            if (bindInfo.descriptorType == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER &&
+                    immutables.mask.test(bindInfo.binding)) {
+                samplerHandles[bindInfo.binding] =
+                        samplerCache->getSampler(immutables.params[bindInfo.binding]);
+                bindInfo.pImmutableSamplers = &samplerHandles[bindInfo.binding];
+            }
+        }
+    }
+
     assert_invariant(count != 0 && "Need at least one binding for descriptor set layout.");
     VkDescriptorSetLayoutCreateInfo dlinfo = {
             .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
@@ -322,16 +349,23 @@ private:
 
 class VulkanDescriptorSetManager::DescriptorSetLayoutManager {
 public:
-    DescriptorSetLayoutManager(VkDevice device)
-        : mDevice(device) {}
+    DescriptorSetLayoutManager(VkDevice device, VulkanSamplerCache* samplerCache)
+        : mDevice(device),
+          mSamplerCache(samplerCache) {}
 
     VkDescriptorSetLayout getVkLayout(VulkanDescriptorSetLayout* layout) {
-        auto const& bitmasks = layout->bitmask;
-        if (auto itr = mVkLayouts.find(bitmasks); itr != mVkLayouts.end()) {
+        LayoutKey key = {};
+        key.bitmask = layout->bitmask;
+        key.immutableSamplerMask = layout->immutableSamplers.mask.getValue();
+        layout->immutableSamplers.mask.forEachSetBit([&](size_t index) {
+            key.immutableSamplers[index] = layout->immutableSamplers.params[index];
+        });
+        if (auto itr = mVkLayouts.find(key); itr != mVkLayouts.end()) {
             return itr->second;
         }
-        auto vklayout = createLayout(mDevice, layout->bitmask);
-        mVkLayouts[layout->bitmask] = vklayout;
+        auto vklayout = createLayout(mDevice, mSamplerCache, layout->bitmask,
+                layout->immutableSamplers);
+        mVkLayouts[key] = vklayout;
         return vklayout;
     }
 
@@ -343,15 +377,16 @@ public:
 
 private:
     VkDevice mDevice;
-    tsl::robin_map<BitmaskGroup, VkDescriptorSetLayout, BitmaskGroupHashFn, BitmaskGroupEqual>
+    VulkanSamplerCache* mSamplerCache;
+    tsl::robin_map<LayoutKey, VkDescriptorSetLayout, LayoutKeyHashFn, LayoutKeyEqual>
             mVkLayouts;
 };
 
 VulkanDescriptorSetManager::VulkanDescriptorSetManager(VkDevice device,
-        VulkanResourceAllocator* resourceAllocator)
+        VulkanResourceAllocator* resourceAllocator, VulkanSamplerCache* samplerCache)
     : mDevice(device),
       mResourceAllocator(resourceAllocator),
-      mLayoutManager(std::make_unique<DescriptorSetLayoutManager>(device)),
+      mLayoutManager(std::make_unique<DescriptorSetLayoutManager>(device, samplerCache)),
       mDescriptorPool(std::make_unique<DescriptorInfinitePool>(device)) {}
 
 VulkanDescriptorSetManager::~VulkanDescriptorSetManager() = default;
@@ -425,6 +460,29 @@ void VulkanDescriptorSetManager::updateBuffer(VulkanDescriptorSet* set, uint8_t
     if (set->dynamicUboMask.test(binding)) {
         type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
     }
+
+    // Skip the driver call if this binding already holds the exact same content. This commonly
+    // happens when a material instance is committed every frame without its bindings changing.
+    // Note that a buffer *data* update does not change the VkBuffer handle and therefore does not
+    // require a descriptor rewrite; a buffer reallocation does change the handle and is caught by
+    // the hash.
+    uint32_t const contentWords[] = {
+        (uint32_t) ((uint64_t) info.buffer),
+        (uint32_t) (((uint64_t) info.buffer) >> 32),
+        (uint32_t) info.offset,
+        (uint32_t) (info.offset >> 32),
+        (uint32_t) info.range,
+        (uint32_t) (info.range >> 32),
+        (uint32_t) type,
+    };
+    uint32_t contentHash = utils::hash::murmur3(contentWords,
+            sizeof(contentWords) / sizeof(uint32_t), 0);
+    contentHash = contentHash ? contentHash : 1;
+    if (set->isWriteRedundant(binding, contentHash)) {
+        set->acquire(bufferObject);
+        return;
+    }
+
     VkWriteDescriptorSet const descriptorWrite = {
         .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
         .pNext = nullptr,
@@ -456,6 +514,25 @@ void VulkanDescriptorSetManager::updateSampler(VulkanDescriptorSet* set, uint8_t
         info.imageView = texture->getViewForType(range, expectedType);
     }
     info.imageLayout = imgutil::getVkLayout(texture->getDefaultLayout());
+
+    // Skip the driver call if this binding already holds the exact same content. The view handle
+    // is what changes when the texture is reallocated or re-mipped; handle values referenced here
+    // cannot be recycled while the set is alive because the set keeps its textures acquired.
+    uint32_t const contentWords[] = {
+        (uint32_t) ((uint64_t) info.sampler),
+        (uint32_t) (((uint64_t) info.sampler) >> 32),
+        (uint32_t) ((uint64_t) info.imageView),
+        (uint32_t) (((uint64_t) info.imageView) >> 32),
+        (uint32_t) info.imageLayout,
+    };
+    uint32_t contentHash = utils::hash::murmur3(contentWords,
+            sizeof(contentWords) / sizeof(uint32_t), 0);
+    contentHash = contentHash ? contentHash : 1;
+    if (set->isWriteRedundant(binding, contentHash)) {
+        set->acquire(texture);
+        return;
+    }
+
     VkWriteDescriptorSet const descriptorWrite = {
         .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
         .pNext = nullptr,
@@ -481,6 +558,7 @@ void VulkanDescriptorSetManager::createSet(Handle<HwDescriptorSet> handle,
     auto const vklayout = layout->getVkLayout();
     mResourceAllocator->construct<VulkanDescriptorSet>(handle, mResourceAllocator, vkSet,
             layout->bitmask.dynamicUbo, layout->count.dynamicUbo,
+            layout->immutableSamplers.mask,
             [vkSet, count, vklayout, this](VulkanDescriptorSet* set) {
                 eraseSetFromHistory(set);
                 mDescriptorPool->recycle(count, vklayout, vkSet);
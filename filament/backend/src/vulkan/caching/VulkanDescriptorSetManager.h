@@ -34,6 +34,8 @@
 
 namespace filament::backend {
 
+class VulkanSamplerCache;
+
 // [GDSR]: Great-Descriptor-Set-Refactor: As of 03/20/24, the Filament frontend is planning to
 // introduce descriptor set. This PR will arrive before that change is complete. As such, some of
 // the methods introduced here will be obsolete, and certain logic will be generalized.
@@ -46,7 +48,8 @@ public:
 
     using DescriptorSetLayoutArray = VulkanDescriptorSetLayout::DescriptorSetLayoutArray;
 
-    VulkanDescriptorSetManager(VkDevice device, VulkanResourceAllocator* resourceAllocator);
+    VulkanDescriptorSetManager(VkDevice device, VulkanResourceAllocator* resourceAllocator,
+            VulkanSamplerCache* samplerCache);
     ~VulkanDescriptorSetManager();
 
     void terminate() noexcept;
@@ -199,6 +199,9 @@ ExtensionSet getDeviceExtensions(VkPhysicalDevice device) {
             VK_KHR_MAINTENANCE2_EXTENSION_NAME,
             VK_KHR_MAINTENANCE3_EXTENSION_NAME,
             VK_KHR_MULTIVIEW_EXTENSION_NAME,
+            VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME,
+            VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME,
+            VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME,
     };
     ExtensionSet exts;
     // Identify supported physical device extensions
@@ -368,6 +371,26 @@ VkDevice createLogicalDevice(VkPhysicalDevice physicalDevice,
         pNext = &multiview;
     }
 
+    VkPhysicalDeviceTimelineSemaphoreFeaturesKHR timelineSemaphore = {
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR,
+            .pNext = nullptr,
+            .timelineSemaphore = VK_TRUE,
+    };
+    if (setContains(deviceExtensions, VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME)) {
+        timelineSemaphore.pNext = pNext;
+        pNext = &timelineSemaphore;
+    }
+
+    VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT graphicsPipelineLibrary = {
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT,
+            .pNext = nullptr,
+            .graphicsPipelineLibrary = VK_TRUE,
+    };
+    if (setContains(deviceExtensions, VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME)) {
+        graphicsPipelineLibrary.pNext = pNext;
+        pNext = &graphicsPipelineLibrary;
+    }
+
     VkPhysicalDeviceProtectedMemoryFeatures protectedMemory = {
         .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROTECTED_MEMORY_FEATURES,
     };
@@ -799,6 +822,10 @@ Driver* VulkanPlatform::createDriver(void* sharedContext,
     context.mDebugUtilsSupported = setContains(instExts, VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
     context.mDebugMarkersSupported = setContains(deviceExts, VK_EXT_DEBUG_MARKER_EXTENSION_NAME);
     context.mMultiviewEnabled = setContains(deviceExts, VK_KHR_MULTIVIEW_EXTENSION_NAME);
+    context.mTimelineSemaphoresSupported
+            = setContains(deviceExts, VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME);
+    context.mGraphicsPipelineLibrarySupported
+            = setContains(deviceExts, VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME);
 
     // Check the availability of lazily allocated memory
     {
@@ -814,6 +841,22 @@ Driver* VulkanPlatform::createDriver(void* sharedContext,
         }
     }
 
+    // Check for host-visible device-local memory (UMA, or desktop GPUs with resizable BAR),
+    // which allows small per-frame buffer updates to bypass the staging copy.
+    {
+        context.mDeviceLocalHostVisibleSupported = false;
+        constexpr VkMemoryPropertyFlags kDirectFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+                | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+        const uint32_t typeCount = context.mMemoryProperties.memoryTypeCount;
+        for (uint32_t i = 0; i < typeCount; ++i) {
+            const VkMemoryType type = context.mMemoryProperties.memoryTypes[i];
+            if ((type.propertyFlags & kDirectFlags) == kDirectFlags) {
+                context.mDeviceLocalHostVisibleSupported = true;
+                break;
+            }
+        }
+    }
+
 #ifdef NDEBUG
     // If we are in release build, we should not have turned on debug extensions
     FILAMENT_CHECK_POSTCONDITION(!context.mDebugUtilsSupported && !context.mDebugMarkersSupported)
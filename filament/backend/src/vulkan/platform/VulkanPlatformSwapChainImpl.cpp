@@ -126,7 +126,8 @@ VulkanPlatformSurfaceSwapChain::VulkanPlatformSurfaceSwapChain(VulkanContext con
       mFallbackExtent(fallbackExtent),
       mUsesRGB((flags & backend::SWAP_CHAIN_CONFIG_SRGB_COLORSPACE) != 0),
       mHasStencil((flags & backend::SWAP_CHAIN_HAS_STENCIL_BUFFER) != 0),
-      mIsProtected((flags & backend::SWAP_CHAIN_CONFIG_PROTECTED_CONTENT) != 0) {
+      mIsProtected((flags & backend::SWAP_CHAIN_CONFIG_PROTECTED_CONTENT) != 0),
+      mFrameLatency(uint32_t(backend::getSwapChainConfigFrameLatency(flags))) {
     assert_invariant(surface);
     create();
 }
@@ -151,6 +152,13 @@ VkResult VulkanPlatformSurfaceSwapChain::create() {
     uint32_t const minImageCount = caps.minImageCount;
     uint32_t desiredImageCount = minImageCount + 1;
 
+    // When a frame-latency policy was requested, size the image pool accordingly: the lowest
+    // latency setting sticks to the bare minimum (less buffering, more chances to block), while
+    // deeper settings add images so presentation never starves the pipeline.
+    if (mFrameLatency) {
+        desiredImageCount = minImageCount + mFrameLatency - 1;
+    }
+
     // According to section 30.5 of VK 1.1, maxImageCount of zero means "that there is no limit on
     // the number of images, though there may be limits related to the total amount of memory used
     // by presentable images."
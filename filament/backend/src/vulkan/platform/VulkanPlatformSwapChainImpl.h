@@ -126,6 +126,7 @@ private:
     bool mUsesRGB = false;
     bool mHasStencil = false;
     bool mIsProtected = false;
+    uint32_t mFrameLatency = 0;
     bool mSuboptimal;
 };
 
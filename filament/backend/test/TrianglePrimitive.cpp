@@ -113,4 +113,8 @@ TrianglePrimitive::PrimitiveHandle TrianglePrimitive::getRenderPrimitive() const
     return mRenderPrimitive;
 }
 
+TrianglePrimitive::VertexInfoHandle TrianglePrimitive::getVertexBufferInfo() const noexcept {
+    return mVertexBufferInfo;
+}
+
 } // namespae test
@@ -51,6 +51,8 @@ public:
 
     PrimitiveHandle getRenderPrimitive() const noexcept;
 
+    VertexInfoHandle getVertexBufferInfo() const noexcept;
+
     void updateVertices(const filament::math::float2 vertices[3]) noexcept;
     void updateIndices(const index_type* indices) noexcept;
     void updateIndices(const index_type* indices, int count, int offset) noexcept;
@@ -113,3 +113,57 @@ TEST(HandlesTest, isValid) {
         EXPECT_FALSE(allocator.is_valid(handle));
     }
 }
+
+TEST(HandlesTest, stats) {
+    HandleAllocatorTest allocator("Test Handles", POOL_SIZE_BYTES, false);
+
+    HandleAllocatorStats stats = allocator.getStats();
+    EXPECT_EQ(stats.pools[0].handleSize, 32u);
+    EXPECT_EQ(stats.pools[1].handleSize, 96u);
+    EXPECT_EQ(stats.pools[2].handleSize, 136u);
+    EXPECT_EQ(stats.pools[0].used, 0u);
+    EXPECT_EQ(stats.overflowTotal, 0u);
+
+    Handle<MyHandle> handleA = allocator.allocate<Concrete>();
+    Handle<MyHandle> handleB = allocator.allocate<Concrete>();
+    stats = allocator.getStats();
+    EXPECT_EQ(stats.pools[0].used, 2u);
+    EXPECT_EQ(stats.pools[0].watermark, 2u);
+
+    allocator.deallocate(handleA);
+    allocator.deallocate(handleB);
+    stats = allocator.getStats();
+    EXPECT_EQ(stats.pools[0].used, 0u);
+    EXPECT_EQ(stats.pools[0].watermark, 2u);
+}
+
+TEST(HandlesTest, statsOverflow) {
+    HandleAllocatorTest allocator("Test Handles", POOL_SIZE_BYTES, false);
+
+    // Use up all the non-heap handles.
+    for (int i = 0; i < POOL_HANDLE_COUNT; i++) {
+        Handle<MyHandle> handle = allocator.allocate<Concrete>();
+    }
+
+    // This one is guaranteed to be a heap handle.
+    Handle<MyHandle> heapHandle = allocator.allocate<Concrete>();
+    EXPECT_TRUE(heapHandle.getId() & HANDLE_HEAP_FLAG);
+
+    HandleAllocatorStats stats = allocator.getStats();
+    EXPECT_EQ(stats.pools[0].used, stats.pools[0].capacity);
+    EXPECT_EQ(stats.overflowUsed, 1u);
+    EXPECT_EQ(stats.overflowTotal, 1u);
+
+    allocator.deallocate(heapHandle);
+    stats = allocator.getStats();
+    EXPECT_EQ(stats.overflowUsed, 0u);
+    EXPECT_EQ(stats.overflowTotal, 1u);
+}
+
+TEST(HandlesTest, poolWeights) {
+    HandleAllocatorTest allocator("Test Handles", POOL_SIZE_BYTES, false, { 2, 1, 1 });
+
+    HandleAllocatorStats const stats = allocator.getStats();
+    EXPECT_EQ(stats.pools[0].capacity, 2 * stats.pools[1].capacity);
+    EXPECT_EQ(stats.pools[1].capacity, stats.pools[2].capacity);
+}
@@ -21,10 +21,26 @@
 
 #include <filament/Box.h>
 #include <filament/Frustum.h>
+#include <filament/LightManager.h>
+#include <filament/Viewport.h>
+
+#include "Allocators.h"
 #include "Culler.h"
+#include "Froxelizer.h"
+#include "RenderPass.h"
+
+#include "components/TransformManager.h"
+
+#include "details/Engine.h"
+#include "details/Scene.h"
 
 #include <utils/Allocator.h>
+#include <utils/EntityManager.h>
+#include <utils/JobSystem.h>
 
+#include <math/mat4.h>
+
+#include <memory>
 #include <vector>
 #include <random>
 
@@ -103,3 +119,290 @@ BENCHMARK_F(FilamentCullingFixture, sphereCulling)(benchmark::State& state) {
         state.SetItemsProcessed(state.iterations() * BATCH_SIZE);
     }
 }
+
+// Same as FilamentCullingFixture but the primitive count is a benchmark argument, so we can
+// see how culling scales from a small scene to one that spills out of the caches.
+class FilamentCullingScaleFixture : public benchmark::Fixture {
+protected:
+    Frustum frustum{};
+    std::vector<float3> boxesCenter;
+    std::vector<float3> boxesExtent;
+    std::vector<float4> spheres;
+    Culler::result_type* UTILS_RESTRICT visibles = nullptr;
+
+public:
+    void SetUp(benchmark::State& state) override {
+        std::default_random_engine gen; // NOLINT
+        std::uniform_real_distribution<float> rand(-100.0f, 100.0f);
+
+        const size_t batch = Culler::round(size_t(state.range(0)));
+        frustum = Frustum{ mat4f::perspective(45.0f, 1.0f, 0.1f, 100.0f) };
+
+        boxesCenter.resize(batch);
+        boxesExtent.resize(batch);
+        spheres.resize(batch);
+        for (size_t i = 0; i < batch; i++) {
+            float4& sphere = spheres[i];
+            float z = std::fabs(rand(gen));
+            sphere.z = -z;
+            sphere.x = rand(gen, std::uniform_real_distribution<float>::param_type{ -z, z });
+            sphere.y = rand(gen, std::uniform_real_distribution<float>::param_type{ -z, z });
+            sphere.w = rand(gen, std::uniform_real_distribution<float>::param_type{ 0.11f, 25.0f });
+
+            boxesCenter[i] = sphere.xyz;
+            boxesExtent[i] = {
+                    rand(gen, std::uniform_real_distribution<float>::param_type{ 0.11f, 25.0f }),
+                    rand(gen, std::uniform_real_distribution<float>::param_type{ 0.11f, 25.0f }),
+                    rand(gen, std::uniform_real_distribution<float>::param_type{ 0.11f, 25.0f })
+            };
+        }
+
+        visibles = (Culler::result_type*)utils::aligned_alloc(batch * sizeof(*visibles), 32);
+    }
+
+    void TearDown(benchmark::State&) override {
+        utils::aligned_free(visibles);
+        visibles = nullptr;
+    }
+};
+
+BENCHMARK_DEFINE_F(FilamentCullingScaleFixture, boxCulling)(benchmark::State& state) {
+    const size_t batch = boxesCenter.size();
+    {
+        PerformanceCounters pc(state);
+        for (auto _ : state) {
+            Culler::Test::intersects(visibles, frustum,
+                    boxesCenter.data(), boxesExtent.data(), batch);
+        }
+        benchmark::ClobberMemory();
+        pc.stop();
+        state.SetItemsProcessed(state.iterations() * batch);
+    }
+}
+
+BENCHMARK_DEFINE_F(FilamentCullingScaleFixture, sphereCulling)(benchmark::State& state) {
+    const size_t batch = spheres.size();
+    {
+        PerformanceCounters pc(state);
+        for (auto _ : state) {
+            Culler::Test::intersects(visibles, frustum, spheres.data(), batch);
+        }
+        benchmark::ClobberMemory();
+        pc.stop();
+        state.SetItemsProcessed(state.iterations() * batch);
+    }
+}
+
+BENCHMARK_REGISTER_F(FilamentCullingScaleFixture, boxCulling)
+        ->Arg(1000)->Arg(10000)->Arg(100000);
+BENCHMARK_REGISTER_F(FilamentCullingScaleFixture, sphereCulling)
+        ->Arg(1000)->Arg(10000)->Arg(100000);
+
+// Benchmarks RenderPass command sorting, which includes the parallel sort path used for
+// large command streams. The synthetic commands use random keys, which is close to the
+// worst case for std::sort.
+class FilamentCommandSortFixture : public benchmark::Fixture {
+protected:
+    std::vector<RenderPass::Command> pristine;
+    std::vector<RenderPass::Command> commands;
+    utils::JobSystem js;
+
+public:
+    FilamentCommandSortFixture() {
+        js.adopt();
+    }
+
+    void SetUp(benchmark::State& state) override {
+        std::default_random_engine gen; // NOLINT
+        std::uniform_int_distribution<uint64_t> rand;
+        const size_t count = size_t(state.range(0));
+        pristine.resize(count);
+        for (auto& command : pristine) {
+            // mask the upper bits so no key collides with the SENTINEL value that
+            // sortCommands uses to trim the command stream
+            command.key = rand(gen) & 0x00FFFFFFFFFFFFFFull;
+        }
+        commands.resize(count);
+    }
+};
+
+BENCHMARK_DEFINE_F(FilamentCommandSortFixture, sortCommands)(benchmark::State& state) {
+    const size_t count = pristine.size();
+    {
+        PerformanceCounters pc(state);
+        for (auto _ : state) {
+            state.PauseTiming();
+            commands = pristine;
+            state.ResumeTiming();
+            RenderPass::Test::sortCommands(js, commands.data(), commands.data() + count);
+        }
+        benchmark::ClobberMemory();
+        pc.stop();
+        state.SetItemsProcessed(state.iterations() * count);
+    }
+}
+
+BENCHMARK_REGISTER_F(FilamentCommandSortFixture, sortCommands)
+        ->Arg(1024)->Arg(16384)->Arg(131072);
+
+// Benchmarks world transform propagation through renderable hierarchies, both the flat
+// "many children" shape and the deep chains produced by e.g. skeleton-like assets.
+class FilamentTransformFixture : public benchmark::Fixture {
+protected:
+    filament::FTransformManager tcm;
+    std::vector<utils::Entity> entities;
+    TransformManager::Instance root;
+
+    void build(size_t count, bool deep) {
+        auto& em = utils::EntityManager::get();
+        entities.resize(count);
+        em.create(entities.size(), entities.data());
+        tcm.create(entities[0]);
+        root = tcm.getInstance(entities[0]);
+        TransformManager::Instance parent = root;
+        for (size_t i = 1; i < count; i++) {
+            tcm.create(entities[i], parent, mat4f{});
+            if (deep) {
+                parent = tcm.getInstance(entities[i]);
+            }
+        }
+    }
+
+public:
+    void TearDown(benchmark::State&) override {
+        auto& em = utils::EntityManager::get();
+        for (auto e : entities) {
+            tcm.destroy(e);
+        }
+        em.destroy(entities.size(), entities.data());
+        entities.clear();
+    }
+};
+
+BENCHMARK_DEFINE_F(FilamentTransformFixture, hierarchyUpdateWide)(benchmark::State& state) {
+    build(size_t(state.range(0)), false);
+    const mat4f transform = mat4f::translation(float3{ 1, 2, 3 });
+    {
+        PerformanceCounters pc(state);
+        for (auto _ : state) {
+            // setting the root transform recomputes the world transform of every descendant
+            tcm.setTransform(root, transform);
+        }
+        benchmark::ClobberMemory();
+        pc.stop();
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+}
+
+BENCHMARK_DEFINE_F(FilamentTransformFixture, hierarchyUpdateDeep)(benchmark::State& state) {
+    build(size_t(state.range(0)), true);
+    const mat4f transform = mat4f::translation(float3{ 1, 2, 3 });
+    {
+        PerformanceCounters pc(state);
+        for (auto _ : state) {
+            tcm.setTransform(root, transform);
+        }
+        benchmark::ClobberMemory();
+        pc.stop();
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+}
+
+BENCHMARK_DEFINE_F(FilamentTransformFixture, hierarchyTransactionCommit)(benchmark::State& state) {
+    const size_t count = size_t(state.range(0));
+    build(count, false);
+    const mat4f transform = mat4f::translation(float3{ 1, 2, 3 });
+    {
+        PerformanceCounters pc(state);
+        for (auto _ : state) {
+            tcm.openLocalTransformTransaction();
+            for (size_t i = 1; i < count; i++) {
+                tcm.setTransform(tcm.getInstance(entities[i]), transform);
+            }
+            tcm.commitLocalTransformTransaction();
+        }
+        benchmark::ClobberMemory();
+        pc.stop();
+        state.SetItemsProcessed(state.iterations() * count);
+    }
+}
+
+BENCHMARK_REGISTER_F(FilamentTransformFixture, hierarchyUpdateWide)
+        ->Arg(1000)->Arg(10000)->Arg(100000);
+BENCHMARK_REGISTER_F(FilamentTransformFixture, hierarchyUpdateDeep)
+        ->Arg(256)->Arg(1024)->Arg(4096);
+BENCHMARK_REGISTER_F(FilamentTransformFixture, hierarchyTransactionCommit)
+        ->Arg(1000)->Arg(10000);
+
+// Benchmarks froxelized light assignment against a real engine instance, with the light
+// count as the benchmark argument (the engine supports up to CONFIG_MAX_LIGHT_COUNT).
+class FilamentFroxelizerFixture : public benchmark::Fixture {
+protected:
+    FEngine* engine = nullptr;
+    std::unique_ptr<LinearAllocatorArena> arena;
+    std::unique_ptr<RootArenaScope> scope;
+    std::unique_ptr<Froxelizer> froxelizer;
+    FScene::LightSoa lights;
+    utils::Entity lightEntity;
+
+public:
+    void SetUp(benchmark::State& state) override {
+        engine = downcast(Engine::create());
+
+        arena = std::make_unique<LinearAllocatorArena>(
+                "benchmark: per-frame allocator", 3 * 1024 * 1024);
+        scope = std::make_unique<RootArenaScope>(*arena);
+
+        Viewport const vp(0, 0, 1280, 640);
+        mat4f const p = mat4f::perspective(90, 2.0f, 0.1, 100, mat4f::Fov::HORIZONTAL);
+
+        froxelizer = std::make_unique<Froxelizer>(*engine);
+        froxelizer->setOptions(5, 100);
+        froxelizer->prepare(engine->getDriverApi(), *scope, vp, p, 0.1, 100);
+
+        // a single point light component referenced by all the synthetic scene lights
+        lightEntity = engine->getEntityManager().create();
+        LightManager::Builder(LightManager::Type::POINT).build(*engine, lightEntity);
+        auto instance = engine->getLightManager().getInstance(lightEntity);
+
+        std::default_random_engine gen; // NOLINT
+        std::uniform_real_distribution<float> randXY(-20.0f, 20.0f);
+        std::uniform_real_distribution<float> randZ(-90.0f, -5.0f);
+        std::uniform_real_distribution<float> randRadius(0.5f, 10.0f);
+
+        lights.push_back({}, {}, {}, {}, {}, {}, {}, {});   // first one is always skipped
+        for (size_t i = 0, c = size_t(state.range(0)); i < c; i++) {
+            lights.push_back(
+                    float4{ randXY(gen), randXY(gen), randZ(gen), randRadius(gen) },
+                    {}, {}, {}, instance, 1, {}, {});
+        }
+    }
+
+    void TearDown(benchmark::State&) override {
+        lights.clear();
+        froxelizer->terminate(engine->getDriverApi());
+        froxelizer.reset();
+        scope.reset();
+        arena.reset();
+        engine->destroy(lightEntity);
+        engine->getEntityManager().destroy(lightEntity);
+        Engine* e = engine;
+        Engine::destroy(&e);
+        engine = nullptr;
+    }
+};
+
+BENCHMARK_DEFINE_F(FilamentFroxelizerFixture, froxelizeLights)(benchmark::State& state) {
+    {
+        PerformanceCounters pc(state);
+        for (auto _ : state) {
+            froxelizer->froxelizeLights(*engine, {}, lights);
+        }
+        benchmark::ClobberMemory();
+        pc.stop();
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+}
+
+BENCHMARK_REGISTER_F(FilamentFroxelizerFixture, froxelizeLights)
+        ->Arg(15)->Arg(63)->Arg(255);
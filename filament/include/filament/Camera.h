@@ -159,7 +159,8 @@ namespace filament {
  * Each eye also maintains its own projection matrix. These can be set with setCustomEyeProjection.
  * Care must be taken to correctly set the projectionForCulling matrix, as well as its corresponding
  * near and far values. The projectionForCulling matrix must define a frustum (in head space) that
- * bounds the frustums of both eyes. Alternatively, culling may be disabled with
+ * bounds the frustums of both eyes. computeCullingProjection derives such a matrix from the
+ * eye projections and eye model matrices. Alternatively, culling may be disabled with
  * View::setFrustumCullingEnabled.
  *
  * \see Frustum, View
@@ -309,6 +310,33 @@ public:
     void setCustomEyeProjection(math::mat4 const* UTILS_NONNULL projection, size_t count,
             math::mat4 const& projectionForCulling, double near, double far);
 
+    /** Computes a projection matrix suitable as the projectionForCulling parameter of
+     * setCustomEyeProjection.
+     *
+     * The returned matrix defines a frustum, in head space, that bounds the frusta of all
+     * eyes, so that a single culling pass -- and the froxelization and shadow setup that
+     * depend on it -- serves every eye. The frustum's apex is receded along +z just enough
+     * to cover the eyes' positions; this is exact for purely translated eyes and slightly
+     * conservative for canted ones. The far plane is pushed back accordingly, so simply pass
+     * the same \p near and \p far values to setCustomEyeProjection.
+     *
+     * All eye projections must be perspective and face forward (-z) in head space.
+     *
+     * @param eyeProjection array of per-eye projection matrices, as given to
+     *                      setCustomEyeProjection
+     * @param eyeModel      array of per-eye model matrices in head space, as given to
+     *                      setEyeModelMatrix
+     * @param count         number of eyes, i.e. the size of both arrays
+     * @param near          distance in world units from each eye to its near plane
+     * @param far           distance in world units from each eye to its far plane
+     * @return a projection matrix bounding all eye frusta, for use with
+     *         setCustomEyeProjection
+     * @see setCustomEyeProjection
+     * @see setEyeModelMatrix
+     */
+    static math::mat4 computeCullingProjection(math::mat4 const* UTILS_NONNULL eyeProjection,
+            math::mat4 const* UTILS_NONNULL eyeModel, size_t count, double near, double far);
+
     /** Sets an additional matrix that scales the projection matrix.
      *
      * This is useful to adjust the aspect ratio of the camera independent from its projection.
@@ -26,6 +26,7 @@
 #include <math/mathfwd.h>
 
 #include <stddef.h>
+#include <stdint.h>
 
 namespace filament {
 
@@ -118,6 +119,50 @@ public:
 
     DataSource getDataSource(const char* UTILS_NONNULL name) const noexcept;
 
+    /**
+     * Per-frame counters of a few hot subsystems, published once per frame by the renderer and
+     * readable from any thread. See getFrameTelemetry().
+     */
+    struct FrameTelemetry {
+        uint32_t frameId = 0;                 //!< id of the frame the counters below describe
+        uint32_t froxelRecordBytesUsed = 0;   //!< bytes of the froxel record buffer written
+        uint32_t froxelOverflowCount = 0;     //!< frames so far whose froxel records overflowed
+        uint32_t commandBufferPeakBytes = 0;  //!< peak command stream occupancy of the frame
+        uint32_t commandBufferSizeBytes = 0;  //!< capacity of the command stream buffer
+        uint32_t shadowPassCount = 0;         //!< shadow map passes rendered during the frame
+    };
+
+    /**
+     * Reads the most recently published frame telemetry.
+     *
+     * This is lock-free: the snapshot is protected by a sequence lock, so sampling from a
+     * telemetry thread never blocks rendering, and the per-frame publishing cost is a few
+     * memcpy. Always-on production sampling is the intended use.
+     *
+     * @param telemetry Receives the counters of the last rendered frame
+     * @return true if a frame has been published, false before the first frame completes
+     */
+    bool getFrameTelemetry(FrameTelemetry* UTILS_NONNULL telemetry) const noexcept;
+
+    /**
+     * Get the value of a property as sampled at the end of the last frame.
+     *
+     * Unlike getProperty(), these read a snapshot mirrored under the same sequence lock as the
+     * frame telemetry, so any thread may call them without synchronizing with the engine.
+     *
+     * @param name Name of the property to get the sampled value of
+     * @param v A pointer to a variable which will hold the result
+     * @return true if the property exists and a frame has been published
+     * @{
+     */
+    bool getSampledProperty(const char* UTILS_NONNULL name, bool* UTILS_NONNULL v) const noexcept;
+    bool getSampledProperty(const char* UTILS_NONNULL name, int* UTILS_NONNULL v) const noexcept;
+    bool getSampledProperty(const char* UTILS_NONNULL name, float* UTILS_NONNULL v) const noexcept;
+    bool getSampledProperty(const char* UTILS_NONNULL name, math::float2* UTILS_NONNULL v) const noexcept;
+    bool getSampledProperty(const char* UTILS_NONNULL name, math::float3* UTILS_NONNULL v) const noexcept;
+    bool getSampledProperty(const char* UTILS_NONNULL name, math::float4* UTILS_NONNULL v) const noexcept;
+    /** @}*/
+
     struct FrameHistory {
         using duration_ms = float;
         duration_ms target{};
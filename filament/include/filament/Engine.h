@@ -19,6 +19,7 @@
 
 #include <filament/FilamentAPI.h>
 
+#include <backend/CallbackHandler.h>
 #include <backend/DriverEnums.h>
 #include <backend/Platform.h>
 
@@ -54,6 +55,7 @@ class Skybox;
 class Stream;
 class SwapChain;
 class Texture;
+class TextureAtlas;
 class VertexBuffer;
 class View;
 class InstanceBuffer;
@@ -249,6 +251,17 @@ public:
          */
         uint32_t driverHandleArenaSizeMB = 0;
 
+        /**
+         * Relative weights of the handle arena's three size-class pools, ordered by increasing
+         * handle size.
+         *
+         * By default each pool holds the same number of handles. Workloads that exhaust one size
+         * class long before the others can skew the split accordingly; use
+         * DriverApi::getHandleAllocatorStats() to measure per-pool occupancy. A weight of 0 is
+         * treated as 1.
+         */
+        std::array<uint8_t, 3> driverHandleArenaPoolWeights = { 1, 1, 1 };
+
 
         /**
          * Minimum size in MiB of a low-level command buffer.
@@ -275,6 +288,26 @@ public:
          */
         uint32_t perFrameCommandsSizeMB = FILAMENT_PER_FRAME_COMMANDS_SIZE_IN_MB;
 
+        /**
+         * Wakeup batching window for the backend (driver) thread.
+         *
+         * By default (both values zero), every flush of the command stream wakes the
+         * backend thread. When both values are non-zero, non-critical flushes are
+         * coalesced: the backend thread wakes up once either driverThreadBatchSizeKiB
+         * worth of commands are queued, or driverThreadBatchWindowUs microseconds have
+         * elapsed since the first queued command buffer, whichever comes first.
+         *
+         * Frame presentation, fence waits and command-buffer-full situations always drain
+         * immediately, so enabling this reduces wakeups (and therefore power) at low load
+         * without adding frame latency.
+         */
+        uint32_t driverThreadBatchSizeKiB = 0;
+
+        /**
+         * See driverThreadBatchSizeKiB.
+         */
+        uint32_t driverThreadBatchWindowUs = 0;
+
         /**
          * Number of threads to use in Engine's JobSystem.
          *
@@ -288,6 +321,53 @@ public:
          */
         uint32_t jobSystemThreadCount = 0;
 
+        /**
+         * Set of cores the JobSystem's worker threads are allowed to run on, one bit per cpu id.
+         *
+         * On heterogeneous CPUs this can be used to keep Engine workloads on a chosen cluster
+         * (e.g. the "big" cores), and to keep workers away from cores reserved for the backend
+         * driver thread (see driverThreadAffinityMask). This is a hint; it is ignored on
+         * platforms without thread-affinity support.
+         *
+         * The default value is 0, which implies no restriction.
+         */
+        uint64_t jobSystemAffinityMask = 0;
+
+        /**
+         * Set of cores the backend driver thread is allowed to run on, one bit per cpu id.
+         *
+         * The driver thread competes with JobSystem workers for CPU time; reserving a core for
+         * it (and excluding that core from jobSystemAffinityMask) avoids having command stream
+         * execution preempted by parallel Engine workloads. This is a hint; it is ignored on
+         * platforms without thread-affinity support.
+         *
+         * The default value is 0, which implies no restriction.
+         */
+        uint64_t driverThreadAffinityMask = 0;
+
+        /**
+         * Number of threads of the Engine's background JobSystem.
+         *
+         * When this value is non-zero, the Engine creates a second, separate JobSystem intended
+         * for throughput work (asset decoding, texture transcoding) so that such jobs cannot
+         * strand latency-critical frame-preparation jobs behind them. It is available through
+         * Engine::getBackgroundJobSystem(); threads other than the one that created the Engine
+         * must adopt() it before waiting on its jobs.
+         *
+         * The default value is 0, which implies that no background pool is created and
+         * getBackgroundJobSystem() returns the main JobSystem.
+         */
+        uint32_t backgroundJobSystemThreadCount = 0;
+
+        /**
+         * Set of cores the background JobSystem's worker threads are allowed to run on, one bit
+         * per cpu id. Only meaningful when backgroundJobSystemThreadCount is non-zero. This is a
+         * hint; it is ignored on platforms without thread-affinity support.
+         *
+         * The default value is 0, which implies no restriction.
+         */
+        uint64_t backgroundJobSystemAffinityMask = 0;
+
         /**
          * When uploading vertex or index data, the Filament Metal backend copies data
          * into a shared staging area before transferring it to the GPU. This setting controls
@@ -306,6 +386,21 @@ public:
          */
         size_t metalUploadBufferSizeBytes = 512 * 1024;
 
+        /**
+         * When uploading texture or buffer data, the Filament Vulkan backend acquires a
+         * transient staging buffer from a pool and recycles it a few frames later, once the
+         * GPU has consumed it. This setting controls how many bytes of free staging memory
+         * the pool keeps alive between frames.
+         *
+         * The default value of 0 sizes the pool automatically: it retains free memory up to
+         * a decaying high-water mark of recent staging demand, so steady-state streaming
+         * workloads stop paying for device memory allocation. A non-zero value caps the
+         * retained free memory at that many bytes instead.
+         *
+         * Only respected by the Vulkan backend.
+         */
+        size_t vulkanStagingRetentionBytes = 0;
+
         /**
          * Set to `true` to forcibly disable parallel shader compilation in the backend.
          * Currently only honored by the GL and Metal backends.
@@ -335,7 +430,11 @@ public:
         uint8_t stereoscopicEyeCount = 2;
 
         /*
-         * @deprecated This value is no longer used.
+         * Byte budget, in MiB, of the transient render-target texture cache. When the cache
+         * exceeds this size at the end of a frame, entries are evicted until it fits; entries
+         * whose dimensions no longer match any recently requested size are evicted first, which
+         * keeps resolution steps under dynamic resolution from filling the cache with dead
+         * sizes. This is a soft limit: textures in use are never evicted.
          */
         uint32_t resourceAllocatorCacheSizeMB = 64;
 
@@ -352,6 +451,14 @@ public:
          */
         bool disableHandleUseAfterFreeCheck = false;
 
+        /*
+         * Enable the backend handle sanitizer. Freed handles are quarantined instead of being
+         * recycled immediately, so a use-after-free through a stale handle is reliably caught
+         * (the use-after-free check is forced on) instead of silently aliasing a newly created
+         * object. Intended for internal/dogfood builds; has no cost when left disabled.
+         */
+        bool enableHandleSanitizer = false;
+
         /*
          * Sets a preferred shader language for Filament to use.
          *
@@ -441,7 +548,13 @@ public:
 
         /**
          * @param sharedContext A platform-dependant context used as a shared context
-         *                      when creating filament's internal context.
+         *                      when creating filament's internal context. On OpenGL this
+         *                      is a share context: several Engines created against the
+         *                      same share context see each other's GPU objects, so
+         *                      immutable resources (textures, program binaries) occupy
+         *                      VRAM only once per device. To additionally share the
+         *                      compilation work itself across Engines, bind a common
+         *                      backend::FileBlobCache to each Engine's Platform.
          *
          * @return A reference to this Builder for chaining calls.
          */
@@ -734,6 +847,34 @@ public:
      */
     bool isAutomaticInstancingEnabled() const noexcept;
 
+    /**
+     * Sets an engine-wide budget for in-flight upload memory.
+     *
+     * Texture upload calls account the bytes of their pixel buffers from submission until
+     * the backend has consumed them into staging memory. While the total exceeds the
+     * budget, batched uploads submitted with Texture::setImages() are queued engine-side
+     * -- lowest priority value first -- instead of growing the backend's staging memory,
+     * and are submitted as the budget frees up (at the latest at the next beginFrame()).
+     *
+     * Streaming systems should poll isStagingBudgetExceeded() and throttle their decode
+     * jobs while it returns true; gltfio's texture providers do this automatically.
+     *
+     * @param budgetInBytes Budget in bytes, or 0 (the default) to disable budgeting.
+     */
+    void setStagingBudget(size_t budgetInBytes) noexcept;
+
+    /**
+     * @return Bytes of upload data submitted but not yet consumed by the backend.
+     * @see setStagingBudget
+     */
+    size_t getPendingUploadBytes() const noexcept;
+
+    /**
+     * @return true if a staging budget is set and currently exceeded.
+     * @see setStagingBudget
+     */
+    bool isStagingBudgetExceeded() const noexcept;
+
     /**
      * Creates a SwapChain from the given Operating System's native window handle.
      *
@@ -841,6 +982,7 @@ public:
     bool destroy(const SwapChain* UTILS_NULLABLE p);        //!< Destroys a SwapChain object.
     bool destroy(const Stream* UTILS_NULLABLE p);           //!< Destroys a Stream object.
     bool destroy(const Texture* UTILS_NULLABLE p);          //!< Destroys a Texture object.
+    bool destroy(const TextureAtlas* UTILS_NULLABLE p);     //!< Destroys a TextureAtlas object.
     bool destroy(const RenderTarget* UTILS_NULLABLE p);     //!< Destroys a RenderTarget object.
     bool destroy(const View* UTILS_NULLABLE p);             //!< Destroys a View object.
     bool destroy(const InstanceBuffer* UTILS_NULLABLE p);   //!< Destroys an InstanceBuffer object.
@@ -885,6 +1027,8 @@ public:
     bool isValid(const Stream* UTILS_NULLABLE p) const;
     /** Tells whether a Texture object is valid */
     bool isValid(const Texture* UTILS_NULLABLE p) const;
+    /** Tells whether a TextureAtlas object is valid */
+    bool isValid(const TextureAtlas* UTILS_NULLABLE p) const;
     /** Tells whether a RenderTarget object is valid */
     bool isValid(const RenderTarget* UTILS_NULLABLE p) const;
     /** Tells whether a View object is valid */
@@ -936,6 +1080,21 @@ public:
       */
     void flush();
 
+    /**
+     * Kicks the hardware thread and schedules a callback once all commands issued to this
+     * point -- resource creations, data uploads, etc. -- have been executed by the backend.
+     *
+     * <p>This is the non-blocking alternative to flushAndWait() for loading scenarios:
+     * objects returned by the various builders are immediately usable on the calling thread,
+     * and this callback tells the application when the backend has actually finished creating
+     * them, without ever stalling the calling thread.</p>
+     *
+     * @param handler  Handler to dispatch the callback, or nullptr for the default handler.
+     * @param callback Callback called once all commands to this point have executed.
+     */
+    void flushAndScheduleCallback(backend::CallbackHandler* UTILS_NULLABLE handler,
+            utils::Invocable<void()>&& callback);
+
     /**
      * Get paused state of rendering thread.
      *
@@ -970,6 +1129,55 @@ public:
      */
     void pumpMessageQueues();
 
+    /**
+     * Categories of GPU memory tracked by the Engine.
+     *
+     * The Engine keeps an estimate of the GPU memory held by each category, computed from the
+     * resource dimensions and formats the same way the render-pass texture cache estimates its
+     * own footprint. The driver may allocate more (alignment, hidden meta-data, compression),
+     * so treat these numbers as a lower bound.
+     */
+    enum class MemoryCategory : uint8_t {
+        TEXTURE,        //!< textures created through Texture::Builder
+        RENDER_TARGET,  //!< transient render-pass textures (shadow maps, post-processing)
+        VERTEX_DATA,    //!< vertex and index buffers
+        BUFFER_OBJECT,  //!< buffer objects created through BufferObject::Builder
+        COUNT           //!< number of categories, not a valid argument
+    };
+
+    //! GPU memory usage of a category. @see getMemoryUsage()
+    struct MemoryUsage {
+        uint64_t current = 0;   //!< bytes currently allocated
+        uint64_t peak = 0;      //!< high-water mark, in bytes
+    };
+
+    /**
+     * Returns the estimated GPU memory held by a category of resources.
+     * @param category category to query, must not be MemoryCategory::COUNT
+     */
+    MemoryUsage getMemoryUsage(MemoryCategory category) const noexcept;
+
+    //! Returns the estimated GPU memory held by all tracked categories together.
+    MemoryUsage getTotalMemoryUsage() const noexcept;
+
+    /**
+     * Callback invoked when an allocation is about to push the total tracked GPU memory above
+     * the configured budget. @see setMemoryBudget()
+     */
+    using MemoryBudgetCallback = void(*)(void* user, uint64_t totalBytes, uint64_t budgetBytes);
+
+    /**
+     * Sets a soft budget on tracked GPU memory.
+     *
+     * \p callback fires at most once per budget crossing, on the thread performing the
+     * allocation, just before the allocation is accounted; it re-arms once usage drops below
+     * the budget again. The allocation itself always proceeds -- the callback is a signal to
+     * release resources (or lower quality settings), not a hard limit.
+     *
+     * A \p budgetBytes of 0 disables the callback.
+     */
+    void setMemoryBudget(uint64_t budgetBytes, MemoryBudgetCallback callback, void* user) noexcept;
+
     /**
      * Switch the command queue to unprotected mode. Protected mode can be activated via
      * Renderer::beginFrame() using a protected SwapChain.
@@ -1045,6 +1253,17 @@ public:
       */
     utils::JobSystem& getJobSystem() noexcept;
 
+    /**
+      * Retrieves the JobSystem intended for throughput work such as asset decoding and texture
+      * transcoding, so these jobs don't compete with latency-critical frame-preparation jobs.
+      *
+      * A separate pool only exists when Config::backgroundJobSystemThreadCount is non-zero;
+      * otherwise this returns the same JobSystem as getJobSystem().
+      *
+      * @return background JobSystem used by filament
+      */
+    utils::JobSystem& getBackgroundJobSystem() noexcept;
+
 #if defined(__EMSCRIPTEN__)
     /**
       * WebGL only: Tells the driver to reset any internal state tracking if necessary.
@@ -51,6 +51,16 @@ public:
         DONT_FLUSH      //!< The command stream is not flushed
     };
 
+    /** WaitPolicy controls how wait() blocks the calling thread. */
+    enum class WaitPolicy : uint8_t {
+        //! Park the thread immediately. Lowest CPU usage, default.
+        PARK,
+        //! Spin briefly polling the fence before parking. Burns a few tens of microseconds
+        //! of CPU when the fence isn't signaled yet, but avoids the scheduler wakeup jitter
+        //! of a parked thread. Intended for latency-critical waits such as frame pacing.
+        SPIN_THEN_PARK
+    };
+
     /**
      * Client-side wait on the Fence.
      *
@@ -66,6 +76,26 @@ public:
      */
     FenceStatus wait(Mode mode = Mode::FLUSH, uint64_t timeout = FENCE_WAIT_FOR_EVER);
 
+    /**
+     * Sets the policy used by subsequent wait() calls on this Fence.
+     *
+     * @param policy PARK (default) or SPIN_THEN_PARK.
+     * @see #WaitPolicy
+     */
+    void setWaitPolicy(WaitPolicy policy) noexcept;
+
+    /**
+     * Queries the current state of the Fence without blocking.
+     *
+     * This is cheap enough to call from a loop: it performs a single atomic read and
+     * acquires no lock.
+     *
+     * @return  FenceStatus::CONDITION_SATISFIED if the Fence has signaled,
+     *          FenceStatus::TIMEOUT_EXPIRED if it hasn't yet, or
+     *          FenceStatus::ERROR if the Fence was destroyed.
+     */
+    FenceStatus getStatus() noexcept;
+
     /**
      * Client-side wait on a Fence and destroy the Fence.
      *
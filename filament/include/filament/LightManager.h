@@ -333,8 +333,10 @@ public:
         /**
          * Number of ray-marching steps for screen-space contact shadows (8 by default).
          *
-         * CAUTION: this parameter is ignored for all lights except the directional/sun light,
-         *          all other lights use the same value set for the directional/sun light.
+         * CAUTION: this parameter is global: all lights use the value set for the
+         *          directional/sun light; if the directional light doesn't use contact
+         *          shadows (or there is none), the largest value among the punctual
+         *          lights that do is used instead.
          *
          */
         uint8_t stepCount = 8;
@@ -343,8 +345,10 @@ public:
          * Maximum shadow-occluder distance for screen-space contact shadows (world units).
          * (30 cm by default)
          *
-         * CAUTION: this parameter is ignored for all lights except the directional/sun light,
-         *          all other lights use the same value set for the directional/sun light.
+         * CAUTION: this parameter is global: all lights use the value set for the
+         *          directional/sun light; if the directional light doesn't use contact
+         *          shadows (or there is none), the largest value among the punctual
+         *          lights that do is used instead.
          *
          */
         float maxShadowDistance = 0.3f;
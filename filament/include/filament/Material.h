@@ -43,8 +43,10 @@ namespace utils {
 
 namespace filament {
 
+class RenderTarget;
 class Texture;
 class TextureSampler;
+class VertexBuffer;
 
 class FEngine;
 class FMaterial;
@@ -112,6 +114,18 @@ public:
          */
         Builder& package(const void* UTILS_NONNULL payload, size_t size);
 
+        /**
+         * Specifies the material data without copying it. Unlike package(), the data is
+         * referenced directly, so it must stay valid and unchanged for the lifetime of the
+         * Material, not just until build() is called. This is intended for packages backed
+         * by a read-only file mapping, and avoids doubling the package's footprint in
+         * memory while the Material is alive.
+         *
+         * @param payload Pointer to the material data, must outlive the Material.
+         * @param size Size of the material data pointed to by "payload" in bytes.
+         */
+        Builder& sharedPackage(const void* UTILS_NONNULL payload, size_t size);
+
         template<typename T>
         using is_supported_constant_parameter_t = typename std::enable_if<
                 std::is_same<int32_t, T>::value ||
@@ -228,6 +242,30 @@ public:
                 std::forward<utils::Invocable<void(Material* UTILS_NONNULL)>>(callback));
     }
 
+    /**
+     * Pre-warms the backend's pipeline state for this material.
+     *
+     * While Material::compile() ensures shader programs are compiled ahead of time, backends that
+     * build monolithic pipeline objects (Vulkan, Metal) additionally need to know the vertex
+     * layout and the render target formats a material will be drawn with; when they don't, the
+     * pipeline object is created lazily on first draw, which can cause a visible hitch. This
+     * method declares such a combination up front so the corresponding pipelines can be created
+     * at load time instead.
+     *
+     * This can be called several times with different vertex buffers and render targets; each
+     * call pre-warms one combination for every variant of this material. Like compile(), it is
+     * recommended to call Engine::flush() afterwards so the backend picks up the work as soon
+     * as possible. On backends without monolithic pipeline objects (OpenGL) this is a no-op.
+     *
+     * @param vertexBuffer  A VertexBuffer whose vertex layout matches the geometry this material
+     *                      will be drawn with. Only the layout is used; the buffer contents are
+     *                      irrelevant.
+     * @param renderTarget  The RenderTarget this material will be drawn into, or nullptr for the
+     *                      SwapChain's default render target.
+     */
+    void precachePipelines(VertexBuffer const* UTILS_NONNULL vertexBuffer,
+            RenderTarget const* UTILS_NULLABLE renderTarget = nullptr) noexcept;
+
     /**
      * Creates a new instance of this material. Material instances should be freed using
      * Engine::destroy(const MaterialInstance*).
@@ -337,6 +375,18 @@ public:
     //! Indicates whether an existing parameter is a sampler or not.
     bool isSampler(const char* UTILS_NONNULL name) const noexcept;
 
+    /**
+     * Resolves a uniform parameter name to a handle that can be used with
+     * MaterialInstance::setParameter() and MaterialInstance::setParameters() on any
+     * instance of this material, skipping the per-call name lookup.
+     *
+     * @param name The name of the material parameter
+     * @return A handle to the parameter, invalid if the name doesn't refer to a
+     *         non-sampler parameter of this material (check with ParameterHandle::isValid()).
+     */
+    MaterialInstance::ParameterHandle getParameterHandle(
+            const char* UTILS_NONNULL name) const noexcept;
+
     /**
      * Sets the value of the given parameter on this material's default instance.
      *
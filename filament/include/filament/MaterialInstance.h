@@ -36,6 +36,9 @@
 
 namespace filament {
 
+class FMaterial;
+class FMaterialInstance;
+
 class Material;
 class Texture;
 class TextureSampler;
@@ -160,6 +163,86 @@ public:
     }
 
 
+    /**
+     * Types supported by the handle-based setParameter() fast path. These are the types that
+     * can be written to the uniform buffer without a layout conversion (this excludes bool
+     * vectors and mat3f).
+     */
+    template<typename T>
+    using is_handle_supported_parameter_t = typename std::enable_if<
+            std::is_same<float, T>::value ||
+            std::is_same<int32_t, T>::value ||
+            std::is_same<uint32_t, T>::value ||
+            std::is_same<math::int2, T>::value ||
+            std::is_same<math::int3, T>::value ||
+            std::is_same<math::int4, T>::value ||
+            std::is_same<math::uint2, T>::value ||
+            std::is_same<math::uint3, T>::value ||
+            std::is_same<math::uint4, T>::value ||
+            std::is_same<math::float2, T>::value ||
+            std::is_same<math::float3, T>::value ||
+            std::is_same<math::float4, T>::value ||
+            std::is_same<math::mat4f, T>::value
+    >::type;
+
+    /**
+     * A pre-resolved handle to a material parameter, obtained once from
+     * Material::getParameterHandle() and then usable on any instance of that Material.
+     * Using a handle skips the per-call name lookup of setParameter(), which matters when
+     * many parameters are set on many instances every frame.
+     */
+    class ParameterHandle {
+    public:
+        ParameterHandle() noexcept = default;
+        //! Returns true if this handle refers to an existing (non-sampler) parameter.
+        bool isValid() const noexcept { return mOffset >= 0; }
+    private:
+        friend class FMaterial;
+        friend class FMaterialInstance;
+        explicit ParameterHandle(int32_t offset) noexcept : mOffset(offset) {}
+        int32_t mOffset = -1;   // byte offset in the uniform buffer, -1 if invalid
+    };
+
+    /**
+     * One element of a setParameters() batch: a parameter handle and its new value.
+     */
+    struct ParameterSetting {
+        template<typename T, typename = is_handle_supported_parameter_t<T>>
+        ParameterSetting(ParameterHandle handle, T const& value) noexcept
+                : handle(handle), size(sizeof(T)) {
+            static_assert(sizeof(T) <= sizeof(storage), "unsupported parameter type");
+            memcpy(storage, &value, sizeof(T));
+        }
+        ParameterHandle handle;
+        uint32_t size;
+        char storage[64];   // largest supported type is mat4f
+    };
+
+    /**
+     * Set a uniform by pre-resolved handle.
+     *
+     * This is equivalent to the name-based setParameter(), but without the string lookup.
+     * An invalid handle is a no-op, like a non-existent name with exceptions disabled.
+     *
+     * @param handle    Handle obtained from Material::getParameterHandle(). Must have been
+     *                  created by this instance's Material.
+     * @param value     Value of the parameter to set.
+     */
+    template<typename T, typename = is_handle_supported_parameter_t<T>>
+    void setParameter(ParameterHandle handle, T const& value) noexcept;
+
+    /**
+     * Set a batch of uniforms by pre-resolved handles.
+     *
+     * All values are written in one pass with a single merged dirty range, making this the
+     * cheapest way to update many parameters on an instance every frame.
+     *
+     * @param settings  Array of handle/value pairs. Invalid handles are skipped.
+     * @param count     Number of elements in the settings array.
+     */
+    void setParameters(ParameterSetting const* UTILS_NONNULL settings, size_t count) noexcept;
+
+
     /**
      * Set a texture as the named parameter
      *
@@ -26,6 +26,7 @@
 #include <math/mathfwd.h>
 
 #include <stddef.h>
+#include <stdint.h>
 
 namespace filament {
 
@@ -126,6 +127,45 @@ public:
     void setPositionsAt(Engine& engine, size_t targetIndex,
             math::float4 const* UTILS_NONNULL positions, size_t count, size_t offset = 0);
 
+    /**
+     * Updates a sparse set of positions for the given morph target.
+     *
+     * Only the listed vertices are stored and uploaded, which is designed for morph data encoded
+     * as glTF sparse accessors, where a target typically displaces a small subset of the mesh.
+     * Vertices not listed in indices keep their current value, so the whole target must have been
+     * initialized (e.g. with setPositionsAt) before sparse updates are applied.
+     *
+     * Runs of consecutive indices are uploaded in a single operation, so indices should be sorted
+     * in ascending order for best performance.
+     *
+     * @param engine Reference to the filament::Engine associated with this MorphTargetBuffer.
+     * @param targetIndex the index of morph target to be updated.
+     * @param indices pointer to at least "count" vertex indices
+     * @param positions pointer to at least "count" positions, one per index
+     * @param count number of vertices to update
+     * @see setPositionsAt
+     */
+    void setPositionsAt(Engine& engine, size_t targetIndex,
+            uint32_t const* UTILS_NONNULL indices, math::float3 const* UTILS_NONNULL positions,
+            size_t count);
+
+    /**
+     * Updates a sparse set of tangents for the given morph target.
+     *
+     * See the sparse variant of setPositionsAt for the storage semantics; the quaternion encoding
+     * is the same as setTangentsAt.
+     *
+     * @param engine Reference to the filament::Engine associated with this MorphTargetBuffer.
+     * @param targetIndex the index of morph target to be updated.
+     * @param indices pointer to at least "count" vertex indices
+     * @param tangents pointer to at least "count" short4 quaternions, one per index
+     * @param count number of vertices to update
+     * @see setTangentsAt
+     */
+    void setTangentsAt(Engine& engine, size_t targetIndex,
+            uint32_t const* UTILS_NONNULL indices, math::short4 const* UTILS_NONNULL tangents,
+            size_t count);
+
     /**
      * Updates tangents for the given morph target.
      *
@@ -96,6 +96,36 @@ struct DynamicResolutionOptions {
     QualityLevel quality = QualityLevel::LOW;
 };
 
+/**
+ * Options for closed-loop dynamic quality scaling
+ *
+ * When enabled, the renderer compares the measured GPU frame time against a caller-set
+ * budget and automatically lowers a few quality knobs -- bloom levels, SSAO quality and
+ * the directional shadow cascade count -- when the budget is exceeded for several
+ * consecutive frames, restoring them once the load subsides. This complements dynamic
+ * resolution: resolution scaling reacts quickly to small overshoots, quality scaling
+ * absorbs sustained overloads that resolution alone can't recover.
+ *
+ * budgetMilliseconds: GPU frame-time budget. When 0, the budget is derived from the
+ *                     display refresh rate and Renderer::FrameRateOptions, like the
+ *                     dynamic resolution target.
+ *
+ * maxDegradation: the largest quality reduction allowed, from 0 (none) to 3 (all knobs
+ *                 at their floor).
+ *
+ * \note
+ * Like dynamic resolution, this is only supported on platforms where the time to render
+ * a frame can be measured accurately.
+ *
+ * @see DynamicResolutionOptions
+ * @see Renderer::FrameRateOptions
+ */
+struct DynamicQualityOptions {
+    float budgetMilliseconds = 0.0f;    //!< GPU frame-time budget, 0 = derive from refresh rate
+    uint8_t maxDegradation = 3;         //!< maximum quality degradation level [0, 3]
+    bool enabled = false;               //!< enable or disable dynamic quality scaling
+};
+
 /**
  * Options to control the bloom effect
  *
@@ -376,7 +406,7 @@ struct AmbientOcclusionOptions {
     float radius = 0.3f;    //!< Ambient Occlusion radius in meters, between 0 and ~10.
     float power = 1.0f;     //!< Controls ambient occlusion's contrast. Must be positive.
     float bias = 0.0005f;   //!< Self-occlusion bias in meters. Use to avoid self-occlusion. Between 0 and a few mm.
-    float resolution = 0.5f;//!< How each dimension of the AO buffer is scaled. Must be either 0.5 or 1.0.
+    float resolution = 0.5f;//!< How each dimension of the AO buffer is scaled. Must be 0.25, 0.5 or 1.0.
     float intensity = 1.0f; //!< Strength of the Ambient Occlusion effect.
     float bilateralThreshold = 0.05f; //!< depth distance that constitute an edge for filtering
     QualityLevel quality = QualityLevel::LOW; //!< affects # of samples used for AO.
@@ -445,6 +475,14 @@ struct TemporalAntiAliasingOptions {
     bool enabled = false;       //!< enables or disables temporal anti-aliasing
     bool upscaling = false;     //!< 4x TAA upscaling. Disables Dynamic Resolution. [BETA]
 
+    /**
+     * Rendering resolution relative to the display when upscaling is true, between 0.5 and 0.67.
+     * The temporal reconstruction is a fixed 2x per axis: at 0.5 it lands exactly on the native
+     * resolution; above 0.5 the reconstructed image is supersampled and then downsampled to
+     * native, trading back some of the saved GPU work for quality.
+     */
+    float upscalingRatio = 0.5f;
+
     enum class BoxType : uint8_t {
         AABB,           //!< use an AABB neighborhood
         VARIANCE,       //!< use the variance of the neighborhood (not recommended)
@@ -253,6 +253,24 @@ public:
          */
         Builder& boundingBox(const Box& axisAlignedBoundingBox) noexcept;
 
+        /**
+         * The axis-aligned bounding box of one primitive, for finer-grained culling.
+         *
+         * This is optional. When specified, primitives of a visible renderable are individually
+         * culled against the frustum, so a large merged mesh only draws the primitives that are
+         * actually in view. This is an object-space AABB, in the same space as boundingBox(),
+         * which must still enclose all primitives; it does not replace it.
+         *
+         * Per-primitive culling is applied to the first 32 primitives of a renderable;
+         * primitives past that, or without a bounding box, are drawn whenever the renderable is
+         * visible.
+         *
+         * @param index zero-based index of the primitive, must be less than the count passed to
+         * Builder constructor
+         * @param axisAlignedBoundingBox the axis aligned bounding box of the primitive
+         */
+        Builder& boundingBox(size_t index, const Box& axisAlignedBoundingBox) noexcept;
+
         /**
          * Sets bits in a visibility mask. By default, this is 0x1.
          *
@@ -347,6 +365,16 @@ public:
          */
         Builder& receiveShadows(bool enable) noexcept;
 
+        /**
+         * Marks this renderable as a shadow-only proxy, false by default.
+         *
+         * A shadow-only renderable is rendered into shadow maps (provided castShadows is
+         * enabled) but never into color or depth passes. This is intended for simplified
+         * occluder geometry standing in for an expensive mesh: the detailed mesh disables
+         * castShadows and the cheap proxy casts the shadow in its place.
+         */
+        Builder& shadowOnly(bool enable) noexcept;
+
         /**
          * Controls if this renderable uses screen-space contact shadows. This is more
          * expensive but can improve the quality of shadows, especially in large scenes.
@@ -693,6 +721,20 @@ public:
      */
     void setScreenSpaceContactShadows(Instance instance, bool enable) noexcept;
 
+    /**
+     * Changes whether the renderable is a shadow-only proxy.
+     *
+     * \see Builder::shadowOnly()
+     */
+    void setShadowOnly(Instance instance, bool enable) noexcept;
+
+    /**
+     * Checks if the renderable is a shadow-only proxy.
+     *
+     * \see Builder::shadowOnly()
+     */
+    bool isShadowOnly(Instance instance) const noexcept;
+
     /**
      * Checks if the renderable can cast shadows.
      *
@@ -21,7 +21,10 @@
 
 #include <filament/FilamentAPI.h>
 
+#include <backend/CallbackHandler.h>
+
 #include <utils/compiler.h>
+#include <utils/CString.h>
 #include <utils/FixedCapacityVector.h>
 
 #include <math/vec4.h>
@@ -34,6 +37,7 @@ namespace filament {
 class Engine;
 class RenderTarget;
 class SwapChain;
+class Texture;
 class View;
 class Viewport;
 
@@ -97,6 +101,8 @@ public:
         time_point_ns endFrame;             //!< Renderer::endFrame() time since epoch [ns]
         time_point_ns backendBeginFrame;    //!< Backend thread time of frame start since epoch [ns]
         time_point_ns backendEndFrame;      //!< Backend thread time of frame end since epoch [ns]
+        uint32_t commandBufferPeak;         //!< peak command-stream buffer occupancy [bytes]
+        uint32_t commandBufferSize;         //!< command-stream buffer capacity [bytes]
     };
 
     /**
@@ -114,6 +120,65 @@ public:
      */
     size_t getMaxFrameHistorySize() const noexcept;
 
+    /**
+     * Enables or disables the frame timeline recorder.
+     *
+     * When enabled, the renderer keeps a ring buffer of the last few hundred frames with the
+     * main thread begin/end times, the backend thread times, the present time, the GPU frame
+     * time and per-pass CPU/GPU times measured with backend timer queries. The recorder is
+     * cheap enough to leave enabled in production so that stutters can be captured in the
+     * field, but it is disabled by default because per-pass timer queries are not free on
+     * all drivers.
+     *
+     * Disabling the recorder keeps the history recorded so far.
+     *
+     * @param enabled true to record the frame timeline
+     * @see exportFrameTimeline()
+     */
+    void setFrameTimelineEnabled(bool enabled) noexcept;
+
+    /**
+     * @return whether the frame timeline recorder is enabled
+     * @see setFrameTimelineEnabled()
+     */
+    bool isFrameTimelineEnabled() const noexcept;
+
+    /**
+     * Exports the recorded frame timeline as Chrome trace JSON ("traceEvents" array format),
+     * which can be loaded in chrome://tracing or Perfetto.
+     *
+     * Pass slices only carry durations, so they are laid out end-to-end from the start of
+     * their frame; gaps between passes are not represented.
+     *
+     * @return the serialized trace; empty if nothing was recorded
+     * @see setFrameTimelineEnabled()
+     */
+    utils::CString exportFrameTimeline() const noexcept;
+
+    /**
+     * Rolling GPU time statistics of one named render pass
+     * @see getPassStatistics()
+     */
+    struct PassStatistics {
+        utils::CString name;        //!< pass name as it appears in the frame graph
+        uint64_t minNs;             //!< minimum GPU time over the window [ns]
+        uint64_t p50Ns;             //!< median GPU time over the window [ns]
+        uint64_t p95Ns;             //!< 95th percentile GPU time over the window [ns]
+        uint32_t sampleCount;       //!< number of samples the statistics are computed over
+    };
+
+    /**
+     * Retrieves rolling GPU time statistics for each render pass, computed over a window of
+     * the last few dozen executions of that pass. Timer queries are collected in batches and
+     * never synchronously, so reading the statistics every frame does not stall the GPU.
+     *
+     * The frame timeline recorder must be enabled for statistics to accumulate.
+     *
+     * @return a vector with one entry per pass seen since the recorder was enabled
+     * @see setFrameTimelineEnabled()
+     */
+    utils::FixedCapacityVector<PassStatistics> getPassStatistics() const noexcept;
+
     /**
      * Use FrameRateOptions to set the desired frame rate and control how quickly the system
      * reacts to GPU load changes.
@@ -389,6 +454,25 @@ public:
      */
     void render(View const* UTILS_NONNULL view);
 
+    /**
+     * Renders several independent Views in one call.
+     *
+     * The Views must be independent, that is, target disjoint RenderTargets (this is not
+     * verified). By declaring the independence explicitly, the renderer is free to overlap
+     * their processing; currently the command stream is flushed after each View, so the
+     * backend thread encodes one View's commands while the commands of the next View are
+     * being generated, instead of all encoding being serialized behind the last View.
+     *
+     * This is otherwise equivalent to calling render() on each View in order, and the same
+     * threading and beginFrame()/endFrame() rules apply.
+     *
+     * @param views     Pointer to an array of Views to render. Null entries are skipped.
+     * @param viewCount Number of Views in the array.
+     *
+     * @see render(View const*)
+     */
+    void render(View const* UTILS_NULLABLE const* UTILS_NONNULL views, size_t viewCount);
+
     /**
      * Copy the currently rendered view to the indicated swap chain, using the
      * indicated source and destination rectangle.
@@ -405,6 +489,39 @@ public:
     void copyFrame(SwapChain* UTILS_NONNULL dstSwapChain, Viewport const& dstViewport,
             Viewport const& srcViewport, uint32_t flags = 0);
 
+    /**
+     * Copy the currently rendered frame into the given Texture, entirely on the GPU.
+     *
+     * Unlike readPixels(), no data crosses back to the CPU, so this never stalls the pipeline
+     * and is suitable for capturing every frame, e.g. to feed a video encoder consuming the
+     * texture (or an external image wrapping it) directly on the GPU.
+     *
+     * The destination texture must have been created with TextureUsage::BLIT_DST and must be
+     * large enough for the destination rectangle. The copy is scheduled on the GPU timeline,
+     * ordered after the rendering commands issued so far in this frame.
+     *
+     * The optional callback is invoked (through `handler`, or on the main thread if `handler`
+     * is null) once the GPU has finished executing the copy, that is when the texture content
+     * is ready to be consumed. Like the readPixels() callback, this typically happens a few
+     * frames after the call.
+     *
+     * @param dstTexture   The texture into which the frame is copied.
+     * @param dstViewport  The destination rectangle within the texture.
+     * @param srcViewport  The source rectangle to be copied.
+     * @param handler      Handler to dispatch the callback, or nullptr for the default handler.
+     * @param callback     Callback called when the copy has completed on the GPU. Can be null.
+     * @param user         A closure-like pointer passed back to the callback.
+     *
+     * @remark
+     * copyFrameInto() should be called after a frame is rendered using render()
+     * but before endFrame() is called.
+     */
+    void copyFrameInto(Texture* UTILS_NONNULL dstTexture, Viewport const& dstViewport,
+            Viewport const& srcViewport,
+            backend::CallbackHandler* UTILS_NULLABLE handler = nullptr,
+            backend::CallbackHandler::Callback UTILS_NULLABLE callback = nullptr,
+            void* UTILS_NULLABLE user = nullptr);
+
     /**
      * Reads back the content of the SwapChain associated with this Renderer.
      *
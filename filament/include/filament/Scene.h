@@ -24,6 +24,8 @@
 #include <utils/compiler.h>
 #include <utils/Invocable.h>
 
+#include <math/mathfwd.h>
+
 #include <stddef.h>
 
 namespace utils {
@@ -103,6 +105,23 @@ public:
      */
     IndirectLight* UTILS_NULLABLE getIndirectLight() const noexcept;
 
+    /**
+     * Atomically replaces the Scene's environment (IndirectLight and Skybox).
+     *
+     * Unlike setIndirectLight() / setSkybox(), the swap is deferred until the GPU work issued
+     * before this call -- typically the new environment's cubemap uploads -- has completed, so
+     * a partially uploaded environment is never sampled. Both objects flip in the same frame.
+     *
+     * A subsequent call replaces a swap that is still pending. The previous environment is
+     * only detached; it can be destroyed immediately afterwards, as the backend defers the
+     * actual resource destruction until in-flight frames are done with it.
+     *
+     * @param ibl    The IndirectLight to use when rendering the Scene, or nullptr to unset.
+     * @param skybox The Skybox to use to fill untouched pixels, or nullptr to unset.
+     */
+    void setEnvironment(IndirectLight* UTILS_NULLABLE ibl,
+            Skybox* UTILS_NULLABLE skybox) noexcept;
+
     /**
      * Adds an Entity to the Scene.
      *
@@ -141,6 +160,78 @@ public:
      */
     void removeEntities(const utils::Entity* UTILS_NONNULL entities, size_t count);
 
+    /**
+     * Identifies a streaming partition, see addPartition().
+     */
+    using PartitionId = uint32_t;
+
+    /**
+     * Denotes "no partition". addPartition() never returns this value.
+     */
+    static constexpr PartitionId INVALID_PARTITION = 0;
+
+    /**
+     * Adds a pre-cooked batch of entities to the Scene as a streaming partition.
+     *
+     * A partition is a unit of streaming, typically a world tile: its entities are added to
+     * the Scene together and later disposed of together with removePartition(). Adding a
+     * partition is O(count) entity insertions; any backend-side object creation it entails
+     * happens asynchronously on the driver thread, so this call never blocks on the GPU.
+     *
+     * The entity array is copied and need not outlive the call. Entities and their
+     * components remain owned by the partition until it is removed, see removePartition().
+     *
+     * If a memory budget is set (see setPartitionBudget()) and this addition pushes the
+     * total declared partition size past it, the eviction callback is invoked for the
+     * oldest resident partitions -- never the one being added -- and each is then removed
+     * as if by removePartition(), until the total is back under budget.
+     *
+     * @param entities    Array of entities making up the partition.
+     * @param count       Number of entities in the array.
+     * @param sizeInBytes Estimated resident size of the partition, as computed by the
+     *                    cooking pipeline. Only used for budget accounting; pass 0 if
+     *                    budgeting is not used.
+     * @return An identifier for the partition, to pass to removePartition().
+     */
+    PartitionId addPartition(const utils::Entity* UTILS_NONNULL entities, size_t count,
+            size_t sizeInBytes = 0);
+
+    /**
+     * Removes a streaming partition from the Scene.
+     *
+     * The partition's entities are removed from the Scene immediately, so they stop
+     * rendering this frame. Their Renderable and Light components are then destroyed
+     * incrementally, a bounded number per frame, so despawning a large tile does not
+     * stall the frame; the storage compaction this triggers is itself budgeted by the
+     * component managers. The Entity objects themselves stay alive and return to the
+     * caller's ownership.
+     *
+     * @param id The identifier returned by addPartition(). Unknown identifiers are
+     *           ignored.
+     */
+    void removePartition(PartitionId id) noexcept;
+
+    /**
+     * Sets a memory budget for streaming partitions along with an eviction callback.
+     *
+     * Whenever the sum of the declared partition sizes exceeds \p budgetInBytes, the
+     * least-recently-added partitions are evicted until the total is back under budget:
+     * for each, \p evictionCallback is invoked -- giving the application a chance to
+     * release its own data for the tile -- and the partition is then removed as if by
+     * removePartition(). Eviction happens during addPartition() calls only.
+     *
+     * @param budgetInBytes    Partition memory budget, or 0 to disable eviction.
+     * @param evictionCallback Called with the identifier of each evicted partition.
+     */
+    void setPartitionBudget(size_t budgetInBytes,
+            utils::Invocable<void(PartitionId)>&& evictionCallback) noexcept;
+
+    /**
+     * Returns the sum of the declared sizes of all resident partitions.
+     * @return Total declared partition memory, in bytes.
+     */
+    size_t getPartitionMemoryUsage() const noexcept;
+
     /**
      * Returns the total number of Entities in the Scene, whether alive or not.
      * @return Total number of Entities in the Scene.
@@ -177,6 +268,23 @@ public:
      */
     void forEach(utils::Invocable<void(utils::Entity entity)>&& functor) const noexcept;
 
+    /**
+     * Finds the renderable whose world-space bounding box is hit first by a ray.
+     *
+     * This is a broad-phase query against renderable bounding boxes, not geometry, making
+     * it suitable for picking. The underlying spatial structure is refreshed when the
+     * scene is rendered, so the result reflects the state of the last rendered frame; a
+     * scene that has never been rendered returns a null entity.
+     *
+     * @param origin    ray origin, in world space
+     * @param direction ray direction, in world space, need not be normalized
+     * @param tMax      maximum distance along the ray to consider, in units of the
+     *                  direction's length
+     * @return the entity of the closest renderable hit, or a null entity if none
+     */
+    utils::Entity raycast(math::float3 origin, math::float3 direction,
+            float tMax) const noexcept;
+
 protected:
     // prevent heap allocation
     ~Scene() = default;
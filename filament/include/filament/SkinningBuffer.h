@@ -124,6 +124,46 @@ public:
     void setBones(Engine& engine, math::mat4f const* UTILS_NONNULL transforms,
             size_t count, size_t offset = 0);
 
+    /**
+     * Stages an update of the bone transforms in the range [offset, offset + count)
+     * without uploading it.
+     *
+     * The bones are converted and kept CPU-side and the range is marked dirty; nothing is
+     * sent to the GPU until commit() is called, which coalesces adjacent dirty ranges into
+     * a minimal set of uploads. Prefer this over setBones() when only a few scattered
+     * sub-ranges of a large palette change per frame (e.g. partially animated crowds).
+     *
+     * @param engine Reference to the filament::Engine to associate this SkinningBuffer with.
+     * @param transforms pointer to at least count Bone
+     * @param count number of Bone elements in transforms
+     * @param offset offset in elements (not bytes) in the SkinningBuffer (not in transforms)
+     * @see commit
+     */
+    void updateBones(Engine& engine, RenderableManager::Bone const* UTILS_NONNULL transforms,
+            size_t count, size_t offset = 0);
+
+    /**
+     * Stages an update of the bone transforms in the range [offset, offset + count)
+     * without uploading it.
+     *
+     * @param engine Reference to the filament::Engine to associate this SkinningBuffer with.
+     * @param transforms pointer to at least count mat4f
+     * @param count number of mat4f elements in transforms
+     * @param offset offset in elements (not bytes) in the SkinningBuffer (not in transforms)
+     * @see commit
+     */
+    void updateBones(Engine& engine, math::mat4f const* UTILS_NONNULL transforms,
+            size_t count, size_t offset = 0);
+
+    /**
+     * Uploads all the ranges staged with updateBones() since the last commit, one upload
+     * per coalesced dirty range. A no-op if nothing is staged.
+     *
+     * @param engine Reference to the filament::Engine to associate this SkinningBuffer with.
+     * @see updateBones
+     */
+    void commit(Engine& engine);
+
     /**
      * Returns the size of this SkinningBuffer in elements.
      * @return The number of bones the SkinningBuffer holds.
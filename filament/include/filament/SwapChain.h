@@ -234,6 +234,29 @@ public:
      */
     static constexpr uint64_t CONFIG_PROTECTED_CONTENT = backend::SWAP_CHAIN_CONFIG_PROTECTED_CONTENT;
 
+    /**
+     * The SwapChain's frame-latency policy: how many frames may be in flight before
+     * Renderer::beginFrame() throttles. A latency of 1 gives the lowest input latency but
+     * prevents CPU / GPU overlap, 2 is the engine default, and 3 fully pipelines the main
+     * thread, the driver thread and the GPU, which is appropriate for cinematic content.
+     * Backends additionally use the policy to size their image / drawable pools where the
+     * platform allows it. Use makeFrameLatencyConfig() to encode a latency into the flags:
+     *
+     *     engine->createSwapChain(nativeWindow, SwapChain::makeFrameLatencyConfig(1));
+     */
+    static constexpr uint64_t CONFIG_FRAME_LATENCY_MASK =
+            backend::SWAP_CHAIN_CONFIG_FRAME_LATENCY_MASK;
+
+    /**
+     * Encodes a frame-latency policy into SwapChain configuration flags.
+     * @param frameLatency  desired number of frames in flight, clamped to [1, 3]. 0 keeps
+     *                      the engine default.
+     * @return a value to combine with the other CONFIG_* flags
+     */
+    static constexpr uint64_t makeFrameLatencyConfig(uint8_t frameLatency) noexcept {
+        return backend::swapChainConfigFrameLatency(frameLatency);
+    }
+
     /**
      * Return whether createSwapChain supports the CONFIG_PROTECTED_CONTENT flag.
      * The default implementation returns false.
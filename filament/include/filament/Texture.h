@@ -83,6 +83,7 @@ public:
     using Type = backend::PixelDataType;                             //!< Pixel data format
     using CompressedType = backend::CompressedPixelDataType;         //!< Compressed pixel data format
     using Usage = backend::TextureUsage;                             //!< Usage affects texel layout
+    using ImageRegion = backend::TextureUpdateRegion;                //!< Region of a batched upload
     using Swizzle = backend::TextureSwizzle;                         //!< Texture swizzle
 
     /** @return whether a backend supports a particular format. */
@@ -339,6 +340,39 @@ public:
             uint32_t width, uint32_t height, uint32_t depth,
             PixelBufferDescriptor&& buffer) const;
 
+    /**
+     * Updates several sub-regions of this texture — possibly spanning multiple mip levels and
+     * layers — in a single call, from a single client-side buffer.
+     *
+     * This is equivalent to calling setImage() once per region, but lets backends batch the
+     * transfer: the Vulkan backend in particular uses a single staging allocation, a single copy
+     * command and one pair of layout transitions for the whole batch, which matters when
+     * streaming many small regions (e.g. glTF asset loads).
+     *
+     * Each region's texels must be tightly packed (stride == width) and start at
+     * ImageRegion::bufferOffset bytes into \p buffer. Compressed pixel data is not supported;
+     * use setImage() for compressed uploads.
+     *
+     * If the engine's staging budget is exceeded (see Engine::setStagingBudget()), the batch
+     * is queued engine-side instead of being submitted, and is flushed once the budget frees
+     * up; \p priority orders the queue, lower values first. Batches targeting the same
+     * texture should use the same priority so their relative order is preserved.
+     *
+     * @param engine    Engine this texture is associated to.
+     * @param regions   Regions to update. Copied internally, need not outlive the call.
+     * @param count     Number of regions, must be at least 1.
+     * @param buffer    Client-side buffer holding the texels of all regions.
+     * @param priority  Submission order when batches are queued by the staging budget,
+     *                  lower values first.
+     *
+     * @attention \p engine must be the instance passed to Builder::build()
+     * @attention \p buffer's Texture::Format must match that of getFormat().
+     *
+     * @see setImage(), Engine::setStagingBudget()
+     */
+    void setImages(Engine& engine, ImageRegion const* regions, size_t count,
+            PixelBufferDescriptor&& buffer, uint8_t priority = 0) const;
+
     /**
      * inline helper to update a 2D texture
      *
@@ -481,6 +515,42 @@ public:
      */
     void generateMipmaps(Engine& engine) const noexcept;
 
+    /**
+     * Returns the number of frames elapsed since this texture was last used for rendering,
+     * that is, since a render pass last sampled from it.
+     *
+     * This is intended for residency management: an application streaming a large texture set
+     * can periodically query this to find textures that have fallen out of the working set,
+     * destroy them, and reload them from its own asset storage when they're needed again.
+     *
+     * @param engine        Engine this texture is associated to.
+     *
+     * @return the number of frames the texture has been unused for, 0 if it was used in the
+     *         current frame, or UINT32_MAX if it has never been used.
+     *
+     * @attention \p engine must be the instance passed to Builder::build()
+     */
+    uint32_t getUnusedFrameCount(Engine& engine) const noexcept;
+
+    /**
+     * Returns the mip level this texture is expected to be sampled at, estimated from the
+     * on-screen footprint of the renderables that sampled it in the most recent frame.
+     *
+     * This drives texture-streaming priorities: a texture whose desired level is above its
+     * currently resident range can be demoted, while a desired level of 0 means full
+     * resolution is needed. The estimate is only produced for Views that have called
+     * View::setStreamingFeedbackEnabled(true).
+     *
+     * @param engine        Engine this texture is associated to.
+     *
+     * @return the desired mip level (0 means the full resolution is needed), or a negative
+     *         value when no feedback is available (feedback disabled, or the texture wasn't
+     *         sampled by a recent frame).
+     *
+     * @attention \p engine must be the instance passed to Builder::build()
+     */
+    float getDesiredMipLevel(Engine& engine) const noexcept;
+
     /**
      * Creates a reflection map from an environment map.
      *
@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//! \file
+
+#ifndef TNT_FILAMENT_TEXTUREATLAS_H
+#define TNT_FILAMENT_TEXTUREATLAS_H
+
+#include <filament/FilamentAPI.h>
+#include <filament/Texture.h>
+#include <filament/Viewport.h>
+
+#include <backend/PixelBufferDescriptor.h>
+
+#include <utils/compiler.h>
+
+#include <math/vec4.h>
+
+#include <stdint.h>
+
+namespace filament {
+
+class FTextureAtlas;
+
+class Engine;
+
+/**
+ * A dynamic texture atlas packing many small images into a single texture array.
+ *
+ * Workloads binding many small textures -- decals, UI widgets, sprite sheets -- pay a
+ * per-texture cost in descriptor bindings and lose batching opportunities because draws
+ * with different textures can't share a pipeline state. TextureAtlas collapses those
+ * textures into a handful of array layers: applications allocate square regions, upload
+ * pixel data into them, and remap their UVs with the transform returned for each entry,
+ * leaving a single texture bound for the whole batch.
+ *
+ * Entries must be square with a power-of-two size; the four power-of-two sizes smaller
+ * than or equal to the atlas size are allowed (e.g. a 1024 atlas accepts 1024, 512, 256
+ * and 128 entries). Freed entries are available to subsequent allocations.
+ *
+ * The atlas texture uses Sampler::SAMPLER_2D_ARRAY; the layer of each entry is the third
+ * texture coordinate.
+ *
+ * @see Texture, MaterialInstance
+ */
+class UTILS_PUBLIC TextureAtlas : public FilamentAPI {
+    struct BuilderDetails;
+
+public:
+    using PixelBufferDescriptor = backend::PixelBufferDescriptor;
+
+    /**
+     * A region of the atlas, returned by allocate().
+     */
+    struct Entry {
+        int32_t layer = -1;     //!< layer in the texture array, -1 if the allocation failed
+        Viewport region;        //!< region within the layer, in pixels
+
+        //! whether this entry denotes a valid atlas region
+        bool isValid() const noexcept { return layer >= 0; }
+    };
+
+    class Builder : public BuilderBase<BuilderDetails>, public BuilderNameMixin<Builder> {
+        friend struct BuilderDetails;
+    public:
+        Builder() noexcept;
+        Builder(Builder const& rhs) noexcept;
+        Builder(Builder&& rhs) noexcept;
+        ~Builder() noexcept;
+        Builder& operator=(Builder const& rhs) noexcept;
+        Builder& operator=(Builder&& rhs) noexcept;
+
+        /**
+         * Size in texels of each layer of the atlas. Must be a power of two.
+         * (defaults to 1024)
+         * @param size Width and height of the atlas layers.
+         * @return A reference to this Builder for chaining calls.
+         */
+        Builder& size(uint32_t size) noexcept;
+
+        /**
+         * Number of layers of the backing texture array, in [1, 64]. (defaults to 1)
+         * @param count Number of layers.
+         * @return A reference to this Builder for chaining calls.
+         */
+        Builder& layerCount(uint8_t count) noexcept;
+
+        /**
+         * Internal format of the backing texture. (defaults to RGBA8)
+         * @param format Format of the atlas texture.
+         * @return A reference to this Builder for chaining calls.
+         */
+        Builder& format(Texture::InternalFormat format) noexcept;
+
+        /**
+         * Creates the TextureAtlas and returns a pointer to it.
+         *
+         * @param engine Reference to the filament::Engine to associate this TextureAtlas with.
+         *
+         * @return pointer to the newly created object.
+         *
+         * @exception utils::PostConditionPanic if a runtime error occurred, such as running out
+         *            of memory or other resources.
+         * @exception utils::PreConditionPanic if a parameter to a builder function was invalid.
+         */
+        TextureAtlas* UTILS_NONNULL build(Engine& engine);
+
+    private:
+        friend class FTextureAtlas;
+    };
+
+    /**
+     * Allocates a square region of the atlas.
+     *
+     * @param size Width and height of the region in texels. Must be one of the four
+     *             power-of-two sizes smaller than or equal to the atlas size.
+     * @return the allocated Entry, invalid (layer == -1) if the atlas is full or the size
+     *         is not allowed.
+     */
+    Entry allocate(uint32_t size) noexcept;
+
+    /**
+     * Frees a region previously returned by allocate(). The space becomes available to
+     * subsequent allocations. The entry's content is left untouched.
+     *
+     * @param entry Entry to free. Invalid entries are ignored.
+     */
+    void free(Entry const& entry) noexcept;
+
+    /**
+     * Asynchronously copies pixel data into an atlas entry.
+     *
+     * @param engine Reference to the filament::Engine associated with this TextureAtlas.
+     * @param entry  Entry to update, as returned by allocate(). Must be valid.
+     * @param buffer Pixel data, covering the whole entry.
+     */
+    void setImage(Engine& engine, Entry const& entry, PixelBufferDescriptor&& buffer) const;
+
+    /**
+     * Returns the texture array backing this atlas, suitable for
+     * MaterialInstance::setParameter(). The atlas retains ownership of the texture.
+     *
+     * @return the backing Texture.
+     */
+    Texture* UTILS_NONNULL getTexture() const noexcept;
+
+    /**
+     * Returns the UV transform mapping an entry's local texture coordinates to atlas
+     * coordinates, as { scale.x, scale.y, offset.x, offset.y }:
+     *
+     *     uvAtlas = uvLocal * transform.xy + transform.zw
+     *
+     * Use entry.layer for the array index. This is typically set as a parameter on the
+     * material instances sampling from the atlas.
+     *
+     * @param entry Entry to compute the transform of. Must be valid.
+     * @return the UV transform of the entry.
+     */
+    math::float4 getUvTransform(Entry const& entry) const noexcept;
+
+protected:
+    // prevent heap allocation
+    ~TextureAtlas() = default;
+};
+
+} // namespace filament
+
+#endif // TNT_FILAMENT_TEXTUREATLAS_H
@@ -333,6 +333,22 @@ public:
      */
     void commitLocalTransformTransaction() noexcept;
 
+    /**
+     * Publishes a snapshot of all world transforms for the renderer to read.
+     *
+     * The snapshot is double-buffered and committed atomically, so a simulation thread can
+     * keep calling setTransform() while a previously committed snapshot is being rendered:
+     * Scene preparation reads the last committed snapshot instead of the live component
+     * data. Call this once per simulation step, after all transforms have been updated.
+     *
+     * Until the first commit, rendering reads the live transforms, so existing applications
+     * are unaffected. Creating or destroying components still requires synchronization with
+     * rendering; only transform *values* are protected by the snapshot.
+     *
+     * @see setTransform(), commitLocalTransformTransaction()
+     */
+    void commitWorldTransformSnapshot() noexcept;
+
 protected:
     // prevent heap allocation
     ~TransformManager() = default;
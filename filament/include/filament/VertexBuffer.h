@@ -158,6 +158,47 @@ public:
          */
         Builder& advancedSkinning(bool enabled) noexcept;
 
+        /**
+         * Moves the POSITION attribute into a dedicated, tightly packed vertex stream managed
+         * by the engine.
+         *
+         * Depth-only renderings (shadow maps, depth prepass, structure pass) only read the
+         * position attribute; when position is interleaved with the other attributes, these
+         * passes still pay the memory bandwidth of the full vertex. With this enabled, the
+         * engine copies the position data into its own stream as part of setBufferAt(), so
+         * position-only fetches touch a fraction of the memory. The interleaved copy of the
+         * position data is left in place but never read.
+         *
+         * This uses one extra buffer slot and a copy of the position data, and is not
+         * compatible with enableBufferObjects().
+         *
+         * @param enabled If true, the position data is split into its own stream.
+         *                False by default.
+         * @return A reference to this Builder for chaining calls.
+         */
+        Builder& splitPositionStream(bool enabled = true) noexcept;
+
+        /**
+         * Marks this VertexBuffer as streamed, i.e. its content is rewritten every frame
+         * (UI meshes, particle systems, CPU-generated geometry).
+         *
+         * In streaming mode, each buffer slot is backed by a small ring of backend buffers and
+         * setBufferAt() writes into the least-recently-used entry of the ring instead of
+         * overwriting a buffer the GPU may still be reading. This avoids the internal copy
+         * ("ghosting") that backends must otherwise perform when a buffer in flight is updated,
+         * at the cost of a few extra buffer allocations, created lazily on first update.
+         *
+         * Because updates rotate between buffers, a streamed buffer slot must be fully
+         * rewritten by each setBufferAt() call; partial updates would expose data from several
+         * frames ago in the unwritten range.
+         *
+         * This is not compatible with enableBufferObjects().
+         *
+         * @param enabled If true, the vertex data is ring-buffered. False by default.
+         * @return A reference to this Builder for chaining calls.
+         */
+        Builder& streaming(bool enabled = true) noexcept;
+
         /**
          * Associate an optional name with this VertexBuffer for debugging purposes.
          *
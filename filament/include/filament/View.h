@@ -77,6 +77,7 @@ public:
     using ShadowType = filament::ShadowType;
 
     using DynamicResolutionOptions = filament::DynamicResolutionOptions;
+    using DynamicQualityOptions = filament::DynamicQualityOptions;
     using BloomOptions = filament::BloomOptions;
     using FogOptions = filament::FogOptions;
     using DepthOfFieldOptions = filament::DepthOfFieldOptions;
@@ -519,6 +520,22 @@ public:
      */
     DynamicResolutionOptions getDynamicResolutionOptions() const noexcept;
 
+    /**
+     * Sets the dynamic quality options for this view. When enabled, the renderer lowers
+     * a few quality knobs (bloom levels, SSAO quality, shadow cascade count) whenever the
+     * measured GPU frame time stays above the configured budget, and restores them when
+     * the load subsides. See DynamicQualityOptions.
+     *
+     * @param options The dynamic quality options to use on this view
+     */
+    void setDynamicQualityOptions(DynamicQualityOptions const& options) noexcept;
+
+    /**
+     * Returns the dynamic quality options associated with this view.
+     * @return value set by setDynamicQualityOptions().
+     */
+    DynamicQualityOptions getDynamicQualityOptions() const noexcept;
+
     /**
      * Sets the rendering quality for this view. Refer to RenderQuality for more
      * information about the different settings available.
@@ -688,6 +705,93 @@ public:
      */
     bool isTransparentPickingEnabled() const noexcept;
 
+    /**
+     * Enables or disables continuous picking. Disabled by default.
+     *
+     * When continuous picking is enabled, the low-resolution picking buffer is rendered
+     * every frame and streamed back to the CPU asynchronously. View::pick() queries are
+     * then resolved from the most recent completed copy, which makes each query
+     * essentially free -- suitable for e.g. per-mouse-move hover queries -- at the cost
+     * of about two frames of latency and the readback bandwidth.
+     *
+     * When disabled, each batch of queries triggers its own GPU readback.
+     *
+     * @param enabled true enables continuous picking, false disables it.
+     *
+     * @note Continuous picking requires feature level 1 or above; below that, queries
+     *       fall back to per-query readbacks.
+     */
+    void setContinuousPickingEnabled(bool enabled) noexcept;
+
+    /**
+     * Returns true if continuous picking is enabled.
+     * See setContinuousPickingEnabled() for more information.
+     */
+    bool isContinuousPickingEnabled() const noexcept;
+
+    /**
+     * Enables or disables texture streaming feedback. Disabled by default.
+     *
+     * When enabled, after culling, the engine estimates the on-screen footprint of each
+     * visible renderable and folds it into the desired mip level of the textures its
+     * materials sample. The result is available through Texture::getDesiredMipLevel()
+     * and is intended to drive texture-streaming priorities.
+     *
+     * @param enabled true enables streaming feedback, false disables it.
+     */
+    void setStreamingFeedbackEnabled(bool enabled) noexcept;
+
+    /**
+     * Returns true if texture streaming feedback is enabled.
+     * See setStreamingFeedbackEnabled() for more information.
+     */
+    bool isStreamingFeedbackEnabled() const noexcept;
+
+    /**
+     * Sets the shadow sharing group of this View. Disabled by default (group 0).
+     *
+     * When several Views showing the same Scene are rendered in the same frame (e.g. a main
+     * camera and a minimap) and are placed in the same non-zero group, the first View rendered
+     * generates the shadow atlas and the other Views sample the same atlas instead of running
+     * their own shadow passes, saving the cost of rendering the shadow maps once per View.
+     *
+     * Views in a group must use the same Scene and the same shadow type; sharing is skipped
+     * otherwise. Directional (cascaded) shadow maps are fitted to the view frustum, so they
+     * are only shared between Views whose cameras are identical; Views with different cameras
+     * share only when their shadows come from spot and point lights. It is the application's
+     * responsibility to group only Views whose shadow-casting light setup is identical.
+     *
+     * @param group sharing group this View belongs to, or 0 to disable sharing.
+     */
+    void setShadowSharingGroup(uint8_t group) noexcept;
+
+    /**
+     * Returns the shadow sharing group of this View, 0 if sharing is disabled.
+     * See setShadowSharingGroup() for more information.
+     */
+    uint8_t getShadowSharingGroup() const noexcept;
+
+    /**
+     * Enables or disables automatic exposure. Disabled by default.
+     *
+     * When enabled, the engine meters the average luminance of the rendered HDR buffer with a
+     * small asynchronous readback and adapts the exposure towards it over a few frames, like a
+     * camera's auto-exposure. The adapted value overrides the camera's exposure settings for
+     * rendering only; Camera::getExposure() is unaffected.
+     *
+     * The metering never stalls the pipeline: the readback completes a few frames after the
+     * frame it measures, and the adaptation eases the exposure in rather than popping.
+     *
+     * @param enabled true enables automatic exposure, false disables it.
+     */
+    void setAutoExposureEnabled(bool enabled) noexcept;
+
+    /**
+     * Returns true if automatic exposure is enabled.
+     * See setAutoExposureEnabled() for more information.
+     */
+    bool isAutoExposureEnabled() const noexcept;
+
     /**
      * Enables use of the stencil buffer.
      *
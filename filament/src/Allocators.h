@@ -48,9 +48,12 @@ using HeapAllocatorArena = utils::Arena<
         utils::TrackingPolicy::Untracked,
         utils::AreaPolicy::NullArea>;
 
+// on Release builds we still track the high watermark (a compare and an add per
+// allocation), it drives the per-frame arena auto-sizing and overflow telemetry.
 using LinearAllocatorArena = utils::Arena<
         utils::LinearAllocator,
-        utils::LockingPolicy::NoLock>;
+        utils::LockingPolicy::NoLock,
+        utils::TrackingPolicy::HighWatermark>;
 
 #endif
 
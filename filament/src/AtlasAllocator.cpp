@@ -30,6 +30,14 @@ static inline constexpr std::pair<uint8_t, uint8_t> unmorton(uint16_t m) noexcep
     return { uint8_t(r), uint8_t(r >> 16u) };
 }
 
+static inline constexpr uint16_t morton(uint8_t x, uint8_t y) noexcept {
+    uint32_t m = (uint32_t(x) | (uint32_t(y) << 16u)) & 0x00ff00ffu;
+    m = (m | (m << 4u)) & 0x0f0f0f0fu;
+    m = (m | (m << 2u)) & 0x33333333u;
+    m = (m | (m << 1u)) & 0x55555555u;
+    return uint16_t(m | (m >> 15u));
+}
+
 AtlasAllocator::AtlasAllocator(size_t maxTextureSize) noexcept {
     // round to power-of-two immediately inferior or equal to the size specified.
     mMaxTextureSizePot = (sizeof(maxTextureSize) * 8 - 1u) - utils::clz(maxTextureSize);
@@ -67,6 +75,40 @@ AtlasAllocator::Allocation AtlasAllocator::allocate(size_t textureSize) noexcept
     return result;
 }
 
+void AtlasAllocator::free(Allocation const& allocation) noexcept {
+    using namespace QuadTreeUtils;
+    if (UTILS_UNLIKELY(allocation.layer < 0)) {
+        return;
+    }
+
+    // recompute the quadtree position from the allocation's location and size
+    const size_t powerOfTwo =
+            (sizeof(size_t) * 8 - 1u) - utils::clz(size_t(allocation.viewport.width));
+    const size_t layer = mMaxTextureSizePot - powerOfTwo;
+    const auto x = uint8_t(allocation.viewport.left >> powerOfTwo);
+    const auto y = uint8_t(allocation.viewport.bottom >> powerOfTwo);
+    NodeId curr{ int8_t(LAYERS_DEPTH + layer),
+            QuadTree::code_t(morton(x, y) | (allocation.layer << (2u * layer))) };
+
+    Node& node = mQuadTree[index(curr.l, curr.code)];
+    assert_invariant(node.isAllocated());
+    assert_invariant(!node.hasChildren());
+    node.allocated = false;
+
+    // walk up the tree, removing empty nodes from their parent's children count
+    while (curr.l > 0) {
+        const size_t p = parent(curr.l, curr.code);
+        curr = NodeId{ int8_t(curr.l - 1), QuadTree::code_t(curr.code >> 2) };
+        Node& parentNode = mQuadTree[p];
+        assert_invariant(!parentNode.isAllocated());
+        assert_invariant(parentNode.hasChildren());
+        parentNode.children--;
+        if (parentNode.hasChildren()) {
+            break;
+        }
+    }
+}
+
 void AtlasAllocator::clear(size_t maxTextureSize) noexcept {
     std::fill(mQuadTree.begin(), mQuadTree.end(), Node{});
     mMaxTextureSizePot = (sizeof(maxTextureSize) * 8 - 1u) - utils::clz(maxTextureSize);
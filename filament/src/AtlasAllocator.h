@@ -87,6 +87,12 @@ public:
     };
     Allocation allocate(size_t textureSize) noexcept;
 
+    /*
+     * Frees a single allocation previously returned by allocate(). The freed space becomes
+     * available to subsequent allocations.
+     */
+    void free(Allocation const& allocation) noexcept;
+
     /*
      * Frees all allocations and reset the maximum texture size.
      */
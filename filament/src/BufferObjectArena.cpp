@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "BufferObjectArena.h"
+
+#include <backend/DriverEnums.h>
+
+#include <private/backend/DriverApi.h>
+
+#include <utils/debug.h>
+
+#include <algorithm>
+
+#include <stdint.h>
+
+namespace filament {
+
+using namespace backend;
+
+BufferObjectArena::BufferObjectArena() noexcept = default;
+
+BufferObjectArena::~BufferObjectArena() noexcept {
+    assert_invariant(mPools.empty());
+}
+
+void BufferObjectArena::terminate(DriverApi& driver) noexcept {
+    assert_invariant(mAllocationCount == 0);
+    for (auto& [slotSize, pool] : mPools) {
+        for (auto const& slab : pool.slabs) {
+            driver.destroyBufferObject(slab);
+        }
+    }
+    mPools.clear();
+}
+
+BufferObjectArena::Allocation BufferObjectArena::allocate(DriverApi& driver,
+        BufferObjectBinding const bindingType, uint32_t const size) noexcept {
+    uint32_t const slotSize = (size + ALIGNMENT - 1u) & ~(ALIGNMENT - 1u);
+    Pool& pool = mPools[slotSize];
+    if (UTILS_UNLIKELY(pool.freeList.empty())) {
+        // slots larger than a slab get a slab of their own
+        uint32_t const slabSize = std::max(SLAB_SIZE, slotSize);
+        BufferObjectHandle const slab = driver.createBufferObject(slabSize,
+                bindingType, BufferUsage::DYNAMIC);
+        pool.slabs.push_back(slab);
+        pool.freeList.reserve(pool.freeList.size() + slabSize / slotSize);
+        for (uint32_t offset = 0; offset + slotSize <= slabSize; offset += slotSize) {
+            pool.freeList.push_back({ slab, offset });
+        }
+    }
+    Allocation const allocation = pool.freeList.back();
+    pool.freeList.pop_back();
+    mAllocationCount++;
+    return allocation;
+}
+
+void BufferObjectArena::free(Allocation const& allocation, uint32_t const size) noexcept {
+    if (!allocation.handle) {
+        return;
+    }
+    uint32_t const slotSize = (size + ALIGNMENT - 1u) & ~(ALIGNMENT - 1u);
+    auto pos = mPools.find(slotSize);
+    assert_invariant(pos != mPools.end());
+    pos.value().freeList.push_back(allocation);
+    assert_invariant(mAllocationCount > 0);
+    mAllocationCount--;
+}
+
+} // namespace filament
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_FILAMENT_BUFFEROBJECTARENA_H
+#define TNT_FILAMENT_BUFFEROBJECTARENA_H
+
+#include <backend/DriverApiForward.h>
+#include <backend/DriverEnums.h>
+#include <backend/Handle.h>
+
+#include <tsl/robin_map.h>
+
+#include <vector>
+
+#include <stdint.h>
+
+namespace filament {
+
+/*
+ * BufferObjectArena packs many small engine-owned buffers into large backend buffer objects,
+ * handing out offset-based sub-allocations. Scenes with thousands of material instances
+ * otherwise create as many tiny backend buffers, which is costly in per-allocation overhead
+ * (Vulkan device memory) and binding churn; descriptor sets already support binding a buffer
+ * range, so consumers bind { handle, offset, size } instead of a dedicated buffer.
+ *
+ * Sub-allocations are grouped in slabs by aligned size, so a freed slot is reused for the
+ * next allocation of the same size. Slabs are only released at terminate().
+ */
+class BufferObjectArena {
+public:
+    struct Allocation {
+        backend::BufferObjectHandle handle; // shared backend buffer, don't destroy
+        uint32_t offset = 0;                // byte offset of this sub-allocation
+    };
+
+    BufferObjectArena() noexcept;
+    ~BufferObjectArena() noexcept;
+
+    BufferObjectArena(BufferObjectArena const& rhs) = delete;
+    BufferObjectArena(BufferObjectArena&& rhs) noexcept = delete;
+    BufferObjectArena& operator=(BufferObjectArena const& rhs) = delete;
+    BufferObjectArena& operator=(BufferObjectArena&& rhs) noexcept = delete;
+
+    // destroys all slabs; all sub-allocations must have been freed
+    void terminate(backend::DriverApi& driver) noexcept;
+
+    // sub-allocates `size` bytes from a slab of the given binding type
+    Allocation allocate(backend::DriverApi& driver,
+            backend::BufferObjectBinding bindingType, uint32_t size) noexcept;
+
+    // returns a sub-allocation to its slab. `size` must be the size passed to allocate().
+    void free(Allocation const& allocation, uint32_t size) noexcept;
+
+private:
+    // worst-case minUniformBufferOffsetAlignment across the backends we support
+    static constexpr uint32_t ALIGNMENT = 256u;
+
+    // slabs are created with this size, unless a single slot is larger
+    static constexpr uint32_t SLAB_SIZE = 256u * 1024u;
+
+    struct Pool {
+        std::vector<backend::BufferObjectHandle> slabs;
+        std::vector<Allocation> freeList;
+    };
+
+    // pools keyed by aligned slot size; small keyspace, all slots of a pool are interchangeable
+    tsl::robin_map<uint32_t, Pool> mPools;
+    uint32_t mAllocationCount = 0;
+};
+
+} // namespace filament
+
+#endif // TNT_FILAMENT_BUFFEROBJECTARENA_H
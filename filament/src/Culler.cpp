@@ -20,6 +20,17 @@
 
 #include <math/fast.h>
 
+#include <limits>
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#   include <arm_neon.h>
+#   define FILAMENT_CULLER_SIMD_NEON 1
+#elif defined(__SSE2__)
+#   include <xmmintrin.h>
+#   include <emmintrin.h>
+#   define FILAMENT_CULLER_SIMD_SSE 1
+#endif
+
 using namespace filament::math;
 
 // use 8 if Culler::result_type is 8-bits, on ARMv8 it allows the compiler to write eight
@@ -40,6 +51,56 @@ void Culler::intersects(
     float4 const * const UTILS_RESTRICT planes = frustum.mPlanes;
 
     count = round(count);
+
+#if defined(FILAMENT_CULLER_SIMD_NEON)
+    // Explicit 8-wide path: vld4q deinterleaves four float4 spheres into SoA registers,
+    // so each plane test is a single fma against all four spheres. count is a multiple
+    // of MODULO (8), so we always process two groups of four per iteration.
+    for (size_t i = 0; i < count; i += 8) {
+        uint32x4_t visible[2];
+        for (size_t g = 0; g < 2; g++) {
+            float32x4x4_t const s = vld4q_f32(reinterpret_cast<float const*>(b + i + g * 4));
+            uint32x4_t v = vdupq_n_u32(~0u);
+            for (size_t j = 0; j < 6; j++) {
+                float32x4_t dot = vsubq_f32(vdupq_n_f32(planes[j].w), s.val[3]);
+                dot = vfmaq_n_f32(dot, s.val[0], planes[j].x);
+                dot = vfmaq_n_f32(dot, s.val[1], planes[j].y);
+                dot = vfmaq_n_f32(dot, s.val[2], planes[j].z);
+                v = vandq_u32(v, vcltq_f32(dot, vdupq_n_f32(0.0f)));
+            }
+            visible[g] = vandq_u32(v, vdupq_n_u32(1u));
+        }
+        uint16x8_t const v16 = vcombine_u16(vmovn_u32(visible[0]), vmovn_u32(visible[1]));
+        vst1_u8(results + i, vmovn_u16(v16));
+    }
+    return;
+#elif defined(FILAMENT_CULLER_SIMD_SSE)
+    // Explicit 8-wide path: transpose four float4 spheres into SoA registers, test all
+    // six planes per group and extract the per-sphere visibility from the sign mask.
+    for (size_t i = 0; i < count; i += 8) {
+        for (size_t g = 0; g < 2; g++) {
+            float const* const p = reinterpret_cast<float const*>(b + i + g * 4);
+            __m128 x = _mm_loadu_ps(p);
+            __m128 y = _mm_loadu_ps(p + 4);
+            __m128 z = _mm_loadu_ps(p + 8);
+            __m128 w = _mm_loadu_ps(p + 12);
+            _MM_TRANSPOSE4_PS(x, y, z, w);
+            __m128 v = _mm_castsi128_ps(_mm_set1_epi32(~0));
+            for (size_t j = 0; j < 6; j++) {
+                __m128 dot = _mm_sub_ps(_mm_set1_ps(planes[j].w), w);
+                dot = _mm_add_ps(dot, _mm_mul_ps(x, _mm_set1_ps(planes[j].x)));
+                dot = _mm_add_ps(dot, _mm_mul_ps(y, _mm_set1_ps(planes[j].y)));
+                dot = _mm_add_ps(dot, _mm_mul_ps(z, _mm_set1_ps(planes[j].z)));
+                v = _mm_and_ps(v, _mm_cmplt_ps(dot, _mm_setzero_ps()));
+            }
+            int const mask = _mm_movemask_ps(v);
+            results[i + g * 4 + 0] = result_type((mask >> 0) & 1);
+            results[i + g * 4 + 1] = result_type((mask >> 1) & 1);
+            results[i + g * 4 + 2] = result_type((mask >> 2) & 1);
+            results[i + g * 4 + 3] = result_type((mask >> 3) & 1);
+        }
+    }
+#else
     #pragma clang loop vectorize_width(FILAMENT_CULLER_VECTORIZE_HINT)
     for (size_t i = 0; i < count; i++) {
         int visible = ~0;
@@ -57,6 +118,7 @@ void Culler::intersects(
         }
         results[i] = result_type(visible);
     }
+#endif
 }
 
 void Culler::intersects(
@@ -93,6 +155,47 @@ void Culler::intersects(
     }
 }
 
+void Culler::intersects(
+        result_type* UTILS_RESTRICT results,
+        float* UTILS_RESTRICT margins,
+        Frustum const& UTILS_RESTRICT frustum,
+        float3 const* UTILS_RESTRICT center,
+        float3 const* UTILS_RESTRICT extent,
+        size_t count, size_t bit) noexcept {
+
+    float4 const * UTILS_RESTRICT const planes = frustum.mPlanes;
+
+    count = round(count);
+    #pragma clang loop vectorize_width(FILAMENT_CULLER_VECTORIZE_HINT)
+    for (size_t i = 0; i < count; i++) {
+        int visible = ~0;
+        float maxDot = -std::numeric_limits<float>::max();
+
+        #pragma clang loop unroll(full)
+        for (size_t j = 0; j < 6; j++) {
+            const float dot =
+                    planes[j].x * center[i].x - std::abs(planes[j].x) * extent[i].x +
+                    planes[j].y * center[i].y - std::abs(planes[j].y) * extent[i].y +
+                    planes[j].z * center[i].z - std::abs(planes[j].z) * extent[i].z +
+                    planes[j].w;
+
+            visible &= fast::signbit(dot) << bit;
+            maxDot = dot > maxDot ? dot : maxDot;
+        }
+
+        // The result flips when the plane closest to doing so crosses the box: a visible
+        // box (all dot < 0) becomes culled when the largest dot reaches zero, a culled one
+        // (some dot > 0) can only become visible once that dot drops to zero. Either way
+        // |maxDot| is the slack.
+        margins[i] = std::abs(maxDot);
+
+        auto r = results[i];
+        r &= ~result_type(1u << bit);
+        r |= result_type(visible);
+        results[i] = r;
+    }
+}
+
 /*
  * returns whether a box intersects with the frustum
  */
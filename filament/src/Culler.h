@@ -62,6 +62,18 @@ public:
             math::float4 const* b,
             size_t count) noexcept;
 
+    /*
+     * Same as the AABB variant above, but additionally writes, for each box, how far the
+     * frustum planes can drift (in world units, normals assumed normalized) before that
+     * box's result could flip. Used by the temporal culling cache in FView.
+     */
+    static void intersects(result_type* results,
+            float* margins,
+            Frustum const& frustum,
+            math::float3 const* center,
+            math::float3 const* extent,
+            size_t count, size_t bit) noexcept;
+
     /*
      * returns whether an AABB intersects with the frustum
      */
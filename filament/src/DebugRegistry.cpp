@@ -89,6 +89,34 @@ DebugRegistry::DataSource DebugRegistry::getDataSource(const char* name) const n
     return  downcast(this)->getDataSource(name);
 }
 
+bool DebugRegistry::getFrameTelemetry(FrameTelemetry* telemetry) const noexcept {
+    return downcast(this)->getFrameTelemetry(telemetry);
+}
+
+bool DebugRegistry::getSampledProperty(const char* name, bool* v) const noexcept {
+    return downcast(this)->getSampledProperty(name, v);
+}
+
+bool DebugRegistry::getSampledProperty(const char* name, int* v) const noexcept {
+    return downcast(this)->getSampledProperty(name, v);
+}
+
+bool DebugRegistry::getSampledProperty(const char* name, float* v) const noexcept {
+    return downcast(this)->getSampledProperty(name, v);
+}
+
+bool DebugRegistry::getSampledProperty(const char* name, float2* v) const noexcept {
+    return downcast(this)->getSampledProperty(name, v);
+}
+
+bool DebugRegistry::getSampledProperty(const char* name, float3* v) const noexcept {
+    return downcast(this)->getSampledProperty(name, v);
+}
+
+bool DebugRegistry::getSampledProperty(const char* name, float4* v) const noexcept {
+    return downcast(this)->getSampledProperty(name, v);
+}
+
 
 } // namespace filament
 
@@ -187,6 +187,10 @@ bool Engine::destroy(const Texture* p) {
     return downcast(this)->destroy(downcast(p));
 }
 
+bool Engine::destroy(const TextureAtlas* p) {
+    return downcast(this)->destroy(downcast(p));
+}
+
 bool Engine::destroy(const RenderTarget* p) {
     return downcast(this)->destroy(downcast(p));
 }
@@ -258,6 +262,9 @@ bool Engine::isValid(const Stream* p) const {
 bool Engine::isValid(const Texture* p) const {
     return downcast(this)->isValid(downcast(p));
 }
+bool Engine::isValid(const TextureAtlas* p) const {
+    return downcast(this)->isValid(downcast(p));
+}
 bool Engine::isValid(const RenderTarget* p) const {
     return downcast(this)->isValid(downcast(p));
 }
@@ -341,6 +348,11 @@ void Engine::flush() {
     downcast(this)->flush();
 }
 
+void Engine::flushAndScheduleCallback(backend::CallbackHandler* handler,
+        utils::Invocable<void()>&& callback) {
+    downcast(this)->flushAndScheduleCallback(handler, std::move(callback));
+}
+
 utils::EntityManager& Engine::getEntityManager() noexcept {
     return downcast(this)->getEntityManager();
 }
@@ -378,6 +390,10 @@ utils::JobSystem& Engine::getJobSystem() noexcept {
     return downcast(this)->getJobSystem();
 }
 
+utils::JobSystem& Engine::getBackgroundJobSystem() noexcept {
+    return downcast(this)->getBackgroundJobSystem();
+}
+
 bool Engine::isPaused() const noexcept {
     FILAMENT_CHECK_PRECONDITION(UTILS_HAS_THREADING)
             << "Pause is meant for multi-threaded platforms.";
@@ -398,6 +414,19 @@ void Engine::pumpMessageQueues() {
     downcast(this)->pumpMessageQueues();
 }
 
+Engine::MemoryUsage Engine::getMemoryUsage(MemoryCategory category) const noexcept {
+    return downcast(this)->getMemoryTracker().getUsage(category);
+}
+
+Engine::MemoryUsage Engine::getTotalMemoryUsage() const noexcept {
+    return downcast(this)->getMemoryTracker().getTotalUsage();
+}
+
+void Engine::setMemoryBudget(uint64_t budgetBytes, MemoryBudgetCallback callback,
+        void* user) noexcept {
+    downcast(this)->getMemoryTracker().setBudget(budgetBytes, callback, user);
+}
+
 void Engine::unprotected() noexcept {
     downcast(this)->unprotected();
 }
@@ -410,6 +439,18 @@ bool Engine::isAutomaticInstancingEnabled() const noexcept {
     return downcast(this)->isAutomaticInstancingEnabled();
 }
 
+void Engine::setStagingBudget(size_t budgetInBytes) noexcept {
+    downcast(this)->setStagingBudget(budgetInBytes);
+}
+
+size_t Engine::getPendingUploadBytes() const noexcept {
+    return downcast(this)->getPendingUploadBytes();
+}
+
+bool Engine::isStagingBudgetExceeded() const noexcept {
+    return downcast(this)->isStagingBudgetExceeded();
+}
+
 FeatureLevel Engine::getSupportedFeatureLevel() const noexcept {
     return downcast(this)->getSupportedFeatureLevel();
 }
@@ -28,4 +28,12 @@ FenceStatus Fence::wait(Mode mode, uint64_t timeout) {
     return downcast(this)->wait(mode, timeout);
 }
 
+void Fence::setWaitPolicy(WaitPolicy policy) noexcept {
+    downcast(this)->setWaitPolicy(policy);
+}
+
+FenceStatus Fence::getStatus() noexcept {
+    return downcast(this)->getStatus();
+}
+
 } // namespace filament
@@ -122,8 +122,11 @@ void FrameInfoManager::beginFrame(DriverApi& driver, Config const& config, uint3
     }
 }
 
-void FrameInfoManager::endFrame(DriverApi& driver) noexcept {
+void FrameInfoManager::endFrame(DriverApi& driver,
+        size_t const commandBufferPeak, size_t const commandBufferSize) noexcept {
     auto& front = mFrameTimeHistory.front();
+    front.commandBufferPeak = commandBufferPeak;
+    front.commandBufferSize = commandBufferSize;
     // close the timer query
     driver.endTimerQuery(mQueries[mIndex].handle);
     // queue custom backend command to query the current time
@@ -196,7 +199,9 @@ utils::FixedCapacityVector<Renderer::FrameInfo> FrameInfoManager::getFrameInfoHi
                 duration_cast<nanoseconds>(entry.beginFrame.time_since_epoch()).count(),
                 duration_cast<nanoseconds>(entry.endFrame.time_since_epoch()).count(),
                 duration_cast<nanoseconds>(entry.backendBeginFrame.time_since_epoch()).count(),
-                duration_cast<nanoseconds>(entry.backendEndFrame.time_since_epoch()).count()
+                duration_cast<nanoseconds>(entry.backendEndFrame.time_since_epoch()).count(),
+                uint32_t(entry.commandBufferPeak),
+                uint32_t(entry.commandBufferSize)
         });
     }
     return result;
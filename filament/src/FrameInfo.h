@@ -56,6 +56,8 @@ struct FrameInfoImpl : public details::FrameInfo {
     time_point endFrame;             // main thread endFrame time
     time_point backendBeginFrame;    // backend thread beginFrame time (makeCurrent time)
     time_point backendEndFrame;      // backend thread endFrame time (present time)
+    size_t commandBufferPeak = 0;    // peak command-stream buffer occupancy during the frame
+    size_t commandBufferSize = 0;    // command-stream buffer capacity at the end of the frame
     std::atomic_bool ready{};        // true once backend thread has populated its data
     explicit FrameInfoImpl(uint32_t frameId) noexcept
         : frameId(frameId) {
@@ -160,8 +162,10 @@ public:
     // call this immediately after "make current"
     void beginFrame(backend::DriverApi& driver, Config const& config, uint32_t frameId) noexcept;
 
-    // call this immediately before "swap buffers"
-    void endFrame(backend::DriverApi& driver) noexcept;
+    // call this immediately before "swap buffers". commandBufferPeak/commandBufferSize are
+    // the frame's command-stream buffer occupancy metrics (see CommandBufferQueue::getStats).
+    void endFrame(backend::DriverApi& driver,
+            size_t commandBufferPeak, size_t commandBufferSize) noexcept;
 
     details::FrameInfo getLastFrameInfo() const noexcept {
         // if pFront is not set yet, return FrameInfo(). But the `valid` field will be false in this case.
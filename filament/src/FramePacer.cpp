@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2016 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FramePacer.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include <math.h>
+#include <stddef.h>
+
+namespace filament {
+
+bool FramePacer::beginFrame(time_point const appVsync, duration const refreshPeriod,
+        duration const frameTime, size_t minInterval) noexcept {
+    if (refreshPeriod <= duration::zero()) {
+        // offscreen rendering, or the application turned frame-pacing off
+        return true;
+    }
+
+    minInterval = std::clamp(minInterval, size_t(1), MAX_SWAP_INTERVAL);
+
+    // how many refresh periods the GPU needs for one frame
+    size_t needed = minInterval;
+    if (frameTime > duration::zero()) {
+        double const periods =
+                std::ceil(double(frameTime.count()) * HEADROOM / double(refreshPeriod.count()));
+        needed = std::clamp(size_t(periods), minInterval, MAX_SWAP_INTERVAL);
+    }
+
+    if (needed > mInterval) {
+        // the GPU can't sustain the current cadence, adopt the slower one right away
+        mInterval = needed;
+        mUnderloadedFrameCount = 0;
+    } else if (needed < mInterval) {
+        // only speed up after a sustained period of headroom (see UPGRADE_HYSTERESIS_FRAME_COUNT)
+        if (++mUnderloadedFrameCount >= UPGRADE_HYSTERESIS_FRAME_COUNT) {
+            mInterval--;
+            mUnderloadedFrameCount = 0;
+        }
+    } else {
+        mUnderloadedFrameCount = 0;
+    }
+
+    // render only every mInterval-th vsync; a frame arriving more than half a refresh period
+    // before the predicted one would break the cadence, so it is dropped
+    if (appVsync < mNextFrameTime - refreshPeriod / 2) {
+        return false;
+    }
+
+    // resync the prediction on the actual vsync timestamp, so that drift in the display's
+    // refresh rate (or an imprecise DisplayInfo::refreshRate) doesn't accumulate
+    mNextFrameTime = appVsync + mInterval * refreshPeriod;
+    return true;
+}
+
+} // namespace filament
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2016 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_FILAMENT_FRAMEPACER_H
+#define TNT_FILAMENT_FRAMEPACER_H
+
+#include <chrono>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace filament {
+
+/*
+ * FramePacer stabilizes the rendering cadence. FrameSkipper only drops frames once the GPU is
+ * already behind, so a GPU that hovers around one refresh period (e.g. under thermal load)
+ * oscillates between presenting every vsync and every other vsync -- visible 16/33ms judder.
+ * FramePacer instead picks a stable swap interval from the denoised GPU frame time and drops
+ * the frames that would break that cadence, resyncing its vsync prediction on the
+ * application-provided vsync timestamp each frame.
+ */
+class FramePacer {
+public:
+    using clock = std::chrono::steady_clock;
+    using duration = clock::duration;
+    using time_point = clock::time_point;
+
+    /*
+     * Decides whether the frame starting at appVsync should be rendered.
+     *
+     * refreshPeriod is 1 / DisplayInfo::refreshRate; a zero period (offscreen rendering)
+     * disables pacing. frameTime is the denoised GPU frame time of the recent frames, zero if
+     * not yet known. minInterval is FrameRateOptions::interval, the cadence requested by the
+     * application.
+     *
+     * Returns false if this frame must be dropped to preserve a stable cadence; in that case
+     * the next vsync prediction is left unchanged, so the frame landing on the predicted
+     * vsync will proceed.
+     */
+    bool beginFrame(time_point appVsync, duration refreshPeriod, duration frameTime,
+            size_t minInterval) noexcept;
+
+private:
+    // The swap interval is raised as soon as the GPU can't sustain the current cadence, but
+    // only lowered after this many consecutive frames with enough headroom; without this
+    // hysteresis a frame time hovering around the refresh period flip-flops between cadences.
+    static constexpr uint32_t UPGRADE_HYSTERESIS_FRAME_COUNT = 60;
+
+    // headroom applied to the frame time when choosing the swap interval, so that a frame
+    // time just below a multiple of the refresh period doesn't pick an unsustainable cadence
+    static constexpr double HEADROOM = 1.05;
+
+    // pacing beyond a quarter of the refresh rate is indistinguishable from a hitch
+    static constexpr size_t MAX_SWAP_INTERVAL = 4;
+
+    size_t mInterval = 1;                   // current swap interval in refresh periods
+    uint32_t mUnderloadedFrameCount = 0;    // consecutive frames with headroom to spare
+    time_point mNextFrameTime{};            // predicted vsync of the next rendered frame
+};
+
+} // namespace filament
+
+#endif // TNT_FILAMENT_FRAMEPACER_H
@@ -44,6 +44,21 @@ void FrameSkipper::terminate(DriverApi& driver) noexcept {
     }
 }
 
+void FrameSkipper::setLatency(DriverApi& driver, size_t latency) noexcept {
+    latency = std::clamp(latency, size_t(1), MAX_FRAME_LATENCY);
+    if (latency - 1 == mLast) {
+        return;
+    }
+    // drop the fences tracked under the previous policy
+    for (auto& fence : mDelayedFences) {
+        if (fence) {
+            driver.destroyFence(fence);
+            fence = {};
+        }
+    }
+    mLast = uint8_t(latency - 1);
+}
+
 bool FrameSkipper::beginFrame(DriverApi& driver) noexcept {
     auto& fences = mDelayedFences;
     if (fences.front()) {
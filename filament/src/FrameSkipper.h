@@ -41,9 +41,11 @@ class FrameSkipper {
      * A frame latency of 1 has the benefit of reducing render latency,
      * but the drawback of preventing CPU / GPU overlap.
      *
-     * Generally a frame latency of 2 is the best compromise.
+     * Generally a frame latency of 2 is the best compromise, but desktop swap chains can ask
+     * for 3 (see SwapChain frame-latency configuration) to fully pipeline the main thread,
+     * the driver thread and the GPU.
      */
-    static constexpr size_t MAX_FRAME_LATENCY = 2;
+    static constexpr size_t MAX_FRAME_LATENCY = 3;
 public:
     /*
      * The latency parameter defines how many unfinished frames we want to accept before we start
@@ -64,6 +66,10 @@ public:
 
     void terminate(backend::DriverApi& driver) noexcept;
 
+    // Changes the accepted latency, clamped to [1, MAX_FRAME_LATENCY]. Fences tracked under
+    // the previous policy are dropped; the new cap takes effect as new frames are issued.
+    void setLatency(backend::DriverApi& driver, size_t latency) noexcept;
+
     // Returns false if we need to skip this frame, because the GPU is running behind the CPU;
     // In that case, don't call render endFrame()
     // Returns true if rendering can proceed. Always call endFrame() when done.
@@ -74,7 +80,7 @@ public:
 private:
     using Container = std::array<backend::Handle<backend::HwFence>, MAX_FRAME_LATENCY>;
     mutable Container mDelayedFences{};
-    uint8_t const mLast;
+    uint8_t mLast;
 };
 
 } // namespace filament
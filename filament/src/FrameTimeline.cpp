@@ -0,0 +1,216 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FrameTimeline.h"
+
+#include <utils/CString.h>
+#include <utils/FixedCapacityVector.h>
+
+#include <algorithm>
+#include <array>
+#include <string>
+
+#include <stdint.h>
+#include <stdio.h>
+
+namespace filament {
+
+// trace event track identifiers, see the thread_name metadata emitted below
+enum : int {
+    TID_MAIN = 0,           // main thread frame slices
+    TID_BACKEND = 1,        // backend thread slices and present markers
+    TID_GPU = 2,            // whole-frame GPU time
+    TID_GPU_PASSES = 3,     // per-pass GPU times
+    TID_CPU_PASSES = 4,     // per-pass CPU (execute lambda) times
+};
+
+static void appendSlice(std::string& out, const char* name, int tid,
+        int64_t tsNs, int64_t durNs, uint32_t frameId) noexcept {
+    char buf[256];
+    snprintf(buf, sizeof(buf),
+            "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%d,"
+            "\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"frameId\":%u}},\n",
+            name, tid, double(tsNs) * 1e-3, double(durNs) * 1e-3, frameId);
+    out += buf;
+}
+
+static void appendInstant(std::string& out, const char* name, int tid,
+        int64_t tsNs, uint32_t frameId) noexcept {
+    char buf[256];
+    snprintf(buf, sizeof(buf),
+            "{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"pid\":0,\"tid\":%d,"
+            "\"ts\":%.3f,\"args\":{\"frameId\":%u}},\n",
+            name, tid, double(tsNs) * 1e-3, frameId);
+    out += buf;
+}
+
+static void appendThreadName(std::string& out, int tid, const char* name) noexcept {
+    char buf[256];
+    snprintf(buf, sizeof(buf),
+            "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%d,"
+            "\"args\":{\"name\":\"%s\"}},\n",
+            tid, name);
+    out += buf;
+}
+
+void FrameTimeline::addFrameInfo(
+        utils::FixedCapacityVector<Renderer::FrameInfo> const& history) noexcept {
+    // history is ordered newest first, we append oldest first and skip what we've already seen
+    for (size_t i = history.size(); i > 0; --i) {
+        Renderer::FrameInfo const& entry = history[i - 1];
+        if (mHasFrames && int32_t(entry.frameId - mLastFrameId) <= 0) {
+            continue;
+        }
+        if (mFrames.size() == MAX_FRAME_COUNT) {
+            mFrames.pop_front();
+        }
+        mFrames.push_back(entry);
+        mLastFrameId = entry.frameId;
+        mHasFrames = true;
+    }
+}
+
+void FrameTimeline::addPassRecords(
+        std::vector<FrameGraph::Instrumentation::FrameRecord> frames) noexcept {
+    for (auto& frame : frames) {
+        // feed the per-scope rolling windows. A zero GPU time means the query errored out,
+        // don't pollute the statistics with it.
+        for (auto const& record : frame.records) {
+            if (record.culled || record.gpuTimeNs == 0) {
+                continue;
+            }
+            auto pos = std::find_if(mScopes.begin(), mScopes.end(),
+                    [&record](ScopeSamples const& scope) {
+                        return scope.name == record.name;
+                    });
+            if (pos == mScopes.end()) {
+                pos = mScopes.emplace(mScopes.end());
+                pos->name = record.name;
+            }
+            pos->samples[pos->next] = record.gpuTimeNs;
+            pos->next = (pos->next + 1) % MAX_SCOPE_SAMPLES;
+            pos->count = std::min(pos->count + 1, uint32_t(MAX_SCOPE_SAMPLES));
+        }
+        if (mPassFrames.size() == MAX_FRAME_COUNT) {
+            mPassFrames.pop_front();
+        }
+        mPassFrames.push_back(std::move(frame));
+    }
+}
+
+utils::FixedCapacityVector<Renderer::PassStatistics> FrameTimeline::getPassStatistics()
+        const noexcept {
+    auto result = utils::FixedCapacityVector<Renderer::PassStatistics>::with_capacity(
+            mScopes.size());
+    std::array<uint64_t, MAX_SCOPE_SAMPLES> sorted; // NOLINT -- initialized below
+    for (auto const& scope : mScopes) {
+        if (scope.count == 0) {
+            continue;
+        }
+        size_t const count = scope.count;
+        std::copy_n(scope.samples.begin(), count, sorted.begin());
+        std::sort(sorted.begin(), sorted.begin() + count);
+        result.push_back({
+                scope.name,
+                sorted[0],
+                sorted[(count - 1) / 2],
+                sorted[(count - 1) * 95 / 100],
+                uint32_t(count)
+        });
+    }
+    return result;
+}
+
+void FrameTimeline::clear() noexcept {
+    mFrames.clear();
+    mPassFrames.clear();
+    mScopes.clear();
+    mHasFrames = false;
+    mLastFrameId = 0;
+}
+
+utils::CString FrameTimeline::exportChromeTrace() const noexcept {
+    std::string out;
+    out.reserve(4096 + 256 * mFrames.size());
+    out += "{\"traceEvents\":[\n";
+
+    out += "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,"
+           "\"args\":{\"name\":\"filament\"}},\n";
+    appendThreadName(out, TID_MAIN, "main thread");
+    appendThreadName(out, TID_BACKEND, "backend thread");
+    appendThreadName(out, TID_GPU, "gpu");
+    appendThreadName(out, TID_GPU_PASSES, "gpu passes");
+    appendThreadName(out, TID_CPU_PASSES, "cpu passes");
+
+    for (auto const& frame : mFrames) {
+        appendSlice(out, "frame", TID_MAIN,
+                frame.beginFrame, frame.endFrame - frame.beginFrame, frame.frameId);
+        appendSlice(out, "backend", TID_BACKEND,
+                frame.backendBeginFrame, frame.backendEndFrame - frame.backendBeginFrame,
+                frame.frameId);
+        appendInstant(out, "present", TID_BACKEND, frame.backendEndFrame, frame.frameId);
+        // the backend doesn't report when the GPU started working on the frame, so the GPU
+        // slice is anchored at the backend's frame begin time
+        appendSlice(out, "gpu", TID_GPU,
+                frame.backendBeginFrame, frame.frameTime, frame.frameId);
+    }
+
+    uint32_t prevFrameId = 0;
+    int64_t gpuTs = 0;
+    int64_t cpuTs = 0;
+    bool hasPrev = false;
+    for (auto const& passFrame : mPassFrames) {
+        // A frame rendering several views produces one record set per view; they share a
+        // frameId and continue laying out slices where the previous set stopped.
+        if (!hasPrev || passFrame.frameId != prevFrameId) {
+            // find the frame this record belongs to, for its anchor times
+            Renderer::FrameInfo const* info = nullptr;
+            for (auto const& frame : mFrames) {
+                if (frame.frameId == passFrame.frameId) {
+                    info = &frame;
+                    break;
+                }
+            }
+            if (!info) {
+                continue;
+            }
+            gpuTs = info->backendBeginFrame;
+            cpuTs = info->beginFrame;
+            prevFrameId = passFrame.frameId;
+            hasPrev = true;
+        }
+        for (auto const& record : passFrame.records) {
+            if (record.culled) {
+                continue;
+            }
+            appendSlice(out, record.name.c_str(), TID_GPU_PASSES,
+                    gpuTs, int64_t(record.gpuTimeNs), passFrame.frameId);
+            appendSlice(out, record.name.c_str(), TID_CPU_PASSES,
+                    cpuTs, int64_t(record.cpuTimeNs), passFrame.frameId);
+            gpuTs += int64_t(record.gpuTimeNs);
+            cpuTs += int64_t(record.cpuTimeNs);
+        }
+    }
+
+    // remove the trailing ",\n" to produce valid JSON
+    if (out.size() >= 2 && out[out.size() - 2] == ',') {
+        out.erase(out.size() - 2, 1);
+    }
+    out += "]}\n";
+    return utils::CString{ out.data(), out.size() };
+}
+
+} // namespace filament
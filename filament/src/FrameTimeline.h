@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_FILAMENT_FRAMETIMELINE_H
+#define TNT_FILAMENT_FRAMETIMELINE_H
+
+#include "fg/FrameGraph.h"
+
+#include <filament/Renderer.h>
+
+#include <utils/CString.h>
+#include <utils/FixedCapacityVector.h>
+
+#include <array>
+#include <deque>
+#include <vector>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace filament {
+
+/*
+ * Keeps a ring buffer of per-frame timing information -- main thread begin/end, backend thread
+ * begin/present, GPU frame time and per-pass CPU/GPU times from the frame graph instrumentation --
+ * and can serialize it as Chrome trace JSON ("traceEvents" array format), loadable in
+ * chrome://tracing or Perfetto. This is designed to be cheap enough to leave enabled in
+ * production builds so that stutters can be captured in the field.
+ *
+ * Pass slices only carry durations (the backend doesn't report absolute GPU timestamps), so in
+ * the exported trace they are laid out end-to-end from the start of their frame; gaps between
+ * passes are not represented.
+ */
+class FrameTimeline {
+public:
+    // how many frames the timeline retains, a few seconds at 60Hz
+    static constexpr size_t MAX_FRAME_COUNT = 256;
+
+    // Appends resolved FrameInfo entries; entries already recorded (by frameId) are skipped.
+    // The history is expected to be ordered newest first, as returned by
+    // FrameInfoManager::getFrameInfoHistory().
+    void addFrameInfo(utils::FixedCapacityVector<Renderer::FrameInfo> const& history) noexcept;
+
+    // appends per-pass records collected from FrameGraph::Instrumentation::takeResolvedFrames()
+    void addPassRecords(std::vector<FrameGraph::Instrumentation::FrameRecord> frames) noexcept;
+
+    // serializes the recorded timeline as Chrome trace JSON
+    utils::CString exportChromeTrace() const noexcept;
+
+    // rolling min/p50/p95 of the GPU time of each named pass, over the last
+    // MAX_SCOPE_SAMPLES samples of that pass
+    utils::FixedCapacityVector<Renderer::PassStatistics> getPassStatistics() const noexcept;
+
+    void clear() noexcept;
+
+private:
+    // how many samples each pass statistic is computed over
+    static constexpr size_t MAX_SCOPE_SAMPLES = 64;
+
+    // rolling window of GPU times for one named pass
+    struct ScopeSamples {
+        utils::CString name;
+        std::array<uint64_t, MAX_SCOPE_SAMPLES> samples;    // ring buffer
+        uint32_t next = 0;
+        uint32_t count = 0;
+    };
+
+    std::deque<Renderer::FrameInfo> mFrames;
+    std::deque<FrameGraph::Instrumentation::FrameRecord> mPassFrames;
+    std::vector<ScopeSamples> mScopes;
+    uint32_t mLastFrameId = 0;
+    bool mHasFrames = false;
+};
+
+} // namespace filament
+
+#endif // TNT_FILAMENT_FRAMETIMELINE_H
@@ -26,6 +26,7 @@
 #include <filament/Viewport.h>
 
 #include <utils/BinaryTreeArray.h>
+#include <utils/Hash.h>
 #include <utils/Log.h>
 #include <utils/Systrace.h>
 #include <utils/debug.h>
@@ -66,6 +67,8 @@ static constexpr size_t LIGHT_PER_GROUP = sizeof(Froxelizer::LightGroupType) * 8
 static constexpr size_t GROUP_COUNT =
         (CONFIG_MAX_LIGHT_COUNT + LIGHT_PER_GROUP - 1) / LIGHT_PER_GROUP;
 
+static_assert(GROUP_COUNT == Froxelizer::LIGHT_GROUP_COUNT);
+
 // This depends on the maximum number of lights (currently 256)
 static_assert(CONFIG_MAX_LIGHT_INDEX <= std::numeric_limits<Froxelizer::RecordBufferType>::max(),
         "can't have more than 256 lights");
@@ -115,11 +118,15 @@ Froxelizer::Froxelizer(FEngine& engine)
             FROXEL_BUFFER_MAX_ENTRY_COUNT,
             engine.getDriverApi().getMaxUniformBufferSize() / 16u);
 
-    mRecordsBuffer = driverApi.createBufferObject(RECORD_BUFFER_ENTRY_COUNT,
-            BufferObjectBinding::UNIFORM, BufferUsage::DYNAMIC);
+    // the froxel/record buffers are double-buffered so commit() can upload frame N's data
+    // while the driver still consumes frame N-1's (see commit())
+    for (size_t i = 0; i < 2; i++) {
+        mRecordsBuffer[i] = driverApi.createBufferObject(RECORD_BUFFER_ENTRY_COUNT,
+                BufferObjectBinding::UNIFORM, BufferUsage::DYNAMIC);
 
-    mFroxelsBuffer = driverApi.createBufferObject(getFroxelBufferEntryCount() * 16u,
-            BufferObjectBinding::UNIFORM, BufferUsage::DYNAMIC);
+        mFroxelsBuffer[i] = driverApi.createBufferObject(getFroxelBufferEntryCount() * 16u,
+                BufferObjectBinding::UNIFORM, BufferUsage::DYNAMIC);
+    }
 }
 
 Froxelizer::~Froxelizer() {
@@ -135,11 +142,13 @@ void Froxelizer::terminate(DriverApi& driverApi) noexcept {
     mPlanesX = nullptr;
     mDistancesZ = nullptr;
 
-    if (mRecordsBuffer) {
-        driverApi.destroyBufferObject(mRecordsBuffer);
-    }
-    if (mFroxelsBuffer) {
-        driverApi.destroyBufferObject(mFroxelsBuffer);
+    for (size_t i = 0; i < 2; i++) {
+        if (mRecordsBuffer[i]) {
+            driverApi.destroyBufferObject(mRecordsBuffer[i]);
+        }
+        if (mFroxelsBuffer[i]) {
+            driverApi.destroyBufferObject(mFroxelsBuffer[i]);
+        }
     }
 }
 
@@ -325,6 +334,9 @@ void Froxelizer::updateBoundingSpheres(
 UTILS_NOINLINE
 bool Froxelizer::update() noexcept {
     bool uniformsNeedUpdating = false;
+    // the froxel grid is changing, whatever the GPU buffers contain is stale
+    mFroxelizedLightsHash = 0;
+    mFroxelizedLightsHashValid = false;
     if (UTILS_UNLIKELY(mDirtyFlags & VIEWPORT_CHANGED)) {
         filament::Viewport const& viewport = mViewport;
 
@@ -502,27 +514,88 @@ std::pair<size_t, size_t> Froxelizer::clipToIndices(float2 const& clip) const no
 }
 
 
-void Froxelizer::commit(backend::DriverApi& driverApi) {
+bool Froxelizer::commit(backend::DriverApi& driverApi) {
+    if (!mCommitNeeded) {
+        // froxelizeLights() determined that the GPU buffers already hold the correct
+        // froxelization for this frame, nothing to upload
+        return false;
+    }
+    mCommitNeeded = false;
+
+    // Upload into the buffer set the GPU isn't reading from: the previous frame's draws may
+    // still be in flight, and writing their buffers would force the driver to stall or
+    // internally rename them. The data itself was produced directly into command-stream
+    // memory by froxelizeLights() on a worker thread, so this only enqueues the upload.
+    mBufferIndex = 1u - mBufferIndex;
+
     // send data to GPU
-    driverApi.updateBufferObject(mFroxelsBuffer,
+    driverApi.updateBufferObject(mFroxelsBuffer[mBufferIndex],
             { mFroxelBufferUser.data(), getFroxelBufferEntryCount() * 16u }, 0);
 
-    driverApi.updateBufferObject(mRecordsBuffer,
-            { mRecordBufferUser.data(), RECORD_BUFFER_ENTRY_COUNT }, 0);
+    // Upload only the portion of the record buffer written this frame. Thanks to record sharing
+    // between identical froxels this is usually a small fraction of the full buffer; we round up
+    // to a 256-byte multiple to keep the copy aligned.
+    size_t const recordsSize = std::min(size_t(RECORD_BUFFER_ENTRY_COUNT),
+            (size_t(mRecordBufferUsed) + 255u) & ~size_t(255u));
+    if (recordsSize) {
+        driverApi.updateBufferObject(mRecordsBuffer[mBufferIndex],
+                { mRecordBufferUser.data(), recordsSize }, 0);
+    }
 
 #ifndef NDEBUG
     mFroxelBufferUser.clear();
     mRecordBufferUser.clear();
     mFroxelShardedData.clear();
 #endif
+    return true;
+}
+
+// hash of everything the froxelization result depends on, besides the froxel grid itself:
+// the view transform, the light set and each light's froxelization-relevant parameters
+static uint32_t computeFroxelizedLightsHash(FLightManager const& lcm,
+        mat4f const& viewMatrix, const FScene::LightSoa& lightData) noexcept {
+    size_t const count = lightData.size();
+    uint32_t h = hash::murmur3(reinterpret_cast<uint32_t const*>(&viewMatrix),
+            sizeof(mat4f) / 4, uint32_t(count));
+    if (count > FScene::DIRECTIONAL_LIGHTS_COUNT) {
+        size_t const c = count - FScene::DIRECTIONAL_LIGHTS_COUNT;
+        auto const* spheres    = lightData.data<FScene::POSITION_RADIUS>() + FScene::DIRECTIONAL_LIGHTS_COUNT;
+        auto const* directions = lightData.data<FScene::DIRECTION>()       + FScene::DIRECTIONAL_LIGHTS_COUNT;
+        auto const* instances  = lightData.data<FScene::LIGHT_INSTANCE>()  + FScene::DIRECTIONAL_LIGHTS_COUNT;
+        h = hash::murmur3(reinterpret_cast<uint32_t const*>(spheres),    c * 4, h);
+        h = hash::murmur3(reinterpret_cast<uint32_t const*>(directions), c * 3, h);
+        for (size_t i = 0; i < c; i++) {
+            // cone parameters live in the light manager, not in LightSoa
+            float const params[2] = {
+                    lcm.getCosOuterSquared(instances[i]),
+                    lcm.getSinInverse(instances[i]) };
+            h = hash::murmur3(reinterpret_cast<uint32_t const*>(params), 2, h);
+        }
+    }
+    return h;
 }
 
 void Froxelizer::froxelizeLights(FEngine& engine,
         mat4f const& UTILS_RESTRICT viewMatrix,
         const FScene::LightSoa& UTILS_RESTRICT lightData) noexcept {
     // note: this is called asynchronously
+
+    // dirty tracking: with a static light set and camera -- the common case in
+    // walkthroughs -- the previous frame's froxelization (still resident in the GPU
+    // buffers) is exactly what we would recompute, so skip the rebuild and the upload.
+    uint32_t const hash = computeFroxelizedLightsHash(
+            engine.getLightManager(), viewMatrix, lightData);
+    if (mFroxelizedLightsHashValid && hash == mFroxelizedLightsHash) {
+        mCommitNeeded = false;
+        return;
+    }
+
     froxelizeLoop(engine, viewMatrix, lightData);
-    froxelizeAssignRecordsCompress();
+    froxelizeAssignRecordsCompress(engine);
+
+    mFroxelizedLightsHash = hash;
+    mFroxelizedLightsHashValid = true;
+    mCommitNeeded = true;
 
 #ifndef NDEBUG
     if (lightData.size()) {
@@ -548,19 +621,66 @@ void Froxelizer::froxelizeLights(FEngine& engine,
 #endif
 }
 
+// hash of the froxelization-relevant parameters of the lights belonging to one group
+// (group g froxelizes lights g, g + GROUP_COUNT, ...)
+static uint32_t computeLightGroupHash(FLightManager const& lcm,
+        const FScene::LightSoa& lightData, size_t const group) noexcept {
+    size_t const count = lightData.size() - FScene::DIRECTIONAL_LIGHTS_COUNT;
+    auto const* spheres    = lightData.data<FScene::POSITION_RADIUS>();
+    auto const* directions = lightData.data<FScene::DIRECTION>();
+    auto const* instances  = lightData.data<FScene::LIGHT_INSTANCE>();
+    uint32_t h = uint32_t(count);
+    for (size_t i = group; i < count; i += GROUP_COUNT) {
+        size_t const j = i + FScene::DIRECTIONAL_LIGHTS_COUNT;
+        float const params[9] = {
+                spheres[j].x, spheres[j].y, spheres[j].z, spheres[j].w,
+                directions[j].x, directions[j].y, directions[j].z,
+                lcm.getCosOuterSquared(instances[j]),
+                lcm.getSinInverse(instances[j]) };
+        h = hash::murmur3(reinterpret_cast<uint32_t const*>(params), 9, h);
+    }
+    return h;
+}
+
 void Froxelizer::froxelizeLoop(FEngine& engine,
         const mat4f& UTILS_RESTRICT viewMatrix,
         const FScene::LightSoa& UTILS_RESTRICT lightData) noexcept {
     SYSTRACE_CALL();
 
     Slice<FroxelThreadData> froxelThreadData = mFroxelShardedData;
-    memset(froxelThreadData.data(), 0, froxelThreadData.sizeInBytes());
 
     auto& lcm = engine.getLightManager();
     auto const* UTILS_RESTRICT spheres      = lightData.data<FScene::POSITION_RADIUS>();
     auto const* UTILS_RESTRICT directions   = lightData.data<FScene::DIRECTION>();
     auto const* UTILS_RESTRICT instances    = lightData.data<FScene::LIGHT_INSTANCE>();
 
+    // Per-group dirty tracking: when the camera and froxel grid are unchanged, a group
+    // whose lights didn't change would recompute exactly the masks it produced last
+    // frame, so it reuses them from the cache instead. In mostly-static scenes only the
+    // groups containing a moving light pay the geometric froxelization cost below.
+    if (UTILS_UNLIKELY(!mGroupCache)) {
+        mGroupCache = std::make_unique<FroxelThreadData[]>(GROUP_COUNT);
+    }
+    uint32_t cameraHash = hash::murmur3(
+            reinterpret_cast<uint32_t const*>(&viewMatrix), sizeof(mat4f) / 4, 0);
+    cameraHash = hash::murmur3(
+            reinterpret_cast<uint32_t const*>(&mProjection), sizeof(mat4f) / 4, cameraHash);
+    // the froxel grid can change without the projection changing (e.g. viewport resize)
+    uint32_t const grid[2] = { uint32_t(mFroxelCountX) | (uint32_t(mFroxelCountY) << 16u),
+                               uint32_t(mFroxelCountZ) };
+    cameraHash = hash::murmur3(grid, 2, cameraHash);
+    if (cameraHash != mGroupCameraHash) {
+        mGroupCameraHash = cameraHash;
+        mGroupCacheValid = false;
+    }
+    bool groupDirty[GROUP_COUNT];
+    for (size_t i = 0; i < GROUP_COUNT; i++) {
+        uint32_t const h = computeLightGroupHash(lcm, lightData, i);
+        groupDirty[i] = !mGroupCacheValid || h != mGroupHash[i];
+        mGroupHash[i] = h;
+    }
+    mGroupCacheValid = true;
+
     auto process = [ this, &froxelThreadData,
                      spheres, directions, instances, &viewMatrix, &lcm ]
             (size_t count, size_t offset, size_t stride) {
@@ -602,49 +722,93 @@ void Froxelizer::froxelizeLoop(FEngine& engine,
     // we do 64 lights per job
     JobSystem& js = engine.getJobSystem();
 
+    size_t const lightCount = lightData.size() - FScene::DIRECTIONAL_LIGHTS_COUNT;
+
     constexpr bool SINGLE_THREADED = false;
     if (!SINGLE_THREADED) {
         auto *parent = js.createJob();
         for (size_t i = 0; i < GROUP_COUNT; i++) {
-            js.run(jobs::createJob(js, parent, std::cref(process),
-                    lightData.size() - FScene::DIRECTIONAL_LIGHTS_COUNT, i, GROUP_COUNT));
+            if (groupDirty[i]) {
+                memset(froxelThreadData[i].data(), 0, sizeof(FroxelThreadData));
+                js.run(jobs::createJob(js, parent, std::cref(process),
+                        lightCount, i, GROUP_COUNT));
+            }
+        }
+        // meanwhile, unchanged groups reuse last frame's masks
+        for (size_t i = 0; i < GROUP_COUNT; i++) {
+            if (!groupDirty[i]) {
+                froxelThreadData[i] = mGroupCache[i];
+            }
         }
         js.runAndWait(parent);
     } else {
-        js.runAndWait(jobs::createJob(js, nullptr, std::cref(process),
-                lightData.size() - FScene::DIRECTIONAL_LIGHTS_COUNT, 0, 1)
-        );
+        for (size_t i = 0; i < GROUP_COUNT; i++) {
+            if (groupDirty[i]) {
+                memset(froxelThreadData[i].data(), 0, sizeof(FroxelThreadData));
+                process(lightCount, i, GROUP_COUNT);
+            } else {
+                froxelThreadData[i] = mGroupCache[i];
+            }
+        }
+    }
+
+    // update the cache with the groups we just recomputed
+    for (size_t i = 0; i < GROUP_COUNT; i++) {
+        if (groupDirty[i]) {
+            mGroupCache[i] = froxelThreadData[i];
+        }
     }
 }
 
-void Froxelizer::froxelizeAssignRecordsCompress() noexcept {
+void Froxelizer::froxelizeAssignRecordsCompress(FEngine& engine) noexcept {
 
     SYSTRACE_CALL();
 
     Slice<FroxelThreadData> const froxelThreadData = mFroxelShardedData;
 
     // convert froxel data from N groups of M bits to LightRecord::bitset, so we can
-    // easily compare adjacent froxels, for compaction. The conversion loops below get
+    // easily compare adjacent froxels, for compaction. Froxel entries are independent,
+    // so the conversion is sliced across JobSystem workers; each slice also computes a
+    // partial "all lights" mask which is OR-merged below. The conversion loops get
     // inlined and vectorized in release builds.
 
-    // this gets very well vectorized...
-
     utils::Slice<LightRecord> records(mLightRecords);
-    for (size_t j = 0, jc = getFroxelBufferEntryCount(); j < jc; j++) {
-        for (size_t i = 0; i < LightRecord::bitset::WORLD_COUNT; i++) {
-            using container_type = LightRecord::bitset::container_type;
-            constexpr size_t r = sizeof(container_type) / sizeof(LightGroupType);
-            container_type b = froxelThreadData[i * r][j];
-            for (size_t k = 0; k < r; k++) {
-                b |= (container_type(froxelThreadData[i * r + k][j]) << (LIGHT_PER_GROUP * k));
+
+    constexpr size_t JOB_COUNT = 8;
+    LightRecord::bitset partialLightSets[JOB_COUNT]{};
+
+    auto convert = [froxelThreadData, &records, &partialLightSets,
+                    jc = getFroxelBufferEntryCount()](size_t const job) {
+        SYSTRACE_NAME("FroxelizeConvert Job");
+        size_t const sliceSize = (jc + JOB_COUNT - 1) / JOB_COUNT;
+        size_t const begin = job * sliceSize;
+        size_t const end = std::min(begin + sliceSize, jc);
+        LightRecord::bitset sliceLights{};
+        for (size_t j = begin; j < end; j++) {
+            for (size_t i = 0; i < LightRecord::bitset::WORLD_COUNT; i++) {
+                using container_type = LightRecord::bitset::container_type;
+                constexpr size_t r = sizeof(container_type) / sizeof(LightGroupType);
+                container_type b = froxelThreadData[i * r][j];
+                for (size_t k = 0; k < r; k++) {
+                    b |= (container_type(froxelThreadData[i * r + k][j]) << (LIGHT_PER_GROUP * k));
+                }
+                records[j].lights.getBitsAt(i) = b;
             }
-            records[j].lights.getBitsAt(i) = b;
+            sliceLights |= records[j].lights;
         }
+        partialLightSets[job] = sliceLights;
+    };
+
+    JobSystem& js = engine.getJobSystem();
+    auto* parent = js.createJob();
+    for (size_t i = 0; i < JOB_COUNT; i++) {
+        js.run(jobs::createJob(js, parent, std::cref(convert), i));
     }
+    js.runAndWait(parent);
 
     LightRecord::bitset allLights{};
-    for (size_t j = 0, jc = getFroxelBufferEntryCount(); j < jc; j++) {
-        allLights |= records[j].lights;
+    for (auto const& partial : partialLightSets) {
+        allLights |= partial;
     }
 
     uint16_t offset = 0;
@@ -657,16 +821,17 @@ void Froxelizer::froxelizeAssignRecordsCompress() noexcept {
     // we run out of record space.
     const uint8_t allLightsCount = (uint8_t)std::min(size_t(255), allLights.count());
     offset += allLightsCount;
-    allLights.forEachSetBit([point = froxelRecords, froxelRecords](size_t l) mutable {
-        // make sure to keep this code branch-less
+    // compact the raw bit indices in bulk, then remap them in place to the interleaved
+    // group encoding -- the remap loop is branch-less and vectorizes.
+    // gatherSetBits() is clamped to 255 entries because of the data type used to store
+    // the light counts per froxel.
+    size_t const allLightsRecordCount = allLights.gatherSetBits(froxelRecords, 255);
+    for (size_t j = 0; j < allLightsRecordCount; j++) {
+        const size_t l = froxelRecords[j];
         const size_t word = l / LIGHT_PER_GROUP;
         const size_t bit  = l % LIGHT_PER_GROUP;
-        l = (bit * GROUP_COUNT) | (word % GROUP_COUNT);
-        *point = (RecordBufferType)l;
-        // we need to "cancel" the write operation if we have more than 255 spot or point lights
-        // (this is a limitation of the data type used to store the light counts per froxel)
-        point += (point - froxelRecords < 255) ? 1 : 0;
-    });
+        froxelRecords[j] = RecordBufferType((bit * GROUP_COUNT) | (word % GROUP_COUNT));
+    }
 
     // how many froxel record entries were reused (for debugging)
     UTILS_UNUSED size_t reused = 0;
@@ -695,21 +860,19 @@ void Froxelizer::froxelizeAssignRecordsCompress() noexcept {
                     froxels[i].u32 = 0;
                 }
             } while(++i < c);
+            mRecordBufferOverflowCount++;
             goto out_of_memory;
         }
 
-        // iterate the bitfield
-        auto * const beginPoint = froxelRecords + offset;
-        b.lights.forEachSetBit([point = beginPoint, beginPoint](size_t l) mutable {
-            // make sure to keep this code branch-less
+        // compact the bitfield into the record buffer, then remap in place (see above)
+        auto* const UTILS_RESTRICT beginPoint = froxelRecords + offset;
+        size_t const recordCount = b.lights.gatherSetBits(beginPoint, 255);
+        for (size_t j = 0; j < recordCount; j++) {
+            const size_t l = beginPoint[j];
             const size_t word = l / LIGHT_PER_GROUP;
             const size_t bit  = l % LIGHT_PER_GROUP;
-            l = (bit * GROUP_COUNT) | (word % GROUP_COUNT);
-            *point = (RecordBufferType)l;
-            // we need to "cancel" the write operation if we have more than 255 spot or point lights
-            // (this is a limitation of the data type used to store the light counts per froxel)
-            point += (point - beginPoint < 255) ? 1 : 0;
-        });
+            beginPoint[j] = RecordBufferType((bit * GROUP_COUNT) | (word % GROUP_COUNT));
+        }
 
         offset += lightCount;
 
@@ -734,7 +897,10 @@ void Froxelizer::froxelizeAssignRecordsCompress() noexcept {
     }
 out_of_memory:
     // FIXME: on big-endian systems we need to change the endianness of the record buffer
-    ;
+
+    // remember how much of the record buffer was actually written; froxel entries never
+    // reference anything past this point, so commit() only needs to upload that much
+    mRecordBufferUsed = offset;
 }
 
 static inline float2 project(mat4f const& p, float3 const& v) noexcept {
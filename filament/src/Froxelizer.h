@@ -33,6 +33,9 @@
 #include <math/mat4.h>
 #include <math/vec4.h>
 
+#include <array>
+#include <memory>
+
 namespace filament {
 
 // Max number of froxels limited by:
@@ -86,14 +89,16 @@ public:
 
     void terminate(backend::DriverApi& driverApi) noexcept;
 
-    // gpu buffer containing records. valid after construction.
+    // gpu buffer containing records. valid after construction. the returned handle changes
+    // whenever commit() uploads new data (see commit()), so it must be re-bound then.
     backend::Handle<backend::HwBufferObject> getRecordBuffer() const noexcept {
-        return mRecordsBuffer;
+        return mRecordsBuffer[mBufferIndex];
     }
 
-    // gpu buffer containing froxels. valid after construction.
+    // gpu buffer containing froxels. valid after construction. the returned handle changes
+    // whenever commit() uploads new data (see commit()), so it must be re-bound then.
     backend::Handle<backend::HwBufferObject> getFroxelBuffer() const noexcept {
-        return mFroxelsBuffer;
+        return mFroxelsBuffer[mBufferIndex];
     }
 
     void setOptions(float zLightNear, float zLightFar) noexcept;
@@ -121,6 +126,12 @@ public:
 
     float getLightFar() const noexcept { return mZLightFar; }
 
+    // telemetry: bytes of the record buffer written by the last froxelizeLights() call
+    uint32_t getRecordBufferUsed() const noexcept { return mRecordBufferUsed; }
+
+    // telemetry: number of frames so far whose light records didn't fit in the record buffer
+    uint32_t getRecordBufferOverflowCount() const noexcept { return mRecordBufferOverflowCount; }
+
     // update Records and Froxels texture with lights data. this is thread-safe.
     void froxelizeLights(FEngine& engine, math::mat4f const& viewMatrix,
             const FScene::LightSoa& lightData) noexcept;
@@ -131,8 +142,12 @@ public:
         s.froxelCountXY = math::float2{ mViewport.width, mViewport.height } / mFroxelDimension;
     }
 
-    // send froxel data to GPU
-    void commit(backend::DriverApi& driverApi);
+    // Send froxel data to GPU. The froxel/record buffers are double-buffered: each upload goes
+    // into the set the GPU isn't currently reading from, so the driver never has to stall or
+    // rename a buffer that frame N-1's draws still consume. Returns true when new data was
+    // uploaded, i.e. when getRecordBuffer()/getFroxelBuffer() now return different handles
+    // that the caller must re-bind.
+    bool commit(backend::DriverApi& driverApi);
 
 
     /*
@@ -157,6 +172,11 @@ public:
     // with 256 lights this implies 8 jobs (256 / 32) for froxelization.
     using LightGroupType = uint32_t;
 
+    // number of 32-light groups froxelization is sliced into (see LightGroupType)
+    static constexpr size_t LIGHT_GROUP_COUNT =
+            (CONFIG_MAX_LIGHT_COUNT + sizeof(LightGroupType) * 8 - 1) /
+            (sizeof(LightGroupType) * 8);
+
 private:
     size_t getFroxelBufferEntryCount() const noexcept {
         return mFroxelBufferEntryCount;
@@ -198,7 +218,7 @@ private:
     void froxelizeLoop(FEngine& engine,
             math::mat4f const& viewMatrix, const FScene::LightSoa& lightData) noexcept;
 
-    void froxelizeAssignRecordsCompress() noexcept;
+    void froxelizeAssignRecordsCompress(FEngine& engine) noexcept;
 
     void froxelizePointAndSpotLight(FroxelThreadData& froxelThread, size_t bit,
             math::mat4f const& projection, const LightParams& light) const noexcept;
@@ -255,14 +275,17 @@ private:
     uint16_t mFroxelCountY = 0;
     uint16_t mFroxelCountZ = 0;
     uint32_t mFroxelCount = 0;
+    uint32_t mRecordBufferUsed = 0; // bytes of the record buffer written this frame
+    uint32_t mRecordBufferOverflowCount = 0; // frames whose records overflowed, since creation
     math::uint2 mFroxelDimension = {};
 
     math::mat4f mProjection;
     float mLinearizer = 0.0f;
     float mClipToFroxelX = 0.0f;
     float mClipToFroxelY = 0.0f;
-    backend::BufferObjectHandle mRecordsBuffer;
-    backend::BufferObjectHandle mFroxelsBuffer;
+    backend::BufferObjectHandle mRecordsBuffer[2];
+    backend::BufferObjectHandle mFroxelsBuffer[2];
+    uint32_t mBufferIndex = 0;
 
     // needed for update()
     Viewport mViewport;
@@ -272,6 +295,23 @@ private:
     float mZLightNear;
     float mZLightFar;
 
+    // dirty tracking for incremental froxelization: hash of the inputs used to build
+    // the froxel/record data currently resident in the GPU buffers
+    uint32_t mFroxelizedLightsHash = 0;
+    bool mFroxelizedLightsHashValid = false;
+
+    // Cache of each light group's froxel masks from the previous frame, along with the
+    // hash of the group's light parameters. When the camera is unchanged, groups whose
+    // lights didn't move reuse their cached masks and only the groups containing a
+    // modified light pay the geometric froxelization cost. ~256 KiB, allocated on first
+    // use (i.e. only when the scene has punctual lights).
+    std::unique_ptr<FroxelThreadData[]> mGroupCache;
+    std::array<uint32_t, LIGHT_GROUP_COUNT> mGroupHash{};
+    uint32_t mGroupCameraHash = 0;
+    bool mGroupCacheValid = false;
+    // whether commit() has anything new to upload
+    bool mCommitNeeded = true;
+
     // track if we need to update our internal state before froxelizing
     uint8_t mDirtyFlags = 0;
     enum {
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2025 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "GpuMemoryTracker.h"
+
+#include <utils/compiler.h>
+#include <utils/debug.h>
+
+namespace filament {
+
+uint64_t GpuMemoryTracker::Counter::add(uint64_t bytes) noexcept {
+    uint64_t const now = current.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    uint64_t max = peak.load(std::memory_order_relaxed);
+    while (now > max && !peak.compare_exchange_weak(max, now, std::memory_order_relaxed)) {
+    }
+    return now;
+}
+
+void GpuMemoryTracker::Counter::sub(uint64_t bytes) noexcept {
+    assert_invariant(current.load(std::memory_order_relaxed) >= bytes);
+    current.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+Engine::MemoryUsage GpuMemoryTracker::Counter::get() const noexcept {
+    return { current.load(std::memory_order_relaxed), peak.load(std::memory_order_relaxed) };
+}
+
+void GpuMemoryTracker::track(Category category, uint64_t bytes) noexcept {
+    assert_invariant(category < Category::COUNT);
+
+    // fire the budget callback before accounting, so the application gets a chance to release
+    // resources while it still knows the allocation that triggered the crossing
+    uint64_t const budget = mBudgetBytes.load(std::memory_order_relaxed);
+    if (UTILS_UNLIKELY(budget)) {
+        uint64_t const total = mTotal.current.load(std::memory_order_relaxed);
+        if (total + bytes > budget) {
+            // edge-triggered: fire once per crossing
+            if (!mBudgetExceeded.exchange(true, std::memory_order_relaxed) && mCallback) {
+                mCallback(mUser, total + bytes, budget);
+            }
+        }
+    }
+
+    mCategories[size_t(category)].add(bytes);
+    mTotal.add(bytes);
+}
+
+void GpuMemoryTracker::release(Category category, uint64_t bytes) noexcept {
+    assert_invariant(category < Category::COUNT);
+    mCategories[size_t(category)].sub(bytes);
+    uint64_t const total = mTotal.current.load(std::memory_order_relaxed) - bytes;
+    mTotal.sub(bytes);
+    uint64_t const budget = mBudgetBytes.load(std::memory_order_relaxed);
+    if (UTILS_UNLIKELY(budget) && total <= budget) {
+        // re-arm the budget callback once usage drops below the budget
+        mBudgetExceeded.store(false, std::memory_order_relaxed);
+    }
+}
+
+Engine::MemoryUsage GpuMemoryTracker::getUsage(Category category) const noexcept {
+    assert_invariant(category < Category::COUNT);
+    return mCategories[size_t(category)].get();
+}
+
+Engine::MemoryUsage GpuMemoryTracker::getTotalUsage() const noexcept {
+    return mTotal.get();
+}
+
+void GpuMemoryTracker::setBudget(uint64_t budgetBytes, Engine::MemoryBudgetCallback callback,
+        void* user) noexcept {
+    mCallback = callback;
+    mUser = user;
+    mBudgetExceeded.store(false, std::memory_order_relaxed);
+    mBudgetBytes.store(budgetBytes, std::memory_order_relaxed);
+}
+
+} // namespace filament
@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2025 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_FILAMENT_GPUMEMORYTRACKER_H
+#define TNT_FILAMENT_GPUMEMORYTRACKER_H
+
+#include <filament/Engine.h>
+
+#include <atomic>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace filament {
+
+/**
+ * Tracks an estimate of the GPU memory held by the engine's resources, by category.
+ *
+ * Sizes are estimated on the user thread from resource dimensions and formats (the backends
+ * never report their true allocations back), so the numbers are a lower bound. Counters are
+ * atomic because the render-pass texture cache can allocate while the application creates
+ * resources from another thread.
+ */
+class GpuMemoryTracker {
+public:
+    using Category = Engine::MemoryCategory;
+
+    // Accounts for a new allocation. Fires the budget callback first if this allocation pushes
+    // the total above the configured budget.
+    void track(Category category, uint64_t bytes) noexcept;
+
+    // Accounts for a freed allocation. `bytes` must match what was passed to track().
+    void release(Category category, uint64_t bytes) noexcept;
+
+    Engine::MemoryUsage getUsage(Category category) const noexcept;
+    Engine::MemoryUsage getTotalUsage() const noexcept;
+
+    // A budget of 0 disables the callback.
+    void setBudget(uint64_t budgetBytes, Engine::MemoryBudgetCallback callback,
+            void* user) noexcept;
+
+private:
+    struct Counter {
+        std::atomic<uint64_t> current{ 0 };
+        std::atomic<uint64_t> peak{ 0 };
+        uint64_t add(uint64_t bytes) noexcept;
+        void sub(uint64_t bytes) noexcept;
+        Engine::MemoryUsage get() const noexcept;
+    };
+
+    Counter mCategories[size_t(Category::COUNT)];
+    Counter mTotal;
+
+    std::atomic<uint64_t> mBudgetBytes{ 0 };
+    std::atomic<bool> mBudgetExceeded{ false };
+    Engine::MemoryBudgetCallback mCallback = nullptr;
+    void* mUser = nullptr;
+};
+
+} // namespace filament
+
+#endif // TNT_FILAMENT_GPUMEMORYTRACKER_H
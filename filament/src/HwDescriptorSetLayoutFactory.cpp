@@ -39,6 +39,11 @@ using namespace utils;
 using namespace backend;
 
 size_t HwDescriptorSetLayoutFactory::Parameters::hash() const noexcept {
+    if (precomputedHash) {
+        return precomputedHash;
+    }
+    // when changing this, the hash precomputed by matc (see MaterialDescriptorSetLayoutChunk)
+    // must be updated to match, otherwise identical layouts stop being deduplicated
     return utils::hash::murmurSlow(
             reinterpret_cast<uint8_t const *>(dsl.bindings.data()),
             dsl.bindings.size() * sizeof(backend::DescriptorSetLayoutBinding),
@@ -68,7 +73,7 @@ void HwDescriptorSetLayoutFactory::terminate(DriverApi&) noexcept {
 }
 
 auto HwDescriptorSetLayoutFactory::create(DriverApi& driver,
-        backend::DescriptorSetLayout dsl) noexcept -> Handle {
+        backend::DescriptorSetLayout dsl, size_t precomputedHash) noexcept -> Handle {
 
     std::sort(dsl.bindings.begin(), dsl.bindings.end(),
             [](auto&& lhs, auto&& rhs) {
@@ -76,13 +81,13 @@ auto HwDescriptorSetLayoutFactory::create(DriverApi& driver,
     });
 
     // see if we already have seen this RenderPrimitive
-    Key const key({ dsl });
+    Key const key({ dsl, precomputedHash });
     auto pos = mBimap.find(key);
 
     // the common case is that we've never seen it (i.e.: no reuse)
     if (UTILS_LIKELY(pos == mBimap.end())) {
         auto handle = driver.createDescriptorSetLayout(std::move(dsl));
-        mBimap.insert(key, { handle });
+        mBimap.insert(key, { handle, mNextClusterId++ });
         return handle;
     }
 
@@ -91,6 +96,11 @@ auto HwDescriptorSetLayoutFactory::create(DriverApi& driver,
     return pos->second.handle;
 }
 
+uint8_t HwDescriptorSetLayoutFactory::getClusterId(Handle handle) const noexcept {
+    auto pos = mBimap.find(Value{ handle });
+    return pos->first.clusterId;
+}
+
 void HwDescriptorSetLayoutFactory::destroy(DriverApi& driver, Handle handle) noexcept {
     // look for this handle in our map
     auto pos = mBimap.find(Value{ handle });
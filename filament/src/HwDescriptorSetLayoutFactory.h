@@ -48,17 +48,27 @@ public:
 
     void terminate(backend::DriverApi& driver) noexcept;
 
-    struct Parameters { // 16 bytes + heap allocations
+    struct Parameters { // 24 bytes + heap allocations
         backend::DescriptorSetLayout dsl;
+        // precomputed hash (e.g. emitted by matc into the material package), 0 if unknown.
+        // must be the same function hash() computes, see Parameters::hash()
+        size_t precomputedHash = 0;
         size_t hash() const noexcept;
     };
 
     friend bool operator==(Parameters const& lhs, Parameters const& rhs) noexcept;
 
-    Handle create(backend::DriverApi& driver, backend::DescriptorSetLayout dsl) noexcept;
+    Handle create(backend::DriverApi& driver, backend::DescriptorSetLayout dsl,
+            size_t precomputedHash = 0) noexcept;
 
     void destroy(backend::DriverApi& driver, Handle handle) noexcept;
 
+    // Compact id shared by every layout that was deduplicated to `handle`, i.e. by all
+    // binding-compatible layouts. Small enough to fit in the RenderPass sort key, so that
+    // commands using compatible layouts can be sorted next to each other. Ids can be
+    // recycled once enough distinct layouts exist; this only affects sorting quality.
+    uint8_t getClusterId(Handle handle) const noexcept;
+
 private:
     struct Key { // 24 bytes
         // The key should not be copyable, unfortunately due to how the Bimap works we have
@@ -80,8 +90,9 @@ private:
         }
     };
 
-    struct Value { // 4 bytes
+    struct Value { // 8 bytes
         Handle handle;
+        uint8_t clusterId = 0;
     };
 
     struct ValueHasher {
@@ -112,6 +123,9 @@ private:
     // The special Bimap
     Bimap<Key, Value, KeyHasher, ValueHasher,
             utils::STLAllocator<Key, PoolAllocatorArena>> mBimap;
+
+    // next cluster id handed out, wraps around (see getClusterId())
+    uint8_t mNextClusterId = 0;
 };
 
 } // namespace filament
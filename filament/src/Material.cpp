@@ -15,6 +15,8 @@
  */
 
 #include "details/Material.h"
+#include "details/RenderTarget.h"
+#include "details/VertexBuffer.h"
 
 namespace filament {
 
@@ -132,6 +134,10 @@ bool Material::isSampler(const char* name) const noexcept {
     return downcast(this)->isSampler(name);
 }
 
+MaterialInstance::ParameterHandle Material::getParameterHandle(const char* name) const noexcept {
+    return downcast(this)->getParameterHandle(name);
+}
+
 MaterialInstance* Material::getDefaultInstance() noexcept {
     return downcast(this)->getDefaultInstance();
 }
@@ -145,6 +151,11 @@ void Material::compile(CompilerPriorityQueue priority, UserVariantFilterMask var
     downcast(this)->compile(priority, variantFilter, handler, std::move(callback));
 }
 
+void Material::precachePipelines(VertexBuffer const* vertexBuffer,
+        RenderTarget const* renderTarget) noexcept {
+    downcast(this)->precachePipelines(downcast(vertexBuffer), downcast(renderTarget));
+}
+
 UserVariantFilterMask Material::getSupportedVariants() const noexcept {
     return downcast(this)->getSupportedVariants();
 }
@@ -77,6 +77,40 @@ inline void FMaterialInstance::setParameterImpl(std::string_view name,
 
 // ------------------------------------------------------------------------------------------------
 
+// handle-based fast path: the offset was resolved once by Material::getParameterHandle(),
+// so this is just a bounds-checked memcpy into the uniform shadow buffer.
+template<typename T>
+UTILS_ALWAYS_INLINE
+inline void FMaterialInstance::setParameterImpl(ParameterHandle handle, T const& value) noexcept {
+    static_assert(!std::is_same_v<T, math::mat3f>);
+    if (UTILS_LIKELY(handle.mOffset >= 0)) {
+        mUniforms.setUniformUntyped<sizeof(T)>(size_t(handle.mOffset), &value);
+    }
+}
+
+void FMaterialInstance::setParametersImpl(ParameterSetting const* settings,
+        size_t count) noexcept {
+    UniformBuffer& uniforms = mUniforms;
+    for (size_t i = 0; i < count; i++) {
+        ParameterSetting const& s = settings[i];
+        if (UTILS_UNLIKELY(s.handle.mOffset < 0)) {
+            continue;
+        }
+        size_t const offset = size_t(s.handle.mOffset);
+        // the ParameterSetting constructor guarantees one of the supported sizes
+        switch (s.size) {
+            case 4:  uniforms.setUniformUntyped<4> (offset, s.storage); break;
+            case 8:  uniforms.setUniformUntyped<8> (offset, s.storage); break;
+            case 12: uniforms.setUniformUntyped<12>(offset, s.storage); break;
+            case 16: uniforms.setUniformUntyped<16>(offset, s.storage); break;
+            case 64: uniforms.setUniformUntyped<64>(offset, s.storage); break;
+            default: break;
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+
 template<typename T, typename>
 void MaterialInstance::setParameter(const char* name, size_t nameLength, T const& value) {
     downcast(this)->setParameterImpl({ name, nameLength }, value);
@@ -124,6 +158,32 @@ template UTILS_PUBLIC void MaterialInstance::setParameter<mat4f>   (const char*
 
 // ------------------------------------------------------------------------------------------------
 
+template<typename T, typename>
+void MaterialInstance::setParameter(ParameterHandle handle, T const& value) noexcept {
+    downcast(this)->setParameterImpl(handle, value);
+}
+
+// explicit template instantiation of the handle-supported types
+template UTILS_PUBLIC void MaterialInstance::setParameter<float>   (ParameterHandle handle, float const&    v) noexcept;
+template UTILS_PUBLIC void MaterialInstance::setParameter<int32_t> (ParameterHandle handle, int32_t const&  v) noexcept;
+template UTILS_PUBLIC void MaterialInstance::setParameter<uint32_t>(ParameterHandle handle, uint32_t const& v) noexcept;
+template UTILS_PUBLIC void MaterialInstance::setParameter<int2>    (ParameterHandle handle, int2 const&     v) noexcept;
+template UTILS_PUBLIC void MaterialInstance::setParameter<int3>    (ParameterHandle handle, int3 const&     v) noexcept;
+template UTILS_PUBLIC void MaterialInstance::setParameter<int4>    (ParameterHandle handle, int4 const&     v) noexcept;
+template UTILS_PUBLIC void MaterialInstance::setParameter<uint2>   (ParameterHandle handle, uint2 const&    v) noexcept;
+template UTILS_PUBLIC void MaterialInstance::setParameter<uint3>   (ParameterHandle handle, uint3 const&    v) noexcept;
+template UTILS_PUBLIC void MaterialInstance::setParameter<uint4>   (ParameterHandle handle, uint4 const&    v) noexcept;
+template UTILS_PUBLIC void MaterialInstance::setParameter<float2>  (ParameterHandle handle, float2 const&   v) noexcept;
+template UTILS_PUBLIC void MaterialInstance::setParameter<float3>  (ParameterHandle handle, float3 const&   v) noexcept;
+template UTILS_PUBLIC void MaterialInstance::setParameter<float4>  (ParameterHandle handle, float4 const&   v) noexcept;
+template UTILS_PUBLIC void MaterialInstance::setParameter<mat4f>   (ParameterHandle handle, mat4f const&    v) noexcept;
+
+void MaterialInstance::setParameters(ParameterSetting const* settings, size_t count) noexcept {
+    downcast(this)->setParametersImpl(settings, count);
+}
+
+// ------------------------------------------------------------------------------------------------
+
 template <typename T, typename>
 void MaterialInstance::setParameter(const char* name, size_t nameLength, const T* value, size_t count) {
     downcast(this)->setParameterImpl({ name, nameLength }, value, count);
@@ -73,8 +73,8 @@ constexpr std::pair<ChunkType, ChunkType> shaderLanguageToTags(ShaderLanguage la
 
 MaterialParser::MaterialParserDetails::MaterialParserDetails(
         utils::FixedCapacityVector<ShaderLanguage> preferredLanguages, const void* data,
-        size_t size)
-    : mManagedBuffer(data, size),
+        size_t size, bool copy)
+    : mManagedBuffer(data, size, copy),
       mChunkContainer(mManagedBuffer.data(), mManagedBuffer.size()),
       mPreferredLanguages(std::move(preferredLanguages)),
       mMaterialChunk(mChunkContainer) {
@@ -93,13 +93,18 @@ bool MaterialParser::MaterialParserDetails::getFromSimpleChunk(
     return false;
 }
 
-MaterialParser::MaterialParserDetails::ManagedBuffer::ManagedBuffer(const void* start, size_t size)
-        : mStart(malloc(size)), mSize(size) {
-    memcpy(mStart, start, size);
+MaterialParser::MaterialParserDetails::ManagedBuffer::ManagedBuffer(
+        const void* start, size_t size, bool copy)
+        : mStart(copy ? malloc(size) : const_cast<void*>(start)), mSize(size), mOwner(copy) {
+    if (copy) {
+        memcpy(mStart, start, size);
+    }
 }
 
 MaterialParser::MaterialParserDetails::ManagedBuffer::~ManagedBuffer() noexcept {
-    free(mStart);
+    if (mOwner) {
+        free(mStart);
+    }
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -113,8 +118,8 @@ bool MaterialParser::get(typename T::Container* container) const noexcept {
 }
 
 MaterialParser::MaterialParser(utils::FixedCapacityVector<ShaderLanguage> preferredLanguages,
-        const void* data, size_t size)
-    : mImpl(std::move(preferredLanguages), data, size) {
+        const void* data, size_t size, bool copy)
+    : mImpl(std::move(preferredLanguages), data, size, copy) {
 }
 
 ChunkContainer& MaterialParser::getChunkContainer() noexcept {
@@ -690,7 +695,7 @@ bool ChunkDescriptorSetLayoutInfo::unflatten(filaflat::Unflattener& unflattener,
         if (!unflattener.read(&descriptorCount)) {
             return false;
         }
-        auto& descriptors = (*container)[j].bindings;
+        auto& descriptors = container->layouts[j].bindings;
         descriptors.reserve(descriptorCount);
         for (size_t i = 0; i < descriptorCount; i++) {
             uint8_t type;
@@ -722,6 +727,15 @@ bool ChunkDescriptorSetLayoutInfo::unflatten(filaflat::Unflattener& unflattener,
             });
         }
     }
+    // layout hashes precomputed by matc; absent from packages produced by older versions,
+    // in which case the runtime factory computes them
+    for (size_t j = 0; j < 2; j++) {
+        uint64_t hash;
+        if (!unflattener.read(&hash)) {
+            break;
+        }
+        container->hashes[j] = hash;
+    }
     return true;
 }
 
@@ -53,8 +53,11 @@ struct MaterialPushConstant;
 
 class MaterialParser {
 public:
+    // When copy is false, the material package is referenced instead of copied; the caller
+    // must keep it valid and unchanged for the lifetime of the parser (e.g. a read-only
+    // file mapping).
     MaterialParser(utils::FixedCapacityVector<backend::ShaderLanguage> preferredLanguages,
-            const void* data, size_t size);
+            const void* data, size_t size, bool copy = true);
 
     MaterialParser(MaterialParser const& rhs) noexcept = delete;
     MaterialParser& operator=(MaterialParser const& rhs) noexcept = delete;
@@ -93,7 +96,11 @@ public:
     using DescriptorBindingsContainer = backend::Program::DescriptorSetInfo;
     bool getDescriptorBindings(DescriptorBindingsContainer* container) const noexcept;
 
-    using DescriptorSetLayoutContainer = std::array<backend::DescriptorSetLayout, 2>;
+    struct DescriptorSetLayoutContainer {
+        std::array<backend::DescriptorSetLayout, 2> layouts;
+        // layout hashes precomputed by matc, 0 when absent (older packages)
+        std::array<uint64_t, 2> hashes = { 0, 0 };
+    };
     bool getDescriptorSetLayout(DescriptorSetLayoutContainer* container) const noexcept;
 
     bool getDepthWriteSet(bool* value) const noexcept;
@@ -147,7 +154,7 @@ private:
     struct MaterialParserDetails {
         MaterialParserDetails(
                 utils::FixedCapacityVector<backend::ShaderLanguage> preferredLanguages,
-                const void* data, size_t size);
+                const void* data, size_t size, bool copy);
 
         template<typename T>
         bool getFromSimpleChunk(filamat::ChunkType type, T* value) const noexcept;
@@ -158,8 +165,9 @@ private:
         class ManagedBuffer {
             void* mStart = nullptr;
             size_t mSize = 0;
+            bool mOwner = true;
         public:
-            explicit ManagedBuffer(const void* start, size_t size);
+            ManagedBuffer(const void* start, size_t size, bool copy);
             ~ManagedBuffer() noexcept;
             ManagedBuffer(ManagedBuffer const& rhs) = delete;
             ManagedBuffer& operator=(ManagedBuffer const& rhs) = delete;
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MaterialProfiler.h"
+
+#include <backend/DriverEnums.h>
+
+#include <utils/compiler.h>
+
+#include <utility>
+
+#include <stdint.h>
+
+namespace filament {
+
+using namespace backend;
+
+void MaterialProfiler::terminate(DriverApi& driver) noexcept {
+    for (auto& query : mQueries) {
+        if (query.handle) {
+            driver.destroyTimerQuery(query.handle);
+            query.handle.clear();
+        }
+    }
+}
+
+void MaterialProfiler::beginSpan(DriverApi& driver, MaterialKey const key) noexcept {
+    endSpan(driver);
+    if (UTILS_UNLIKELY(advance(mIndex) == mLast)) {
+        // the ring is full of unresolved queries, this span goes unmeasured
+        return;
+    }
+    auto& query = mQueries[mIndex];
+    if (UTILS_UNLIKELY(!query.handle)) {
+        // created lazily so a disabled profiler costs nothing
+        query.handle = driver.createTimerQuery();
+    }
+    query.key = key;
+    query.frameId = mFrameId;
+    driver.beginTimerQuery(query.handle);
+    mSpanOpen = true;
+}
+
+void MaterialProfiler::endSpan(DriverApi& driver) noexcept {
+    if (mSpanOpen) {
+        driver.endTimerQuery(mQueries[mIndex].handle);
+        mIndex = advance(mIndex);
+        mSpanOpen = false;
+    }
+}
+
+void MaterialProfiler::endFrame(DriverApi& driver) noexcept {
+    assert_invariant(!mSpanOpen);
+    while (mLast != mIndex) {
+        auto const& query = mQueries[mLast];
+        uint64_t elapsed = 0;
+        TimerQueryResult const result = driver.getTimerQueryValue(query.handle, &elapsed);
+        if (result == TimerQueryResult::NOT_READY) {
+            break;
+        }
+        if (result == TimerQueryResult::AVAILABLE) {
+            if (query.frameId != mCollectFrameId) {
+                // first span of a later frame: the collected frame is complete, publish it
+                mLatest = std::move(mCollecting);
+                mCollecting.clear();
+                mHasNewResults = true;
+                mCollectFrameId = query.frameId;
+            }
+            mCollecting[query.key] += elapsed;
+        }
+        // on ERROR we just drop the span
+        mLast = advance(mLast);
+    }
+    mFrameId++;
+}
+
+} // namespace filament
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_FILAMENT_MATERIALPROFILER_H
+#define TNT_FILAMENT_MATERIALPROFILER_H
+
+#include <backend/Handle.h>
+
+#include <private/backend/DriverApi.h>
+
+#include <tsl/robin_map.h>
+
+#include <array>
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace filament {
+
+/**
+ * MaterialProfiler attributes GPU time to materials. When enabled (see
+ * "d.materials.gpu_profiling"), the render pass executor brackets each span of consecutive
+ * draws sharing a material with a backend timer query; both the Vulkan and Metal backends
+ * implement these with GPU timestamps. Completed queries are harvested once per frame, and
+ * the per-material totals of the most recently completed frame are published to the matdbg
+ * server, giving actual GPU milliseconds per material.
+ *
+ * Queries come from a fixed ring; when more spans are submitted than the ring can track
+ * (results resolve a few frames late), the excess spans simply go unmeasured for that frame.
+ */
+class MaterialProfiler {
+public:
+    // matches matdbg::MaterialKey, which we can't name here when matdbg is disabled
+    using MaterialKey = uint32_t;
+
+    // per-material GPU time of the most recently completed frame, in nanoseconds
+    using Results = tsl::robin_map<MaterialKey, uint64_t>;
+
+    MaterialProfiler() noexcept = default;
+
+    // destroys the timer queries, call before the driver is terminated
+    void terminate(backend::DriverApi& driver) noexcept;
+
+    // Begins a span attributed to the given material, ending the current span if any.
+    // Called from the render pass executor whenever the bound material changes.
+    void beginSpan(backend::DriverApi& driver, MaterialKey key) noexcept;
+
+    // ends the current span, called when a pass' command stream ends
+    void endSpan(backend::DriverApi& driver) noexcept;
+
+    // Harvests completed queries and advances the frame used to tag new spans. Queries
+    // complete in submission order, so a frame's totals are published when the first span
+    // of a later frame resolves.
+    void endFrame(backend::DriverApi& driver) noexcept;
+
+    // returns the totals of the last completed frame once, or nullptr if none completed
+    // since the previous call
+    Results const* consumeResults() noexcept {
+        if (!mHasNewResults) {
+            return nullptr;
+        }
+        mHasNewResults = false;
+        return &mLatest;
+    }
+
+private:
+    // in-flight spans; at ~1ms GPU latency per frame this covers several frames of a
+    // typical scene's material count
+    static constexpr size_t QUERY_COUNT = 256;
+
+    [[nodiscard]] static uint32_t advance(uint32_t const v) noexcept {
+        return (v + 1) % QUERY_COUNT;
+    }
+
+    struct Query {
+        backend::Handle<backend::HwTimerQuery> handle;
+        MaterialKey key = 0;
+        uint32_t frameId = 0;
+    };
+
+    std::array<Query, QUERY_COUNT> mQueries;
+    uint32_t mIndex = 0;            // query of the current span / next span to issue
+    uint32_t mLast = 0;             // oldest query with a pending result
+    bool mSpanOpen = false;
+    uint32_t mFrameId = 0;          // frame used to tag new spans
+    uint32_t mCollectFrameId = 0;   // frame whose results are being accumulated
+    Results mCollecting;
+    Results mLatest;
+    bool mHasNewResults = false;
+};
+
+} // namespace filament
+
+#endif // TNT_FILAMENT_MATERIALPROFILER_H
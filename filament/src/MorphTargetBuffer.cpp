@@ -30,11 +30,21 @@ void MorphTargetBuffer::setPositionsAt(Engine& engine, size_t targetIndex,
     downcast(this)->setPositionsAt(downcast(engine), targetIndex, positions, count, offset);
 }
 
+void MorphTargetBuffer::setPositionsAt(Engine& engine, size_t targetIndex,
+        uint32_t const* indices, math::float3 const* positions, size_t count) {
+    downcast(this)->setPositionsAt(downcast(engine), targetIndex, indices, positions, count);
+}
+
 void MorphTargetBuffer::setTangentsAt(Engine& engine, size_t targetIndex,
         math::short4 const* tangents, size_t count, size_t offset) {
     downcast(this)->setTangentsAt(downcast(engine), targetIndex, tangents, count, offset);
 }
 
+void MorphTargetBuffer::setTangentsAt(Engine& engine, size_t targetIndex,
+        uint32_t const* indices, math::short4 const* tangents, size_t count) {
+    downcast(this)->setTangentsAt(downcast(engine), targetIndex, indices, tangents, count);
+}
+
 size_t MorphTargetBuffer::getVertexCount() const noexcept {
     return downcast(this)->getVertexCount();
 }
@@ -2687,7 +2687,9 @@ void PostProcessManager::configureTemporalAntiAliasingMaterial(
     setConstantParameter(ma, "boxClipping", (int32_t)taaOptions.boxClipping);
     setConstantParameter(ma, "varianceGamma", taaOptions.varianceGamma);
     if (dirty) {
-        ma->invalidate();
+        // retires the current programs instead of destroying them, so toggling back to a
+        // previously-used set of options reuses pre-specialized programs without recompiling
+        ma->respecialize();
         // TODO: call Material::compile(), we can't si that now because it works only
         //       with surface materials
     }
@@ -2712,6 +2714,11 @@ FrameGraphId<FrameGraphTexture> PostProcessManager::taa(FrameGraph& fg,
                 FrameGraphTexture::Usage::SAMPLEABLE, previous.color);
     }
 
+    // Motion is derived from the camera matrices alone (the reprojection matrix computed
+    // below); there is deliberately no per-renderable velocity tracking or prepass, so static
+    // geometry -- the vast majority of a typical scene -- carries no per-object uniform or
+    // vertex cost for TAA. Dynamic objects rely on the neighborhood clamp instead, which
+    // bounds their ghosting without a velocity buffer.
     mat4 const& historyProjection = previous.color.handle ?
             previous.projection : current.projection;
 
@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PvsDatabase.h"
+
+#include <utils/debug.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace filament::math;
+
+namespace filament {
+
+void PvsDatabase::setGrid(Box const& bounds, ushort3 resolution,
+        size_t renderableCount) noexcept {
+    mResolution = {
+            std::max<uint16_t>(resolution.x, 1u),
+            std::max<uint16_t>(resolution.y, 1u),
+            std::max<uint16_t>(resolution.z, 1u) };
+    assert_invariant(bounds.halfExtent.x > 0 && bounds.halfExtent.y > 0
+            && bounds.halfExtent.z > 0);
+    mMin = bounds.getMin();
+    mCellSize = (2.0f * bounds.halfExtent) /
+            float3{ mResolution.x, mResolution.y, mResolution.z };
+    mInvCellSize = 1.0f / mCellSize;
+    mCellCount = size_t(mResolution.x) * mResolution.y * mResolution.z;
+    mRenderableCount = renderableCount;
+    mBlocks = utils::FixedCapacityVector<utils::bitset64>(
+            mCellCount * getBlocksPerCell(), utils::bitset64{});
+}
+
+size_t PvsDatabase::getCell(float3 const& position) const noexcept {
+    if (UTILS_UNLIKELY(mBlocks.empty())) {
+        return INVALID_CELL;
+    }
+    float3 const q = (position - mMin) * mInvCellSize;
+    if (q.x < 0 || q.y < 0 || q.z < 0) {
+        return INVALID_CELL;
+    }
+    size_t const x = size_t(q.x);
+    size_t const y = size_t(q.y);
+    size_t const z = size_t(q.z);
+    if (x >= mResolution.x || y >= mResolution.y || z >= mResolution.z) {
+        return INVALID_CELL;
+    }
+    return (z * mResolution.y + y) * mResolution.x + x;
+}
+
+Box PvsDatabase::getCellBox(size_t cell) const noexcept {
+    assert_invariant(cell < mCellCount);
+    size_t const x = cell % mResolution.x;
+    size_t const y = (cell / mResolution.x) % mResolution.y;
+    size_t const z = cell / (size_t(mResolution.x) * mResolution.y);
+    float3 const min = mMin + mCellSize * float3{ float(x), float(y), float(z) };
+    return { min + 0.5f * mCellSize, 0.5f * mCellSize };
+}
+
+void PvsDatabase::setVisible(size_t cell, size_t index, bool visible) noexcept {
+    assert_invariant(cell < mCellCount);
+    assert_invariant(index < mRenderableCount);
+    utils::bitset64& block =
+            mBlocks[cell * getBlocksPerCell() + index / BITS_PER_BLOCK];
+    block.set(index % BITS_PER_BLOCK, visible);
+}
+
+bool PvsDatabase::isVisible(size_t cell, size_t index) const noexcept {
+    assert_invariant(cell < mCellCount);
+    assert_invariant(index < mRenderableCount);
+    utils::bitset64 const& block =
+            mBlocks[cell * getBlocksPerCell() + index / BITS_PER_BLOCK];
+    return block.test(index % BITS_PER_BLOCK);
+}
+
+// Returns true if the segment [p0, p1] definitely passes through `box` (separating-axis test).
+// The epsilon biases borderline cases towards "no intersection", which keeps the bake
+// conservative when a sample point lies exactly on an occluder face.
+static bool segmentIntersectsBox(float3 const& p0, float3 const& p1, Box const& box) noexcept {
+    constexpr float EPSILON = 1e-6f;
+    float3 const d = (p1 - p0) * 0.5f;              // segment half-direction
+    float3 const m = p0 + d - box.center;           // segment midpoint, box-relative
+    float3 const ad = abs(d);
+    float3 const e = box.halfExtent;
+    if (std::abs(m.x) > e.x + ad.x - EPSILON) return false;
+    if (std::abs(m.y) > e.y + ad.y - EPSILON) return false;
+    if (std::abs(m.z) > e.z + ad.z - EPSILON) return false;
+    if (std::abs(m.y * d.z - m.z * d.y) > e.y * ad.z + e.z * ad.y + EPSILON) return false;
+    if (std::abs(m.z * d.x - m.x * d.z) > e.z * ad.x + e.x * ad.z + EPSILON) return false;
+    if (std::abs(m.x * d.y - m.y * d.x) > e.x * ad.y + e.y * ad.x + EPSILON) return false;
+    return true;
+}
+
+void PvsDatabase::bake(Box const* renderableAabbs, size_t renderableCount,
+        Box const* occluders, size_t occluderCount) noexcept {
+    assert_invariant(!mBlocks.empty());
+    renderableCount = std::min(renderableCount, mRenderableCount);
+
+    // Sample points of a box: its center and 8 corners.
+    constexpr size_t SAMPLE_COUNT = 9;
+    auto const sample = [](Box const& b, float3 out[SAMPLE_COUNT]) {
+        out[0] = b.center;
+        size_t n = 1;
+        for (float const sx: { -1.0f, 1.0f }) {
+            for (float const sy: { -1.0f, 1.0f }) {
+                for (float const sz: { -1.0f, 1.0f }) {
+                    out[n++] = b.center + b.halfExtent * float3{ sx, sy, sz };
+                }
+            }
+        }
+    };
+
+    float3 from[SAMPLE_COUNT];
+    float3 to[SAMPLE_COUNT];
+    for (size_t cell = 0; cell < mCellCount; cell++) {
+        sample(getCellBox(cell), from);
+        for (size_t i = 0; i < renderableCount; i++) {
+            sample(renderableAabbs[i], to);
+            // Visible unless every sampled sight line is blocked by some occluder.
+            bool visible = false;
+            for (size_t a = 0; !visible && a < SAMPLE_COUNT; a++) {
+                for (size_t b = 0; !visible && b < SAMPLE_COUNT; b++) {
+                    bool blocked = false;
+                    for (size_t o = 0; !blocked && o < occluderCount; o++) {
+                        blocked = segmentIntersectsBox(from[a], to[b], occluders[o]);
+                    }
+                    visible = !blocked;
+                }
+            }
+            setVisible(cell, i, visible);
+        }
+    }
+}
+
+void PvsDatabase::apply(size_t cell, Culler::result_type* const visibleMask,
+        size_t count, size_t bit) const noexcept {
+    assert_invariant(cell < mCellCount);
+    count = std::min(count, mRenderableCount);
+    utils::bitset64 const* const UTILS_RESTRICT blocks =
+            mBlocks.data() + cell * getBlocksPerCell();
+    auto const visibleBit = Culler::result_type(1u << bit);
+    for (size_t i = 0; i < count; i++) {
+        if (!blocks[i / BITS_PER_BLOCK].test(i % BITS_PER_BLOCK)) {
+            visibleMask[i] &= Culler::result_type(~visibleBit);
+        }
+    }
+}
+
+} // namespace filament
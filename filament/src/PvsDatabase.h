@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_FILAMENT_DETAILS_PVSDATABASE_H
+#define TNT_FILAMENT_DETAILS_PVSDATABASE_H
+
+#include "Culler.h"
+
+#include <filament/Box.h>
+
+#include <utils/bitset.h>
+#include <utils/FixedCapacityVector.h>
+
+#include <math/vec3.h>
+
+#include <stddef.h>
+
+namespace filament {
+
+/*
+ * Precomputed visibility (PVS) for scenes with natural room/portal structure.
+ *
+ * Space is partitioned into a uniform grid of axis-aligned cells; each cell stores one bit per
+ * renderable (by index into the scene's renderable SoA) telling whether that renderable can be
+ * seen from anywhere inside the cell. The bitsets are baked offline -- either by tooling that
+ * calls setVisible() directly, or with the conservative bake() helper below -- and at runtime
+ * FView::prepare() looks up the cell containing the culling camera and intersects the cell's
+ * bitset with the frustum culling results.
+ *
+ * Frustum culling answers "is it in front of the camera"; the PVS answers "can it be seen from
+ * here at all", which is what eliminates frustum-passing-but-occluded draws in multi-room
+ * interiors.
+ */
+class PvsDatabase {
+public:
+    static constexpr size_t INVALID_CELL = ~size_t(0);
+
+    PvsDatabase() noexcept = default;
+
+    // Defines the cell grid and allocates the bitset storage with all bits clear (nothing
+    // visible). Cells partition `bounds` uniformly; each resolution axis is clamped to >= 1.
+    // Invalidates previously stored bitsets.
+    void setGrid(Box const& bounds, math::ushort3 resolution, size_t renderableCount) noexcept;
+
+    bool empty() const noexcept { return mBlocks.empty(); }
+    size_t getCellCount() const noexcept { return mCellCount; }
+    size_t getRenderableCount() const noexcept { return mRenderableCount; }
+
+    // Returns the index of the cell containing `position`, or INVALID_CELL if the position lies
+    // outside the grid (in which case the PVS cannot be applied and culling falls back to the
+    // frustum results alone).
+    size_t getCell(math::float3 const& position) const noexcept;
+
+    // Marks renderable `index` as visible (or not) from `cell`. Used by the bake tooling.
+    void setVisible(size_t cell, size_t index, bool visible) noexcept;
+    bool isVisible(size_t cell, size_t index) const noexcept;
+
+    // Conservative offline bake. A renderable is kept visible from a cell unless every sampled
+    // sight line between the cell's box and the renderable's world-space AABB is blocked by one
+    // of the occluder boxes (walls, floors, ...). Errs on the side of visibility.
+    void bake(Box const* renderableAabbs, size_t renderableCount,
+            Box const* occluders, size_t occluderCount) noexcept;
+
+    // Clears `bit` in visibleMask[i] for every renderable i that is not in `cell`'s
+    // potentially-visible set. `count` entries are processed at most.
+    void apply(size_t cell, Culler::result_type* visibleMask,
+            size_t count, size_t bit) const noexcept;
+
+    // Returns the world-space box of the given cell. Used by the bake.
+    Box getCellBox(size_t cell) const noexcept;
+
+private:
+    size_t getBlocksPerCell() const noexcept {
+        return (mRenderableCount + BITS_PER_BLOCK - 1) / BITS_PER_BLOCK;
+    }
+
+    static constexpr size_t BITS_PER_BLOCK = 64;
+
+    math::float3 mMin{};
+    math::float3 mCellSize{};
+    math::float3 mInvCellSize{};
+    math::ushort3 mResolution{};
+    size_t mCellCount = 0;
+    size_t mRenderableCount = 0;
+    utils::FixedCapacityVector<utils::bitset64> mBlocks;
+};
+
+} // namespace filament
+
+#endif // TNT_FILAMENT_DETAILS_PVSDATABASE_H
@@ -20,6 +20,7 @@
 #include "ShadowMap.h"
 #include "SharedHandle.h"
 
+#include "details/Engine.h"
 #include "details/Material.h"
 #include "details/MaterialInstance.h"
 #include "details/View.h"
@@ -44,6 +45,7 @@
 
 #include <utils/compiler.h>
 #include <utils/debug.h>
+#include <utils/Hash.h>
 #include <utils/JobSystem.h>
 #include <utils/Panic.h>
 #include <utils/Slice.h>
@@ -106,21 +108,75 @@ void RenderPass::DescriptorSetHandleDeleter::operator()(
 
 // ------------------------------------------------------------------------------------------------
 
+// hash of all the builder inputs that affect command generation and sorting, used as the
+// key of the retained-mode command cache
+static uint32_t computeCommandsCacheKey(RenderPassBuilder const& builder) noexcept {
+    struct {
+        uint32_t first;
+        uint32_t last;
+        uint32_t commandTypeFlags;
+        uint32_t renderFlags;
+        uint32_t visibilityMask;
+        uint32_t variant;
+        float3 cameraPosition;
+        float3 cameraForwardVector;
+        math::mat4f cullingViewProjection;
+    } key{
+            builder.mVisibleRenderables.first,
+            builder.mVisibleRenderables.last,
+            uint32_t(builder.mCommandTypeFlags),
+            uint32_t(builder.mFlags),
+            uint32_t(builder.mVisibilityMask),
+            uint32_t(builder.mVariant.key),
+            builder.mCameraPosition,
+            builder.mCameraForwardVector,
+            builder.mCullingViewProjection
+    };
+    return hash::murmur3(reinterpret_cast<uint32_t const*>(&key), sizeof(key) / 4, 0);
+}
+
 RenderPass::RenderPass(FEngine const& engine, backend::DriverApi& driver,
         RenderPassBuilder const& builder) noexcept
         : mRenderableSoa(*builder.mRenderableSoa),
           mColorPassDescriptorSet(builder.mColorPassDescriptorSet),
           mScissorViewport(builder.mScissorViewport) {
 
-    // compute the number of commands we need
-    updateSummedPrimitiveCounts(
-            const_cast<FScene::RenderableSoa&>(mRenderableSoa), builder.mVisibleRenderables);
+    int32_t stereoscopicEyeCount = 1;
+    if (builder.mFlags & IS_INSTANCED_STEREOSCOPIC) {
+        stereoscopicEyeCount *= engine.getConfig().stereoscopicEyeCount;
+    }
+
+    // retained-mode path: when the previous frame's sorted commands are still valid
+    // (static geometry, static camera), skip generation and sorting entirely. Passes with
+    // custom commands are not cached because their executors can't be replayed.
+    CachedCommandBuffer* const cache =
+            builder.mCustomCommands.has_value() ? nullptr : builder.mCachedCommands;
+    uint32_t const cacheKey = cache ? computeCommandsCacheKey(builder) : 0;
+    if (cache && cache->mValid && cache->mInputHash == cacheKey) {
+        size_t const cachedCount = cache->mCommands.size();
+        Command* const commandBegin = builder.mArena.alloc<Command>(cachedCount);
+        Command* commandEnd = commandBegin + cachedCount;
+        assert_invariant(commandBegin);
+        memcpy(commandBegin, cache->mCommands.data(), cachedCount * sizeof(Command));
+
+        if (engine.isAutomaticInstancingEnabled()) {
+            commandEnd = resize(builder.mArena,
+                    instanceify(driver,
+                            engine.getPerRenderableDescriptorSetLayout().getHandle(),
+                            commandBegin, commandEnd, stereoscopicEyeCount));
+        }
 
-    uint32_t commandCount =
-            FScene::getPrimitiveCount(mRenderableSoa, builder.mVisibleRenderables.last);
-    const bool colorPass  = bool(builder.mCommandTypeFlags & CommandTypeFlags::COLOR);
-    const bool depthPass  = bool(builder.mCommandTypeFlags & CommandTypeFlags::DEPTH);
-    commandCount *= uint32_t(colorPass * 2 + depthPass);
+        mCommandBegin = commandBegin;
+        mCommandEnd = commandEnd;
+        return;
+    }
+
+    // compute the exact number of commands we need. Color passes used to reserve two
+    // commands for every primitive, but only blended primitives (two-pass transparency)
+    // actually use the second slot; counting them here shrinks the arena slab accordingly.
+    uint32_t commandCount = updateSummedCommandCounts(
+            const_cast<FScene::RenderableSoa&>(mRenderableSoa), builder.mVisibleRenderables,
+            builder.mCommandTypeFlags, builder.mVisibilityMask);
     commandCount += 1; // for the sentinel
 
     uint32_t const customCommandCount =
@@ -160,13 +216,17 @@ RenderPass::RenderPass(FEngine const& engine, backend::DriverApi& driver,
 
     // sort commands once we're done adding commands
     commandEnd = resize(builder.mArena,
-            RenderPass::sortCommands(commandBegin, commandEnd));
+            RenderPass::sortCommands(engine.getJobSystem(), commandBegin, commandEnd));
+
+    if (cache) {
+        // store the sorted (but not instanced -- instancing creates per-frame UBOs)
+        // commands for reuse by subsequent frames
+        cache->mCommands.assign(commandBegin, commandEnd);
+        cache->mInputHash = cacheKey;
+        cache->mValid = true;
+    }
 
     if (engine.isAutomaticInstancingEnabled()) {
-        int32_t stereoscopicEyeCount = 1;
-        if (builder.mFlags & IS_INSTANCED_STEREOSCOPIC) {
-            stereoscopicEyeCount *= engine.getConfig().stereoscopicEyeCount;
-        }
         commandEnd = resize(builder.mArena,
                 instanceify(driver,
                         engine.getPerRenderableDescriptorSetLayout().getHandle(),
@@ -272,11 +332,47 @@ void RenderPass::appendCustomCommand(Command* commands,
     commands->key = cmd;
 }
 
-RenderPass::Command* RenderPass::sortCommands(
+RenderPass::Command* RenderPass::sortCommands(JobSystem& js,
         Command* const begin, Command* const end) noexcept {
     SYSTRACE_NAME("sort commands");
 
-    std::sort(begin, end);
+    size_t const count = end - begin;
+
+    // Below this size the JobSystem overhead exceeds what parallelism buys us.
+    constexpr size_t PARALLEL_SORT_THRESHOLD = 4096;
+    // Must be a power-of-two for the pairwise merge tree below.
+    constexpr size_t PARALLEL_SORT_CHUNK_COUNT = 8;
+
+    if (UTILS_LIKELY(count < PARALLEL_SORT_THRESHOLD)) {
+        std::sort(begin, end);
+    } else {
+        // sort each chunk on a worker, then merge pairwise; each merge level halves the
+        // number of runs and merges within a level proceed in parallel
+        Command* bounds[PARALLEL_SORT_CHUNK_COUNT + 1];
+        for (size_t i = 0; i < PARALLEL_SORT_CHUNK_COUNT; i++) {
+            bounds[i] = begin + (count * i) / PARALLEL_SORT_CHUNK_COUNT;
+        }
+        bounds[PARALLEL_SORT_CHUNK_COUNT] = end;
+
+        auto* parent = js.createJob();
+        for (size_t i = 0; i < PARALLEL_SORT_CHUNK_COUNT; i++) {
+            js.run(jobs::createJob(js, parent,
+                    [b = bounds[i], e = bounds[i + 1]]() { std::sort(b, e); }));
+        }
+        js.runAndWait(parent);
+
+        for (size_t stride = 1; stride < PARALLEL_SORT_CHUNK_COUNT; stride *= 2) {
+            auto* mergeParent = js.createJob();
+            for (size_t i = 0; i < PARALLEL_SORT_CHUNK_COUNT; i += 2 * stride) {
+                js.run(jobs::createJob(js, mergeParent,
+                        [first = bounds[i], mid = bounds[i + stride],
+                         last = bounds[i + 2 * stride]]() {
+                            std::inplace_merge(first, mid, last);
+                        }));
+            }
+            js.runAndWait(mergeParent);
+        }
+    }
 
     // find the last command
     Command* const last = std::partition_point(begin, end,
@@ -296,10 +392,9 @@ RenderPass::Command* RenderPass::instanceify(backend::DriverApi& driver,
     // instanceify works by scanning the **sorted** command stream, looking for repeat draw
     // commands. When one is found, it is replaced by an instanced command.
     // A "repeat" draw is one that ends-up using the same draw parameters and state.
-    // Currently, this relies somewhat on luck that "repeat draws" are found consecutively,
-    // we could improve this by including some or all of these "repeat" parameters in the
-    // sorting key (e.g. raster state, primitive handle, etc...), the key could even use a small
-    // hash of those parameters.
+    // Command::operator< breaks key ties on the primitive handle, so repeat draws with equal
+    // keys are guaranteed to be consecutive; only repeats that straddle a key boundary
+    // (e.g. a Z-bucket edge in the color pass) are missed.
 
     UTILS_UNUSED uint32_t drawCallsSavedCount = 0;
 
@@ -313,30 +408,41 @@ RenderPass::Command* RenderPass::instanceify(backend::DriverApi& driver,
     // TODO: for the case of instancing we could actually use 128 instead of 64 instances
     constexpr size_t maxInstanceCount = CONFIG_MAX_INSTANCES;
 
+    auto const* const UTILS_RESTRICT soaSkinning = mRenderableSoa.data<FScene::SKINNING_BUFFER>();
+
     while (curr != last) {
-        // Currently, if we have skinning or morphing, we can't use auto instancing. This is
-        // because the morphing/skinning data for comparison is not easily accessible; and also
-        // because we're assuming that the per-renderable descriptor-set only has the
-        // OBJECT_UNIFORMS descriptor active (i.e. the skinning/morphing descriptors are unused).
+        // Currently, if we have morphing, we can't use auto instancing, because the morphing
+        // weights are per-renderable. Skinned draws can be merged when they bind the same bone
+        // palette window (same buffer, same offset, same indices-and-weights texture), which is
+        // the case for crowds fed from one shared SkinningBuffer; a merged group gets its own
+        // descriptor-set carrying the palette on top of the instancing UBO.
         // We also can't use auto-instancing if manual- or hybrid- instancing is used.
-        // TODO: support auto-instancing for skinning/morphing
+        // TODO: support auto-instancing for morphing
         Command const* e = curr + 1;
         if (UTILS_LIKELY(
-                !curr->info.hasSkinning && !curr->info.hasMorphing &&
+                !curr->info.hasMorphing &&
                  curr->info.instanceCount <= 1))
         {
             assert_invariant(!curr->info.hasHybridInstancing);
             // we can't have nice things! No more than maxInstanceCount due to UBO size limits
             e = std::find_if_not(curr, std::min(last, curr + maxInstanceCount),
-                    [lhs = *curr](Command const& rhs) {
+                    [lhs = *curr, soaSkinning](Command const& rhs) {
                         // primitives must be identical to be instanced
-                        // Currently, instancing doesn't support skinning/morphing.
+                        // Currently, instancing doesn't support morphing.
                         return lhs.info.mi == rhs.info.mi &&
                                lhs.info.rph == rhs.info.rph &&
                                lhs.info.vbih == rhs.info.vbih &&
                                lhs.info.indexOffset == rhs.info.indexOffset &&
                                lhs.info.indexCount == rhs.info.indexCount &&
-                               lhs.info.rasterState == rhs.info.rasterState;
+                               lhs.info.rasterState == rhs.info.rasterState &&
+                               lhs.info.hasSkinning == rhs.info.hasSkinning &&
+                               (!lhs.info.hasSkinning ||
+                                (soaSkinning[lhs.info.index].handle ==
+                                         soaSkinning[rhs.info.index].handle &&
+                                 soaSkinning[lhs.info.index].offset ==
+                                         soaSkinning[rhs.info.index].offset &&
+                                 soaSkinning[lhs.info.index].boneIndicesAndWeightHandle ==
+                                         soaSkinning[rhs.info.index].boneIndicesAndWeightHandle));
                     });
         }
 
@@ -392,8 +498,16 @@ RenderPass::Command* RenderPass::instanceify(backend::DriverApi& driver,
 
             // make the first command instanced
             curr[0].info.instanceCount = instanceCount * eyeCount;
+            if (UTILS_UNLIKELY(curr[0].info.hasSkinning)) {
+                // the group shares one bone palette binding (guaranteed by the merge
+                // criteria above); note: info.index is still the renderable's index here
+                curr[0].info.dsh = getInstancedBoneDescriptorSet(driver,
+                        perRenderableDescriptorSetLayoutHandle,
+                        soaSkinning[curr[0].info.index]);
+            } else {
+                curr[0].info.dsh = mInstancedDescriptorSetHandle;
+            }
             curr[0].info.index = instancedPrimitiveOffset;
-            curr[0].info.dsh = mInstancedDescriptorSetHandle;
 
             instancedPrimitiveOffset += instanceCount;
 
@@ -433,6 +547,36 @@ RenderPass::Command* RenderPass::instanceify(backend::DriverApi& driver,
     return last;
 }
 
+backend::DescriptorSetHandle RenderPass::getInstancedBoneDescriptorSet(DriverApi& driver,
+        DescriptorSetLayoutHandle perRenderableDescriptorSetLayoutHandle,
+        FRenderableManager::SkinningBindingInfo const& skinning) const noexcept {
+    // a frame typically has very few distinct palettes, a linear search is fine
+    for (auto const& entry : mInstancedBoneDescriptorSets) {
+        if (entry.bones == skinning.handle &&
+                entry.boneIndicesAndWeights == skinning.boneIndicesAndWeightHandle) {
+            return entry.dsh;
+        }
+    }
+    // Same layout and lifetime as mInstancedDescriptorSetHandle, with the group's bone
+    // palette bound on top of the instancing UBO. The palette window offset is not baked
+    // in here, it's supplied as a dynamic offset with the draw.
+    assert_invariant(mInstancedUboHandle);
+    DescriptorSetSharedHandle dsh{
+            driver.createDescriptorSet(perRenderableDescriptorSetLayoutHandle), driver };
+    driver.updateDescriptorSetBuffer(dsh,
+            +PerRenderableBindingPoints::OBJECT_UNIFORMS,
+            mInstancedUboHandle, 0, sizeof(PerRenderableUib));
+    driver.updateDescriptorSetBuffer(dsh,
+            +PerRenderableBindingPoints::BONES_UNIFORMS,
+            skinning.handle, 0, sizeof(PerRenderableBoneUib));
+    driver.updateDescriptorSetTexture(dsh,
+            +PerRenderableBindingPoints::BONES_INDICES_AND_WEIGHTS,
+            skinning.boneIndicesAndWeightHandle, {});
+    mInstancedBoneDescriptorSets.push_back({
+            skinning.handle, skinning.boneIndicesAndWeightHandle, std::move(dsh) });
+    return mInstancedBoneDescriptorSets.back().dsh;
+}
+
 
 /* static */
 UTILS_ALWAYS_INLINE // This function exists only to make the code more readable. we want it inlined.
@@ -501,13 +645,11 @@ void RenderPass::generateCommands(CommandTypeFlags commandTypeFlags, Command* co
     // (in principle, we could have split this method into two, at the cost of going through
     // the list twice)
 
-    // compute how much maximum storage we need
-    // double the color pass for transparent objects that need to render twice
-    const bool colorPass  = bool(commandTypeFlags & CommandTypeFlags::COLOR);
-    const bool depthPass  = bool(commandTypeFlags & CommandTypeFlags::DEPTH);
-    const size_t commandsPerPrimitive = uint32_t(colorPass * 2 + depthPass);
-    const size_t offsetBegin = FScene::getPrimitiveCount(soa, range.first) * commandsPerPrimitive;
-    const size_t offsetEnd   = FScene::getPrimitiveCount(soa, range.last) * commandsPerPrimitive;
+    // the summed command counts give us the exact offset of each renderable's commands in the
+    // shared slab (see updateSummedCommandCounts()), so parallel invocations of this function
+    // never overlap.
+    const size_t offsetBegin = FScene::getRenderPassCommandCount(soa, range.first);
+    const size_t offsetEnd   = FScene::getRenderPassCommandCount(soa, range.last);
     Command* curr = commands + offsetBegin;
     Command* const last = commands + offsetEnd;
 
@@ -591,6 +733,11 @@ RenderPass::Command* RenderPass::generateCommandsImpl(RenderPass::CommandTypeFla
     auto const* const UTILS_RESTRICT soaVisibilityMask  = soa.data<FScene::VISIBLE_MASK>();
     auto const* const UTILS_RESTRICT soaInstanceInfo    = soa.data<FScene::INSTANCES>();
     auto const* const UTILS_RESTRICT soaDescriptorSet   = soa.data<FScene::DESCRIPTOR_SET_HANDLE>();
+    auto const* const UTILS_RESTRICT soaPrimitiveVisibleMask = soa.data<FScene::PRIMITIVE_VISIBLE_MASK>();
+
+    // the per-primitive visible bits are computed against the camera frustum, so they only
+    // apply to passes culled by it (color, depth prepass, picking, structure) -- never shadows
+    bool const applyPrimitiveCulling = visibilityMask & VISIBLE_RENDERABLE;
 
     Command cmd;
 
@@ -700,11 +847,16 @@ RenderPass::Command* RenderPass::generateCommandsImpl(RenderPass::CommandTypeFla
         const bool writeDepthForShadowCasters = depthContainsShadowCasters & shadowCaster;
 
         const Slice<FRenderPrimitive>& primitives = soaPrimitives[i];
+        // always ~0 unless this renderable declared per-primitive bounds (see cullPrimitives())
+        const uint32_t primitiveVisibleMask = soaPrimitiveVisibleMask[i];
         /*
          * This is our hot loop. It's written to avoid branches.
          * When modifying this code, always ensure it stays efficient.
          */
-        for (auto const& primitive: primitives) {
+        for (size_t pi = 0, pn = primitives.size(); pi < pn; ++pi) {
+            FRenderPrimitive const& primitive = primitives[pi];
+            bool const primitiveCulled = applyPrimitiveCulling
+                    && pi < 32 && !(primitiveVisibleMask & (1u << pi));
             FMaterialInstance const* const mi = primitive.getMaterialInstance();
             FMaterial const* const ma = mi->getMaterial();
 
@@ -777,6 +929,9 @@ RenderPass::Command* RenderPass::generateCommandsImpl(RenderPass::CommandTypeFla
                     // cancel command if both front and back faces are culled
                     key |= select(mi->getCullingMode() == CullingMode::FRONT_AND_BACK);
 
+                    // cancel command if the primitive's own bounds failed frustum culling
+                    key |= select(primitiveCulled);
+
                     *curr = cmd;
                     curr->key = key;
                     ++curr;
@@ -808,7 +963,14 @@ RenderPass::Command* RenderPass::generateCommandsImpl(RenderPass::CommandTypeFla
                         && blendingMode != BlendingMode::MASKED);
                 const bool isPickingVariant = Variant::isPickingVariant(variant);
 
-                cmd.key |= mi->getSortingKey(); // already all set-up for direct or'ing
+                // Materials without a custom depth shader all share the default material's
+                // minimal depth-only programs; give their commands a common sorting key
+                // (sub-sorted by variant) so they end up adjacent, which lets the executor
+                // collapse their pipeline changes into one per variant.
+                cmd.key |= UTILS_UNLIKELY(ma->hasCustomDepthShader()) ?
+                        mi->getSortingKey() : // already all set-up for direct or'ing
+                        makeField(cmd.info.materialVariant.key,
+                                MATERIAL_INSTANCE_ID_MASK, MATERIAL_INSTANCE_ID_SHIFT);
                 cmd.info.rasterState.culling = mi->getCullingMode();
 
                 // FIXME: should writeDepthForShadowCasters take precedence over mi->getDepthWrite()?
@@ -823,23 +985,54 @@ RenderPass::Command* RenderPass::generateCommandsImpl(RenderPass::CommandTypeFla
             *curr = cmd;
             // cancel command if both front and back faces are culled
             curr->key |= select(mi->getCullingMode() == CullingMode::FRONT_AND_BACK);
+            // cancel command if the primitive's own bounds failed frustum culling
+            curr->key |= select(primitiveCulled);
             ++curr;
         }
     }
     return curr;
 }
 
-void RenderPass::updateSummedPrimitiveCounts(
-        FScene::RenderableSoa& renderableData, Range<uint32_t> vr) noexcept {
+uint32_t RenderPass::updateSummedCommandCounts(
+        FScene::RenderableSoa& renderableData, Range<uint32_t> vr,
+        CommandTypeFlags const commandTypeFlags,
+        FScene::VisibleMaskType const visibilityMask) noexcept {
+    // Compute the exact number of commands each renderable generates, summed so that
+    // generateCommands() can derive the offset of each renderable's commands in the shared
+    // slab. This must mirror what generateCommandsImpl() writes for each primitive: a color
+    // pass emits two commands for blended primitives (two-pass transparency) and one
+    // otherwise -- cancelled commands still occupy their slot; a depth pass emits one.
     auto const* const UTILS_RESTRICT primitives = renderableData.data<FScene::PRIMITIVES>();
-    uint32_t* const UTILS_RESTRICT summedPrimitiveCount = renderableData.data<FScene::SUMMED_PRIMITIVE_COUNT>();
+    auto const* const UTILS_RESTRICT visibility = renderableData.data<FScene::VISIBLE_MASK>();
+    uint32_t* const UTILS_RESTRICT summedCommandCount = renderableData.data<FScene::SUMMED_COMMAND_COUNT>();
+    const bool colorPass  = bool(commandTypeFlags & CommandTypeFlags::COLOR);
+    const bool depthPass  = bool(commandTypeFlags & CommandTypeFlags::DEPTH);
     uint32_t count = 0;
     for (uint32_t const i : vr) {
-        summedPrimitiveCount[i] = count;
-        count += primitives[i].size();
+        summedCommandCount[i] = count;
+        if (UTILS_UNLIKELY(!(visibility[i] & visibilityMask))) {
+            // generateCommandsImpl() skips this renderable entirely
+            continue;
+        }
+        if (depthPass) {
+            count += primitives[i].size();
+        }
+        if (colorPass) {
+            for (auto const& primitive: primitives[i]) {
+                FMaterial const* const ma = primitive.getMaterialInstance()->getMaterial();
+                BlendingMode const blendingMode = ma->getBlendingMode();
+                // must match the isBlendingCommand logic in setupColorCommand()
+                bool const isBlended =
+                        ma->getRefractionMode() != RefractionMode::SCREEN_SPACE &&
+                        blendingMode != BlendingMode::OPAQUE &&
+                        blendingMode != BlendingMode::MASKED;
+                count += 1u + uint32_t(isBlended);
+            }
+        }
     }
     // we're guaranteed to have enough space at the end of vr
-    summedPrimitiveCount[vr.last] = count;
+    summedCommandCount[vr.last] = count;
+    return count;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -921,9 +1114,20 @@ void RenderPass::Executor::execute(FEngine const& engine, backend::DriverApi& dr
         FMaterial const* UTILS_RESTRICT ma = nullptr;
         auto const* UTILS_RESTRICT pCustomCommands = mCustomCommands.data();
 
+        // The per-view descriptor-set only depends on the material's per-view layout index,
+        // so it can stay bound across materials that share it (commands are sorted so that
+        // layout-compatible materials are adjacent). 0xff means "unknown".
+        uint8_t currentPerViewLayoutIndex = 0xff;
+
+#if FILAMENT_ENABLE_MATDBG
+        // opt-in per-material GPU time attribution, see MaterialProfiler
+        MaterialProfiler* const profiler = UTILS_UNLIKELY(engine.debug.materials.gpu_profiling)
+                ? &const_cast<FEngine&>(engine).getMaterialProfiler() : nullptr;
+#endif
+
         // Maximum space occupied in the CircularBuffer by a single `Command`. This must be
         // reevaluated when the inner loop below adds DriverApi commands or when we change the
-        // CommandStream protocol. Currently, the maximum is 248 bytes.
+        // CommandStream protocol.
         // The batch size is calculated by adding the size of all commands that can possibly be
         // emitted per draw call:
         constexpr size_t const maxCommandSizeInBytes =
@@ -934,7 +1138,7 @@ void RenderPass::Executor::execute(FEngine const& engine, backend::DriverApi& dr
                 sizeof(COMMAND_TYPE(bindRenderPrimitive)) +
                 sizeof(COMMAND_TYPE(bindDescriptorSet)) + backend::CustomCommand::align(sizeof(NoopCommand) + 8) +
                 sizeof(COMMAND_TYPE(setPushConstant)) +
-                sizeof(COMMAND_TYPE(draw2));
+                sizeof(COMMAND_TYPE(bindDescriptorSetAndDraw));
 
 
         // Number of Commands that can be issued and guaranteed to fit in the current
@@ -967,6 +1171,7 @@ void RenderPass::Executor::execute(FEngine const& engine, backend::DriverApi& dr
 
                 if (UTILS_UNLIKELY((first->key & CUSTOM_MASK) != uint64_t(CustomCommand::PASS))) {
                     mi = nullptr; // custom command could change the currently bound MaterialInstance
+                    currentPerViewLayoutIndex = 0xff; // it could also rebind the per-view set
                     uint32_t const index = (first->key & CUSTOM_INDEX_MASK) >> CUSTOM_INDEX_SHIFT;
                     assert_invariant(index < mCustomCommands.size());
                     pCustomCommands[index]();
@@ -992,6 +1197,12 @@ void RenderPass::Executor::execute(FEngine const& engine, backend::DriverApi& dr
                     mi = info.mi;
                     ma = mi->getMaterial();
 
+#if FILAMENT_ENABLE_MATDBG
+                    if (UTILS_UNLIKELY(profiler)) {
+                        profiler->beginSpan(driver, ma->getDebuggerId());
+                    }
+#endif
+
                     // if we have the scissor override, the material instance and scissor-viewport
                     // are ignored (typically used for shadow maps).
                     if (!hasScissorOverride) {
@@ -1028,6 +1239,7 @@ void RenderPass::Executor::execute(FEngine const& engine, backend::DriverApi& dr
                         // Ideally we would have a more formal compute API). In this case, we need
                         // to set the post-process descriptor-set.
                         engine.getPostProcessManager().bindPostProcessDescriptorSet(driver);
+                        currentPerViewLayoutIndex = 0xff; // the per-view binding point changed
                     } else {
                         // If we have a ColorPassDescriptorSet we use it to bind the per-view
                         // descriptor-set (ideally only if it changed). If we don't, it means
@@ -1038,8 +1250,13 @@ void RenderPass::Executor::execute(FEngine const& engine, backend::DriverApi& dr
                         if (mColorPassDescriptorSet) {
                             // We have a ColorPassDescriptorSet, we need to go through it for binding
                             // the per-view descriptor-set because its layout can change based on the
-                            // material.
-                            mColorPassDescriptorSet->bind(driver, ma->getPerViewLayoutIndex());
+                            // material; it is skipped when the layout index didn't change, keeping
+                            // the view-global set bound across compatible materials.
+                            uint8_t const perViewLayoutIndex = ma->getPerViewLayoutIndex();
+                            if (perViewLayoutIndex != currentPerViewLayoutIndex) {
+                                currentPerViewLayoutIndex = perViewLayoutIndex;
+                                mColorPassDescriptorSet->bind(driver, perViewLayoutIndex);
+                            }
                         }
                     }
 
@@ -1060,25 +1277,32 @@ void RenderPass::Executor::execute(FEngine const& engine, backend::DriverApi& dr
                     driver.bindRenderPrimitive(info.rph);
                 }
 
-                // Bind per-renderable uniform block. There is no need to attempt to skip this command
-                // because the backends already do this.
-                uint32_t const offset = info.hasHybridInstancing ?
-                                      0 : info.index * sizeof(PerRenderableData);
-
-                assert_invariant(info.dsh);
-                driver.bindDescriptorSet(info.dsh,
-                        +DescriptorSetBindingPoints::PER_RENDERABLE,
-                        {{ offset, info.skinningOffset }, driver});
-
                 if (UTILS_UNLIKELY(info.hasMorphing)) {
                     driver.setPushConstant(ShaderStage::VERTEX,
                             +PushConstantIds::MORPHING_BUFFER_OFFSET, int32_t(info.morphingOffset));
                 }
 
-                driver.draw2(info.indexOffset, info.indexCount, info.instanceCount);
+                // Bind the per-renderable uniform block and issue the draw as a single fused
+                // command; both happen unconditionally for every draw, so fusing them halves
+                // the dispatch overhead on the driver thread. There is no need to attempt to
+                // skip the descriptor-set binding because the backends already do this.
+                uint32_t const offset = info.hasHybridInstancing ?
+                                      0 : info.index * sizeof(PerRenderableData);
+
+                assert_invariant(info.dsh);
+                driver.bindDescriptorSetAndDraw(info.dsh,
+                        +DescriptorSetBindingPoints::PER_RENDERABLE,
+                        {{ offset, info.skinningOffset }, driver},
+                        info.indexOffset, info.indexCount, info.instanceCount);
             }
         }
 
+#if FILAMENT_ENABLE_MATDBG
+        if (UTILS_UNLIKELY(profiler)) {
+            profiler->endSpan(driver);
+        }
+#endif
+
         // If the remaining space is less than half the capacity, we flush right away to
         // allow some headroom for commands that might come later.
         if (UTILS_UNLIKELY(circularBuffer.getUsed() > capacity / 2)) {
@@ -1100,6 +1324,10 @@ RenderPass::Executor::Executor(RenderPass const& pass, Command const* b, Command
           mScissor(pass.mScissorViewport),
           mPolygonOffsetOverride(false),
           mScissorOverride(false) {
+    mInstancedBoneDescriptorSetHandles.reserve(pass.mInstancedBoneDescriptorSets.size());
+    for (auto const& entry : pass.mInstancedBoneDescriptorSets) {
+        mInstancedBoneDescriptorSetHandles.push_back(entry.dsh);
+    }
     mHasScissorViewport = mScissor != backend::Viewport{ 0, 0, INT32_MAX, INT32_MAX };
     assert_invariant(b >= pass.begin());
     assert_invariant(e <= pass.end());
@@ -50,6 +50,10 @@
 #include <stddef.h>
 #include <stdint.h>
 
+namespace utils {
+class JobSystem;
+}
+
 namespace filament {
 
 namespace backend {
@@ -75,8 +79,8 @@ public:
      *   0     = reserved, must be zero
      *
      *
-     * TODO: we need to add a "primitive id" in the low-bits of material-id, so that
-     *       auto-instancing can work better
+     * Commands with equal keys are further ordered by their render-primitive (see
+     * Command::operator<), so that auto-instancing finds repeat draws consecutively.
      *
      *   DEPTH command (b00)
      *   |  |  | 2| 2| 2|1| 3 | 2|  6   |   10     |               32               |
@@ -139,9 +143,12 @@ public:
     static constexpr uint64_t MATERIAL_VARIANT_KEY_MASK     = 0x000FF000llu;
     static constexpr unsigned MATERIAL_VARIANT_KEY_SHIFT    = 12;
 
-    static constexpr uint64_t MATERIAL_ID_MASK              = 0xFFF00000llu;
+    static constexpr uint64_t MATERIAL_ID_MASK              = 0x0FF00000llu;
     static constexpr unsigned MATERIAL_ID_SHIFT             = 20;
 
+    static constexpr uint64_t MATERIAL_LAYOUT_MASK          = 0xF0000000llu;
+    static constexpr unsigned MATERIAL_LAYOUT_SHIFT         = 28;
+
     static constexpr uint64_t BLEND_DISTANCE_MASK           = 0xFFFFFFFF0000llu;
     static constexpr unsigned BLEND_DISTANCE_SHIFT          = 16;
 
@@ -212,16 +219,24 @@ public:
     /*
      * The sorting material key is 32 bits and encoded as:
      *
-     * |     12     |   8    |     12     |
-     * +------------+--------+------------+
-     * |  material  |variant |  instance  |
-     * +------------+--------+------------+
+     * |  4   |   8    |   8    |     12     |
+     * +------+--------+--------+------------+
+     * |layout|material|variant |  instance  |
+     * +------+--------+--------+------------+
+     *
+     * `layout` is the material's descriptor-set layout-compatibility cluster (see
+     * HwDescriptorSetLayoutFactory::getClusterId()), so that materials sharing a layout sort
+     * next to each other and the backends see runs of compatible descriptor binds. Both it
+     * and the material id are truncated; this only affects sorting, not correctness.
      *
      * The variant is inserted while building the commands, because we don't know it before that
      */
-    static CommandKey makeMaterialSortingKey(uint32_t materialId, uint32_t instanceId) noexcept {
-        CommandKey const key = ((materialId << MATERIAL_ID_SHIFT) & MATERIAL_ID_MASK) |
-                         ((instanceId << MATERIAL_INSTANCE_ID_SHIFT) & MATERIAL_INSTANCE_ID_MASK);
+    static CommandKey makeMaterialSortingKey(uint32_t materialId,
+            uint32_t layoutClusterId, uint32_t instanceId) noexcept {
+        CommandKey const key =
+                ((layoutClusterId << MATERIAL_LAYOUT_SHIFT) & MATERIAL_LAYOUT_MASK) |
+                ((materialId << MATERIAL_ID_SHIFT) & MATERIAL_ID_MASK) |
+                ((instanceId << MATERIAL_INSTANCE_ID_SHIFT) & MATERIAL_INSTANCE_ID_MASK);
         return (key << MATERIAL_SHIFT) & MATERIAL_MASK;
     }
 
@@ -271,7 +286,19 @@ public:
     struct alignas(8) Command {     // 64 bytes
         CommandKey key = 0;         //  8 bytes
         PrimitiveInfo info;    // 56 bytes
-        bool operator < (Command const& rhs) const noexcept { return key < rhs.key; }
+        bool operator < (Command const& rhs) const noexcept {
+            // The ordering of commands with equal keys is unspecified as far as rendering is
+            // concerned, so we use it to group identical primitives together, which guarantees
+            // that instanceify() finds all mergeable draws consecutively (e.g. many renderables
+            // sharing the same mesh and material instance).
+            if (key != rhs.key) {
+                return key < rhs.key;
+            }
+            if (info.rph.getId() != rhs.info.rph.getId()) {
+                return info.rph.getId() < rhs.info.rph.getId();
+            }
+            return info.indexOffset < rhs.info.indexOffset;
+        }
         // placement new declared as "throw" to avoid the compiler's null-check
         inline void* operator new (size_t, void* ptr) {
             assert_invariant(ptr);
@@ -295,6 +322,30 @@ public:
             utils::TrackingPolicy::HighWatermark,
             utils::AreaPolicy::StaticArea>;
 
+    /*
+     * Retained-mode support. A caller-owned buffer holding the sorted command list of a
+     * previous frame. When set on RenderPassBuilder and still valid, command generation
+     * and sorting are skipped and the cached commands are copied into the per-frame arena
+     * (instancing still runs, as it creates per-frame UBOs).
+     *
+     * The key only covers the builder's inputs (visible range, flags, variant, camera);
+     * commands hold pointers into the scene's data structures, so the owner must call
+     * invalidate() whenever renderables are added, removed or modified.
+     */
+    class CachedCommandBuffer {
+        friend class RenderPass;
+        std::vector<Command> mCommands;
+        uint32_t mInputHash = 0;
+        bool mValid = false;
+    public:
+        void invalidate() noexcept {
+            mValid = false;
+            mCommands.clear();
+        }
+        bool isValid() const noexcept { return mValid; }
+        size_t size() const noexcept { return mCommands.size(); }
+    };
+
     // RenderPass can only be moved
     RenderPass(RenderPass&& rhs) = default;
     RenderPass& operator=(RenderPass&& rhs) = delete;  // could be supported if needed
@@ -343,6 +394,8 @@ public:
         utils::Slice<CustomCommandFn> mCustomCommands;
         BufferObjectSharedHandle mInstancedUboHandle;
         DescriptorSetSharedHandle mInstancedDescriptorSetHandle;
+        // keeps the per-bone-palette descriptor-sets of instanced skinned groups alive
+        std::vector<DescriptorSetSharedHandle> mInstancedBoneDescriptorSetHandles;
         ColorPassDescriptorSet const* mColorPassDescriptorSet = nullptr;
         // this stores either the scissor-viewport or the scissor override
         backend::Viewport mScissor{ 0, 0, INT32_MAX, INT32_MAX };
@@ -396,6 +449,14 @@ public:
         return { *this, b, e };
     }
 
+    // test and benchmark hook, see Culler::Test
+    struct UTILS_PUBLIC Test {
+        static Command* sortCommands(utils::JobSystem& js,
+                Command* const begin, Command* const end) noexcept {
+            return RenderPass::sortCommands(js, begin, end);
+        }
+    };
+
 private:
     friend class FRenderer;
     friend class RenderPassBuilder;
@@ -421,8 +482,8 @@ private:
 
     static Command* resize(Arena& arena, Command* last) noexcept;
 
-    // sorts commands then trims sentinels
-    static Command* sortCommands(
+    // sorts commands (in parallel for large command streams) then trims sentinels
+    static Command* sortCommands(utils::JobSystem& js,
             Command* begin, Command* end) noexcept;
 
     // instanceify commands then trims sentinels
@@ -456,8 +517,11 @@ private:
     static void setupColorCommand(Command& cmdDraw, Variant variant,
             FMaterialInstance const* mi, bool inverseFrontFaces, bool hasDepthClamp) noexcept;
 
-    static void updateSummedPrimitiveCounts(
-            FScene::RenderableSoa& renderableData, utils::Range<uint32_t> vr) noexcept;
+    // computes per-renderable summed command counts and returns the total command count
+    static uint32_t updateSummedCommandCounts(
+            FScene::RenderableSoa& renderableData, utils::Range<uint32_t> vr,
+            CommandTypeFlags commandTypeFlags,
+            FScene::VisibleMaskType visibilityMask) noexcept;
 
     FScene::RenderableSoa const& mRenderableSoa;
     ColorPassDescriptorSet const* const mColorPassDescriptorSet;
@@ -466,6 +530,21 @@ private:
     Command const* /* const */ mCommandEnd = nullptr;     // Pointer to one past the last command
     mutable BufferObjectSharedHandle mInstancedUboHandle; // ubo for instanced primitives
     mutable DescriptorSetSharedHandle mInstancedDescriptorSetHandle; // a descriptor-set to hold the ubo
+
+    // descriptor-sets for instanced skinned primitives, one per distinct bone palette binding;
+    // like mInstancedDescriptorSetHandle, their lifetime is extended by the Executors
+    struct InstancedBoneDescriptorSet {
+        backend::BufferObjectHandle bones;
+        backend::TextureHandle boneIndicesAndWeights;
+        DescriptorSetSharedHandle dsh;
+    };
+    mutable std::vector<InstancedBoneDescriptorSet> mInstancedBoneDescriptorSets;
+
+    // returns (creating it if needed) the descriptor-set for an instanced group of skinned
+    // primitives sharing the given bone palette binding
+    backend::DescriptorSetHandle getInstancedBoneDescriptorSet(backend::DriverApi& driver,
+            backend::DescriptorSetLayoutHandle perRenderableDescriptorSetLayoutHandle,
+            FRenderableManager::SkinningBindingInfo const& skinning) const noexcept;
     // a vector for our custom commands
     using CustomCommandVector = utils::FixedCapacityVector<Executor::CustomCommandFn>;
     mutable CustomCommandVector mCustomCommands;
@@ -481,10 +560,12 @@ class RenderPassBuilder {
     utils::Range<uint32_t> mVisibleRenderables{};
     math::float3 mCameraPosition{};
     math::float3 mCameraForwardVector{};
+    math::mat4f mCullingViewProjection{};
     RenderPass::RenderFlags mFlags{};
     Variant mVariant{};
     ColorPassDescriptorSet const* mColorPassDescriptorSet = nullptr;
     FScene::VisibleMaskType mVisibilityMask = std::numeric_limits<FScene::VisibleMaskType>::max();
+    RenderPass::CachedCommandBuffer* mCachedCommands = nullptr;
 
     using CustomCommandRecord = std::tuple<
             uint8_t,
@@ -526,6 +607,9 @@ public:
     RenderPassBuilder& camera(const CameraInfo& camera) noexcept {
         mCameraPosition = camera.getPosition();
         mCameraForwardVector = camera.getForwardVector();
+        // the culling frustum determines each renderable's visibility bits, so it's part
+        // of the retained-mode cache key
+        mCullingViewProjection = camera.cullingProjection * camera.view;
         return *this;
     }
 
@@ -564,6 +648,14 @@ public:
         return *this;
     }
 
+    // Optional retained-mode cache. When the cache is valid and the builder's inputs
+    // are unchanged, RenderPass reuses the cached sorted commands; otherwise the newly
+    // generated commands are stored into it. Ignored for passes with custom commands.
+    RenderPassBuilder& cachedCommands(RenderPass::CachedCommandBuffer* cache) noexcept {
+        mCachedCommands = cache;
+        return *this;
+    }
+
     RenderPassBuilder& customCommand(
             uint8_t channel,
             RenderPass::Pass pass,
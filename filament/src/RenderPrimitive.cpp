@@ -39,6 +39,8 @@ void FRenderPrimitive::init(HwRenderPrimitiveFactory& factory, backend::DriverAp
 
     mMaterialInstance = downcast(entry.materialInstance);
     mBlendOrder = entry.blendOrder;
+    mAabb = entry.aabb;
+    mHasAabb = entry.hasAabb;
 
     if (entry.indices && entry.vertices) {
         FVertexBuffer* vertexBuffer = downcast(entry.vertices);
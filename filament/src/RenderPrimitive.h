@@ -60,6 +60,8 @@ public:
 
     backend::PrimitiveType getPrimitiveType() const noexcept { return mPrimitiveType; }
     AttributeBitset getEnabledAttributes() const noexcept { return mEnabledAttributes; }
+    bool hasAxisAlignedBoundingBox() const noexcept { return mHasAabb; }
+    Box const& getAxisAlignedBoundingBox() const noexcept { return mAabb; }
     uint16_t getBlendOrder() const noexcept { return mBlendOrder; }
     bool isGlobalBlendOrderEnabled() const noexcept { return mGlobalBlendOrderEnabled; }
 
@@ -89,8 +91,10 @@ private:
     };
 
     AttributeBitset mEnabledAttributes = {};
+    Box mAabb = {};     // object-space AABB of this primitive, only valid if mHasAabb is set
     uint16_t mBlendOrder = 0;
     bool mGlobalBlendOrderEnabled = false;
+    bool mHasAabb = false;
     backend::PrimitiveType mPrimitiveType = backend::PrimitiveType::TRIANGLES;
 };
 
@@ -0,0 +1,263 @@
+/*
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "RenderableBvh.h"
+
+#include <utils/debug.h>
+
+#include <math/vec4.h>
+
+#include <algorithm>
+#include <limits>
+
+using namespace filament::math;
+
+namespace filament {
+
+// traversal stacks; the median split guarantees a depth logarithmic in the renderable
+// count, so this accommodates any count a uint32_t can index
+static constexpr size_t MAX_DEPTH = 64;
+
+RenderableBvh::RenderableBvh() noexcept = default;
+
+RenderableBvh::~RenderableBvh() noexcept = default;
+
+void RenderableBvh::rebuild(float3 const* center, float3 const* extent, size_t count) {
+    mCount = count;
+    if (UTILS_UNLIKELY(count == 0)) {
+        mNodes = {};
+        mIndices = {};
+        return;
+    }
+
+    if (mIndices.size() != count) {
+        mIndices = utils::FixedCapacityVector<uint32_t>(count);
+    }
+    for (size_t i = 0; i < count; i++) {
+        mIndices[i] = uint32_t(i);
+    }
+
+    // Once a node splits, each child covers at least LEAF_SIZE/2 entries, which bounds the
+    // leaf count and, the tree being full binary, the total node count.
+    size_t const maxLeaves = (count + LEAF_SIZE / 2 - 1) / (LEAF_SIZE / 2);
+    size_t const maxNodes = std::max(size_t(1), 2 * maxLeaves - 1);
+    mNodes = utils::FixedCapacityVector<Node>::with_capacity(maxNodes);
+
+    build(center, extent, 0, uint32_t(count));
+
+    // the topology is in place, the bounds come from a regular refit
+    refit(center, extent);
+}
+
+uint32_t RenderableBvh::build(float3 const* center, float3 const* extent,
+        uint32_t const first, uint32_t const count) noexcept {
+    uint32_t const nodeIndex = uint32_t(mNodes.size());
+    assert_invariant(mNodes.size() < mNodes.capacity());
+    mNodes.push_back({ {}, {}, first, count, 0 });
+
+    if (count <= LEAF_SIZE) {
+        return nodeIndex;
+    }
+
+    // split at the median along the largest axis of the centroid bounds
+    uint32_t* const indices = mIndices.data();
+    float3 lo = center[indices[first]];
+    float3 hi = lo;
+    for (uint32_t i = first + 1, e = first + count; i < e; i++) {
+        lo = min(lo, center[indices[i]]);
+        hi = max(hi, center[indices[i]]);
+    }
+    float3 const d = hi - lo;
+    size_t const axis = d.x > d.y ? (d.x > d.z ? 0 : 2) : (d.y > d.z ? 1 : 2);
+
+    uint32_t const half = count / 2;
+    std::nth_element(indices + first, indices + first + half, indices + first + count,
+            [center, axis](uint32_t const a, uint32_t const b) {
+                return center[a][axis] < center[b][axis];
+            });
+
+    // the left child is laid out right after its parent, only the right one is recorded
+    UTILS_UNUSED_IN_RELEASE uint32_t const left = build(center, extent, first, half);
+    assert_invariant(left == nodeIndex + 1);
+    uint32_t const right = build(center, extent, first + half, count - half);
+    mNodes[nodeIndex].child = right;
+    return nodeIndex;
+}
+
+void RenderableBvh::refit(float3 const* center, float3 const* extent) noexcept {
+    Node* const nodes = mNodes.data();
+    uint32_t const* const indices = mIndices.data();
+    // children always live at higher indices than their parent, so a reverse walk sees
+    // them before the parent that merges them
+    for (size_t i = mNodes.size(); i--;) {
+        Node& node = nodes[i];
+        float3 lo, hi;
+        if (node.child == 0) {
+            uint32_t const j = indices[node.first];
+            lo = center[j] - extent[j];
+            hi = center[j] + extent[j];
+            for (uint32_t k = node.first + 1, e = node.first + node.count; k < e; k++) {
+                uint32_t const index = indices[k];
+                lo = min(lo, center[index] - extent[index]);
+                hi = max(hi, center[index] + extent[index]);
+            }
+        } else {
+            Node const& l = nodes[i + 1];
+            Node const& r = nodes[node.child];
+            lo = min(l.center - l.extent, r.center - r.extent);
+            hi = max(l.center + l.extent, r.center + r.extent);
+        }
+        node.center = (hi + lo) * 0.5f;
+        node.extent = (hi - lo) * 0.5f;
+    }
+}
+
+void RenderableBvh::cull(Frustum const& frustum,
+        float3 const* center, float3 const* extent,
+        Culler::result_type* const visibleArray, size_t const bit) const noexcept {
+    if (UTILS_UNLIKELY(empty())) {
+        return;
+    }
+
+    float4 const* const planes = frustum.getNormalizedPlanes();
+    Node const* const nodes = mNodes.data();
+    uint32_t const* const indices = mIndices.data();
+    auto const mask = Culler::result_type(1u << bit);
+
+    auto const setRange = [indices, visibleArray, mask](
+            uint32_t const first, uint32_t const count, bool const visible) {
+        for (uint32_t i = first, e = first + count; i < e; i++) {
+            auto r = visibleArray[indices[i]];
+            r = visible ? Culler::result_type(r | mask) : Culler::result_type(r & ~mask);
+            visibleArray[indices[i]] = r;
+        }
+    };
+
+    uint32_t stack[MAX_DEPTH];
+    size_t sp = 0;
+    stack[sp++] = 0;
+    while (sp) {
+        uint32_t const ni = stack[--sp];
+        Node const& node = nodes[ni];
+
+        // same convention as Culler: a positive distance to the near corner separates the
+        // box from the frustum; a non-positive distance to the far corner means the box
+        // is entirely on the inner side of the plane
+        bool outside = false;
+        bool inside = true;
+        for (size_t j = 0; j < 6; j++) {
+            float const d =
+                    planes[j].x * node.center.x +
+                    planes[j].y * node.center.y +
+                    planes[j].z * node.center.z + planes[j].w;
+            float const e =
+                    std::abs(planes[j].x) * node.extent.x +
+                    std::abs(planes[j].y) * node.extent.y +
+                    std::abs(planes[j].z) * node.extent.z;
+            outside = outside || (d - e > 0.0f);
+            inside = inside && (d + e <= 0.0f);
+        }
+
+        if (outside || inside) {
+            // the whole subtree is resolved at once
+            setRange(node.first, node.count, inside);
+            continue;
+        }
+
+        if (node.child == 0) {
+            // a leaf straddling the frustum, test its renderables individually
+            for (uint32_t i = node.first, e = node.first + node.count; i < e; i++) {
+                uint32_t const index = indices[i];
+                bool visible = true;
+                for (size_t j = 0; j < 6; j++) {
+                    float const dot =
+                            planes[j].x * center[index].x - std::abs(planes[j].x) * extent[index].x +
+                            planes[j].y * center[index].y - std::abs(planes[j].y) * extent[index].y +
+                            planes[j].z * center[index].z - std::abs(planes[j].z) * extent[index].z +
+                            planes[j].w;
+                    visible = visible && (dot <= 0.0f);
+                }
+                auto r = visibleArray[index];
+                r &= ~mask;
+                r |= Culler::result_type(visible ? mask : 0u);
+                visibleArray[index] = r;
+            }
+            continue;
+        }
+
+        assert_invariant(sp + 2 <= MAX_DEPTH);
+        stack[sp++] = node.child;
+        stack[sp++] = ni + 1;
+    }
+}
+
+ptrdiff_t RenderableBvh::raycast(float3 const origin, float3 const direction, float const tMax,
+        float3 const* center, float3 const* extent) const noexcept {
+    if (UTILS_UNLIKELY(empty())) {
+        return -1;
+    }
+
+    constexpr float inf = std::numeric_limits<float>::infinity();
+    float3 const invDirection{
+            1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z };
+
+    // slab test, returns the entry distance (clamped to 0 when the origin is inside) or
+    // +inf when the box is missed within [0, limit]
+    auto const intersectBox = [origin, invDirection](
+            float3 const& c, float3 const& e, float const limit) -> float {
+        float3 const t0 = (c - e - origin) * invDirection;
+        float3 const t1 = (c + e - origin) * invDirection;
+        float3 const tlo = min(t0, t1);
+        float3 const thi = max(t0, t1);
+        float const tmin = std::max({ tlo.x, tlo.y, tlo.z, 0.0f });
+        float const tmax = std::min({ thi.x, thi.y, thi.z, limit });
+        return tmin <= tmax ? tmin : inf;
+    };
+
+    Node const* const nodes = mNodes.data();
+    uint32_t const* const indices = mIndices.data();
+
+    float bestT = tMax;
+    ptrdiff_t best = -1;
+
+    uint32_t stack[MAX_DEPTH];
+    size_t sp = 0;
+    stack[sp++] = 0;
+    while (sp) {
+        uint32_t const ni = stack[--sp];
+        Node const& node = nodes[ni];
+        if (intersectBox(node.center, node.extent, bestT) == inf) {
+            continue;
+        }
+        if (node.child == 0) {
+            for (uint32_t i = node.first, e = node.first + node.count; i < e; i++) {
+                uint32_t const index = indices[i];
+                float const t = intersectBox(center[index], extent[index], bestT);
+                if (t < bestT || (t <= bestT && best < 0)) {
+                    bestT = t;
+                    best = ptrdiff_t(index);
+                }
+            }
+            continue;
+        }
+        assert_invariant(sp + 2 <= MAX_DEPTH);
+        stack[sp++] = node.child;
+        stack[sp++] = ni + 1;
+    }
+    return best;
+}
+
+} // namespace filament
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_FILAMENT_DETAILS_RENDERABLEBVH_H
+#define TNT_FILAMENT_DETAILS_RENDERABLEBVH_H
+
+#include "Culler.h"
+
+#include <filament/Frustum.h>
+
+#include <utils/compiler.h>
+#include <utils/FixedCapacityVector.h>
+
+#include <math/vec3.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace filament {
+
+/*
+ * A bounding-volume hierarchy over the scene's renderable AABBs, maintained by FScene.
+ *
+ * The topology is rebuilt when the renderable count changes and only refitted (bounds
+ * recomputed bottom-up, structure kept) otherwise, so the per-frame cost is O(n) with a
+ * small constant. A stale topology after entities move only degrades culling efficiency,
+ * never correctness, since the bounds always come from the current frame's data.
+ *
+ * Like the RenderableSoa it indexes into, this structure is only valid during a view pass.
+ */
+class RenderableBvh {
+public:
+    // below this, the flat vectorized Culler path beats the traversal overhead
+    static constexpr size_t CULL_THRESHOLD = 2048;
+
+    // target number of renderables per leaf, matches Culler's batching granularity
+    static constexpr size_t LEAF_SIZE = Culler::MODULO;
+
+    RenderableBvh() noexcept;
+    ~RenderableBvh() noexcept;
+
+    RenderableBvh(RenderableBvh const&) = delete;
+    RenderableBvh& operator=(RenderableBvh const&) = delete;
+
+    // Rebuilds the topology from scratch (median split on the largest centroid axis).
+    void rebuild(math::float3 const* center, math::float3 const* extent, size_t count);
+
+    // Recomputes all node bounds from the current AABBs, keeping the topology.
+    void refit(math::float3 const* center, math::float3 const* extent) noexcept;
+
+    // number of renderables the hierarchy was built over
+    size_t size() const noexcept { return mCount; }
+
+    bool empty() const noexcept { return mCount == 0; }
+
+    // Writes `bit` of visibleArray for every renderable: subtrees fully outside or fully
+    // inside the frustum are resolved without visiting their renderables. center/extent
+    // must be the arrays the hierarchy was last refitted from.
+    void cull(Frustum const& frustum,
+            math::float3 const* center, math::float3 const* extent,
+            Culler::result_type* visibleArray, size_t bit) const noexcept;
+
+    // Returns the index of the renderable whose AABB is hit closest to the ray origin
+    // within [0, tMax], or -1 if none. The direction need not be normalized. center/extent
+    // must be the arrays the hierarchy was last refitted from.
+    ptrdiff_t raycast(math::float3 origin, math::float3 direction, float tMax,
+            math::float3 const* center, math::float3 const* extent) const noexcept;
+
+private:
+    struct Node {
+        math::float3 center;
+        math::float3 extent;
+        uint32_t first;     // first entry covered, as an index into mIndices
+        uint32_t count;     // number of entries covered (mIndices[first, first + count))
+        uint32_t child;     // index of the left child node (right is child + 1), 0 for leaves
+    };
+
+    uint32_t build(math::float3 const* center, math::float3 const* extent,
+            uint32_t first, uint32_t count) noexcept;
+
+    utils::FixedCapacityVector<Node> mNodes;
+    utils::FixedCapacityVector<uint32_t> mIndices;  // renderable indices, leaf-contiguous
+    size_t mCount = 0;
+};
+
+} // namespace filament
+
+#endif // TNT_FILAMENT_DETAILS_RENDERABLEBVH_H
@@ -76,6 +76,14 @@ void RenderableManager::setCulling(Instance instance, bool enable) noexcept {
     downcast(this)->setCulling(instance, enable);
 }
 
+void RenderableManager::setShadowOnly(Instance instance, bool enable) noexcept {
+    downcast(this)->setShadowOnly(instance, enable);
+}
+
+bool RenderableManager::isShadowOnly(Instance instance) const noexcept {
+    return downcast(this)->isShadowOnly(instance);
+}
+
 void RenderableManager::setCastShadows(Instance instance, bool enable) noexcept {
     downcast(this)->setCastShadows(instance, enable);
 }
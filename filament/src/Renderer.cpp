@@ -20,6 +20,7 @@
 
 #include "details/Engine.h"
 #include "details/Renderer.h"
+#include "details/Texture.h"
 #include "details/View.h"
 
 #include <utils/FixedCapacityVector.h>
@@ -42,6 +43,10 @@ void Renderer::render(View const* view) {
     downcast(this)->render(downcast(view));
 }
 
+void Renderer::render(View const* const* views, size_t viewCount) {
+    downcast(this)->render(reinterpret_cast<FView const* const*>(views), viewCount);
+}
+
 void Renderer::setPresentationTime(int64_t monotonic_clock_ns) {
     downcast(this)->setPresentationTime(monotonic_clock_ns);
 }
@@ -59,6 +64,13 @@ void Renderer::copyFrame(SwapChain* dstSwapChain, filament::Viewport const& dstV
     downcast(this)->copyFrame(downcast(dstSwapChain), dstViewport, srcViewport, flags);
 }
 
+void Renderer::copyFrameInto(Texture* dstTexture, filament::Viewport const& dstViewport,
+        filament::Viewport const& srcViewport, backend::CallbackHandler* handler,
+        backend::CallbackHandler::Callback callback, void* user) {
+    downcast(this)->copyFrameInto(downcast(dstTexture), dstViewport, srcViewport,
+            handler, callback, user);
+}
+
 void Renderer::readPixels(uint32_t xoffset, uint32_t yoffset, uint32_t width, uint32_t height,
         PixelBufferDescriptor&& buffer) {
     downcast(this)->readPixels(xoffset, yoffset, width, height, std::move(buffer));
@@ -115,4 +127,20 @@ size_t Renderer::getMaxFrameHistorySize() const noexcept {
     return downcast(this)->getMaxFrameHistorySize();
 }
 
+void Renderer::setFrameTimelineEnabled(bool enabled) noexcept {
+    downcast(this)->setFrameTimelineEnabled(enabled);
+}
+
+bool Renderer::isFrameTimelineEnabled() const noexcept {
+    return downcast(this)->isFrameTimelineEnabled();
+}
+
+utils::CString Renderer::exportFrameTimeline() const noexcept {
+    return downcast(this)->exportFrameTimeline();
+}
+
+utils::FixedCapacityVector<Renderer::PassStatistics> Renderer::getPassStatistics() const noexcept {
+    return downcast(this)->getPassStatistics();
+}
+
 } // namespace filament
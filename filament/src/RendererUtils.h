@@ -33,7 +33,6 @@
 
 #include <stdint.h>
 
-#include <optional>
 #include <utility>
 
 namespace filament {
@@ -99,13 +98,21 @@ public:
             PostProcessManager::ColorGradingConfig colorGradingConfig,
             RenderPass::Executor passExecutor) noexcept;
 
-    static std::optional<RendererUtils::ColorPassOutput> refractionPass(
+    // Returns the first surviving refraction command of the post-culling command list, or
+    // nullptr if no refractive object is visible this frame. This is what gates the whole
+    // refraction color capture: when it returns nullptr the full-screen copy and mip-chain
+    // generation are skipped entirely.
+    static RenderPass::Command const* findFirstRefractionCommand(
+            RenderPass const& pass) noexcept;
+
+    static ColorPassOutput refractionPass(
             FrameGraph& fg, FEngine& engine, FView const& view,
             ColorPassInput colorPassInput,
             ColorPassConfig config,
             PostProcessManager::ScreenSpaceRefConfig const& ssrConfig,
             PostProcessManager::ColorGradingConfig colorGradingConfig,
-            RenderPass const& pass) noexcept;
+            RenderPass const& pass,
+            RenderPass::Command const* firstRefractionCommand) noexcept;
 
     static void readPixels(backend::DriverApi& driver,
             backend::Handle<backend::HwRenderTarget> renderTargetHandle,
@@ -16,6 +16,8 @@
 
 #include "ResourceAllocator.h"
 
+#include "GpuMemoryTracker.h"
+
 #include <filament/Engine.h>
 
 #include "details/Texture.h"
@@ -121,6 +123,7 @@ size_t ResourceAllocator::TextureKey::getSize() const noexcept {
 ResourceAllocator::ResourceAllocator(Engine::Config const& config, DriverApi& driverApi) noexcept
         : mCacheMaxAge(config.resourceAllocatorCacheMaxAge),
           mBackend(driverApi),
+          mCacheMaxSize(size_t(config.resourceAllocatorCacheSizeMB) << 20u),
           mDisposer(std::make_shared<ResourceAllocatorDisposer>(driverApi)) {
 }
 
@@ -128,6 +131,7 @@ ResourceAllocator::ResourceAllocator(std::shared_ptr<ResourceAllocatorDisposer>
         Engine::Config const& config, DriverApi& driverApi) noexcept
         : mCacheMaxAge(config.resourceAllocatorCacheMaxAge),
           mBackend(driverApi),
+          mCacheMaxSize(size_t(config.resourceAllocatorCacheSizeMB) << 20u),
           mDisposer(std::move(disposer)) {
 }
 
@@ -138,6 +142,9 @@ ResourceAllocator::~ResourceAllocator() noexcept {
 void ResourceAllocator::terminate() noexcept {
     auto& textureCache = mTextureCache;
     for (auto it = textureCache.begin(); it != textureCache.end();) {
+        if (mMemoryTracker) {
+            mMemoryTracker->release(Engine::MemoryCategory::RENDER_TARGET, it->second.size);
+        }
         mBackend.destroyTexture(it->second.handle);
         it = textureCache.erase(it);
     }
@@ -172,16 +179,48 @@ backend::TextureHandle ResourceAllocator::createTexture(const char* name,
 
     // do we have a suitable texture in the cache?
     TextureHandle handle;
-    TextureKey const key{ name, target, levels, format, samples, width, height, depth, usage, swizzle };
+    TextureKey key{ name, target, levels, format, samples, width, height, depth, usage, swizzle };
+    if (std::find(mRecentSizes.begin(), mRecentSizes.end(),
+            std::pair<uint32_t, uint32_t>{ width, height }) == mRecentSizes.end()) {
+        mRecentSizes.push_back({ width, height });
+    }
     if constexpr (mEnabled) {
         auto& textureCache = mTextureCache;
         auto it = textureCache.find(key);
+        if (it == textureCache.end()) {
+            // No exact match. Try to alias a cached texture whose allocation is
+            // compatible: identical in every way except that it carries more usage bits
+            // than requested. This lets transient targets with disjoint lifetimes (e.g.
+            // bloom/SSAO/TAA intermediates) share one allocation even when their declared
+            // usage differs.
+            it = std::find_if(textureCache.begin(), textureCache.end(),
+                    [&key](auto const& entry) {
+                        TextureKey const& k = entry.first;
+                        return k.target == key.target &&
+                               k.levels == key.levels &&
+                               k.format == key.format &&
+                               k.samples == key.samples &&
+                               k.width == key.width &&
+                               k.height == key.height &&
+                               k.depth == key.depth &&
+                               k.swizzle == key.swizzle &&
+                               (k.usage & key.usage) == key.usage;
+                    });
+            if (it != textureCache.end()) {
+                // keep the texture's true key (with the new name), so that checkin()
+                // returns it to the cache unchanged
+                key = it->first;
+                key.name = name;
+            }
+        }
         if (UTILS_LIKELY(it != textureCache.end())) {
             // we do, move the entry to the in-use list, and remove from the cache
+            mCacheHits++;
             handle = it->second.handle;
             mCacheSize -= it->second.size;
             textureCache.erase(it);
         } else {
+            mCacheMisses++;
             // we don't, allocate a new texture and populate the in-use list
             handle = mBackend.createTexture(
                     target, levels, format, samples, width, height, depth, usage);
@@ -191,6 +230,9 @@ backend::TextureHandle ResourceAllocator::createTexture(const char* name,
                 mBackend.destroyTexture(handle);
                 handle = swizzledHandle;
             }
+            if (mMemoryTracker) {
+                mMemoryTracker->track(Engine::MemoryCategory::RENDER_TARGET, key.getSize());
+            }
         }
     } else {
         handle = mBackend.createTexture(
@@ -201,6 +243,9 @@ backend::TextureHandle ResourceAllocator::createTexture(const char* name,
             mBackend.destroyTexture(handle);
             handle = swizzledHandle;
         }
+        if (mMemoryTracker) {
+            mMemoryTracker->track(Engine::MemoryCategory::RENDER_TARGET, key.getSize());
+        }
     }
     mDisposer->checkout(handle, key);
     mBackend.setDebugTag(handle.getId(), CString{ name });
@@ -217,6 +262,9 @@ void ResourceAllocator::destroyTexture(TextureHandle h) noexcept {
             mCacheSizeHiWaterMark = std::max(mCacheSizeHiWaterMark, mCacheSize);
         }
     } else {
+        if (mMemoryTracker && key.has_value()) {
+            mMemoryTracker->release(Engine::MemoryCategory::RENDER_TARGET, key.value().getSize());
+        }
         mBackend.destroyTexture(h);
     }
 }
@@ -225,6 +273,11 @@ ResourceAllocatorDisposerInterface& ResourceAllocator::getDisposer() noexcept {
     return *mDisposer;
 }
 
+ResourceAllocator::CacheStats ResourceAllocator::getCacheStats() const noexcept {
+    return { mCacheHits, mCacheMisses,
+             uint32_t(mTextureCache.size()), mCacheSize, mCacheSizeHiWaterMark };
+}
+
 void ResourceAllocator::gc(bool skippedFrame) noexcept {
     // this is called regularly -- usually once per frame
 
@@ -286,6 +339,40 @@ void ResourceAllocator::gc(bool skippedFrame) noexcept {
             }
         }
     }
+
+    // Size pressure: when the cache exceeds its byte budget, evict until it fits, regardless of
+    // age. Entries whose dimensions don't match any size requested this frame go first -- after
+    // a dynamic-resolution step these are dead sizes that would otherwise age out slowly while
+    // the new sizes get allocated from scratch on top of them. Within each group we evict oldest
+    // first, breaking ties on the larger entry.
+    if (UTILS_UNLIKELY(mCacheSize > mCacheMaxSize)) {
+        auto const isRecentSize = [this](TextureKey const& k) {
+            return std::find(mRecentSizes.begin(), mRecentSizes.end(),
+                    std::pair<uint32_t, uint32_t>{ k.width, k.height }) != mRecentSizes.end();
+        };
+        for (int pass = 0; pass < 2 && mCacheSize > mCacheMaxSize; pass++) {
+            while (mCacheSize > mCacheMaxSize) {
+                auto candidate = textureCache.end();
+                for (auto it = textureCache.begin(); it != textureCache.end(); ++it) {
+                    if (pass == 0 && isRecentSize(it->first)) {
+                        continue;
+                    }
+                    if (candidate == textureCache.end() ||
+                            it->second.age < candidate->second.age ||
+                            (it->second.age == candidate->second.age &&
+                                    it->second.size > candidate->second.size)) {
+                        candidate = it;
+                    }
+                }
+                if (candidate == textureCache.end()) {
+                    break;
+                }
+                purge(candidate);
+            }
+        }
+    }
+
+    mRecentSizes.clear();
 }
 
 UTILS_NOINLINE
@@ -294,6 +381,8 @@ void ResourceAllocator::dump(bool brief) const noexcept {
     slog.d  << "# entries=" << mTextureCache.size()
             << ", sz=" << (float)mCacheSize * MiB << " MiB"
             << ", max=" << (float)mCacheSizeHiWaterMark * MiB << " MiB"
+            << ", hits=" << mCacheHits
+            << ", misses=" << mCacheMisses
             << io::endl;
     if (!brief) {
         for (auto const& it : mTextureCache) {
@@ -310,6 +399,9 @@ ResourceAllocator::CacheContainer::iterator
 ResourceAllocator::purge(
         ResourceAllocator::CacheContainer::iterator const& pos) {
     //slog.d << "purging " << pos->second.handle.getId() << ", age=" << pos->second.age << io::endl;
+    if (mMemoryTracker) {
+        mMemoryTracker->release(Engine::MemoryCategory::RENDER_TARGET, pos->second.size);
+    }
     mBackend.destroyTexture(pos->second.handle);
     mCacheSize -= pos->second.size;
     return mTextureCache.erase(pos);
@@ -333,6 +425,10 @@ void ResourceAllocatorDisposer::destroy(backend::TextureHandle handle) noexcept
     if (handle) {
         auto r = checkin(handle);
         if (r.has_value()) {
+            if (mMemoryTracker) {
+                mMemoryTracker->release(Engine::MemoryCategory::RENDER_TARGET,
+                        r.value().getSize());
+            }
             mBackend.destroyTexture(handle);
         }
     }
@@ -39,6 +39,7 @@
 
 namespace filament {
 
+class GpuMemoryTracker;
 class ResourceAllocatorDisposer;
 
 // The only reason we use an interface here is for unit-tests, so we can mock this allocator.
@@ -115,6 +116,21 @@ public:
 
     void gc(bool skippedFrame = false) noexcept;
 
+    //! cache effectiveness counters, for debugging and profiling
+    struct CacheStats {
+        uint32_t hits = 0;              //!< createTexture() calls served from the cache
+        uint32_t misses = 0;            //!< createTexture() calls that allocated a new texture
+        uint32_t entryCount = 0;        //!< current number of cached entries
+        uint32_t sizeBytes = 0;         //!< current estimated size of the cache
+        uint32_t sizeHiWaterMark = 0;   //!< high-water mark of the cache size
+    };
+
+    CacheStats getCacheStats() const noexcept;
+
+    // Optional: reports allocations to the engine's GPU memory tracker under
+    // MemoryCategory::RENDER_TARGET. May be nullptr (e.g. in unit tests).
+    void setMemoryTracker(GpuMemoryTracker* tracker) noexcept { mMemoryTracker = tracker; }
+
 private:
     size_t const mCacheMaxAge;
 
@@ -219,11 +235,18 @@ private:
     purge(ResourceAllocator::CacheContainer::iterator const& pos);
 
     backend::DriverApi& mBackend;
+    GpuMemoryTracker* mMemoryTracker = nullptr;
     std::shared_ptr<ResourceAllocatorDisposer> mDisposer;
     CacheContainer mTextureCache;
     size_t mAge = 0;
     uint32_t mCacheSize = 0;
     uint32_t mCacheSizeHiWaterMark = 0;
+    uint32_t mCacheHits = 0;
+    uint32_t mCacheMisses = 0;
+    size_t const mCacheMaxSize;
+    // (width, height) of textures requested since the last gc(), used to recognize entries
+    // whose dimensions are dead after a dynamic-resolution step
+    std::vector<std::pair<uint32_t, uint32_t>> mRecentSizes;
     static constexpr bool mEnabled = true;
 
     friend class ResourceAllocatorDisposer;
@@ -237,6 +260,9 @@ public:
     void terminate() noexcept;
     void destroy(backend::TextureHandle handle) noexcept override;
 
+    // see ResourceAllocator::setMemoryTracker()
+    void setMemoryTracker(GpuMemoryTracker* tracker) noexcept { mMemoryTracker = tracker; }
+
 private:
     friend class ResourceAllocator;
     void checkout(backend::TextureHandle handle, TextureKey key);
@@ -244,6 +270,7 @@ private:
 
     using InUseContainer = ResourceAllocator::AssociativeContainer<backend::TextureHandle, TextureKey>;
     backend::DriverApi& mBackend;
+    GpuMemoryTracker* mMemoryTracker = nullptr;
     InUseContainer mInUseTextures;
 };
 
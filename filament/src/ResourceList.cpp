@@ -16,6 +16,7 @@
 
 #include "ResourceList.h"
 
+#include <utils/debug.h>
 #include <utils/Log.h>
 
 #include <algorithm>
@@ -38,26 +39,53 @@ ResourceListBase::~ResourceListBase() noexcept {
 }
 
 void ResourceListBase::insert(void* item) {
-    mList.insert(item);
+    auto const [pos, inserted] = mIndex.insert({ item, uint32_t(mList.size()) });
+    if (inserted) {
+        mList.push_back(item);
+        mGeneration++;
+    }
 }
 
 bool ResourceListBase::remove(void const* item) {
-    return mList.erase(const_cast<void*>(item)) > 0;
+    auto const pos = mIndex.find(const_cast<void*>(item));
+    if (pos == mIndex.end()) {
+        return false;
+    }
+    // swap-remove from the dense array so it stays compact
+    uint32_t const index = pos->second;
+    void* const last = mList.back();
+    mList[index] = last;
+    mList.pop_back();
+    mIndex.erase(pos);
+    if (last != item) {
+        mIndex[last] = index;
+    }
+    mGeneration++;
+    return true;
 }
 
 auto ResourceListBase::find(void const* item) -> iterator {
-    return mList.find(const_cast<void*>(item));
+    auto const pos = mIndex.find(const_cast<void*>(item));
+    if (pos == mIndex.end()) {
+        return mList.end();
+    }
+    return mList.begin() + pos->second;
 }
 
 void ResourceListBase::clear() noexcept {
     mList.clear();
+    mIndex.clear();
+    mGeneration++;
 }
 
 // this is not inlined, so we don't pay the code-size cost of iterating the list
 void ResourceListBase::forEach(void (* f)(void*, void*), void* user) const noexcept {
+    UTILS_UNUSED_IN_RELEASE uint32_t const generation = mGeneration;
     std::for_each(mList.begin(), mList.end(), [=](void* p) {
         f(user, p);
     });
+    // the callback must not create or destroy resources of the list being traversed
+    assert_invariant(generation == mGeneration);
 }
 
 } // namespace filament
@@ -19,7 +19,9 @@
 
 #include <utils/compiler.h>
 
-#include <tsl/robin_set.h>
+#include <tsl/robin_map.h>
+
+#include <vector>
 
 #include <stdint.h>
 
@@ -27,8 +29,8 @@ namespace filament {
 
 class ResourceListBase {
 public:
-    using iterator = typename tsl::robin_set<void*>::iterator;
-    using const_iterator = typename tsl::robin_set<void*>::const_iterator;
+    using iterator = typename std::vector<void*>::iterator;
+    using const_iterator = typename std::vector<void*>::const_iterator;
 
     explicit ResourceListBase(const char* typeName);
     ResourceListBase(ResourceListBase&& rhs) noexcept = default;
@@ -69,7 +71,14 @@ public:
 
 protected:
     void forEach(void(*f)(void* user, void *p), void* user) const noexcept;
-    tsl::robin_set<void*> mList;
+    // The resources are kept in a dense array, in creation order, so that traversal -- in
+    // particular the destruction-heavy forEach() of engine teardown -- walks memory in
+    // allocation order instead of hash order. remove() is a swap-remove, which keeps the
+    // array compact while preserving creation locality. The map provides O(1) find/remove.
+    std::vector<void*> mList;
+    tsl::robin_map<void*, uint32_t> mIndex;
+    // bumped on every mutation; used to assert the list isn't modified during iteration
+    uint32_t mGeneration = 0;
 #ifndef NDEBUG
 private:
     // removing this saves 8-bytes because of padding of derived classes
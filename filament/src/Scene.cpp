@@ -35,6 +35,10 @@ void Scene::setIndirectLight(IndirectLight* ibl) noexcept {
     downcast(this)->setIndirectLight(downcast(ibl));
 }
 
+void Scene::setEnvironment(IndirectLight* ibl, Skybox* skybox) noexcept {
+    downcast(this)->setEnvironment(downcast(ibl), downcast(skybox));
+}
+
 IndirectLight* Scene::getIndirectLight() const noexcept {
     return downcast(this)->getIndirectLight();
 }
@@ -55,6 +59,24 @@ void Scene::removeEntities(const Entity* entities, size_t count) {
     downcast(this)->removeEntities(entities, count);
 }
 
+Scene::PartitionId Scene::addPartition(const Entity* entities, size_t count,
+        size_t sizeInBytes) {
+    return downcast(this)->addPartition(entities, count, sizeInBytes);
+}
+
+void Scene::removePartition(PartitionId id) noexcept {
+    downcast(this)->removePartition(id);
+}
+
+void Scene::setPartitionBudget(size_t budgetInBytes,
+        Invocable<void(PartitionId)>&& evictionCallback) noexcept {
+    downcast(this)->setPartitionBudget(budgetInBytes, std::move(evictionCallback));
+}
+
+size_t Scene::getPartitionMemoryUsage() const noexcept {
+    return downcast(this)->getPartitionMemoryUsage();
+}
+
 size_t Scene::getEntityCount() const noexcept {
     return downcast(this)->getEntityCount();
 }
@@ -75,4 +97,9 @@ void Scene::forEach(Invocable<void(utils::Entity)>&& functor) const noexcept {
     downcast(this)->forEach(std::move(functor));
 }
 
+Entity Scene::raycast(math::float3 const origin, math::float3 const direction,
+        float const tMax) const noexcept {
+    return downcast(this)->raycast(origin, direction, tMax);
+}
+
 } // namespace filament
@@ -35,6 +35,7 @@
 #include <utils/Slice.h>
 #include <utils/Systrace.h>
 
+#include <math/batch.h>
 #include <math/vec3.h>
 #include <math/vec4.h>
 #include <math/mat3.h>
@@ -92,6 +93,9 @@ void ShadowMap::initialize(size_t lightIndex, ShadowType shadowType,
     mOptions = options;
     mShadowType = shadowType;
     mFace = face;
+    // the atlas allocation, if any, is reassigned in calculateTextureRequirements()
+    mAllocationOrigin = {};
+    mAllocatedDimension = 0;
 }
 
 math::mat4f ShadowMap::getDirectionalLightViewMatrix(math::float3 direction, math::float3 up,
@@ -271,7 +275,7 @@ ShadowMap::ShaderParameters ShadowMap::updatePunctual(
     const mat4f Mp = mat4f::perspective(
             outerConeAngle * f::RAD_TO_DEG * 2.0f, 1.0f, nearPlane, farPlane);
 
-    assert_invariant(shadowMapInfo.textureDimension == mOptions->mapSize);
+    assert_invariant(shadowMapInfo.textureDimension == getTextureDimension());
 
     // Final shadow transform
     const mat4f S = math::highPrecisionMultiply(Mp, Mv);
@@ -757,9 +761,12 @@ mat4f ShadowMap::directionalLightFrustum(float near, float far) noexcept {
 float2 ShadowMap::computeNearFar(const mat4f& view,
         float3 const* wsVertices, size_t count) noexcept {
     float2 nearFar = { std::numeric_limits<float>::lowest(), std::numeric_limits<float>::max() };
+    assert_invariant(count <= std::tuple_size_v<FrustumBoxIntersection>);
+    FrustumBoxIntersection lsVertices;
+    batch::projectPoints(view, wsVertices, lsVertices.data(), count);
     for (size_t i = 0; i < count; i++) {
         // we're on the z axis in light space (looking down to -z)
-        float const c = mat4f::project(view, wsVertices[i]).z;
+        float const c = lsVertices[i].z;
         nearFar.x = std::max(nearFar.x, c);  // near
         nearFar.y = std::min(nearFar.y, c);  // far
     }
@@ -769,10 +776,12 @@ float2 ShadowMap::computeNearFar(const mat4f& view,
 float2 ShadowMap::computeNearFarOfWarpSpace(mat4f const& lightView,
         float3 const* wsVertices, size_t count) noexcept {
     float2 nearFar = { std::numeric_limits<float>::max(), std::numeric_limits<float>::lowest() };
-    #pragma nounroll
+    assert_invariant(count <= std::tuple_size_v<FrustumBoxIntersection>);
+    FrustumBoxIntersection lsVertices;
+    batch::projectPoints(lightView, wsVertices, lsVertices.data(), count);
     for (size_t i = 0; i < count; i++) {
         // we're on the y-axis in light space (looking down to +y)
-        float const c = mat4f::project(lightView, wsVertices[i]).y;
+        float const c = lsVertices[i].y;
         nearFar.x = std::min(nearFar.x, c);
         nearFar.y = std::max(nearFar.y, c);
     }
@@ -839,9 +848,8 @@ ShadowMap::Corners ShadowMap::computeFrustumCorners(
             }
     };
 
-    for (size_t i = 0; i < csViewFrustumCorners.size(); i++) {
-        out[i] = mat4f::project(projectionInverse, csViewFrustumCorners[i]);
-    }
+    batch::projectPoints(projectionInverse,
+            csViewFrustumCorners.vertices, out.vertices, out.size());
 
     return out;
 }
@@ -1303,9 +1311,10 @@ backend::Viewport ShadowMap::getViewport() const noexcept {
     // or when shadowFar is smaller than the camera far.
     // For spot- and point-lights we also use a 1-texel border, so that bilinear filtering
     // can work properly if the shadowmap is in an atlas (and we can't rely on h/w clamp).
-    const uint32_t dim = mOptions->mapSize;
+    const uint32_t dim = getTextureDimension();
     const uint16_t border = 1u;
-    return { border, border, dim - 2u * border, dim - 2u * border };
+    return { mAllocationOrigin.x + border, mAllocationOrigin.y + border,
+             dim - 2u * border, dim - 2u * border };
 }
 
 backend::Viewport ShadowMap::getScissor() const noexcept {
@@ -1315,14 +1324,15 @@ backend::Viewport ShadowMap::getScissor() const noexcept {
     // For spot- and point-lights we also use a 1-texel border, so that bilinear filtering
     // can work properly if the shadowmap is in an atlas (and we can't rely on h/w clamp), so we
     // don't scissor the border, so it gets filled with correct neighboring texels.
-    const uint32_t dim = mOptions->mapSize;
+    const uint32_t dim = getTextureDimension();
     const uint16_t border = 1u;
     switch (mShadowType) {
         case ShadowType::DIRECTIONAL:
-            return { border, border, dim - 2u * border, dim - 2u * border };
+            return { mAllocationOrigin.x + border, mAllocationOrigin.y + border,
+                     dim - 2u * border, dim - 2u * border };
         case ShadowType::SPOT:
         case ShadowType::POINT:
-            return { 0, 0, dim, dim };
+            return { mAllocationOrigin.x, mAllocationOrigin.y, dim, dim };
     }
 }
 
@@ -1344,9 +1354,9 @@ math::float4 ShadowMap::getClampToEdgeCoords(ShadowMapInfo const& shadowMapInfo)
     }
 
     float const texel = 1.0f / float(shadowMapInfo.atlasDimension);
-    float const dim = float(mOptions->mapSize);
-    float const l = border;
-    float const b = border;
+    float const dim = float(getTextureDimension());
+    float const l = float(mAllocationOrigin.x) + border;
+    float const b = float(mAllocationOrigin.y) + border;
     float const w = dim - 2.0f * border;
     float const h = dim - 2.0f * border;
     float4 const v = float4{ l, b, l + w, b + h } * texel;
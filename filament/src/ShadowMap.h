@@ -33,6 +33,7 @@
 #include <utils/compiler.h>
 
 #include <math/mathfwd.h>
+#include <math/vec2.h>
 #include <math/vec3.h>
 #include <math/vec4.h>
 #include <math/mat4.h>
@@ -181,6 +182,21 @@ public:
     uint16_t getShadowIndex() const { return mShadowIndex; }
     void setLayer(uint8_t layer) noexcept { mLayer = layer; }
     uint8_t getLayer() const noexcept { return mLayer; }
+
+    // Sets the sub-region of our atlas layer, used when dynamic resolution packs several
+    // shadow maps into a single layer. A dimension of 0 (the default) means the map
+    // occupies a full layer at the requested mapSize.
+    void setAllocation(uint16_t left, uint16_t bottom, uint16_t dimension) noexcept {
+        mAllocationOrigin = { left, bottom };
+        mAllocatedDimension = dimension;
+    }
+
+    // The dimension actually used by this shadow map within the atlas; equal to the
+    // requested mapSize unless dynamic resolution allocated a smaller region.
+    uint16_t getTextureDimension() const noexcept {
+        return mAllocatedDimension ? mAllocatedDimension : uint16_t(mOptions->mapSize);
+    }
+
     backend::Viewport getViewport() const noexcept;
     backend::Viewport getScissor() const noexcept;
 
@@ -349,6 +365,8 @@ private:
     LightManager::ShadowOptions const* mOptions = nullptr;                  // 8
     uint32_t mLightIndex = 0;   // which light are we shadowing             // 4
     uint16_t mShadowIndex = 0;  // our index in the shadowMap vector        // 2
+    math::ushort2 mAllocationOrigin{}; // our position within our layer     // 4
+    uint16_t mAllocatedDimension = 0;  // our size in the layer, 0 = mapSize// 2
     uint8_t mLayer = 0;         // our layer in the shadowMap texture       // 1
     ShadowType mShadowType  : 2;                                            // :2
     bool mHasVisibleShadows : 2;                                            // :2
@@ -15,6 +15,7 @@
  */
 
 #include "ShadowMapManager.h"
+#include "AtlasAllocator.h"
 #include "RenderPass.h"
 #include "ShadowMap.h"
 
@@ -43,6 +44,8 @@
 #include <utils/debug.h>
 #include <utils/FixedCapacityVector.h>
 #include <utils/BitmaskEnum.h>
+#include <utils/Hash.h>
+#include <utils/JobSystem.h>
 #include <utils/Range.h>
 #include <utils/Slice.h>
 
@@ -60,6 +63,7 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include <string.h>
 
 namespace filament {
 
@@ -75,6 +79,10 @@ ShadowMapManager::ShadowMapManager(FEngine& engine)
             &engine.debug.shadowmap.disable_light_frustum_align);
     debugRegistry.registerProperty("d.shadowmap.depth_clamp",
             &engine.debug.shadowmap.depth_clamp);
+    debugRegistry.registerProperty("d.shadowmap.cache_stable_maps",
+            &engine.debug.shadowmap.cache_stable_maps);
+    debugRegistry.registerProperty("d.shadowmap.dynamic_resolution",
+            &engine.debug.shadowmap.dynamic_resolution);
 }
 
 ShadowMapManager::~ShadowMapManager() {
@@ -102,6 +110,10 @@ void ShadowMapManager::terminate(FEngine& engine,
 }
 
 void ShadowMapManager::terminate(FEngine& engine) {
+    if (mCachedShadowAtlas) {
+        engine.getDriverApi().destroyTexture(mCachedShadowAtlas);
+        mCachedShadowAtlas.clear();
+    }
     if (UTILS_UNLIKELY(mInitialized)) {
         DriverApi& driver = engine.getDriverApi();
         driver.destroyBufferObject(mShadowUbh);
@@ -150,7 +162,7 @@ ShadowMapManager::ShadowTechnique ShadowMapManager::update(
 
     ShadowTechnique shadowTechnique = {};
 
-    calculateTextureRequirements(engine, view, lightData);
+    calculateTextureRequirements(engine, view, cameraInfo, lightData);
 
     // Compute scene-dependent values shared across all shadow maps
     ShadowMap::SceneInfo const info{ *view.getScene(), view.getVisibleLayers() };
@@ -211,6 +223,49 @@ ShadowMapManager::Builder& ShadowMapManager::Builder::shadowMap(size_t lightInde
     return *this;
 }
 
+// Hash of everything that can affect the content of a shadow map layer: the shadow camera,
+// the world-space bounds, layer and visibility state of the potential casters, and the few
+// global toggles that change how the depth is rendered. Two identical hashes mean the layer's
+// content from last frame is still valid.
+static uint32_t computeShadowMapContentHash(ShadowMap const& shadowMap,
+        FScene::RenderableSoa const& renderableData, utils::Range<uint32_t> const range,
+        uint8_t const visibleLayers, bool const depthClamp) noexcept {
+    FCamera const& camera = shadowMap.getCamera();
+    mat4f const viewMatrix{ camera.getViewMatrix() };
+    mat4f const projectionMatrix{ camera.getProjectionMatrix() };
+    uint32_t hash = utils::hash::murmur3(
+            reinterpret_cast<uint32_t const*>(&viewMatrix),
+            sizeof(viewMatrix) / sizeof(uint32_t), 0);
+    hash = utils::hash::murmur3(
+            reinterpret_cast<uint32_t const*>(&projectionMatrix),
+            sizeof(projectionMatrix) / sizeof(uint32_t), hash);
+    if (range.size()) {
+        float3 const* const center = renderableData.data<FScene::WORLD_AABB_CENTER>();
+        float3 const* const extent = renderableData.data<FScene::WORLD_AABB_EXTENT>();
+        uint8_t const* const layers = renderableData.data<FScene::LAYERS>();
+        auto const* const visibility = renderableData.data<FScene::VISIBILITY_STATE>();
+        hash = utils::hash::murmur3(
+                reinterpret_cast<uint32_t const*>(center + range.first),
+                range.size() * sizeof(float3) / sizeof(uint32_t), hash);
+        hash = utils::hash::murmur3(
+                reinterpret_cast<uint32_t const*>(extent + range.first),
+                range.size() * sizeof(float3) / sizeof(uint32_t), hash);
+        hash = utils::hash::murmurSlow(layers + range.first, range.size(), hash);
+        hash = utils::hash::murmurSlow(
+                reinterpret_cast<uint8_t const*>(visibility + range.first),
+                range.size() * sizeof(*visibility), hash);
+    }
+    // the sub-region of the layer the map renders into (it can move or be resized when
+    // dynamic resolution is enabled)
+    backend::Viewport const viewport = shadowMap.getViewport();
+    hash = utils::hash::murmur3(
+            reinterpret_cast<uint32_t const*>(&viewport),
+            sizeof(viewport) / sizeof(uint32_t), hash);
+    uint32_t const flags = uint32_t(shadowMap.getLayer()) |
+            (uint32_t(visibleLayers) << 8u) | (uint32_t(depthClamp) << 16u);
+    return utils::hash::murmur3(&flags, 1, hash);
+}
+
 FrameGraphId<FrameGraphTexture> ShadowMapManager::render(FEngine& engine, FrameGraph& fg,
         RenderPassBuilder const& passBuilder,
         FView& view, CameraInfo const& mainCameraInfo,
@@ -227,6 +282,45 @@ FrameGraphId<FrameGraphTexture> ShadowMapManager::render(FEngine& engine, FrameG
     const TextureAtlasRequirements textureRequirements = mTextureAtlasRequirements;
     assert_invariant(textureRequirements.layers <= CONFIG_MAX_SHADOW_LAYERS);
 
+    // Shadow-map caching: when enabled, we render into a persistent atlas that we own and
+    // import into the FrameGraph, so that the layers of shadow maps whose light and caster
+    // set haven't changed can simply keep last frame's content. VSM is excluded because its
+    // shadow maps go through blur/mipmap post-processing passes.
+    bool const cacheStableMaps =
+            engine.debug.shadowmap.cache_stable_maps && !view.hasVSM();
+    FrameGraphId<FrameGraphTexture> importedShadows;
+    if (UTILS_UNLIKELY(cacheStableMaps)) {
+        if (!mCachedShadowAtlas ||
+                mCachedAtlasRequirements.size != textureRequirements.size ||
+                mCachedAtlasRequirements.layers != textureRequirements.layers ||
+                mCachedAtlasRequirements.levels != textureRequirements.levels ||
+                mCachedAtlasRequirements.format != textureRequirements.format) {
+            DriverApi& driver = engine.getDriverApi();
+            if (mCachedShadowAtlas) {
+                driver.destroyTexture(mCachedShadowAtlas);
+            }
+            mCachedShadowAtlas = driver.createTexture(
+                    SamplerType::SAMPLER_2D_ARRAY, textureRequirements.levels,
+                    textureRequirements.format, 1,
+                    textureRequirements.size, textureRequirements.size,
+                    textureRequirements.layers,
+                    TextureUsage::DEPTH_ATTACHMENT | TextureUsage::SAMPLEABLE);
+            mCachedAtlasRequirements = textureRequirements;
+            mCachedLayerHash.fill(0);
+        }
+        importedShadows = fg.import("Shadowmap", {
+                        .width = textureRequirements.size, .height = textureRequirements.size,
+                        .depth = textureRequirements.layers,
+                        .levels = textureRequirements.levels,
+                        .type = SamplerType::SAMPLER_2D_ARRAY,
+                        .format = textureRequirements.format },
+                TextureUsage::DEPTH_ATTACHMENT | TextureUsage::SAMPLEABLE,
+                FrameGraphTexture{ .handle = mCachedShadowAtlas });
+    } else {
+        // force a full re-render if caching is re-enabled later
+        mCachedLayerHash.fill(0);
+    }
+
     // -------------------------------------------------------------------------------------------
     // Prepare Shadow Pass
     // -------------------------------------------------------------------------------------------
@@ -249,17 +343,39 @@ FrameGraphId<FrameGraphTexture> ShadowMapManager::render(FEngine& engine, FrameG
     auto& prepareShadowPass = fg.addPass<PrepareShadowPassData>("Prepare Shadow Pass",
             [&](FrameGraph::Builder& builder, auto& data) {
                 data.passList.reserve(CONFIG_MAX_SHADOWMAPS);
-                data.shadows = builder.createTexture("Shadowmap", {
-                        .width = textureRequirements.size, .height = textureRequirements.size,
-                        .depth = textureRequirements.layers,
-                        .levels = textureRequirements.levels,
-                        .type = SamplerType::SAMPLER_2D_ARRAY,
-                        .format = textureRequirements.format
-                });
+                data.shadows = UTILS_UNLIKELY(cacheStableMaps) ? importedShadows
+                        : builder.createTexture("Shadowmap", {
+                                .width = textureRequirements.size,
+                                .height = textureRequirements.size,
+                                .depth = textureRequirements.layers,
+                                .levels = textureRequirements.levels,
+                                .type = SamplerType::SAMPLER_2D_ARRAY,
+                                .format = textureRequirements.format
+                        });
 
                 // these loops create a list of the shadow maps that might need to be rendered
                 auto& passList = data.passList;
 
+                // with caching enabled, a shadow map whose content hash matches what's
+                // already in its atlas layer doesn't need a pass at all
+                auto isCached = [&](ShadowMap const& shadowMap,
+                        utils::Range<uint32_t> const range) -> bool {
+                    if (UTILS_LIKELY(!cacheStableMaps)) {
+                        return false;
+                    }
+                    bool const depthClamp =
+                            shadowMap.getShadowType() == ShadowType::DIRECTIONAL &&
+                            mIsDepthClampSupported && engine.debug.shadowmap.depth_clamp;
+                    uint32_t const h = computeShadowMapContentHash(shadowMap,
+                            scene->getRenderableData(), range,
+                            view.getVisibleLayers(), depthClamp);
+                    if (h == mCachedLayerHash[shadowMap.getLayer()]) {
+                        return true;
+                    }
+                    mCachedLayerHash[shadowMap.getLayer()] = h;
+                    return false;
+                };
+
                 // Directional, cascaded shadow maps
                 // if the view has shadowing enabled, the SRE variant could be used, so we must
                 // generate the shadow maps
@@ -270,7 +386,8 @@ FrameGraphId<FrameGraphTexture> ShadowMapManager::render(FEngine& engine, FrameG
                         // if hasVisibleShadows() is false, we're guaranteed the shader won't
                         // sample this shadow map (see PerViewUib::cascades and
                         // ShadowMapManager::updateCascadeShadowMaps)
-                        if (shadowMap.hasVisibleShadows()) {
+                        if (shadowMap.hasVisibleShadows() &&
+                                !isCached(shadowMap, directionalShadowCastersRange)) {
                             passList.push_back({
                                     {}, &shadowMap, directionalShadowCastersRange,
                                     VISIBLE_DIR_SHADOW_RENDERABLE });
@@ -301,14 +418,18 @@ FrameGraphId<FrameGraphTexture> ShadowMapManager::render(FEngine& engine, FrameG
                         }
 
                         // For spot/point lights, shadowMap.hasVisibleShadows() doesn't guarantee
-                        // the shader won't access the shadow map, so we must generate it.
-                        passList.push_back({
-                                {}, &shadowMap, spotShadowCastersRange,
-                                VISIBLE_DYN_SHADOW_RENDERABLE });
+                        // the shader won't access the shadow map, so we must generate it --
+                        // unless its atlas layer already holds this exact content.
+                        if (!isCached(shadowMap, spotShadowCastersRange)) {
+                            passList.push_back({
+                                    {}, &shadowMap, spotShadowCastersRange,
+                                    VISIBLE_DYN_SHADOW_RENDERABLE });
+                        }
                     }
                 }
 
-                assert_invariant(passList.size() <= textureRequirements.layers);
+                // with dynamic resolution, several shadow maps can share an atlas layer
+                assert_invariant(passList.size() <= CONFIG_MAX_SHADOWMAPS);
 
                 // This pass must be declared as having a side effect because it never gets a
                 // "read" from one of its resource (only writes), so the FrameGraph culls it.
@@ -319,15 +440,136 @@ FrameGraphId<FrameGraphTexture> ShadowMapManager::render(FEngine& engine, FrameG
                     &view = const_cast<FView const&>(view)]
                     (FrameGraphResources const&, auto const& data, DriverApi& driver) mutable {
 
-                // Note: we could almost parallel_for the loop below, the problem currently is
-                // that updatePrimitivesLod() updates temporary global state.
-                // prepareSpotShadowMap() also update the visibility of renderable. These two
-                // pieces of state are needed only until shadowMap.render() returns.
-                // Conceptually, we could store this out-of-band.
+                // Note: we can't parallel_for the command generation loop below, because
+                // updatePrimitivesLod() updates temporary global state and the DriverApi
+                // can only be used from a single thread. However, the culling of each
+                // shadow map is independent CPU-only work, so we run all of them in
+                // parallel first, each one writing its visibility results into a private
+                // scratch buffer (the out-of-band storage alluded to below). The serial
+                // loop then just copies each result into scene->getRenderableData()
+                // before generating the commands for that shadow map.
+
+                auto& js = engine.getJobSystem();
+                size_t const passCount = data.passList.size();
+
+                auto scratchVisibleMasks =
+                        utils::FixedCapacityVector<utils::FixedCapacityVector<Culler::result_type>>::
+                                with_capacity(passCount);
+
+                // When several lights need culling, build conservative per-light caster
+                // candidate lists in one shared sweep (light bounding sphere vs. renderable
+                // AABB); each shadow map below then only frustum-tests its light's
+                // candidates instead of re-sweeping the whole range. Point lights benefit
+                // twice, since their six faces share a single candidate list.
+                utils::FixedCapacityVector<size_t> culledLights =
+                        utils::FixedCapacityVector<size_t>::with_capacity(passCount);
+                utils::FixedCapacityVector<uint32_t> entryToLightSlot =
+                        utils::FixedCapacityVector<uint32_t>::with_capacity(passCount);
+                utils::Range<uint32_t> candidatesRange{ 0, 0 };
+                for (auto const& entry : data.passList) {
+                    ShadowMap const& shadowMap = *entry.shadowMap;
+                    if (shadowMap.getShadowType() == ShadowType::DIRECTIONAL ||
+                            !shadowMap.hasVisibleShadows()) {
+                        entryToLightSlot.push_back(uint32_t(-1));
+                        continue;
+                    }
+                    size_t const lightIndex = shadowMap.getLightIndex();
+                    auto pos = std::find(culledLights.begin(), culledLights.end(), lightIndex);
+                    if (pos == culledLights.end()) {
+                        culledLights.push_back(lightIndex);
+                        pos = culledLights.end() - 1;
+                    }
+                    entryToLightSlot.push_back(uint32_t(pos - culledLights.begin()));
+                    // all spot/point shadow maps cull against the same range by construction
+                    assert_invariant(candidatesRange.empty() ||
+                            (candidatesRange.first == entry.range.first &&
+                             candidatesRange.last == entry.range.last));
+                    candidatesRange = entry.range;
+                }
 
-                // Generate a RenderPass for each shadow map
+                utils::FixedCapacityVector<utils::FixedCapacityVector<uint32_t>> candidates;
+                bool const useCandidates = culledLights.size() >= 2;
+                if (useCandidates) {
+                    candidates = utils::FixedCapacityVector<
+                            utils::FixedCapacityVector<uint32_t>>::with_capacity(culledLights.size());
+                    for (size_t i = 0, c = culledLights.size(); i < c; i++) {
+                        candidates.push_back(utils::FixedCapacityVector<uint32_t>::with_capacity(
+                                candidatesRange.size()));
+                    }
+                    computeShadowCasterCandidates(scene->getRenderableData(), candidatesRange,
+                            scene->getLightData(),
+                            { culledLights.data(), culledLights.size() },
+                            candidates);
+                }
+
+                auto* parent = js.createJob();
+                size_t entryIndex = 0;
                 for (auto const& entry : data.passList) {
                     ShadowMap const& shadowMap = *entry.shadowMap;
+                    uint32_t const lightSlot = entryToLightSlot[entryIndex++];
+                    auto& scratch = scratchVisibleMasks.emplace_back();
+                    if (shadowMap.getShadowType() == ShadowType::DIRECTIONAL ||
+                            !shadowMap.hasVisibleShadows()) {
+                        // directional cascades are culled in updateCascadeShadowMaps(),
+                        // and invisible shadow maps don't need culling at all
+                        continue;
+                    }
+                    // the scalar per-candidate test only pays off when the light's sphere
+                    // rejected most of the range; otherwise keep the flat vectorized sweep
+                    utils::FixedCapacityVector<uint32_t> const* pCandidates = nullptr;
+                    if (useCandidates && candidates[lightSlot].size() * 4 < candidatesRange.size()) {
+                        pCandidates = &candidates[lightSlot];
+                    }
+                    // Culler and updateSpotVisibilityMasks() both assume a capacity rounded
+                    // to their vectorization width, like the VISIBLE_MASK column has.
+                    size_t const paddedCount = (entry.range.size() + 0xFu) & ~0xFu;
+                    scratch = utils::FixedCapacityVector<Culler::result_type>(paddedCount);
+                    auto* job = utils::jobs::createJob(js, parent,
+                            [&engine, &view, scene, pEntry = &entry, pCandidates,
+                                    visibleArray = scratch.data(), paddedCount]() {
+                        ShadowMap const& shadowMap = *pEntry->shadowMap;
+                        // seed the scratch buffer with the current masks, we only own the
+                        // VISIBLE_DYN_SHADOW_RENDERABLE bit
+                        memcpy(visibleArray,
+                                scene->getRenderableData().data<FScene::VISIBLE_MASK>() +
+                                        pEntry->range.first, paddedCount);
+                        if (pCandidates) {
+                            ShadowMapManager::cullShadowMapFromCandidates(shadowMap, engine,
+                                    view, scene->getRenderableData(), pEntry->range,
+                                    scene->getLightData(), *pCandidates, visibleArray);
+                            return;
+                        }
+                        switch (shadowMap.getShadowType()) {
+                            case ShadowType::DIRECTIONAL:
+                                // we should never be here
+                                break;
+                            case ShadowType::SPOT:
+                                ShadowMapManager::cullSpotShadowMap(shadowMap, engine, view,
+                                        scene->getRenderableData(), pEntry->range,
+                                        scene->getLightData(), visibleArray);
+                                break;
+                            case ShadowType::POINT:
+                                ShadowMapManager::cullPointShadowMap(shadowMap, engine, view,
+                                        scene->getRenderableData(), pEntry->range,
+                                        scene->getLightData(), visibleArray);
+                                break;
+                        }
+                    });
+                    js.run(job);
+                }
+                js.runAndWait(parent);
+
+                // Generate a RenderPass for each shadow map
+                //
+                // Passes built in this loop are kept alive until the loop ends, so that
+                // entries with identical culling results can obtain an executor sharing
+                // the same commands (executors remain valid after the pass is destroyed).
+                std::vector<RenderPass> builtPasses;
+                std::vector<ssize_t> entryToPass(passCount, -1);
+                builtPasses.reserve(passCount);
+                for (size_t i = 0; i < passCount; i++) {
+                    auto const& entry = data.passList[i];
+                    ShadowMap const& shadowMap = *entry.shadowMap;
 
                     // Note: this loop can generate a lot of commands that come out of the
                     //       "per frame command arena". The allocation persists until the
@@ -338,26 +580,13 @@ FrameGraphId<FrameGraphTexture> ShadowMapManager::render(FEngine& engine, FrameG
                     //       To do this efficiently, we'd need a way to cull draw calls already
                     //       recorded in the command buffer, per shadow map.
 
-                    // Note: the output of culling below is stored in scene->getRenderableData()
-
-                    switch (shadowMap.getShadowType()) {
-                        case ShadowType::DIRECTIONAL:
-                            // we should never be here
-                            break;
-                        case ShadowType::SPOT:
-                            if (shadowMap.hasVisibleShadows()) {
-                                ShadowMapManager::cullSpotShadowMap(shadowMap, engine, view,
-                                        scene->getRenderableData(), entry.range,
-                                        scene->getLightData());
-                            }
-                            break;
-                        case ShadowType::POINT:
-                            if (shadowMap.hasVisibleShadows()) {
-                                ShadowMapManager::cullPointShadowMap(shadowMap, view,
-                                        scene->getRenderableData(), entry.range,
-                                        scene->getLightData());
-                            }
-                            break;
+                    // publish this shadow map's culling results to
+                    // scene->getRenderableData(), where RenderPass expects them
+                    auto const& scratch = scratchVisibleMasks[i];
+                    if (!scratch.empty()) {
+                        memcpy(scene->getRenderableData().data<FScene::VISIBLE_MASK>() +
+                                        entry.range.first,
+                                scratch.data(), scratch.size());
                     }
 
                     // cameraInfo only valid after calling update
@@ -377,6 +606,28 @@ FrameGraphId<FrameGraphTexture> ShadowMapManager::render(FEngine& engine, FrameG
 
                     // generate and sort the commands for rendering the shadow map
 
+                    // Cascades (and point-light faces) often end up with the exact same
+                    // set of visible casters. Command generation is the expensive part of
+                    // this loop, and the commands depend only on the caster set and pass
+                    // flags -- the per-shadow-map camera lives in its descriptor set, bound
+                    // at execution time. So when an earlier entry covered the same range
+                    // with identical culling results, share its command buffer instead of
+                    // regenerating it.
+                    ssize_t shareWith = -1;
+                    for (size_t j = 0; j < i; j++) {
+                        auto const& prev = data.passList[j];
+                        if (prev.range.first == entry.range.first
+                                && prev.range.last == entry.range.last
+                                && prev.visibilityMask == entry.visibilityMask
+                                && prev.shadowMap->getShadowType() == shadowMap.getShadowType()
+                                && scratchVisibleMasks[j].size() == scratch.size()
+                                && !memcmp(scratchVisibleMasks[j].data(), scratch.data(),
+                                        scratch.size() * sizeof(Culler::result_type))) {
+                            shareWith = ssize_t(j);
+                            break;
+                        }
+                    }
+
                     RenderPass::RenderFlags renderPassFlags{};
 
                     bool const canUseDepthClamp =
@@ -389,15 +640,23 @@ FrameGraphId<FrameGraphTexture> ShadowMapManager::render(FEngine& engine, FrameG
                         renderPassFlags |= RenderPass::HAS_DEPTH_CLAMP;
                     }
 
-                    RenderPass const pass = passBuilder
-                            .renderFlags(RenderPass::HAS_DEPTH_CLAMP, renderPassFlags)
-                            .camera(cameraInfo)
-                            .visibilityMask(entry.visibilityMask)
-                            .geometry(scene->getRenderableData(), entry.range)
-                            .commandTypeFlags(RenderPass::CommandTypeFlags::SHADOW)
-                            .build(engine, driver);
-
-                    entry.executor = pass.getExecutor();
+                    if (shareWith >= 0) {
+                        assert_invariant(entryToPass[shareWith] >= 0);
+                        entryToPass[i] = entryToPass[shareWith];
+                        entry.executor = builtPasses[entryToPass[i]].getExecutor();
+                    } else {
+                        RenderPass pass = passBuilder
+                                .renderFlags(RenderPass::HAS_DEPTH_CLAMP, renderPassFlags)
+                                .camera(cameraInfo)
+                                .visibilityMask(entry.visibilityMask)
+                                .geometry(scene->getRenderableData(), entry.range)
+                                .commandTypeFlags(RenderPass::CommandTypeFlags::SHADOW)
+                                .build(engine, driver);
+
+                        entry.executor = pass.getExecutor();
+                        entryToPass[i] = ssize_t(builtPasses.size());
+                        builtPasses.push_back(std::move(pass));
+                    }
 
                     if (!view.hasVSM()) {
                         auto const* options = shadowMap.getShadowOptions();
@@ -429,8 +688,25 @@ FrameGraphId<FrameGraphTexture> ShadowMapManager::render(FEngine& engine, FrameG
     };
 
     auto const& passList = prepareShadowPass.getData().passList;
-    for (auto const& entry: passList) {
+    mShadowPassCount = uint32_t(passList.size());
+    for (size_t i = 0; i < passList.size(); i++) {
+        auto const& entry = passList[i];
         const uint8_t layer = entry.shadowMap->getLayer();
+
+        // With dynamic resolution, several shadow maps can live in the same atlas layer.
+        // The first entry of each layer creates the layer's render pass -- which clears the
+        // whole layer -- and that pass then draws every shadow map assigned to the layer.
+        bool firstOfLayer = true;
+        for (size_t j = 0; j < i; j++) {
+            if (passList[j].shadowMap->getLayer() == layer) {
+                firstOfLayer = false;
+                break;
+            }
+        }
+        if (!firstOfLayer) {
+            continue;
+        }
+
         const auto* options = entry.shadowMap->getShadowOptions();
         const auto msaaSamples = textureRequirements.msaaSamples;
         const bool blur = entry.shadowMap->hasVisibleShadows() &&
@@ -507,15 +783,15 @@ FrameGraphId<FrameGraphTexture> ShadowMapManager::render(FEngine& engine, FrameG
                     // blurring.
                     data.rt = blur ? data.rt : rt;
                 },
-                [=, &engine, &entry](FrameGraphResources const& resources,
+                [=, &engine, &passList](FrameGraphResources const& resources,
                         auto const& data, DriverApi& driver) {
 
-                    // Note: we capture entry by reference here. That's actually okay because
-                    // `entry` lives in `PrepareShadowPassData` which is guaranteed to still
-                    // be alive when we execute here (all passes stay alive until the FrameGraph
-                    // is destroyed).
-                    // It wouldn't work to capture by copy because entry.executor wouldn't be
-                    // initialized, as this happens in an `execute` block.
+                    // Note: we capture passList by reference here. That's actually okay
+                    // because it lives in `PrepareShadowPassData` which is guaranteed to
+                    // still be alive when we execute here (all passes stay alive until the
+                    // FrameGraph is destroyed).
+                    // It wouldn't work to capture by copy because each entry's executor
+                    // wouldn't be initialized, as this happens in an `execute` block.
 
                     auto rt = resources.getRenderPassInfo(data.rt);
 
@@ -523,10 +799,15 @@ FrameGraphId<FrameGraphTexture> ShadowMapManager::render(FEngine& engine, FrameG
                     // if we know there are no visible shadows, we can skip rendering, but
                     // we need the render-pass to clear/initialize the shadow-map
                     // Note: this is always true for directional/cascade shadows.
-                    if (entry.shadowMap->hasVisibleShadows()) {
-                        entry.shadowMap->bind(driver);
-                        entry.executor.overrideScissor(entry.shadowMap->getScissor());
-                        entry.executor.execute(engine, driver);
+                    for (auto const& e : passList) {
+                        if (e.shadowMap->getLayer() != layer) {
+                            continue;
+                        }
+                        if (e.shadowMap->hasVisibleShadows()) {
+                            e.shadowMap->bind(driver);
+                            e.executor.overrideScissor(e.shadowMap->getScissor());
+                            e.executor.execute(engine, driver);
+                        }
                     }
                     driver.endRenderPass();
                 });
@@ -561,6 +842,61 @@ FrameGraphId<FrameGraphTexture> ShadowMapManager::render(FEngine& engine, FrameG
     return prepareShadowPass->shadows;
 }
 
+FrameGraphId<FrameGraphTexture> ShadowMapManager::import(FEngine& engine, FrameGraph& fg,
+        FView& view, CameraInfo const& mainCameraInfo,
+        FrameGraphTexture::Descriptor const& desc,
+        FrameGraphTexture const& texture) noexcept {
+
+    FScene* scene = view.getScene();
+    assert_invariant(scene);
+
+    auto const shadows = fg.import("Shared Shadowmap", desc,
+            TextureUsage::DEPTH_ATTACHMENT | TextureUsage::SAMPLEABLE, texture);
+
+    // The atlas content was rendered by another View, but this View samples it through its own
+    // per-view shadow UBO. The directional/cascade entries were already written in update();
+    // the spot/point entries are normally written in render()'s "Prepare Shadow Pass", so we
+    // replicate that part here (minus the culling and command generation) and upload the UBO.
+    struct PrepareSharedShadowData {
+    };
+    fg.addPass<PrepareSharedShadowData>("Prepare Shared Shadowmap",
+            [&](FrameGraph::Builder& builder, auto&) {
+                // This pass only has side effects (UBO update), it would be culled otherwise.
+                builder.sideEffect();
+            },
+            [this, &engine, &view, scene, mainCameraInfo]
+                    (FrameGraphResources const&, auto const&, DriverApi& driver) {
+                if (view.needsPointShadowMaps()) {
+                    for (auto& shadowMap : getSpotShadowMaps()) {
+                        assert_invariant(!shadowMap.isDirectionalShadow());
+                        switch (shadowMap.getShadowType()) {
+                            case ShadowType::DIRECTIONAL:
+                                // we should never be here
+                                break;
+                            case ShadowType::SPOT:
+                                prepareSpotShadowMap(shadowMap, engine, view, mainCameraInfo,
+                                        scene->getLightData(), mSceneInfo);
+                                break;
+                            case ShadowType::POINT:
+                                preparePointShadowMap(shadowMap, engine, view, mainCameraInfo,
+                                        scene->getLightData());
+                                break;
+                        }
+                    }
+                }
+                if (mShadowUb.isDirty()) {
+                    driver.updateBufferObject(mShadowUbh,
+                            mShadowUb.toBufferDescriptor(driver), 0);
+                }
+            });
+
+    mShadowPassCount = 0;
+
+    fg.getBlackboard()["shadowmap"] = shadows;
+
+    return shadows;
+}
+
 ShadowMapManager::ShadowTechnique ShadowMapManager::updateCascadeShadowMaps(FEngine& engine,
         FView& view, CameraInfo cameraInfo, FScene::RenderableSoa& renderableData,
         FScene::LightSoa const& lightData, ShadowMap::SceneInfo sceneInfo) noexcept {
@@ -755,10 +1091,11 @@ void ShadowMapManager::prepareSpotShadowMap(ShadowMap& shadowMap, FEngine& engin
     FLightManager::ShadowOptions const* const options = shadowMap.getShadowOptions();
 
     // update the shadow map frustum/camera
+    const uint16_t textureDimension = shadowMap.getTextureDimension();
     const ShadowMap::ShadowMapInfo shadowMapInfo{
             .atlasDimension      = mTextureAtlasRequirements.size,
-            .textureDimension    = uint16_t(options->mapSize),
-            .shadowDimension     = uint16_t(options->mapSize - 2u),
+            .textureDimension    = textureDimension,
+            .shadowDimension     = uint16_t(textureDimension - 2u),
             .textureSpaceFlipped = engine.getBackend() == Backend::METAL ||
                                    engine.getBackend() == Backend::VULKAN,
             .vsm                 = view.hasVSM()
@@ -792,35 +1129,44 @@ void ShadowMapManager::prepareSpotShadowMap(ShadowMap& shadowMap, FEngine& engin
     }
 }
 
-void ShadowMapManager::cullSpotShadowMap(ShadowMap const& shadowMap,
-        FEngine const& engine, FView const& view,
-        FScene::RenderableSoa& renderableData, utils::Range<uint32_t> range,
-        FScene::LightSoa const& lightData) noexcept {
-    auto& lcm = engine.getLightManager();
-
+Frustum ShadowMapManager::computeShadowCullingFrustum(ShadowMap const& shadowMap,
+        FEngine const& engine, FScene::LightSoa const& lightData) noexcept {
     const size_t lightIndex = shadowMap.getLightIndex();
-    const FLightManager::Instance li = lightData.elementAt<FScene::LIGHT_INSTANCE>(lightIndex);
+    const auto position = lightData.elementAt<FScene::POSITION_RADIUS>(lightIndex).xyz;
+    const auto radius = lightData.elementAt<FScene::POSITION_RADIUS>(lightIndex).w;
+
+    if (shadowMap.getShadowType() == ShadowType::SPOT) {
+        auto& lcm = engine.getLightManager();
+        const FLightManager::Instance li = lightData.elementAt<FScene::LIGHT_INSTANCE>(lightIndex);
+        const auto direction = lightData.elementAt<FScene::DIRECTION>(lightIndex);
+        const auto outerConeAngle = lcm.getSpotLightOuterCone(li);
+        const mat4f Mv = ShadowMap::getDirectionalLightViewMatrix(direction, { 0, 1, 0 }, position);
+        const mat4f Mp = mat4f::perspective(outerConeAngle * f::RAD_TO_DEG * 2.0f, 1.0f, 0.01f, radius);
+        return Frustum{ math::highPrecisionMultiply(Mp, Mv) };
+    }
 
+    // point light, one frustum per cubemap face
+    const mat4f Mv = ShadowMap::getPointLightViewMatrix(
+            TextureCubemapFace(shadowMap.getFace()), position);
+    const mat4f Mp = mat4f::perspective(90.0f, 1.0f, 0.01f, radius);
+    return Frustum{ math::highPrecisionMultiply(Mp, Mv) };
+}
+
+void ShadowMapManager::cullSpotShadowMap(ShadowMap const& shadowMap,
+        FEngine const& engine, FView const& view,
+        FScene::RenderableSoa const& renderableData, utils::Range<uint32_t> range,
+        FScene::LightSoa const& lightData,
+        Culler::result_type* UTILS_RESTRICT visibleArray) noexcept {
     // compute the frustum for this light
     // for spotlights, we cull shadow casters first because we already know the frustum,
     // this will help us find better near/far plane later
-    const auto position = lightData.elementAt<FScene::POSITION_RADIUS>(lightIndex).xyz;
-    const auto direction = lightData.elementAt<FScene::DIRECTION>(lightIndex);
-    const auto radius = lightData.elementAt<FScene::POSITION_RADIUS>(lightIndex).w;
-    const auto outerConeAngle = lcm.getSpotLightOuterCone(li);
-
-    // compute shadow map frustum for culling
-    const mat4f Mv = ShadowMap::getDirectionalLightViewMatrix(direction, { 0, 1, 0 }, position);
-    const mat4f Mp = mat4f::perspective(outerConeAngle * f::RAD_TO_DEG * 2.0f, 1.0f, 0.01f, radius);
-    const mat4f MpMv = math::highPrecisionMultiply(Mp, Mv);
-    const Frustum frustum(MpMv);
+    const Frustum frustum = computeShadowCullingFrustum(shadowMap, engine, lightData);
 
     // Cull shadow casters
     float3 const* worldAABBCenter = renderableData.data<FScene::WORLD_AABB_CENTER>();
     float3 const* worldAABBExtent = renderableData.data<FScene::WORLD_AABB_EXTENT>();
-    FScene::VisibleMaskType* visibleArray = renderableData.data<FScene::VISIBLE_MASK>();
     Culler::intersects(
-            visibleArray + range.first,
+            visibleArray,
             frustum,
             worldAABBCenter + range.first,
             worldAABBExtent + range.first,
@@ -834,7 +1180,7 @@ void ShadowMapManager::cullSpotShadowMap(ShadowMap const& shadowMap,
             view.getVisibleLayers(),
             layers + range.first,
             visibility + range.first,
-            visibleArray + range.first,
+            visibleArray,
             range.size());
 }
 
@@ -847,10 +1193,11 @@ void ShadowMapManager::preparePointShadowMap(ShadowMap& shadowMap,
     FLightManager::ShadowOptions const* const options = shadowMap.getShadowOptions();
 
     // update the shadow map frustum/camera
+    const uint16_t textureDimension = shadowMap.getTextureDimension();
     const ShadowMap::ShadowMapInfo shadowMapInfo{
             .atlasDimension      = mTextureAtlasRequirements.size,
-            .textureDimension    = uint16_t(options->mapSize),
-            .shadowDimension     = uint16_t(options->mapSize), // point-lights don't have a border
+            .textureDimension    = textureDimension,
+            .shadowDimension     = textureDimension, // point-lights don't have a border
             .textureSpaceFlipped = engine.getBackend() == Backend::METAL ||
                                    engine.getBackend() == Backend::VULKAN,
             .vsm                 = view.hasVSM()
@@ -883,30 +1230,20 @@ void ShadowMapManager::preparePointShadowMap(ShadowMap& shadowMap,
     }
 }
 
-void ShadowMapManager::cullPointShadowMap(ShadowMap const& shadowMap, FView const& view,
-        FScene::RenderableSoa& renderableData, utils::Range<uint32_t> range,
-        FScene::LightSoa const& lightData) noexcept {
-
-    uint8_t const face = shadowMap.getFace();
-    size_t const lightIndex = shadowMap.getLightIndex();
-
-    // compute the frustum for this light
-    // for spotlights, we cull shadow casters first because we already know the frustum,
-    // this will help us find better near/far plane later
-    auto const position = lightData.elementAt<FScene::POSITION_RADIUS>(lightIndex).xyz;
-    auto const radius = lightData.elementAt<FScene::POSITION_RADIUS>(lightIndex).w;
+void ShadowMapManager::cullPointShadowMap(ShadowMap const& shadowMap,
+        FEngine const& engine, FView const& view,
+        FScene::RenderableSoa const& renderableData, utils::Range<uint32_t> range,
+        FScene::LightSoa const& lightData,
+        Culler::result_type* UTILS_RESTRICT visibleArray) noexcept {
 
-    // compute shadow map frustum for culling
-    mat4f const Mv = ShadowMap::getPointLightViewMatrix(TextureCubemapFace(face), position);
-    mat4f const Mp = mat4f::perspective(90.0f, 1.0f, 0.01f, radius);
-    Frustum const frustum{ math::highPrecisionMultiply(Mp, Mv) };
+    // compute the shadow map frustum of this cubemap face for culling
+    Frustum const frustum = computeShadowCullingFrustum(shadowMap, engine, lightData);
 
     // Cull shadow casters
     float3 const* worldAABBCenter = renderableData.data<FScene::WORLD_AABB_CENTER>();
     float3 const* worldAABBExtent = renderableData.data<FScene::WORLD_AABB_EXTENT>();
-    FScene::VisibleMaskType* visibleArray = renderableData.data<FScene::VISIBLE_MASK>();
     Culler::intersects(
-            visibleArray + range.first,
+            visibleArray,
             frustum,
             worldAABBCenter + range.first,
             worldAABBExtent + range.first,
@@ -920,7 +1257,74 @@ void ShadowMapManager::cullPointShadowMap(ShadowMap const& shadowMap, FView cons
             view.getVisibleLayers(),
             layers + range.first,
             visibility + range.first,
-            visibleArray + range.first,
+            visibleArray,
+            range.size());
+}
+
+void ShadowMapManager::computeShadowCasterCandidates(
+        FScene::RenderableSoa const& renderableData, utils::Range<uint32_t> range,
+        FScene::LightSoa const& lightData,
+        utils::Slice<size_t const> lightIndices,
+        utils::FixedCapacityVector<utils::FixedCapacityVector<uint32_t>>& candidates) noexcept {
+
+    assert_invariant(candidates.size() == lightIndices.size());
+
+    float3 const* const UTILS_RESTRICT center = renderableData.data<FScene::WORLD_AABB_CENTER>();
+    float3 const* const UTILS_RESTRICT extent = renderableData.data<FScene::WORLD_AABB_EXTENT>();
+
+    size_t const lightCount = lightIndices.size();
+    auto spheres = utils::FixedCapacityVector<float4>::with_capacity(lightCount);
+    for (size_t const lightIndex : lightIndices) {
+        spheres.push_back(lightData.elementAt<FScene::POSITION_RADIUS>(lightIndex));
+    }
+
+    // Each renderable's AABB is read once and tested against all the lights' bounding
+    // spheres, instead of each light's shadow maps re-sweeping the whole range.
+    for (uint32_t i = range.first; i < range.last; ++i) {
+        float3 const c = center[i];
+        float3 const e = extent[i];
+        for (size_t l = 0; l < lightCount; l++) {
+            float4 const s = spheres[l];
+            // squared distance from the sphere's center to the AABB
+            float3 const d = max(abs(s.xyz - c) - e, float3{ 0.0f });
+            if (dot(d, d) <= s.w * s.w) {
+                candidates[l].push_back(i);
+            }
+        }
+    }
+}
+
+void ShadowMapManager::cullShadowMapFromCandidates(ShadowMap const& shadowMap,
+        FEngine const& engine, FView const& view,
+        FScene::RenderableSoa const& renderableData, utils::Range<uint32_t> range,
+        FScene::LightSoa const& lightData,
+        utils::FixedCapacityVector<uint32_t> const& candidates,
+        Culler::result_type* UTILS_RESTRICT visibleArray) noexcept {
+
+    Frustum const frustum = computeShadowCullingFrustum(shadowMap, engine, lightData);
+
+    float3 const* const worldAABBCenter = renderableData.data<FScene::WORLD_AABB_CENTER>();
+    float3 const* const worldAABBExtent = renderableData.data<FScene::WORLD_AABB_EXTENT>();
+
+    // non-candidates are outside the light's bounding sphere, so outside the frustum too
+    size_t const paddedCount = (range.size() + 0xFu) & ~0xFu;
+    for (size_t i = 0; i < paddedCount; i++) {
+        visibleArray[i] &= ~VISIBLE_DYN_SHADOW_RENDERABLE;
+    }
+    for (uint32_t const i : candidates) {
+        if (Culler::intersects(frustum, Box{ worldAABBCenter[i], worldAABBExtent[i] })) {
+            visibleArray[i - range.first] |= VISIBLE_DYN_SHADOW_RENDERABLE;
+        }
+    }
+
+    // update their visibility mask
+    uint8_t const* layers = renderableData.data<FScene::LAYERS>();
+    auto const* visibility = renderableData.data<FScene::VISIBILITY_STATE>();
+    updateSpotVisibilityMasks(
+            view.getVisibleLayers(),
+            layers + range.first,
+            visibility + range.first,
+            visibleArray,
             range.size());
 }
 
@@ -952,21 +1356,39 @@ ShadowMapManager::ShadowTechnique ShadowMapManager::updateSpotShadowMaps(FEngine
     // screen-space contact shadows for point/spotlights
     auto& lcm = engine.getLightManager();
     auto *pLightInstances = lightData.data<FScene::LIGHT_INSTANCE>();
+    float ssShadowDistance = 0.0f;
+    uint8_t ssStepCount = 0;
     for (size_t i = 0, c = lightData.size(); i < c; i++) {
         // screen-space contact shadows
         LightManager::ShadowOptions const& shadowOptions = lcm.getShadowOptions(pLightInstances[i]);
         if (shadowOptions.screenSpaceContactShadows) {
             shadowTechnique |= ShadowTechnique::SCREEN_SPACE;
             shadowInfo[i].contactShadows = true;
-            // TODO: distance/steps are always taken from the directional light currently
+            ssShadowDistance = std::max(ssShadowDistance, shadowOptions.maxShadowDistance);
+            ssStepCount = std::max(ssStepCount, shadowOptions.stepCount);
         }
     }
 
+    // The ray-marching distance/steps uniforms are global. They're normally taken from the
+    // directional light, but if it doesn't use contact shadows (or there is none), derive
+    // them from the punctual lights that do, instead of silently using the directional
+    // light's (possibly default) values.
+    FLightManager::Instance const directionalLight =
+            lightData.elementAt<FScene::LIGHT_INSTANCE>(0);
+    bool const directionalHasContactShadows = directionalLight &&
+            lcm.getShadowOptions(directionalLight).screenSpaceContactShadows;
+    if (any(shadowTechnique & ShadowTechnique::SCREEN_SPACE) && !directionalHasContactShadows) {
+        mShadowMappingUniforms.ssContactShadowDistance = ssShadowDistance;
+        mShadowMappingUniforms.directionalShadows =
+                (mShadowMappingUniforms.directionalShadows & ~0xFF00u) |
+                (uint32_t(ssStepCount) << 8u);
+    }
+
     return shadowTechnique;
 }
 
 void ShadowMapManager::calculateTextureRequirements(FEngine& engine, FView& view,
-        FScene::LightSoa const&) noexcept {
+        CameraInfo const& cameraInfo, FScene::LightSoa const& lightData) noexcept {
 
     // Lay out the shadow maps. For now, we take the largest requested dimension and allocate a
     // texture of that size. Each cascade / shadow map gets its own layer in the array texture.
@@ -988,7 +1410,97 @@ void ShadowMapManager::calculateTextureRequirements(FEngine& engine, FView& view
         shadowMap.setLayer(layer++);
     }
 
-    const uint8_t layersNeeded = layer;
+    uint8_t layersNeeded = layer;
+
+    // Dynamic shadow resolution: scale each spot/point shadow map with its light's
+    // projected screen footprint, and pack the resulting maps into shared atlas layers.
+    // VSM is excluded because its blur/mipmap passes operate on whole layers, and the
+    // stable-map cache is excluded because its caching decisions are per-layer.
+    // AtlasAllocator only handles power-of-two sizes.
+    bool const dynamicResolution = engine.debug.shadowmap.dynamic_resolution &&
+            !view.hasVSM() && !engine.debug.shadowmap.cache_stable_maps &&
+            mSpotShadowMapCount > 0 && (maxDimension & (maxDimension - 1u)) == 0u;
+
+    if (UTILS_UNLIKELY(dynamicResolution)) {
+        auto spotShadowMaps = getSpotShadowMaps();
+        size_t const count = spotShadowMaps.size();
+        auto const* const spheres = lightData.data<FScene::POSITION_RADIUS>();
+        float const viewportHeight = float(view.getViewport().height);
+        float const projectionScale = std::abs(cameraInfo.projection[1][1]);
+
+        // The smallest size the allocator supports (it allows the four power-of-two
+        // sizes at or below the atlas size).
+        uint32_t const minDimension = maxDimension / 8u;
+
+        auto desiredSize = utils::FixedCapacityVector<uint32_t>::with_capacity(count);
+        for (ShadowMap const& shadowMap : spotShadowMaps) {
+            float4 const sphere = spheres[shadowMap.getLightIndex()];
+            float const distance =
+                    length(sphere.xyz - cameraInfo.getPosition()) - sphere.w;
+            uint32_t const mapSize = shadowMap.getShadowOptions()->mapSize;
+            // cap at the requested mapSize, rounded up to the next allocatable size
+            uint32_t cap = minDimension;
+            while (cap < mapSize) {
+                cap *= 2u;
+            }
+            uint32_t size = cap;
+            if (distance > 0.0f) {
+                // the light sphere's projected diameter on screen, in pixels; this is
+                // approximate, but smooth under camera motion, so maps rescale without
+                // popping between unrelated sizes
+                float const diameterPixels =
+                        (sphere.w / distance) * projectionScale * viewportHeight;
+                size = minDimension;
+                while (size < uint32_t(diameterPixels) && size < cap) {
+                    size *= 2u;
+                }
+            }
+            desiredSize.push_back(size);
+        }
+
+        // Pack largest-first, which a quadtree allocator handles without fragmentation.
+        auto order = utils::FixedCapacityVector<uint32_t>::with_capacity(count);
+        for (uint32_t i = 0; i < count; i++) {
+            order.push_back(i);
+        }
+        std::sort(order.begin(), order.end(), [&desiredSize](uint32_t lhs, uint32_t rhs) {
+            return desiredSize[lhs] > desiredSize[rhs];
+        });
+
+        uint8_t const baseLayer = uint8_t(mDirectionalShadowMapCount);
+        uint8_t atlasLayers = 0;
+        bool packed = true;
+        AtlasAllocator allocator{ maxDimension };
+        for (uint32_t const i : order) {
+            auto const allocation = allocator.allocate(desiredSize[i]);
+            if (UTILS_UNLIKELY(allocation.layer < 0 ||
+                    baseLayer + allocation.layer >= CONFIG_MAX_SHADOW_LAYERS)) {
+                packed = false;
+                break;
+            }
+            ShadowMap& shadowMap = spotShadowMaps[i];
+            shadowMap.setLayer(baseLayer + uint8_t(allocation.layer));
+            shadowMap.setAllocation(
+                    uint16_t(allocation.viewport.left),
+                    uint16_t(allocation.viewport.bottom),
+                    uint16_t(desiredSize[i]));
+            atlasLayers = std::max(atlasLayers, uint8_t(allocation.layer + 1));
+        }
+
+        if (UTILS_LIKELY(packed)) {
+            layersNeeded = baseLayer + atlasLayers;
+        } else {
+            // shouldn't happen in practice (the allocator can hold CONFIG_MAX_SHADOWMAPS
+            // maps of any allowed size), but fall back to the fixed one-layer-per-map
+            // layout if it does
+            uint8_t fallbackLayer = baseLayer;
+            for (ShadowMap& shadowMap : spotShadowMaps) {
+                shadowMap.setLayer(fallbackLayer++);
+                shadowMap.setAllocation(0, 0, 0);
+            }
+            layersNeeded = fallbackLayer;
+        }
+    }
 
     // Generate mipmaps for VSM when anisotropy is enabled or when requested
     auto const& vsmShadowOptions = view.getVsmShadowOptions();
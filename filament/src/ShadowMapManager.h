@@ -130,6 +130,14 @@ public:
             RenderPassBuilder const& passBuilder,
             FView& view, CameraInfo const& mainCameraInfo, math::float4 const& userTime) noexcept;
 
+    // Imports a shadow atlas rendered by another View's ShadowMapManager this frame instead of
+    // rendering our own passes. The per-view shadow UBO is still computed and uploaded here,
+    // because this View samples the shared atlas through its own descriptor set.
+    FrameGraphId<FrameGraphTexture> import(FEngine& engine, FrameGraph& fg,
+            FView& view, CameraInfo const& mainCameraInfo,
+            FrameGraphTexture::Descriptor const& desc,
+            FrameGraphTexture const& texture) noexcept;
+
     // valid after calling update() above
     ShadowMappingUniforms getShadowMappingUniforms() const noexcept {
         return mShadowMappingUniforms;
@@ -139,6 +147,9 @@ public:
 
     bool hasSpotShadows() const { return !mSpotShadowMapCount; }
 
+    // telemetry: number of shadow map passes added by the last render() call
+    uint32_t getShadowPassCount() const noexcept { return mShadowPassCount; }
+
     // for debugging only
     utils::FixedCapacityVector<Camera const*> getDirectionalShadowCameras() const noexcept;
 
@@ -158,7 +169,7 @@ private:
             FScene::LightSoa const& lightData) noexcept;
 
     void calculateTextureRequirements(FEngine&, FView& view,
-            FScene::LightSoa const&) noexcept;
+            CameraInfo const& cameraInfo, FScene::LightSoa const&) noexcept;
 
     void prepareSpotShadowMap(ShadowMap& shadowMap,
             FEngine& engine, FView& view, CameraInfo const& mainCameraInfo,
@@ -166,16 +177,42 @@ private:
 
     static void cullSpotShadowMap(ShadowMap const& map,
             FEngine const& engine, FView const& view,
-            FScene::RenderableSoa& renderableData, utils::Range<uint32_t> range,
-            FScene::LightSoa const& lightData) noexcept;
+            FScene::RenderableSoa const& renderableData, utils::Range<uint32_t> range,
+            FScene::LightSoa const& lightData,
+            Culler::result_type* UTILS_RESTRICT visibleArray) noexcept;
 
     void preparePointShadowMap(ShadowMap& map,
             FEngine& engine, FView& view, CameraInfo const& mainCameraInfo,
             FScene::LightSoa& lightData) noexcept;
 
-    static void cullPointShadowMap(ShadowMap const& shadowMap, FView const& view,
-            FScene::RenderableSoa& renderableData, utils::Range<uint32_t> range,
-            FScene::LightSoa const& lightData) noexcept;
+    static void cullPointShadowMap(ShadowMap const& shadowMap,
+            FEngine const& engine, FView const& view,
+            FScene::RenderableSoa const& renderableData, utils::Range<uint32_t> range,
+            FScene::LightSoa const& lightData,
+            Culler::result_type* UTILS_RESTRICT visibleArray) noexcept;
+
+    // the culling frustum of a spot shadow map or point shadow map face
+    static Frustum computeShadowCullingFrustum(ShadowMap const& shadowMap,
+            FEngine const& engine, FScene::LightSoa const& lightData) noexcept;
+
+    // Builds conservative per-light shadow-caster candidate lists in a single sweep over the
+    // renderables: each AABB is read once and tested against every light's bounding sphere.
+    // Every shadow map frustum of a light is contained in that light's bounding sphere, so a
+    // renderable outside the sphere can be skipped by all of the light's shadow maps.
+    static void computeShadowCasterCandidates(
+            FScene::RenderableSoa const& renderableData, utils::Range<uint32_t> range,
+            FScene::LightSoa const& lightData,
+            utils::Slice<size_t const> lightIndices,
+            utils::FixedCapacityVector<utils::FixedCapacityVector<uint32_t>>& candidates) noexcept;
+
+    // like cullSpotShadowMap()/cullPointShadowMap(), but only frustum-tests the light's
+    // candidates computed by computeShadowCasterCandidates()
+    static void cullShadowMapFromCandidates(ShadowMap const& shadowMap,
+            FEngine const& engine, FView const& view,
+            FScene::RenderableSoa const& renderableData, utils::Range<uint32_t> range,
+            FScene::LightSoa const& lightData,
+            utils::FixedCapacityVector<uint32_t> const& candidates,
+            Culler::result_type* UTILS_RESTRICT visibleArray) noexcept;
 
     static void updateSpotVisibilityMasks(
             uint8_t visibleLayers,
@@ -215,6 +252,13 @@ private:
         backend::TextureFormat format = backend::TextureFormat::DEPTH16;
     } mTextureAtlasRequirements;
 
+    // Persistent shadow atlas used when d.shadowmap.cache_stable_maps is enabled. It is
+    // imported into the FrameGraph instead of using a transient texture, so that layers
+    // whose content hash hasn't changed can keep last frame's result.
+    backend::Handle<backend::HwTexture> mCachedShadowAtlas;
+    TextureAtlasRequirements mCachedAtlasRequirements{};
+    std::array<uint32_t, CONFIG_MAX_SHADOW_LAYERS> mCachedLayerHash{};
+
     SoftShadowOptions mSoftShadowOptions;
 
     mutable TypedBuffer<ShadowUib> mShadowUb;
@@ -232,6 +276,7 @@ private:
     ShadowMapCacheContainer mShadowMapCache;
     uint32_t mDirectionalShadowMapCount = 0;
     uint32_t mSpotShadowMapCount = 0;
+    uint32_t mShadowPassCount = 0;
     bool const mIsDepthClampSupported;
     bool mInitialized = false;
 
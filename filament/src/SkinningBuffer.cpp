@@ -33,6 +33,20 @@ void SkinningBuffer::setBones(Engine& engine,
     downcast(this)->setBones(downcast(engine), transforms, count, offset);
 }
 
+void SkinningBuffer::updateBones(Engine& engine,
+        RenderableManager::Bone const* transforms, size_t count, size_t offset) {
+    downcast(this)->updateBones(downcast(engine), transforms, count, offset);
+}
+
+void SkinningBuffer::updateBones(Engine& engine,
+        math::mat4f const* transforms, size_t count, size_t offset) {
+    downcast(this)->updateBones(downcast(engine), transforms, count, offset);
+}
+
+void SkinningBuffer::commit(Engine& engine) {
+    downcast(this)->commit(downcast(engine));
+}
+
 size_t SkinningBuffer::getBoneCount() const noexcept {
     return downcast(this)->getBoneCount();
 }
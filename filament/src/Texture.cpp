@@ -58,6 +58,11 @@ void Texture::setImage(Engine& engine, size_t level,
     downcast(this)->setImage(downcast(engine), level, std::move(buffer), faceOffsets);
 }
 
+void Texture::setImages(Engine& engine, ImageRegion const* regions, size_t count,
+        PixelBufferDescriptor&& buffer, uint8_t priority) const {
+    downcast(this)->setImages(downcast(engine), regions, count, std::move(buffer), priority);
+}
+
 void Texture::setExternalImage(Engine& engine, void* image) noexcept {
     downcast(this)->setExternalImage(downcast(engine), image);
 }
@@ -74,6 +79,14 @@ void Texture::generateMipmaps(Engine& engine) const noexcept {
     downcast(this)->generateMipmaps(downcast(engine));
 }
 
+uint32_t Texture::getUnusedFrameCount(Engine& engine) const noexcept {
+    return downcast(this)->getUnusedFrameCount(downcast(engine));
+}
+
+float Texture::getDesiredMipLevel(Engine& engine) const noexcept {
+    return downcast(this)->getDesiredMipLevel(downcast(engine));
+}
+
 bool Texture::isTextureFormatSupported(Engine& engine, InternalFormat format) noexcept {
     return FTexture::isTextureFormatSupported(downcast(engine), format);
 }
@@ -0,0 +1,45 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "details/TextureAtlas.h"
+
+#include "details/Engine.h"
+#include "details/Texture.h"
+
+namespace filament {
+
+TextureAtlas::Entry TextureAtlas::allocate(uint32_t size) noexcept {
+    return downcast(this)->allocate(size);
+}
+
+void TextureAtlas::free(Entry const& entry) noexcept {
+    downcast(this)->free(entry);
+}
+
+void TextureAtlas::setImage(Engine& engine,
+        Entry const& entry, PixelBufferDescriptor&& buffer) const {
+    downcast(this)->setImage(downcast(engine), entry, std::move(buffer));
+}
+
+Texture* TextureAtlas::getTexture() const noexcept {
+    return downcast(this)->getTexture();
+}
+
+math::float4 TextureAtlas::getUvTransform(Entry const& entry) const noexcept {
+    return downcast(this)->getUvTransform(entry);
+}
+
+} // namespace filament
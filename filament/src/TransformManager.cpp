@@ -111,6 +111,10 @@ void TransformManager::commitLocalTransformTransaction() noexcept {
     downcast(this)->commitLocalTransformTransaction();
 }
 
+void TransformManager::commitWorldTransformSnapshot() noexcept {
+    downcast(this)->commitWorldTransformSnapshot();
+}
+
 TransformManager::children_iterator TransformManager::getChildrenBegin(
         TransformManager::Instance parent) const noexcept {
     return downcast(this)->getChildrenBegin(parent);
@@ -16,6 +16,8 @@
 
 #include "UniformBuffer.h"
 
+#include "BufferPoolAllocator.h"
+
 #include <stdlib.h>
 #include <string.h>
 
@@ -26,7 +28,8 @@ namespace filament {
 UniformBuffer::UniformBuffer(size_t size) noexcept
         : mBuffer(mStorage),
           mSize(uint32_t(size)),
-          mSomethingDirty(true) {
+          mDirtyStart(0),
+          mDirtyEnd(uint32_t(size)) {
     if (UTILS_LIKELY(size > sizeof(mStorage))) {
         mBuffer = UniformBuffer::alloc(size);
     }
@@ -36,7 +39,8 @@ UniformBuffer::UniformBuffer(size_t size) noexcept
 UniformBuffer::UniformBuffer(UniformBuffer&& rhs) noexcept
         : mBuffer(rhs.mBuffer),
           mSize(rhs.mSize),
-          mSomethingDirty(rhs.mSomethingDirty) {
+          mDirtyStart(rhs.mDirtyStart),
+          mDirtyEnd(rhs.mDirtyEnd) {
     if (UTILS_LIKELY(rhs.isLocalStorage())) {
         mBuffer = mStorage;
         memcpy(mBuffer, rhs.mBuffer, mSize);
@@ -47,7 +51,8 @@ UniformBuffer::UniformBuffer(UniformBuffer&& rhs) noexcept
 
 UniformBuffer& UniformBuffer::operator=(UniformBuffer&& rhs) noexcept {
     if (this != &rhs) {
-        mSomethingDirty = rhs.mSomethingDirty;
+        mDirtyStart = rhs.mDirtyStart;
+        mDirtyEnd = rhs.mDirtyEnd;
         if (UTILS_LIKELY(rhs.isLocalStorage())) {
             mBuffer = mStorage;
             mSize = rhs.mSize;
@@ -81,13 +86,19 @@ UniformBuffer& UniformBuffer::setUniforms(const UniformBuffer& rhs) noexcept {
     return *this;
 }
 
+// Parameter blocks are created and destroyed in large numbers when clients use short-lived
+// MaterialInstances (e.g. one per UI element per frame); pooling their shadow storage makes
+// that churn allocation-free. The pool holds at most 64 buffers, which bounds its footprint
+// to a few hundred KiB given the allocator's 4 KiB rounding.
+static BufferPoolAllocator<64, alignof(std::max_align_t),
+        utils::HeapAllocator, utils::LockingPolicy::Mutex> sBufferPool;
+
 void* UniformBuffer::alloc(size_t size) noexcept {
-    // these allocations have a long life span
-    return ::malloc(size);
+    return sBufferPool.get(size);
 }
 
 void UniformBuffer::free(void* addr, size_t) noexcept {
-    ::free(addr);
+    sBufferPool.put(addr);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -161,6 +161,14 @@ View::DynamicResolutionOptions View::getDynamicResolutionOptions() const noexcep
     return downcast(this)->getDynamicResolutionOptions();
 }
 
+void View::setDynamicQualityOptions(const DynamicQualityOptions& options) noexcept {
+    downcast(this)->setDynamicQualityOptions(options);
+}
+
+View::DynamicQualityOptions View::getDynamicQualityOptions() const noexcept {
+    return downcast(this)->getDynamicQualityOptions();
+}
+
 void View::setRenderQuality(const RenderQuality& renderQuality) noexcept {
     downcast(this)->setRenderQuality(renderQuality);
 }
@@ -193,6 +201,38 @@ bool View::isTransparentPickingEnabled() const noexcept {
     return downcast(this)->isTransparentPickingEnabled();
 }
 
+void View::setContinuousPickingEnabled(bool enabled) noexcept {
+    downcast(this)->setContinuousPickingEnabled(enabled);
+}
+
+bool View::isContinuousPickingEnabled() const noexcept {
+    return downcast(this)->isContinuousPickingEnabled();
+}
+
+void View::setStreamingFeedbackEnabled(bool enabled) noexcept {
+    downcast(this)->setStreamingFeedbackEnabled(enabled);
+}
+
+bool View::isStreamingFeedbackEnabled() const noexcept {
+    return downcast(this)->isStreamingFeedbackEnabled();
+}
+
+void View::setShadowSharingGroup(uint8_t group) noexcept {
+    downcast(this)->setShadowSharingGroup(group);
+}
+
+uint8_t View::getShadowSharingGroup() const noexcept {
+    return downcast(this)->getShadowSharingGroup();
+}
+
+void View::setAutoExposureEnabled(bool enabled) noexcept {
+    downcast(this)->setAutoExposureEnabled(enabled);
+}
+
+bool View::isAutoExposureEnabled() const noexcept {
+    return downcast(this)->isAutoExposureEnabled();
+}
+
 void View::setDynamicLightingOptions(float zLightNear, float zLightFar) noexcept {
     downcast(this)->setDynamicLightingOptions(zLightNear, zLightFar);
 }
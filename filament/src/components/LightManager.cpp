@@ -228,7 +228,9 @@ void FLightManager::terminate() noexcept {
     }
 }
 void FLightManager::gc(utils::EntityManager& em) noexcept {
-    mManager.gc(em, [this](Entity e) {
+    // collection is budgeted to spread the cost of mass destructions over several frames
+    constexpr size_t GC_BUDGET = 256;
+    mManager.gc(em, 4, GC_BUDGET, [this](Entity e) {
         destroy(e);
     });
 }
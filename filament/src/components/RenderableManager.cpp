@@ -85,6 +85,7 @@ struct RenderableManager::BuilderDetails {
     bool mScreenSpaceContactShadows : 1;
     bool mSkinningBufferMode : 1;
     bool mFogEnabled : 1;
+    bool mShadowOnly : 1;
     RenderableManager::Builder::GeometryType mGeometryType : 2;
     size_t mSkinningBoneCount = 0;
     size_t mMorphTargetCount = 0;
@@ -104,7 +105,7 @@ struct RenderableManager::BuilderDetails {
     explicit BuilderDetails(size_t count)
             : mEntries(count), mCulling(true), mCastShadows(false),
               mReceiveShadows(true), mScreenSpaceContactShadows(false),
-              mSkinningBufferMode(false), mFogEnabled(true),
+              mSkinningBufferMode(false), mFogEnabled(true), mShadowOnly(false),
               mGeometryType(RenderableManager::Builder::GeometryType::DYNAMIC),
               mBonePairs() {
     }
@@ -170,6 +171,16 @@ RenderableManager::Builder& RenderableManager::Builder::boundingBox(const Box& a
     return *this;
 }
 
+RenderableManager::Builder& RenderableManager::Builder::boundingBox(size_t index,
+        const Box& axisAlignedBoundingBox) noexcept {
+    std::vector<BuilderDetails::Entry>& entries = mImpl->mEntries;
+    if (index < entries.size()) {
+        entries[index].aabb = axisAlignedBoundingBox;
+        entries[index].hasAabb = true;
+    }
+    return *this;
+}
+
 RenderableManager::Builder& RenderableManager::Builder::layerMask(uint8_t select, uint8_t values) noexcept {
     mImpl->mLayerMask = (mImpl->mLayerMask & ~select) | (values & select);
     return *this;
@@ -199,6 +210,11 @@ RenderableManager::Builder& RenderableManager::Builder::lightChannel(unsigned in
     return *this;
 }
 
+RenderableManager::Builder& RenderableManager::Builder::shadowOnly(bool enable) noexcept {
+    mImpl->mShadowOnly = enable;
+    return *this;
+}
+
 RenderableManager::Builder& RenderableManager::Builder::castShadows(bool enable) noexcept {
     mImpl->mCastShadows = enable;
     return *this;
@@ -543,6 +559,7 @@ FRenderableManager::~FRenderableManager() {
 
 void FRenderableManager::create(
         const RenderableManager::Builder& UTILS_RESTRICT builder, Entity entity) {
+    mGenerationCount++;
     FEngine& engine = mEngine;
     auto& manager = mManager;
     FEngine::DriverApi& driver = engine.getDriverApi();
@@ -571,6 +588,7 @@ void FRenderableManager::create(
         setChannel(ci, builder->mCommandChannel);
         setCastShadows(ci, builder->mCastShadows);
         setReceiveShadows(ci, builder->mReceiveShadows);
+        setShadowOnly(ci, builder->mShadowOnly);
         setScreenSpaceContactShadows(ci, builder->mScreenSpaceContactShadows);
         setCulling(ci, builder->mCulling);
         setSkinning(ci, false);
@@ -578,6 +596,12 @@ void FRenderableManager::create(
         setFogEnabled(ci, builder->mFogEnabled);
         // do this after calling setAxisAlignedBoundingBox
         static_cast<Visibility&>(mManager[ci].visibility).geometryType = builder->mGeometryType;
+        bool hasPerPrimitiveBounds = false;
+        for (size_t i = 0; i < entryCount; ++i) {
+            hasPerPrimitiveBounds = hasPerPrimitiveBounds || entries[i].hasAabb;
+        }
+        static_cast<Visibility&>(mManager[ci].visibility).hasPerPrimitiveBounds =
+                hasPerPrimitiveBounds;
         mManager[ci].channels = builder->mLightChannels;
 
         InstancesInfo& instances = manager[ci].instances;
@@ -717,6 +741,7 @@ void FRenderableManager::create(
 void FRenderableManager::destroy(utils::Entity e) noexcept {
     Instance const ci = getInstance(e);
     if (ci) {
+        mGenerationCount++;
         destroyComponent(ci);
         mManager.removeComponent(e);
     }
@@ -740,7 +765,10 @@ void FRenderableManager::terminate() noexcept {
 }
 
 void FRenderableManager::gc(utils::EntityManager& em) noexcept {
-    mManager.gc(em, [this](Entity e) {
+    // cap the number of components collected per frame so that mass destructions (e.g.
+    // despawning a streamed tile) don't compact the whole storage in a single frame
+    constexpr size_t GC_BUDGET = 256;
+    mManager.gc(em, 4, GC_BUDGET, [this](Entity e) {
         destroy(e);
     });
 }
@@ -793,6 +821,7 @@ void FRenderableManager::destroyComponentPrimitives(
 void FRenderableManager::setMaterialInstanceAt(Instance instance, uint8_t level,
         size_t primitiveIndex, FMaterialInstance const* mi) {
     if (instance) {
+        mGenerationCount++;
         Slice<FRenderPrimitive>& primitives = getRenderPrimitives(instance, level);
         if (primitiveIndex < primitives.size()) {
             assert_invariant(mi);
@@ -835,6 +864,7 @@ MaterialInstance* FRenderableManager::getMaterialInstanceAt(
 void FRenderableManager::setBlendOrderAt(Instance instance, uint8_t level,
         size_t primitiveIndex, uint16_t order) noexcept {
     if (instance) {
+        mGenerationCount++;
         Slice<FRenderPrimitive>& primitives = getRenderPrimitives(instance, level);
         if (primitiveIndex < primitives.size()) {
             primitives[primitiveIndex].setBlendOrder(order);
@@ -845,6 +875,7 @@ void FRenderableManager::setBlendOrderAt(Instance instance, uint8_t level,
 void FRenderableManager::setGlobalBlendOrderEnabledAt(Instance instance, uint8_t level,
         size_t primitiveIndex, bool enabled) noexcept {
     if (instance) {
+        mGenerationCount++;
         Slice<FRenderPrimitive>& primitives = getRenderPrimitives(instance, level);
         if (primitiveIndex < primitives.size()) {
             primitives[primitiveIndex].setGlobalBlendOrderEnabled(enabled);
@@ -867,6 +898,7 @@ void FRenderableManager::setGeometryAt(Instance instance, uint8_t level, size_t
         PrimitiveType type, FVertexBuffer* vertices, FIndexBuffer* indices,
         size_t offset, size_t count) noexcept {
     if (instance) {
+        mGenerationCount++;
         Slice<FRenderPrimitive>& primitives = getRenderPrimitives(instance, level);
         if (primitiveIndex < primitives.size()) {
             primitives[primitiveIndex].set(mHwRenderPrimitiveFactory, mEngine.getDriverApi(),
@@ -932,6 +964,7 @@ void FRenderableManager::setSkinningBuffer(FRenderableManager::Instance ci,
             << "SkinningBuffer overflow (size=" << skinningBuffer->getBoneCount()
             << ", count=" << count << ", offset=" << offset << ")";
 
+    mGenerationCount++;
     bones.handle = skinningBuffer->getHwHandle();
     bones.count = uint16_t(count);
     bones.offset = uint16_t(offset);
@@ -954,9 +987,32 @@ void FRenderableManager::setMorphWeights(Instance instance, float const* weights
                 << "Only " << CONFIG_MAX_MORPH_TARGET_COUNT
                 << " morph targets are supported (count=" << count << ", offset=" << offset << ")";
 
-        MorphWeights const& morphWeights = mManager[instance].morphWeights;
+        MorphWeights& morphWeights = mManager[instance].morphWeights;
         if (morphWeights.handle) {
-            updateMorphWeights(mEngine, morphWeights.handle, weights, count, offset);
+            // Weights below this threshold have no visible effect; they are snapped to exactly
+            // zero so that the shader can skip the corresponding targets entirely. The CPU-side
+            // shadow lets us elide the whole upload when an animator feeds us unchanged weights,
+            // which is common for facial rigs where most targets sit at rest most of the time.
+            constexpr float MORPH_WEIGHT_EPSILON = 0.001f;
+            auto& shadow = morphWeights.lastWeights;
+            bool dirty = false;
+            if (UTILS_UNLIKELY(shadow.size() < count + offset)) {
+                shadow = FixedCapacityVector<float>(
+                        std::max(size_t(morphWeights.count), count + offset), 0.0f);
+                dirty = true;
+            }
+            for (size_t i = 0; i < count; i++) {
+                float w = weights[i];
+                w = (w < MORPH_WEIGHT_EPSILON && w > -MORPH_WEIGHT_EPSILON) ? 0.0f : w;
+                if (shadow[offset + i] != w) {
+                    shadow[offset + i] = w;
+                    dirty = true;
+                }
+            }
+            if (dirty) {
+                updateMorphWeights(mEngine, morphWeights.handle,
+                        shadow.data() + offset, count, offset);
+            }
         }
     }
 }
@@ -965,6 +1021,7 @@ void FRenderableManager::setMorphTargetBufferOffsetAt(Instance instance, uint8_t
         size_t primitiveIndex,
         size_t offset) {
     if (instance) {
+        mGenerationCount++;
         assert_invariant(mManager[instance].morphTargetBuffer);
         Slice<FRenderPrimitive>& primitives = mManager[instance].primitives;
         if (primitiveIndex < primitives.size()) {
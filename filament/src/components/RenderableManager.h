@@ -35,6 +35,7 @@
 #include <utils/compiler.h>
 #include <utils/Entity.h>
 #include <utils/EntityInstance.h>
+#include <utils/FixedCapacityVector.h>
 #include <utils/Panic.h>
 #include <utils/SingleInstanceComponentManager.h>
 #include <utils/Slice.h>
@@ -78,9 +79,12 @@ public:
         bool reversedWindingOrder       : 1;
         bool fog                        : 1;
         GeometryType geometryType       : 2;
+        bool hasPerPrimitiveBounds      : 1;
+
+        bool shadowOnly                 : 1;
     };
 
-    static_assert(sizeof(Visibility) == sizeof(uint16_t), "Visibility should be 16 bits");
+    static_assert(sizeof(Visibility) <= sizeof(uint32_t), "Visibility should fit in 32 bits");
 
     explicit FRenderableManager(FEngine& engine) noexcept;
     ~FRenderableManager();
@@ -122,6 +126,11 @@ public:
 
     void destroy(utils::Entity e) noexcept;
 
+    // Monotonic counter bumped whenever a renderable is created, destroyed or modified in a
+    // way that affects generated draw commands; used by FView to invalidate retained-mode
+    // command buffers.
+    uint32_t getGenerationCount() const noexcept { return mGenerationCount; }
+
     inline void setAxisAlignedBoundingBox(Instance instance, const Box& aabb);
 
     inline void setLayerMask(Instance instance, uint8_t select, uint8_t values) noexcept;
@@ -140,6 +149,8 @@ public:
     inline void setCulling(Instance instance, bool enable) noexcept;
     inline void setFogEnabled(Instance instance, bool enable) noexcept;
     inline bool getFogEnabled(Instance instance) const noexcept;
+    inline void setShadowOnly(Instance instance, bool enable) noexcept;
+    inline bool isShadowOnly(Instance instance) const noexcept;
 
     inline void setPrimitives(Instance instance, utils::Slice<FRenderPrimitive> const& primitives) noexcept;
 
@@ -226,6 +237,8 @@ public:
         struct {
             uint32_t offset = 0;
         } morphing;
+        Box aabb = {};          // object-space AABB of this primitive, optional
+        bool hasAabb = false;   // whether aabb was specified
     };
 
 private:
@@ -246,8 +259,11 @@ private:
     struct MorphWeights {
         backend::Handle<backend::HwBufferObject> handle;
         uint32_t count = 0;
+        // CPU shadow of the last weights uploaded to the UBO, allocated lazily on the first
+        // setMorphWeights() call, so that redundant uploads can be elided.
+        utils::FixedCapacityVector<float> lastWeights;
     };
-    static_assert(sizeof(MorphWeights) == 8);
+    static_assert(sizeof(MorphWeights) == 24);
 
     enum {
         AABB,                   // user data
@@ -311,6 +327,7 @@ private:
     Sim mManager;
     FEngine& mEngine;
     HwRenderPrimitiveFactory mHwRenderPrimitiveFactory;
+    uint32_t mGenerationCount = 0;
 };
 
 FILAMENT_DOWNCAST(RenderableManager)
@@ -322,6 +339,7 @@ void FRenderableManager::setAxisAlignedBoundingBox(Instance instance, const Box&
                 GeometryType::DYNAMIC)
                 << "This renderable has staticBounds enabled; its AABB cannot change.";
         mManager[instance].aabb = aabb;
+        mGenerationCount++;
     }
 }
 
@@ -330,12 +348,14 @@ void FRenderableManager::setLayerMask(Instance instance,
     if (instance) {
         uint8_t& layers = mManager[instance].layers;
         layers = (layers & ~select) | (values & select);
+        mGenerationCount++;
     }
 }
 
 void FRenderableManager::setLayerMask(Instance instance, uint8_t layerMask) noexcept {
     if (instance) {
         mManager[instance].layers = layerMask;
+        mGenerationCount++;
     }
 }
 
@@ -343,6 +363,7 @@ void FRenderableManager::setPriority(Instance instance, uint8_t priority) noexce
     if (instance) {
         Visibility& visibility = mManager[instance].visibility;
         visibility.priority = std::min(priority, uint8_t(0x7));
+        mGenerationCount++;
     }
 }
 
@@ -350,6 +371,7 @@ void FRenderableManager::setChannel(Instance instance, uint8_t channel) noexcept
     if (instance) {
         Visibility& visibility = mManager[instance].visibility;
         visibility.channel = std::min(channel, uint8_t(0x3));
+        mGenerationCount++;
     }
 }
 
@@ -357,6 +379,7 @@ void FRenderableManager::setCastShadows(Instance instance, bool enable) noexcept
     if (instance) {
         Visibility& visibility = mManager[instance].visibility;
         visibility.castShadows = enable;
+        mGenerationCount++;
     }
 }
 
@@ -364,6 +387,7 @@ void FRenderableManager::setReceiveShadows(Instance instance, bool enable) noexc
     if (instance) {
         Visibility& visibility = mManager[instance].visibility;
         visibility.receiveShadows = enable;
+        mGenerationCount++;
     }
 }
 
@@ -371,6 +395,7 @@ void FRenderableManager::setScreenSpaceContactShadows(Instance instance, bool en
     if (instance) {
         Visibility& visibility = mManager[instance].visibility;
         visibility.screenSpaceContactShadows = enable;
+        mGenerationCount++;
     }
 }
 
@@ -378,6 +403,7 @@ void FRenderableManager::setCulling(Instance instance, bool enable) noexcept {
     if (instance) {
         Visibility& visibility = mManager[instance].visibility;
         visibility.culling = enable;
+        mGenerationCount++;
     }
 }
 
@@ -385,6 +411,7 @@ void FRenderableManager::setFogEnabled(Instance instance, bool enable) noexcept
     if (instance) {
         Visibility& visibility = mManager[instance].visibility;
         visibility.fog = enable;
+        mGenerationCount++;
     }
 }
 
@@ -392,6 +419,18 @@ bool FRenderableManager::getFogEnabled(RenderableManager::Instance instance) con
     return getVisibility(instance).fog;
 }
 
+void FRenderableManager::setShadowOnly(Instance instance, bool enable) noexcept {
+    if (instance) {
+        Visibility& visibility = mManager[instance].visibility;
+        visibility.shadowOnly = enable;
+        mGenerationCount++;
+    }
+}
+
+bool FRenderableManager::isShadowOnly(Instance instance) const noexcept {
+    return getVisibility(instance).shadowOnly;
+}
+
 void FRenderableManager::setSkinning(Instance instance, bool enable) {
     if (instance) {
         Visibility& visibility = mManager[instance].visibility;
@@ -400,6 +439,7 @@ void FRenderableManager::setSkinning(Instance instance, bool enable) {
                 << "Skinning can't be used with STATIC geometry";
 
         visibility.skinning = enable;
+        mGenerationCount++;
     }
 }
 
@@ -411,6 +451,7 @@ void FRenderableManager::setMorphing(Instance instance, bool enable) {
                 << "Morphing can't be used with STATIC geometry";
 
         visibility.morphing = enable;
+        mGenerationCount++;
     }
 }
 
@@ -418,6 +459,7 @@ void FRenderableManager::setPrimitives(Instance instance,
         utils::Slice<FRenderPrimitive> const& primitives) noexcept {
     if (instance) {
         mManager[instance].primitives = primitives;
+        mGenerationCount++;
     }
 }
 
@@ -19,6 +19,8 @@
 #include <math/mat4.h>
 
 #include <utils/debug.h>
+#include <utils/FixedCapacityVector.h>
+#include <utils/JobSystem.h>
 #include <filament/TransformManager.h>
 
 
@@ -147,6 +149,8 @@ void FTransformManager::destroy(Entity e) noexcept {
     Instance const i = manager.getInstance(e);
     validateNode(i);
     if (i) {
+        mGenerationCount++;
+
         // 1) remove the entry from the linked lists
         removeNode(i);
 
@@ -190,6 +194,7 @@ void FTransformManager::setTransform(Instance ci, const mat4& model) noexcept {
 }
 
 void FTransformManager::updateNodeTransform(Instance i) noexcept {
+    mGenerationCount++;
     if (UTILS_UNLIKELY(mLocalTransformTransactionOpen)) {
         return;
     }
@@ -221,10 +226,33 @@ void FTransformManager::openLocalTransformTransaction() noexcept {
 void FTransformManager::commitLocalTransformTransaction() noexcept {
     if (mLocalTransformTransactionOpen) {
         mLocalTransformTransactionOpen = false;
+        mGenerationCount++;
         computeAllWorldTransforms();
     }
 }
 
+void FTransformManager::commitWorldTransformSnapshot() noexcept {
+    auto const worlds = mManager.slice<WORLD>();
+    auto const worldsLo = mManager.slice<WORLD_LO>();
+    uint32_t const state = mWorldSnapshotState.load(std::memory_order_relaxed);
+    uint32_t const back = (state & SNAPSHOT_INDEX) ^ SNAPSHOT_INDEX;
+    auto& snapshot = mWorldSnapshot[back];
+    auto& seq = mWorldSnapshotSeq[back];
+    // When the simulation outpaces rendering, this buffer may still be scanned by an
+    // in-flight prepare pass; the odd sequence makes those readers retry against the
+    // buffer published below instead of observing torn matrices.
+    seq.fetch_add(1, std::memory_order_acq_rel);
+    size_t const count = worlds.size();
+    snapshot.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        snapshot[i] = { worlds[i], worldsLo[i] };
+    }
+    seq.fetch_add(1, std::memory_order_release);
+    // publish the new front buffer; the release store pairs with the acquire load in
+    // getCommittedWorldTransformAccurate()
+    mWorldSnapshotState.store(SNAPSHOT_VALID | back, std::memory_order_release);
+}
+
 void FTransformManager::computeAllWorldTransforms() noexcept {
     auto& manager = mManager;
 
@@ -233,19 +261,89 @@ void FTransformManager::computeAllWorldTransforms() noexcept {
     auto& soa = manager.getSoA();
     soa.ensureCapacity(soa.size() + 1);
 
+    // Ensure that children are always sorted after their parent. In steady state (no
+    // re-parenting since the last commit) this is a pure scan.
     for (Instance i = manager.begin(), e = manager.end(); i != e; ++i) {
-        // Ensure that children are always sorted after their parent.
         while (UTILS_UNLIKELY(Instance(manager[i].parent) > i)) {
             swapNode(i, manager[i].parent);
         }
-        Instance const parent = manager[i].parent;
-        assert_invariant(parent < i);
+        assert_invariant(Instance(manager[i].parent) < i);
+    }
 
-        FTransformManager::computeWorldTransform(
-                manager[i].world, manager[i].worldTranslationLo,
-                manager[parent].world, manager[i].local,
-                manager[parent].worldTranslationLo, manager[i].localTranslationLo,
-                accurate);
+    size_t const count = manager.getComponentCount();
+
+    // Below this size, the level-bucketing pass and job dispatch cost more than they save.
+    constexpr size_t JOBS_PARALLEL_FOR_TRANSFORMS_COUNT = 2048;
+
+    if (UTILS_LIKELY(count < JOBS_PARALLEL_FOR_TRANSFORMS_COUNT || !mJobSystem)) {
+        for (Instance i = manager.begin(), e = manager.end(); i != e; ++i) {
+            Instance const parent = manager[i].parent;
+            FTransformManager::computeWorldTransform(
+                    manager[i].world, manager[i].worldTranslationLo,
+                    manager[parent].world, manager[i].local,
+                    manager[parent].worldTranslationLo, manager[i].localTranslationLo,
+                    accurate);
+        }
+        return;
+    }
+
+    // Bucket nodes by hierarchy depth: within one level no node is an ancestor of another,
+    // so a whole level can be processed in parallel, siblings contiguously. Parents sort
+    // before their children (ensured above), so depths are computed in one forward pass.
+    // Index 0 is the identity root, depth 0.
+    auto depth = FixedCapacityVector<uint32_t>(count + 1, 0);
+    uint32_t maxDepth = 0;
+    for (uint32_t i = 1; i <= count; i++) {
+        Instance const parent = manager[Instance(i)].parent;
+        uint32_t const d = depth[parent.asValue()] + 1;
+        depth[i] = d;
+        maxDepth = std::max(maxDepth, d);
+    }
+
+    // counting sort of the instances by depth; level d occupies
+    // [levelStart[d], levelStart[d + 1]) in 'sorted'
+    auto levelStart = FixedCapacityVector<uint32_t>(maxDepth + 2, 0);
+    for (uint32_t i = 1; i <= count; i++) {
+        levelStart[depth[i] + 1]++;
+    }
+    for (uint32_t d = 1; d <= maxDepth; d++) {
+        levelStart[d + 1] += levelStart[d];
+    }
+    auto sorted = FixedCapacityVector<uint32_t>(count, 0);
+    {
+        auto cursor = levelStart;
+        for (uint32_t i = 1; i <= count; i++) {
+            sorted[cursor[depth[i]]++] = i;
+        }
+    }
+
+    auto work = [&manager, accurate](uint32_t const* first, size_t c) {
+        for (size_t k = 0; k < c; k++) {
+            Instance const i{ first[k] };
+            Instance const parent = manager[i].parent;
+            FTransformManager::computeWorldTransform(
+                    manager[i].world, manager[i].worldTranslationLo,
+                    manager[parent].world, manager[i].local,
+                    manager[parent].worldTranslationLo, manager[i].localTranslationLo,
+                    accurate);
+        }
+    };
+
+    // Each level only depends on the previous one, so we synchronize between levels and
+    // parallelize within them. Narrow levels (e.g. deep chains) stay on the calling thread.
+    JobSystem& js = *mJobSystem;
+    constexpr size_t JOBS_PARALLEL_FOR_TRANSFORMS_LEVEL_COUNT = 512;
+    for (uint32_t d = 1; d <= maxDepth; d++) {
+        uint32_t const* const first = sorted.data() + levelStart[d];
+        size_t const levelCount = levelStart[d + 1] - levelStart[d];
+        if (levelCount <= JOBS_PARALLEL_FOR_TRANSFORMS_LEVEL_COUNT) {
+            work(first, levelCount);
+        } else {
+            auto* job = jobs::parallel_for(js, nullptr, first, levelCount,
+                    std::cref(work),
+                    jobs::CountSplitter<JOBS_PARALLEL_FOR_TRANSFORMS_LEVEL_COUNT>());
+            js.runAndWait(job);
+        }
     }
 }
 
@@ -471,7 +569,9 @@ void FTransformManager::validateNode(UTILS_UNUSED_IN_RELEASE Instance i) noexcep
 }
 
 void FTransformManager::gc(utils::EntityManager& em) noexcept {
-    mManager.gc(em, [this](Entity e) {
+    // collection is budgeted to spread the cost of mass destructions over several frames
+    constexpr size_t GC_BUDGET = 256;
+    mManager.gc(em, 4, GC_BUDGET, [this](Entity e) {
                 destroy(e);
             });
 }
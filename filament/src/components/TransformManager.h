@@ -28,6 +28,13 @@
 
 #include <math/mat4.h>
 
+#include <atomic>
+#include <vector>
+
+namespace utils {
+class JobSystem;
+} // namespace utils
+
 namespace filament {
 
 class UTILS_PRIVATE FTransformManager : public TransformManager {
@@ -40,6 +47,13 @@ public:
     // free-up all resources
     void terminate() noexcept;
 
+    // set by FEngine to allow parallel world-transform updates
+    void setJobSystem(utils::JobSystem* js) noexcept { mJobSystem = js; }
+
+    // Monotonic counter bumped whenever any world transform changes; used by FView to
+    // invalidate retained-mode command buffers.
+    uint32_t getGenerationCount() const noexcept { return mGenerationCount; }
+
 
     /*
     * Component Manager APIs
@@ -99,6 +113,45 @@ public:
 
     void commitLocalTransformTransaction() noexcept;
 
+    void commitWorldTransformSnapshot() noexcept;
+
+    bool hasCommittedWorldTransforms() const noexcept {
+        return mWorldSnapshotState.load(std::memory_order_relaxed) & SNAPSHOT_VALID;
+    }
+
+    // World transform as published by the last commitWorldTransformSnapshot(), unaffected by
+    // concurrent setTransform() calls from a simulation thread. Falls back to the live value
+    // when no snapshot exists or the component was created after the last commit.
+    //
+    // The read is guarded by a per-buffer seqlock: when the simulation commits twice while
+    // one prepare pass is still in flight, the second commit reuses the buffer being read;
+    // the sequence re-check detects this and retries against the newly published front
+    // buffer instead of returning torn matrices.
+    math::mat4 getCommittedWorldTransformAccurate(Instance ci) const noexcept {
+        for (;;) {
+            uint32_t const state = mWorldSnapshotState.load(std::memory_order_acquire);
+            if (UTILS_UNLIKELY(!(state & SNAPSHOT_VALID))) {
+                return getWorldTransformAccurate(ci);
+            }
+            uint32_t const index = state & SNAPSHOT_INDEX;
+            uint32_t const seq = mWorldSnapshotSeq[index].load(std::memory_order_acquire);
+            if (UTILS_UNLIKELY(seq & 1u)) {
+                continue; // a commit is copying into this buffer, the state is about to move
+            }
+            auto const& snapshot = mWorldSnapshot[index];
+            if (UTILS_UNLIKELY(size_t(ci) >= snapshot.size())) {
+                return getWorldTransformAccurate(ci);
+            }
+            TransformSnapshot const s = snapshot[size_t(ci)];
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (UTILS_LIKELY(mWorldSnapshotSeq[index].load(std::memory_order_relaxed) == seq)) {
+                math::mat4 r(s.world);
+                r[3].xyz += s.worldTranslationLo;
+                return r;
+            }
+        }
+    }
+
     void gc(utils::EntityManager& em) noexcept;
 
     utils::Slice<const math::mat4f> getWorldTransforms() const noexcept {
@@ -208,7 +261,28 @@ private:
         }
     };
 
+    struct TransformSnapshot {
+        math::mat4f world;
+        math::float3 worldTranslationLo;
+    };
+
     Sim mManager;
+
+    // Double-buffered world transform snapshot, see commitWorldTransformSnapshot().
+    // mWorldSnapshotState packs the front buffer index and a valid bit; the commit
+    // publishes with a release store, readers load with acquire. Each buffer also carries
+    // a sequence counter, odd while a commit is copying into it, so a reader caught in a
+    // buffer being recycled retries (see getCommittedWorldTransformAccurate()). The
+    // vectors can only reallocate when components were created, which the public API
+    // already requires to be synchronized with rendering.
+    static constexpr uint32_t SNAPSHOT_INDEX = 0x1;
+    static constexpr uint32_t SNAPSHOT_VALID = 0x2;
+    std::vector<TransformSnapshot> mWorldSnapshot[2];
+    std::atomic<uint32_t> mWorldSnapshotSeq[2] = { };
+    std::atomic<uint32_t> mWorldSnapshotState{ 0 };
+
+    utils::JobSystem* mJobSystem = nullptr;
+    uint32_t mGenerationCount = 0;
     bool mLocalTransformTransactionOpen = false;
     bool mAccurateTranslations = false;
 };
@@ -61,9 +61,11 @@ FBufferObject::FBufferObject(FEngine& engine, const BufferObject::Builder& build
     if (auto name = builder.getName(); !name.empty()) {
         driver.setDebugTag(mHandle.getId(), std::move(name));
     }
+    engine.getMemoryTracker().track(Engine::MemoryCategory::BUFFER_OBJECT, mByteCount);
 }
 
 void FBufferObject::terminate(FEngine& engine) {
+    engine.getMemoryTracker().release(Engine::MemoryCategory::BUFFER_OBJECT, mByteCount);
     FEngine::DriverApi& driver = engine.getDriverApi();
     driver.destroyBufferObject(mHandle);
 }
@@ -30,6 +30,10 @@
 
 #include <math/vec2.h>
 
+#include <algorithm>
+#include <initializer_list>
+#include <limits>
+
 using namespace filament::math;
 using namespace utils;
 
@@ -80,6 +84,72 @@ math::mat4 FCamera::projection(double focalLengthInMillimeters,
     return p;
 }
 
+math::mat4 FCamera::computeCullingProjection(math::mat4 const* eyeProjection,
+        math::mat4 const* eyeModel, size_t count, double near, double far) {
+    // We build a "super frustum" in head space that bounds the frusta of all eyes. Because
+    // the eyes are offset from the head origin, the apex of the combined frustum must be
+    // receded along +z until every eye's apex lies inside the combined cone of directions;
+    // this is exact for purely translated eyes and conservative for slightly canted ones.
+
+    // angular bounds of the combined frustum, as slopes at unit distance
+    double tanLeft = std::numeric_limits<double>::max();
+    double tanRight = std::numeric_limits<double>::lowest();
+    double tanBottom = std::numeric_limits<double>::max();
+    double tanTop = std::numeric_limits<double>::lowest();
+    // by how much a far-plane corner can be farther (in head-space -z) than `far`
+    double farScale = 1.0;
+
+    for (size_t i = 0; i < count; i++) {
+        mat4 const& p = eyeProjection[i];
+        FILAMENT_CHECK_PRECONDITION(p[2][3] == -1.0)
+                << "eye projection " << i << " must be a perspective projection";
+        // frustum slopes of this eye (see mat4::frustum)
+        const double sl = (p[2][0] - 1.0) / p[0][0];
+        const double sr = (p[2][0] + 1.0) / p[0][0];
+        const double sb = (p[2][1] - 1.0) / p[1][1];
+        const double st = (p[2][1] + 1.0) / p[1][1];
+        const mat3 r{ eyeModel[i].upperLeft() };
+        for (double const sx : { sl, sr }) {
+            for (double const sy : { sb, st }) {
+                // corner ray at unit distance, rotated into head space
+                double3 const d = r * double3{ sx, sy, -1.0 };
+                FILAMENT_CHECK_PRECONDITION(d.z < 0.0)
+                        << "eye " << i << " frustum must face forward (-z in head space)";
+                tanLeft   = std::min(tanLeft,   d.x / -d.z);
+                tanRight  = std::max(tanRight,  d.x / -d.z);
+                tanBottom = std::min(tanBottom, d.y / -d.z);
+                tanTop    = std::max(tanTop,    d.y / -d.z);
+                farScale  = std::max(farScale, -d.z);
+            }
+        }
+    }
+
+    // recede the apex until every eye origin lies inside the combined cone of directions
+    double apex = 0.0;
+    double minEyeZ = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        double3 const o = eyeModel[i][3].xyz;
+        apex = std::max(apex, o.z);
+        if (tanRight > 0.0)  { apex = std::max(apex, o.z + o.x / tanRight); }
+        if (tanLeft < 0.0)   { apex = std::max(apex, o.z + o.x / tanLeft); }
+        if (tanTop > 0.0)    { apex = std::max(apex, o.z + o.y / tanTop); }
+        if (tanBottom < 0.0) { apex = std::max(apex, o.z + o.y / tanBottom); }
+        minEyeZ = std::min(minEyeZ, o.z);
+    }
+
+    // Receding the apex only moves the eyes' near planes farther away, so a near plane at
+    // `near` from the apex is conservative. The far plane however must be pushed back.
+    double const f = (apex - minEyeZ) + far * farScale;
+    mat4 p = mat4::frustum(tanLeft * near, tanRight * near, tanBottom * near, tanTop * near,
+            near, f);
+    if (f == std::numeric_limits<double>::infinity()) {
+        p[2][2] = -1.0f;           // lim(far->inf) = -1
+        p[3][2] = -2.0f * near;    // lim(far->inf) = -2*near
+    }
+    // the culling frustum is expressed in head space: shift it to the receded apex
+    return p * mat4::translation(double3{ 0.0, 0.0, -apex });
+}
+
 /*
  * All methods for setting the projection funnel through here
  */
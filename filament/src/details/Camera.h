@@ -66,6 +66,11 @@ public:
     void setCustomEyeProjection(math::mat4 const* projection, size_t count,
             math::mat4 const& projectionForCulling, double near, double far);
 
+    // Computes a head-space projection matrix bounding the frusta of all eyes, suitable as
+    // the projectionForCulling parameter of setCustomEyeProjection.
+    static math::mat4 computeCullingProjection(math::mat4 const* eyeProjection,
+            math::mat4 const* eyeModel, size_t count, double near, double far);
+
 
     void setScaling(math::double2 scaling) noexcept { mScalingCS = scaling; }
 
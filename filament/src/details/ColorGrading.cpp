@@ -29,6 +29,7 @@
 #include <math/vec3.h>
 #include <math/vec4.h>
 
+#include <utils/Hash.h>
 #include <utils/JobSystem.h>
 #include <utils/Mutex.h>
 #include <utils/Systrace.h>
@@ -623,6 +624,97 @@ static ColorTransform selectOETF(const ColorSpace& colorSpace) noexcept {
     return OETF_sRGB;
 }
 
+//------------------------------------------------------------------------------
+// LUT cache
+//------------------------------------------------------------------------------
+
+// The tone mapper is polymorphic and mutable, so it can't contribute to the key by pointer
+// identity; instead it contributes through its response at a few probe points, which also
+// covers two different ToneMapper objects configured identically.
+uint32_t FColorGrading::computeLutCacheKey(Builder const& builder) noexcept {
+    struct {
+        float2 whiteBalance;
+        float3 outRed, outGreen, outBlue;
+        float3 shadows, midtones, highlights;
+        float4 tonalRanges;
+        float3 slope, offset, power;
+        float contrast, vibrance, saturation;
+        float3 shadowGamma, midPoint, highlightScale;
+        float exposure, nightAdaptation;
+        float3 probes[4];
+        uint32_t flags;
+    } key = {
+        builder->whiteBalance,
+        builder->outRed, builder->outGreen, builder->outBlue,
+        builder->shadows, builder->midtones, builder->highlights,
+        builder->tonalRanges,
+        builder->slope, builder->offset, builder->power,
+        builder->contrast, builder->vibrance, builder->saturation,
+        builder->shadowGamma, builder->midPoint, builder->highlightScale,
+        builder->exposure, builder->nightAdaptation,
+        {},
+        uint32_t(builder->format)
+                | uint32_t(builder->dimension) << 2u
+                | uint32_t(builder->luminanceScaling) << 10u
+                | uint32_t(builder->gamutMapping) << 11u
+                | uint32_t(builder->hasAdjustments) << 12u
+                // only the transfer function of the output color space affects the LUT
+                | uint32_t(builder->outputColorSpace.getTransferFunction() == Linear) << 13u
+                | uint32_t(builder->toneMapping) << 14u
+    };
+    for (size_t i = 0; i < 4; i++) {
+        float const x = float(i * i) * 1.5f + 0.02f;    // 0.02, 1.52, 6.02, 13.52
+        key.probes[i] = (*builder->toneMapper)(float3{ x, x * 0.5f, x * 0.25f });
+    }
+    return hash::murmur3(reinterpret_cast<uint32_t const*>(&key), sizeof(key) / 4, 0);
+}
+
+// Small LRU cache of the most recently generated LUTs. Interactive grading toggles between a
+// handful of presets; re-creating a ColorGrading whose parameters hash the same skips the
+// LUT math entirely and only re-uploads the cached data. A 64^3 FLOAT LUT is 1 MiB, so the
+// cache stays small even when full.
+class LutCache {
+public:
+    // on a hit, copies the cached LUT into dst and returns true
+    bool lookup(uint32_t key, void* dst, size_t size) noexcept {
+        std::lock_guard<utils::Mutex> const lock(mLock);
+        for (Entry& e : mEntries) {
+            if (e.age && e.key == key && e.data.size() == size) {
+                memcpy(dst, e.data.data(), size);
+                e.age = mClock++;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void insert(uint32_t key, void const* data, size_t size) noexcept {
+        std::lock_guard<utils::Mutex> const lock(mLock);
+        Entry* victim = &mEntries[0];
+        for (Entry& e : mEntries) {
+            if (e.age < victim->age) {
+                victim = &e;
+            }
+        }
+        victim->key = key;
+        victim->age = mClock++;
+        victim->data.assign((uint8_t const*)data, (uint8_t const*)data + size);
+    }
+
+private:
+    struct Entry {
+        uint32_t key = 0;
+        uint32_t age = 0;       // 0 means empty
+        std::vector<uint8_t> data;
+    };
+    static constexpr size_t ENTRY_COUNT = 4;
+    Entry mEntries[ENTRY_COUNT];
+    uint32_t mClock = 1;
+    utils::Mutex mLock;
+};
+
+static LutCache sLutCache;
+
 //------------------------------------------------------------------------------
 // Color grading implementation
 //------------------------------------------------------------------------------
@@ -678,12 +770,17 @@ FColorGrading::FColorGrading(FEngine& engine, const Builder& builder) {
 
     //auto now = std::chrono::steady_clock::now();
 
+    // If an identical LUT was generated recently, reuse its data and skip the math below.
+    uint32_t const cacheKey = computeLutCacheKey(builder);
+    size_t const uploadSize = lutElementCount * (converted ? sizeof(uint32_t) : elementSize);
+    bool const cacheHit = sLutCache.lookup(cacheKey, converted ? converted : data, uploadSize);
+
     // Multithreadedly generate the tone mapping 3D look-up table using 32 jobs
     // Slices are 8 KiB (128 cache lines) apart.
     // This takes about 3-6ms on Android in Release
     JobSystem& js = engine.getJobSystem();
     auto *slices = js.createJob();
-    for (size_t b = 0; b < c.lutDimension; b++) {
+    for (size_t b = 0; !cacheHit && b < c.lutDimension; b++) {
         auto *job = js.createJob(slices,
                 [data, converted, b, &c, &configLock, builder](JobSystem&, JobSystem::Job*) {
             Config config;
@@ -810,6 +907,7 @@ FColorGrading::FColorGrading(FEngine& engine, const Builder& builder) {
     //       getHwHandle() is invoked?
     js.runAndWait(slices);
 
+
     //std::chrono::duration<float, std::milli> duration = std::chrono::steady_clock::now() - now;
     //slog.d << "LUT generation time: " << duration.count() << " ms" << io::endl;
 
@@ -830,6 +928,10 @@ FColorGrading::FColorGrading(FEngine& engine, const Builder& builder) {
         elementSize = sizeof(uint32_t);
     }
 
+    if (!cacheHit) {
+        sLutCache.insert(cacheKey, data, lutElementCount * elementSize);
+    }
+
     driver.update3DImage(mLutHandle, 0,
             0, 0, 0,
             c.lutDimension, c.lutDimension, c.lutDimension,
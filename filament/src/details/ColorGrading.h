@@ -46,6 +46,9 @@ public:
     uint32_t getDimension() const noexcept { return mDimension; }
 
 private:
+    // hash of everything that feeds the LUT math, used to key the LUT cache
+    static uint32_t computeLutCacheKey(Builder const& builder) noexcept;
+
     backend::TextureHandle mLutHandle;
     uint32_t mDimension;
 };
@@ -24,10 +24,13 @@
 #include <math/vec3.h>
 #include <math/vec4.h>
 
+#include <atomic>
 #include <functional>
 #include <string_view>
 #include <utility>
 
+#include <string.h>
+
 using namespace filament::math;
 using namespace utils;
 
@@ -59,11 +62,30 @@ void const* FDebugRegistry::getPropertyAddress(const char* name) const noexcept
     return info.first;
 }
 
-void FDebugRegistry::registerProperty(std::string_view name, void* p, Type,
+size_t FDebugRegistry::propertySize(Type const type) noexcept {
+    switch (type) {
+        case BOOL:      return sizeof(bool);
+        case INT:       return sizeof(int);
+        case FLOAT:     return sizeof(float);
+        case FLOAT2:    return sizeof(float2);
+        case FLOAT3:    return sizeof(float3);
+        case FLOAT4:    return sizeof(float4);
+    }
+    return 0;
+}
+
+void FDebugRegistry::registerProperty(std::string_view name, void* p, Type const type,
         std::function<void()> fn) noexcept {
     auto& propertyMap = mPropertyMap;
     if (propertyMap.find(name) == propertyMap.end()) {
         propertyMap[name] = { p, std::move(fn) };
+        // also reserve a slot in the telemetry snapshot, so the property's value can be
+        // sampled from any thread (see publishFrameTelemetry)
+        size_t const size = propertySize(type);
+        if (mSnapshotUsed + size <= SNAPSHOT_CAPACITY) {
+            mSnapshotMap[name] = { p, mSnapshotUsed, uint32_t(size) };
+            mSnapshotUsed += uint32_t(size);
+        }
     }
 }
 
@@ -136,6 +158,69 @@ void FDebugRegistry::unregisterDataSource(std::string_view name) noexcept {
 }
 
 
+void FDebugRegistry::publishFrameTelemetry(FrameTelemetry const& telemetry) noexcept {
+    // Sequence-lock writer: the sequence is odd while the snapshot is inconsistent. There is a
+    // single writer (the renderer, once per frame), so a plain increment is enough; readers
+    // retry when they observe an odd value, or a value that changed while they were copying.
+    uint32_t const seq = mSnapshotSeq.load(std::memory_order_relaxed);
+    mSnapshotSeq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    mTelemetry = telemetry;
+    for (auto const& [name, entry] : mSnapshotMap) {
+        memcpy(mSnapshotData + entry.offset, entry.source, entry.size);
+    }
+    mSnapshotSeq.store(seq + 2, std::memory_order_release);
+}
+
+bool FDebugRegistry::getFrameTelemetry(FrameTelemetry* telemetry) const noexcept {
+    for (;;) {
+        uint32_t const before = mSnapshotSeq.load(std::memory_order_acquire);
+        if (before == 0) {
+            // no frame has been published yet
+            return false;
+        }
+        if (before & 1u) {
+            // a publish is in progress, spin until it completes
+            continue;
+        }
+        *telemetry = mTelemetry;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (mSnapshotSeq.load(std::memory_order_relaxed) == before) {
+            return true;
+        }
+    }
+}
+
+template<typename T>
+bool FDebugRegistry::getSampledProperty(const char* name, T* p) const noexcept {
+    auto const& it = mSnapshotMap.find(std::string_view{ name });
+    if (it == mSnapshotMap.end() || it->second.size != sizeof(T)) {
+        return false;
+    }
+    SnapshotEntry const& entry = it->second;
+    for (;;) {
+        uint32_t const before = mSnapshotSeq.load(std::memory_order_acquire);
+        if (before == 0) {
+            return false;
+        }
+        if (before & 1u) {
+            continue;
+        }
+        memcpy(p, mSnapshotData + entry.offset, sizeof(T));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (mSnapshotSeq.load(std::memory_order_relaxed) == before) {
+            return true;
+        }
+    }
+}
+
+template bool FDebugRegistry::getSampledProperty<bool>(const char* name, bool* v) const noexcept;
+template bool FDebugRegistry::getSampledProperty<int>(const char* name, int* v) const noexcept;
+template bool FDebugRegistry::getSampledProperty<float>(const char* name, float* v) const noexcept;
+template bool FDebugRegistry::getSampledProperty<float2>(const char* name, float2* v) const noexcept;
+template bool FDebugRegistry::getSampledProperty<float3>(const char* name, float3* v) const noexcept;
+template bool FDebugRegistry::getSampledProperty<float4>(const char* name, float4* v) const noexcept;
+
 DebugRegistry::DataSource FDebugRegistry::getDataSource(const char* name) const noexcept {
     std::string_view const key{ name };
     auto& dataSourceMap = mDataSourceMap;
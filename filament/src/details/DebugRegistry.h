@@ -26,12 +26,14 @@
 
 #include <math/mathfwd.h>
 
+#include <atomic>
 #include <functional>
 #include <string_view>
 #include <unordered_map>
 #include <utility>
 
 #include <stddef.h>
+#include <stdint.h>
 
 namespace filament {
 
@@ -109,11 +111,17 @@ public:
 
     void unregisterDataSource(std::string_view name) noexcept;
 
+    // Mirrors the frame counters and all registered properties into a snapshot that any thread
+    // can read without blocking the engine (see getFrameTelemetry() / getSampledProperty()).
+    // Called by the renderer once per frame; must not be called concurrently with itself.
+    void publishFrameTelemetry(FrameTelemetry const& telemetry) noexcept;
+
 #if !defined(_MSC_VER)
 private:
 #endif
     template<typename T> bool getProperty(const char* name, T* p) const noexcept;
     template<typename T> bool setProperty(const char* name, T v) noexcept;
+    template<typename T> bool getSampledProperty(const char* name, T* p) const noexcept;
 
 private:
     using PropertyInfo = std::pair<void*, std::function<void()>>;
@@ -124,9 +132,27 @@ private:
     void* getPropertyAddress(const char* name);
     void const* getPropertyAddress(const char* name) const noexcept;
     DataSource getDataSource(const char* name) const noexcept;
+    bool getFrameTelemetry(FrameTelemetry* telemetry) const noexcept;
+    static size_t propertySize(Type type) noexcept;
     std::unordered_map<std::string_view, PropertyInfo> mPropertyMap;
     mutable std::unordered_map<std::string_view, DataSource> mDataSourceMap;
     mutable std::unordered_map<std::string_view, utils::Invocable<DataSource()>> mDataSourceCreatorMap;
+
+    // Lock-free telemetry snapshot. Properties are registered during engine initialization,
+    // before any frame is published, so mSnapshotMap is immutable while frames are in flight;
+    // the snapshot payload itself is protected by mSnapshotSeq, a sequence lock whose value is
+    // odd while a publish is in progress.
+    struct SnapshotEntry {
+        void const* source;     // live property address, copied from at publish time
+        uint32_t offset;        // offset of the property's slot in mSnapshotData
+        uint32_t size;
+    };
+    static constexpr size_t SNAPSHOT_CAPACITY = 1024;
+    std::unordered_map<std::string_view, SnapshotEntry> mSnapshotMap;
+    uint32_t mSnapshotUsed = 0;
+    mutable std::atomic<uint32_t> mSnapshotSeq{ 0 };
+    FrameTelemetry mTelemetry{};
+    uint8_t mSnapshotData[SNAPSHOT_CAPACITY] = {};
 };
 
 FILAMENT_DOWNCAST(DebugRegistry)
@@ -54,6 +54,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <new>
 #include <thread>
 
 #include "generated/resources/materials.h"
@@ -103,9 +104,12 @@ Engine* FEngine::create(Engine::Builder const& builder) {
         }
         DriverConfig const driverConfig{
                 .handleArenaSize = instance->getRequestedDriverHandleArenaSize(),
+                .handleArenaPoolWeights = instance->getConfig().driverHandleArenaPoolWeights,
                 .metalUploadBufferSizeBytes = instance->getConfig().metalUploadBufferSizeBytes,
+                .vulkanStagingRetentionBytes = instance->getConfig().vulkanStagingRetentionBytes,
                 .disableParallelShaderCompile = instance->getConfig().disableParallelShaderCompile,
                 .disableHandleUseAfterFreeCheck = instance->getConfig().disableHandleUseAfterFreeCheck,
+                .enableHandleSanitizer = instance->getConfig().enableHandleSanitizer,
                 .forceGLES2Context = instance->getConfig().forceGLES2Context,
                 .stereoscopicType = instance->getConfig().stereoscopicType,
                 .assertNativeWindowIsValid = instance->getConfig().assertNativeWindowIsValid,
@@ -209,9 +213,6 @@ FEngine::FEngine(Engine::Builder const& builder) :
                 builder->mConfig.minCommandBufferSizeMB * MiB,
                 builder->mConfig.commandBufferSizeMB * MiB,
                 builder->mPaused),
-        mPerRenderPassArena(
-                "FEngine::mPerRenderPassAllocator",
-                builder->mConfig.perRenderPassArenaSizeMB * MiB),
         mHeapAllocator("FEngine::mHeapAllocator", AreaPolicy::NullArea{}),
         mJobSystem(getJobSystemThreadPoolSize(builder->mConfig)),
         mEngineEpoch(std::chrono::steady_clock::now()),
@@ -223,6 +224,30 @@ FEngine::FEngine(Engine::Builder const& builder) :
     // (it may not be the case)
     mJobSystem.adopt();
 
+    if (mConfig.jobSystemAffinityMask) {
+        mJobSystem.setWorkerAffinityByMask(mConfig.jobSystemAffinityMask);
+    }
+
+    if (mConfig.driverThreadBatchSizeKiB > 0 && mConfig.driverThreadBatchWindowUs > 0) {
+        mCommandBufferQueue.setBatchingWindow(
+                size_t(mConfig.driverThreadBatchSizeKiB) * 1024u,
+                std::chrono::microseconds(mConfig.driverThreadBatchWindowUs));
+    }
+
+    if (mConfig.backgroundJobSystemThreadCount > 0) {
+        // a separate pool for throughput work (asset decoding, texture transcoding), so it can't
+        // strand latency-critical frame-preparation jobs behind it
+        mBackgroundJobSystem =
+                std::make_unique<JobSystem>(mConfig.backgroundJobSystemThreadCount);
+        if (mConfig.backgroundJobSystemAffinityMask) {
+            mBackgroundJobSystem->setWorkerAffinityByMask(
+                    mConfig.backgroundJobSystemAffinityMask);
+        }
+        mBackgroundJobSystem->adopt();
+    }
+
+    mTransformManager.setJobSystem(&mJobSystem);
+
     slog.i << "FEngine (" << sizeof(void*) * 8 << " bits) created at " << this << " "
            << "(threading is " << (UTILS_HAS_THREADING ? "enabled)" : "disabled)") << io::endl;
 }
@@ -239,6 +264,20 @@ uint32_t FEngine::getJobSystemThreadPoolSize(Engine::Config const& config) noexc
     return threadCount;
 }
 
+utils::ThermalManager::ThermalStatus FEngine::getThermalStatus() noexcept {
+    // Polling the OS for the thermal status can be costly (it's a binder call on Android),
+    // and it changes slowly, so we refresh the cached value at most once per second.
+    auto const now = std::chrono::steady_clock::now();
+    if (UTILS_UNLIKELY(now - mThermalStatusPollTime >= std::chrono::seconds(1))) {
+        mThermalStatusPollTime = now;
+        auto const status = mThermalManager.getCurrentThermalStatus();
+        if (status != utils::ThermalManager::ThermalStatus::ERROR) {
+            mThermalStatus = status;
+        }
+    }
+    return mThermalStatus;
+}
+
 /*
  * init() is called just after the driver thread is initialized. Driver commands are therefore
  * possible.
@@ -264,6 +303,7 @@ void FEngine::init() {
 
 
     mResourceAllocatorDisposer = std::make_shared<ResourceAllocatorDisposer>(driverApi);
+    mResourceAllocatorDisposer->setMemoryTracker(&mMemoryTracker);
 
     mFullScreenTriangleVb = downcast(VertexBuffer::Builder()
             .vertexCount(3)
@@ -443,6 +483,9 @@ void FEngine::init() {
                 });
             });
 
+    mDebugRegistry.registerProperty("d.materials.gpu_profiling",
+            &debug.materials.gpu_profiling);
+
     mInitialized = true;
 }
 
@@ -479,6 +522,7 @@ void FEngine::shutdown() {
      */
 
     mPostProcessManager.terminate(driver);  // free-up post-process manager resources
+    mMaterialProfiler.terminate(driver);    // free-up the per-material timer queries
     mResourceAllocatorDisposer->terminate();
     mResourceAllocatorDisposer.reset();
     mDFG.terminate(*this);                  // free-up the DFG
@@ -525,6 +569,8 @@ void FEngine::shutdown() {
     cleanupResourceList(std::move(mMorphTargetBuffers));
     cleanupResourceList(std::move(mSkinningBuffers));
     cleanupResourceList(std::move(mVertexBuffers));
+    // atlases own a texture each, so they must go before the texture list
+    cleanupResourceList(std::move(mTextureAtlases));
     cleanupResourceList(std::move(mTextures));
     cleanupResourceList(std::move(mRenderTargets));
     cleanupResourceList(std::move(mMaterials));
@@ -533,6 +579,9 @@ void FEngine::shutdown() {
         cleanupResourceList(std::move(item.second));
     }
 
+    // this must be done after all material instances have been destroyed
+    mUniformBufferArena.terminate(driver);
+
     cleanupResourceListLocked(mFenceListLock, std::move(mFences));
 
     driver.destroyTexture(mDummyOneTexture);
@@ -573,6 +622,10 @@ void FEngine::shutdown() {
      */
 
     // detach this thread from the JobSystem
+    if (mBackgroundJobSystem) {
+        mBackgroundJobSystem->emancipate();
+        mBackgroundJobSystem.reset();
+    }
     mJobSystem.emancipate();
 }
 
@@ -605,9 +658,51 @@ void FEngine::gc() {
     mCameraManager.gc(*this, em);
 }
 
-void FEngine::flush() {
+void FEngine::flush(bool urgent) {
     // flush the command buffer
-    flushCommandBuffer(mCommandBufferQueue);
+    flushCommandBuffer(mCommandBufferQueue, urgent);
+}
+
+void FEngine::enqueueDeferredUpload(FTexture const* texture,
+        FixedCapacityVector<TextureUpdateRegion>&& regions,
+        backend::PixelBufferDescriptor&& buffer, uint8_t const priority) {
+    mDeferredUploads.push_back({ texture, std::move(regions), std::move(buffer), priority });
+}
+
+void FEngine::cancelDeferredUploads(FTexture const* texture) noexcept {
+    auto& queue = mDeferredUploads;
+    queue.erase(std::remove_if(queue.begin(), queue.end(),
+            [texture](DeferredUpload const& upload) { return upload.texture == texture; }),
+            queue.end());
+}
+
+void FEngine::flushDeferredUploads() noexcept {
+    auto& queue = mDeferredUploads;
+    while (!queue.empty() && !isStagingBudgetExceeded()) {
+        // the most urgent batch goes first; min_element returns the first of equals, so
+        // this is FIFO within a priority
+        auto const pos = std::min_element(queue.begin(), queue.end(),
+                [](DeferredUpload const& lhs, DeferredUpload const& rhs) {
+                    return lhs.priority < rhs.priority;
+                });
+        pos->texture->submitImageBatch(*this, pos->regions, std::move(pos->buffer));
+        queue.erase(pos);
+    }
+}
+
+void FEngine::flushAndScheduleCallback(backend::CallbackHandler* handler,
+        utils::Invocable<void()>&& callback) {
+    struct Callback {
+        utils::Invocable<void()> f;
+        static void func(void* user) {
+            auto* const c = static_cast<Callback*>(user);
+            c->f();
+            delete c;
+        }
+    };
+    auto* const user = new(std::nothrow) Callback{ std::move(callback) };
+    getDriverApi().queueCallback(handler, &Callback::func, static_cast<void*>(user));
+    flush();
 }
 
 void FEngine::flushAndWait() {
@@ -698,12 +793,20 @@ int FEngine::loop() {
 
     JobSystem::setThreadName("FEngine::loop");
     JobSystem::setThreadPriority(JobSystem::Priority::DISPLAY);
+    if (mConfig.driverThreadAffinityMask) {
+        // typically used to reserve a core for the driver thread, keeping it from competing
+        // with the JobSystem workers (see Config::jobSystemAffinityMask)
+        JobSystem::setThreadAffinityByMask(mConfig.driverThreadAffinityMask);
+    }
 
     DriverConfig const driverConfig {
             .handleArenaSize = getRequestedDriverHandleArenaSize(),
+            .handleArenaPoolWeights = mConfig.driverHandleArenaPoolWeights,
             .metalUploadBufferSizeBytes = mConfig.metalUploadBufferSizeBytes,
+            .vulkanStagingRetentionBytes = mConfig.vulkanStagingRetentionBytes,
             .disableParallelShaderCompile = mConfig.disableParallelShaderCompile,
             .disableHandleUseAfterFreeCheck = mConfig.disableHandleUseAfterFreeCheck,
+            .enableHandleSanitizer = mConfig.enableHandleSanitizer,
             .forceGLES2Context = mConfig.forceGLES2Context,
             .stereoscopicType =  mConfig.stereoscopicType,
             .assertNativeWindowIsValid = mConfig.assertNativeWindowIsValid,
@@ -728,9 +831,9 @@ int FEngine::loop() {
     return 0;
 }
 
-void FEngine::flushCommandBuffer(CommandBufferQueue& commandQueue) {
+void FEngine::flushCommandBuffer(CommandBufferQueue& commandQueue, bool urgent) {
     getDriver().purge();
-    commandQueue.flush();
+    commandQueue.flush(urgent);
 }
 
 const FMaterial* FEngine::getSkyboxMaterial() const noexcept {
@@ -788,6 +891,10 @@ FTexture* FEngine::createTexture(const Texture::Builder& builder) noexcept {
     return create(mTextures, builder);
 }
 
+FTextureAtlas* FEngine::createTextureAtlas(const TextureAtlas::Builder& builder) noexcept {
+    return create(mTextureAtlases, builder);
+}
+
 FIndirectLight* FEngine::createIndirectLight(const IndirectLight::Builder& builder) noexcept {
     return create(mIndirectLights, builder);
 }
@@ -1061,6 +1168,11 @@ bool FEngine::destroy(const FTexture* p) {
     return terminateAndDestroy(p, mTextures);
 }
 
+UTILS_NOINLINE
+bool FEngine::destroy(const FTextureAtlas* p) {
+    return terminateAndDestroy(p, mTextureAtlases);
+}
+
 UTILS_NOINLINE
 bool FEngine::destroy(const FRenderTarget* p) {
     return terminateAndDestroy(p, mRenderTargets);
@@ -1219,6 +1331,10 @@ bool FEngine::isValid(const FTexture* p) const {
     return isValid(p, mTextures);
 }
 
+bool FEngine::isValid(const FTextureAtlas* p) const {
+    return isValid(p, mTextureAtlases);
+}
+
 bool FEngine::isValid(const FRenderTarget* p) const {
     return isValid(p, mRenderTargets);
 }
@@ -20,7 +20,10 @@
 #include "downcast.h"
 
 #include "Allocators.h"
+#include "BufferObjectArena.h"
 #include "DFG.h"
+#include "GpuMemoryTracker.h"
+#include "MaterialProfiler.h"
 #include "PostProcessManager.h"
 #include "ResourceList.h"
 #include "HwDescriptorSetLayoutFactory.h"
@@ -44,6 +47,7 @@
 #include "details/SkinningBuffer.h"
 #include "details/MorphTargetBuffer.h"
 #include "details/Skybox.h"
+#include "details/TextureAtlas.h"
 
 #include "private/backend/CommandBufferQueue.h"
 #include "private/backend/CommandStream.h"
@@ -66,12 +70,15 @@
 #include <utils/CountDownLatch.h>
 #include <utils/FixedCapacityVector.h>
 #include <utils/JobSystem.h>
+#include <utils/ThermalManager.h>
 #include <utils/compiler.h>
 
+#include <atomic>
 #include <chrono>
 #include <memory>
 #include <new>
 #include <random>
+#include <vector>
 #include <thread>
 #include <type_traits>
 #include <unordered_map>
@@ -143,12 +150,9 @@ public:
         return *std::launder(reinterpret_cast<DriverApi*>(&mDriverApiStorage));
     }
 
-    DFG const& getDFG() const noexcept { return mDFG; }
+    backend::CommandBufferQueue& getCommandBufferQueue() noexcept { return mCommandBufferQueue; }
 
-    // the per-frame Area is used by all Renderer, so they must run in sequence and
-    // have freed all allocated memory when done. If this needs to change in the future,
-    // we'll simply have to use separate Areas (for instance).
-    LinearAllocatorArena& getPerRenderPassArena() noexcept { return mPerRenderPassArena; }
+    DFG const& getDFG() const noexcept { return mDFG; }
 
     // Material IDs...
     uint32_t getMaterialId() const noexcept { return mMaterialId++; }
@@ -244,6 +248,10 @@ public:
         return mPlatform;
     }
 
+    // Current thermal status of the device, polled from the OS at most once per second.
+    // Used by dynamic resolution to anticipate thermal throttling.
+    utils::ThermalManager::ThermalStatus getThermalStatus() noexcept;
+
     // Return a vector of shader languages, in order of preference.
     utils::FixedCapacityVector<backend::ShaderLanguage> getShaderLanguage() const noexcept {
         switch (mBackend) {
@@ -298,6 +306,7 @@ public:
     FIndirectLight* createIndirectLight(const IndirectLight::Builder& builder) noexcept;
     FMaterial* createMaterial(const Material::Builder& builder, std::unique_ptr<MaterialParser> materialParser) noexcept;
     FTexture* createTexture(const Texture::Builder& builder) noexcept;
+    FTextureAtlas* createTextureAtlas(const TextureAtlas::Builder& builder) noexcept;
     FSkybox* createSkybox(const Skybox::Builder& builder) noexcept;
     FColorGrading* createColorGrading(const ColorGrading::Builder& builder) noexcept;
     FStream* createStream(const Stream::Builder& builder) noexcept;
@@ -340,6 +349,7 @@ public:
     bool destroy(const FColorGrading* p);
     bool destroy(const FStream* p);
     bool destroy(const FTexture* p);
+    bool destroy(const FTextureAtlas* p);
     bool destroy(const FRenderTarget* p);
     bool destroy(const FSwapChain* p);
     bool destroy(const FView* p);
@@ -362,6 +372,7 @@ public:
     bool isValid(const FSwapChain* p) const;
     bool isValid(const FStream* p) const;
     bool isValid(const FTexture* p) const;
+    bool isValid(const FTextureAtlas* p) const;
     bool isValid(const FRenderTarget* p) const;
     bool isValid(const FView* p) const;
     bool isValid(const FInstanceBuffer* p) const;
@@ -391,7 +402,14 @@ public:
     void flushAndWait();
 
     // flush the current buffer
-    void flush();
+    // Flushes the command stream to the driver thread. Non-urgent flushes may be coalesced
+    // into fewer driver-thread wakeups when Config::driverThreadBatchSizeKiB is set.
+    void flush(bool urgent = true);
+
+    // flush the current buffer and schedule a callback once the backend has executed all
+    // commands issued to this point; the non-blocking alternative to flushAndWait()
+    void flushAndScheduleCallback(backend::CallbackHandler* handler,
+            utils::Invocable<void()>&& callback);
 
     // flush the current buffer based on some heuristics
     void flushIfNeeded() {
@@ -429,6 +447,15 @@ public:
         return mDebugRegistry;
     }
 
+    MaterialProfiler& getMaterialProfiler() noexcept {
+        return mMaterialProfiler;
+    }
+
+    GpuMemoryTracker& getMemoryTracker() const noexcept {
+        // the tracker is thread-safe, it's always okay to return a non-const one
+        return const_cast<GpuMemoryTracker&>(mMemoryTracker);
+    }
+
     bool execute();
 
     utils::JobSystem& getJobSystem() const noexcept {
@@ -438,6 +465,12 @@ public:
         return const_cast<utils::JobSystem&>(mJobSystem);
     }
 
+    utils::JobSystem& getBackgroundJobSystem() const noexcept {
+        // only exists when Config::backgroundJobSystemThreadCount is non-zero, otherwise
+        // throughput work shares the main JobSystem as before
+        return mBackgroundJobSystem ? *mBackgroundJobSystem : getJobSystem();
+    }
+
     std::default_random_engine& getRandomEngine() {
         return mRandomEngine;
     }
@@ -459,6 +492,55 @@ public:
         return mAutomaticInstancingEnabled;
     }
 
+    /*
+     * Staging-memory budget for streaming uploads, see Engine::setStagingBudget().
+     * Upload calls reserve their pixel-buffer bytes on submission; the bytes are released
+     * from the backend thread once the upload command has been consumed into staging
+     * memory. While over budget, setImages() batches are queued here instead of being
+     * submitted, and flushed by flushDeferredUploads() as the budget frees up.
+     */
+
+    void setStagingBudget(size_t const budgetInBytes) noexcept {
+        mStagingBudget.store(budgetInBytes, std::memory_order_relaxed);
+    }
+
+    size_t getPendingUploadBytes() const noexcept {
+        return mPendingUploadBytes.load(std::memory_order_relaxed);
+    }
+
+    bool isStagingBudgetExceeded() const noexcept {
+        size_t const budget = mStagingBudget.load(std::memory_order_relaxed);
+        return budget && getPendingUploadBytes() > budget;
+    }
+
+    void reserveUploadBytes(size_t const bytes) noexcept {
+        mPendingUploadBytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    // called from the backend thread, see FTexture::submitImageBatch()
+    void releaseUploadBytes(size_t const bytes) noexcept {
+        mPendingUploadBytes.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+
+    // queues a batched upload until the staging budget frees up (main thread only)
+    void enqueueDeferredUpload(FTexture const* texture,
+            utils::FixedCapacityVector<backend::TextureUpdateRegion>&& regions,
+            backend::PixelBufferDescriptor&& buffer, uint8_t priority);
+
+    // drops queued uploads of a texture about to be destroyed
+    void cancelDeferredUploads(FTexture const* texture) noexcept;
+
+    // submits queued uploads, lowest priority value first, while under budget. Called at
+    // the latest from Renderer::beginFrame().
+    void flushDeferredUploads() noexcept;
+
+    bool hasDeferredUploads() const noexcept { return !mDeferredUploads.empty(); }
+
+    // monotonic engine-wide frame counter, incremented by Renderer::beginFrame(). Used for
+    // texture residency tracking, see FTexture::markUsedInFrame().
+    void advanceFrameCounter() noexcept { mFrameCounter++; }
+    uint32_t getFrameCounter() const noexcept { return mFrameCounter; }
+
     HwVertexBufferInfoFactory& getVertexBufferInfoFactory() noexcept {
         return mHwVertexBufferInfoFactory;
     }
@@ -467,6 +549,10 @@ public:
         return mHwDescriptorSetLayoutFactory;
     }
 
+    BufferObjectArena& getUniformBufferArena() noexcept {
+        return mUniformBufferArena;
+    }
+
     DescriptorSetLayout const& getPerViewDescriptorSetLayoutDepthVariant() const noexcept {
         return mPerViewDescriptorSetLayoutDepthVariant;
     }
@@ -506,7 +592,7 @@ private:
     void shutdown();
 
     int loop();
-    void flushCommandBuffer(backend::CommandBufferQueue& commandBufferQueue);
+    void flushCommandBuffer(backend::CommandBufferQueue& commandBufferQueue, bool urgent = true);
 
     backend::Driver& getDriver() const noexcept { return *mDriver; }
 
@@ -533,6 +619,20 @@ private:
     Platform* mPlatform = nullptr;
     bool mOwnPlatform = false;
     bool mAutomaticInstancingEnabled = false;
+    uint32_t mFrameCounter = 0;
+
+    // staging budget state, see Engine::setStagingBudget()
+    std::atomic<size_t> mStagingBudget = { 0 };
+    std::atomic<size_t> mPendingUploadBytes = { 0 };
+    struct DeferredUpload {
+        FTexture const* texture;
+        utils::FixedCapacityVector<backend::TextureUpdateRegion> regions;
+        backend::PixelBufferDescriptor buffer;
+        uint8_t priority;
+    };
+    // insertion order preserved, so flushing is FIFO within a priority (main thread only)
+    std::vector<DeferredUpload> mDeferredUploads;
+
     void* mSharedGLContext = nullptr;
     backend::Handle<backend::HwRenderPrimitive> mFullScreenTriangleRph;
     FVertexBuffer* mFullScreenTriangleVb = nullptr;
@@ -549,6 +649,7 @@ private:
     std::shared_ptr<ResourceAllocatorDisposer> mResourceAllocatorDisposer;
     HwVertexBufferInfoFactory mHwVertexBufferInfoFactory;
     HwDescriptorSetLayoutFactory mHwDescriptorSetLayoutFactory;
+    BufferObjectArena mUniformBufferArena;
     DescriptorSetLayout mPerViewDescriptorSetLayoutDepthVariant;
     DescriptorSetLayout mPerViewDescriptorSetLayoutSsrVariant;
     DescriptorSetLayout mPerRenderableDescriptorSetLayout;
@@ -567,6 +668,7 @@ private:
     ResourceList<FIndirectLight> mIndirectLights{ "IndirectLight" };
     ResourceList<FMaterial> mMaterials{ "Material" };
     ResourceList<FTexture> mTextures{ "Texture" };
+    ResourceList<FTextureAtlas> mTextureAtlases{ "TextureAtlas" };
     ResourceList<FSkybox> mSkyboxes{ "Skybox" };
     ResourceList<FColorGrading> mColorGradings{ "ColorGrading" };
     ResourceList<FRenderTarget> mRenderTargets{ "RenderTarget" };
@@ -589,14 +691,18 @@ private:
 
     uint32_t mFlushCounter = 0;
 
-    RootArenaScope::Arena mPerRenderPassArena;
     HeapAllocatorArena mHeapAllocator;
 
     utils::JobSystem mJobSystem;
+    std::unique_ptr<utils::JobSystem> mBackgroundJobSystem;
     static uint32_t getJobSystemThreadPoolSize(Engine::Config const& config) noexcept;
 
     std::default_random_engine mRandomEngine;
 
+    utils::ThermalManager mThermalManager{};
+    utils::ThermalManager::ThermalStatus mThermalStatus = utils::ThermalManager::ThermalStatus::NONE;
+    std::chrono::steady_clock::time_point mThermalStatusPollTime{};
+
     Epoch mEngineEpoch;
 
     mutable FMaterial const* mDefaultMaterial = nullptr;
@@ -614,6 +720,8 @@ private:
     mutable ShaderContent mVertexShaderContent;
     mutable ShaderContent mFragmentShaderContent;
     FDebugRegistry mDebugRegistry;
+    GpuMemoryTracker mMemoryTracker;
+    MaterialProfiler mMaterialProfiler;
 
     backend::Handle<backend::HwTexture> mDummyOneTexture;
     backend::Handle<backend::HwTexture> mDummyOneTextureArray;
@@ -639,6 +747,8 @@ public:
             bool visualize_cascades = false;
             bool disable_light_frustum_align = false;
             bool depth_clamp = true;
+            bool cache_stable_maps = false;
+            bool dynamic_resolution = false;
             float dzn = -1.0f;
             float dzf =  1.0f;
             float display_shadow_texture_scale = 0.25f;
@@ -670,6 +780,12 @@ public:
         struct {
             bool combine_multiview_images = false;
         } stereo;
+        struct {
+            // Opt-in per-material GPU time attribution. Draw spans are bracketed with
+            // timer queries and the per-material totals are exported through the matdbg
+            // server ("/api/profile"). Only effective when matdbg is enabled.
+            bool gpu_profiling = false;
+        } materials;
         matdbg::DebugServer* server = nullptr;
     } debug;
 };
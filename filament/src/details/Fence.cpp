@@ -23,6 +23,9 @@
 #include <utils/Panic.h>
 #include <utils/debug.h>
 
+#include <algorithm>
+#include <chrono>
+
 namespace filament {
 
 using namespace backend;
@@ -32,6 +35,11 @@ utils::Condition FFence::sCondition;
 
 static const constexpr uint64_t PUMP_INTERVAL_MILLISECONDS = 1;
 
+// How long SPIN_THEN_PARK polls before parking on the condition variable. Long enough to
+// cover the typical scheduler wake-up jitter, short enough to not burn a meaningful amount
+// of CPU when the fence is late.
+static const constexpr uint64_t SPIN_TIME_NANOSECONDS = 50000; // 50us
+
 using ms = std::chrono::milliseconds;
 using ns = std::chrono::nanoseconds;
 
@@ -72,17 +80,21 @@ FenceStatus FFence::wait(Mode mode, uint64_t timeout) noexcept {
 
     FenceSignal * const fs = mFenceSignal.get();
 
+    uint64_t const spinTimeNs =
+            mWaitPolicy == WaitPolicy::SPIN_THEN_PARK ? SPIN_TIME_NANOSECONDS : 0;
+
     FenceStatus status;
 
     if (UTILS_LIKELY(!engine.pumpPlatformEvents())) {
-        status = fs->wait(timeout);
+        status = fs->wait(timeout, spinTimeNs);
     } else {
         // Unfortunately, some platforms might force us to have sync points between the GL thread
         // and user thread. To prevent deadlock on these platforms, we chop up the waiting time into
         // polling and pumping the platform's event queue.
         const auto startTime = std::chrono::system_clock::now();
         while (true) {
-            status = fs->wait(ns(ms(PUMP_INTERVAL_MILLISECONDS)).count());
+            // the pump interval already chops the wait into short sleeps, no need to spin
+            status = fs->wait(ns(ms(PUMP_INTERVAL_MILLISECONDS)).count(), 0);
             if (status != FenceStatus::TIMEOUT_EXPIRED) {
                 break;
             }
@@ -104,22 +116,57 @@ FenceStatus FFence::wait(Mode mode, uint64_t timeout) noexcept {
 UTILS_NOINLINE
 void FFence::FenceSignal::signal(State s) noexcept {
     std::lock_guard<utils::Mutex> const lock(FFence::sLock);
-    mState = s;
+    mState.store(s, std::memory_order_release);
     FFence::sCondition.notify_all();
 }
 
+Fence::FenceStatus FFence::FenceSignal::poll() const noexcept {
+    switch (mState.load(std::memory_order_acquire)) {
+        case SIGNALED:      return FenceStatus::CONDITION_SATISFIED;
+        case DESTROYED:     return FenceStatus::ERROR;
+        case UNSIGNALED:    break;
+    }
+    return FenceStatus::TIMEOUT_EXPIRED;
+}
+
 UTILS_NOINLINE
-Fence::FenceStatus FFence::FenceSignal::wait(uint64_t timeout) noexcept {
-    std::unique_lock<utils::Mutex> lock(FFence::sLock);
-    while (mState == UNSIGNALED) {
-        if (mState == DESTROYED) {
-            return FenceStatus::ERROR;
+Fence::FenceStatus FFence::FenceSignal::wait(uint64_t timeout, uint64_t spinTimeNs) noexcept {
+    // fast path: the fence may have signaled already, this takes no lock
+    if (mState.load(std::memory_order_acquire) != UNSIGNALED) {
+        return FenceStatus::CONDITION_SATISFIED;
+    }
+    if (timeout == 0) {
+        return FenceStatus::TIMEOUT_EXPIRED;
+    }
+
+    // SPIN_THEN_PARK: poll the state for a little while before parking. A thread parked in
+    // the condition variable pays the scheduler's wake-up latency (a couple hundred
+    // microseconds of jitter on some kernels); a fence that signals within the spin window
+    // is observed with essentially no latency at all.
+    if (spinTimeNs > 0) {
+        uint64_t const deadline = std::min(spinTimeNs, timeout);
+        auto const start = std::chrono::steady_clock::now();
+        do {
+            UTILS_PAUSE();
+            if (mState.load(std::memory_order_acquire) != UNSIGNALED) {
+                return FenceStatus::CONDITION_SATISFIED;
+            }
+        } while (uint64_t(std::chrono::duration_cast<ns>(
+                std::chrono::steady_clock::now() - start).count()) < deadline);
+        if (timeout != FENCE_WAIT_FOR_EVER) {
+            timeout -= deadline;
+            if (timeout == 0) {
+                return FenceStatus::TIMEOUT_EXPIRED;
+            }
         }
+    }
+
+    std::unique_lock<utils::Mutex> lock(FFence::sLock);
+    while (mState.load(std::memory_order_relaxed) == UNSIGNALED) {
         if (timeout == FENCE_WAIT_FOR_EVER) {
             FFence::sCondition.wait(lock);
         } else {
-            if (timeout == 0 ||
-                    sCondition.wait_for(lock, ns(timeout)) == std::cv_status::timeout) {
+            if (sCondition.wait_for(lock, ns(timeout)) == std::cv_status::timeout) {
                 return FenceStatus::TIMEOUT_EXPIRED;
             }
         }
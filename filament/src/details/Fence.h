@@ -27,6 +27,8 @@
 #include <utils/Condition.h>
 #include <utils/Mutex.h>
 
+#include <atomic>
+
 namespace filament {
 
 class FEngine;
@@ -41,6 +43,11 @@ public:
 
     static FenceStatus waitAndDestroy(FFence* fence, Mode mode) noexcept;
 
+    void setWaitPolicy(WaitPolicy policy) noexcept { mWaitPolicy = policy; }
+
+    // single atomic read, no lock taken
+    FenceStatus getStatus() noexcept { return mFenceSignal->poll(); }
+
 private:
     // We assume we don't have a lot of contention of fence and have all of them
     // share a single lock/condition
@@ -50,14 +57,18 @@ private:
     struct FenceSignal {
         explicit FenceSignal() noexcept = default;
         enum State : uint8_t { UNSIGNALED, SIGNALED, DESTROYED };
-        State mState = UNSIGNALED;
+        // atomic so that poll() and the spin phase of wait() don't need the lock; the lock
+        // is still taken around stores and cv waits to avoid missed wake-ups.
+        std::atomic<State> mState = { UNSIGNALED };
         void signal(State s = SIGNALED) noexcept;
-        FenceStatus wait(uint64_t timeout) noexcept;
+        FenceStatus wait(uint64_t timeout, uint64_t spinTimeNs) noexcept;
+        FenceStatus poll() const noexcept;
     };
 
     FEngine& mEngine;
     // TODO: use custom allocator for these small objects
     std::shared_ptr<FenceSignal> mFenceSignal;
+    WaitPolicy mWaitPolicy = WaitPolicy::PARK;
 };
 
 FILAMENT_DOWNCAST(Fence)
@@ -68,9 +68,13 @@ FIndexBuffer::FIndexBuffer(FEngine& engine, const IndexBuffer::Builder& builder)
     if (auto name = builder.getName(); !name.empty()) {
         driver.setDebugTag(mHandle.getId(), std::move(name));
     }
+    mTrackedMemory = mIndexCount *
+            (builder->mIndexType == IndexType::UINT ? sizeof(uint32_t) : sizeof(uint16_t));
+    engine.getMemoryTracker().track(Engine::MemoryCategory::VERTEX_DATA, mTrackedMemory);
 }
 
 void FIndexBuffer::terminate(FEngine& engine) {
+    engine.getMemoryTracker().release(Engine::MemoryCategory::VERTEX_DATA, mTrackedMemory);
     FEngine::DriverApi& driver = engine.getDriverApi();
     driver.destroyIndexBuffer(mHandle);
 }
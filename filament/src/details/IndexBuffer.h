@@ -46,6 +46,7 @@ private:
     friend class IndexBuffer;
     backend::Handle<backend::HwIndexBuffer> mHandle;
     uint32_t mIndexCount;
+    uint32_t mTrackedMemory = 0; // GPU footprint accounted in GpuMemoryTracker
 };
 
 FILAMENT_DOWNCAST(IndexBuffer)
@@ -16,6 +16,8 @@
 
 #include "details/Material.h"
 #include "details/Engine.h"
+#include "details/RenderTarget.h"
+#include "details/VertexBuffer.h"
 
 #include "Froxelizer.h"
 #include "MaterialParser.h"
@@ -43,6 +45,7 @@
 
 #include <backend/DriverEnums.h>
 #include <backend/CallbackHandler.h>
+#include <backend/PipelineState.h>
 #include <backend/Program.h>
 
 #include <utils/BitmaskEnum.h>
@@ -71,6 +74,7 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 namespace filament {
 
@@ -79,9 +83,10 @@ using namespace filaflat;
 using namespace utils;
 
 static std::unique_ptr<MaterialParser> createParser(Backend backend,
-        utils::FixedCapacityVector<ShaderLanguage> languages, const void* data, size_t size) {
+        utils::FixedCapacityVector<ShaderLanguage> languages, const void* data, size_t size,
+        bool copy = true) {
     // unique_ptr so we don't leak MaterialParser on failures below
-    auto materialParser = std::make_unique<MaterialParser>(languages, data, size);
+    auto materialParser = std::make_unique<MaterialParser>(languages, data, size, copy);
 
     MaterialParser::ParseResult const materialResult = materialParser->parse();
 
@@ -121,6 +126,7 @@ static std::unique_ptr<MaterialParser> createParser(Backend backend,
 struct Material::BuilderDetails {
     const void* mPayload = nullptr;
     size_t mSize = 0;
+    bool mSharedPayload = false;
     bool mDefaultMaterial = false;
     int32_t mShBandsCount = 3;
     std::unordered_map<
@@ -144,6 +150,14 @@ BuilderType::Builder& BuilderType::Builder::operator=(BuilderType::Builder&& rhs
 Material::Builder& Material::Builder::package(const void* payload, size_t size) {
     mImpl->mPayload = payload;
     mImpl->mSize = size;
+    mImpl->mSharedPayload = false;
+    return *this;
+}
+
+Material::Builder& Material::Builder::sharedPackage(const void* payload, size_t size) {
+    mImpl->mPayload = payload;
+    mImpl->mSize = size;
+    mImpl->mSharedPayload = true;
     return *this;
 }
 
@@ -166,7 +180,7 @@ template Material::Builder& Material::Builder::constant<bool>(const char*, size_
 Material* Material::Builder::build(Engine& engine) {
     std::unique_ptr<MaterialParser> materialParser = createParser(
         downcast(engine).getBackend(), downcast(engine).getShaderLanguage(),
-        mImpl->mPayload, mImpl->mSize);
+        mImpl->mPayload, mImpl->mSize, !mImpl->mSharedPayload);
 
     if (!materialParser) {
         return nullptr;
@@ -323,6 +337,7 @@ FMaterial::FMaterial(FEngine& engine, const Material::Builder& builder,
 
     processBlendingMode(parser);
     processSpecializationConstants(engine, builder, parser);
+    mSpecializationConstantsKey = computeSpecializationConstantsKey();
     processPushConstants(engine, parser);
     processDepthVariants(engine, parser);
     processDescriptorSets(engine, parser);
@@ -347,6 +362,15 @@ FMaterial::~FMaterial() noexcept = default;
 
 void FMaterial::invalidate(Variant::type_t variantMask, Variant::type_t variantValue) noexcept {
     DriverApi& driverApi = mEngine.getDriverApi();
+
+    // the material itself changed, programs retired by respecialize() are stale too
+    for (auto& [key, retired] : mRetiredPrograms) {
+        for (auto& program : *retired) {
+            driverApi.destroyProgram(program);
+        }
+    }
+    mRetiredPrograms.clear();
+
     if (mMaterialDomain == MaterialDomain::SURFACE) {
         auto& cachedPrograms = mCachedPrograms;
         for (size_t k = 0, n = VARIANT_COUNT; k < n; ++k) {
@@ -455,6 +479,37 @@ void FMaterial::compile(CompilerPriorityQueue priority,
     }
 }
 
+void FMaterial::precachePipelines(FVertexBuffer const* vertexBuffer,
+        FRenderTarget const* renderTarget) noexcept {
+    auto& driver = mEngine.getDriverApi();
+
+    Handle<HwRenderTarget> const rth = renderTarget ?
+            renderTarget->getHwHandle() : mEngine.getDefaultRenderTarget();
+
+    PipelineState state{};
+    state.vertexBufferInfo = vertexBuffer->getVertexBufferInfoHandle();
+    state.rasterState = mRasterState;
+    state.primitiveType = PrimitiveType::TRIANGLES;
+    state.pipelineLayout.setLayout[+DescriptorSetBindingPoints::PER_RENDERABLE] =
+            mEngine.getPerRenderableDescriptorSetLayout().getHandle();
+    state.pipelineLayout.setLayout[+DescriptorSetBindingPoints::PER_MATERIAL] =
+            getDescriptorSetLayout().getHandle();
+
+    auto const& variants = isVariantLit() ?
+            VariantUtils::getLitVariants() : VariantUtils::getUnlitVariants();
+    for (auto const variant: variants) {
+        if (hasVariant(variant)) {
+            prepareProgram(variant);
+            state.program = getProgram(variant);
+            // The per-view layout depends on the variant (e.g. depth variants use a
+            // specialized one).
+            state.pipelineLayout.setLayout[+DescriptorSetBindingPoints::PER_VIEW] =
+                    getPerViewDescriptorSetLayout(variant).getHandle();
+            driver.precachePipeline(state, rth);
+        }
+    }
+}
+
 FMaterialInstance* FMaterial::createInstance(const char* name) const noexcept {
     if (mDefaultMaterialInstance) {
         // if we have a default instance, use it to create a new one
@@ -483,6 +538,15 @@ bool FMaterial::isSampler(const char* name) const noexcept {
     return mSamplerInterfaceBlock.hasSampler(name);
 }
 
+MaterialInstance::ParameterHandle FMaterial::getParameterHandle(
+        std::string_view name) const noexcept {
+    ssize_t const offset = mUniformInterfaceBlock.getFieldOffset(name, 0);
+    if (UTILS_UNLIKELY(offset < 0)) {
+        return {};
+    }
+    return MaterialInstance::ParameterHandle{ int32_t(offset) };
+}
+
 BufferInterfaceBlock::FieldInfo const* FMaterial::reflect(
         std::string_view name) const noexcept {
     return mUniformInterfaceBlock.getFieldInfo(name);
@@ -518,6 +582,12 @@ void FMaterial::prepareProgramSlow(Variant variant,
     switch (getMaterialDomain()) {
         case MaterialDomain::SURFACE:
             getSurfaceProgramSlow(variant, priorityQueue);
+            // A variant compiled on demand is a good predictor of which variants will be
+            // needed next, so speculatively queue its siblings at low priority. Siblings
+            // scheduled this way use the LOW queue and don't fan out further.
+            if (priorityQueue != CompilerPriorityQueue::LOW) {
+                precompileSiblingVariants(variant);
+            }
             break;
         case MaterialDomain::POST_PROCESS:
             getPostProcessProgramSlow(variant, priorityQueue);
@@ -528,6 +598,34 @@ void FMaterial::prepareProgramSlow(Variant variant,
     }
 }
 
+void FMaterial::precompileSiblingVariants(Variant const variant) const noexcept {
+    // When a variant is first used, the variants reachable by common runtime state
+    // transitions -- shadows toggling on/off, skinned vs. static geometry, fog enabled or
+    // not -- are likely to be needed within a few frames (e.g. while streaming a level in).
+    // Queue them at low priority so the compiler threads fill them in before their first
+    // use, without delaying urgent compilations.
+    if (!mEngine.getDriverApi().isParallelShaderCompileSupported()) {
+        // without parallel compilation, speculative work would itself cause hitches
+        return;
+    }
+    constexpr Variant::type_t transitions[] = { Variant::SRE, Variant::SKN, Variant::FOG };
+    bool const isDepthVariant = Variant::isValidDepthVariant(variant);
+    for (auto const bit: transitions) {
+        if (isDepthVariant && bit != Variant::SKN) {
+            // for depth variants only the skinning bit corresponds to a state transition
+            // (the FOG bit aliases PCK there, and SRE doesn't exist)
+            continue;
+        }
+        Variant sibling = Variant::filterVariant(Variant(variant.key ^ bit), isVariantLit());
+        if (sibling == variant || Variant::isReserved(sibling)) {
+            continue;
+        }
+        if (!isCached(sibling) && hasVariant(sibling)) {
+            prepareProgram(sibling, CompilerPriorityQueue::LOW);
+        }
+    }
+}
+
 void FMaterial::getSurfaceProgramSlow(Variant variant,
         CompilerPriorityQueue priorityQueue) const noexcept {
     // filterVariant() has already been applied in generateCommands(), shouldn't be needed here
@@ -684,13 +782,21 @@ size_t FMaterial::getParameters(ParameterInfo* parameters, size_t count) const n
 void FMaterial::applyPendingEdits() noexcept {
     const char* name = mName.c_str();
     slog.d << "Applying edits to " << (name ? name : "(untitled)") << io::endl;
-    destroyPrograms(mEngine); // FIXME: this will not destroy the shared variants
-    latchPendingEdits();
+    std::lock_guard const lock(mPendingEditsLock);
+    // Only the variants whose source actually changed are destroyed; the others keep their
+    // compiled programs, so a single-shader edit doesn't recompile the whole material.
+    // FIXME: this will not destroy the shared variants
+    destroyPrograms(mEngine, &mPendingEditedVariants);
+    mPendingEditedVariants.reset();
+    mMaterialParser.reset(mPendingEdits.release());
 }
 
-void FMaterial::setPendingEdits(std::unique_ptr<MaterialParser> pendingEdits) noexcept {
+void FMaterial::setPendingEdits(std::unique_ptr<MaterialParser> pendingEdits,
+        Variant const editedVariant) noexcept {
     std::lock_guard const lock(mPendingEditsLock);
     std::swap(pendingEdits, mPendingEdits);
+    // edits accumulate until the engine latches them on the next getProgram()
+    mPendingEditedVariants.set(editedVariant.key);
 }
 
 bool FMaterial::hasPendingEdits() noexcept {
@@ -698,11 +804,6 @@ bool FMaterial::hasPendingEdits() noexcept {
     return (bool)mPendingEdits;
 }
 
-void FMaterial::latchPendingEdits() noexcept {
-    std::lock_guard const lock(mPendingEditsLock);
-    mMaterialParser.reset(mPendingEdits.release());
-}
-
 /**
  * Callback handlers for the debug server, potentially called from any thread. These methods are
  * never called during normal operation and exist for debugging purposes only.
@@ -711,7 +812,7 @@ void FMaterial::latchPendingEdits() noexcept {
  */
 
 void FMaterial::onEditCallback(void* userdata, const utils::CString&, const void* packageData,
-        size_t packageSize) {
+        size_t packageSize, Variant const variant) {
     FMaterial* material = downcast((Material*) userdata);
     FEngine const& engine = material->mEngine;
 
@@ -719,7 +820,7 @@ void FMaterial::onEditCallback(void* userdata, const utils::CString&, const void
     // and swapping out the MaterialParser until the next getProgram call.
     std::unique_ptr<MaterialParser> pending = createParser(
             engine.getBackend(), engine.getShaderLanguage(), packageData, packageSize);
-    material->setPendingEdits(std::move(pending));
+    material->setPendingEdits(std::move(pending), variant);
 }
 
 void FMaterial::onQueryCallback(void* userdata, VariantList* pVariants) {
@@ -734,11 +835,15 @@ void FMaterial::onQueryCallback(void* userdata, VariantList* pVariants) {
 #endif // FILAMENT_ENABLE_MATDBG
 
 
-void FMaterial::destroyPrograms(FEngine& engine) {
+void FMaterial::destroyPrograms(FEngine& engine, VariantList const* variants) {
     DriverApi& driverApi = engine.getDriverApi();
     auto& cachedPrograms = mCachedPrograms;
     for (size_t k = 0, n = VARIANT_COUNT; k < n; ++k) {
         const Variant variant(k);
+        if (variants && !(*variants)[k]) {
+            // a variant filter was given and this variant is not part of it
+            continue;
+        }
         if (!mIsDefaultMaterial) {
             // The depth variants may be shared with the default material, in which case
             // we should not free it now.
@@ -750,7 +855,69 @@ void FMaterial::destroyPrograms(FEngine& engine) {
         }
         driverApi.destroyProgram(cachedPrograms[k]);
         cachedPrograms[k].clear();
+        for (auto& [key, retired] : mRetiredPrograms) {
+            // destroyProgram() tolerates null handles
+            driverApi.destroyProgram((*retired)[k]);
+            (*retired)[k].clear();
+        }
+    }
+    if (!variants) {
+        mRetiredPrograms.clear();
+    }
+}
+
+uint32_t FMaterial::computeSpecializationConstantsKey() const noexcept {
+    uint32_t key = 0;
+    for (auto const& constant : mSpecializationConstants) {
+        uint32_t words[3] = { constant.id, uint32_t(constant.value.index()), 0 };
+        std::visit([&words](auto&& value) {
+            memcpy(&words[2], &value, sizeof(value));
+        }, constant.value);
+        key = hash::murmur3(words, 3, key);
+    }
+    return key;
+}
+
+void FMaterial::respecialize() noexcept {
+    uint32_t const key = computeSpecializationConstantsKey();
+    if (key == mSpecializationConstantsKey) {
+        // no constant actually changed, the cached programs are still valid
+        return;
+    }
+
+    // Retire the programs specialized for the current constant values. We keep the
+    // shared-variant skip logic of destroyPrograms(): depth variants we don't own stay
+    // in mCachedPrograms, they don't depend on our constants.
+    auto& cachedPrograms = mCachedPrograms;
+    auto retired = std::make_unique<CachedProgramArray>();
+    for (size_t k = 0, n = VARIANT_COUNT; k < n; ++k) {
+        const Variant variant(k);
+        if (!mIsDefaultMaterial) {
+            bool const isSharedVariant =
+                    Variant::isValidDepthVariant(variant) && !mHasCustomDepthShader;
+            if (isSharedVariant) {
+                continue;
+            }
+        }
+        (*retired)[k] = cachedPrograms[k];
+        cachedPrograms[k].clear();
     }
+    mRetiredPrograms[mSpecializationConstantsKey] = std::move(retired);
+
+    // If we already have programs specialized for the new constant values, restore them;
+    // getProgram() then reuses them directly instead of going through the compile path.
+    if (auto pos = mRetiredPrograms.find(key); pos != mRetiredPrograms.end()) {
+        CachedProgramArray const& restored = *pos->second;
+        for (size_t k = 0, n = VARIANT_COUNT; k < n; ++k) {
+            if (restored[k]) {
+                assert_invariant(!cachedPrograms[k]);
+                cachedPrograms[k] = restored[k];
+            }
+        }
+        mRetiredPrograms.erase(pos);
+    }
+
+    mSpecializationConstantsKey = key;
 }
 
 std::optional<uint32_t> FMaterial::getSpecializationConstantId(std::string_view name) const noexcept {
@@ -1052,17 +1219,21 @@ void FMaterial::processDescriptorSets(FEngine& engine, MaterialParser const* con
     success = parser->getDescriptorBindings(&mProgramDescriptorBindings);
     assert_invariant(success);
 
-    std::array<backend::DescriptorSetLayout, 2> descriptorSetLayout;
+    MaterialParser::DescriptorSetLayoutContainer descriptorSetLayout;
     success = parser->getDescriptorSetLayout(&descriptorSetLayout);
     assert_invariant(success);
 
+    // the hashes were precomputed by matc when the package is recent enough, letting the
+    // factory skip hashing the layouts on every material load
     mDescriptorSetLayout = {
             engine.getDescriptorSetLayoutFactory(),
-            engine.getDriverApi(), std::move(descriptorSetLayout[0]) };
+            engine.getDriverApi(), std::move(descriptorSetLayout.layouts[0]),
+            size_t(descriptorSetLayout.hashes[0]) };
 
     mPerViewDescriptorSetLayout = {
             engine.getDescriptorSetLayoutFactory(),
-            engine.getDriverApi(), std::move(descriptorSetLayout[1]) };
+            engine.getDriverApi(), std::move(descriptorSetLayout.layouts[1]),
+            size_t(descriptorSetLayout.hashes[1]) };
 }
 
 backend::descriptor_binding_t FMaterial::getSamplerBinding(
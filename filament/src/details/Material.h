@@ -68,6 +68,8 @@ namespace filament {
 class MaterialParser;
 
 class  FEngine;
+class FRenderTarget;
+class FVertexBuffer;
 
 class FMaterial : public Material {
 public:
@@ -114,6 +116,11 @@ public:
             backend::CallbackHandler* handler,
             utils::Invocable<void(Material*)>&& callback) noexcept;
 
+    // Pre-warms the backend's pipeline caches for all of this material's variants with the given
+    // vertex layout and render target formats (a null render target means the default one).
+    void precachePipelines(FVertexBuffer const* vertexBuffer,
+            FRenderTarget const* renderTarget) noexcept;
+
     // Create an instance of this material
     FMaterialInstance* createInstance(const char* name) const noexcept;
 
@@ -121,6 +128,8 @@ public:
 
     bool isSampler(const char* name) const noexcept;
 
+    MaterialInstance::ParameterHandle getParameterHandle(std::string_view name) const noexcept;
+
     BufferInterfaceBlock::FieldInfo const* reflect(std::string_view name) const noexcept;
 
     FMaterialInstance const* getDefaultInstance() const noexcept {
@@ -186,6 +195,10 @@ public:
     }
     bool isDoubleSided() const noexcept { return mDoubleSided; }
     bool hasDoubleSidedCapability() const noexcept { return mDoubleSidedCapability; }
+
+    // whether this material provides its own depth shader, as opposed to sharing the
+    // engine's default-material depth-only programs
+    bool hasCustomDepthShader() const noexcept { return mHasCustomDepthShader; }
     bool isAlphaToCoverageEnabled() const noexcept { return mRasterState.alphaToCoverage; }
     float getMaskThreshold() const noexcept { return mMaskThreshold; }
     bool hasShadowMultiplier() const noexcept { return mHasShadowMultiplier; }
@@ -218,7 +231,9 @@ public:
 
     uint32_t generateMaterialInstanceId() const noexcept { return mMaterialInstanceId++; }
 
-    void destroyPrograms(FEngine& engine);
+    // destroys the cached programs; when `variants` is non-null, only the variants it
+    // contains are destroyed
+    void destroyPrograms(FEngine& engine, VariantList const* variants = nullptr);
 
     // return the id of a specialization constant specified by name for this material
     std::optional<uint32_t> getSpecializationConstantId(std::string_view name) const noexcept ;
@@ -228,6 +243,12 @@ public:
     template<typename T, typename = Builder::is_supported_constant_parameter_t<T>>
     bool setConstant(uint32_t id, T value) noexcept;
 
+    // Makes pending setConstant() calls take effect. The programs specialized for the
+    // previous constant values are retired into a cache instead of being destroyed, and
+    // restored when the constants return to those values -- so toggling between constant
+    // sets (e.g. quality presets) selects pre-specialized programs without recompiling.
+    void respecialize() noexcept;
+
     uint8_t getPerViewLayoutIndex() const noexcept {
         return mPerViewLayoutIndex;
     }
@@ -235,6 +256,9 @@ public:
 #if FILAMENT_ENABLE_MATDBG
     void applyPendingEdits() noexcept;
 
+    // the key this material was registered with on the debug server, see MaterialProfiler
+    matdbg::MaterialKey getDebuggerId() const noexcept { return mDebuggerId; }
+
     /**
      * Callback handlers for the debug server, potentially called from any thread. The userdata
      * argument has the same value that was passed to DebugServer::addMaterial(), which should
@@ -242,9 +266,9 @@ public:
      * @{
      */
 
-    /** Replaces the material package. */
+    /** Replaces the material package. `variant` is the single edited shader variant. */
     static void onEditCallback(void* userdata, const utils::CString& name, const void* packageData,
-            size_t packageSize);
+            size_t packageSize, Variant variant);
 
     /**
      * Returns a list of "active" variants.
@@ -268,6 +292,7 @@ private:
     bool hasVariant(Variant variant) const noexcept;
     void prepareProgramSlow(Variant variant,
             CompilerPriorityQueue priorityQueue) const noexcept;
+    void precompileSiblingVariants(Variant variant) const noexcept;
     void getSurfaceProgramSlow(Variant variant,
             CompilerPriorityQueue priorityQueue) const noexcept;
     void getPostProcessProgramSlow(Variant variant,
@@ -280,6 +305,8 @@ private:
     void processSpecializationConstants(FEngine& engine, Material::Builder const& builder,
             MaterialParser const* parser);
 
+    uint32_t computeSpecializationConstantsKey() const noexcept;
+
     void processPushConstants(FEngine& engine, MaterialParser const* parser);
 
     void processDepthVariants(FEngine& engine, MaterialParser const* parser);
@@ -288,8 +315,10 @@ private:
 
     void createAndCacheProgram(backend::Program&& p, Variant variant) const noexcept;
 
+    using CachedProgramArray = std::array<backend::Handle<backend::HwProgram>, VARIANT_COUNT>;
+
     // try to order by frequency of use
-    mutable std::array<backend::Handle<backend::HwProgram>, VARIANT_COUNT> mCachedPrograms;
+    mutable CachedProgramArray mCachedPrograms;
     DescriptorSetLayout mPerViewDescriptorSetLayout;
     DescriptorSetLayout mDescriptorSetLayout;
     backend::Program::DescriptorSetInfo mProgramDescriptorBindings;
@@ -348,6 +377,11 @@ private:
     std::unordered_map<std::string_view, uint32_t> mSpecializationConstantsNameToIndex;
     // current specialization constants for the HwProgram
     utils::FixedCapacityVector<backend::Program::SpecializationConstant> mSpecializationConstants;
+    // hash of the constant values the cached programs are specialized for
+    uint32_t mSpecializationConstantsKey = 0;
+    // programs specialized for previously-used constant values, keyed by value hash
+    // (see respecialize())
+    mutable std::unordered_map<uint32_t, std::unique_ptr<CachedProgramArray>> mRetiredPrograms;
 
     // current push constants for the HwProgram
     std::array<utils::FixedCapacityVector<backend::Program::PushConstant>,
@@ -360,9 +394,11 @@ private:
     mutable VariantList mActivePrograms;
     mutable utils::Mutex mPendingEditsLock;
     std::unique_ptr<MaterialParser> mPendingEdits;
-    void setPendingEdits(std::unique_ptr<MaterialParser> pendingEdits) noexcept;
+    // variants edited since the last applyPendingEdits(); only these get rebuilt
+    VariantList mPendingEditedVariants;
+    void setPendingEdits(std::unique_ptr<MaterialParser> pendingEdits,
+            Variant editedVariant) noexcept;
     bool hasPendingEdits() noexcept;
-    void latchPendingEdits() noexcept;
 #endif
 
     utils::CString mName;
@@ -56,6 +56,8 @@ namespace filament {
 
 using namespace backend;
 
+uint32_t FMaterialInstance::sRasterStateGeneration = 0;
+
 FMaterialInstance::FMaterialInstance(FEngine& engine, FMaterial const* material,
                                      const char* name) noexcept
         : mMaterial(material),
@@ -67,20 +69,28 @@ FMaterialInstance::FMaterialInstance(FEngine& engine, FMaterial const* material,
           mHasScissor(false),
           mIsDoubleSided(false),
           mIsDefaultInstance(false),
+          mUbDedicated(!engine.hasFeatureLevel(FeatureLevel::FEATURE_LEVEL_1)),
+          mHasName(name != nullptr),
           mTransparencyMode(TransparencyMode::DEFAULT),
-          mName(name ? CString(name) : material->getName()) {
+          mName(name ? utils::FixedSizeString<64>(name) : utils::FixedSizeString<64>{}) {
 
     FEngine::DriverApi& driver = engine.getDriverApi();
 
     if (!material->getUniformInterfaceBlock().isEmpty()) {
         mUniforms = UniformBuffer(material->getUniformInterfaceBlock().getSize());
-        mUbHandle = driver.createBufferObject(mUniforms.getSize(),
-                BufferObjectBinding::UNIFORM, backend::BufferUsage::STATIC);
-        driver.setDebugTag(mUbHandle.getId(), material->getName());
+        if (UTILS_UNLIKELY(mUbDedicated)) {
+            // FEATURE_LEVEL_0's UBO emulation doesn't support offset binding
+            mUbAllocation.handle = driver.createBufferObject(mUniforms.getSize(),
+                    BufferObjectBinding::UNIFORM, backend::BufferUsage::STATIC);
+            driver.setDebugTag(mUbAllocation.handle.getId(), material->getName());
+        } else {
+            mUbAllocation = engine.getUniformBufferArena().allocate(driver,
+                    BufferObjectBinding::UNIFORM, mUniforms.getSize());
+        }
     }
 
     // set the UBO, always descriptor 0
-    mDescriptorSet.setBuffer(0, mUbHandle, 0, mUniforms.getSize());
+    mDescriptorSet.setBuffer(0, mUbAllocation.handle, mUbAllocation.offset, mUniforms.getSize());
 
     const RasterState& rasterState = material->getRasterState();
     // At the moment, only MaterialInstances have a stencil state, but in the future it should be
@@ -97,7 +107,8 @@ FMaterialInstance::FMaterialInstance(FEngine& engine, FMaterial const* material,
     mDepthFunc = rasterState.depthFunc;
 
     mMaterialSortingKey = RenderPass::makeMaterialSortingKey(
-            material->getId(), material->generateMaterialInstanceId());
+            material->getId(), material->getDescriptorSetLayout().getClusterId(),
+            material->generateMaterialInstanceId());
 
     if (material->getBlendingMode() == BlendingMode::MASKED) {
         setMaskThreshold(material->getMaskThreshold());
@@ -132,21 +143,28 @@ FMaterialInstance::FMaterialInstance(FEngine& engine,
           mHasScissor(false),
           mIsDoubleSided(other->mIsDoubleSided),
           mIsDefaultInstance(false),
+          mUbDedicated(other->mUbDedicated),
+          mHasName(name != nullptr || other->mHasName),
           mScissorRect(other->mScissorRect),
-          mName(name ? CString(name) : other->mName) {
+          mName(name ? utils::FixedSizeString<64>(name) : other->mName) {
 
     FEngine::DriverApi& driver = engine.getDriverApi();
     FMaterial const* const material = other->getMaterial();
 
     if (!material->getUniformInterfaceBlock().isEmpty()) {
         mUniforms.setUniforms(other->getUniformBuffer());
-        mUbHandle = driver.createBufferObject(mUniforms.getSize(),
-                BufferObjectBinding::UNIFORM, backend::BufferUsage::DYNAMIC);
-        driver.setDebugTag(mUbHandle.getId(), material->getName());
+        if (UTILS_UNLIKELY(mUbDedicated)) {
+            mUbAllocation.handle = driver.createBufferObject(mUniforms.getSize(),
+                    BufferObjectBinding::UNIFORM, backend::BufferUsage::DYNAMIC);
+            driver.setDebugTag(mUbAllocation.handle.getId(), material->getName());
+        } else {
+            mUbAllocation = engine.getUniformBufferArena().allocate(driver,
+                    BufferObjectBinding::UNIFORM, mUniforms.getSize());
+        }
     }
 
     // set the UBO, always descriptor 0
-    mDescriptorSet.setBuffer(0, mUbHandle, 0, mUniforms.getSize());
+    mDescriptorSet.setBuffer(0, mUbAllocation.handle, mUbAllocation.offset, mUniforms.getSize());
 
     if (material->hasDoubleSidedCapability()) {
         setDoubleSided(mIsDoubleSided);
@@ -164,7 +182,8 @@ FMaterialInstance::FMaterialInstance(FEngine& engine,
     setTransparencyMode(material->getTransparencyMode());
 
     mMaterialSortingKey = RenderPass::makeMaterialSortingKey(
-            material->getId(), material->generateMaterialInstanceId());
+            material->getId(), material->getDescriptorSetLayout().getClusterId(),
+            material->generateMaterialInstanceId());
 
     // If the original descriptor set has been commited, the copy needs to commit as well.
     if (other->mDescriptorSet.getHandle()) {
@@ -184,13 +203,22 @@ FMaterialInstance::~FMaterialInstance() noexcept = default;
 void FMaterialInstance::terminate(FEngine& engine) {
     FEngine::DriverApi& driver = engine.getDriverApi();
     mDescriptorSet.terminate(driver);
-    driver.destroyBufferObject(mUbHandle);
+    if (UTILS_UNLIKELY(mUbDedicated)) {
+        driver.destroyBufferObject(mUbAllocation.handle);
+    } else {
+        engine.getUniformBufferArena().free(mUbAllocation, mUniforms.getSize());
+    }
 }
 
 void FMaterialInstance::commit(DriverApi& driver) const {
-    // update uniforms if needed
+    // update uniforms if needed, uploading only the coalesced dirty range -- UI-heavy scenes
+    // often change a single parameter per instance and frame
     if (mUniforms.isDirty()) {
-        driver.updateBufferObject(mUbHandle, mUniforms.toBufferDescriptor(driver), 0);
+        size_t const offset = mUniforms.getDirtyOffset();
+        size_t const size = mUniforms.getDirtySize();
+        driver.updateBufferObject(mUbAllocation.handle,
+                mUniforms.toBufferDescriptor(driver, offset, size),
+                mUbAllocation.offset + uint32_t(offset));
     }
     if (!mTextureParameters.empty()) {
         for (auto const& [binding, p]: mTextureParameters) {
@@ -199,6 +227,7 @@ void FMaterialInstance::commit(DriverApi& driver) const {
             FEngine& engine = mMaterial->getEngine();
             FILAMENT_CHECK_PRECONDITION(engine.isValid(p.texture))
                     << "Invalid texture still bound to MaterialInstance: '" << getName() << "'\n";
+            p.texture->markUsedInFrame(engine.getFrameCounter());
             Handle<HwTexture> handle = p.texture->getHwHandleForSampling();
             assert_invariant(handle);
             mDescriptorSet.setSampler(binding, handle, p.params);
@@ -214,6 +243,17 @@ void FMaterialInstance::commit(DriverApi& driver) const {
 
 // ------------------------------------------------------------------------------------------------
 
+void FMaterialInstance::updateStreamingFeedback(uint32_t frameCounter,
+        float log2RequiredPixels) const noexcept {
+    // mTextureParameters holds the mip-mapped sampleable textures, which are exactly the
+    // streamable ones (see FTexture::textureHandleCanMutate())
+    for (auto const& [binding, p] : mTextureParameters) {
+        if (p.texture) {
+            p.texture->updateDesiredMipLevel(frameCounter, log2RequiredPixels);
+        }
+    }
+}
+
 void FMaterialInstance::setParameter(std::string_view name,
         backend::Handle<backend::HwTexture> texture, backend::SamplerParams params) {
     auto binding = mMaterial->getSamplerBinding(name);
@@ -303,10 +343,12 @@ bool FMaterialInstance::isDoubleSided() const noexcept {
 
 void FMaterialInstance::setTransparencyMode(TransparencyMode mode) noexcept {
     mTransparencyMode = mode;
+    sRasterStateGeneration++;
 }
 
 void FMaterialInstance::setDepthCulling(bool enable) noexcept {
     mDepthFunc = enable ? RasterState::DepthFunc::GE : RasterState::DepthFunc::A;
+    sRasterStateGeneration++;
 }
 
 bool FMaterialInstance::isDepthCullingEnabled() const noexcept {
@@ -314,10 +356,10 @@ bool FMaterialInstance::isDepthCullingEnabled() const noexcept {
 }
 
 const char* FMaterialInstance::getName() const noexcept {
-    // To decide whether to use the parent material name as a fallback, we check for the nullness of
-    // the instance's CString rather than calling empty(). This allows instances to override the
-    // parent material's name with a blank string.
-    if (mName.data() == nullptr) {
+    // To decide whether to use the parent material name as a fallback, we check whether a name
+    // was ever given to this instance rather than calling empty(). This allows instances to
+    // override the parent material's name with a blank string.
+    if (!mHasName) {
         return mMaterial->getName().c_str_safe();
     }
     return mName.c_str();
@@ -331,7 +373,7 @@ void FMaterialInstance::use(FEngine::DriverApi& driver) const {
         std::call_once(mMissingSamplersFlag, [this]() {
             auto const& list = mMaterial->getSamplerInterfaceBlock().getSamplerInfoList();
             slog.w << "sampler parameters not set in MaterialInstance \""
-                   << mName.c_str_safe() << "\" or Material \""
+                   << getName() << "\" or Material \""
                    << mMaterial->getName().c_str_safe() << "\":\n";
             mMissingSamplerDescriptors.forEachSetBit([&list](descriptor_binding_t binding) {
                 auto pos = std::find_if(list.begin(), list.end(), [binding](const auto& item) {
@@ -19,6 +19,7 @@
 
 #include "downcast.h"
 
+#include "BufferObjectArena.h"
 #include "UniformBuffer.h"
 
 #include "ds/DescriptorSet.h"
@@ -108,6 +109,7 @@ public:
 
     void setDepthFunc(backend::RasterState::DepthFunc depthFunc) noexcept {
         mDepthFunc = depthFunc;
+        sRasterStateGeneration++;
     }
 
     void setPolygonOffset(float scale, float constant) noexcept {
@@ -135,11 +137,20 @@ public:
 
     void setTransparencyMode(TransparencyMode mode) noexcept;
 
-    void setCullingMode(CullingMode culling) noexcept { mCulling = culling; }
+    void setCullingMode(CullingMode culling) noexcept {
+        mCulling = culling;
+        sRasterStateGeneration++;
+    }
 
-    void setColorWrite(bool enable) noexcept { mColorWrite = enable; }
+    void setColorWrite(bool enable) noexcept {
+        mColorWrite = enable;
+        sRasterStateGeneration++;
+    }
 
-    void setDepthWrite(bool enable) noexcept { mDepthWrite = enable; }
+    void setDepthWrite(bool enable) noexcept {
+        mDepthWrite = enable;
+        sRasterStateGeneration++;
+    }
 
     void setStencilWrite(bool enable) noexcept { mStencilState.stencilWrite = enable; }
 
@@ -147,6 +158,12 @@ public:
 
     bool isDepthCullingEnabled() const noexcept;
 
+    // Monotonic counter bumped whenever any instance changes raster state that gets baked into
+    // render pass commands (culling mode, color/depth write, depth func, transparency mode).
+    // State read at execution time (stencil, polygon offset, scissor) doesn't count. Used by
+    // FView to invalidate retained-mode command buffers.
+    static uint32_t getRasterStateGeneration() noexcept { return sRasterStateGeneration; }
+
     void setStencilCompareFunction(StencilCompareFunc func, StencilFace face) noexcept {
         if (any(face & StencilFace::FRONT)) {
             mStencilState.front.stencilFunc = func;
@@ -226,6 +243,10 @@ public:
     void setParameter(std::string_view name,
             backend::Handle<backend::HwTexture> texture, backend::SamplerParams params);
 
+    // folds a streaming-feedback sample (on-screen footprint of a renderable using this
+    // instance) into the desired mip level of the textures it samples
+    void updateStreamingFeedback(uint32_t frameCounter, float log2RequiredPixels) const noexcept;
+
     using MaterialInstance::setParameter;
 
 private:
@@ -244,6 +265,11 @@ private:
     template<typename T>
     void setParameterImpl(std::string_view name, const T* value, size_t count);
 
+    template<typename T>
+    void setParameterImpl(ParameterHandle handle, T const& value) noexcept;
+
+    void setParametersImpl(ParameterSetting const* settings, size_t count) noexcept;
+
     void setParameterImpl(std::string_view name,
             FTexture const* texture, TextureSampler const& sampler);
 
@@ -258,7 +284,9 @@ private:
         backend::SamplerParams params;
     };
 
-    backend::Handle<backend::HwBufferObject> mUbHandle;
+    // sub-allocation from the engine's uniform buffer arena, or a dedicated buffer object
+    // at FEATURE_LEVEL_0 where the UBO emulation doesn't support offset binding
+    BufferObjectArena::Allocation mUbAllocation;
     tsl::robin_map<backend::descriptor_binding_t, TextureParameter> mTextureParameters;
     mutable filament::DescriptorSet mDescriptorSet;
     UniformBuffer mUniforms;
@@ -277,6 +305,8 @@ private:
     bool mHasScissor : 1;
     bool mIsDoubleSided : 1;
     bool mIsDefaultInstance : 1;
+    bool mUbDedicated : 1;
+    bool mHasName : 1;
     TransparencyMode mTransparencyMode : 2;
 
     uint64_t mMaterialSortingKey = 0;
@@ -287,9 +317,13 @@ private:
             (uint32_t)std::numeric_limits<int32_t>::max()
     };
 
-    utils::CString mName;
+    // instance names are stored inline (and truncated if needed) so that naming an instance
+    // never allocates; unnamed instances fall back to the material's name in getName()
+    utils::FixedSizeString<64> mName;
     mutable utils::bitset64 mMissingSamplerDescriptors{};
     mutable std::once_flag mMissingSamplersFlag;
+
+    static uint32_t sRasterStateGeneration;
 };
 
 FILAMENT_DOWNCAST(MaterialInstance)
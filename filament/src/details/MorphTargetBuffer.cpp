@@ -187,6 +187,40 @@ void FMorphTargetBuffer::setPositionsAt(FEngine& engine, size_t targetIndex,
             count, offset);
 }
 
+void FMorphTargetBuffer::setPositionsAt(FEngine& engine, size_t targetIndex,
+        uint32_t const* indices, math::float3 const* positions, size_t count) {
+    FILAMENT_CHECK_PRECONDITION(targetIndex < mCount)
+            << targetIndex << " target index must be < " << mCount;
+
+    // Group runs of consecutive indices so that each run becomes a single texture update. Sparse
+    // morph data (e.g. glTF sparse accessors) typically affects contiguous regions of the mesh,
+    // so in practice only a handful of updates are issued per target.
+    FEngine::DriverApi& driver = engine.getDriverApi();
+    for (size_t i = 0; i < count;) {
+        size_t const runBegin = i;
+        uint32_t const first = indices[i];
+        while (++i < count && indices[i] == first + uint32_t(i - runBegin)) { }
+        size_t const runLength = i - runBegin;
+
+        FILAMENT_CHECK_PRECONDITION(first + runLength <= mVertexCount)
+                << "MorphTargetBuffer (size=" << (unsigned)mVertexCount
+                << ") overflow (count=" << (unsigned)runLength
+                << ", offset=" << (unsigned)first << ")";
+
+        auto size = getSize<VertexAttribute::POSITION>(runLength);
+
+        // We could use a pool instead of malloc() directly.
+        auto* out = (float4*) malloc(size);
+        std::transform(positions + runBegin, positions + runBegin + runLength, out,
+                [](const float3& p) { return float4(p, 1.0f); });
+
+        updateDataAt(driver, mPbHandle,
+                Texture::Format::RGBA, Texture::Type::FLOAT,
+                (char const*)out, sizeof(float4), targetIndex,
+                runLength, first);
+    }
+}
+
 void FMorphTargetBuffer::setTangentsAt(FEngine& engine, size_t targetIndex,
         math::short4 const* tangents, size_t count, size_t offset) {
     FILAMENT_CHECK_PRECONDITION(offset + count <= mVertexCount)
@@ -209,6 +243,37 @@ void FMorphTargetBuffer::setTangentsAt(FEngine& engine, size_t targetIndex,
             count, offset);
 }
 
+void FMorphTargetBuffer::setTangentsAt(FEngine& engine, size_t targetIndex,
+        uint32_t const* indices, math::short4 const* tangents, size_t count) {
+    FILAMENT_CHECK_PRECONDITION(targetIndex < mCount)
+            << targetIndex << " target index must be < " << mCount;
+
+    // See the sparse setPositionsAt overload for the run-grouping rationale.
+    FEngine::DriverApi& driver = engine.getDriverApi();
+    for (size_t i = 0; i < count;) {
+        size_t const runBegin = i;
+        uint32_t const first = indices[i];
+        while (++i < count && indices[i] == first + uint32_t(i - runBegin)) { }
+        size_t const runLength = i - runBegin;
+
+        FILAMENT_CHECK_PRECONDITION(first + runLength <= mVertexCount)
+                << "MorphTargetBuffer (size=" << (unsigned)mVertexCount
+                << ") overflow (count=" << (unsigned)runLength
+                << ", offset=" << (unsigned)first << ")";
+
+        const auto size = getSize<VertexAttribute::TANGENTS>(runLength);
+
+        // We could use a pool instead of malloc() directly.
+        auto* out = (short4*) malloc(size);
+        memcpy(out, tangents + runBegin, sizeof(short4) * runLength);
+
+        updateDataAt(driver, mTbHandle,
+                Texture::Format::RGBA_INTEGER, Texture::Type::SHORT,
+                (char const*)out, sizeof(short4), targetIndex,
+                runLength, first);
+    }
+}
+
 UTILS_NOINLINE
 void FMorphTargetBuffer::updateDataAt(backend::DriverApi& driver,
         Handle<HwTexture> handle, PixelDataFormat format, PixelDataType type,
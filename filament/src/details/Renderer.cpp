@@ -31,6 +31,10 @@
 #include "details/Texture.h"
 #include "details/View.h"
 
+#if FILAMENT_ENABLE_MATDBG
+#include <matdbg/DebugServer.h>
+#endif
+
 #include <filament/Camera.h>
 #include <filament/Fence.h>
 #include <filament/Options.h>
@@ -95,6 +99,8 @@ FRenderer::FRenderer(FEngine& engine) :
                 engine.getConfig(),
                 engine.getDriverApi()))
 {
+    mResourceAllocator->setMemoryTracker(&engine.getMemoryTracker());
+
     FDebugRegistry& debugRegistry = engine.getDebugRegistry();
     debugRegistry.registerProperty("d.renderer.doFrameCapture",
             &engine.debug.renderer.doFrameCapture);
@@ -180,10 +186,20 @@ void FRenderer::terminate(FEngine& engine) {
         engine.execute();
     }
     mFrameInfoManager.terminate(driver);
+    mFrameGraphInstrumentation.terminate(driver);
     mFrameSkipper.terminate(driver);
+    releaseSharedShadowAtlas();
     mResourceAllocator->terminate();
 }
 
+void FRenderer::releaseSharedShadowAtlas() noexcept {
+    if (UTILS_UNLIKELY(mSharedShadowAtlas.valid)) {
+        mEngine.getResourceAllocatorDisposer().destroy(
+                std::move(mSharedShadowAtlas.texture.handle));
+        mSharedShadowAtlas = {};
+    }
+}
+
 void FRenderer::resetUserTime() {
     mUserEpoch = std::chrono::steady_clock::now();
 }
@@ -269,7 +285,8 @@ void FRenderer::skipFrame(uint64_t vsyncSteadyClockTimeNano) {
 
     auto *job = js.runAndRetain(jobs::createJob(js, nullptr, &FEngine::gc, &engine)); // gc all managers
 
-    engine.flush();     // flush command stream
+    // the frame was skipped, nothing waits on these commands: let them coalesce
+    engine.flush(false);    // flush command stream
 
     // make sure we're done with the gcs
     js.waitAndRelease(job);
@@ -312,8 +329,12 @@ bool FRenderer::beginFrame(FSwapChain* swapChain, uint64_t vsyncSteadyClockTimeN
     SYSTRACE_FRAME_ID(mFrameId);
 
     FEngine& engine = mEngine;
+    engine.advanceFrameCounter();
     FEngine::DriverApi& driver = engine.getDriverApi();
 
+    // submit uploads held back by the staging budget, as far as the budget allows
+    engine.flushDeferredUploads();
+
     // start a frame capture, if requested.
     if (UTILS_UNLIKELY(engine.debug.renderer.doFrameCapture)) {
         driver.startCapture();
@@ -339,12 +360,20 @@ bool FRenderer::beginFrame(FSwapChain* swapChain, uint64_t vsyncSteadyClockTimeN
     // the frame skipper.
     driver.tick();
 
+    // Choose the frame cadence from the display's refresh rate and the recent GPU load, and
+    // check whether rendering at this vsync would break that cadence (see FramePacer).
+    nanoseconds const refreshPeriod(mDisplayInfo.refreshRate == 0.0 ? 0 : int64_t(
+            1'000'000'000.0 / mDisplayInfo.refreshRate));
+    bool const paced = mFramePacer.beginFrame(appVsync, refreshPeriod,
+            duration_cast<nanoseconds>(mFrameInfoManager.getLastFrameInfo().denoisedFrameTime),
+            mFrameRateOptions.interval);
+
     /*
     * From this point, we can't do any more work in beginFrame() because the user could choose
     * to ignore the return value and render the frame anyway -- which is perfectly fine.
     * The remaining work will be done when the first render() call is made.
     */
-    auto beginFrameInternal = [this, appVsync, swapChain]() {
+    auto beginFrameInternal = [this, appVsync, swapChain, refreshPeriod]() {
         FEngine& engine = mEngine;
         FEngine::DriverApi& driver = engine.getDriverApi();
 
@@ -354,8 +383,7 @@ bool FRenderer::beginFrame(FSwapChain* swapChain, uint64_t vsyncSteadyClockTimeN
 
         driver.beginFrame(
                 appVsync.time_since_epoch().count(),
-                mDisplayInfo.refreshRate == 0.0 ? 0 : int64_t(
-                        1'000'000'000.0 / mDisplayInfo.refreshRate),
+                refreshPeriod.count(),
                 mFrameId);
 
         // This need to occur after the backend beginFrame() because some backends need to start
@@ -369,7 +397,13 @@ bool FRenderer::beginFrame(FSwapChain* swapChain, uint64_t vsyncSteadyClockTimeN
         engine.prepare();
     };
 
-    if (mFrameSkipper.beginFrame(driver)) {
+    // Apply the swap chain's frame-latency policy (if any); a change takes effect as new
+    // frames are issued.
+    if (size_t const latency = swapChain->getFrameLatency(); latency) {
+        mFrameSkipper.setLatency(driver, latency);
+    }
+
+    if (paced && mFrameSkipper.beginFrame(driver)) {
         // if beginFrame() returns true, we are expecting a call to endFrame(),
         // so do the beginFrame work right now, instead of requiring a call to render()
         beginFrameInternal();
@@ -384,8 +418,9 @@ bool FRenderer::beginFrame(FSwapChain* swapChain, uint64_t vsyncSteadyClockTimeN
     // ignores the skip)
     mSwapChain = nullptr;
 
-    // we need to flush in this case, to make sure the tick() call is executed at some point
-    engine.flush();
+    // we need to flush in this case, to make sure the tick() call is executed at some point;
+    // "at some point" is exactly what a non-urgent flush guarantees
+    engine.flush(false);
 
     return false;
 }
@@ -415,9 +450,41 @@ void FRenderer::endFrame() {
         mSwapChain = nullptr;
     }
 
-    mFrameInfoManager.endFrame(driver);
+    auto const commandBufferStats = engine.getCommandBufferQueue().getStats();
+    mFrameInfoManager.endFrame(driver,
+            commandBufferStats.peakUsedBytes, commandBufferStats.bufferSizeBytes);
     mFrameSkipper.endFrame(driver);
 
+#if FILAMENT_ENABLE_MATDBG
+    if (UTILS_UNLIKELY(engine.debug.materials.gpu_profiling)) {
+        // harvest the per-material timer queries and publish the last completed frame
+        auto& profiler = engine.getMaterialProfiler();
+        profiler.endFrame(driver);
+        if (auto const* results = profiler.consumeResults()) {
+            if (matdbg::DebugServer* const server = engine.debug.server) {
+                for (auto const& [key, gpuNanos] : *results) {
+                    server->updateProfile(key, gpuNanos);
+                }
+            }
+        }
+    }
+#endif
+
+    // release the shadow atlas possibly detached for cross-View sharing during this frame
+    releaseSharedShadowAtlas();
+
+    // publish this frame's telemetry snapshot (lock-free on the reader side)
+    mFrameTelemetry.frameId = mFrameId;
+    mFrameTelemetry.commandBufferPeakBytes = uint32_t(commandBufferStats.peakUsedBytes);
+    mFrameTelemetry.commandBufferSizeBytes = uint32_t(commandBufferStats.bufferSizeBytes);
+    engine.getDebugRegistry().publishFrameTelemetry(mFrameTelemetry);
+    mFrameTelemetry = {};
+
+    if (UTILS_UNLIKELY(mFrameTimelineEnabled)) {
+        // pull the frames whose backend/GPU results have resolved into the timeline
+        mFrameTimeline.addFrameInfo(mFrameInfoManager.getFrameInfoHistory(MAX_FRAMETIME_HISTORY));
+    }
+
     driver.endFrame(mFrameId);
 
     // gives the backend a chance to execute periodic tasks
@@ -519,6 +586,40 @@ void FRenderer::copyFrame(FSwapChain* dstSwapChain, filament::Viewport const& ds
     mSwapChain->makeCurrent(driver);
 }
 
+void FRenderer::copyFrameInto(FTexture* dstTexture, filament::Viewport const& dstViewport,
+        filament::Viewport const& srcViewport, backend::CallbackHandler* handler,
+        backend::CallbackHandler::Callback callback, void* user) {
+    SYSTRACE_CALL();
+
+    assert_invariant(mSwapChain);
+    assert_invariant(dstTexture);
+
+    FILAMENT_CHECK_PRECONDITION(any(dstTexture->getUsage() & TextureUsage::BLIT_DST))
+            << "copyFrameInto() requires a texture created with TextureUsage::BLIT_DST.";
+
+    FEngine& engine = mEngine;
+    FEngine::DriverApi& driver = engine.getDriverApi();
+
+    // Verify that the source swap chain is readable.
+    assert_invariant(mSwapChain->isReadable());
+
+    // Wrap the destination texture in a transient render target so we can reuse the blit
+    // path. The copy stays entirely on the GPU timeline: no readback, no pipeline sync.
+    Handle<HwRenderTarget> const dstRenderTarget = driver.createRenderTarget(
+            TargetBufferFlags::COLOR,
+            dstTexture->getWidth(), dstTexture->getHeight(), 1, 0,
+            { dstTexture->getHwHandle() }, {}, {});
+
+    driver.blitDEPRECATED(TargetBufferFlags::COLOR, dstRenderTarget,
+            dstViewport, mRenderTargetHandle, srcViewport, SamplerMagFilter::LINEAR);
+
+    driver.destroyRenderTarget(dstRenderTarget);
+
+    if (callback) {
+        driver.queueCallback(handler, callback, user);
+    }
+}
+
 void FRenderer::renderStandaloneView(FView const* view) {
     SYSTRACE_CALL();
 
@@ -536,6 +637,7 @@ void FRenderer::renderStandaloneView(FView const* view) {
 
         // ask the engine to do what it needs to (e.g. updates light buffer, materials...)
         FEngine& engine = mEngine;
+        engine.advanceFrameCounter();
         engine.prepare();
 
         FEngine::DriverApi& driver = engine.getDriverApi();
@@ -547,6 +649,8 @@ void FRenderer::renderStandaloneView(FView const* view) {
 
         renderInternal(view);
 
+        releaseSharedShadowAtlas();
+
         driver.endFrame(mFrameId);
 
         // This is a workaround for internal bug b/361822355.
@@ -581,24 +685,65 @@ void FRenderer::render(FView const* view) {
     }
 }
 
+void FRenderer::render(FView const* const* views, size_t const viewCount) {
+    SYSTRACE_CALL();
+
+    if (UTILS_UNLIKELY(mBeginFrameInternal)) {
+        // this should not happen, the user should not call render() if we returned false from
+        // beginFrame(). But because this is allowed, we handle it gracefully.
+        mBeginFrameInternal();
+        mBeginFrameInternal = {};
+    }
+
+    // after beginFrame() is called, mSwapChain should be true
+    assert_invariant(mSwapChain);
+
+    // The caller guarantees the views are independent, so we flush the command stream between
+    // views: the backend thread encodes one view's commands while we generate the next view's.
+    // True concurrent encoding (e.g. several primary command buffers recorded in parallel)
+    // would require multiple command stream consumers, which the single driver thread doesn't
+    // support; pipelining the encode against command generation recovers most of the overlap.
+    for (size_t i = 0; i < viewCount; i++) {
+        FView const* const view = views[i];
+        if (UTILS_LIKELY(view && view->getScene() && view->hasCamera())) {
+            if (mViewRenderedCount) {
+                mEngine.getDriverApi().flush();
+            }
+            renderInternal(view);
+            mViewRenderedCount++;
+        }
+    }
+}
+
 void FRenderer::renderInternal(FView const* view) {
     FEngine& engine = mEngine;
+    FView& mutableView = const_cast<FView&>(*view);
 
-    // per-renderpass data
-    RootArenaScope rootArenaScope(engine.getPerRenderPassArena());
+    // let the view's per-render-pass arena grow/shrink based on last frames' usage
+    mutableView.adjustPerRenderPassArena(engine);
+
+    // per-renderpass data. Each view allocates from its own arena, so several views'
+    // prepare phases don't contend on a shared allocator.
+    RootArenaScope rootArenaScope(mutableView.getPerRenderPassArena());
 
     // create a root job so no other job can escape
     JobSystem& js = engine.getJobSystem();
     auto *rootJob = js.setRootJob(js.createJob());
 
+    // frame preparation is latency-critical: ask long-running cooperative jobs (e.g. asset
+    // decoding) to step aside until we're done
+    js.raiseUrgentWork();
+
     // execute the render pass
-    renderJob(rootArenaScope, const_cast<FView&>(*view));
+    renderJob(rootArenaScope, mutableView);
 
     // make sure to flush the command buffer
     engine.flush();
 
     // and wait for all jobs to finish as a safety (this should be a no-op)
     js.runAndWait(rootJob);
+
+    js.lowerUrgentWork();
 }
 
 void FRenderer::renderJob(RootArenaScope& rootArenaScope, FView& view) {
@@ -627,6 +772,21 @@ void FRenderer::renderJob(RootArenaScope& rootArenaScope, FView& view) {
     auto colorGrading = view.getColorGrading();
     auto ssReflectionsOptions = view.getScreenSpaceReflectionsOptions();
     auto guardBandOptions = view.getGuardBandOptions();
+
+    // Closed-loop quality scaling: when the previous frames' GPU time exceeded the caller-set
+    // budget, lower this frame's quality knobs (the directional shadow cascade count is
+    // handled in FView::prepareShadowing, which sees the same degradation level).
+    uint8_t const qualityDegradation = view.updateQualityDegradation(
+            mFrameInfoManager.getLastFrameInfo(), mFrameRateOptions, mDisplayInfo);
+    if (UTILS_UNLIKELY(qualityDegradation > 0)) {
+        bloomOptions.levels = uint8_t(std::max(3, bloomOptions.levels - 2 * qualityDegradation));
+        aoOptions.quality = std::min(aoOptions.quality,
+                qualityDegradation >= 2 ? QualityLevel::LOW : QualityLevel::MEDIUM);
+        if (qualityDegradation >= 3) {
+            // at the lowest level also drop SSAO to quarter resolution
+            aoOptions.resolution = std::min(aoOptions.resolution, 0.5f);
+        }
+    }
     const bool isRenderingMultiview = view.hasStereo() &&
             engine.getConfig().stereoscopicType == backend::StereoscopicType::MULTIVIEW;
     // FIXME: This is to override some settings that are not supported for multiview at the moment.
@@ -656,8 +816,12 @@ void FRenderer::renderJob(RootArenaScope& rootArenaScope, FView& view) {
                 dsrOptions.enabled = false;
                 // also, upscaling doesn't work well with quater-resolution SSAO
                 aoOptions.resolution = 1.0;
-                // Currently we only support a fixed TAA upscaling ratio
-                scale = 0.5f;
+                // The temporal reconstruction is a fixed 2x per axis: rendering above 50% of
+                // the display resolution overshoots it, and the excess is downsampled back
+                // to native after TAA -- force the bilinear path for that downsample, the
+                // FSR upscaler only handles magnification.
+                scale = taaOptions.upscalingRatio;
+                dsrOptions.quality = QualityLevel::LOW;
             }
         }
     }
@@ -826,6 +990,10 @@ void FRenderer::renderJob(RootArenaScope& rootArenaScope, FView& view) {
 
     FrameGraph fg(*mResourceAllocator,
             isProtectedContent ? FrameGraph::Mode::PROTECTED : FrameGraph::Mode::UNPROTECTED);
+
+    if (UTILS_UNLIKELY(mFrameTimelineEnabled)) {
+        fg.setInstrumentation(&mFrameGraphInstrumentation, mFrameId);
+    }
     auto& blackboard = fg.getBlackboard();
 
     /*
@@ -833,13 +1001,67 @@ void FRenderer::renderJob(RootArenaScope& rootArenaScope, FView& view) {
      */
 
     if (view.needsShadowMap()) {
-        Variant shadowVariant(Variant::DEPTH_VARIANT);
-        shadowVariant.setVsm(view.getShadowType() == ShadowType::VSM);
-        auto shadows = view.renderShadowMaps(engine, fg, cameraInfo, mShaderUserTime,
-                RenderPassBuilder{ commandArena }
-                    .renderFlags(renderFlags)
-                    .variant(shadowVariant));
-        blackboard["shadows"] = shadows;
+        // Cross-View shadow sharing: when several Views showing the same scene are in the same
+        // sharing group (see View::setShadowSharingGroup()), the first one renders the shadow
+        // atlas and detaches it from its FrameGraph; the others import it instead of running
+        // their own shadow passes. Directional cascades are fitted to the view frustum, so when
+        // they are in play we only share between Views whose culling cameras are identical --
+        // otherwise the consumer's shadow matrices wouldn't match the atlas content.
+        uint8_t const shadowSharingGroup = view.getShadowSharingGroup();
+        auto& sharedShadows = mSharedShadowAtlas;
+        auto const matches = [](math::mat4f const& lhs, math::mat4f const& rhs) {
+            return lhs[0] == rhs[0] && lhs[1] == rhs[1] && lhs[2] == rhs[2] && lhs[3] == rhs[3];
+        };
+        bool const canConsumeSharedShadows = shadowSharingGroup != 0u
+                && sharedShadows.valid
+                && sharedShadows.group == shadowSharingGroup
+                && sharedShadows.scene == view.getScene()
+                && sharedShadows.shadowType == view.getShadowType()
+                && (!view.needsDirectionalShadowMaps() ||
+                        (matches(sharedShadows.cameraView, cameraInfo.view) &&
+                         matches(sharedShadows.cameraCullingProjection,
+                                 cameraInfo.cullingProjection)));
+        if (UTILS_UNLIKELY(canConsumeSharedShadows)) {
+            auto shadows = view.importShadowMaps(engine, fg, cameraInfo,
+                    sharedShadows.desc, sharedShadows.texture);
+            blackboard["shadows"] = shadows;
+        } else {
+            Variant shadowVariant(Variant::DEPTH_VARIANT);
+            shadowVariant.setVsm(view.getShadowType() == ShadowType::VSM);
+            auto shadows = view.renderShadowMaps(engine, fg, cameraInfo, mShaderUserTime,
+                    RenderPassBuilder{ commandArena }
+                        .renderFlags(renderFlags)
+                        .variant(shadowVariant));
+            blackboard["shadows"] = shadows;
+
+            if (UTILS_UNLIKELY(shadowSharingGroup != 0u && !sharedShadows.valid)) {
+                // Detach the atlas so later Views of this frame can import it. We need
+                // sideEffect() because this pass has no consumed output within this graph.
+                struct ExportSharedShadowsData {
+                    FrameGraphId<FrameGraphTexture> shadows;
+                };
+                fg.addPass<ExportSharedShadowsData>("Export Shared Shadowmap",
+                        [&](FrameGraph::Builder& builder, auto& data) {
+                            builder.sideEffect();
+                            data.shadows = builder.sample(shadows);
+                        },
+                        [this, shadowSharingGroup, scene = view.getScene(),
+                                shadowType = view.getShadowType(),
+                                cameraView = cameraInfo.view,
+                                cameraCullingProjection = cameraInfo.cullingProjection]
+                                (FrameGraphResources const& resources, auto const& data,
+                                        backend::DriverApi&) {
+                            auto& shared = mSharedShadowAtlas;
+                            resources.detach(data.shadows, &shared.texture, &shared.desc);
+                            shared.scene = scene;
+                            shared.cameraView = cameraView;
+                            shared.cameraCullingProjection = cameraCullingProjection;
+                            shared.shadowType = shadowType;
+                            shared.group = shadowSharingGroup;
+                            shared.valid = true;
+                        });
+            }
+        }
     }
 
     // When we don't have a custom RenderTarget, customRenderTarget below is nullptr and is
@@ -950,7 +1172,7 @@ void FRenderer::renderJob(RootArenaScope& rootArenaScope, FView& view) {
                 // The reason why this bug is acceptable is that the viewport parameters are
                 // currently only used for generating noise, so it's not too bad.
 
-                // note: aoOptions.resolution is either 1.0 or 0.5, and the result is then
+                // note: aoOptions.resolution is 1.0, 0.5 or 0.25, and the result is then
                 // guaranteed to be an integer (because xvp is a multiple of 16).
                 view.prepareViewport(svp,
                         filament::Viewport{
@@ -1052,7 +1274,8 @@ void FRenderer::renderJob(RootArenaScope& rootArenaScope, FView& view) {
                 [=, &view](FrameGraphResources const& resources,
                         auto const&, DriverApi& driver) mutable {
                     auto out = resources.getRenderPassInfo();
-                    view.executePickingQueries(driver, out.target, scale * aoOptions.resolution);
+                    view.executePickingQueries(driver, out.target, scale * aoOptions.resolution,
+                            out.params.viewport.width, out.params.viewport.height);
                 });
     }
 
@@ -1150,6 +1373,11 @@ void FRenderer::renderJob(RootArenaScope& rootArenaScope, FView& view) {
 
     passBuilder.commandTypeFlags(RenderPass::CommandTypeFlags::COLOR);
 
+    // Attach the view's retained-mode command cache. This must happen only on the color
+    // pass: the builder copies made for the picking and ssr passes above use different
+    // inputs, and would otherwise evict the cached commands every frame.
+    passBuilder.cachedCommands(view.getColorPassCachedCommands(scene));
+
 
     // RenderPass::IS_INSTANCED_STEREOSCOPIC only applies to the color pass
     if (view.hasStereo() &&
@@ -1195,31 +1423,31 @@ void FRenderer::renderJob(RootArenaScope& rootArenaScope, FView& view) {
             }
     );
 
-    // the color pass itself + color-grading as subpass if needed
-    auto colorPassOutput = RendererUtils::colorPass(fg, "Color Pass", mEngine, view, {
-                .shadows = blackboard.get<FrameGraphTexture>("shadows"),
-                .ssao = blackboard.get<FrameGraphTexture>("ssao"),
-                .ssr = ssrConfig.ssr,
-                .structure = structure
-            },
-            colorBufferDesc, config, colorGradingConfigForColor, pass.getExecutor());
-
-    if (view.isScreenSpaceRefractionEnabled() && !pass.empty()) {
-        // This cancels the colorPass() call above if refraction is active.
-        // The color pass + refraction + color-grading as subpass if needed
-        auto const output = RendererUtils::refractionPass(fg, mEngine, view, {
+    // Check on the post-culling command list whether any refractive object is actually visible
+    // this frame; the refraction color capture and mip-chain generation are skipped entirely
+    // otherwise.
+    RenderPass::Command const* const firstRefractionCommand =
+            (view.isScreenSpaceRefractionEnabled() && !pass.empty()) ?
+                    RendererUtils::findFirstRefractionCommand(pass) : nullptr;
+
+    hasScreenSpaceRefraction = firstRefractionCommand != nullptr;
+
+    // the color pass itself + refraction if needed + color-grading as subpass if needed
+    auto colorPassOutput = hasScreenSpaceRefraction ?
+            RendererUtils::refractionPass(fg, mEngine, view, {
                         .shadows = blackboard.get<FrameGraphTexture>("shadows"),
                         .ssao = blackboard.get<FrameGraphTexture>("ssao"),
                         .ssr = ssrConfig.ssr,
                         .structure = structure
                 },
-                config, ssrConfig, colorGradingConfigForColor, pass);
-
-        hasScreenSpaceRefraction = output.has_value();
-        if (hasScreenSpaceRefraction) {
-            colorPassOutput = output.value();
-        }
-    }
+                config, ssrConfig, colorGradingConfigForColor, pass, firstRefractionCommand) :
+            RendererUtils::colorPass(fg, "Color Pass", mEngine, view, {
+                        .shadows = blackboard.get<FrameGraphTexture>("shadows"),
+                        .ssao = blackboard.get<FrameGraphTexture>("ssao"),
+                        .ssr = ssrConfig.ssr,
+                        .structure = structure
+                },
+                colorBufferDesc, config, colorGradingConfigForColor, pass.getExecutor());
 
     if (colorGradingConfig.customResolve) {
         assert_invariant(fg.getDescriptor(colorPassOutput.linearColor).samples <= 1);
@@ -1265,6 +1493,36 @@ void FRenderer::renderJob(RootArenaScope& rootArenaScope, FView& view) {
     // input can change below
     FrameGraphId<FrameGraphTexture> input = postProcessInput;
 
+    // Auto-exposure metering -- scale the HDR buffer down and read it back asynchronously.
+    // The readback's completion callback performs the adaptation, so this never stalls;
+    // the adapted exposure is consumed by FView::prepare() a few frames later.
+    if (UTILS_UNLIKELY(view.isAutoExposureEnabled())) {
+        constexpr uint32_t dim = FView::AUTO_EXPOSURE_METERING_SIZE;
+        auto const metered = ppm.blit(fg, false, colorPassOutput.linearColor, xvp, {
+                        .width = dim, .height = dim,
+                        .format = TextureFormat::RGBA16F },
+                SamplerMagFilter::LINEAR, SamplerMinFilter::LINEAR);
+
+        struct AutoExposureReadbackData {
+            FrameGraphId<FrameGraphTexture> color;
+        };
+        fg.addPass<AutoExposureReadbackData>("Auto Exposure Readback",
+                [&](FrameGraph::Builder& builder, auto& data) {
+                    data.color = builder.read(metered, FrameGraphTexture::Usage::COLOR_ATTACHMENT |
+                                                       FrameGraphTexture::Usage::BLIT_SRC);
+                    builder.declareRenderPass("Auto Exposure Metering Target", {
+                            .attachments = { .color = { data.color }}
+                    });
+                    builder.sideEffect();
+                },
+                [&view](FrameGraphResources const& resources,
+                        auto const&, DriverApi& driver) {
+                    auto out = resources.getRenderPassInfo();
+                    driver.readPixels(out.target, 0, 0, dim, dim,
+                            view.makeAutoExposureMeteringBuffer());
+                });
+    }
+
     // Resolve depth -- which might be needed because of TAA or DoF. This pass will be culled
     // if the depth is not used below or if the depth is not MS (e.g. it could have been
     // auto-resolved).
@@ -1287,9 +1545,12 @@ void FRenderer::renderJob(RootArenaScope& rootArenaScope, FView& view) {
         input = ppm.taa(fg, input, depth, view.getFrameHistory(), &FrameHistoryEntry::taa,
                 taaOptions, colorGradingConfig);
         if (taaOptions.upscaling) {
-            scale = 1.0f;
-            scaled = false;
-            UTILS_UNUSED_IN_RELEASE auto const& inputDesc = fg.getDescriptor(input);
+            // the reconstructed output is twice the rendering resolution per axis; with a 0.5
+            // rendering ratio this is exactly the native resolution, with a higher ratio the
+            // output is supersampled and the regular scaled path downsamples it to native
+            scale *= 2.0f;
+            scaled = any(notEqual(scale, float2(1.0f)));
+            auto const& inputDesc = fg.getDescriptor(input);
             svp.width = inputDesc.width;
             svp.height = inputDesc.height;
             xvp.width *= 2;
@@ -1432,9 +1693,20 @@ void FRenderer::renderJob(RootArenaScope& rootArenaScope, FView& view) {
 
     fg.execute(driver);
 
+    if (UTILS_UNLIKELY(mFrameTimelineEnabled)) {
+        // collect the pass records of older frames whose GPU results have come back
+        mFrameTimeline.addPassRecords(mFrameGraphInstrumentation.takeResolvedFrames());
+    }
+
     // save the current history entry and destroy the oldest entry
     view.commitFrameHistory(engine);
 
+    // accumulate this view's telemetry counters; endFrame() publishes them to the DebugRegistry
+    Froxelizer const& froxelizer = view.getFroxelizer();
+    mFrameTelemetry.froxelRecordBytesUsed += froxelizer.getRecordBufferUsed();
+    mFrameTelemetry.froxelOverflowCount += froxelizer.getRecordBufferOverflowCount();
+    mFrameTelemetry.shadowPassCount += view.getShadowPassCount();
+
     recordHighWatermark(commandArena.getListener().getHighWatermark());
 }
 
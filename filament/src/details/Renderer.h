@@ -21,7 +21,9 @@
 
 #include "Allocators.h"
 #include "FrameInfo.h"
+#include "FramePacer.h"
 #include "FrameSkipper.h"
+#include "FrameTimeline.h"
 #include "PostProcessManager.h"
 #include "RenderPass.h"
 
@@ -29,6 +31,7 @@
 
 #include "backend/DriverApiForward.h"
 
+#include <filament/DebugRegistry.h>
 #include <filament/Renderer.h>
 #include <filament/Viewport.h>
 
@@ -39,6 +42,7 @@
 #include <utils/Allocator.h>
 #include <utils/FixedCapacityVector.h>
 
+#include <math/mat4.h>
 #include <math/vec4.h>
 
 #include <tsl/robin_set.h>
@@ -62,6 +66,8 @@ class Driver;
 
 class FEngine;
 class FRenderTarget;
+class FScene;
+class FTexture;
 class FView;
 
 /*
@@ -102,6 +108,7 @@ public:
 
     // render a view. must be called between beginFrame/enfFrame.
     void render(FView const* view);
+    void render(FView const* const* views, size_t viewCount);
 
     // read pixel from the current swapchain. must be called between beginFrame/enfFrame.
     void readPixels(uint32_t xoffset, uint32_t yoffset, uint32_t width, uint32_t height,
@@ -116,6 +123,12 @@ public:
     void copyFrame(FSwapChain* dstSwapChain, Viewport const& dstViewport,
             Viewport const& srcViewport, CopyFrameFlag flags);
 
+    // blits the current swapchain into a user texture, entirely on the GPU.
+    // must be called between beginFrame/endFrame.
+    void copyFrameInto(FTexture* dstTexture, Viewport const& dstViewport,
+            Viewport const& srcViewport, backend::CallbackHandler* handler,
+            backend::CallbackHandler::Callback callback, void* user);
+
 
     void setDisplayInfo(DisplayInfo const& info) noexcept {
         mDisplayInfo.refreshRate = info.refreshRate;
@@ -155,6 +168,23 @@ public:
         return MAX_FRAMETIME_HISTORY;
     }
 
+    // enables/disables the frame timeline recorder; disabling keeps the recorded history
+    void setFrameTimelineEnabled(bool enabled) noexcept {
+        mFrameTimelineEnabled = enabled;
+    }
+
+    bool isFrameTimelineEnabled() const noexcept {
+        return mFrameTimelineEnabled;
+    }
+
+    utils::CString exportFrameTimeline() const noexcept {
+        return mFrameTimeline.exportChromeTrace();
+    }
+
+    utils::FixedCapacityVector<Renderer::PassStatistics> getPassStatistics() const noexcept {
+        return mFrameTimeline.getPassStatistics();
+    }
+
 private:
     friend class Renderer;
     using Command = RenderPass::Command;
@@ -188,16 +218,23 @@ private:
 
     void renderInternal(FView const* view);
     void renderJob(RootArenaScope& rootArenaScope, FView& view);
+    void releaseSharedShadowAtlas() noexcept;
 
     // keep a reference to our engine
     FEngine& mEngine;
     FrameSkipper mFrameSkipper;
+    FramePacer mFramePacer;
     backend::Handle<backend::HwRenderTarget> mRenderTargetHandle;
     FSwapChain* mSwapChain = nullptr;
     size_t mCommandsHighWatermark = 0;
     uint32_t mFrameId = 0;
     uint32_t mViewRenderedCount = 0;
     FrameInfoManager mFrameInfoManager;
+    // per-frame counters accumulated across the frame's views, published by endFrame()
+    DebugRegistry::FrameTelemetry mFrameTelemetry{};
+    FrameGraph::Instrumentation mFrameGraphInstrumentation;
+    FrameTimeline mFrameTimeline;
+    bool mFrameTimelineEnabled = false;
     backend::TextureFormat mHdrTranslucent;
     backend::TextureFormat mHdrQualityMedium;
     backend::TextureFormat mHdrQualityHigh;
@@ -210,6 +247,20 @@ private:
     backend::TargetBufferFlags mDiscardStartFlags{};
     backend::TargetBufferFlags mClearFlags{};
     tsl::robin_set<FRenderTarget*> mPreviousRenderTargets;
+    // Shadow atlas detached from the FrameGraph of a View rendered earlier this frame, so that
+    // other Views in the same sharing group can import it instead of re-rendering their own
+    // shadow passes (see View::setShadowSharingGroup()). Released in endFrame().
+    struct SharedShadowAtlas {
+        FScene const* scene = nullptr;
+        math::mat4f cameraView;
+        math::mat4f cameraCullingProjection;
+        FrameGraphTexture texture;
+        FrameGraphTexture::Descriptor desc;
+        ShadowType shadowType = ShadowType::PCF;
+        uint8_t group = 0;
+        bool valid = false;
+    };
+    SharedShadowAtlas mSharedShadowAtlas;
     std::function<void()> mBeginFrameInternal;
     uint64_t mVsyncSteadyClockTimeNano = 0;
     std::unique_ptr<ResourceAllocator> mResourceAllocator{};
@@ -18,11 +18,14 @@
 
 #include "components/LightManager.h"
 #include "components/RenderableManager.h"
+#include "components/TransformManager.h"
 
 #include <private/filament/UibStructs.h>
 
 #include "details/Engine.h"
+#include "details/Fence.h"
 #include "details/IndirectLight.h"
+#include "details/MaterialInstance.h"
 #include "details/InstanceBuffer.h"
 #include "details/Skybox.h"
 
@@ -63,6 +66,12 @@ void FScene::prepare(utils::JobSystem& js,
 
     SYSTRACE_CONTEXT();
 
+    // flip to a new environment requested via setEnvironment() if it's resident by now
+    commitPendingEnvironment();
+
+    // service the deferred destruction of removed streaming partitions
+    collectRemovedPartitions();
+
     // This will reset the allocator upon exiting
     ArenaScope<RootArenaScope::Arena> localArenaScope(rootArenaScope.getArena());
 
@@ -179,7 +188,7 @@ void FScene::prepare(utils::JobSystem& js,
 
             // this is where we go from double to float for our transforms
             const mat4f shaderWorldTransform{
-                    worldTransform * tcm.getWorldTransformAccurate(ti) };
+                    worldTransform * tcm.getCommittedWorldTransformAccurate(ti) };
             const bool reversedWindingOrder = det(shaderWorldTransform.upperLeft()) < 0;
 
             // compute the world AABB so we can perform culling
@@ -212,7 +221,8 @@ void FScene::prepare(utils::JobSystem& js,
             sceneData.elementAt<LAYERS>(index)              = rcm.getLayerMask(ri);
             sceneData.elementAt<WORLD_AABB_EXTENT>(index)   = worldAABB.halfExtent;
             //sceneData.elementAt<PRIMITIVES>(index)          = {}; // already initialized, Slice<>
-            sceneData.elementAt<SUMMED_PRIMITIVE_COUNT>(index) = 0;
+            sceneData.elementAt<PRIMITIVE_VISIBLE_MASK>(index) = ~uint32_t(0);
+            sceneData.elementAt<SUMMED_COMMAND_COUNT>(index) = 0;
             //sceneData.elementAt<UBO>(index)                 = {}; // not needed here
             sceneData.elementAt<USER_DATA>(index)           = scale;
         }
@@ -225,7 +235,7 @@ void FScene::prepare(utils::JobSystem& js,
             auto [li, ti] = p[i];
             // this is where we go from double to float for our transforms
             mat4f const shaderWorldTransform{
-                    worldTransform * tcm.getWorldTransformAccurate(ti) };
+                    worldTransform * tcm.getCommittedWorldTransformAccurate(ti) };
             float4 const position = shaderWorldTransform * float4{ lcm.getLocalPosition(li), 1 };
             float3 d = 0;
             if (!lcm.isPointLight(li) || lcm.isIESLight(li)) {
@@ -268,7 +278,7 @@ void FScene::prepare(utils::JobSystem& js,
         // world transform is irrelevant, and we don't need to use getWorldTransformAccurate()
 
         mat3 const worldDirectionTransform =
-                mat3::getTransformForNormals(tcm.getWorldTransformAccurate(ti).upperLeft());
+                mat3::getTransformForNormals(tcm.getCommittedWorldTransformAccurate(ti).upperLeft());
         FLightManager::ShadowParams const params = lcm.getShadowParams(li);
         float3 const localDirection = worldDirectionTransform * lcm.getLocalDirection(li);
         double3 const shadowLocalDirection = params.options.transform * localDirection;
@@ -323,6 +333,17 @@ void FScene::prepare(utils::JobSystem& js,
 
     js.runAndWait(rootJob);
 
+    // Refresh the spatial structure now that world-space AABBs are final. The topology is
+    // only rebuilt when the renderable count changes; otherwise the bounds are refitted in
+    // place, which is O(n) with a small constant.
+    if (UTILS_UNLIKELY(mRenderableBvh.size() != sceneData.size())) {
+        mRenderableBvh.rebuild(sceneData.data<WORLD_AABB_CENTER>(),
+                sceneData.data<WORLD_AABB_EXTENT>(), sceneData.size());
+    } else {
+        mRenderableBvh.refit(sceneData.data<WORLD_AABB_CENTER>(),
+                sceneData.data<WORLD_AABB_EXTENT>());
+    }
+
     SYSTRACE_NAME_END();
 }
 
@@ -331,14 +352,14 @@ void FScene::prepareVisibleRenderables(Range<uint32_t> visibleRenderables) noexc
     RenderableSoa& sceneData = mRenderableData;
     FRenderableManager const& rcm = mEngine.getRenderableManager();
 
-    mHasContactShadows = false;
-    for (uint32_t const i : visibleRenderables) {
-        PerRenderableData& uboData = sceneData.elementAt<UBO>(i);
-
-        auto const visibility = sceneData.elementAt<VISIBILITY_STATE>(i);
-        auto const& model = sceneData.elementAt<WORLD_TRANSFORM>(i);
-        auto const ri = sceneData.elementAt<RENDERABLE_INSTANCE>(i);
-
+    bool hasContactShadows = false;
+    sceneData.forEachElement<UBO, VISIBILITY_STATE, WORLD_TRANSFORM, RENDERABLE_INSTANCE,
+            INSTANCES, CHANNELS, MORPHING_BUFFER, USER_DATA>(
+            visibleRenderables.first, visibleRenderables.last,
+            [&rcm, &hasContactShadows](size_t,
+                    PerRenderableData& uboData, auto const& visibility, mat4f const& model,
+                    auto const ri, auto const& instances, uint8_t const channels,
+                    auto const& morphing, float const userData) {
         // Using mat3f::getTransformForNormals handles non-uniform scaling, but DOESN'T guarantee that
         // the transformed normals will have unit-length, therefore they need to be normalized
         // in the shader (that's already the case anyway, since normalization is needed after
@@ -368,18 +389,19 @@ void FScene::prepareVisibleRenderables(Range<uint32_t> visibleRenderables) noexc
                 visibility.skinning,
                 visibility.morphing,
                 visibility.screenSpaceContactShadows,
-                sceneData.elementAt<INSTANCES>(i).buffer != nullptr,
-                sceneData.elementAt<CHANNELS>(i));
+                instances.buffer != nullptr,
+                channels);
 
-        uboData.morphTargetCount = sceneData.elementAt<MORPHING_BUFFER>(i).count;
+        uboData.morphTargetCount = morphing.count;
 
         uboData.objectId = rcm.getEntity(ri).getId();
 
         // TODO: We need to find a better way to provide the scale information per object
-        uboData.userData = sceneData.elementAt<USER_DATA>(i);
+        uboData.userData = userData;
 
-        mHasContactShadows = mHasContactShadows || visibility.screenSpaceContactShadows;
-    }
+        hasContactShadows = hasContactShadows || visibility.screenSpaceContactShadows;
+    });
+    mHasContactShadows = hasContactShadows;
 }
 
 void FScene::updateUBOs(
@@ -403,17 +425,17 @@ void FScene::updateUBOs(
     }();
 
     PerRenderableData const* const uboData = mRenderableData.data<UBO>();
-    mat4f const* const worldTransformData = mRenderableData.data<WORLD_TRANSFORM>();
 
     // prepare each InstanceBuffer.
-    FRenderableManager::InstancesInfo const* instancesData = mRenderableData.data<INSTANCES>();
-    for (uint32_t const i : visibleRenderables) {
-        auto& instancesInfo = instancesData[i];
+    mRenderableData.forEachElement<INSTANCES, WORLD_TRANSFORM, UBO>(
+            visibleRenderables.first, visibleRenderables.last,
+            [this](size_t, auto& instancesInfo, mat4f const& worldTransform,
+                    PerRenderableData const& ubo) {
         if (UTILS_UNLIKELY(instancesInfo.buffer)) {
             instancesInfo.buffer->prepare(
-                    mEngine, worldTransformData[i], uboData[i], instancesInfo.handle);
+                    mEngine, worldTransform, ubo, instancesInfo.handle);
         }
-    }
+    });
 
     // copy our data into the UBO for each visible renderable
     for (uint32_t const i : visibleRenderables) {
@@ -441,7 +463,15 @@ void FScene::updateUBOs(
     }, 0);
 }
 
-void FScene::terminate(FEngine&) {
+void FScene::terminate(FEngine& engine) {
+    // removePartition() promised destruction of these components, finish it now
+    FRenderableManager& rcm = engine.getRenderableManager();
+    FLightManager& lcm = engine.getLightManager();
+    for (Entity const e : mPartitionGraveyard) {
+        rcm.destroy(e);
+        lcm.destroy(e);
+    }
+    mPartitionGraveyard.clear();
 }
 
 void FScene::prepareDynamicLights(const CameraInfo& camera,
@@ -526,16 +556,19 @@ inline void FScene::computeLightRanges(
 
 UTILS_NOINLINE
 void FScene::addEntity(Entity entity) {
+    mMutationGeneration++;
     mEntities.insert(entity);
 }
 
 UTILS_NOINLINE
 void FScene::addEntities(const Entity* entities, size_t count) {
+    mMutationGeneration++;
     mEntities.insert(entities, entities + count);
 }
 
 UTILS_NOINLINE
 void FScene::remove(Entity entity) {
+    mMutationGeneration++;
     mEntities.erase(entity);
 }
 
@@ -546,6 +579,79 @@ void FScene::removeEntities(const Entity* entities, size_t count) {
     }
 }
 
+Scene::PartitionId FScene::addPartition(const Entity* entities, size_t count,
+        size_t const sizeInBytes) {
+    addEntities(entities, count);
+
+    Scene::PartitionId const id = mNextPartitionId++;
+    FixedCapacityVector<Entity> batch(count);
+    std::copy_n(entities, count, batch.data());
+    mPartitions.push_back({ id, sizeInBytes, std::move(batch) });
+    mPartitionBytes += sizeInBytes;
+
+    // enforce the budget by evicting oldest-first, never the partition just added
+    if (mPartitionBudget && bool(mPartitionEvictionCallback)) {
+        while (mPartitionBytes > mPartitionBudget && mPartitions.size() > 1) {
+            Scene::PartitionId const victim = mPartitions.front().id;
+            mPartitionEvictionCallback(victim);
+            // a no-op if the callback already removed it
+            removePartition(victim);
+        }
+    }
+    return id;
+}
+
+UTILS_NOINLINE
+void FScene::removePartition(Scene::PartitionId const id) noexcept {
+    auto& partitions = mPartitions;
+    auto pos = std::find_if(partitions.begin(), partitions.end(),
+            [id](Partition const& p) { return p.id == id; });
+    if (pos == partitions.end()) {
+        return;
+    }
+    // the entities stop rendering immediately...
+    removeEntities(pos->entities.data(), pos->entities.size());
+    // ...but their components are destroyed incrementally, see collectRemovedPartitions()
+    mPartitionGraveyard.insert(mPartitionGraveyard.end(),
+            pos->entities.begin(), pos->entities.end());
+    mPartitionBytes -= pos->sizeInBytes;
+    partitions.erase(pos);
+}
+
+void FScene::setPartitionBudget(size_t const budgetInBytes,
+        Invocable<void(Scene::PartitionId)>&& evictionCallback) noexcept {
+    mPartitionBudget = budgetInBytes;
+    mPartitionEvictionCallback = std::move(evictionCallback);
+}
+
+void FScene::collectRemovedPartitions() noexcept {
+    auto& graveyard = mPartitionGraveyard;
+    if (UTILS_LIKELY(graveyard.empty())) {
+        return;
+    }
+    // Destroying a whole tile's components at once would spike the frame, so we collect a
+    // bounded number per frame; the storage compaction each destroy triggers is itself
+    // budgeted by the component managers' gc.
+    constexpr size_t PARTITION_DESTROY_BUDGET = 256;
+    FRenderableManager& rcm = mEngine.getRenderableManager();
+    FLightManager& lcm = mEngine.getLightManager();
+    size_t const n = std::min(graveyard.size(), PARTITION_DESTROY_BUDGET);
+    for (size_t i = 0; i < n; i++) {
+        Entity const e = graveyard.back();
+        graveyard.pop_back();
+        rcm.destroy(e);
+        lcm.destroy(e);
+    }
+}
+
+uint32_t FScene::getContentGeneration() const noexcept {
+    FEngine& engine = mEngine;
+    return mMutationGeneration
+            + engine.getTransformManager().getGenerationCount()
+            + engine.getRenderableManager().getGenerationCount()
+            + FMaterialInstance::getRasterStateGeneration();
+}
+
 UTILS_NOINLINE
 size_t FScene::getRenderableCount() const noexcept {
     FEngine& engine = mEngine;
@@ -578,6 +684,53 @@ bool FScene::hasEntity(Entity entity) const noexcept {
 }
 
 UTILS_NOINLINE
+Entity FScene::raycast(float3 const origin, float3 const direction,
+        float const tMax) const noexcept {
+    auto const& sceneData = mRenderableData;
+    if (UTILS_UNLIKELY(mRenderableBvh.size() != sceneData.size())) {
+        // the spatial structure hasn't been refreshed for the current renderable set
+        return {};
+    }
+    ptrdiff_t const index = mRenderableBvh.raycast(origin, direction, tMax,
+            sceneData.data<WORLD_AABB_CENTER>(), sceneData.data<WORLD_AABB_EXTENT>());
+    if (index < 0) {
+        return {};
+    }
+    auto const ri = sceneData.elementAt<RENDERABLE_INSTANCE>(size_t(index));
+    return mEngine.getRenderableManager().getEntity(ri);
+}
+
+UTILS_NOINLINE
+void FScene::setEnvironment(FIndirectLight* ibl, FSkybox* skybox) noexcept {
+    // a new request replaces any swap still pending
+    if (UTILS_UNLIKELY(mPendingEnvironmentFence)) {
+        mEngine.destroy(mPendingEnvironmentFence);
+    }
+    mPendingIndirectLight = ibl;
+    mPendingSkybox = skybox;
+    // the fence signals once all GPU work submitted so far -- including the new environment's
+    // texture uploads -- has executed
+    mPendingEnvironmentFence = mEngine.createFence();
+}
+
+void FScene::commitPendingEnvironment() noexcept {
+    if (UTILS_LIKELY(!mPendingEnvironmentFence)) {
+        return;
+    }
+    // poll only; the swap simply waits another frame if the uploads are still in flight
+    FenceStatus const status = mPendingEnvironmentFence->wait(Fence::Mode::DONT_FLUSH, 0);
+    if (status != FenceStatus::TIMEOUT_EXPIRED) {
+        // on CONDITION_SATISFIED the new environment is resident; on ERROR waiting longer
+        // can't help, so flip in both cases rather than keep a stale environment forever
+        setIndirectLight(mPendingIndirectLight);
+        setSkybox(mPendingSkybox);
+        mEngine.destroy(mPendingEnvironmentFence);
+        mPendingIndirectLight = nullptr;
+        mPendingSkybox = nullptr;
+        mPendingEnvironmentFence = nullptr;
+    }
+}
+
 void FScene::setSkybox(FSkybox* skybox) noexcept {
     std::swap(mSkybox, skybox);
     if (skybox) {
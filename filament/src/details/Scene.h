@@ -21,6 +21,7 @@
 
 #include "Allocators.h"
 #include "Culler.h"
+#include "RenderableBvh.h"
 
 #include "ds/DescriptorSet.h"
 
@@ -37,6 +38,8 @@
 
 #include <utils/compiler.h>
 #include <utils/Entity.h>
+#include <utils/FixedCapacityVector.h>
+#include <utils/Invocable.h>
 #include <utils/Slice.h>
 #include <utils/StructureOfArrays.h>
 #include <utils/Range.h>
@@ -47,11 +50,13 @@
 #include <tsl/robin_set.h>
 
 #include <memory>
+#include <vector>
 
 namespace filament {
 
 struct CameraInfo;
 class FEngine;
+class FFence;
 class FIndirectLight;
 class FRenderer;
 class FSkybox;
@@ -105,7 +110,8 @@ public:
 
         // These are temporaries and should be stored out of line
         PRIMITIVES,             //   8 | level-of-detail'ed primitives
-        SUMMED_PRIMITIVE_COUNT, //   4 | summed visible primitive counts
+        PRIMITIVE_VISIBLE_MASK, //   4 | one bit per primitive, for per-primitive culling
+        SUMMED_COMMAND_COUNT,   //   4 | summed render-pass command counts (written by RenderPass)
         UBO,                    // 128 |
         DESCRIPTOR_SET_HANDLE,
 
@@ -126,7 +132,8 @@ public:
             uint8_t,                                    // LAYERS
             math::float3,                               // WORLD_AABB_EXTENT
             utils::Slice<FRenderPrimitive>,             // PRIMITIVES
-            uint32_t,                                   // SUMMED_PRIMITIVE_COUNT
+            uint32_t,                                   // PRIMITIVE_VISIBLE_MASK
+            uint32_t,                                   // SUMMED_COMMAND_COUNT
             PerRenderableData,                          // UBO
             backend::DescriptorSetHandle,               // DESCRIPTOR_SET_HANDLE
             // FIXME: We need a better way to handle this
@@ -136,16 +143,20 @@ public:
     RenderableSoa const& getRenderableData() const noexcept { return mRenderableData; }
     RenderableSoa& getRenderableData() noexcept { return mRenderableData; }
 
-    static inline uint32_t getPrimitiveCount(RenderableSoa const& soa,
+    // spatial structure over the renderables, refreshed by prepare(). Like the
+    // RenderableSoa it indexes, it is only valid during a view pass.
+    RenderableBvh const& getRenderableBvh() const noexcept { return mRenderableBvh; }
+
+    static inline uint32_t getRenderPassCommandCount(RenderableSoa const& soa,
             uint32_t first, uint32_t last) noexcept {
         // the caller must guarantee that last is dereferenceable
-        return soa.elementAt<SUMMED_PRIMITIVE_COUNT>(last) -
-                soa.elementAt<SUMMED_PRIMITIVE_COUNT>(first);
+        return soa.elementAt<SUMMED_COMMAND_COUNT>(last) -
+                soa.elementAt<SUMMED_COMMAND_COUNT>(first);
     }
 
-    static inline uint32_t getPrimitiveCount(RenderableSoa const& soa, uint32_t last) noexcept {
+    static inline uint32_t getRenderPassCommandCount(RenderableSoa const& soa, uint32_t last) noexcept {
         // the caller must guarantee that last is dereferenceable
-        return soa.elementAt<SUMMED_PRIMITIVE_COUNT>(last);
+        return soa.elementAt<SUMMED_COMMAND_COUNT>(last);
     }
 
     /*
@@ -191,27 +202,52 @@ public:
 
     bool hasContactShadows() const noexcept;
 
+    // Change signal for the retained-mode command cache: a monotonic counter that moves
+    // whenever the scene's content, any world transform, any renderable, or any material
+    // instance raster state changes. Computed as a sum of monotonic counters, so it's cheap
+    // and can only move forward.
+    uint32_t getContentGeneration() const noexcept;
+
 private:
     friend class Scene;
     void setSkybox(FSkybox* skybox) noexcept;
     void setIndirectLight(FIndirectLight* ibl) noexcept { mIndirectLight = ibl; }
+    void setEnvironment(FIndirectLight* ibl, FSkybox* skybox) noexcept;
+    void commitPendingEnvironment() noexcept;
     void addEntity(utils::Entity entity);
     void addEntities(const utils::Entity* entities, size_t count);
     void remove(utils::Entity entity);
     void removeEntities(const utils::Entity* entities, size_t count);
+    Scene::PartitionId addPartition(const utils::Entity* entities, size_t count,
+            size_t sizeInBytes);
+    void removePartition(Scene::PartitionId id) noexcept;
+    void setPartitionBudget(size_t budgetInBytes,
+            utils::Invocable<void(Scene::PartitionId)>&& evictionCallback) noexcept;
+    size_t getPartitionMemoryUsage() const noexcept { return mPartitionBytes; }
     size_t getEntityCount() const noexcept { return mEntities.size(); }
     size_t getRenderableCount() const noexcept;
     size_t getLightCount() const noexcept;
     bool hasEntity(utils::Entity entity) const noexcept;
     void forEach(utils::Invocable<void(utils::Entity)>&& functor) const noexcept;
+    utils::Entity raycast(math::float3 origin, math::float3 direction,
+            float tMax) const noexcept;
 
     static inline void computeLightRanges(math::float2* zrange,
             CameraInfo const& camera, const math::float4* spheres, size_t count) noexcept;
 
+    // destroys components of removed partitions, a bounded number per frame, see prepare()
+    void collectRemovedPartitions() noexcept;
+
     FEngine& mEngine;
     FSkybox* mSkybox = nullptr;
     FIndirectLight* mIndirectLight = nullptr;
 
+    // Pending environment swap, see setEnvironment(). The fence tracks the GPU work issued
+    // before the request; the flip happens in prepare() once it has signaled.
+    FSkybox* mPendingSkybox = nullptr;
+    FIndirectLight* mPendingIndirectLight = nullptr;
+    FFence* mPendingEnvironmentFence = nullptr;
+
     /*
      * list of Entities in the scene. We use a robin_set<> so we can do efficient removes
      * (a vector<> could work, but removes would be O(n)). robin_set<> iterates almost as
@@ -219,6 +255,27 @@ private:
      */
     tsl::robin_set<utils::Entity, utils::Entity::Hasher> mEntities;
 
+    // bumped when entities are added or removed, see getContentGeneration()
+    uint32_t mMutationGeneration = 0;
+
+    /*
+     * Streaming partitions, see Scene::addPartition(). mPartitions holds the resident
+     * partitions oldest-first, which is the eviction order. Components of removed
+     * partitions are parked in mPartitionGraveyard and destroyed a bounded number per
+     * frame by collectRemovedPartitions().
+     */
+    struct Partition {
+        Scene::PartitionId id;
+        size_t sizeInBytes;
+        utils::FixedCapacityVector<utils::Entity> entities;
+    };
+    std::vector<Partition> mPartitions;
+    std::vector<utils::Entity> mPartitionGraveyard;
+    utils::Invocable<void(Scene::PartitionId)> mPartitionEvictionCallback;
+    size_t mPartitionBudget = 0;
+    size_t mPartitionBytes = 0;
+    Scene::PartitionId mNextPartitionId = Scene::INVALID_PARTITION + 1;
+
 
     /*
      * The data below is valid only during a view pass. i.e. if a scene is used in multiple
@@ -227,6 +284,7 @@ private:
      * we store it here.
      */
     RenderableSoa mRenderableData;
+    RenderableBvh mRenderableBvh;
     LightSoa mLightData;
     bool mHasContactShadows = false;
 
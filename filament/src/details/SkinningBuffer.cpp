@@ -26,6 +26,7 @@
 #include <math/mat4.h>
 
 #include <utils/CString.h>
+#include <utils/JobSystem.h>
 
 #include <string.h>
 #include <stddef.h>
@@ -121,6 +122,71 @@ void FSkinningBuffer::setBones(FEngine& engine,
     setBones(engine, mHandle, transforms, count, offset);
 }
 
+void FSkinningBuffer::updateBones(FEngine&,
+        RenderableManager::Bone const* transforms, size_t count, size_t offset) {
+    FILAMENT_CHECK_PRECONDITION((offset + count) <= mBoneCount)
+            << "SkinningBuffer (size=" << (unsigned)mBoneCount
+            << ") overflow (boneCount=" << (unsigned)count << ", offset=" << (unsigned)offset
+            << ")";
+
+    if (UTILS_UNLIKELY(mShadow.empty())) {
+        mShadow = utils::FixedCapacityVector<PerRenderableBoneUib::BoneData>(
+                mBoneCount, makeBone({}));
+    }
+
+    // staged updates are expected to be small, the conversion is done inline
+    for (size_t i = 0; i < count; i++) {
+        // the transform is stored in row-major, last row is not stored.
+        mat4f transform(transforms[i].unitQuaternion);
+        transform[3] = float4{ transforms[i].translation, 1.0f };
+        mShadow[offset + i] = makeBone(transform);
+    }
+    // clear first: RangeMap::add() can leave two overlapping ranges when the new range
+    // bridges into an existing one, which would cost an extra upload at commit()
+    mDirtyRanges.clear(uint32_t(offset), uint32_t(offset + count));
+    mDirtyRanges.add(uint32_t(offset), uint32_t(offset + count), true);
+}
+
+void FSkinningBuffer::updateBones(FEngine&,
+        mat4f const* transforms, size_t count, size_t offset) {
+    FILAMENT_CHECK_PRECONDITION((offset + count) <= mBoneCount)
+            << "SkinningBuffer (size=" << (unsigned)mBoneCount
+            << ") overflow (boneCount=" << (unsigned)count << ", offset=" << (unsigned)offset
+            << ")";
+
+    if (UTILS_UNLIKELY(mShadow.empty())) {
+        mShadow = utils::FixedCapacityVector<PerRenderableBoneUib::BoneData>(
+                mBoneCount, makeBone({}));
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        mShadow[offset + i] = makeBone(transforms[i]);
+    }
+    // clear first: RangeMap::add() can leave two overlapping ranges when the new range
+    // bridges into an existing one, which would cost an extra upload at commit()
+    mDirtyRanges.clear(uint32_t(offset), uint32_t(offset + count));
+    mDirtyRanges.add(uint32_t(offset), uint32_t(offset + count), true);
+}
+
+void FSkinningBuffer::commit(FEngine& engine) noexcept {
+    if (mDirtyRanges.rangeCount() == 0) {
+        return;
+    }
+    // adjacent and overlapping staged ranges have already been coalesced by the RangeMap,
+    // so this issues the minimal number of buffer updates
+    auto& driverApi = engine.getDriverApi();
+    mDirtyRanges.forEachRange([&](utils::Range<uint32_t> const& range, bool) {
+        size_t const count = range.last - range.first;
+        auto* const out = driverApi.allocatePod<PerRenderableBoneUib::BoneData>(count);
+        memcpy(out, mShadow.data() + range.first,
+                count * sizeof(PerRenderableBoneUib::BoneData));
+        driverApi.updateBufferObject(mHandle, {
+                        out, count * sizeof(PerRenderableBoneUib::BoneData) },
+                range.first * sizeof(PerRenderableBoneUib::BoneData));
+    });
+    mDirtyRanges.clear(0, mBoneCount);
+}
+
 UTILS_UNUSED
 static uint32_t packHalf2x16(half2 v) noexcept {
     uint32_t lo = getBits(v[0]);
@@ -128,16 +194,35 @@ static uint32_t packHalf2x16(half2 v) noexcept {
     return (hi << 16) | lo;
 }
 
+// Below this count, the per-bone conversion (quaternion to matrix, cofactors, transpose) is
+// cheaper than the JobSystem dispatch overhead.
+constexpr size_t JOBS_PARALLEL_FOR_BONES_COUNT = 512;
+
 void FSkinningBuffer::setBones(FEngine& engine, Handle<backend::HwBufferObject> handle,
         RenderableManager::Bone const* transforms, size_t boneCount, size_t offset) noexcept {
     auto& driverApi = engine.getDriverApi();
     auto* UTILS_RESTRICT out = driverApi.allocatePod<PerRenderableBoneUib::BoneData>(boneCount);
-    for (size_t i = 0, c = boneCount; i < c; ++i) {
-        // the transform is stored in row-major, last row is not stored.
-        mat4f transform(transforms[i].unitQuaternion);
-        transform[3] = float4{ transforms[i].translation, 1.0f };
-        out[i] = makeBone(transform);
+
+    auto work = [out, base = transforms](RenderableManager::Bone const* first, size_t count) {
+        size_t const index = first - base;
+        for (size_t i = index, e = index + count; i < e; ++i) {
+            // the transform is stored in row-major, last row is not stored.
+            mat4f transform(base[i].unitQuaternion);
+            transform[3] = float4{ base[i].translation, 1.0f };
+            out[i] = makeBone(transform);
+        }
+    };
+
+    // Large palettes (e.g. crowds sharing one SkinningBuffer) are converted on JobSystem workers.
+    if (boneCount <= JOBS_PARALLEL_FOR_BONES_COUNT) {
+        work(transforms, boneCount);
+    } else {
+        utils::JobSystem& js = engine.getJobSystem();
+        auto* job = utils::jobs::parallel_for(js, nullptr, transforms, boneCount,
+                std::cref(work), utils::jobs::CountSplitter<JOBS_PARALLEL_FOR_BONES_COUNT>());
+        js.runAndWait(job);
     }
+
     driverApi.updateBufferObject(handle, {
                     out, boneCount * sizeof(PerRenderableBoneUib::BoneData) },
             offset * sizeof(PerRenderableBoneUib::BoneData));
@@ -161,10 +246,25 @@ void FSkinningBuffer::setBones(FEngine& engine, Handle<backend::HwBufferObject>
         mat4f const* transforms, size_t boneCount, size_t offset) noexcept {
     auto& driverApi = engine.getDriverApi();
     auto* UTILS_RESTRICT out = driverApi.allocatePod<PerRenderableBoneUib::BoneData>(boneCount);
-    for (size_t i = 0, c = boneCount; i < c; ++i) {
-        // the transform is stored in row-major, last row is not stored.
-        out[i] = makeBone(transforms[i]);
+
+    auto work = [out, base = transforms](mat4f const* first, size_t count) {
+        size_t const index = first - base;
+        for (size_t i = index, e = index + count; i < e; ++i) {
+            // the transform is stored in row-major, last row is not stored.
+            out[i] = makeBone(base[i]);
+        }
+    };
+
+    // Large palettes (e.g. crowds sharing one SkinningBuffer) are converted on JobSystem workers.
+    if (boneCount <= JOBS_PARALLEL_FOR_BONES_COUNT) {
+        work(transforms, boneCount);
+    } else {
+        utils::JobSystem& js = engine.getJobSystem();
+        auto* job = utils::jobs::parallel_for(js, nullptr, transforms, boneCount,
+                std::cref(work), utils::jobs::CountSplitter<JOBS_PARALLEL_FOR_BONES_COUNT>());
+        js.runAndWait(job);
     }
+
     driverApi.updateBufferObject(handle, { out, boneCount * sizeof(PerRenderableBoneUib::BoneData) },
             offset * sizeof(PerRenderableBoneUib::BoneData));
 }
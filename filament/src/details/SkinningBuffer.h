@@ -28,6 +28,7 @@
 #include <backend/Handle.h>
 
 #include <utils/FixedCapacityVector.h>
+#include <utils/RangeMap.h>
 
 #include <math/mat4.h>
 #include <math/vec2.h>
@@ -52,6 +53,13 @@ public:
 
     void setBones(FEngine& engine, RenderableManager::Bone const* transforms, size_t count, size_t offset);
     void setBones(FEngine& engine, math::mat4f const* transforms, size_t count, size_t offset);
+
+    // sparse update path: stages into a CPU shadow copy and tracks dirty ranges, commit()
+    // uploads one buffer update per coalesced range
+    void updateBones(FEngine& engine, RenderableManager::Bone const* transforms, size_t count, size_t offset);
+    void updateBones(FEngine& engine, math::mat4f const* transforms, size_t count, size_t offset);
+    void commit(FEngine& engine) noexcept;
+
     size_t getBoneCount() const noexcept { return mBoneCount; }
 
     // round count to the size of the UBO in the shader
@@ -86,6 +94,10 @@ private:
 
     backend::Handle<backend::HwBufferObject> mHandle;
     uint32_t mBoneCount;
+
+    // CPU shadow of the palette for the sparse update path, allocated on first use
+    utils::FixedCapacityVector<PerRenderableBoneUib::BoneData> mShadow;
+    utils::RangeMap<uint32_t, bool> mDirtyRanges;
 };
 
 FILAMENT_DOWNCAST(SkinningBuffer)
@@ -69,6 +69,11 @@ public:
         return (mConfigFlags & CONFIG_PROTECTED_CONTENT) != 0;
     }
 
+    // the frame-latency policy encoded in the flags, 0 if unset
+    size_t getFrameLatency() const noexcept {
+        return backend::getSwapChainConfigFrameLatency(mConfigFlags);
+    }
+
     // This returns the effective flags. Unsupported flags are cleared automatically.
     uint64_t getFlags() const noexcept {
         return mConfigFlags;
@@ -255,6 +255,19 @@ FTexture::FTexture(FEngine& engine, const Builder& builder) {
     if (UTILS_LIKELY(!isImported)) {
         mHandle = driver.createTexture(
                 mTarget, mLevelCount, mFormat, mSampleCount, mWidth, mHeight, mDepth, mUsage);
+        // estimated GPU footprint, same heuristic as ResourceAllocator::TextureKey::getSize()
+        size_t const faces = (mTarget == SamplerType::SAMPLER_CUBEMAP ||
+                mTarget == SamplerType::SAMPLER_CUBEMAP_ARRAY) ? 6 : 1;
+        size_t size = size_t(mWidth) * mHeight * mDepth * faces * getFormatSize(mFormat);
+        if (mSampleCount > 1) {
+            size *= mSampleCount;
+        }
+        if (mLevelCount > 1) {
+            // if we have mip-maps we assume the full pyramid
+            size += size / 3;
+        }
+        mTrackedMemory = size;
+        engine.getMemoryTracker().track(Engine::MemoryCategory::TEXTURE, size);
     } else {
         mHandle = driver.importTexture(builder->mImportedId,
                 mTarget, mLevelCount, mFormat, mSampleCount, mWidth, mHeight, mDepth, mUsage);
@@ -278,6 +291,11 @@ FTexture::FTexture(FEngine& engine, const Builder& builder) {
 
 // frees driver resources, object becomes invalid
 void FTexture::terminate(FEngine& engine) {
+    engine.cancelDeferredUploads(this);
+    if (mTrackedMemory) {
+        engine.getMemoryTracker().release(Engine::MemoryCategory::TEXTURE, mTrackedMemory);
+        mTrackedMemory = 0;
+    }
     setHandles({});
 }
 
@@ -377,13 +395,151 @@ void FTexture::setImage(FEngine& engine, size_t level,
             << unsigned(xoffset) << "," << unsigned(yoffset) << "," << unsigned(zoffset) << "},{"
             << unsigned(width) << "," << unsigned(height) << "," << unsigned(depth) << ")}}";
 
+    // account this upload against the engine's staging budget; the bytes are released on
+    // the backend thread once the upload command has been consumed
+    size_t const uploadSize = p.size;
+    engine.reserveUploadBytes(uploadSize);
+
     engine.getDriverApi().update3DImage(mHandle,
             uint8_t(level), xoffset, yoffset, zoffset, width, height, depth, std::move(p));
 
+    engine.getDriverApi().queueCommand([&engine, uploadSize]() {
+        engine.releaseUploadBytes(uploadSize);
+    });
+
     // this method shouldn't have been const
     const_cast<FTexture*>(this)->updateLodRange(level);
 }
 
+void FTexture::setImages(FEngine& engine, ImageRegion const* regions, size_t count,
+        FTexture::PixelBufferDescriptor&& p, uint8_t const priority) const {
+
+    FILAMENT_CHECK_PRECONDITION(regions && count > 0) << "No regions to update.";
+
+    FILAMENT_CHECK_PRECONDITION(p.type != PixelDataType::COMPRESSED)
+            << "Compressed pixel data is not supported by setImages(), use setImage().";
+
+    // this should have been validated already
+    assert_invariant(isTextureFormatSupported(engine, mFormat));
+
+    FILAMENT_CHECK_PRECONDITION(validatePixelFormatAndType(mFormat, p.format, p.type))
+            << "The combination of internal format=" << unsigned(mFormat)
+            << " and {format=" << unsigned(p.format) << ", type=" << unsigned(p.type)
+            << "} is not supported.";
+
+    FILAMENT_CHECK_PRECONDITION(!mStream) << "setImages() called on a Stream texture.";
+
+    FILAMENT_CHECK_PRECONDITION(mTarget != SamplerType::SAMPLER_EXTERNAL)
+            << "Texture SamplerType::SAMPLER_EXTERNAL not supported for this operation.";
+
+    FILAMENT_CHECK_PRECONDITION(mSampleCount <= 1) << "Operation not supported with multisample ("
+                                                   << unsigned(mSampleCount) << ") texture.";
+
+    FILAMENT_CHECK_PRECONDITION(p.buffer) << "Data buffer is nullptr.";
+
+    FILAMENT_CHECK_PRECONDITION(p.stride == 0)
+            << "Regions of a batched update must be tightly packed (stride must be 0).";
+
+    using PBD = PixelBufferDescriptor;
+    for (size_t i = 0; i < count; i++) {
+        ImageRegion const& r = regions[i];
+
+        FILAMENT_CHECK_PRECONDITION(r.level < mLevelCount)
+                << "region " << i << ": level=" << unsigned(r.level)
+                << " is >= to levelCount=" << unsigned(mLevelCount) << ".";
+
+        FILAMENT_CHECK_PRECONDITION(r.xoffset + r.width <= valueForLevel(r.level, mWidth))
+                << "region " << i << ": xoffset (" << unsigned(r.xoffset) << ") + width ("
+                << unsigned(r.width) << ") > texture width ("
+                << valueForLevel(r.level, mWidth) << ") at level (" << unsigned(r.level) << ")";
+
+        FILAMENT_CHECK_PRECONDITION(r.yoffset + r.height <= valueForLevel(r.level, mHeight))
+                << "region " << i << ": yoffset (" << unsigned(r.yoffset) << ") + height ("
+                << unsigned(r.height) << ") > texture height ("
+                << valueForLevel(r.level, mHeight) << ") at level (" << unsigned(r.level) << ")";
+
+        uint32_t effectiveTextureDepthOrLayers;
+        switch (mTarget) {
+            case SamplerType::SAMPLER_EXTERNAL:
+                // can't happen by construction, fallthrough...
+            case SamplerType::SAMPLER_2D:
+                assert_invariant(mDepth == 1);
+                effectiveTextureDepthOrLayers = 1;
+                break;
+            case SamplerType::SAMPLER_3D:
+                effectiveTextureDepthOrLayers = valueForLevel(r.level, mDepth);
+                break;
+            case SamplerType::SAMPLER_2D_ARRAY:
+                effectiveTextureDepthOrLayers = mDepth;
+                break;
+            case SamplerType::SAMPLER_CUBEMAP:
+                effectiveTextureDepthOrLayers = 6;
+                break;
+            case SamplerType::SAMPLER_CUBEMAP_ARRAY:
+                effectiveTextureDepthOrLayers = mDepth * 6;
+                break;
+        }
+
+        FILAMENT_CHECK_PRECONDITION(r.zoffset + r.depth <= effectiveTextureDepthOrLayers)
+                << "region " << i << ": zoffset (" << unsigned(r.zoffset) << ") + depth ("
+                << unsigned(r.depth) << ") > texture depth (" << effectiveTextureDepthOrLayers
+                << ") at level (" << unsigned(r.level) << ")";
+
+        size_t const size =
+                PBD::computeDataSize(p.format, p.type, r.width, r.height, p.alignment) * r.depth;
+        FILAMENT_CHECK_PRECONDITION(r.bufferOffset + size <= p.size)
+                << "buffer overflow: region " << i << " at bufferOffset ("
+                << unsigned(r.bufferOffset) << ") needs " << size
+                << " bytes, buffer holds " << size_t(p.size) << " bytes";
+    }
+
+    // the regions are copied, the caller's array need not outlive the call
+    utils::FixedCapacityVector<ImageRegion> regionsCopy(count);
+    std::copy_n(regions, count, regionsCopy.data());
+
+    if (UTILS_UNLIKELY(engine.isStagingBudgetExceeded() || engine.hasDeferredUploads())) {
+        // Over the staging budget (or behind batches already queued, which must go first):
+        // queue the batch engine-side instead of growing the backend's staging memory. It
+        // is submitted by FEngine::flushDeferredUploads() once the budget frees up.
+        engine.enqueueDeferredUpload(this, std::move(regionsCopy), std::move(p), priority);
+    } else {
+        submitImageBatch(engine, regionsCopy, std::move(p));
+    }
+
+    // this method shouldn't have been const
+    for (size_t i = 0; i < count; i++) {
+        const_cast<FTexture*>(this)->updateLodRange(regions[i].level);
+    }
+}
+
+void FTexture::submitImageBatch(FEngine& engine,
+        utils::FixedCapacityVector<ImageRegion> const& regions,
+        FTexture::PixelBufferDescriptor&& p) const {
+    size_t const count = regions.size();
+
+    // the command stream owns a copy of the region array
+    auto* const regionsCopy = new ImageRegion[count];
+    std::copy_n(regions.data(), count, regionsCopy);
+
+    // account this upload against the engine's staging budget
+    size_t const uploadSize = p.size;
+    engine.reserveUploadBytes(uploadSize);
+
+    FEngine::DriverApi& driver = engine.getDriverApi();
+    driver.update3DImageBatch(mHandle, uint32_t(count),
+            { regionsCopy, count * sizeof(ImageRegion),
+                    [](void* buffer, size_t, void*) {
+                        delete [] static_cast<ImageRegion*>(buffer);
+                    } },
+            std::move(p));
+
+    // executes on the backend thread right after the upload has been consumed into
+    // staging memory, releasing the budgeted bytes
+    driver.queueCommand([&engine, uploadSize]() {
+        engine.releaseUploadBytes(uploadSize);
+    });
+}
+
 // deprecated
 void FTexture::setImage(FEngine& engine, size_t level,
         Texture::PixelBufferDescriptor&& buffer, const FaceOffsets& faceOffsets) const {
@@ -622,6 +778,32 @@ void FTexture::updateLodRange(uint8_t level) noexcept {
     updateLodRange(level, 1);
 }
 
+uint32_t FTexture::getUnusedFrameCount(FEngine& engine) const noexcept {
+    return mLastUsedFrame ? engine.getFrameCounter() - mLastUsedFrame : UINT32_MAX;
+}
+
+void FTexture::updateDesiredMipLevel(uint32_t frameCounter,
+        float log2RequiredPixels) const noexcept {
+    // the mip level at which this texture's resolution matches the on-screen footprint
+    float const log2Size = std::log2(float(std::max(mWidth, mHeight)));
+    float const level = std::max(0.0f, log2Size - log2RequiredPixels);
+    if (mDesiredMipFrame != frameCounter) {
+        mDesiredMipFrame = frameCounter;
+        mDesiredMipLevel = level;
+    } else {
+        // several renderables can sample this texture, keep the most demanding one
+        mDesiredMipLevel = std::min(mDesiredMipLevel, level);
+    }
+}
+
+float FTexture::getDesiredMipLevel(FEngine& engine) const noexcept {
+    // only report feedback from the current or previous frame
+    if (mDesiredMipFrame == 0 || engine.getFrameCounter() - mDesiredMipFrame > 1) {
+        return -1.0f;
+    }
+    return mDesiredMipLevel;
+}
+
 bool FTexture::isTextureFormatSupported(FEngine& engine, InternalFormat format) noexcept {
     return engine.getDriverApi().isTextureFormatSupported(format);
 }
@@ -58,6 +58,15 @@ public:
             uint32_t width, uint32_t height, uint32_t depth,
             PixelBufferDescriptor&& buffer) const;
 
+    void setImages(FEngine& engine, ImageRegion const* regions, size_t count,
+            PixelBufferDescriptor&& buffer, uint8_t priority) const;
+
+    // Submits a validated batch to the driver, accounting its bytes against the engine's
+    // staging budget. Also used by FEngine::flushDeferredUploads().
+    void submitImageBatch(FEngine& engine,
+            utils::FixedCapacityVector<ImageRegion> const& regions,
+            PixelBufferDescriptor&& buffer) const;
+
     UTILS_DEPRECATED
     void setImage(FEngine& engine, size_t level,
             PixelBufferDescriptor&& buffer, const FaceOffsets& faceOffsets) const;
@@ -123,6 +132,16 @@ public:
     bool textureHandleCanMutate() const noexcept;
     void updateLodRange(uint8_t level) noexcept;
 
+    // residency tracking: stamped with the engine's frame counter whenever this texture is
+    // bound for sampling by a render pass
+    void markUsedInFrame(uint32_t frameCounter) const noexcept { mLastUsedFrame = frameCounter; }
+    uint32_t getUnusedFrameCount(FEngine& engine) const noexcept;
+
+    // streaming feedback: desired mip level for the current frame, folded (min) over all
+    // visible renderables that sample this texture, see FView::updateStreamingFeedback()
+    void updateDesiredMipLevel(uint32_t frameCounter, float log2RequiredPixels) const noexcept;
+    float getDesiredMipLevel(FEngine& engine) const noexcept;
+
     // TODO: remove in a future filament release.  See below for description.
     inline bool hasBlitSrcUsage() const noexcept {
         return mHasBlitSrc;
@@ -154,6 +173,10 @@ private:
     backend::DriverApi* mDriver = nullptr; // this is only needed for getHwHandleForSampling()
     LodRange mLodRange{};
     mutable LodRange mActiveLodRange{};
+    mutable uint32_t mLastUsedFrame = 0; // 0 means never used, the counter starts at 1
+    mutable uint32_t mDesiredMipFrame = 0; // frame of the last streaming-feedback update
+    mutable float mDesiredMipLevel = 0.0f;
+    uint64_t mTrackedMemory = 0; // estimated GPU footprint accounted in GpuMemoryTracker
 
     uint32_t mWidth = 1;
     uint32_t mHeight = 1;
@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "details/TextureAtlas.h"
+
+#include "details/Engine.h"
+#include "details/Texture.h"
+
+#include "FilamentAPI-impl.h"
+
+#include <filament/Texture.h>
+
+#include <utils/algorithm.h>
+#include <utils/debug.h>
+#include <utils/Panic.h>
+
+#include <utility>
+
+#include <stdint.h>
+
+namespace filament {
+
+struct TextureAtlas::BuilderDetails {
+    Texture::InternalFormat mFormat = Texture::InternalFormat::RGBA8;
+    uint32_t mSize = 1024;
+    uint8_t mLayerCount = 1;
+};
+
+using BuilderType = TextureAtlas;
+BuilderType::Builder::Builder() noexcept = default;
+BuilderType::Builder::~Builder() noexcept = default;
+BuilderType::Builder::Builder(BuilderType::Builder const& rhs) noexcept = default;
+BuilderType::Builder::Builder(BuilderType::Builder&& rhs) noexcept = default;
+BuilderType::Builder& BuilderType::Builder::operator=(BuilderType::Builder const& rhs) noexcept = default;
+BuilderType::Builder& BuilderType::Builder::operator=(BuilderType::Builder&& rhs) noexcept = default;
+
+TextureAtlas::Builder& TextureAtlas::Builder::size(uint32_t size) noexcept {
+    mImpl->mSize = size;
+    return *this;
+}
+
+TextureAtlas::Builder& TextureAtlas::Builder::layerCount(uint8_t count) noexcept {
+    mImpl->mLayerCount = count;
+    return *this;
+}
+
+TextureAtlas::Builder& TextureAtlas::Builder::format(Texture::InternalFormat format) noexcept {
+    mImpl->mFormat = format;
+    return *this;
+}
+
+TextureAtlas* TextureAtlas::Builder::build(Engine& engine) {
+    FILAMENT_CHECK_PRECONDITION(utils::popcount(mImpl->mSize) == 1)
+            << "Atlas size " << mImpl->mSize << " is not a power of two.";
+
+    FILAMENT_CHECK_PRECONDITION(mImpl->mLayerCount >= 1 && mImpl->mLayerCount <= 64)
+            << "Atlas layer count " << unsigned(mImpl->mLayerCount) << " is not in [1, 64].";
+
+    return downcast(engine).createTextureAtlas(*this);
+}
+
+// ------------------------------------------------------------------------------------------------
+
+FTextureAtlas::FTextureAtlas(FEngine& engine, const Builder& builder)
+        : mAllocator(builder->mSize),
+          mSize(builder->mSize),
+          mLayerCount(builder->mLayerCount) {
+    mTexture = engine.createTexture(Texture::Builder()
+            .width(builder->mSize)
+            .height(builder->mSize)
+            .depth(builder->mLayerCount)
+            .levels(1)
+            .sampler(Texture::Sampler::SAMPLER_2D_ARRAY)
+            .format(builder->mFormat));
+}
+
+void FTextureAtlas::terminate(FEngine& engine) {
+    engine.destroy(mTexture);
+    mTexture = nullptr;
+}
+
+TextureAtlas::Entry FTextureAtlas::allocate(uint32_t size) noexcept {
+    AtlasAllocator::Allocation const allocation = mAllocator.allocate(size);
+    if (UTILS_UNLIKELY(allocation.layer >= int32_t(mLayerCount))) {
+        // the allocator placed us past the layers the backing texture actually has
+        mAllocator.free(allocation);
+        return {};
+    }
+    return { allocation.layer, allocation.viewport };
+}
+
+void FTextureAtlas::free(Entry const& entry) noexcept {
+    if (entry.isValid()) {
+        mAllocator.free({ entry.layer, entry.region });
+    }
+}
+
+void FTextureAtlas::setImage(FEngine& engine,
+        Entry const& entry, PixelBufferDescriptor&& buffer) const {
+    assert_invariant(entry.isValid());
+    mTexture->setImage(engine, 0,
+            uint32_t(entry.region.left), uint32_t(entry.region.bottom), uint32_t(entry.layer),
+            entry.region.width, entry.region.height, 1, std::move(buffer));
+}
+
+math::float4 FTextureAtlas::getUvTransform(Entry const& entry) const noexcept {
+    float const s = 1.0f / float(mSize);
+    return { float(entry.region.width) * s, float(entry.region.height) * s,
+             float(entry.region.left) * s, float(entry.region.bottom) * s };
+}
+
+} // namespace filament
@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_FILAMENT_DETAILS_TEXTUREATLAS_H
+#define TNT_FILAMENT_DETAILS_TEXTUREATLAS_H
+
+#include "downcast.h"
+
+#include "AtlasAllocator.h"
+
+#include <filament/TextureAtlas.h>
+
+#include <math/vec4.h>
+
+#include <stdint.h>
+
+namespace filament {
+
+class FEngine;
+class FTexture;
+
+class FTextureAtlas : public TextureAtlas {
+public:
+    FTextureAtlas(FEngine& engine, const Builder& builder);
+
+    // frees driver resources, object becomes invalid
+    void terminate(FEngine& engine);
+
+    Entry allocate(uint32_t size) noexcept;
+
+    void free(Entry const& entry) noexcept;
+
+    void setImage(FEngine& engine, Entry const& entry, PixelBufferDescriptor&& buffer) const;
+
+    FTexture* getTexture() const noexcept { return mTexture; }
+
+    math::float4 getUvTransform(Entry const& entry) const noexcept;
+
+private:
+    AtlasAllocator mAllocator;
+    FTexture* mTexture = nullptr;
+    uint32_t mSize = 0;
+    uint8_t mLayerCount = 1;
+};
+
+FILAMENT_DOWNCAST(TextureAtlas)
+
+} // namespace filament
+
+#endif // TNT_FILAMENT_DETAILS_TEXTUREATLAS_H
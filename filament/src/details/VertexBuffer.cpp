@@ -43,6 +43,8 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 
 namespace filament {
 
@@ -62,6 +64,8 @@ struct VertexBuffer::BuilderDetails {
     uint8_t mBufferCount = 0;
     bool mBufferObjectsEnabled = false;
     bool mAdvancedSkinningEnabled = false; // TODO: use bits to save memory
+    bool mPositionStreamSplitEnabled = false;
+    bool mStreamingEnabled = false;
 };
 
 using BuilderType = VertexBuffer;
@@ -148,6 +152,16 @@ VertexBuffer::Builder& VertexBuffer::Builder::advancedSkinning(bool enabled) noe
     return *this;
 }
 
+VertexBuffer::Builder& VertexBuffer::Builder::splitPositionStream(bool enabled) noexcept {
+    mImpl->mPositionStreamSplitEnabled = enabled;
+    return *this;
+}
+
+VertexBuffer::Builder& VertexBuffer::Builder::streaming(bool enabled) noexcept {
+    mImpl->mStreamingEnabled = enabled;
+    return *this;
+}
+
 VertexBuffer* VertexBuffer::Builder::build(Engine& engine) {
     FILAMENT_CHECK_PRECONDITION(mImpl->mVertexCount > 0) << "vertexCount cannot be 0";
     FILAMENT_CHECK_PRECONDITION(mImpl->mBufferCount > 0) << "bufferCount cannot be 0";
@@ -189,6 +203,21 @@ VertexBuffer* VertexBuffer::Builder::build(Engine& engine) {
     FILAMENT_CHECK_PRECONDITION(attributedBuffers.count() == mImpl->mBufferCount)
             << "At least one buffer slot was never assigned to an attribute.";
 
+    if (mImpl->mPositionStreamSplitEnabled) {
+        FILAMENT_CHECK_PRECONDITION(!mImpl->mBufferObjectsEnabled)
+                << "splitPositionStream() is not compatible with enableBufferObjects()";
+        FILAMENT_CHECK_PRECONDITION(mImpl->mDeclaredAttributes[VertexAttribute::POSITION])
+                << "splitPositionStream() requires a POSITION attribute";
+        FILAMENT_CHECK_PRECONDITION(mImpl->mBufferCount <
+                MAX_VERTEX_BUFFER_COUNT - (mImpl->mAdvancedSkinningEnabled ? 2 : 0))
+                << "Vertex buffer uses too many buffers (" << mImpl->mBufferCount << ")";
+    }
+
+    if (mImpl->mStreamingEnabled) {
+        FILAMENT_CHECK_PRECONDITION(!mImpl->mBufferObjectsEnabled)
+                << "streaming() is not compatible with enableBufferObjects()";
+    }
+
     if (mImpl->mAdvancedSkinningEnabled) {
         FILAMENT_CHECK_PRECONDITION(!mImpl->mDeclaredAttributes[VertexAttribute::BONE_INDICES])
                 << "Vertex buffer attribute BONE_INDICES is already defined, "
@@ -208,7 +237,9 @@ VertexBuffer* VertexBuffer::Builder::build(Engine& engine) {
 FVertexBuffer::FVertexBuffer(FEngine& engine, const VertexBuffer::Builder& builder)
         : mVertexCount(builder->mVertexCount), mBufferCount(builder->mBufferCount),
           mBufferObjectsEnabled(builder->mBufferObjectsEnabled),
-          mAdvancedSkinningEnabled(builder->mAdvancedSkinningEnabled){
+          mAdvancedSkinningEnabled(builder->mAdvancedSkinningEnabled),
+          mPositionStreamSplitEnabled(builder->mPositionStreamSplitEnabled),
+          mStreamingEnabled(builder->mStreamingEnabled) {
     std::copy(std::begin(builder->mAttributes), std::end(builder->mAttributes), mAttributes.begin());
     mDeclaredAttributes = builder->mDeclaredAttributes;
 
@@ -254,6 +285,18 @@ FVertexBuffer::FVertexBuffer(FEngine& engine, const VertexBuffer::Builder& build
         mAttributes[BONE_INDICES].flags |= Attribute::FLAG_INTEGER_TARGET;
     }
 
+    if (mPositionStreamSplitEnabled) {
+        // Relocate POSITION into its own tightly packed stream, so that depth-only renderings
+        // don't pay the fetch bandwidth of the full interleaved vertex. The data is copied
+        // into that stream as part of setBufferAt().
+        auto& position = mAttributes[VertexAttribute::POSITION];
+        mPositionSource = position; // remember where the application provides the data
+        position.buffer = mBufferCount;
+        position.offset = 0;
+        position.stride = uint8_t(Driver::getElementTypeSize(position.type));
+        mBufferCount++;
+    }
+
     FEngine::DriverApi& driver = engine.getDriverApi();
 
     mVertexBufferInfoHandle = engine.getVertexBufferInfoFactory().create(driver,
@@ -280,6 +323,17 @@ FVertexBuffer::FVertexBuffer(FEngine& engine, const VertexBuffer::Builder& build
         }
     }
 
+    if (mPositionStreamSplitEnabled) {
+        // the application still uploads its buffer unchanged in setBufferAt(), so the source
+        // slot keeps its original size even if position was its only attribute
+        bufferSizes[mPositionSource.buffer] = std::max(bufferSizes[mPositionSource.buffer],
+                size_t(mPositionSource.offset) + size_t(mVertexCount) * mPositionSource.stride);
+    }
+
+    // streamed buffers are rewritten every frame
+    auto const internalBufferUsage = mStreamingEnabled ?
+            backend::BufferUsage::DYNAMIC : backend::BufferUsage::STATIC;
+
     if (!mBufferObjectsEnabled) {
         // If buffer objects are not enabled at the API level, then we create them internally.
         #pragma nounroll
@@ -289,15 +343,29 @@ FVertexBuffer::FVertexBuffer(FEngine& engine, const VertexBuffer::Builder& build
                 assert_invariant(bufferSizes[i] > 0);
                 if (!mBufferObjects[i]) {
                     BufferObjectHandle bo = driver.createBufferObject(bufferSizes[i],
-                            backend::BufferObjectBinding::VERTEX, backend::BufferUsage::STATIC);
+                            backend::BufferObjectBinding::VERTEX, internalBufferUsage);
                     if (auto name = builder.getName(); !name.empty()) {
                         driver.setDebugTag(bo.getId(), name);
                     }
                     driver.setVertexBufferObject(mHandle, i, bo);
                     mBufferObjects[i] = bo;
+                    mTrackedMemory += bufferSizes[i];
                 }
             }
         }
+        if (mPositionStreamSplitEnabled && !mBufferObjects[mPositionSource.buffer]) {
+            // position was the only attribute of its source slot; the slot still receives
+            // the application's data, so it needs its buffer object regardless
+            size_t const i = mPositionSource.buffer;
+            BufferObjectHandle const bo = driver.createBufferObject(bufferSizes[i],
+                    backend::BufferObjectBinding::VERTEX, internalBufferUsage);
+            if (auto name = builder.getName(); !name.empty()) {
+                driver.setDebugTag(bo.getId(), name);
+            }
+            driver.setVertexBufferObject(mHandle, i, bo);
+            mBufferObjects[i] = bo;
+            mTrackedMemory += bufferSizes[i];
+        }
     } else {
         // in advanced skinning mode, we manage the BONE_INDICES and BONE_WEIGHTS arrays ourselves,
         // so we have to set the corresponding buffer objects.
@@ -318,13 +386,42 @@ FVertexBuffer::FVertexBuffer(FEngine& engine, const VertexBuffer::Builder& build
             }
         }
     }
+    if (UTILS_UNLIKELY(mStreamingEnabled)) {
+        // seed each slot's ring with the buffer created above; the remaining entries are
+        // created lazily by rotateStreamBuffer() when updates actually come in
+        mStreamRings = std::make_unique<StreamRing[]>(MAX_VERTEX_BUFFER_COUNT);
+        for (size_t i = 0; i < MAX_VERTEX_BUFFER_COUNT; ++i) {
+            if (mBufferObjects[i]) {
+                mStreamRings[i].buffers[0] = mBufferObjects[i];
+                mStreamRings[i].size = uint32_t(bufferSizes[i]);
+                mStreamRings[i].next = 1;
+            }
+        }
+    }
+
+    if (mTrackedMemory) {
+        engine.getMemoryTracker().track(Engine::MemoryCategory::VERTEX_DATA, mTrackedMemory);
+    }
 }
 
 void FVertexBuffer::terminate(FEngine& engine) {
+    if (mTrackedMemory) {
+        engine.getMemoryTracker().release(Engine::MemoryCategory::VERTEX_DATA, mTrackedMemory);
+        mTrackedMemory = 0;
+    }
     FEngine::DriverApi& driver = engine.getDriverApi();
     if (!mBufferObjectsEnabled) {
-        for (BufferObjectHandle bo : mBufferObjects) {
-            driver.destroyBufferObject(bo);
+        if (UTILS_UNLIKELY(mStreamingEnabled)) {
+            // the currently bound buffers are entries of the rings, destroy each entry once
+            for (size_t i = 0; i < MAX_VERTEX_BUFFER_COUNT; ++i) {
+                for (BufferObjectHandle bo : mStreamRings[i].buffers) {
+                    driver.destroyBufferObject(bo);
+                }
+            }
+        } else {
+            for (BufferObjectHandle bo : mBufferObjects) {
+                driver.destroyBufferObject(bo);
+            }
         }
     }
     driver.destroyVertexBuffer(mHandle);
@@ -340,14 +437,79 @@ void FVertexBuffer::setBufferAt(FEngine& engine, uint8_t bufferIndex,
     FILAMENT_CHECK_PRECONDITION(!mBufferObjectsEnabled) << "Please use setBufferObjectAt()";
     if (bufferIndex < mBufferCount) {
         assert_invariant(mBufferObjects[bufferIndex]);
-        engine.getDriverApi().updateBufferObject(mBufferObjects[bufferIndex],
-               std::move(buffer), byteOffset);
+        if (UTILS_UNLIKELY(mPositionStreamSplitEnabled && bufferIndex == mPositionSource.buffer)) {
+            // mirror the position data into the dedicated position stream
+            updatePositionStream(engine, buffer, byteOffset);
+        }
+        BufferObjectHandle target = mBufferObjects[bufferIndex];
+        if (UTILS_UNLIKELY(mStreamingEnabled)) {
+            // write into the least-recently-used entry of the slot's ring so we never
+            // overwrite a buffer the GPU may still be reading (which backends handle by
+            // making an internal copy of the previous content)
+            target = rotateStreamBuffer(engine, bufferIndex);
+        }
+        engine.getDriverApi().updateBufferObject(target, std::move(buffer), byteOffset);
     } else {
         FILAMENT_CHECK_PRECONDITION(bufferIndex < mBufferCount)
                 << "bufferIndex must be < bufferCount";
     }
 }
 
+void FVertexBuffer::updatePositionStream(FEngine& engine,
+        backend::BufferDescriptor const& buffer, uint32_t byteOffset) noexcept {
+    size_t const elementSize = Driver::getElementTypeSize(mPositionSource.type);
+    uint32_t const srcOffset = mPositionSource.offset;
+    uint8_t const srcStride = mPositionSource.stride;
+
+    // compute the range of vertices whose position is fully covered by this update
+    size_t first = 0;
+    if (byteOffset > srcOffset) {
+        first = (byteOffset - srcOffset + srcStride - 1) / srcStride;
+    }
+    size_t last = 0; // exclusive
+    size_t const end = byteOffset + buffer.size;
+    if (end >= srcOffset + elementSize) {
+        last = std::min(size_t(mVertexCount), (end - srcOffset - elementSize) / srcStride + 1);
+    }
+    if (last <= first) {
+        return;
+    }
+
+    size_t const count = last - first;
+    uint8_t* const data = static_cast<uint8_t*>(malloc(count * elementSize));
+    uint8_t const* const src = static_cast<uint8_t const*>(buffer.buffer) - byteOffset + srcOffset;
+    for (size_t i = 0; i < count; ++i) {
+        memcpy(data + i * elementSize, src + (first + i) * srcStride, elementSize);
+    }
+
+    uint8_t const slot = mAttributes[VertexAttribute::POSITION].buffer;
+    assert_invariant(mBufferObjects[slot]);
+    BufferObjectHandle target = mBufferObjects[slot];
+    if (UTILS_UNLIKELY(mStreamingEnabled)) {
+        target = rotateStreamBuffer(engine, slot);
+    }
+    engine.getDriverApi().updateBufferObject(target,
+            { data, count * elementSize, [](void* p, size_t, void*) { free(p); } },
+            uint32_t(first * elementSize));
+}
+
+backend::BufferObjectHandle FVertexBuffer::rotateStreamBuffer(FEngine& engine, uint8_t slot) {
+    assert_invariant(mStreamingEnabled && slot < MAX_VERTEX_BUFFER_COUNT);
+    FEngine::DriverApi& driver = engine.getDriverApi();
+    StreamRing& ring = mStreamRings[slot];
+    size_t const entry = ring.next;
+    ring.next = uint8_t((entry + 1) % STREAM_RING_SIZE);
+    if (!ring.buffers[entry]) {
+        ring.buffers[entry] = driver.createBufferObject(ring.size,
+                backend::BufferObjectBinding::VERTEX, backend::BufferUsage::DYNAMIC);
+        mTrackedMemory += ring.size;
+        engine.getMemoryTracker().track(Engine::MemoryCategory::VERTEX_DATA, ring.size);
+    }
+    driver.setVertexBufferObject(mHandle, slot, ring.buffers[entry]);
+    mBufferObjects[slot] = ring.buffers[entry];
+    return ring.buffers[entry];
+}
+
 void FVertexBuffer::setBufferObjectAt(FEngine& engine, uint8_t bufferIndex,
         FBufferObject const * bufferObject) {
     FILAMENT_CHECK_PRECONDITION(mBufferObjectsEnabled) << "Please use setBufferAt()";
@@ -72,15 +72,40 @@ public:
 
 private:
     friend class VertexBuffer;
+
+    // deinterleaves the position data of an update into the dedicated position stream
+    void updatePositionStream(FEngine& engine,
+            backend::BufferDescriptor const& buffer, uint32_t byteOffset) noexcept;
+
+    // number of backing buffers per streamed slot; enough to cover the frames that can be
+    // in flight between the frontend and the GPU, so that the entry being rewritten is
+    // never still referenced by a pending command buffer
+    static constexpr size_t STREAM_RING_SIZE = 3;
+
+    // ring of backing stores for a streamed buffer slot, entries created lazily on update
+    struct StreamRing {
+        std::array<BufferObjectHandle, STREAM_RING_SIZE> buffers{};
+        uint32_t size = 0;      // byte size of each entry
+        uint8_t next = 0;       // entry receiving the next update
+    };
+
+    // rotates the ring of the given slot and rebinds the slot to the returned buffer
+    BufferObjectHandle rotateStreamBuffer(FEngine& engine, uint8_t slot);
+
     VertexBufferInfoHandle mVertexBufferInfoHandle;
     VertexBufferHandle mHandle;
     backend::AttributeArray mAttributes;
     std::array<BufferObjectHandle, backend::MAX_VERTEX_BUFFER_COUNT> mBufferObjects;
+    std::unique_ptr<StreamRing[]> mStreamRings;     // one per slot, streaming mode only
     AttributeBitset mDeclaredAttributes;
+    backend::Attribute mPositionSource{};   // where the application provides the position data
     uint32_t mVertexCount = 0;
+    uint32_t mTrackedMemory = 0; // internally-created buffer objects, accounted in GpuMemoryTracker
     uint8_t mBufferCount = 0;
     bool mBufferObjectsEnabled = false;
     bool mAdvancedSkinningEnabled = false;
+    bool mPositionStreamSplitEnabled = false;
+    bool mStreamingEnabled = false;
 };
 
 FILAMENT_DOWNCAST(VertexBuffer)
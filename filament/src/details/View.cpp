@@ -40,9 +40,11 @@
 
 #include <utils/compiler.h>
 #include <utils/debug.h>
+#include <utils/Log.h>
 #include <utils/Profiler.h>
 #include <utils/Slice.h>
 #include <utils/Systrace.h>
+#include <utils/ThermalManager.h>
 #include <utils/Zip2Iterator.h>
 
 #include <math/scalar.h>
@@ -68,7 +70,8 @@ FView::FView(FEngine& engine)
           mFogEntity(engine.getEntityManager().create()),
           mIsStereoSupported(engine.getDriverApi().isStereoSupported()),
           mUniforms(engine.getDriverApi()),
-          mColorPassDescriptorSet(engine, mUniforms) {
+          mColorPassDescriptorSet(engine, mUniforms),
+          mPerRenderPassArena("FView::mPerRenderPassArena", engine.getPerRenderPassArenaSize()) {
 
     DriverApi& driver = engine.getDriverApi();
 
@@ -155,6 +158,51 @@ void FView::terminate(FEngine& engine) {
 #endif
 }
 
+FView::ArenaStats FView::getPerRenderPassArenaStats() const noexcept {
+    auto const& listener = mPerRenderPassArena.getListener();
+    return {
+            .sizeBytes = uint32_t(mPerRenderPassArena.getArea().size()),
+            .highWatermarkBytes = listener.getHighWatermark(),
+            .overflowCount = mPerRenderPassArenaOverflows + listener.getOverflowCount(),
+    };
+}
+
+void FView::adjustPerRenderPassArena(FEngine& engine) noexcept {
+    // how many frames of usage we look at before considering shrinking the arena
+    constexpr uint32_t WINDOW_FRAME_COUNT = 256;
+
+    auto& listener = mPerRenderPassArena.getListener();
+    size_t const size = mPerRenderPassArena.getArea().size();
+    uint32_t const highWatermark = listener.getHighWatermark();
+    uint32_t const overflows = listener.getOverflowCount();
+
+    size_t newSize = 0;
+    if (UTILS_UNLIKELY(overflows > 0 || highWatermark > size - size / 10)) {
+        // we overflowed (or came within 10% of it), grow immediately
+        newSize = size * 2;
+    } else if (++mPerRenderPassArenaFrames >= WINDOW_FRAME_COUNT) {
+        // consistently low usage over the whole window, give memory back -- but never
+        // shrink below the configured initial size
+        mPerRenderPassArenaFrames = 0;
+        size_t const initialSize = engine.getPerRenderPassArenaSize();
+        if (highWatermark < size / 4 && size > initialSize) {
+            newSize = std::max(size / 2, initialSize);
+        }
+        listener.resetHighWatermark();
+    }
+
+    if (UTILS_UNLIKELY(newSize)) {
+        // overflow counts don't survive the swap, carry them over
+        mPerRenderPassArenaOverflows += overflows;
+        mPerRenderPassArenaFrames = 0;
+        LinearAllocatorArena arena("FView::mPerRenderPassArena", newSize);
+        swap(mPerRenderPassArena, arena);
+        slog.d << "FView::mPerRenderPassArena resized "
+               << (size / FEngine::MiB) << " MiB -> " << (newSize / FEngine::MiB) << " MiB"
+               << io::endl;
+    }
+}
+
 void FView::setViewport(filament::Viewport const& viewport) noexcept {
     // catch the cases were user had an underflow and didn't catch it.
     assert((int32_t)viewport.width > 0);
@@ -227,7 +275,24 @@ float2 FView::updateScale(FEngine& engine,
         using std::chrono::duration;
         const float dt = 1.0f; // we don't really need dt here, setting it to 1, means our parameters are in "frames"
         const float target = (1000.0f * float(frameRateOptions.interval)) / displayInfo.refreshRate;
-        const float targetWithHeadroom = target * (1.0f - frameRateOptions.headRoomRatio);
+        // Thermal pressure enters the control loop as extra headroom on the frame-time target:
+        // the hotter the device, the lower the target, so the controller lowers the resolution
+        // before the OS throttles the GPU clocks -- and raises it back once the device cools.
+        const float thermalHeadroom = [&engine] {
+            using ThermalStatus = utils::ThermalManager::ThermalStatus;
+            switch (engine.getThermalStatus()) {
+                case ThermalStatus::LIGHT:      return 0.10f;
+                case ThermalStatus::MODERATE:   return 0.25f;
+                case ThermalStatus::SEVERE:
+                case ThermalStatus::CRITICAL:
+                case ThermalStatus::EMERGENCY:
+                case ThermalStatus::SHUTDOWN:   return 0.40f;
+                default:                        return 0.0f;
+            }
+        }();
+
+        const float targetWithHeadroom =
+                target * (1.0f - frameRateOptions.headRoomRatio) * (1.0f - thermalHeadroom);
         float const measured = duration<float, std::milli>{ info.denoisedFrameTime }.count();
         float const out = mPidController.update(measured / targetWithHeadroom, 1.0f, dt);
 
@@ -311,6 +376,71 @@ float2 FView::updateScale(FEngine& engine,
     return mScale;
 }
 
+void FView::setDynamicQualityOptions(DynamicQualityOptions const& options) noexcept {
+    DynamicQualityOptions& dynamicQuality = mDynamicQuality;
+    dynamicQuality = options;
+
+    // this can't work with a feature level where the frame time is not available
+    dynamicQuality.enabled = dynamicQuality.enabled && mIsDynamicResolutionSupported;
+
+    dynamicQuality.maxDegradation = std::min(dynamicQuality.maxDegradation, uint8_t(3));
+    dynamicQuality.budgetMilliseconds = std::max(dynamicQuality.budgetMilliseconds, 0.0f);
+
+    if (!dynamicQuality.enabled) {
+        mQualityDegradation = 0;
+        mOverBudgetFrameCount = 0;
+        mUnderBudgetFrameCount = 0;
+    }
+}
+
+uint8_t FView::updateQualityDegradation(filament::details::FrameInfo const& info,
+        Renderer::FrameRateOptions const& frameRateOptions,
+        Renderer::DisplayInfo const& displayInfo) noexcept {
+    DynamicQualityOptions const& options = mDynamicQuality;
+    if (!options.enabled || UTILS_UNLIKELY(!info.valid)) {
+        return std::min(mQualityDegradation, options.maxDegradation);
+    }
+
+    // the budget defaults to the display-derived target dynamic resolution uses
+    float budget = options.budgetMilliseconds;
+    if (budget <= 0.0f) {
+        const float target = (1000.0f * float(frameRateOptions.interval)) / displayInfo.refreshRate;
+        budget = target * (1.0f - frameRateOptions.headRoomRatio);
+    }
+
+    using std::chrono::duration;
+    float const measured = duration<float, std::milli>{ info.denoisedFrameTime }.count();
+
+    // Hysteresis keeps the knobs from oscillating: degrading is fast (a few frames over
+    // budget), restoring is slow (a couple of seconds comfortably under it), and each level
+    // change restarts both counters. The fast transients in-between are absorbed by dynamic
+    // resolution, which reacts within a frame.
+    constexpr uint16_t DEGRADE_FRAME_COUNT = 4;
+    constexpr uint16_t RESTORE_FRAME_COUNT = 120;
+    constexpr float RESTORE_MARGIN = 0.85f;
+
+    if (measured > budget) {
+        mUnderBudgetFrameCount = 0;
+        if (++mOverBudgetFrameCount >= DEGRADE_FRAME_COUNT &&
+                mQualityDegradation < options.maxDegradation) {
+            mQualityDegradation++;
+            mOverBudgetFrameCount = 0;
+        }
+    } else if (measured < budget * RESTORE_MARGIN) {
+        mOverBudgetFrameCount = 0;
+        if (++mUnderBudgetFrameCount >= RESTORE_FRAME_COUNT && mQualityDegradation > 0) {
+            mQualityDegradation--;
+            mUnderBudgetFrameCount = 0;
+        }
+    } else {
+        // within the hysteresis band, don't move in either direction
+        mOverBudgetFrameCount = 0;
+        mUnderBudgetFrameCount = 0;
+    }
+
+    return std::min(mQualityDegradation, options.maxDegradation);
+}
+
 void FView::setVisibleLayers(uint8_t select, uint8_t values) noexcept {
     mVisibleLayers = (mVisibleLayers & ~select) | (values & select);
 }
@@ -334,14 +464,32 @@ void FView::prepareShadowing(FEngine& engine, FScene::RenderableSoa& renderableD
 
     ShadowMapManager::Builder builder;
 
+    // Screen-space contact shadows don't allocate shadow maps, but they still need
+    // ShadowMapManager::update() to run so the per-light shadow info and the ray-marching
+    // uniforms are set up.
+    bool needsContactShadows = false;
+
     // dominant directional light is always as index 0
     FLightManager::Instance const directionalLight = lightData.elementAt<FScene::LIGHT_INSTANCE>(0);
+    if (directionalLight && lcm.getShadowOptions(directionalLight).screenSpaceContactShadows) {
+        needsContactShadows = true;
+    }
     const bool hasDirectionalShadows = directionalLight && lcm.isShadowCaster(directionalLight);
     if (UTILS_UNLIKELY(hasDirectionalShadows)) {
         const auto& shadowOptions = lcm.getShadowOptions(directionalLight);
         assert_invariant(shadowOptions.shadowCascades >= 1 &&
                 shadowOptions.shadowCascades <= CONFIG_MAX_SHADOW_CASCADES);
-        builder.directionalShadowMap(0, &shadowOptions);
+        if (UTILS_UNLIKELY(mQualityDegradation >= 2 && shadowOptions.shadowCascades > 1)) {
+            // dynamic quality scaling: drop the farthest cascade(s) under sustained GPU
+            // overload. The copy must outlive the frame because the ShadowMapManager keeps
+            // a pointer to it, hence the member.
+            mDegradedShadowOptions = shadowOptions;
+            mDegradedShadowOptions.shadowCascades = uint8_t(std::max(1,
+                    shadowOptions.shadowCascades - (mQualityDegradation - 1)));
+            builder.directionalShadowMap(0, &mDegradedShadowOptions);
+        } else {
+            builder.directionalShadowMap(0, &shadowOptions);
+        }
     }
 
     // Find all shadow-casting spotlights.
@@ -361,6 +509,11 @@ void FView::prepareShadowing(FEngine& engine, FScene::RenderableSoa& renderableD
             continue; // invalid instance
         }
 
+        const auto& shadowOptions = lcm.getShadowOptions(li);
+        if (UTILS_UNLIKELY(shadowOptions.screenSpaceContactShadows)) {
+            needsContactShadows = true;
+        }
+
         if (UTILS_LIKELY(!lcm.isShadowCaster(li))) {
             // Because we early exit here, we need to make sure we mark the light as non-casting.
             // See `ShadowMapManager::updateSpotShadowMaps` for const_cast<> justification.
@@ -374,7 +527,6 @@ void FView::prepareShadowing(FEngine& engine, FScene::RenderableSoa& renderableD
         const size_t shadowMapCountNeeded = spotLight ? 1 : 6;
         if (shadowMapCount + shadowMapCountNeeded <= CONFIG_MAX_SHADOWMAPS) {
             shadowMapCount += shadowMapCountNeeded;
-            const auto& shadowOptions = lcm.getShadowOptions(li);
             builder.shadowMap(l, spotLight, &shadowOptions);
         }
 
@@ -383,7 +535,9 @@ void FView::prepareShadowing(FEngine& engine, FScene::RenderableSoa& renderableD
         }
     }
 
-    if (builder.hasShadowMaps()) {
+    // Contact-shadow-only lights get shadowing without any shadow map (or atlas layer)
+    // being allocated, so run the update even when the builder is empty.
+    if (builder.hasShadowMaps() || UTILS_UNLIKELY(needsContactShadows)) {
         ShadowMapManager::createIfNeeded(engine, mShadowMapManager);
         auto shadowTechnique = mShadowMapManager->update(builder, engine, *this,
                 cameraInfo, renderableData, lightData);
@@ -415,8 +569,18 @@ void FView::prepareLighting(FEngine& engine, CameraInfo const& cameraInfo) noexc
      * Exposure
      */
 
-    const float exposure = Exposure::exposure(cameraInfo.ev100);
-    mColorPassDescriptorSet.prepareExposure(cameraInfo.ev100);
+    float ev100 = cameraInfo.ev100;
+    if (UTILS_UNLIKELY(mIsAutoExposureEnabled && mAutoExposureState &&
+            mAutoExposureState->hasSample.load(std::memory_order_relaxed))) {
+        // override the camera's exposure with the metered, temporally adapted value
+        ev100 = mAutoExposureState->adaptedEv100.load(std::memory_order_relaxed);
+    }
+    // remember which ev100 this frame is rendered with, so the metering readback can undo
+    // the pre-exposure baked into the HDR buffer it samples
+    mLastPreparedEv100 = ev100;
+
+    const float exposure = Exposure::exposure(ev100);
+    mColorPassDescriptorSet.prepareExposure(ev100);
 
     /*
      * Indirect light (IBL)
@@ -510,6 +674,12 @@ void FView::prepare(FEngine& engine, DriverApi& driver, RootArenaScope& rootAren
 
     const Frustum cullingFrustum = getFrustum();
 
+    // World-space position of the culling camera, used for the PVS cell lookup. As with the
+    // frustum above, the viewing-camera case is extremely uncommon.
+    const float3 cullingCameraPosition = UTILS_LIKELY(mViewingCamera == nullptr) ?
+            cameraInfo.getPosition() :
+            float3{ (cameraInfo.worldTransform * mCullingCamera->getModelMatrix())[3].xyz };
+
     FScene* const scene = getScene();
 
     /*
@@ -562,7 +732,7 @@ void FView::prepare(FEngine& engine, DriverApi& driver, RootArenaScope& rootAren
          * (this will set the VISIBLE_RENDERABLE bit)
          */
 
-        prepareVisibleRenderables(js, cullingFrustum, renderableData);
+        prepareVisibleRenderables(js, cullingFrustum, cullingCameraPosition, renderableData);
 
 
         /*
@@ -781,6 +951,43 @@ void FView::prepare(FEngine& engine, DriverApi& driver, RootArenaScope& rootAren
     mColorPassDescriptorSet.prepareTemporalNoise(engine, mTemporalAntiAliasingOptions);
     mColorPassDescriptorSet.prepareBlending(needsAlphaChannel);
     mColorPassDescriptorSet.prepareMaterialGlobals(mMaterialGlobals);
+
+    if (UTILS_UNLIKELY(mIsStreamingFeedbackEnabled)) {
+        updateStreamingFeedback(engine, cameraInfo);
+    }
+}
+
+// Engine-side stand-in for GPU sampling feedback: estimate, for each visible renderable,
+// the on-screen resolution it needs from its textures, and fold that into the per-texture
+// desired mip level exposed by FTexture::getDesiredMipLevel() to drive streaming priorities.
+void FView::updateStreamingFeedback(FEngine& engine,
+        CameraInfo const& cameraInfo) const noexcept {
+    SYSTRACE_CALL();
+    FScene::RenderableSoa const& soa = mScene->getRenderableData();
+    auto const* const UTILS_RESTRICT center = soa.data<FScene::WORLD_AABB_CENTER>();
+    auto const* const UTILS_RESTRICT extent = soa.data<FScene::WORLD_AABB_EXTENT>();
+    auto const* const UTILS_RESTRICT primitives = soa.data<FScene::PRIMITIVES>();
+
+    uint32_t const frameCounter = engine.getFrameCounter();
+    float3 const cameraPosition = cameraInfo.getPosition();
+    // vertical scale of the projection, i.e. cot(fovy / 2) for perspective projections
+    float const projectionScale = cameraInfo.projection[1][1];
+    float const viewportHeight = float(mViewport.height);
+
+    for (uint32_t i = mVisibleRenderables.first; i < mVisibleRenderables.last; ++i) {
+        float const radius = std::max(length(extent[i]), 1e-3f);
+        float const distance = std::max(length(center[i] - cameraPosition), radius);
+        // footprint of the bounding sphere in pixels, a proxy for the sampled resolution
+        float const projectedPixels =
+                (radius / distance) * projectionScale * viewportHeight;
+        float const log2Pixels = std::log2(std::max(projectedPixels, 1.0f));
+        for (auto const& primitive: primitives[i]) {
+            FMaterialInstance const* const mi = primitive.getMaterialInstance();
+            if (mi) {
+                mi->updateStreamingFeedback(frameCounter, log2Pixels);
+            }
+        }
+    }
 }
 
 void FView::computeVisibilityMasks(
@@ -797,7 +1004,7 @@ void FView::computeVisibilityMasks(
         const FRenderableManager::Visibility v = visibility[i];
         const bool inVisibleLayer = layers[i] & visibleLayers;
 
-        const bool visibleRenderable = inVisibleLayer &&
+        const bool visibleRenderable = inVisibleLayer && !v.shadowOnly &&
                 (!v.culling || (mask & VISIBLE_RENDERABLE));
 
         const bool visibleDirectionalShadowRenderable = (v.castShadows && inVisibleLayer) &&
@@ -914,20 +1121,106 @@ void FView::commitUniformsAndSamplers(DriverApi& driver) const noexcept {
 
 void FView::commitFroxels(DriverApi& driverApi) const noexcept {
     if (mHasDynamicLighting) {
-        mFroxelizer.commit(driverApi);
+        if (mFroxelizer.commit(driverApi)) {
+            // the froxelizer swapped to its other buffer set; rebind so the new handles are
+            // picked up when the color pass commits the per-view descriptor set
+            mColorPassDescriptorSet.prepareFroxelBuffers(
+                    mFroxelizer.getRecordBuffer(), mFroxelizer.getFroxelBuffer());
+        }
     }
 }
 
 UTILS_NOINLINE
 void FView::prepareVisibleRenderables(JobSystem& js,
-        Frustum const& frustum, FScene::RenderableSoa& renderableData) const noexcept {
+        Frustum const& frustum, float3 const& cameraPosition,
+        FScene::RenderableSoa& renderableData) const noexcept {
     SYSTRACE_CALL();
     if (UTILS_LIKELY(isFrustumCullingEnabled())) {
-        FView::cullRenderables(js, renderableData, frustum, VISIBLE_RENDERABLE_BIT);
+        // Large scenes go through the scene's BVH, which rejects whole subtrees; smaller
+        // ones stay on the flat vectorized path, whose constant factor is hard to beat.
+        FScene const* const scene = getScene();
+        RenderableBvh const* const bvh = scene ? &scene->getRenderableBvh() : nullptr;
+        if (bvh && bvh->size() == renderableData.size()
+                && bvh->size() >= RenderableBvh::CULL_THRESHOLD) {
+            bvh->cull(frustum,
+                    renderableData.data<FScene::WORLD_AABB_CENTER>(),
+                    renderableData.data<FScene::WORLD_AABB_EXTENT>(),
+                    renderableData.data<FScene::VISIBLE_MASK>(), VISIBLE_RENDERABLE_BIT);
+        } else {
+            cullRenderablesTemporal(js, renderableData, frustum, VISIBLE_RENDERABLE_BIT);
+        }
     } else {
         std::uninitialized_fill(renderableData.begin<FScene::VISIBLE_MASK>(),
                   renderableData.end<FScene::VISIBLE_MASK>(), VISIBLE_RENDERABLE);
     }
+
+    if (UTILS_UNLIKELY(!mPvsDatabase.empty())
+            && mPvsDatabase.getRenderableCount() == renderableData.size()) {
+        // Precomputed visibility: intersect the frustum results with the bitset of the cell
+        // containing the camera. Only the main-pass bit is cleared -- a renderable occluded
+        // from the cell can still cast a shadow into it. Outside the grid the PVS doesn't
+        // apply and the frustum results stand alone.
+        size_t const cell = mPvsDatabase.getCell(cameraPosition);
+        if (cell != PvsDatabase::INVALID_CELL) {
+            mPvsDatabase.apply(cell, renderableData.data<FScene::VISIBLE_MASK>(),
+                    renderableData.size(), VISIBLE_RENDERABLE_BIT);
+        }
+    }
+
+    if (UTILS_UNLIKELY(mOcclusionCulling && !mOcclusionResults.empty())) {
+        // Latency-tolerant occlusion masking: the results were computed against the
+        // previous frame's depth, so a renderable is only masked out of the main pass
+        // (shadow-caster bits are left alone, occluders still cast shadows). Results are
+        // dropped when the renderable count changed, as entries no longer line up.
+        if (mOcclusionResults.size() == renderableData.size()) {
+            FScene::VisibleMaskType* const UTILS_RESTRICT visibleArray =
+                    renderableData.data<FScene::VISIBLE_MASK>();
+            uint8_t const* const UTILS_RESTRICT occluded = mOcclusionResults.data();
+            for (size_t i = 0, c = renderableData.size(); i < c; i++) {
+                visibleArray[i] &= FScene::VisibleMaskType(
+                        occluded[i] ? ~VISIBLE_RENDERABLE : ~FScene::VisibleMaskType(0));
+            }
+        }
+    }
+
+    cullPrimitives(renderableData, frustum);
+}
+
+void FView::cullPrimitives(FScene::RenderableSoa& renderableData,
+        Frustum const& frustum) noexcept {
+    SYSTRACE_CALL();
+    auto const* const UTILS_RESTRICT visibility =
+            renderableData.data<FScene::VISIBILITY_STATE>();
+    auto const* const UTILS_RESTRICT visibleMask = renderableData.data<FScene::VISIBLE_MASK>();
+    auto const* const UTILS_RESTRICT worldTransform =
+            renderableData.data<FScene::WORLD_TRANSFORM>();
+    auto const* const UTILS_RESTRICT primitives = renderableData.data<FScene::PRIMITIVES>();
+    auto* const UTILS_RESTRICT primitiveVisibleMask =
+            renderableData.data<FScene::PRIMITIVE_VISIBLE_MASK>();
+
+    for (size_t i = 0, c = renderableData.size(); i < c; i++) {
+        primitiveVisibleMask[i] = ~uint32_t(0);
+        // the vast majority of renderables don't declare per-primitive bounds
+        if (UTILS_LIKELY(!visibility[i].hasPerPrimitiveBounds)
+                || !(visibleMask[i] & VISIBLE_RENDERABLE)) {
+            continue;
+        }
+        Slice<FRenderPrimitive> const& prims = primitives[i];
+        uint32_t mask = ~uint32_t(0);
+        // only the first 32 primitives can be individually culled
+        size_t const n = std::min(prims.size(), size_t(32));
+        for (size_t j = 0; j < n; j++) {
+            FRenderPrimitive const& prim = prims[j];
+            if (prim.hasAxisAlignedBoundingBox()) {
+                Box const worldAabb =
+                        rigidTransform(prim.getAxisAlignedBoundingBox(), worldTransform[i]);
+                if (!Culler::intersects(frustum, worldAabb)) {
+                    mask &= ~(1u << j);
+                }
+            }
+        }
+        primitiveVisibleMask[i] = mask;
+    }
 }
 
 void FView::cullRenderables(JobSystem&,
@@ -956,6 +1249,116 @@ void FView::cullRenderables(JobSystem&,
     functor(0, renderableData.size());
 }
 
+void FView::cullRenderablesTemporal(JobSystem&,
+        FScene::RenderableSoa& renderableData, Frustum const& frustum,
+        size_t const bit) const noexcept {
+    SYSTRACE_CALL();
+
+    float3 const* const worldAABBCenter = renderableData.data<FScene::WORLD_AABB_CENTER>();
+    float3 const* const worldAABBExtent = renderableData.data<FScene::WORLD_AABB_EXTENT>();
+    FScene::VisibleMaskType* const visibleArray = renderableData.data<FScene::VISIBLE_MASK>();
+
+    size_t const count = renderableData.size();
+    size_t const rounded = Culler::round(count);
+    auto& cache = mTemporalCullingCache;
+
+    if (UTILS_UNLIKELY(count == 0)) {
+        cache.count = 0;
+        return;
+    }
+
+    // Re-tests a range and re-banks its margins. Fresh margins are relative to the current
+    // frustum, but expiry is checked against the reference one, so the drift already
+    // accumulated (zero right after a rebase) is deducted up-front to stay conservative.
+    auto const refresh = [&](size_t const index, size_t const c,
+            float const normalDrift, float const offsetDrift) {
+        float* const margins = cache.margins.data();
+        float* const reaches = cache.reaches.data();
+        uint8_t* const results = cache.results.data();
+        Culler::intersects(visibleArray + index, margins + index, frustum,
+                worldAABBCenter + index, worldAABBExtent + index, c, bit);
+        for (size_t i = index, e = index + Culler::round(c); i < e; i++) {
+            float const reach = length(worldAABBCenter[i]) + length(worldAABBExtent[i]);
+            reaches[i] = reach;
+            margins[i] -= normalDrift * reach + offsetDrift;
+            results[i] = uint8_t((visibleArray[i] >> bit) & 1u);
+        }
+    };
+
+    // The drift bound only models camera motion. Any object motion -- transforms, bounds,
+    // entities added or removed -- is invisible to it, so the scene's content generation
+    // (which aggregates those change counters) must match the one the margins were banked
+    // against; otherwise a moved object could stay culled under a static camera forever,
+    // and a same-count remove+add would reuse entries recorded for different objects.
+    FScene const* const scene = getScene();
+    uint32_t const generation = scene ? scene->getContentGeneration() : 0;
+
+    if (UTILS_UNLIKELY(cache.count != count || cache.generation != generation)) {
+        // the entries no longer line up with the scene, start over
+        if (cache.margins.size() < rounded) {
+            cache.margins = utils::FixedCapacityVector<float>(rounded);
+            cache.reaches = utils::FixedCapacityVector<float>(rounded);
+            cache.results = utils::FixedCapacityVector<uint8_t>(rounded);
+        }
+        cache.count = uint32_t(count);
+        cache.generation = generation;
+        cache.frustum = frustum;
+        refresh(0, count, 0.0f, 0.0f);
+        return;
+    }
+
+    // Conservative bound on how much any plane's signed distance to a box can have changed
+    // since the reference frustum: a rotational term, scaled per-box by how far the box
+    // reaches from the origin, plus a translational term. Planes are normalized, so both
+    // are in world units.
+    float4 const* const planes = frustum.getNormalizedPlanes();
+    float4 const* const refPlanes = cache.frustum.getNormalizedPlanes();
+    float normalDrift = 0.0f;
+    float offsetDrift = 0.0f;
+    for (size_t j = 0; j < 6; j++) {
+        normalDrift = std::max(normalDrift, length(planes[j].xyz - refPlanes[j].xyz));
+        offsetDrift = std::max(offsetDrift, std::abs(planes[j].w - refPlanes[j].w));
+    }
+
+    // Entries expire in groups of MODULO so that re-tests stay on the vectorized path.
+    float const* const margins = cache.margins.data();
+    float const* const reaches = cache.reaches.data();
+    size_t expiredGroups = 0;
+    for (size_t i = 0; i < rounded; i += Culler::MODULO) {
+        for (size_t j = i, e = i + Culler::MODULO; j < e; j++) {
+            if (margins[j] <= normalDrift * reaches[j] + offsetDrift) {
+                expiredGroups++;
+                break;
+            }
+        }
+    }
+
+    if (UTILS_UNLIKELY(expiredGroups * 2 >= rounded / Culler::MODULO)) {
+        // most of the banked slack is spent, rebase everything on the current frustum
+        cache.frustum = frustum;
+        refresh(0, count, 0.0f, 0.0f);
+        return;
+    }
+
+    uint8_t const* const results = cache.results.data();
+    for (size_t i = 0; i < rounded; i += Culler::MODULO) {
+        bool expired = false;
+        for (size_t j = i, e = i + Culler::MODULO; j < e; j++) {
+            expired = expired || (margins[j] <= normalDrift * reaches[j] + offsetDrift);
+        }
+        if (UTILS_UNLIKELY(expired)) {
+            refresh(i, Culler::MODULO, normalDrift, offsetDrift);
+        } else {
+            for (size_t j = i, e = i + Culler::MODULO; j < e; j++) {
+                auto r = visibleArray[j];
+                r &= ~FScene::VisibleMaskType(1u << bit);
+                r |= FScene::VisibleMaskType(uint32_t(results[j]) << bit);
+                visibleArray[j] = r;
+            }
+        }
+    }
+}
+
 void FView::prepareVisibleLights(FLightManager const& lcm,
         utils::Slice<float> scratch,
         mat4f const& viewMatrix, Frustum const& frustum,
@@ -1082,6 +1485,14 @@ FrameGraphId<FrameGraphTexture> FView::renderShadowMaps(FEngine& engine, FrameGr
     return mShadowMapManager->render(engine, fg, passBuilder, *this, cameraInfo, userTime);
 }
 
+FrameGraphId<FrameGraphTexture> FView::importShadowMaps(FEngine& engine, FrameGraph& fg,
+        CameraInfo const& cameraInfo,
+        FrameGraphTexture::Descriptor const& desc,
+        FrameGraphTexture const& texture) noexcept {
+    assert_invariant(needsShadowMap());
+    return mShadowMapManager->import(engine, fg, *this, cameraInfo, desc, texture);
+}
+
 void FView::commitFrameHistory(FEngine& engine) noexcept {
     // Here we need to destroy resources in mFrameHistory.back()
     auto& disposer = engine.getResourceAllocatorDisposer();
@@ -1107,7 +1518,81 @@ void FView::clearFrameHistory(FEngine& engine) noexcept {
 }
 
 void FView::executePickingQueries(backend::DriverApi& driver,
-        backend::RenderTargetHandle handle, float2 scale) noexcept {
+        backend::RenderTargetHandle handle, float2 scale,
+        uint32_t width, uint32_t height) noexcept {
+
+    bool const isFL0 = driver.getFeatureLevel() == FeatureLevel::FEATURE_LEVEL_0;
+
+    // With continuous picking, we keep CPU-side snapshots of the whole picking buffer and
+    // resolve queries from the most recent one, so each query is a simple memory read with
+    // about two frames of latency and no per-query GPU work. This relies on the RG32F
+    // picking buffer layout, so feature level 0 falls back to per-query readbacks below.
+    if (mIsContinuousPickingEnabled && !isFL0) {
+        if (UTILS_UNLIKELY(!mPickingSnapshotRing)) {
+            mPickingSnapshotRing = std::make_shared<PickingSnapshotRing>();
+        }
+        PickingSnapshotRing& ring = *mPickingSnapshotRing;
+
+        // resolve pending queries from the most recent completed snapshot, if we have one;
+        // until the first readback completes, queries fall through to the per-query path
+        if (ring.latest >= 0) {
+            PickingSnapshotRing::Snapshot const& snapshot = ring.snapshots[ring.latest];
+            while (mActivePickingQueriesList) {
+                FPickingQuery* const pQuery = mActivePickingQueriesList;
+                mActivePickingQueriesList = pQuery->next;
+                uint32_t const x = std::min(uint32_t(float(pQuery->x) * scale.x),
+                        snapshot.width - 1);
+                uint32_t const y = std::min(uint32_t(float(pQuery->y) * scale.y),
+                        snapshot.height - 1);
+                // same layout as the RG32F per-query readback below: entity bits, then depth
+                memcpy(&pQuery->result.renderable,
+                        &snapshot.data[y * snapshot.width + x], sizeof(float2));
+                pQuery->result.fragCoords = {
+                        pQuery->x, pQuery->y, float(1.0 - pQuery->result.depth) };
+                auto const dispatch = [](void* user) {
+                    FPickingQuery* const pQuery = static_cast<FPickingQuery*>(user);
+                    pQuery->callback(pQuery->result, pQuery);
+                    FPickingQuery::put(pQuery);
+                };
+                if (pQuery->handler) {
+                    pQuery->handler->post(pQuery, dispatch);
+                } else {
+                    // no handler means the main thread, which is where we are
+                    dispatch(pQuery);
+                }
+            }
+        }
+
+        // kick an asynchronous readback of the whole buffer into the next ring entry -- if
+        // it's still in flight (readbacks outpacing the GPU), simply skip this frame
+        PickingSnapshotRing::Snapshot& snapshot = ring.snapshots[ring.head];
+        if (!snapshot.inFlight) {
+            if (snapshot.width != width || snapshot.height != height) {
+                snapshot.data = std::make_unique<float2[]>(size_t(width) * height);
+                snapshot.width = width;
+                snapshot.height = height;
+            }
+            snapshot.inFlight = true;
+            struct ReadbackContext {
+                std::shared_ptr<PickingSnapshotRing> ring;
+                size_t index;
+            };
+            ReadbackContext* const context =
+                    new(std::nothrow) ReadbackContext{ mPickingSnapshotRing, ring.head };
+            driver.readPixels(handle, 0, 0, width, height, {
+                    snapshot.data.get(), size_t(width) * height * sizeof(float2),
+                    backend::PixelDataFormat::RG, backend::PixelDataType::FLOAT,
+                    nullptr, [](void*, size_t, void* user) {
+                        ReadbackContext* const context = static_cast<ReadbackContext*>(user);
+                        PickingSnapshotRing& ring = *context->ring;
+                        ring.snapshots[context->index].inFlight = false;
+                        ring.latest = int32_t(context->index);
+                        delete context;
+                    }, context
+            });
+            ring.head = (ring.head + 1) % PickingSnapshotRing::COUNT;
+        }
+    }
 
     while (mActivePickingQueriesList) {
         FPickingQuery* const pQuery = mActivePickingQueriesList;
@@ -1156,9 +1641,64 @@ void FView::executePickingQueries(backend::DriverApi& driver,
     }
 }
 
+void FView::setAutoExposureEnabled(bool const enabled) noexcept {
+    if (enabled && UTILS_UNLIKELY(!mAutoExposureState)) {
+        mAutoExposureState = std::make_shared<AutoExposureState>();
+    }
+    if (!enabled && mAutoExposureState) {
+        // forget the adapted value so a later re-enable starts from the camera's exposure
+        mAutoExposureState->hasSample.store(false, std::memory_order_relaxed);
+    }
+    mIsAutoExposureEnabled = enabled;
+}
+
+backend::PixelBufferDescriptor FView::makeAutoExposureMeteringBuffer() noexcept {
+    constexpr uint32_t N = AUTO_EXPOSURE_METERING_SIZE;
+    // the context owns the pixel storage and keeps the adaptation state alive; the readback
+    // can still be in flight when the View is destroyed
+    struct MeteringContext {
+        std::shared_ptr<AutoExposureState> state;
+        float ev100; // ev100 the metered frame was rendered with (to undo pre-exposure)
+        float pixels[N * N * 4];
+    };
+    assert_invariant(mAutoExposureState);
+    MeteringContext* const context =
+            new(std::nothrow) MeteringContext{ mAutoExposureState, mLastPreparedEv100, {} };
+    return { context->pixels, sizeof(context->pixels),
+            backend::PixelDataFormat::RGBA, backend::PixelDataType::FLOAT,
+            [](void*, size_t, void* user) {
+                MeteringContext* const context = static_cast<MeteringContext*>(user);
+                // undo the pre-exposure baked into the HDR buffer
+                const float exposure = Exposure::exposure(context->ev100);
+                // log-average of the relative luminance, i.e. the geometric mean, which is
+                // much less sensitive to a few very bright pixels than the arithmetic mean
+                float logLuminanceSum = 0.0f;
+                for (size_t i = 0; i < N * N; i++) {
+                    float const* const p = context->pixels + i * 4;
+                    float const y = (0.2126f * p[0] + 0.7152f * p[1] + 0.0722f * p[2]) / exposure;
+                    logLuminanceSum += std::log2(std::max(y, 1e-6f));
+                }
+                float const averageLuminance = std::exp2(logLuminanceSum / float(N * N));
+                float const targetEv100 = Exposure::ev100FromLuminance(averageLuminance);
+                AutoExposureState& state = *context->state;
+                if (!state.hasSample.load(std::memory_order_relaxed)) {
+                    state.adaptedEv100.store(targetEv100, std::memory_order_relaxed);
+                    state.hasSample.store(true, std::memory_order_relaxed);
+                } else {
+                    // exponential adaptation towards the metered value, so the exposure
+                    // eases in over a few frames instead of popping
+                    float const current = state.adaptedEv100.load(std::memory_order_relaxed);
+                    state.adaptedEv100.store(current + (targetEv100 - current) * 0.1f,
+                            std::memory_order_relaxed);
+                }
+                delete context;
+            }, context };
+}
+
 void FView::setTemporalAntiAliasingOptions(TemporalAntiAliasingOptions options) noexcept {
     options.feedback = math::clamp(options.feedback, 0.0f, 1.0f);
     options.filterWidth = std::max(0.2f, options.filterWidth); // below 0.2 causes issues
+    options.upscalingRatio = math::clamp(options.upscalingRatio, 0.5f, 0.67f);
     mTemporalAntiAliasingOptions = options;
 }
 
@@ -1184,9 +1724,9 @@ void FView::setAmbientOcclusionOptions(AmbientOcclusionOptions options) noexcept
     options.radius = math::max(0.0f, options.radius);
     options.power = std::max(0.0f, options.power);
     options.bias = math::clamp(options.bias, 0.0f, 0.1f);
-    // snap to the closer of 0.5 or 1.0
-    options.resolution = std::floor(
-            math::clamp(options.resolution * 2.0f, 1.0f, 2.0f) + 0.5f) * 0.5f;
+    // snap to the closest power-of-two scale in [0.25, 1.0], i.e. 0.25, 0.5 or 1.0
+    options.resolution = std::exp2(std::floor(
+            math::clamp(std::log2(options.resolution), -2.0f, 0.0f) + 0.5f));
     options.intensity = std::max(0.0f, options.intensity);
     options.bilateralThreshold = std::max(0.0f, options.bilateralThreshold);
     options.minHorizonAngleRad = math::clamp(options.minHorizonAngleRad, 0.0f, math::f::PI_2);
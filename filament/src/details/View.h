@@ -21,10 +21,12 @@
 
 #include "Allocators.h"
 #include "Culler.h"
+#include "RenderPass.h"
 #include "FrameHistory.h"
 #include "FrameInfo.h"
 #include "Froxelizer.h"
 #include "PIDController.h"
+#include "PvsDatabase.h"
 #include "ShadowMapManager.h"
 
 #include "ds/ColorPassDescriptorSet.h"
@@ -52,10 +54,12 @@
 
 #include <backend/DriverEnums.h>
 #include <backend/Handle.h>
+#include <backend/PixelBufferDescriptor.h>
 
 #include <utils/compiler.h>
 #include <utils/Allocator.h>
 #include <utils/Entity.h>
+#include <utils/FixedCapacityVector.h>
 #include <utils/StructureOfArrays.h>
 #include <utils/Range.h>
 #include <utils/Slice.h>
@@ -64,6 +68,7 @@
 #include <math/mat4.h>
 
 #include <array>
+#include <atomic>
 #include <memory>
 #include <new>
 
@@ -109,6 +114,24 @@ public:
             filament::Viewport viewport, CameraInfo cameraInfo,
             math::float4 const& userTime, bool needsAlphaChannel) noexcept;
 
+    // Each view owns its per-render-pass arena, so prepare() never contends with other views
+    // on a shared allocator -- a prerequisite for eventually running several views' prepare
+    // phases concurrently.
+    LinearAllocatorArena& getPerRenderPassArena() noexcept { return mPerRenderPassArena; }
+
+    struct ArenaStats {
+        uint32_t sizeBytes = 0;             // current size of the arena backing store
+        uint32_t highWatermarkBytes = 0;    // peak usage in the current sampling window
+        uint32_t overflowCount = 0;         // failed arena allocations since view creation
+    };
+
+    // usage statistics of the per-render-pass arena, e.g. for telemetry
+    ArenaStats getPerRenderPassArenaStats() const noexcept;
+
+    // Grows or shrinks the per-render-pass arena based on recent usage. Called once per
+    // frame by FRenderer, while no RootArenaScope is alive.
+    void adjustPerRenderPassArena(FEngine& engine) noexcept;
+
     void setScene(FScene* scene) { mScene = scene; }
     FScene const* getScene() const noexcept { return mScene; }
     FScene* getScene() noexcept { return mScene; }
@@ -130,12 +153,53 @@ public:
     void setFrustumCullingEnabled(bool culling) noexcept { mCulling = culling; }
     bool isFrustumCullingEnabled() const noexcept { return mCulling; }
 
+    // Occlusion culling (latency-tolerant). Results are produced one frame late by an
+    // occlusion source -- e.g. a depth-pyramid test against last frame's depth -- and
+    // applied as a mask on top of frustum culling during prepare().
+    void setOcclusionCullingEnabled(bool enabled) noexcept { mOcclusionCulling = enabled; }
+    bool isOcclusionCullingEnabled() const noexcept { return mOcclusionCulling; }
+
+    // Supplies occlusion results to apply on the next frame: one entry per renderable in
+    // scene order, non-zero meaning "occluded". The results are dropped if the scene's
+    // renderable count changes, since entries would no longer line up.
+    void setOcclusionResults(utils::FixedCapacityVector<uint8_t> results) noexcept {
+        mOcclusionResults = std::move(results);
+    }
+
+    // Precomputed visibility (PVS) for scenes with room/portal structure, baked offline
+    // against this view's scene. During prepare() the cell containing the culling camera is
+    // looked up and its bitset is intersected with the frustum culling results. The database
+    // is ignored when its renderable count doesn't match the scene (entries no longer line
+    // up), or when the camera is outside the cell grid.
+    void setPvsDatabase(PvsDatabase database) noexcept { mPvsDatabase = std::move(database); }
+    PvsDatabase const& getPvsDatabase() const noexcept { return mPvsDatabase; }
+
     void setFrontFaceWindingInverted(bool inverted) noexcept { mFrontFaceWindingInverted = inverted; }
     bool isFrontFaceWindingInverted() const noexcept { return mFrontFaceWindingInverted; }
 
     void setTransparentPickingEnabled(bool enabled) noexcept { mIsTransparentPickingEnabled = enabled; }
     bool isTransparentPickingEnabled() const noexcept { return mIsTransparentPickingEnabled; }
 
+    void setContinuousPickingEnabled(bool enabled) noexcept { mIsContinuousPickingEnabled = enabled; }
+    bool isContinuousPickingEnabled() const noexcept { return mIsContinuousPickingEnabled; }
+
+    void setStreamingFeedbackEnabled(bool enabled) noexcept { mIsStreamingFeedbackEnabled = enabled; }
+    bool isStreamingFeedbackEnabled() const noexcept { return mIsStreamingFeedbackEnabled; }
+
+    void setShadowSharingGroup(uint8_t group) noexcept { mShadowSharingGroup = group; }
+    uint8_t getShadowSharingGroup() const noexcept { return mShadowSharingGroup; }
+
+    void setAutoExposureEnabled(bool enabled) noexcept;
+    bool isAutoExposureEnabled() const noexcept { return mIsAutoExposureEnabled; }
+
+    // dimension (in pixels) of the scaled-down frame used to meter the scene luminance
+    static constexpr uint32_t AUTO_EXPOSURE_METERING_SIZE = 16u;
+
+    // Creates the pixel buffer the auto-exposure metering pass reads the scaled-down frame
+    // into. The buffer's completion callback performs the adaptation, so the readback never
+    // blocks; the adapted value is consumed by prepare() on a later frame.
+    backend::PixelBufferDescriptor makeAutoExposureMeteringBuffer() noexcept;
+
 
     void setVisibleLayers(uint8_t select, uint8_t values) noexcept;
     uint8_t getVisibleLayers() const noexcept {
@@ -178,6 +242,12 @@ public:
     utils::JobSystem::Job* getFroxelizerSync() const noexcept { return mFroxelizerSync; }
     void setFroxelizerSync(utils::JobSystem::Job* sync) noexcept { mFroxelizerSync = sync; }
 
+    // telemetry counters, sampled by the renderer after the frame's passes are built
+    Froxelizer const& getFroxelizer() const noexcept { return mFroxelizer; }
+    uint32_t getShadowPassCount() const noexcept {
+        return mShadowMapManager ? mShadowMapManager->getShadowPassCount() : 0u;
+    }
+
     // ultimately decides to use the DIR variant
     bool hasDirectionalLighting() const noexcept { return mHasDirectionalLighting; }
 
@@ -194,7 +264,9 @@ public:
     bool hasVSM() const noexcept { return mShadowType == ShadowType::VSM; }
     bool hasDPCF() const noexcept { return mShadowType == ShadowType::DPCF; }
     bool hasPCSS() const noexcept { return mShadowType == ShadowType::PCSS; }
-    bool hasPicking() const noexcept { return mActivePickingQueriesList != nullptr; }
+    bool hasPicking() const noexcept {
+        return mActivePickingQueriesList != nullptr || mIsContinuousPickingEnabled;
+    }
     bool hasStereo() const noexcept {
         return mIsStereoSupported && mStereoscopicOptions.enabled;
     }
@@ -203,6 +275,11 @@ public:
             CameraInfo const& cameraInfo, math::float4 const& userTime,
             RenderPassBuilder const& passBuilder) noexcept;
 
+    FrameGraphId<FrameGraphTexture> importShadowMaps(FEngine& engine, FrameGraph& fg,
+            CameraInfo const& cameraInfo,
+            FrameGraphTexture::Descriptor const& desc,
+            FrameGraphTexture const& texture) noexcept;
+
     static void updatePrimitivesLod(FScene::RenderableSoa& renderableData,
             FEngine const& engine, CameraInfo const& camera,
             Range visible) noexcept;
@@ -315,6 +392,18 @@ public:
         return mDynamicResolution;
     }
 
+    // Runs the dynamic quality control loop for this frame and returns the degradation
+    // level ([0, 3], 0 = full quality) the renderer applies to this frame's quality knobs.
+    uint8_t updateQualityDegradation(details::FrameInfo const& info,
+            Renderer::FrameRateOptions const& frameRateOptions,
+            Renderer::DisplayInfo const& displayInfo) noexcept;
+
+    void setDynamicQualityOptions(View::DynamicQualityOptions const& options) noexcept;
+
+    DynamicQualityOptions getDynamicQualityOptions() const noexcept {
+        return mDynamicQuality;
+    }
+
     void setRenderQuality(RenderQuality const& renderQuality) noexcept {
         mRenderQuality = renderQuality;
     }
@@ -415,6 +504,19 @@ public:
         return mCullingCamera != nullptr;
     }
 
+    // Retained-mode command buffer for the color pass. The scene's content generation is a
+    // sum of monotonic change counters (entities, transforms, renderables, material raster
+    // state); when it hasn't moved since the commands were recorded, RenderPass reuses them
+    // and skips generation and sorting entirely.
+    RenderPass::CachedCommandBuffer* getColorPassCachedCommands(FScene const& scene) noexcept {
+        uint32_t const generation = scene.getContentGeneration();
+        if (generation != mLastContentGeneration) {
+            mLastContentGeneration = generation;
+            mColorPassCommandCache.invalidate();
+        }
+        return &mColorPassCommandCache;
+    }
+
     backend::Handle<backend::HwRenderTarget> getRenderTargetHandle() const noexcept {
         backend::Handle<backend::HwRenderTarget> const kEmptyHandle;
         return mRenderTarget == nullptr ? kEmptyHandle : mRenderTarget->getHwHandle();
@@ -431,6 +533,20 @@ public:
     static void cullRenderables(utils::JobSystem& js, FScene::RenderableSoa& renderableData,
             Frustum const& frustum, size_t bit) noexcept;
 
+    // Second, finer-grained culling pass: for renderables that survived frustum culling and
+    // declared per-primitive bounding boxes, computes one visible bit per primitive (see
+    // FScene::PRIMITIVE_VISIBLE_MASK), consumed by RenderPass::generateCommands().
+    static void cullPrimitives(FScene::RenderableSoa& renderableData,
+            Frustum const& frustum) noexcept;
+
+    // Frustum culling with a temporal coherence cache: renderables whose last result still
+    // has enough slack against the frustum drift measured since keep it without being
+    // re-tested. Object motion isn't modeled by the drift bound, so the cache is dropped
+    // wholesale whenever the scene's content generation moves. Only used for the main
+    // view's visibility; shadow passes go through cullRenderables() directly.
+    void cullRenderablesTemporal(utils::JobSystem& js, FScene::RenderableSoa& renderableData,
+            Frustum const& frustum, size_t bit) const noexcept;
+
     ColorPassDescriptorSet& getColorPassDescriptorSet() noexcept { return mColorPassDescriptorSet; }
 
     // Returns the frame history FIFO. This is typically used by the FrameGraph to access
@@ -452,7 +568,8 @@ public:
             View::PickingQueryResultCallback callback) noexcept;
 
     void executePickingQueries(backend::DriverApi& driver,
-            backend::RenderTargetHandle handle, math::float2 scale) noexcept;
+            backend::RenderTargetHandle handle, math::float2 scale,
+            uint32_t width, uint32_t height) noexcept;
 
     void setMaterialGlobal(uint32_t index, math::float4 const& value);
 
@@ -493,8 +610,28 @@ private:
         PickingQueryResult result;
     };
 
+    // CPU-side copies of the picking buffer used by continuous picking. One entry is
+    // being read back while another holds the most recent completed snapshot that queries
+    // are resolved from (about two frames of latency). Held through a shared_ptr because
+    // a readback can still be in flight when the View is destroyed.
+    struct PickingSnapshotRing {
+        struct Snapshot {
+            std::unique_ptr<math::float2[]> data{};
+            uint32_t width = 0;
+            uint32_t height = 0;
+            bool inFlight = false;
+        };
+        static constexpr size_t COUNT = 3;
+        Snapshot snapshots[COUNT];
+        size_t head = 0;        // next snapshot to read back into
+        int32_t latest = -1;    // most recent completed snapshot, -1 if none yet
+    };
+
     void prepareVisibleRenderables(utils::JobSystem& js,
-            Frustum const& frustum, FScene::RenderableSoa& renderableData) const noexcept;
+            Frustum const& frustum, math::float3 const& cameraPosition,
+            FScene::RenderableSoa& renderableData) const noexcept;
+
+    void updateStreamingFeedback(FEngine& engine, CameraInfo const& cameraInfo) const noexcept;
 
     static void prepareVisibleLights(FLightManager const& lcm,
             utils::Slice<float> scratch,
@@ -531,10 +668,37 @@ private:
     mutable Froxelizer mFroxelizer;
     utils::JobSystem::Job* mFroxelizerSync = nullptr;
 
+    RenderPass::CachedCommandBuffer mColorPassCommandCache;
+    uint32_t mLastContentGeneration = 0;
+
     Viewport mViewport;
     bool mCulling = true;
+    bool mOcclusionCulling = false;
     bool mFrontFaceWindingInverted = false;
     bool mIsTransparentPickingEnabled = true;
+    bool mIsContinuousPickingEnabled = false;
+    bool mIsStreamingFeedbackEnabled = false;
+    bool mIsAutoExposureEnabled = false;
+    uint8_t mShadowSharingGroup = 0;
+
+    // per-renderable occlusion results for the current frame (computed from the previous
+    // frame's depth), empty when no results are available
+    utils::FixedCapacityVector<uint8_t> mOcclusionResults;
+
+    // precomputed visibility cells, empty when the feature is unused
+    PvsDatabase mPvsDatabase;
+
+    // temporal culling cache: per-renderable slack banked by the last full frustum test
+    // and spent against the frustum drift measured since (see cullRenderablesTemporal())
+    struct TemporalCullingCache {
+        Frustum frustum;                                // reference the margins were banked against
+        uint32_t count = 0;                             // renderable count the entries map to
+        uint32_t generation = 0;                        // scene content generation at banking time
+        utils::FixedCapacityVector<float> margins;      // drift budget before a result can flip
+        utils::FixedCapacityVector<float> reaches;      // |center| + |extent|, scales rotational drift
+        utils::FixedCapacityVector<uint8_t> results;    // cached visibility bit per renderable
+    };
+    mutable TemporalCullingCache mTemporalCullingCache;
 
     FRenderTarget* mRenderTarget = nullptr;
 
@@ -569,14 +733,37 @@ private:
     math::float2 mScale = 1.0f;
     bool mIsDynamicResolutionSupported = false;
 
+    DynamicQualityOptions mDynamicQuality;
+    uint8_t mQualityDegradation = 0;            // current level, [0, maxDegradation]
+    uint16_t mOverBudgetFrameCount = 0;         // consecutive frames over budget
+    uint16_t mUnderBudgetFrameCount = 0;        // consecutive frames comfortably under budget
+    // per-frame copy of the directional light's ShadowOptions with the cascade count
+    // clamped; referenced by the ShadowMapManager for the rest of the frame
+    FLightManager::ShadowOptions mDegradedShadowOptions;
+
     RenderQuality mRenderQuality;
 
     mutable TypedUniformBuffer<PerViewUib> mUniforms;
     mutable ColorPassDescriptorSet mColorPassDescriptorSet;
 
+    LinearAllocatorArena mPerRenderPassArena;
+    uint32_t mPerRenderPassArenaFrames = 0;     // frames since the last watermark window reset
+    uint32_t mPerRenderPassArenaOverflows = 0;  // overflows carried over from discarded arenas
+
     mutable FrameHistory mFrameHistory{};
 
     FPickingQuery* mActivePickingQueriesList = nullptr;
+    std::shared_ptr<PickingSnapshotRing> mPickingSnapshotRing;
+
+    // Auto-exposure adaptation state. shared_ptr because the metering readback can still be
+    // in flight when the View is destroyed; atomics because the readback callback can run on
+    // a different thread than prepare().
+    struct AutoExposureState {
+        std::atomic<float> adaptedEv100{ 0.0f };
+        std::atomic<bool> hasSample{ false };
+    };
+    std::shared_ptr<AutoExposureState> mAutoExposureState;
+    float mLastPreparedEv100 = 0.0f;
 
     utils::CString mName;
 
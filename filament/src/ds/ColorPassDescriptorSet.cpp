@@ -447,6 +447,16 @@ void ColorPassDescriptorSet::prepareDynamicLights(Froxelizer& froxelizer) noexce
     s.lightFarAttenuationParams = 0.5f * float2{ 10.0f, 10.0f / (f * f) };
 }
 
+void ColorPassDescriptorSet::prepareFroxelBuffers(backend::BufferObjectHandle recordBuffer,
+        backend::BufferObjectHandle froxelBuffer) noexcept {
+    for (auto&& descriptorSet: mDescriptorSet) {
+        descriptorSet.setBuffer(+PerViewBindingPoints::RECORD_BUFFER,
+                recordBuffer, 0, sizeof(FroxelRecordUib));
+        descriptorSet.setBuffer(+PerViewBindingPoints::FROXEL_BUFFER,
+                froxelBuffer, 0, sizeof(FroxelsUib));
+    }
+}
+
 void ColorPassDescriptorSet::prepareShadowMapping(backend::BufferObjectHandle shadowUniforms, bool highPrecision) noexcept {
     auto& s = mUniforms.edit();
     constexpr float low  = 5.54f; // ~ std::log(std::numeric_limits<math::half>::max()) * 0.5f;
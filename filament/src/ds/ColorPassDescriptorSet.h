@@ -137,6 +137,10 @@ public:
 
     void prepareDynamicLights(Froxelizer& froxelizer) noexcept;
 
+    // rebinds the (double-buffered) froxel/record buffers after Froxelizer::commit() swapped them
+    void prepareFroxelBuffers(backend::BufferObjectHandle recordBuffer,
+            backend::BufferObjectHandle froxelBuffer) noexcept;
+
     void prepareShadowVSM(TextureHandle texture,
             ShadowMappingUniforms const& shadowMappingUniforms,
             VsmShadowOptions const& options) noexcept;
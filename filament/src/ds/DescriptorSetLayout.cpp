@@ -32,7 +32,8 @@ DescriptorSetLayout::DescriptorSetLayout() noexcept = default;
 DescriptorSetLayout::DescriptorSetLayout(
         HwDescriptorSetLayoutFactory& factory,
         backend::DriverApi& driver,
-        backend::DescriptorSetLayout descriptorSetLayout) noexcept  {
+        backend::DescriptorSetLayout descriptorSetLayout,
+        size_t precomputedHash) noexcept  {
     for (auto&& desc : descriptorSetLayout.bindings) {
         mMaxDescriptorBinding = std::max(mMaxDescriptorBinding, desc.binding);
         mSamplers.set(desc.binding,
@@ -43,7 +44,8 @@ DescriptorSetLayout::DescriptorSetLayout(
     }
 
     mDescriptorSetLayoutHandle = factory.create(driver,
-            std::move(descriptorSetLayout));
+            std::move(descriptorSetLayout), precomputedHash);
+    mClusterId = factory.getClusterId(mDescriptorSetLayoutHandle);
 }
 
 void DescriptorSetLayout::terminate(
@@ -37,7 +37,8 @@ public:
     DescriptorSetLayout(
             HwDescriptorSetLayoutFactory& factory,
             backend::DriverApi& driver,
-            backend::DescriptorSetLayout descriptorSetLayout) noexcept;
+            backend::DescriptorSetLayout descriptorSetLayout,
+            size_t precomputedHash = 0) noexcept;
 
     DescriptorSetLayout(DescriptorSetLayout const&) = delete;
     DescriptorSetLayout(DescriptorSetLayout&& rhs) noexcept;
@@ -56,6 +57,12 @@ public:
         return mMaxDescriptorBinding;
     }
 
+    // id of the layout-compatibility cluster this layout belongs to,
+    // see HwDescriptorSetLayoutFactory::getClusterId()
+    uint8_t getClusterId() const noexcept {
+        return mClusterId;
+    }
+
     bool isSampler(backend::descriptor_binding_t binding) const noexcept {
         return mSamplers[binding];
     }
@@ -73,6 +80,7 @@ private:
     utils::bitset64 mSamplers;
     utils::bitset64 mUniformBuffers;
     uint8_t mMaxDescriptorBinding = 0;
+    uint8_t mClusterId = 0;
 };
 
 
@@ -38,7 +38,9 @@
 #include <utils/Systrace.h>
 
 #include <algorithm>
+#include <chrono>
 #include <functional>
+#include <utility>
 
 #include <stdint.h>
 
@@ -77,6 +79,7 @@ FrameGraphId<FrameGraphTexture> FrameGraph::Builder::declareRenderPass(
 FrameGraph::FrameGraph(ResourceAllocatorInterface& resourceAllocator, Mode mode)
         : mResourceAllocator(resourceAllocator),
           mArena("FrameGraph Arena", 262144),
+          mGraph(mArena),
           mMode(mode),
           mResourceSlots(mArena),
           mResources(mArena),
@@ -135,6 +138,13 @@ FrameGraph& FrameGraph::compile() noexcept {
         return !pPassNode->isCulled();
     });
 
+    if (UTILS_UNLIKELY(mInstrumentation)) {
+        mInstrumentation->beginFrame(mInstrumentationFrameId);
+        for (auto it = mActivePassNodesEnd, last = mPassNodes.end(); it != last; ++it) {
+            mInstrumentation->addCulledPass((*it)->getName());
+        }
+    }
+
     auto first = mPassNodes.begin();
     const auto activePassNodesEnd = mActivePassNodesEnd;
     while (first != activePassNodesEnd) {
@@ -220,7 +230,16 @@ void FrameGraph::execute(backend::DriverApi& driver) noexcept {
 
         // call execute
         FrameGraphResources const resources(*this, *node);
-        node->execute(resources, driver);
+        if (UTILS_UNLIKELY(mInstrumentation)) {
+            auto const query = mInstrumentation->beginPass(driver, node->getName());
+            auto const start = std::chrono::steady_clock::now();
+            node->execute(resources, driver);
+            auto const stop = std::chrono::steady_clock::now();
+            mInstrumentation->endPass(driver, query,
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count());
+        } else {
+            node->execute(resources, driver);
+        }
 
         // destroy concrete resources
         for (VirtualResource* resource : node->destroy) {
@@ -230,6 +249,10 @@ void FrameGraph::execute(backend::DriverApi& driver) noexcept {
         driver.popGroupMarker();
     }
     driver.popGroupMarker();
+
+    if (UTILS_UNLIKELY(mInstrumentation)) {
+        mInstrumentation->endFrame(driver);
+    }
 }
 
 void FrameGraph::addPresentPass(const std::function<void(FrameGraph::Builder&)>& setup) noexcept {
@@ -322,7 +345,23 @@ FrameGraphHandle FrameGraph::readInternal(FrameGraphHandle handle, PassNode* pas
                 // we have a parent's node for reads, use that one
                 parentNode = mResourceNodes[slot.sid];
             }
-            node->setParentReadDependency(parentNode);
+            // If this version of the parent was assembled purely from subresource writes,
+            // we can depend on just the slices that overlap the one we're reading, instead
+            // of the whole-resource version. This keeps a read of one mip/layer from being
+            // ordered after -- and from keeping alive -- writes to unrelated slices.
+            auto const& sliceWriters = parentNode->getSubResourceWriters();
+            if (parentNode->hasWriterPass() || sliceWriters.empty()) {
+                node->setParentReadDependency(parentNode);
+            } else {
+                for (ResourceNode* const writer : sliceWriters) {
+                    // we can be among the writers ourselves when reading a handle that
+                    // was written to; we clearly don't depend on ourselves.
+                    if (writer != node &&
+                            resource->overlaps(*getResource(writer->resourceHandle))) {
+                        node->addSliceReadDependency(writer);
+                    }
+                }
+            }
         } else {
             // we're reading from a top-level resource (i.e. not a subresource), but this
             // resource is a parent of some subresource, and it might exist as a version for
@@ -481,6 +520,116 @@ void FrameGraph::export_graphviz(utils::io::ostream& out, char const* name) {
 
 // ------------------------------------------------------------------------------------------------
 
+FrameGraph::Instrumentation::~Instrumentation() noexcept {
+    // all timer queries must have been released with terminate()
+    assert_invariant(mFreeQueries.empty());
+    assert_invariant(mInFlight.empty());
+    assert_invariant(mCurrent.queries.empty());
+}
+
+void FrameGraph::Instrumentation::terminate(backend::DriverApi& driver) noexcept {
+    for (auto const& handle : mFreeQueries) {
+        driver.destroyTimerQuery(handle);
+    }
+    mFreeQueries.clear();
+    for (auto const& frame : mInFlight) {
+        for (auto const& query : frame.queries) {
+            driver.destroyTimerQuery(query.handle);
+        }
+    }
+    mInFlight.clear();
+    for (auto const& query : mCurrent.queries) {
+        driver.destroyTimerQuery(query.handle);
+    }
+    mCurrent = {};
+}
+
+backend::TimerQueryHandle FrameGraph::Instrumentation::obtainQuery(backend::DriverApi& driver) noexcept {
+    if (!mFreeQueries.empty()) {
+        auto const handle = mFreeQueries.back();
+        mFreeQueries.pop_back();
+        return handle;
+    }
+    return driver.createTimerQuery();
+}
+
+void FrameGraph::Instrumentation::beginFrame(uint32_t frameId) noexcept {
+    mCurrent.frameId = frameId;
+    mCurrent.records.clear();
+    mCurrent.queries.clear();
+}
+
+void FrameGraph::Instrumentation::addCulledPass(const char* name) noexcept {
+    mCurrent.records.push_back({ utils::CString{ name }, true, 0, 0 });
+}
+
+backend::TimerQueryHandle FrameGraph::Instrumentation::beginPass(backend::DriverApi& driver,
+        const char* name) noexcept {
+    auto const handle = obtainQuery(driver);
+    mCurrent.queries.push_back({ handle, uint32_t(mCurrent.records.size()) });
+    mCurrent.records.push_back({ utils::CString{ name }, false, 0, 0 });
+    driver.beginTimerQuery(handle);
+    return handle;
+}
+
+void FrameGraph::Instrumentation::endPass(backend::DriverApi& driver,
+        backend::TimerQueryHandle query, uint64_t cpuTimeNs) noexcept {
+    driver.endTimerQuery(query);
+    assert_invariant(!mCurrent.queries.empty());
+    assert_invariant(mCurrent.queries.back().handle == query);
+    mCurrent.records[mCurrent.queries.back().recordIndex].cpuTimeNs = cpuTimeNs;
+}
+
+void FrameGraph::Instrumentation::endFrame(backend::DriverApi& driver) noexcept {
+    mInFlight.push_back(std::move(mCurrent));
+    mCurrent = {};
+
+    // resolve in-flight frames, oldest first, as long as all their queries are available
+    while (!mInFlight.empty()) {
+        auto& frame = mInFlight.front();
+        bool complete = true;
+        for (auto const& query : frame.queries) {
+            uint64_t elapsed = 0;
+            backend::TimerQueryResult const result =
+                    driver.getTimerQueryValue(query.handle, &elapsed);
+            if (result == backend::TimerQueryResult::NOT_READY) {
+                complete = false;
+                break;
+            }
+            if (result == backend::TimerQueryResult::AVAILABLE) {
+                frame.records[query.recordIndex].gpuTimeNs = elapsed;
+            }
+            // on ERROR the record's GPU time stays at 0
+        }
+        if (!complete) {
+            break;
+        }
+        for (auto const& query : frame.queries) {
+            mFreeQueries.push_back(query.handle);
+        }
+        mResolvedFrames.push_back({ frame.frameId, std::move(frame.records) });
+        mInFlight.erase(mInFlight.begin());
+    }
+
+    // don't let resolved frames accumulate if nobody collects them
+    constexpr size_t MAX_RESOLVED_FRAMES = 8;
+    if (UTILS_UNLIKELY(mResolvedFrames.size() > MAX_RESOLVED_FRAMES)) {
+        mResolvedFrames.erase(mResolvedFrames.begin());
+    }
+
+    // don't let frames accumulate if the GPU never reports results
+    constexpr size_t MAX_IN_FLIGHT_FRAMES = 4;
+    if (UTILS_UNLIKELY(mInFlight.size() > MAX_IN_FLIGHT_FRAMES)) {
+        auto& frame = mInFlight.front();
+        for (auto const& query : frame.queries) {
+            mFreeQueries.push_back(query.handle);
+        }
+        mInFlight.erase(mInFlight.begin());
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+
 /*
  * Explicit template instantiation for FrameGraphTexture which is a known type,
  * to reduce compile time and code size.
@@ -34,7 +34,12 @@
 #include <backend/DriverEnums.h>
 #include <backend/Handle.h>
 
+#include <utils/CString.h>
+
 #include <functional>
+#include <vector>
+
+#include <stdint.h>
 
 namespace filament {
 
@@ -223,6 +228,70 @@ public:
         PROTECTED,
     };
 
+    /**
+     * Optional per-pass instrumentation. The Instrumentation object is owned by the
+     * caller and must outlive the (per-frame) FrameGraph, because GPU times come back
+     * with a few frames of latency. Attach it with setInstrumentation() before compile().
+     *
+     * For each frame it records which passes were culled during compile() and, for
+     * surviving passes, the CPU time spent in the execute lambda and the GPU elapsed
+     * time measured with backend timer queries. Frames whose GPU results are all
+     * available accumulate until they are collected with takeResolvedFrames().
+     */
+    class Instrumentation {
+        friend class FrameGraph;
+    public:
+        struct PassRecord {
+            utils::CString name;
+            bool culled = false;
+            uint64_t cpuTimeNs = 0;     // CPU time spent in the execute lambda
+            uint64_t gpuTimeNs = 0;     // GPU elapsed time, 0 if culled
+        };
+        using PassRecordContainer = std::vector<PassRecord>;
+
+        struct FrameRecord {
+            uint32_t frameId = 0;       // frame id given to setInstrumentation()
+            PassRecordContainer records;
+        };
+
+        Instrumentation() noexcept = default;
+        ~Instrumentation() noexcept;
+
+        // must be called before destruction, releases the timer queries
+        void terminate(backend::DriverApi& driver) noexcept;
+
+        // moves out the fully-resolved frames accumulated so far, oldest first
+        std::vector<FrameRecord> takeResolvedFrames() noexcept {
+            return std::move(mResolvedFrames);
+        }
+
+    private:
+        struct PendingQuery {
+            backend::TimerQueryHandle handle;
+            uint32_t recordIndex;
+        };
+        struct PendingFrame {
+            uint32_t frameId = 0;
+            PassRecordContainer records;
+            std::vector<PendingQuery> queries;
+        };
+
+        void beginFrame(uint32_t frameId) noexcept;
+        void addCulledPass(const char* name) noexcept;
+        backend::TimerQueryHandle beginPass(backend::DriverApi& driver,
+                const char* name) noexcept;
+        void endPass(backend::DriverApi& driver, backend::TimerQueryHandle query,
+                uint64_t cpuTimeNs) noexcept;
+        void endFrame(backend::DriverApi& driver) noexcept;
+
+        backend::TimerQueryHandle obtainQuery(backend::DriverApi& driver) noexcept;
+
+        PendingFrame mCurrent;                      // frame being recorded
+        std::vector<PendingFrame> mInFlight;        // frames waiting for GPU results
+        std::vector<FrameRecord> mResolvedFrames;   // frames with all results in
+        std::vector<backend::TimerQueryHandle> mFreeQueries;
+    };
+
     explicit FrameGraph(ResourceAllocatorInterface& resourceAllocator,
             Mode mode = Mode::UNPROTECTED);
     FrameGraph(FrameGraph const&) = delete;
@@ -285,6 +354,16 @@ public:
     template<typename Execute>
     void addTrivialSideEffectPass(const char* name, Execute&& execute);
 
+    /**
+     * Attaches an optional per-pass instrumentation recorder. Must be called before
+     * compile(). Pass nullptr to disable. frameId is recorded with the frame's pass
+     * records so the caller can attribute them once the GPU results come back.
+     */
+    void setInstrumentation(Instrumentation* instrumentation, uint32_t frameId = 0) noexcept {
+        mInstrumentation = instrumentation;
+        mInstrumentationFrameId = frameId;
+    }
+
     /**
      * Allocates concrete resources and culls unreferenced passes.
      * @return a reference to the FrameGraph, for chaining calls.
@@ -530,6 +609,8 @@ private:
     Vector<ResourceNode*> mResourceNodes;
     Vector<PassNode*> mPassNodes;
     Vector<PassNode*>::iterator mActivePassNodesEnd;
+    Instrumentation* mInstrumentation = nullptr;
+    uint32_t mInstrumentationFrameId = 0;
 };
 
 template<typename Data, typename Setup, typename Execute>
@@ -602,7 +683,7 @@ FrameGraphId<RESOURCE> FrameGraph::read(PassNode* passNode, FrameGraphId<RESOURC
     FrameGraphId<RESOURCE> result(readInternal(input, passNode,
             [this, passNode, usage](ResourceNode* node, VirtualResource* vrsrc) {
                 Resource<RESOURCE>* resource = static_cast<Resource<RESOURCE>*>(vrsrc);
-                return resource->connect(mGraph, node, passNode, usage);
+                return resource->connect(mArena, mGraph, node, passNode, usage);
             }));
     return result;
 }
@@ -613,7 +694,7 @@ FrameGraphId<RESOURCE> FrameGraph::write(PassNode* passNode, FrameGraphId<RESOUR
     FrameGraphId<RESOURCE> result(writeInternal(input, passNode,
             [this, passNode, usage](ResourceNode* node, VirtualResource* vrsrc) {
                 Resource<RESOURCE>* resource = static_cast<Resource<RESOURCE>*>(vrsrc);
-                return resource->connect(mGraph, passNode, node, usage);
+                return resource->connect(mArena, mGraph, passNode, node, usage);
             }));
     return result;
 }
@@ -47,6 +47,19 @@ void FrameGraphTexture::destroy(ResourceAllocatorInterface& resourceAllocator) n
     }
 }
 
+FrameGraphTexture::Usage FrameGraphTexture::getTransientUsage(Usage const usage) noexcept {
+    using namespace backend;
+    if ((usage & ~TextureUsage::ALL_ATTACHMENTS) == TextureUsage::NONE) {
+        return TextureUsage::TRANSIENT_ATTACHMENT;
+    }
+    return TextureUsage::NONE;
+}
+
+bool FrameGraphTexture::subResourcesOverlap(SubResourceDescriptor const& lhs,
+        SubResourceDescriptor const& rhs) noexcept {
+    return lhs.level == rhs.level && lhs.layer == rhs.layer;
+}
+
 FrameGraphTexture::Descriptor FrameGraphTexture::generateSubResourceDescriptor(
         Descriptor descriptor,
         SubResourceDescriptor const& srd) noexcept {
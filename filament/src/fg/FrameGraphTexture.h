@@ -37,6 +37,7 @@ namespace filament {
  *      void create(ResourceAllocatorInterface&, const char* name, Descriptor const&, Usage,
  *              bool useProtectedMemory) noexcept;
  *      void destroy(ResourceAllocatorInterface&) noexcept;
+ *      static Usage getTransientUsage(Usage) noexcept;
  */
 struct FrameGraphTexture {
     backend::Handle<backend::HwTexture> handle;
@@ -87,6 +88,26 @@ struct FrameGraphTexture {
      */
     void destroy(ResourceAllocatorInterface& resourceAllocator) noexcept;
 
+    /**
+     * Returns the usage bits to add when the resource's entire lifetime is confined to a
+     * single pass. Attachment-only textures qualify for transient (tile-only) storage;
+     * anything sampled, uploaded or blitted needs system-memory backing.
+     * @param usage the resource's resolved usage
+     * @return      additional usage bits, or Usage::NONE if the resource doesn't qualify
+     */
+    static Usage getTransientUsage(Usage usage) noexcept;
+
+    /**
+     * Returns whether two sub-resources of the same texture designate overlapping storage.
+     * Used by the frame graph to decide if a read from one slice must be ordered after a
+     * write to another.
+     * @param lhs a SubResourceDescriptor of a texture
+     * @param rhs a SubResourceDescriptor of the same texture
+     * @return    true if the sub-resources overlap
+     */
+    static bool subResourcesOverlap(SubResourceDescriptor const& lhs,
+            SubResourceDescriptor const& rhs) noexcept;
+
     /**
      * Generates the Descriptor for a subresource from its parent Descriptor and its
      * SubResourceDescriptor
@@ -50,6 +50,10 @@ void PassNode::registerResource(FrameGraphHandle resourceHandle) noexcept {
     mDeclaredHandles.insert(resourceHandle.index);
 }
 
+bool PassNode::overwritesAttachment(FrameGraphHandle) const noexcept {
+    return false;
+}
+
 // ------------------------------------------------------------------------------------------------
 
 RenderPassNode::RenderPassNode(FrameGraph& fg, const char* name, FrameGraphPassBase* base) noexcept
@@ -123,6 +127,32 @@ uint32_t RenderPassNode::declareRenderTarget(FrameGraph& fg, FrameGraph::Builder
     return id;
 }
 
+bool RenderPassNode::overwritesAttachment(FrameGraphHandle handle) const noexcept {
+    for (auto const& rt : mRenderTargetData) {
+        size_t found = RenderPassData::ATTACHMENT_COUNT;
+        bool imported = false;
+        for (size_t i = 0; i < RenderPassData::ATTACHMENT_COUNT; i++) {
+            if (rt.descriptor.attachments.array[i]) {
+                // an imported render target overrides the clear flags during resolve(),
+                // which may not have run for this pass yet -- be conservative.
+                imported = imported || bool(mFrameGraph.getResource(
+                        rt.descriptor.attachments.array[i])->asImportedRenderTarget());
+                if (rt.descriptor.attachments.array[i] == handle) {
+                    found = i;
+                }
+            }
+        }
+        if (found != RenderPassData::ATTACHMENT_COUNT) {
+            // clearing or explicitly discarding the attachment on start implies we don't
+            // consume its previous content
+            return !imported && any((rt.descriptor.clearFlags | rt.descriptor.discardStart)
+                    & getTargetBufferFlagsAt(found));
+        }
+    }
+    // the resource isn't used as an attachment by this pass, so this is a real read
+    return false;
+}
+
 void RenderPassNode::resolve() noexcept {
     using namespace backend;
 
@@ -154,9 +184,14 @@ void RenderPassNode::resolve() noexcept {
                 // Discard at the end only if we are writing to this attachment AND later reading
                 // from it. (in particular, don't discard if we're not writing at all, because this
                 // attachment might have other readers after us).
+                // We can also discard when every active reader overwrites the attachment
+                // without consuming its content (it clears it on load): the store -- and the
+                // implicit MSAA resolve, if any -- is then useless, which on tilers saves a
+                // full-surface store+load per affected pass.
                 // TODO: we could set the discard flag if we are the last reader, i.e.
                 //       if rt->incoming[i] last reader is us.
-                if (rt.outgoing[i] && !rt.outgoing[i]->hasActiveReaders()) {
+                if (rt.outgoing[i] && (!rt.outgoing[i]->hasActiveReaders() ||
+                        rt.outgoing[i]->hasOnlyOverwritingActiveReaders())) {
                     rt.backend.params.flags.discardEnd |= target;
                 }
                 if (!rt.outgoing[i] || !rt.outgoing[i]->hasWriterPass()) {
@@ -191,9 +226,9 @@ void RenderPassNode::resolve() noexcept {
                 maxHeight = std::max(maxHeight, h);
             }
         }
-        // additionally, clear implies discardStart
+        // additionally, clear or an explicit discard request implies discardStart
         rt.backend.params.flags.discardStart |= (
-                rt.descriptor.clearFlags & rt.targetBufferFlags);
+                (rt.descriptor.clearFlags | rt.descriptor.discardStart) & rt.targetBufferFlags);
 
         assert_invariant(minWidth == maxWidth);
         assert_invariant(minHeight == maxHeight);
@@ -105,18 +105,18 @@ void ImportedRenderTarget::assertConnect(FrameGraphTexture::Usage u) {
             << "\" can only be used as an attachment (usage=" << utils::to_string(u).c_str() << ')';
 }
 
-bool ImportedRenderTarget::connect(DependencyGraph& graph, PassNode* passNode,
-        ResourceNode* resourceNode, TextureUsage u) {
+bool ImportedRenderTarget::connect(LinearAllocatorArena& arena, DependencyGraph& graph,
+        PassNode* passNode, ResourceNode* resourceNode, TextureUsage u) {
     // pass Node to resource Node edge (a write to)
     assertConnect(u);
-    return Resource::connect(graph, passNode, resourceNode, u);
+    return Resource::connect(arena, graph, passNode, resourceNode, u);
 }
 
-bool ImportedRenderTarget::connect(DependencyGraph& graph, ResourceNode* resourceNode,
-        PassNode* passNode, TextureUsage u) {
+bool ImportedRenderTarget::connect(LinearAllocatorArena& arena, DependencyGraph& graph,
+        ResourceNode* resourceNode, PassNode* passNode, TextureUsage u) {
     // resource Node to pass Node edge (a read from)
     assertConnect(u);
-    return Resource::connect(graph, resourceNode, passNode, u);
+    return Resource::connect(arena, graph, resourceNode, passNode, u);
 }
 
 FrameGraphTexture::Usage ImportedRenderTarget::usageFromAttachmentsFlags(
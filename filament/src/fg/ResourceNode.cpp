@@ -22,19 +22,24 @@ namespace filament {
 
 ResourceNode::ResourceNode(FrameGraph& fg, FrameGraphHandle h, FrameGraphHandle parent) noexcept
         : DependencyGraph::Node(fg.getGraph()),
-          resourceHandle(h), mFrameGraph(fg), mReaderPasses(fg.getArena()), mParentHandle(parent) {
+          resourceHandle(h), mFrameGraph(fg), mReaderPasses(fg.getArena()), mParentHandle(parent),
+          mSubResourceWriters(fg.getArena()), mSliceReadEdges(fg.getArena()) {
 }
 
 ResourceNode::~ResourceNode() noexcept {
     VirtualResource* resource = mFrameGraph.getResource(resourceHandle);
     assert_invariant(resource);
-    resource->destroyEdge(mWriterPass);
+    LinearAllocatorArena& arena = mFrameGraph.getArena();
+    resource->destroyEdge(arena, mWriterPass);
     for (auto* pEdge : mReaderPasses) {
-        resource->destroyEdge(pEdge);
+        resource->destroyEdge(arena, pEdge);
+    }
+    arena.destroy(mParentReadEdge);
+    arena.destroy(mParentWriteEdge);
+    arena.destroy(mForwardedEdge);
+    for (auto* pEdge : mSliceReadEdges) {
+        arena.destroy(pEdge);
     }
-    delete mParentReadEdge;
-    delete mParentWriteEdge;
-    delete mForwardedEdge;
 }
 
 ResourceNode* ResourceNode::getParentNode() noexcept {
@@ -78,6 +83,28 @@ bool ResourceNode::hasActiveReaders() const noexcept {
     return false;
 }
 
+bool ResourceNode::hasOnlyOverwritingActiveReaders() const noexcept {
+    // here we don't use mReaderPasses because this wouldn't account for subresources
+    DependencyGraph& dependencyGraph = mFrameGraph.getGraph();
+    auto const& readers = dependencyGraph.getOutgoingEdges(this);
+    for (auto const& reader : readers) {
+        DependencyGraph::Node const* const node = dependencyGraph.getNode(reader->to);
+        if (node->isCulled()) {
+            continue;
+        }
+        // only the edges recorded in mReaderPasses lead to a PassNode; any other edge is
+        // a subresource dependency, which we conservatively treat as a real read.
+        auto pos = std::find(mReaderPasses.begin(), mReaderPasses.end(), reader);
+        if (pos == mReaderPasses.end()) {
+            return false;
+        }
+        if (!static_cast<PassNode const*>(node)->overwritesAttachment(resourceHandle)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool ResourceNode::hasActiveWriters() const noexcept {
     // here we don't use mReaderPasses because this wouldn't account for subresources
     DependencyGraph const& dependencyGraph = mFrameGraph.getGraph();
@@ -105,20 +132,39 @@ bool ResourceNode::hasWriteFrom(PassNode const* node) const noexcept {
 
 void ResourceNode::setParentReadDependency(ResourceNode* parent) noexcept {
     if (!mParentReadEdge) {
-        mParentReadEdge = new DependencyGraph::Edge(mFrameGraph.getGraph(), parent, this);
+        mParentReadEdge = mFrameGraph.getArena().make<DependencyGraph::Edge>(
+                mFrameGraph.getGraph(), parent, this);
     }
 }
 
 
 void ResourceNode::setParentWriteDependency(ResourceNode* parent) noexcept {
     if (!mParentWriteEdge) {
-        mParentWriteEdge = new DependencyGraph::Edge(mFrameGraph.getGraph(), this, parent);
+        mParentWriteEdge = mFrameGraph.getArena().make<DependencyGraph::Edge>(
+                mFrameGraph.getGraph(), this, parent);
+        // record which slice this version of the parent was assembled from, so readers of
+        // a single slice can depend on just the writers that overlap it
+        parent->mSubResourceWriters.push_back(this);
+    }
+}
+
+void ResourceNode::addSliceReadDependency(ResourceNode* writer) noexcept {
+    // we can be called several times with the same writer (e.g. multiple read() calls),
+    // only one edge is needed
+    auto pos = std::find_if(mSliceReadEdges.begin(), mSliceReadEdges.end(),
+            [writer](DependencyGraph::Edge const* edge) {
+                return edge->from == writer->getId();
+            });
+    if (pos == mSliceReadEdges.end()) {
+        mSliceReadEdges.push_back(mFrameGraph.getArena().make<DependencyGraph::Edge>(
+                mFrameGraph.getGraph(), writer, this));
     }
 }
 
 void ResourceNode::setForwardResourceDependency(ResourceNode* source) noexcept {
     assert_invariant(!mForwardedEdge);
-    mForwardedEdge = new DependencyGraph::Edge(mFrameGraph.getGraph(), this, source);
+    mForwardedEdge = mFrameGraph.getArena().make<DependencyGraph::Edge>(
+            mFrameGraph.getGraph(), this, source);
 }
 
 
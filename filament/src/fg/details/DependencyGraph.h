@@ -17,9 +17,10 @@
 #ifndef TNT_FILAMENT_FG_DETAILS_DEPENDENCYGRAPH_H
 #define TNT_FILAMENT_FG_DETAILS_DEPENDENCYGRAPH_H
 
+#include "Utilities.h"
+
 #include <utils/ostream.h>
 #include <utils/CString.h>
-#include <utils/FixedCapacityVector.h>
 #include <utils/debug.h>
 
 #include <vector>
@@ -31,7 +32,9 @@ namespace filament {
  */
 class DependencyGraph {
 public:
-    DependencyGraph() noexcept;
+    // The node and edge tables, as well as the temporary containers used during culling, are
+    // backed by the owner's per-frame linear arena, so graph (re)building is heap-free.
+    explicit DependencyGraph(LinearAllocatorArena& arena) noexcept;
     ~DependencyGraph() noexcept;
     DependencyGraph(const DependencyGraph&) noexcept = delete;
     DependencyGraph& operator=(const DependencyGraph&) noexcept = delete;
@@ -127,8 +130,8 @@ public:
         const NodeID mId;           // unique id
     };
 
-    using EdgeContainer = utils::FixedCapacityVector<Edge*, std::allocator<Edge*>, false>;
-    using NodeContainer = utils::FixedCapacityVector<Node*, std::allocator<Node*>, false>;
+    using EdgeContainer = Vector<Edge*>;
+    using NodeContainer = Vector<Node*>;
 
     /**
      * Removes all edges and nodes from the graph.
@@ -181,6 +184,7 @@ private:
     void registerNode(Node* node, NodeID id) noexcept;
     void link(Edge* edge) noexcept;
     static bool isAcyclicInternal(DependencyGraph& graph) noexcept;
+    LinearAllocatorArena& mArena;
     NodeContainer mNodes;
     EdgeContainer mEdges;
 };
@@ -26,6 +26,8 @@
 
 #include <backend/TargetBufferInfo.h>
 
+#include <utils/SmallVector.h>
+
 #include <unordered_set>
 
 namespace utils {
@@ -54,6 +56,11 @@ public:
 
     void registerResource(FrameGraphHandle resourceHandle) noexcept;
 
+    // Returns true if this pass uses the given resource only as an attachment it fully
+    // overwrites (i.e. it clears it and never consumes its previous content). Defaults to
+    // false; used during resolve() to compute store/resolve elision.
+    virtual bool overwritesAttachment(FrameGraphHandle handle) const noexcept;
+
     virtual void execute(FrameGraphResources const& resources, backend::DriverApi& driver) noexcept = 0;
     virtual void resolve() noexcept = 0;
     utils::CString graphvizifyEdgeColor() const noexcept override;
@@ -96,6 +103,7 @@ private:
     // virtuals from DependencyGraph::Node
     char const* getName() const noexcept override { return mName; }
     utils::CString graphvizify() const noexcept override;
+    bool overwritesAttachment(FrameGraphHandle handle) const noexcept override;
     void execute(FrameGraphResources const& resources, backend::DriverApi& driver) noexcept override;
     void resolve() noexcept override;
 
@@ -103,8 +111,9 @@ private:
     const char* const mName = nullptr;
     UniquePtr<FrameGraphPassBase, LinearAllocatorArena> mPassBase;
 
-    // set during setup
-    std::vector<RenderPassData> mRenderTargetData;
+    // set during setup. Most passes declare a single render target, so the first two
+    // entries live in-object and declaring them doesn't hit the heap.
+    utils::SmallVector<RenderPassData, 2> mRenderTargetData;
 };
 
 class PresentPassNode : public PassNode {
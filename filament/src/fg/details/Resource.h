@@ -90,13 +90,19 @@ public:
     /* Destroy the concrete resource */
     virtual void destroy(ResourceAllocatorInterface& resourceAllocator) noexcept = 0;
 
-    /* Destroy an Edge instantiated by this resource */
-    virtual void destroyEdge(DependencyGraph::Edge* edge) noexcept = 0;
+    /* Destroy an Edge instantiated by this resource, returning it to the given arena */
+    virtual void destroyEdge(LinearAllocatorArena& arena, DependencyGraph::Edge* edge) noexcept = 0;
 
     virtual utils::CString usageString() const noexcept = 0;
 
     virtual bool isImported() const noexcept { return false; }
 
+    /*
+     * Returns whether this resource's storage overlaps another resource of the same root.
+     * Whole resources conservatively overlap everything; subresources can be more precise.
+     */
+    virtual bool overlaps(VirtualResource const&) const noexcept { return true; }
+
     // this is to workaround our lack of RTTI -- otherwise we could use dynamic_cast
     virtual ImportedRenderTarget* asImportedRenderTarget() noexcept { return nullptr; }
 
@@ -162,14 +168,14 @@ public:
 
     // pass Node to resource Node edge (a write to)
     UTILS_NOINLINE
-    virtual bool connect(DependencyGraph& graph,
+    virtual bool connect(LinearAllocatorArena& arena, DependencyGraph& graph,
             PassNode* passNode, ResourceNode* resourceNode, Usage u) {
         // TODO: we should check that usage flags are correct (e.g. a write flag is not used for reading)
         ResourceEdge* edge = static_cast<ResourceEdge*>(getWriterEdgeForPass(resourceNode, passNode));
         if (edge) {
             edge->usage |= u;
         } else {
-            edge = new ResourceEdge(graph,
+            edge = arena.make<ResourceEdge>(graph,
                     toDependencyGraphNode(passNode), toDependencyGraphNode(resourceNode), u);
             setIncomingEdge(resourceNode, edge);
         }
@@ -178,7 +184,7 @@ public:
 
     // resource Node to pass Node edge (a read from)
     UTILS_NOINLINE
-    virtual bool connect(DependencyGraph& graph,
+    virtual bool connect(LinearAllocatorArena& arena, DependencyGraph& graph,
             ResourceNode* resourceNode, PassNode* passNode, Usage u) {
         // TODO: we should check that usage flags are correct (e.g. a write flag is not used for reading)
         // if passNode is already a reader of resourceNode, then just update the usage flags
@@ -186,7 +192,7 @@ public:
         if (edge) {
             edge->usage |= u;
         } else {
-            edge = new ResourceEdge(graph,
+            edge = arena.make<ResourceEdge>(graph,
                     toDependencyGraphNode(resourceNode), toDependencyGraphNode(passNode), u);
             addOutgoingEdge(resourceNode, edge);
         }
@@ -225,14 +231,20 @@ protected:
         }
     }
 
-    void destroyEdge(DependencyGraph::Edge* edge) noexcept override {
+    void destroyEdge(LinearAllocatorArena& arena, DependencyGraph::Edge* edge) noexcept override {
         // this Edge is guaranteed to be a ResourceEdge<RESOURCE> by construction
-        delete static_cast<ResourceEdge *>(edge);
+        arena.destroy(static_cast<ResourceEdge *>(edge));
     }
 
     void devirtualize(ResourceAllocatorInterface& resourceAllocator,
             bool useProtectedMemory) noexcept override {
         if (!isSubResource()) {
+            // A resource whose entire lifetime is a single pass can never be observed outside
+            // of it; let the concrete resource take advantage of that, e.g. by using
+            // tile-only (memoryless) storage for attachment-only textures.
+            if (first == last) {
+                usage |= RESOURCE::getTransientUsage(usage);
+            }
             resource.create(resourceAllocator, name, descriptor, usage, useProtectedMemory);
         } else {
             // resource is guaranteed to be initialized before we are by construction
@@ -250,6 +262,16 @@ protected:
     utils::CString usageString() const noexcept override {
         return utils::to_string(usage);
     }
+
+    bool overlaps(VirtualResource const& other) const noexcept override {
+        if (!isSubResource() || !other.isSubResource()) {
+            // a whole resource overlaps all of its slices
+            return true;
+        }
+        // both resources share the same root, so they're guaranteed to be Resource<RESOURCE>
+        auto const& rhs = static_cast<Resource const&>(other);
+        return RESOURCE::subResourcesOverlap(subResourceDescriptor, rhs.subResourceDescriptor);
+    }
 };
 
 /*
@@ -280,17 +302,17 @@ protected:
     bool isImported() const noexcept override { return true; }
 
     UTILS_NOINLINE
-    bool connect(DependencyGraph& graph,
+    bool connect(LinearAllocatorArena& arena, DependencyGraph& graph,
             PassNode* passNode, ResourceNode* resourceNode, FrameGraphTexture::Usage u) override {
         assertConnect(u);
-        return Resource<RESOURCE>::connect(graph, passNode, resourceNode, u);
+        return Resource<RESOURCE>::connect(arena, graph, passNode, resourceNode, u);
     }
 
     UTILS_NOINLINE
-    bool connect(DependencyGraph& graph,
+    bool connect(LinearAllocatorArena& arena, DependencyGraph& graph,
             ResourceNode* resourceNode, PassNode* passNode, FrameGraphTexture::Usage u) override {
         assertConnect(u);
-        return Resource<RESOURCE>::connect(graph, resourceNode, passNode, u);
+        return Resource<RESOURCE>::connect(arena, graph, resourceNode, passNode, u);
     }
 
 private:
@@ -319,11 +341,11 @@ public:
 
 protected:
     UTILS_NOINLINE
-    bool connect(DependencyGraph& graph,
+    bool connect(LinearAllocatorArena& arena, DependencyGraph& graph,
             PassNode* passNode, ResourceNode* resourceNode, FrameGraphTexture::Usage u) override;
 
     UTILS_NOINLINE
-    bool connect(DependencyGraph& graph,
+    bool connect(LinearAllocatorArena& arena, DependencyGraph& graph,
             ResourceNode* resourceNode, PassNode* passNode, FrameGraphTexture::Usage u) override;
 
     ImportedRenderTarget* asImportedRenderTarget() noexcept override { return this; }
@@ -65,6 +65,10 @@ public:
     // is any non culled Node (of any type) reading from this ResourceNode
     bool hasActiveReaders() const noexcept;
 
+    // are all non culled readers of this ResourceNode render passes that fully overwrite it,
+    // i.e. none of them consume its current content (vacuously true with no active readers)
+    bool hasOnlyOverwritingActiveReaders() const noexcept;
+
     // is the specified PassNode reading this resource, if so return the corresponding edge.
     ResourceEdgeBase* getReaderEdgeForPass(PassNode const* node) const noexcept;
 
@@ -90,6 +94,16 @@ public:
     // us being writen to.
     void setParentWriteDependency(ResourceNode* parent) noexcept;
 
+    // subresource nodes that have a write dependency to this (parent) node, i.e. the
+    // slices this version of the resource was assembled from
+    Vector<ResourceNode*> const& getSubResourceWriters() const noexcept {
+        return mSubResourceWriters;
+    }
+
+    // this is a sibling subresource we're reading from; used instead of the parent
+    // dependency when the slices we read from are known exactly.
+    void addSliceReadDependency(ResourceNode* writer) noexcept;
+
     void setForwardResourceDependency(ResourceNode* source) noexcept;
 
     // virtuals from DependencyGraph::Node
@@ -107,6 +121,8 @@ private:
     DependencyGraph::Edge* mParentReadEdge = nullptr;
     DependencyGraph::Edge* mParentWriteEdge = nullptr;
     DependencyGraph::Edge* mForwardedEdge = nullptr;
+    Vector<ResourceNode*> mSubResourceWriters;
+    Vector<DependencyGraph::Edge*> mSliceReadEdges;
 
     // virtuals from DependencyGraph::Node
     utils::CString graphvizify() const noexcept override;
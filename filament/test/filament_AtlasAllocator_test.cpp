@@ -152,6 +152,47 @@ TEST(AtlasAllocator, AllocateBySizeOneOfEach) {
 
 }
 
+TEST(AtlasAllocator, FreeReusesSpace) {
+    AtlasAllocator allocator(256);
+
+    auto vp0 = allocator.allocate(128);
+    auto vp1 = allocator.allocate(64);
+    auto vp2 = allocator.allocate(64);
+
+    EXPECT_EQ(vp0.layer, 0);
+    EXPECT_EQ(vp1.layer, 0);
+    EXPECT_EQ(vp2.layer, 0);
+
+    // freeing an allocation makes its space available again
+    allocator.free(vp1);
+    auto vp3 = allocator.allocate(64);
+    EXPECT_EQ(vp3.layer, 0);
+    EXPECT_EQ(vp3.viewport, vp1.viewport);
+}
+
+TEST(AtlasAllocator, FreeCollapsesEmptySubtrees) {
+    AtlasAllocator allocator(256);
+
+    auto vp0 = allocator.allocate(128);
+    auto vp1 = allocator.allocate(128);
+    auto vp2 = allocator.allocate(128);
+    auto vp3 = allocator.allocate(128);
+
+    // the four allocations fill layer 0
+    EXPECT_EQ(vp3.layer, 0);
+    EXPECT_EQ(allocator.allocate(128).layer, 1);
+
+    // freeing everything makes the whole layer available again
+    allocator.free(vp0);
+    allocator.free(vp1);
+    allocator.free(vp2);
+    allocator.free(vp3);
+
+    auto vp4 = allocator.allocate(256);
+    EXPECT_EQ(vp4.layer, 0);
+    EXPECT_EQ(vp4.viewport, Viewport(0, 0, 256, 256));
+}
+
 TEST(AtlasAllocator, AllocateBySizeFullLayers) {
     AtlasAllocator allocator(512);
 
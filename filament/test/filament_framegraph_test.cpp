@@ -29,6 +29,12 @@
 
 #include "details/Texture.h"
 
+#include <array>
+#include <atomic>
+#include <new>
+
+#include <stdlib.h>
+
 using namespace filament;
 using namespace backend;
 
@@ -96,7 +102,8 @@ public:
 };
 
 TEST(DependencyGraphTest, Simple) {
-    DependencyGraph graph;
+    LinearAllocatorArena arena("graph", 1u << 20);
+    DependencyGraph graph(arena);
     Node* n0 = new Node(graph, "node 0");
     Node* n1 = new Node(graph, "node 1");
     Node* n2 = new Node(graph, "node 2");
@@ -128,7 +135,8 @@ TEST(DependencyGraphTest, Simple) {
 }
 
 TEST(DependencyGraphTest, Culling1) {
-    DependencyGraph graph;
+    LinearAllocatorArena arena("graph", 1u << 20);
+    DependencyGraph graph(arena);
     Node* n0 = new Node(graph, "node 0");
     Node* n1 = new Node(graph, "node 1");
     Node* n2 = new Node(graph, "node 2");
@@ -165,7 +173,8 @@ TEST(DependencyGraphTest, Culling1) {
 }
 
 TEST(DependencyGraphTest, Culling2) {
-    DependencyGraph graph;
+    LinearAllocatorArena arena("graph", 1u << 20);
+    DependencyGraph graph(arena);
     Node* n0 = new Node(graph, "node 0");
     Node* n1 = new Node(graph, "node 1");
     Node* n2 = new Node(graph, "node 2");
@@ -900,6 +909,77 @@ TEST_F(FrameGraphTest, SubResourcesWriteRead) {
     fg.execute(driverApi);
 }
 
+TEST_F(FrameGraphTest, SubResourcesSliceRead) {
+
+    // Two passes write different mips of the same texture and downstream work consumes only
+    // one of them. Readers of a slice must depend on the writers of that slice only, so the
+    // writer of the unread mip is culled instead of being kept alive by the whole texture.
+
+    struct MipPassData {
+        FrameGraphId<FrameGraphTexture> texture;
+        FrameGraphId<FrameGraphTexture> output;
+    };
+    auto& mip1Pass = fg.addPass<MipPassData>("Mip 1 pass",
+            [&](FrameGraph::Builder& builder, auto& data) {
+                data.texture = builder.create<FrameGraphTexture>("Color buffer",
+                        {.width=16, .height=32, .levels=4});
+                data.output = builder.createSubresource(data.texture, "Mip 1 buffer", {.level=1});
+                data.output = builder.declareRenderPass(data.output);
+                EXPECT_TRUE(fg.isValid(data.output));
+            },
+            [=](FrameGraphResources const& resources, auto const& data, backend::DriverApi&) {
+                EXPECT_TRUE(resources.get(data.output).handle);
+            });
+
+    auto& mip2Pass = fg.addPass<MipPassData>("Mip 2 pass",
+            [&](FrameGraph::Builder& builder, auto& data) {
+                data.output = builder.createSubresource(mip1Pass->texture, "Mip 2 buffer", {.level=2});
+                data.output = builder.declareRenderPass(data.output);
+                EXPECT_TRUE(fg.isValid(data.output));
+            },
+            [=](FrameGraphResources const&, auto const&, backend::DriverApi&) {
+            });
+
+    struct ReaderPassData {
+        FrameGraphId<FrameGraphTexture> input;
+        FrameGraphId<FrameGraphTexture> output;
+    };
+    auto& firstReader = fg.addPass<ReaderPassData>("First reader",
+            [&](FrameGraph::Builder& builder, auto& data) {
+                data.input = builder.sample(mip1Pass->output);
+                data.output = builder.create<FrameGraphTexture>("First output", {.width=8, .height=16});
+                data.output = builder.declareRenderPass(data.output);
+            },
+            [=](FrameGraphResources const& resources, auto const& data, backend::DriverApi&) {
+                EXPECT_TRUE(resources.get(data.input).handle);
+            });
+
+    auto& secondReader = fg.addPass<ReaderPassData>("Second reader",
+            [&](FrameGraph::Builder& builder, auto& data) {
+                data.input = builder.sample(mip1Pass->output);
+                data.output = builder.create<FrameGraphTexture>("Second output", {.width=8, .height=16});
+                data.output = builder.declareRenderPass(data.output);
+            },
+            [=](FrameGraphResources const& resources, auto const& data, backend::DriverApi&) {
+                EXPECT_TRUE(resources.get(data.input).handle);
+            });
+
+    fg.present(firstReader->output);
+    fg.present(secondReader->output);
+
+    EXPECT_TRUE(fg.isAcyclic());
+
+    fg.compile();
+
+    EXPECT_FALSE(fg.isCulled(mip1Pass));
+    EXPECT_FALSE(fg.isCulled(firstReader));
+    EXPECT_FALSE(fg.isCulled(secondReader));
+    // nothing consumes mip 2, and the readers of mip 1 don't depend on it
+    EXPECT_TRUE(fg.isCulled(mip2Pass));
+
+    fg.execute(driverApi);
+}
+
 TEST_F(FrameGraphTest, WriteResourceReadAsAttachment) {
 
     // this check s that using a resources as a read-only attachment doesn't set the
@@ -951,3 +1031,136 @@ TEST_F(FrameGraphTest, WriteResourceReadAsAttachment) {
 
     fg.execute(driverApi);
 }
+
+TEST_F(FrameGraphTest, StoreElidedWhenReadersOverwrite) {
+
+    // this checks that when every reader of an attachment is a render pass that clears it
+    // (i.e. overwrites it without consuming its content), the producer's store is elided
+    // by setting the discardEnd flag -- on MSAA attachments this also elides the resolve.
+
+    struct PassData {
+        FrameGraphId<FrameGraphTexture> buffer;
+    };
+    auto& producerPass = fg.addPass<PassData>("Producer Pass", [&](FrameGraph::Builder& builder, auto& data) {
+                data.buffer = builder.create<FrameGraphTexture>("Buffer", {.width=16, .height=32});
+                data.buffer = builder.write(data.buffer, FrameGraphTexture::Usage::COLOR_ATTACHMENT);
+                builder.declareRenderPass("Producer target", { .attachments = {
+                        .color = { data.buffer }
+                }});
+                builder.sideEffect();
+            },
+            [=](FrameGraphResources const& resources, auto const&, backend::DriverApi&) {
+                auto rt = resources.getRenderPassInfo();
+                // our only reader clears the attachment, so the store is useless
+                EXPECT_EQ(rt.params.flags.discardEnd, TargetBufferFlags::COLOR0);
+            });
+
+    fg.addPass<PassData>("Clearing Pass", [&](FrameGraph::Builder& builder, auto& data) {
+                data.buffer = builder.read(producerPass->buffer, FrameGraphTexture::Usage::COLOR_ATTACHMENT);
+                data.buffer = builder.write(data.buffer, FrameGraphTexture::Usage::COLOR_ATTACHMENT);
+                builder.declareRenderPass("Cleared target", { .attachments = {
+                        .color = { data.buffer }},
+                        .clearFlags = TargetBufferFlags::COLOR0
+                });
+                builder.sideEffect();
+            },
+            [=](FrameGraphResources const& resources, auto const&, backend::DriverApi&) {
+                auto rt = resources.getRenderPassInfo();
+                EXPECT_EQ(rt.params.flags.discardStart, TargetBufferFlags::COLOR0);
+                EXPECT_EQ(rt.params.flags.clear, TargetBufferFlags::COLOR0);
+            });
+
+    EXPECT_TRUE(fg.isAcyclic());
+
+    fg.compile();
+
+    fg.execute(driverApi);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Global operator new/delete replacements used to verify that the frame graph setup phase is
+// heap-free. Counting is off by default so gtest's own allocations don't interfere.
+// ------------------------------------------------------------------------------------------------
+
+static std::atomic<bool> sCountAllocations = { false };
+static std::atomic<size_t> sAllocationCount = { 0 };
+
+void* operator new(std::size_t size) {
+    if (sCountAllocations.load(std::memory_order_relaxed)) {
+        sAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (void* p = malloc(size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    free(p);
+}
+
+TEST_F(FrameGraphTest, NoHeapAllocationsDuringSetup) {
+    struct PassData {
+        FrameGraphId<FrameGraphTexture> input;
+        FrameGraphId<FrameGraphTexture> output;
+        // large enough to defeat any small-buffer optimization a closure container might use
+        std::array<uint64_t, 16> payload;
+    };
+
+    std::array<uint64_t, 16> payload;
+    payload.fill(0x42);
+
+    sAllocationCount.store(0);
+    sCountAllocations.store(true);
+
+    auto& producer = fg.addPass<PassData>("Producer",
+            [&, payload](FrameGraph::Builder& builder, auto& data) {
+                data.payload = payload;
+                data.output = builder.create<FrameGraphTexture>("Output buffer",
+                        {.width = 16, .height = 32});
+                data.output = builder.write(data.output,
+                        FrameGraphTexture::Usage::COLOR_ATTACHMENT);
+                builder.declareRenderPass("Output target", {.attachments = {
+                        .color = { data.output }
+                }});
+            },
+            [=](FrameGraphResources const&, auto const& data, backend::DriverApi&) {
+                EXPECT_EQ(data.payload[0], 0x42u);
+            });
+
+    fg.addPass<PassData>("Consumer",
+            [&, payload](FrameGraph::Builder& builder, auto& data) {
+                data.payload = payload;
+                data.input = builder.read(producer->output,
+                        FrameGraphTexture::Usage::SAMPLEABLE);
+                builder.sideEffect();
+            },
+            [=](FrameGraphResources const&, auto const& data, backend::DriverApi&) {
+                EXPECT_EQ(data.payload[0], 0x42u);
+            });
+
+    sCountAllocations.store(false);
+
+    // pass objects, pass data, dependency-graph nodes and edges all come from the frame
+    // graph's arena, so declaring passes and resources must not touch the heap
+    EXPECT_EQ(sAllocationCount.load(), 0u);
+
+    fg.compile();
+    fg.execute(driverApi);
+}
@@ -37,6 +37,7 @@
 #include <private/backend/BackendUtils.h>
 
 #include "Allocators.h"
+#include "PvsDatabase.h"
 #include "details/Material.h"
 #include "details/Camera.h"
 #include "Froxelizer.h"
@@ -612,6 +613,47 @@ TEST(FilamentTest, SphereCulling) {
     EXPECT_TRUE(frustum.intersects({ 0, 200 }));
 }
 
+TEST(FilamentTest, PvsDatabase) {
+    // Two "rooms" along x, separated by a solid wall slightly larger than the grid.
+    PvsDatabase pvs;
+    pvs.setGrid(Box{{ 0, 0, 0 }, { 2, 1, 1 }}, { 2, 1, 1 }, 2);
+    EXPECT_EQ(pvs.getCellCount(), 2u);
+    EXPECT_EQ(pvs.getRenderableCount(), 2u);
+
+    // cell lookup by position
+    size_t const roomA = pvs.getCell({ -1, 0, 0 });
+    size_t const roomB = pvs.getCell({  1, 0, 0 });
+    EXPECT_NE(roomA, PvsDatabase::INVALID_CELL);
+    EXPECT_NE(roomB, PvsDatabase::INVALID_CELL);
+    EXPECT_NE(roomA, roomB);
+    EXPECT_EQ(pvs.getCell({ 5, 0, 0 }), PvsDatabase::INVALID_CELL);
+
+    // renderable 0 sits in room A, renderable 1 in room B
+    Box const renderables[2] = {
+            {{ -1, 0, 0 }, { 0.1f, 0.1f, 0.1f }},
+            {{  1, 0, 0 }, { 0.1f, 0.1f, 0.1f }},
+    };
+    Box const wall[1] = {{{ 0, 0, 0 }, { 0.1f, 2, 2 }}};
+    pvs.bake(renderables, 2, wall, 1);
+
+    // each room only sees its own renderable
+    EXPECT_TRUE( pvs.isVisible(roomA, 0));
+    EXPECT_FALSE(pvs.isVisible(roomA, 1));
+    EXPECT_FALSE(pvs.isVisible(roomB, 0));
+    EXPECT_TRUE( pvs.isVisible(roomB, 1));
+
+    // apply() clears only the requested bit for renderables outside the PVS
+    Culler::result_type visibleMask[2] = { 0x3, 0x3 };
+    pvs.apply(roomA, visibleMask, 2, 0);
+    EXPECT_EQ(visibleMask[0], 0x3);
+    EXPECT_EQ(visibleMask[1], 0x2);
+
+    // without occluders, everything is visible from everywhere
+    pvs.bake(renderables, 2, nullptr, 0);
+    EXPECT_TRUE(pvs.isVisible(roomA, 1));
+    EXPECT_TRUE(pvs.isVisible(roomB, 0));
+}
+
 TEST(FilamentTest, ColorConversion) {
     // Linear to Gamma
     // 0.0 stays 0.0
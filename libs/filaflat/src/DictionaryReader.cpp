@@ -19,11 +19,6 @@
 #include <filaflat/ChunkContainer.h>
 #include <filaflat/Unflattener.h>
 
-#if defined (FILAMENT_DRIVER_SUPPORTS_VULKAN)
-#include <utils/Log.h>
-#include <smolv.h>
-#endif
-
 #include <assert.h>
 
 using namespace filamat;
@@ -62,20 +57,13 @@ bool DictionaryReader::unflatten(ChunkContainer const& container,
 
             assert_invariant((intptr_t(compressed) % 8) == 0);
 
-#if defined (FILAMENT_DRIVER_SUPPORTS_VULKAN)
-            size_t spirvSize = smolv::GetDecodedBufferSize(compressed, compressedSize);
-            if (spirvSize == 0) {
-                return false;
-            }
-            ShaderContent spirv(spirvSize);
-            if (!smolv::Decode(compressed, compressedSize, spirv.data(), spirvSize)) {
-                return false;
-            }
-            dictionary.emplace_back(std::move(spirv));
-#else
-            return false;
-#endif
-
+            // The blobs are kept in their compressed (smol-v) form; they are decoded in
+            // MaterialChunk::getShader() only when a variant is actually needed, and the
+            // plaintext is released once the backend has consumed it. SPIR-V decompresses
+            // to several times its compressed size, so eagerly decoding the whole
+            // dictionary here would be wasteful for materials with many unused variants.
+            dictionary.emplace_back(compressedSize);
+            memcpy(dictionary.back().data(), compressed, compressedSize);
         }
         return true;
     } else if (dictionaryTag == ChunkType::DictionaryMetalLibrary) {
@@ -21,6 +21,10 @@
 
 #include <utils/Log.h>
 
+#if defined (FILAMENT_DRIVER_SUPPORTS_VULKAN)
+#include <smolv.h>
+#endif
+
 namespace filaflat {
 
 static inline uint32_t makeKey(
@@ -166,6 +170,26 @@ bool MaterialChunk::getBinaryShader(BlobDictionary const& dictionary,
         return false;
     }
 
+    if (mMaterialTag == filamat::ChunkType::MaterialSpirv) {
+#if defined (FILAMENT_DRIVER_SUPPORTS_VULKAN)
+        // SPIR-V is kept smol-v compressed in the dictionary and only decoded when a variant
+        // is actually requested. The decoded blob lives in shaderContent and is released by
+        // the caller once the backend has consumed it.
+        ShaderContent const& compressed = dictionary[pos->second];
+        size_t const spirvSize = smolv::GetDecodedBufferSize(
+                compressed.data(), compressed.size());
+        if (spirvSize == 0) {
+            return false;
+        }
+        shaderContent.reserve(spirvSize);
+        shaderContent.resize(spirvSize);
+        return smolv::Decode(compressed.data(), compressed.size(),
+                shaderContent.data(), spirvSize);
+#else
+        return false;
+#endif
+    }
+
     shaderContent = dictionary[pos->second];
     return true;
 }
@@ -103,11 +103,16 @@ public:
         SPIRV           // GLSL with Vulkan semantics
     };
 
+    /**
+     * Shader optimization presets. Each level selects a tuned spirv-opt pass list; the lists
+     * are further specialized per target API and shader model. Combine NONE with
+     * generateDebugInfo() for the best debugging experience.
+     */
     enum class Optimization {
-        NONE,
-        PREPROCESSOR,
-        SIZE,
-        PERFORMANCE
+        NONE,           //!< no optimization, fastest compilation, debuggable output
+        PREPROCESSOR,   //!< only run the preprocessor
+        SIZE,           //!< optimize for generated shader size
+        PERFORMANCE     //!< optimize for shader execution speed (default)
     };
 
     /**
@@ -604,6 +609,15 @@ public:
     //! Specifies a list of variants that should be filtered out during code generation.
     MaterialBuilder& variantFilter(filament::UserVariantFilterMask variantFilter) noexcept;
 
+    /**
+     * Declares the set of engine capabilities this material is used with. This is the
+     * declarative counterpart of variantFilter(): every capability *not* present in the mask
+     * (skinning, fog, shadows, etc.) has its whole variant family pruned at build time, which
+     * shrinks both the package and the variant tables the engine keeps resident. Combines with
+     * variantFilter() if both are specified.
+     */
+    MaterialBuilder& variantUsages(filament::UserVariantFilterMask usedCapabilities) noexcept;
+
     //! Adds a new preprocessor macro definition to the shader code. Can be called repeatedly.
     MaterialBuilder& shaderDefine(const char* name, const char* value) noexcept;
 
@@ -928,6 +942,8 @@ private:
     PreprocessorDefineList mDefines;
 
     filament::UserVariantFilterMask mVariantFilter = {};
+    filament::UserVariantFilterMask mVariantUsages =
+            (filament::UserVariantFilterMask) filament::UserVariantFilterBit::ALL;
 
     bool mNoSamplerValidation = false;
 };
@@ -929,6 +929,18 @@ void GLSLPostProcessor::registerPerformancePasses(Optimizer& optimizer, Config c
     RegisterPass(CreateDeadBranchElimPass());
     RegisterPass(CreateBlockMergePass());
     RegisterPass(CreateSimplificationPass(), MaterialBuilder::TargetApi::METAL);
+
+    if (config.shaderModel == ShaderModel::MOBILE) {
+        // On mobile a final load-store elimination round pays off: the if-conversions and
+        // block merges above expose stores that the earlier rounds couldn't prove dead yet,
+        // and mobile GPUs are the most sensitive to the leftover ALU and register pressure.
+        RegisterPass(CreateLocalSingleBlockLoadStoreElimPass());
+        RegisterPass(CreateLocalSingleStoreElimPass());
+        RegisterPass(CreateLocalMultiStoreElimPass());
+        RegisterPass(CreateAggressiveDCEPass());
+        RegisterPass(CreateVectorDCEPass());
+        RegisterPass(CreateCFGCleanupPass());
+    }
 }
 
 void GLSLPostProcessor::registerSizePasses(Optimizer& optimizer, Config const& config) {
@@ -587,6 +587,11 @@ MaterialBuilder& MaterialBuilder::variantFilter(UserVariantFilterMask variantFil
     return *this;
 }
 
+MaterialBuilder& MaterialBuilder::variantUsages(UserVariantFilterMask usedCapabilities) noexcept {
+    mVariantUsages = usedCapabilities;
+    return *this;
+}
+
 MaterialBuilder& MaterialBuilder::shaderDefine(const char* name, const char* value) noexcept {
     mDefines.emplace_back(name, value);
     return *this;
@@ -885,11 +890,12 @@ bool MaterialBuilder::generateShaders(JobSystem& jobSystem, const std::vector<Va
     std::atomic_bool cancelJobs(false);
     bool firstJob = true;
 
-    for (const auto& params : mCodeGenPermutations) {
-        if (cancelJobs.load()) {
-            return false;
-        }
+    // All variant jobs are attached to a single root so that variants of all permutations
+    // (shader models, target APIs) run concurrently, instead of draining each permutation
+    // before starting the next one.
+    JobSystem::Job* rootJob = jobSystem.createJob();
 
+    for (const auto& params : mCodeGenPermutations) {
         const ShaderModel shaderModel = ShaderModel(params.shaderModel);
         const TargetApi targetApi = params.targetApi;
         const TargetLanguage targetLanguage = params.targetLanguage;
@@ -903,11 +909,12 @@ bool MaterialBuilder::generateShaders(JobSystem& jobSystem, const std::vector<Va
         const bool targetApiNeedsMsl = targetApi == TargetApi::METAL;
         const bool targetApiNeedsGlsl = targetApi == TargetApi::OPENGL;
 
-        // Set when a job fails
-        JobSystem::Job* parent = jobSystem.createJob();
-
         for (const auto& v : variants) {
-            JobSystem::Job* job = jobs::createJob(jobSystem, parent, [&]() {
+            // per-permutation locals are captured by value because the jobs now outlive
+            // the loop iteration that created them
+            JobSystem::Job* job = jobs::createJob(jobSystem, rootJob,
+                    [&, params, v, shaderModel, targetApi, targetLanguage, featureLevel,
+                            targetApiNeedsSpirv, targetApiNeedsMsl, targetApiNeedsGlsl]() {
                 if (cancelJobs.load()) {
                     return;
                 }
@@ -1066,10 +1073,10 @@ bool MaterialBuilder::generateShaders(JobSystem& jobSystem, const std::vector<Va
                 jobSystem.run(job);
             }
         }
-
-        jobSystem.runAndWait(parent);
     }
 
+    jobSystem.runAndWait(rootJob);
+
     if (cancelJobs.load()) {
         return false;
     }
@@ -1257,6 +1264,10 @@ error:
         goto error;
     }
 
+    // Fold the declared usages into the variant filter: every capability the material is not
+    // used with gets its variant family pruned, exactly as if it had been listed in the filter.
+    mVariantFilter |= uint32_t(UserVariantFilterBit::ALL) & ~mVariantUsages;
+
     // adjust variant-filter for feature level *before* we start writing into the container
     if (mFeatureLevel == filament::backend::FeatureLevel::FEATURE_LEVEL_0) {
         // at feature level 0, many variants are not supported
@@ -28,8 +28,11 @@
 #include <backend/DriverEnums.h>
 
 #include <utils/debug.h>
+#include <utils/Hash.h>
 
+#include <algorithm>
 #include <utility>
+#include <vector>
 
 #include <stdint.h>
 
@@ -282,6 +285,38 @@ void MaterialDescriptorSetLayoutChunk::flatten(Flattener& f) {
         f.writeUint8(uint8_t(entry.flags));
         f.writeUint16(entry.count);
     }
+
+    // precompute the layout hashes, so the engine's HwDescriptorSetLayoutFactory can skip
+    // hashing on every material load. This must match what the factory computes: murmur
+    // with seed 42 over the bindings sorted by binding number.
+    auto const layoutHash = [](std::vector<DescriptorSetLayoutBinding> bindings) -> uint64_t {
+        std::sort(bindings.begin(), bindings.end(),
+                [](auto const& lhs, auto const& rhs) {
+            return lhs.binding < rhs.binding;
+        });
+        return utils::hash::murmurSlow(
+                reinterpret_cast<uint8_t const*>(bindings.data()),
+                bindings.size() * sizeof(DescriptorSetLayoutBinding),
+                42);
+    };
+
+    // per-material layout, mirroring the descriptors written above
+    std::vector<DescriptorSetLayoutBinding> materialBindings;
+    materialBindings.reserve(mSamplerInterfaceBlock.getSize() + 1);
+    materialBindings.push_back({ DescriptorType::UNIFORM_BUFFER,
+            ShaderStageFlags::VERTEX | ShaderStageFlags::FRAGMENT, 0,
+            DescriptorFlags::NONE, 0 });
+    for (auto const& entry: mSamplerInterfaceBlock.getSamplerInfoList()) {
+        materialBindings.push_back({
+                entry.type == SamplerInterfaceBlock::Type::SAMPLER_EXTERNAL ?
+                        DescriptorType::SAMPLER_EXTERNAL : DescriptorType::SAMPLER,
+                ShaderStageFlags::VERTEX | ShaderStageFlags::FRAGMENT, entry.binding,
+                DescriptorFlags::NONE, 0 });
+    }
+    f.writeUint64(layoutHash(std::move(materialBindings)));
+
+    f.writeUint64(layoutHash({ mPerViewLayout.bindings.begin(),
+            mPerViewLayout.bindings.end() }));
 }
 
 } // namespace filamat
@@ -36,6 +36,11 @@ enum Flags : uint32_t {
     INTERLEAVED         = 1 << 0,
     TEXCOORD_SNORM16    = 1 << 1,
     COMPRESSION         = 1 << 2,
+    // Positions are stored as SNORM16 short4 normalized to the Header's aabb: the original
+    // position is aabb.center + snorm * aabb.halfExtent (w dequantizes to 1). The aabb thus
+    // doubles as the dequantization transform, which MeshReader re-applies as a transform
+    // component on the renderable.
+    POSITION_SNORM16    = 1 << 3,
 };
 
 // Each of these fields specifies a number of bytes within the compressed data. This is ignored
@@ -24,8 +24,11 @@
 #include <filament/Material.h>
 #include <filament/MaterialInstance.h>
 #include <filament/RenderableManager.h>
+#include <filament/TransformManager.h>
 #include <filament/VertexBuffer.h>
 
+#include <math/mat4.h>
+
 #include <meshoptimizer.h>
 
 #include <utils/EntityManager.h>
@@ -40,6 +43,7 @@
 #include <fcntl.h>
 #if !defined(WIN32)
 #    include <unistd.h>
+#    include <sys/mman.h>
 #else
 #    include <io.h>
 #endif
@@ -167,6 +171,26 @@ MeshReader::Mesh MeshReader::loadMeshFromFile(filament::Engine* engine, const ut
     int fd = open(path.c_str(), O_RDONLY);
 
     size_t size = fileSize(fd);
+
+#if !defined(WIN32)
+    // Map the file read-only and parse in place: uncompressed vertex and index data is
+    // handed to the backend directly from the mapping, so loading doesn't duplicate the
+    // package in memory and clean pages can be reclaimed under memory pressure.
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping != MAP_FAILED) {
+        char* data = (char*) mapping;
+        if (!strncmp(MAGICID, data, 8)) {
+            mesh = loadMeshFromBuffer(engine, data, nullptr, nullptr, materials);
+        }
+        // the backend reads from the mapping until the fence signals
+        Fence::waitAndDestroy(engine->createFence());
+        munmap(mapping, size);
+        close(fd);
+        return mesh;
+    }
+    // if the file can't be mapped, fall through to the copying path
+#endif
+
     char* data = (char*) malloc(size);
     read(fd, data, size);
 
@@ -271,9 +295,16 @@ MeshReader::Mesh MeshReader::loadMeshFromBuffer(filament::Engine* engine,
     VertexBuffer::AttributeType uvtype = (header->flags & TEXCOORD_SNORM16) ?
             VertexBuffer::AttributeType::SHORT2 : VertexBuffer::AttributeType::HALF2;
 
+    // quantized positions are stored as snorm16 on the header AABB grid (see filamesh.h);
+    // the layout is unchanged since half4 and short4 have the same size
+    const bool hasQuantizedPositions = header->flags & POSITION_SNORM16;
+    VertexBuffer::AttributeType postype = hasQuantizedPositions ?
+            VertexBuffer::AttributeType::SHORT4 : VertexBuffer::AttributeType::HALF4;
+
     vbb
-            .attribute(VertexAttribute::POSITION, 0, VertexBuffer::AttributeType::HALF4,
+            .attribute(VertexAttribute::POSITION, 0, postype,
                         header->offsetPosition, uint8_t(header->stridePosition))
+            .normalized(VertexAttribute::POSITION, hasQuantizedPositions)
             .attribute(VertexAttribute::TANGENTS, 0, VertexBuffer::AttributeType::SHORT4,
                         header->offsetTangents, uint8_t(header->strideTangents))
             .attribute(VertexAttribute::COLOR, 0, VertexBuffer::AttributeType::UBYTE4,
@@ -352,7 +383,9 @@ MeshReader::Mesh MeshReader::loadMeshFromBuffer(filament::Engine* engine,
     mesh.renderable = utils::EntityManager::get().create();
 
     RenderableManager::Builder builder(header->parts);
-    builder.boundingBox(header->aabb);
+    // with quantized positions the geometry lives in the [-1, 1] unit cube; the dequantization
+    // back to the original space is applied below as a transform on the renderable
+    builder.boundingBox(hasQuantizedPositions ? Box{ {}, float3{ 1.0f } } : header->aabb);
 
     const auto defaultmi = materials.getMaterialInstance(utils::CString(DEFAULT_MATERIAL));
     for (size_t i = 0; i < header->parts; i++) {
@@ -381,6 +414,17 @@ MeshReader::Mesh MeshReader::loadMeshFromBuffer(filament::Engine* engine,
     }
     builder.build(*engine, mesh.renderable);
 
+    if (hasQuantizedPositions) {
+        // re-apply the dequantization (unit cube to mesh AABB) stored in the header; clients
+        // can still parent or move the renderable, this is just its local transform
+        auto& tcm = engine->getTransformManager();
+        if (!tcm.getInstance(mesh.renderable)) {
+            tcm.create(mesh.renderable);
+        }
+        tcm.setTransform(tcm.getInstance(mesh.renderable),
+                mat4f::translation(header->aabb.center) * mat4f::scaling(header->aabb.halfExtent));
+    }
+
     return mesh;
 }
 
@@ -17,12 +17,14 @@
 #include <filament/Engine.h>
 #include <filament/Material.h>
 #include <filament/RenderableManager.h>
+#include <filament/TransformManager.h>
 
 #include <filameshio/filamesh.h>
 #include <filameshio/MeshReader.h>
 
 #include <math/half.h>
 #include <math/mat3.h>
+#include <math/mat4.h>
 #include <math/norm.h>
 #include <math/quat.h>
 #include <math/vec3.h>
@@ -216,6 +218,70 @@ TEST_F(FilameshTest, Interleaved) {
     engine->destroy(mi);
 }
 
+TEST_F(FilameshTest, QuantizedPositions) {
+    // Serialize a single-triangle mesh with snorm16 positions on the AABB grid.
+    static const Box aabb = {
+        .center = float3(1, 2, 3),
+        .halfExtent = float3(4, 5, 6)
+    };
+    static const short4 quantizedPositions[] = {
+        packSnorm16(float4(-1.0f, 0.0f, 1.0f, 1.0f)),
+        packSnorm16(float4(0.5f, -0.5f, 0.0f, 1.0f)),
+        packSnorm16(float4(0.0f, 1.0f, -1.0f, 1.0f)),
+    };
+    const Header header {
+        .version = VERSION,
+        .parts = 1,
+        .aabb = aabb,
+        .flags = POSITION_SNORM16,
+        .offsetTangents = sizeof(quantizedPositions),
+        .offsetColor = sizeof(quantizedPositions) + sizeof(tangents),
+        .offsetUV0 = sizeof(quantizedPositions) + sizeof(tangents) + sizeof(colors),
+        .strideUV1 = maxint,
+        .vertexCount = vertexCount,
+        .vertexSize = sizeof(quantizedPositions) + sizeof(tangents) + sizeof(colors) + sizeof(uv0),
+        .indexType = IndexType::UI16,
+        .indexCount = 3,
+        .indexSize = sizeof(uint16_t) * 3
+    };
+    const uint32_t nmats = 1;
+    const string matname = "DefaultMaterial";
+    const uint32_t matnamelength = matname.size();
+
+    stringstream stream(ios_base::out);
+    write(stream, MAGICID, sizeof(MAGICID));
+    write(stream, &header, sizeof(header));
+    write(stream, quantizedPositions, sizeof(quantizedPositions));
+    write(stream, tangents, sizeof(tangents));
+    write(stream, colors, sizeof(colors));
+    write(stream, uv0, sizeof(uv0));
+    write(stream, indices, sizeof(indices));
+    write(stream, parts, sizeof(parts));
+    write(stream, &nmats, sizeof(nmats));
+    write(stream, &matnamelength, sizeof(matnamelength));
+    write(stream, matname.c_str(), matnamelength + 1);
+
+    MaterialInstance* mi = engine->getDefaultMaterial()->createInstance();
+    auto mesh = MeshReader::loadMeshFromBuffer(engine, stream.str().data(), nullptr, nullptr, mi);
+    auto& rm = engine->getRenderableManager();
+    auto inst = rm.getInstance(mesh.renderable);
+    EXPECT_EQ(rm.getPrimitiveCount(inst), 1);
+
+    // The reader must have attached the dequantization transform (unit cube to AABB).
+    auto& tcm = engine->getTransformManager();
+    auto tinst = tcm.getInstance(mesh.renderable);
+    ASSERT_TRUE(bool(tinst));
+    const mat4f transform = tcm.getTransform(tinst);
+    const float4 corner = transform * float4(1.0f, 1.0f, 1.0f, 1.0f);
+    EXPECT_FLOAT_EQ(corner.x, aabb.center.x + aabb.halfExtent.x);
+    EXPECT_FLOAT_EQ(corner.y, aabb.center.y + aabb.halfExtent.y);
+    EXPECT_FLOAT_EQ(corner.z, aabb.center.z + aabb.halfExtent.z);
+
+    // Cleanup.
+    engine->destroy(mesh.renderable);
+    engine->destroy(mi);
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
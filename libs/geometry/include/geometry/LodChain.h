@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_GEOMETRY_LODCHAIN_H
+#define TNT_GEOMETRY_LODCHAIN_H
+
+#include <math/vec3.h>
+
+#include <utils/compiler.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace filament {
+namespace geometry {
+
+struct LodChainBuilderImpl;
+struct LodChainImpl;
+
+/**
+ * Generates a chain of progressively simplified levels of detail for an indexed triangle mesh.
+ *
+ * Every level is an index buffer into the *original* vertex buffer, so all levels of a mesh can
+ * share one VertexBuffer and switch by index buffer only — no per-level vertex data, no
+ * per-level descriptor sets. Level 0 is the input mesh; each subsequent level targets
+ * reductionFactor() times the previous level's index count and reports the geometric error it
+ * introduced, which callers can project to screen space to drive selection (a level is good
+ * enough when its error times the projection scale over distance is below a pixel threshold).
+ */
+class UTILS_PUBLIC LodChain {
+public:
+    /**
+     * The Builder is used to construct an immutable LOD chain.
+     *
+     * Clients provide pointers into their own data, which is synchronously consumed during
+     * build(). Positions, a vertex count, triangles and a triangle count are all required.
+     */
+    class Builder {
+    public:
+        Builder() noexcept;
+        ~Builder() noexcept;
+        Builder(Builder&& that) noexcept;
+        Builder& operator=(Builder&& that) noexcept;
+
+        Builder& positions(const math::float3*, size_t stride = 0) noexcept;
+        Builder& vertexCount(size_t vertexCount) noexcept;
+
+        Builder& triangles(const math::uint3*) noexcept;
+        Builder& triangles(const math::ushort3*) noexcept;
+        Builder& triangleCount(size_t triangleCount) noexcept;
+
+        /**
+         * Number of levels to generate including level 0, at least 1. Defaults to 4. The
+         * chain stops early if a level cannot be simplified further without exceeding
+         * maxError(), so the resulting chain may be shorter.
+         */
+        Builder& lodCount(size_t lodCount) noexcept;
+
+        /**
+         * Target index count of each level relative to the previous one, in (0, 1).
+         * Defaults to 0.5.
+         */
+        Builder& reductionFactor(float factor) noexcept;
+
+        /**
+         * Maximum geometric error a level may introduce, relative to the mesh extent
+         * (see getScale()). Defaults to 0.1.
+         */
+        Builder& maxError(float error) noexcept;
+
+        /**
+         * Keeps the boundary of open meshes intact, at some cost in simplification quality.
+         * Useful when the mesh is simplified in pieces that must stay watertight along their
+         * seams. Defaults to false.
+         */
+        Builder& lockBorder(bool lock) noexcept;
+
+        /**
+         * Generates the chain, or returns null if the submitted data is incomplete.
+         */
+        LodChain* build();
+
+    private:
+        LodChainBuilderImpl* mImpl;
+        Builder(const Builder&) = delete;
+        Builder& operator=(const Builder&) = delete;
+    };
+
+    ~LodChain() noexcept;
+    LodChain(LodChain&& that) noexcept;
+    LodChain& operator=(LodChain&& that) noexcept;
+
+    /**
+     * Returns the number of levels actually generated, in [1, lodCount()].
+     */
+    size_t getLodCount() const noexcept;
+
+    /**
+     * Returns the indices of the given level; these index into the original vertex buffer.
+     * @{
+     */
+    uint32_t const* getIndices(size_t lod) const noexcept;
+    size_t getIndexCount(size_t lod) const noexcept;
+    /** @} */
+
+    /**
+     * Returns the geometric error of the given level relative to level 0, as a fraction of
+     * the mesh extent. Multiply by getScale() for an object-space distance. Level 0 reports
+     * an error of 0, and errors are non-decreasing along the chain.
+     */
+    float getError(size_t lod) const noexcept;
+
+    /**
+     * Returns the extent of the mesh, i.e. the object-space distance that a relative error
+     * of 1 corresponds to.
+     */
+    float getScale() const noexcept;
+
+private:
+    LodChain(LodChainImpl*) noexcept;
+    LodChain(const LodChain&) = delete;
+    LodChain& operator=(const LodChain&) = delete;
+    LodChainImpl* mImpl;
+    friend struct LodChainBuilderImpl;
+};
+
+} // namespace geometry
+} // namespace filament
+
+#endif // TNT_GEOMETRY_LODCHAIN_H
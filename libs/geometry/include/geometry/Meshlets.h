@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_GEOMETRY_MESHLETS_H
+#define TNT_GEOMETRY_MESHLETS_H
+
+#include <math/vec3.h>
+
+#include <utils/compiler.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace filament {
+namespace geometry {
+
+struct MeshletsBuilderImpl;
+struct MeshletsImpl;
+
+/**
+ * Splits an indexed triangle mesh into small vertex-cache-friendly clusters (meshlets), each
+ * with a bounding sphere and a normal cone suitable for per-cluster culling.
+ *
+ * Each meshlet references at most maxVertices() unique vertices and maxTriangles() triangles.
+ * Triangles are stored as 8-bit indices into the meshlet's slice of the vertex index array, so
+ * the output can be uploaded to the GPU as-is. Clients that stay on the regular indexed path
+ * can instead expand each meshlet back into a global index buffer slice and use the bounds to
+ * cull individual draws; the clustering alone helps vertex-bound scenes by improving locality.
+ */
+class UTILS_PUBLIC Meshlets {
+public:
+    /**
+     * A range within the vertex index and triangle arrays. Offsets are in elements.
+     */
+    struct Meshlet {
+        uint32_t vertexOffset;      //!< first entry in getVertexIndices()
+        uint32_t triangleOffset;    //!< first byte in getTriangles(), always a multiple of 3
+        uint32_t vertexCount;       //!< number of unique vertices, at most maxVertices()
+        uint32_t triangleCount;     //!< number of triangles, at most maxTriangles()
+    };
+
+    /**
+     * Culling data for one meshlet, in the mesh's object space.
+     *
+     * The cone bounds the spread of the meshlet's triangle normals: the whole meshlet is
+     * back-facing when dot(normalize(center - viewPosition), coneAxis) >= coneCutoff.
+     */
+    struct Bounds {
+        math::float3 center;        //!< center of the bounding sphere
+        float radius;               //!< radius of the bounding sphere
+        math::float3 coneApex;      //!< apex of the normal cone
+        float coneCutoff;           //!< cos(angle / 2) of the normal cone
+        math::float3 coneAxis;      //!< axis of the normal cone
+    };
+
+    /**
+     * The Builder is used to construct an immutable set of meshlets.
+     *
+     * Clients provide pointers into their own data, which is synchronously consumed during
+     * build(). Positions, a vertex count, triangles and a triangle count are all required.
+     */
+    class Builder {
+    public:
+        Builder() noexcept;
+        ~Builder() noexcept;
+        Builder(Builder&& that) noexcept;
+        Builder& operator=(Builder&& that) noexcept;
+
+        Builder& positions(const math::float3*, size_t stride = 0) noexcept;
+        Builder& vertexCount(size_t vertexCount) noexcept;
+
+        Builder& triangles(const math::uint3*) noexcept;
+        Builder& triangles(const math::ushort3*) noexcept;
+        Builder& triangleCount(size_t triangleCount) noexcept;
+
+        /**
+         * Maximum number of unique vertices per meshlet, at most 255. Defaults to 64, which
+         * suits both mesh-shader payload limits and per-cluster indexed draws.
+         */
+        Builder& maxVertices(size_t maxVertices) noexcept;
+
+        /**
+         * Maximum number of triangles per meshlet, at most 512. Defaults to 124 to keep the
+         * triangle array 4-byte aligned.
+         */
+        Builder& maxTriangles(size_t maxTriangles) noexcept;
+
+        /**
+         * Balance between vertex reuse (0) and normal cone tightness (1) when clustering.
+         * Defaults to 0, which minimizes vertex transform work; use ~0.5 when cone culling
+         * matters more than locality.
+         */
+        Builder& coneWeight(float coneWeight) noexcept;
+
+        /**
+         * Generates the meshlets, or returns null if the submitted data is incomplete.
+         */
+        Meshlets* build();
+
+    private:
+        MeshletsBuilderImpl* mImpl;
+        Builder(const Builder&) = delete;
+        Builder& operator=(const Builder&) = delete;
+    };
+
+    ~Meshlets() noexcept;
+    Meshlets(Meshlets&& that) noexcept;
+    Meshlets& operator=(Meshlets&& that) noexcept;
+
+    /**
+     * Returns the number of meshlets.
+     */
+    size_t getMeshletCount() const noexcept;
+
+    /**
+     * Returns one Meshlet per meshlet.
+     */
+    Meshlet const* getMeshlets() const noexcept;
+
+    /**
+     * Returns one Bounds per meshlet.
+     */
+    Bounds const* getBounds() const noexcept;
+
+    /**
+     * Returns the vertex indices referenced by the meshlets; these index into the original
+     * vertex buffer. Use getVertexIndexCount() for the array size.
+     * @{
+     */
+    uint32_t const* getVertexIndices() const noexcept;
+    size_t getVertexIndexCount() const noexcept;
+    /** @} */
+
+    /**
+     * Returns the triangles as triplets of 8-bit indices, local to each meshlet's slice of
+     * the vertex index array. Use getTriangleIndexCount() for the array size (3 entries per
+     * triangle).
+     * @{
+     */
+    uint8_t const* getTriangles() const noexcept;
+    size_t getTriangleIndexCount() const noexcept;
+    /** @} */
+
+private:
+    Meshlets(MeshletsImpl*) noexcept;
+    Meshlets(const Meshlets&) = delete;
+    Meshlets& operator=(const Meshlets&) = delete;
+    MeshletsImpl* mImpl;
+    friend struct MeshletsBuilderImpl;
+};
+
+} // namespace geometry
+} // namespace filament
+
+#endif // TNT_GEOMETRY_MESHLETS_H
@@ -23,6 +23,10 @@
 
 #include <utils/compiler.h>
 
+namespace utils {
+class JobSystem;
+}
+
 namespace filament {
 
 /**
@@ -84,6 +88,15 @@ public:
         Builder& triangles(const filament::math::uint3*) noexcept;
         Builder& triangles(const filament::math::ushort3*) noexcept;
 
+        /**
+         * Optional JobSystem used to parallelize the per-vertex work across worker threads.
+         *
+         * Only large meshes benefit; small meshes are processed serially regardless. It is safe
+         * to call build() from inside a job of the same JobSystem, since waiting threads steal
+         * and execute pending work.
+         */
+        Builder& jobSystem(utils::JobSystem* jobSystem) noexcept;
+
         /**
          * Generates quats or returns null if the submitted data is an incomplete combination.
          */
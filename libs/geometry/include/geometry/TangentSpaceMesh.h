@@ -324,6 +324,58 @@ public:
      */
     void getQuats(filament::math::quath* out, size_t stride = 0) const noexcept;
 
+    /**
+     * Incrementally recomputes tangent frames after the input attributes have been mutated in
+     * place, and writes only the affected frames into a caller-provided vertex buffer region.
+     *
+     * This is intended for deforming meshes (e.g. cloth) that refresh their normals every frame:
+     * instead of rebuilding the whole mesh, the client keeps the input arrays given to the
+     * Builder alive, overwrites the entries for the vertices that moved, and passes the list of
+     * those vertices here. `out` is the base of the mapped tangent region for output vertex 0;
+     * the frame for output vertex `i` is written at `i * stride` bytes past `out`.
+     *
+     * Only algorithms whose per-vertex frames are local are supported: FRISVAD, HUGHES_MOLLER,
+     * TANGENTS_PROVIDED and FLAT_SHADING. For FLAT_SHADING the dirty indices refer to *input*
+     * vertices and the frames of every output triangle referencing a dirty vertex are rewritten
+     * (a vertex-to-triangle table is built lazily on first call). LENGYEL and MIKKTSPACE
+     * accumulate contributions across the mesh and will throw an exception.
+     *
+     * The internal copy of the tangent frames (and, for FLAT_SHADING, positions) is kept in
+     * sync, so the `get` methods remain consistent with the updated input.
+     *
+     * @param  dirtyVertices    Indices of the input vertices whose attributes changed.
+     * @param  dirtyVertexCount Number of entries in `dirtyVertices`.
+     * @param  out              Client-provided (possibly mapped) array, addressed by output
+     *                          vertex index, receiving tangent space in 32-bit floating points.
+     * @param  stride           Stride for iterating through `out`
+     */
+    void updateQuats(uint32_t const* dirtyVertices, size_t dirtyVertexCount,
+            filament::math::quatf* out, size_t stride = 0) const;
+
+    /**
+     * Incrementally recomputes tangent frames for a dirty-vertex list. See the quatf overload.
+     *
+     * @param  dirtyVertices    Indices of the input vertices whose attributes changed.
+     * @param  dirtyVertexCount Number of entries in `dirtyVertices`.
+     * @param  out              Client-provided (possibly mapped) array, addressed by output
+     *                          vertex index, receiving tangent space in 16-bit signed integers.
+     * @param  stride           Stride for iterating through `out`
+     */
+    void updateQuats(uint32_t const* dirtyVertices, size_t dirtyVertexCount,
+            filament::math::short4* out, size_t stride = 0) const;
+
+    /**
+     * Incrementally recomputes tangent frames for a dirty-vertex list. See the quatf overload.
+     *
+     * @param  dirtyVertices    Indices of the input vertices whose attributes changed.
+     * @param  dirtyVertexCount Number of entries in `dirtyVertices`.
+     * @param  out              Client-provided (possibly mapped) array, addressed by output
+     *                          vertex index, receiving tangent space in 16-bit floating points.
+     * @param  stride           Stride for iterating through `out`
+     */
+    void updateQuats(uint32_t const* dirtyVertices, size_t dirtyVertexCount,
+            filament::math::quath* out, size_t stride = 0) const;
+
     /**
      * Get output auxiliary attributes.
      * Assumes the `out` param is at least of getVertexCount() length (while accounting for
@@ -0,0 +1,229 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <geometry/LodChain.h>
+
+#include <utils/Panic.h>
+
+#include <meshoptimizer.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace filament {
+namespace geometry {
+
+using namespace filament::math;
+using std::vector;
+using Builder = LodChain::Builder;
+
+struct LodChainBuilderImpl {
+    const float3* positions = nullptr;
+    size_t positionStride = 0;
+    size_t vertexCount = 0;
+    const uint3* triangles32 = nullptr;
+    const ushort3* triangles16 = nullptr;
+    size_t triangleCount = 0;
+    size_t lodCount = 4;
+    float reductionFactor = 0.5f;
+    float maxError = 0.1f;
+    bool lockBorder = false;
+    LodChain* build();
+};
+
+struct LodChainImpl {
+    vector<vector<uint32_t>> lods;
+    vector<float> errors;
+    float scale = 0.0f;
+};
+
+Builder::Builder() noexcept : mImpl(new LodChainBuilderImpl) {}
+
+Builder::~Builder() noexcept { delete mImpl; }
+
+Builder::Builder(Builder&& that) noexcept {
+    std::swap(mImpl, that.mImpl);
+}
+
+Builder& Builder::operator=(Builder&& that) noexcept {
+    std::swap(mImpl, that.mImpl);
+    return *this;
+}
+
+Builder& Builder::positions(const float3* positions, size_t stride) noexcept {
+    mImpl->positions = positions;
+    mImpl->positionStride = stride;
+    return *this;
+}
+
+Builder& Builder::vertexCount(size_t vertexCount) noexcept {
+    mImpl->vertexCount = vertexCount;
+    return *this;
+}
+
+Builder& Builder::triangles(const uint3* triangles) noexcept {
+    mImpl->triangles32 = triangles;
+    return *this;
+}
+
+Builder& Builder::triangles(const ushort3* triangles) noexcept {
+    mImpl->triangles16 = triangles;
+    return *this;
+}
+
+Builder& Builder::triangleCount(size_t triangleCount) noexcept {
+    mImpl->triangleCount = triangleCount;
+    return *this;
+}
+
+Builder& Builder::lodCount(size_t lodCount) noexcept {
+    mImpl->lodCount = lodCount;
+    return *this;
+}
+
+Builder& Builder::reductionFactor(float factor) noexcept {
+    mImpl->reductionFactor = factor;
+    return *this;
+}
+
+Builder& Builder::maxError(float error) noexcept {
+    mImpl->maxError = error;
+    return *this;
+}
+
+Builder& Builder::lockBorder(bool lock) noexcept {
+    mImpl->lockBorder = lock;
+    return *this;
+}
+
+LodChain* Builder::build() {
+    // The header promises null for incomplete data in every build configuration, so these
+    // log-and-return rather than using ASSERT_PRECONDITION_NON_FATAL, which panics in
+    // debug and exceptions-enabled builds.
+    if (!mImpl->positions) {
+        PANIC_LOG("Positions are required.");
+        return nullptr;
+    }
+    if (mImpl->vertexCount == 0) {
+        PANIC_LOG("Vertex count must be non-zero.");
+        return nullptr;
+    }
+    if (!mImpl->triangles16 && !mImpl->triangles32) {
+        PANIC_LOG("Triangles are required.");
+        return nullptr;
+    }
+    if (mImpl->triangles16 && mImpl->triangles32) {
+        PANIC_LOG("Choose 16 or 32-bit indices, not both.");
+        return nullptr;
+    }
+    if (mImpl->triangleCount == 0) {
+        PANIC_LOG("Triangle count is required.");
+        return nullptr;
+    }
+    if (mImpl->lodCount == 0) {
+        PANIC_LOG("LOD count must be non-zero.");
+        return nullptr;
+    }
+    if (mImpl->reductionFactor <= 0.0f || mImpl->reductionFactor >= 1.0f) {
+        PANIC_LOG("Reduction factor must be in (0, 1).");
+        return nullptr;
+    }
+    return mImpl->build();
+}
+
+LodChain* LodChainBuilderImpl::build() {
+    const size_t indexCount = triangleCount * 3;
+    const size_t stride = positionStride ? positionStride : sizeof(float3);
+    const float* vertices = &positions->x;
+
+    LodChainImpl* impl = new LodChainImpl;
+    impl->scale = meshopt_simplifyScale(vertices, vertexCount, stride);
+
+    // level 0 is the input mesh
+    vector<uint32_t> base(indexCount);
+    if (triangles32) {
+        const uint32_t* src = &triangles32->x;
+        std::copy(src, src + indexCount, base.begin());
+    } else {
+        const uint16_t* src = &triangles16->x;
+        std::copy(src, src + indexCount, base.begin());
+    }
+    impl->lods.push_back(std::move(base));
+    impl->errors.push_back(0.0f);
+
+    const unsigned int options = lockBorder ? meshopt_SimplifyLockBorder : 0;
+    for (size_t lod = 1; lod < lodCount; ++lod) {
+        vector<uint32_t> const& previous = impl->lods.back();
+        const size_t targetIndexCount =
+                (size_t(float(previous.size()) * reductionFactor) / 3) * 3;
+        if (targetIndexCount < 3) {
+            break;
+        }
+
+        // Each level is simplified from the previous one, so the reported error is measured
+        // against that level; keeping the running maximum makes the chain's errors monotonic
+        // and a reasonable (slightly optimistic) bound against level 0.
+        float error = 0.0f;
+        vector<uint32_t> indices(previous.size());
+        indices.resize(meshopt_simplify(indices.data(), previous.data(), previous.size(),
+                vertices, vertexCount, stride, targetIndexCount, maxError, options, &error));
+
+        // stop once the simplifier can't make meaningful progress within the error budget
+        if (indices.size() >= previous.size()) {
+            break;
+        }
+        impl->lods.push_back(std::move(indices));
+        impl->errors.push_back(std::max(error, impl->errors.back()));
+    }
+
+    return new LodChain(impl);
+}
+
+LodChain::LodChain(LodChainImpl* impl) noexcept : mImpl(impl) {}
+
+LodChain::~LodChain() noexcept { delete mImpl; }
+
+LodChain::LodChain(LodChain&& that) noexcept {
+    std::swap(mImpl, that.mImpl);
+}
+
+LodChain& LodChain::operator=(LodChain&& that) noexcept {
+    std::swap(mImpl, that.mImpl);
+    return *this;
+}
+
+size_t LodChain::getLodCount() const noexcept {
+    return mImpl->lods.size();
+}
+
+uint32_t const* LodChain::getIndices(size_t lod) const noexcept {
+    return mImpl->lods[lod].data();
+}
+
+size_t LodChain::getIndexCount(size_t lod) const noexcept {
+    return mImpl->lods[lod].size();
+}
+
+float LodChain::getError(size_t lod) const noexcept {
+    return mImpl->errors[lod];
+}
+
+float LodChain::getScale() const noexcept {
+    return mImpl->scale;
+}
+
+} // namespace geometry
+} // namespace filament
@@ -0,0 +1,245 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <geometry/Meshlets.h>
+
+#include <utils/Panic.h>
+
+#include <meshoptimizer.h>
+
+#include <vector>
+
+namespace filament {
+namespace geometry {
+
+using namespace filament::math;
+using std::vector;
+using Builder = Meshlets::Builder;
+
+struct MeshletsBuilderImpl {
+    const float3* positions = nullptr;
+    size_t positionStride = 0;
+    size_t vertexCount = 0;
+    const uint3* triangles32 = nullptr;
+    const ushort3* triangles16 = nullptr;
+    size_t triangleCount = 0;
+    size_t maxVertices = 64;
+    size_t maxTriangles = 124;
+    float coneWeight = 0.0f;
+    Meshlets* build();
+};
+
+struct MeshletsImpl {
+    vector<Meshlets::Meshlet> meshlets;
+    vector<Meshlets::Bounds> bounds;
+    vector<uint32_t> vertexIndices;
+    vector<uint8_t> triangles;
+};
+
+Builder::Builder() noexcept : mImpl(new MeshletsBuilderImpl) {}
+
+Builder::~Builder() noexcept { delete mImpl; }
+
+Builder::Builder(Builder&& that) noexcept {
+    std::swap(mImpl, that.mImpl);
+}
+
+Builder& Builder::operator=(Builder&& that) noexcept {
+    std::swap(mImpl, that.mImpl);
+    return *this;
+}
+
+Builder& Builder::positions(const float3* positions, size_t stride) noexcept {
+    mImpl->positions = positions;
+    mImpl->positionStride = stride;
+    return *this;
+}
+
+Builder& Builder::vertexCount(size_t vertexCount) noexcept {
+    mImpl->vertexCount = vertexCount;
+    return *this;
+}
+
+Builder& Builder::triangles(const uint3* triangles) noexcept {
+    mImpl->triangles32 = triangles;
+    return *this;
+}
+
+Builder& Builder::triangles(const ushort3* triangles) noexcept {
+    mImpl->triangles16 = triangles;
+    return *this;
+}
+
+Builder& Builder::triangleCount(size_t triangleCount) noexcept {
+    mImpl->triangleCount = triangleCount;
+    return *this;
+}
+
+Builder& Builder::maxVertices(size_t maxVertices) noexcept {
+    mImpl->maxVertices = maxVertices;
+    return *this;
+}
+
+Builder& Builder::maxTriangles(size_t maxTriangles) noexcept {
+    mImpl->maxTriangles = maxTriangles;
+    return *this;
+}
+
+Builder& Builder::coneWeight(float coneWeight) noexcept {
+    mImpl->coneWeight = coneWeight;
+    return *this;
+}
+
+Meshlets* Builder::build() {
+    // The header promises null for incomplete data in every build configuration, so these
+    // log-and-return rather than using ASSERT_PRECONDITION_NON_FATAL, which panics in
+    // debug and exceptions-enabled builds.
+    if (!mImpl->positions) {
+        PANIC_LOG("Positions are required.");
+        return nullptr;
+    }
+    if (mImpl->vertexCount == 0) {
+        PANIC_LOG("Vertex count must be non-zero.");
+        return nullptr;
+    }
+    if (!mImpl->triangles16 && !mImpl->triangles32) {
+        PANIC_LOG("Triangles are required.");
+        return nullptr;
+    }
+    if (mImpl->triangles16 && mImpl->triangles32) {
+        PANIC_LOG("Choose 16 or 32-bit indices, not both.");
+        return nullptr;
+    }
+    if (mImpl->triangleCount == 0) {
+        PANIC_LOG("Triangle count is required.");
+        return nullptr;
+    }
+    if (mImpl->maxVertices == 0 || mImpl->maxVertices > 255) {
+        PANIC_LOG("Max vertices must be in [1, 255].");
+        return nullptr;
+    }
+    if (mImpl->maxTriangles == 0 || mImpl->maxTriangles > 512) {
+        PANIC_LOG("Max triangles must be in [1, 512].");
+        return nullptr;
+    }
+    return mImpl->build();
+}
+
+Meshlets* MeshletsBuilderImpl::build() {
+    const size_t indexCount = triangleCount * 3;
+
+    // The clusterizer consumes 32-bit indices; expand 16-bit triangles when necessary.
+    vector<uint32_t> indices(indexCount);
+    if (triangles32) {
+        const uint32_t* src = &triangles32->x;
+        std::copy(src, src + indexCount, indices.begin());
+    } else {
+        const uint16_t* src = &triangles16->x;
+        std::copy(src, src + indexCount, indices.begin());
+    }
+
+    const size_t stride = positionStride ? positionStride : sizeof(float3);
+    const float* vertices = &positions->x;
+
+    const size_t maxMeshlets = meshopt_buildMeshletsBound(indexCount, maxVertices, maxTriangles);
+    vector<meshopt_Meshlet> meshlets(maxMeshlets);
+    vector<uint32_t> vertexIndices(maxMeshlets * maxVertices);
+    vector<uint8_t> triangles(maxMeshlets * maxTriangles * 3);
+
+    const size_t meshletCount = meshopt_buildMeshlets(meshlets.data(), vertexIndices.data(),
+            triangles.data(), indices.data(), indexCount, vertices, vertexCount, stride,
+            maxVertices, maxTriangles, coneWeight);
+
+    MeshletsImpl* impl = new MeshletsImpl;
+    impl->meshlets.reserve(meshletCount);
+    impl->bounds.reserve(meshletCount);
+
+    for (size_t i = 0; i < meshletCount; ++i) {
+        const meshopt_Meshlet& m = meshlets[i];
+        impl->meshlets.push_back({
+                .vertexOffset = m.vertex_offset,
+                .triangleOffset = m.triangle_offset,
+                .vertexCount = m.vertex_count,
+                .triangleCount = m.triangle_count });
+
+        const meshopt_Bounds b = meshopt_computeMeshletBounds(&vertexIndices[m.vertex_offset],
+                &triangles[m.triangle_offset], m.triangle_count, vertices, vertexCount, stride);
+        impl->bounds.push_back({
+                .center = { b.center[0], b.center[1], b.center[2] },
+                .radius = b.radius,
+                .coneApex = { b.cone_apex[0], b.cone_apex[1], b.cone_apex[2] },
+                .coneCutoff = b.cone_cutoff,
+                .coneAxis = { b.cone_axis[0], b.cone_axis[1], b.cone_axis[2] } });
+    }
+
+    // Trim the worst-case allocations down to the data the last meshlet actually uses.
+    if (meshletCount > 0) {
+        const meshopt_Meshlet& last = meshlets[meshletCount - 1];
+        vertexIndices.resize(last.vertex_offset + last.vertex_count);
+        triangles.resize(last.triangle_offset + last.triangle_count * 3);
+    } else {
+        vertexIndices.clear();
+        triangles.clear();
+    }
+    impl->vertexIndices = std::move(vertexIndices);
+    impl->triangles = std::move(triangles);
+
+    return new Meshlets(impl);
+}
+
+Meshlets::Meshlets(MeshletsImpl* impl) noexcept : mImpl(impl) {}
+
+Meshlets::~Meshlets() noexcept { delete mImpl; }
+
+Meshlets::Meshlets(Meshlets&& that) noexcept {
+    std::swap(mImpl, that.mImpl);
+}
+
+Meshlets& Meshlets::operator=(Meshlets&& that) noexcept {
+    std::swap(mImpl, that.mImpl);
+    return *this;
+}
+
+size_t Meshlets::getMeshletCount() const noexcept {
+    return mImpl->meshlets.size();
+}
+
+Meshlets::Meshlet const* Meshlets::getMeshlets() const noexcept {
+    return mImpl->meshlets.data();
+}
+
+Meshlets::Bounds const* Meshlets::getBounds() const noexcept {
+    return mImpl->bounds.data();
+}
+
+uint32_t const* Meshlets::getVertexIndices() const noexcept {
+    return mImpl->vertexIndices.data();
+}
+
+size_t Meshlets::getVertexIndexCount() const noexcept {
+    return mImpl->vertexIndices.size();
+}
+
+uint8_t const* Meshlets::getTriangles() const noexcept {
+    return mImpl->triangles.data();
+}
+
+size_t Meshlets::getTriangleIndexCount() const noexcept {
+    return mImpl->triangles.size();
+}
+
+} // namespace geometry
+} // namespace filament
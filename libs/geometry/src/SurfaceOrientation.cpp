@@ -16,12 +16,14 @@
 
 #include <geometry/SurfaceOrientation.h>
 
+#include <utils/JobSystem.h>
 #include <utils/Panic.h>
 #include <utils/debug.h>
 
 #include <math/mat3.h>
 #include <math/norm.h>
 
+#include <functional>
 #include <vector>
 
 namespace filament {
@@ -44,6 +46,7 @@ struct OrientationBuilderImpl {
     size_t uvStride = 0;
     size_t positionStride = 0;
     size_t triangleCount = 0;
+    utils::JobSystem* jobSystem = nullptr;
     SurfaceOrientation* buildWithNormalsOnly();
     SurfaceOrientation* buildWithSuppliedTangents();
     SurfaceOrientation* buildWithUvs();
@@ -111,6 +114,11 @@ Builder& Builder::triangles(const ushort3* triangles) noexcept {
     return *this;
 }
 
+Builder& Builder::jobSystem(utils::JobSystem* jobSystem) noexcept {
+    mImpl->jobSystem = jobSystem;
+    return *this;
+}
+
 SurfaceOrientation* Builder::build() {
     if (!ASSERT_PRECONDITION_NON_FATAL(mImpl->vertexCount > 0, "Vertex count must be non-zero.")) {
         return nullptr;
@@ -170,19 +178,40 @@ static void frisvadTangentSpace(const float3& N, float3& T, float3& B) {
     B = float3(1.0f - N.x * N.x * a, -N.x, b);
 }
 
+// Invokes the given per-vertex functor over [0, vertexCount), either serially or distributed
+// across JobSystem workers. The functor must be safe to invoke concurrently for distinct indices.
+template<typename F>
+static void forEachVertex(utils::JobSystem* js, size_t vertexCount, F const& func) {
+    constexpr size_t MIN_PARALLEL_VERTEX_COUNT = 16384;
+    if (js && vertexCount >= MIN_PARALLEL_VERTEX_COUNT) {
+        auto work = [&func](uint32_t start, uint32_t count) {
+            for (uint32_t i = start, end = start + count; i < end; ++i) {
+                func(i);
+            }
+        };
+        auto* job = utils::jobs::parallel_for(*js, nullptr, uint32_t(0), uint32_t(vertexCount),
+                std::cref(work), utils::jobs::CountSplitter<4096>());
+        js->runAndWait(job);
+    } else {
+        for (size_t i = 0; i < vertexCount; ++i) {
+            func(i);
+        }
+    }
+}
+
 SurfaceOrientation* OrientationBuilderImpl::buildWithNormalsOnly() {
     vector<quatf> quats(vertexCount);
 
-    const float3* normal = this->normals;
+    const uint8_t* normals = (const uint8_t*) this->normals;
     size_t nstride = this->normalStride ? this->normalStride : sizeof(float3);
+    quatf* out = quats.data();
 
-    for (size_t qindex = 0; qindex < vertexCount; ++qindex) {
-        float3 n = *normal;
+    forEachVertex(jobSystem, vertexCount, [=](size_t qindex) {
+        float3 n = *(const float3*) (normals + qindex * nstride);
         float3 b, t;
         frisvadTangentSpace(n, t, b);
-        quats[qindex] = mat3f::packTangentFrame({t, b, n});
-        normal = (const float3*) (((const uint8_t*) normal) + nstride);
-    }
+        out[qindex] = mat3f::packTangentFrame({t, b, n});
+    });
 
     return new SurfaceOrientation(new OrientationImpl( { std::move(quats) } ));
 }
@@ -190,29 +219,28 @@ SurfaceOrientation* OrientationBuilderImpl::buildWithNormalsOnly() {
 SurfaceOrientation* OrientationBuilderImpl::buildWithSuppliedTangents() {
     vector<quatf> quats(vertexCount);
 
-    const float3* normal = this->normals;
+    const uint8_t* normals = (const uint8_t*) this->normals;
     size_t nstride = this->normalStride ? this->normalStride : sizeof(float3);
 
-    const float3* tanvec = (const float3*) this->tangents;
-    const float* tandir = &this->tangents->w;
+    const uint8_t* tangents = (const uint8_t*) this->tangents;
     size_t tstride = this->tangentStride ? this->tangentStride : sizeof(float4);
 
-    for (size_t qindex = 0; qindex < vertexCount; ++qindex) {
-        float3 n = *normal;
-        float3 t = *tanvec;
-        float3 b = *tandir > 0 ? cross(t, n) : cross(n, t);
+    quatf* out = quats.data();
+
+    forEachVertex(jobSystem, vertexCount, [=](size_t qindex) {
+        float3 n = *(const float3*) (normals + qindex * nstride);
+        float4 tangent = *(const float4*) (tangents + qindex * tstride);
+        float3 t = tangent.xyz;
+        float3 b = tangent.w > 0 ? cross(t, n) : cross(n, t);
 
         // Some assets do not provide perfectly orthogonal tangents and normals, so we adjust the
         // tangent to enforce orthonormality. We would rather honor the exact normal vector than
         // the exact tangent vector since the latter is only used for bump mapping and anisotropic
         // lighting.
-        t = *tandir > 0 ? cross(n, b) : cross(b, n);
+        t = tangent.w > 0 ? cross(n, b) : cross(b, n);
 
-        quats[qindex] = mat3f::packTangentFrame({t, b, n});
-        normal = (const float3*) (((const uint8_t*) normal) + nstride);
-        tanvec = (const float3*) (((const uint8_t*) tanvec) + tstride);
-        tandir = (const float*) (((const uint8_t*) tandir) + tstride);
-    }
+        out[qindex] = mat3f::packTangentFrame({t, b, n});
+    });
 
     return new SurfaceOrientation(new OrientationImpl( { std::move(quats) } ));
 }
@@ -285,11 +313,17 @@ SurfaceOrientation* OrientationBuilderImpl::buildWithUvs() {
         tan2[tri.z] += tdir;
     }
 
+    // Note that the triangle loop above scatters into shared accumulators and therefore stays
+    // serial; only this per-vertex pass is distributed over the JobSystem.
     vector<quatf> quats(vertexCount);
-    for (size_t a = 0; a < vertexCount; a++) {
+    quatf* out = quats.data();
+    const float3* normals = this->normals;
+    const float3* tan1data = tan1.data();
+    const float3* tan2data = tan2.data();
+    forEachVertex(jobSystem, vertexCount, [=](size_t a) {
         const float3& n = normals[a];
-        const float3& t1 = tan1[a];
-        const float3& t2 = tan2[a];
+        const float3& t1 = tan1data[a];
+        const float3& t2 = tan2data[a];
 
         // Gram-Schmidt orthogonalize
         float3 t = normalize(t1 - n * dot(n, t1));
@@ -298,8 +332,8 @@ SurfaceOrientation* OrientationBuilderImpl::buildWithUvs() {
         float w = (dot(cross(n, t1), t2) < 0.0f) ? -1.0f : 1.0f;
 
         float3 b = w < 0 ? cross(t, n) : cross(n, t);
-        quats[a] = mat3f::packTangentFrame({t, b, n});
-    }
+        out[a] = mat3f::packTangentFrame({t, b, n});
+    });
     return new SurfaceOrientation(new OrientationImpl( { std::move(quats) } ));
 }
 
@@ -503,6 +503,159 @@ void lengyelMethod(TangentSpaceMeshInput const* input, TangentSpaceMeshOutput* o
     output->triangles16.borrow(triangles16);
 }
 
+inline void writeQuat(quatf const& q, quatf* out) noexcept {
+    *out = q;
+}
+
+inline void writeQuat(quatf const& q, short4* out) noexcept {
+    *out = packSnorm16(q.xyzw);
+}
+
+inline void writeQuat(quatf const& q, quath* out) noexcept {
+    *out = quath(q.xyzw);
+}
+
+// Builds a CSR table mapping each input vertex to the triangles referencing it. Only needed by
+// the incremental update path of remeshing algorithms, so it is built lazily on first use.
+void buildVertexTriangleAdjacency(TangentSpaceMeshInput const* input,
+        TangentSpaceMeshOutput* output) {
+    size_t const vertexCount = input->vertexCount;
+    size_t const triangleCount = input->triangleCount;
+    auto const* triangles16 = input->triangles16;
+    auto const* triangles32 = input->triangles32;
+
+    auto& offsets = output->vertexTriangleOffsets;
+    auto& adjacent = output->vertexTriangles;
+    offsets.assign(vertexCount + 1, 0);
+    for (size_t tindex = 0; tindex < triangleCount; ++tindex) {
+        uint3 const tri = triangles16 ? uint3(triangles16[tindex]) : triangles32[tindex];
+        ++offsets[tri.x + 1];
+        ++offsets[tri.y + 1];
+        ++offsets[tri.z + 1];
+    }
+    for (size_t v = 0; v < vertexCount; ++v) {
+        offsets[v + 1] += offsets[v];
+    }
+    adjacent.resize(triangleCount * 3);
+    std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (size_t tindex = 0; tindex < triangleCount; ++tindex) {
+        uint3 const tri = triangles16 ? uint3(triangles16[tindex]) : triangles32[tindex];
+        adjacent[cursor[tri.x]++] = tindex;
+        adjacent[cursor[tri.y]++] = tindex;
+        adjacent[cursor[tri.z]++] = tindex;
+    }
+}
+
+// Recomputes the tangent frames affected by the given dirty input vertices, mirroring the exact
+// arithmetic of the corresponding full-mesh method so that incremental and full results agree
+// bit-for-bit. Each recomputed frame is written both to the internal output arrays and to the
+// caller's buffer.
+template<typename QuatType>
+void updateQuatsImpl(TangentSpaceMeshInput const* input, TangentSpaceMeshOutput* output,
+        uint32_t const* dirtyVertices, size_t dirtyVertexCount, QuatType* out, size_t stride) {
+    switch (output->algorithm) {
+        case AlgorithmImpl::FRISVAD: {
+            float3 const* UTILS_RESTRICT normals = input->normals();
+            size_t const nstride = input->normalsStride();
+            auto& quats = output->tspace();
+            for (size_t i = 0; i < dirtyVertexCount; ++i) {
+                uint32_t const v = dirtyVertices[i];
+                assert_invariant(v < output->vertexCount);
+                float3 const n = *pointerAdd(normals, v, nstride);
+                auto const [b, t] = frisvadKernel(n);
+                quatf const q = mat3f::packTangentFrame({t, b, n}, sizeof(int32_t));
+                quats[v] = q;
+                writeQuat(q, pointerAdd(out, v, stride));
+            }
+            break;
+        }
+        case AlgorithmImpl::HUGHES_MOLLER: {
+            float3 const* UTILS_RESTRICT normals = input->normals();
+            size_t const nstride = input->normalsStride();
+            auto& quats = output->tspace();
+            for (size_t i = 0; i < dirtyVertexCount; ++i) {
+                uint32_t const v = dirtyVertices[i];
+                assert_invariant(v < output->vertexCount);
+                float3 const n = *pointerAdd(normals, v, nstride);
+                float3 b, t;
+                if (abs(n.x) > abs(n.z) + std::numeric_limits<float>::epsilon()) {
+                    t = float3{-n.y, n.x, 0.0f};
+                } else {
+                    t = float3{0.0f, -n.z, n.y};
+                }
+                t = normalize(t);
+                b = cross(n, t);
+                quatf const q = mat3f::packTangentFrame({t, b, n}, sizeof(int32_t));
+                quats[v] = q;
+                writeQuat(q, pointerAdd(out, v, stride));
+            }
+            break;
+        }
+        case AlgorithmImpl::TANGENTS_PROVIDED: {
+            float3 const* normal = input->normals();
+            size_t const nstride = input->normalsStride();
+            float4 const* tanvec = input->tangents();
+            auto& quats = output->tspace();
+            for (size_t i = 0; i < dirtyVertexCount; ++i) {
+                uint32_t const v = dirtyVertices[i];
+                assert_invariant(v < output->vertexCount);
+                float3 const& n = *pointerAdd(normal, v, nstride);
+                float4 const& t4 = *pointerAdd(tanvec, v, nstride);
+                float3 tv = t4.xyz;
+                float3 const b = t4.w > 0 ? cross(tv, n) : cross(n, tv);
+                tv = t4.w > 0 ? cross(n, b) : cross(b, n);
+                quatf const q = mat3f::packTangentFrame({tv, b, n});
+                quats[v] = q;
+                writeQuat(q, pointerAdd(out, v, stride));
+            }
+            break;
+        }
+        case AlgorithmImpl::FLAT_SHADING: {
+            if (output->vertexTriangleOffsets.empty()) {
+                buildVertexTriangleAdjacency(input, output);
+            }
+            float3 const* positions = input->positions();
+            size_t const pstride = input->positionsStride();
+            auto const* triangles16 = input->triangles16;
+            auto const* triangles32 = input->triangles32;
+            auto& quats = output->tspace();
+            auto& outPositions = output->positions();
+            auto const& offsets = output->vertexTriangleOffsets;
+            auto const& adjacent = output->vertexTriangles;
+            for (size_t i = 0; i < dirtyVertexCount; ++i) {
+                uint32_t const v = dirtyVertices[i];
+                assert_invariant(v < input->vertexCount);
+                for (uint32_t slot = offsets[v]; slot < offsets[v + 1]; ++slot) {
+                    uint32_t const tindex = adjacent[slot];
+                    uint3 const tri = triangles16 ? uint3(triangles16[tindex]) :
+                            triangles32[tindex];
+
+                    float3 const pa = *pointerAdd(positions, tri.x, pstride);
+                    float3 const pb = *pointerAdd(positions, tri.y, pstride);
+                    float3 const pc = *pointerAdd(positions, tri.z, pstride);
+
+                    float3 const n = normalize(cross(pc - pb, pa - pb));
+                    const auto [t, b] = frisvadKernel(n);
+                    quatf const tspace = mat3f::packTangentFrame({t, b, n}, sizeof(int32_t));
+
+                    uint32_t const i0 = tindex * 3;
+                    outPositions[i0 + 0] = pa;
+                    outPositions[i0 + 1] = pb;
+                    outPositions[i0 + 2] = pc;
+                    for (uint32_t corner = 0; corner < 3; ++corner) {
+                        quats[i0 + corner] = tspace;
+                        writeQuat(tspace, pointerAdd(out, i0 + corner, stride));
+                    }
+                }
+            }
+            break;
+        }
+        default:
+            FILAMENT_CHECK_PRECONDITION(false) << "updateQuats is not supported for algorithm="
+                    << to_string(output->algorithm).data();
+    }
+}
+
 void auxImpl(TangentSpaceMeshInput::AttributeMap& attributeData, AttributeImpl attribute,
         InData data, size_t stride) noexcept {
     attributeData[attribute] = {
@@ -746,6 +899,24 @@ void TangentSpaceMesh::getQuats(quath* out, size_t stride) const noexcept {
     }
 }
 
+void TangentSpaceMesh::updateQuats(uint32_t const* dirtyVertices, size_t dirtyVertexCount,
+        quatf* out, size_t stride) const {
+    stride = stride ? stride : sizeof(decltype(*out));
+    updateQuatsImpl(mInput, mOutput, dirtyVertices, dirtyVertexCount, out, stride);
+}
+
+void TangentSpaceMesh::updateQuats(uint32_t const* dirtyVertices, size_t dirtyVertexCount,
+        short4* out, size_t stride) const {
+    stride = stride ? stride : sizeof(decltype(*out));
+    updateQuatsImpl(mInput, mOutput, dirtyVertices, dirtyVertexCount, out, stride);
+}
+
+void TangentSpaceMesh::updateQuats(uint32_t const* dirtyVertices, size_t dirtyVertexCount,
+        quath* out, size_t stride) const {
+    stride = stride ? stride : sizeof(decltype(*out));
+    updateQuatsImpl(mInput, mOutput, dirtyVertices, dirtyVertexCount, out, stride);
+}
+
 template void TangentSpaceMesh::getAux<float2>(AuxAttribute attribute, float2* out,
         size_t stride) const noexcept;
 
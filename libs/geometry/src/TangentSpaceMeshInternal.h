@@ -135,9 +135,8 @@ public:
     }
 
     T& operator [](int i) {
-        if (mBorrowed) {
-            return *pointerAdd(mBorrowed, i, mBorrowedStride);
-        }
+        // Borrowed arrays alias the client's input and must stay immutable.
+        assert_invariant(!mBorrowed);
         return mAllocated[i];
     }
 
@@ -419,6 +418,13 @@ struct TangentSpaceMeshOutput {
     InternalArray<ushort3> triangles16;
 
     std::unordered_map<AttributeImpl, ArrayType> attributeData;
+
+    // Maps each input vertex to the triangles referencing it, in CSR layout (offsets has
+    // vertexCount + 1 entries indexing into triangles). Built lazily by the incremental update
+    // path; only needed for remeshing algorithms, where a dirty input vertex fans out to
+    // several output vertices.
+    std::vector<uint32_t> vertexTriangleOffsets;
+    std::vector<uint32_t> vertexTriangles;
 };
 
 }// namespace filament::geometry
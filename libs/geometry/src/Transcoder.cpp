@@ -16,31 +16,23 @@
 
 #include <geometry/Transcoder.h>
 
-#include <math/half.h>
-
-using filament::math::half;
+#include <string.h>
 
 namespace filament {
 namespace geometry {
 
-// The internal workhorse function of the Transcoder, which takes arbitrary input but always
-// produced packed floats. We expose a more readable interface than this to users, who often have
-// untyped blobs of interleaved data. Note that this variant takes an arbitrary number of
-// components, we also have a fixed-size variant for better compiler output.
-template<typename SOURCE_TYPE, int NORMALIZATION_FACTOR>
-void convert(float* UTILS_RESTRICT target, void const* UTILS_RESTRICT source, size_t count,
-        int componentCount, int srcStride) noexcept {
-    constexpr float scale = 1.0f / float(NORMALIZATION_FACTOR);
-    uint8_t const* srcBytes = (uint8_t const*) source;
-    for (size_t i = 0; i < count; ++i, target += componentCount, srcBytes += srcStride) {
-        SOURCE_TYPE const* src = (SOURCE_TYPE const*) srcBytes;
-        for (int n = 0; n < componentCount; ++n) {
-            target[n] = float(src[n]) * scale;
-        }
-    }
-}
+namespace {
 
-template<typename SOURCE_TYPE, int NORMALIZATION_FACTOR, int NUM_COMPONENTS>
+// The internal workhorse kernels of the Transcoder, which take arbitrary input but always produce
+// packed floats. We expose a more readable interface than this to users, who often have untyped
+// blobs of interleaved data. A kernel is instantiated per (source type, normalization factor,
+// clamping, component count) combination and selected exactly once per transcode call, so the
+// per-vertex loops are fully typed, branch-free, and short enough to auto-vectorize.
+//
+// Clamping is required for normalized signed types: for example, -128 can be represented in SBYTE
+// but is outside the permitted range and should therefore be clamped to -1. For more information,
+// see the Vulkan spec under the section "Conversion from Normalized Fixed-Point to Floating-Point".
+template<typename SOURCE_TYPE, int NORMALIZATION_FACTOR, bool CLAMPED, int NUM_COMPONENTS>
 void convert(float* UTILS_RESTRICT target, void const* UTILS_RESTRICT source, size_t count,
         int srcStride) noexcept {
     constexpr float scale = 1.0f / float(NORMALIZATION_FACTOR);
@@ -48,17 +40,20 @@ void convert(float* UTILS_RESTRICT target, void const* UTILS_RESTRICT source, si
     for (size_t i = 0; i < count; ++i, target += NUM_COMPONENTS, srcBytes += srcStride) {
         SOURCE_TYPE const* src = (SOURCE_TYPE const*) srcBytes;
         for (int n = 0; n < NUM_COMPONENTS; ++n) {
-            target[n] = float(src[n]) * scale;
+            const float value = float(src[n]) * scale;
+            if constexpr (CLAMPED) {
+                target[n] = value < -1.0f ? -1.0f : value;
+            } else {
+                target[n] = value;
+            }
         }
     }
 }
 
-// Similar to "convert" but clamps the result to -1, which is required for normalized signed types.
-// For example, -128 can be represented in SBYTE but is outside the permitted range and should
-// therefore be clamped. For more information, see the Vulkan spec under the section "Conversion
-// from Normalized Fixed-Point to Floating-Point".
-template<typename SOURCE_TYPE, int NORMALIZATION_FACTOR>
-void convertClamped(float* UTILS_RESTRICT target, void const* UTILS_RESTRICT source, size_t count,
+// Variant of the above that takes an arbitrary number of components, used as a fallback for
+// component counts that do not have a dedicated instantiation.
+template<typename SOURCE_TYPE, int NORMALIZATION_FACTOR, bool CLAMPED>
+void convert(float* UTILS_RESTRICT target, void const* UTILS_RESTRICT source, size_t count,
         int componentCount, int srcStride) noexcept {
     constexpr float scale = 1.0f / float(NORMALIZATION_FACTOR);
     uint8_t const* srcBytes = (uint8_t const*) source;
@@ -66,25 +61,98 @@ void convertClamped(float* UTILS_RESTRICT target, void const* UTILS_RESTRICT sou
         SOURCE_TYPE const* src = (SOURCE_TYPE const*) srcBytes;
         for (int n = 0; n < componentCount; ++n) {
             const float value = float(src[n]) * scale;
-            target[n] = value < -1.0f ? -1.0f : value;
+            if constexpr (CLAMPED) {
+                target[n] = value < -1.0f ? -1.0f : value;
+            } else {
+                target[n] = value;
+            }
         }
     }
 }
 
-template<typename SOURCE_TYPE, int NORMALIZATION_FACTOR, int NUM_COMPONENTS>
-void convertClamped(float* UTILS_RESTRICT target, void const* UTILS_RESTRICT source, size_t count,
+// Selects the fixed-size kernel for the given component count. glTF attributes have at most 4
+// components, so in practice the variable-count fallback never runs.
+template<typename SOURCE_TYPE, int NORMALIZATION_FACTOR, bool CLAMPED = false>
+void dispatch(float* UTILS_RESTRICT target, void const* UTILS_RESTRICT source, size_t count,
+        int componentCount, int srcStride) noexcept {
+    switch (componentCount) {
+        case 1:
+            convert<SOURCE_TYPE, NORMALIZATION_FACTOR, CLAMPED, 1>(target, source, count,
+                    srcStride);
+            break;
+        case 2:
+            convert<SOURCE_TYPE, NORMALIZATION_FACTOR, CLAMPED, 2>(target, source, count,
+                    srcStride);
+            break;
+        case 3:
+            convert<SOURCE_TYPE, NORMALIZATION_FACTOR, CLAMPED, 3>(target, source, count,
+                    srcStride);
+            break;
+        case 4:
+            convert<SOURCE_TYPE, NORMALIZATION_FACTOR, CLAMPED, 4>(target, source, count,
+                    srcStride);
+            break;
+        default:
+            convert<SOURCE_TYPE, NORMALIZATION_FACTOR, CLAMPED>(target, source, count,
+                    componentCount, srcStride);
+            break;
+    }
+}
+
+// Branch-free half to float conversion, consistent with math::half's operator float() including
+// denormals, infinities and NaNs, but written without data-dependent control flow so that the
+// kernels below auto-vectorize. This matters because HALF is the dominant non-float format in
+// quantized glTF assets.
+inline float halfToFloat(uint16_t h) noexcept {
+    union F {
+        uint32_t bits;
+        float fp;
+    };
+    constexpr F magic = { 0xEFu << 23 };  // 2^(127 - 15), undoes the exponent bias difference
+    F out = { uint32_t(h & 0x7FFFu) << 13 };
+    out.fp *= magic.fp;
+    // infinities and NaNs need their exponent extended from 5 to 8 bits
+    out.bits |= ((h & 0x7C00u) == 0x7C00u) ? (0xFFu << 23) : 0u;
+    out.bits |= uint32_t(h & 0x8000u) << 16;
+    return out.fp;
+}
+
+template<int NUM_COMPONENTS>
+void convertHalf(float* UTILS_RESTRICT target, void const* UTILS_RESTRICT source, size_t count,
         int srcStride) noexcept {
-    constexpr float scale = 1.0f / float(NORMALIZATION_FACTOR);
     uint8_t const* srcBytes = (uint8_t const*) source;
     for (size_t i = 0; i < count; ++i, target += NUM_COMPONENTS, srcBytes += srcStride) {
-        SOURCE_TYPE const* src = (SOURCE_TYPE const*) srcBytes;
+        uint16_t const* src = (uint16_t const*) srcBytes;
         for (int n = 0; n < NUM_COMPONENTS; ++n) {
-            const float value = float(src[n]) * scale;
-            target[n] = value < -1.0f ? -1.0f : value;
+            target[n] = halfToFloat(src[n]);
         }
     }
 }
 
+void convertHalf(float* UTILS_RESTRICT target, void const* UTILS_RESTRICT source, size_t count,
+        int componentCount, int srcStride) noexcept {
+    uint8_t const* srcBytes = (uint8_t const*) source;
+    for (size_t i = 0; i < count; ++i, target += componentCount, srcBytes += srcStride) {
+        uint16_t const* src = (uint16_t const*) srcBytes;
+        for (int n = 0; n < componentCount; ++n) {
+            target[n] = halfToFloat(src[n]);
+        }
+    }
+}
+
+void dispatchHalf(float* UTILS_RESTRICT target, void const* UTILS_RESTRICT source, size_t count,
+        int componentCount, int srcStride) noexcept {
+    switch (componentCount) {
+        case 1: convertHalf<1>(target, source, count, srcStride); break;
+        case 2: convertHalf<2>(target, source, count, srcStride); break;
+        case 3: convertHalf<3>(target, source, count, srcStride); break;
+        case 4: convertHalf<4>(target, source, count, srcStride); break;
+        default: convertHalf(target, source, count, componentCount, srcStride); break;
+    }
+}
+
+} // anonymous namespace
+
 size_t Transcoder::operator()(float* UTILS_RESTRICT target, void const* UTILS_RESTRICT source,
         size_t count) const noexcept {
     const size_t required = count * mConfig.componentCount * sizeof(float);
@@ -96,107 +164,58 @@ size_t Transcoder::operator()(float* UTILS_RESTRICT target, void const* UTILS_RE
         case ComponentType::BYTE: {
             const uint32_t stride = mConfig.inputStrideBytes ? mConfig.inputStrideBytes : comp;
             if (mConfig.normalized) {
-                if (comp == 2) {
-                    convertClamped<int8_t, 127, 2>(target, source, count, stride);
-                } else if (comp == 3) {
-                    convertClamped<int8_t, 127, 3>(target, source, count, stride);
-                } else {
-                    convertClamped<int8_t, 127>(target, source, count, comp, stride);
-                }
+                dispatch<int8_t, 127, true>(target, source, count, comp, stride);
             } else {
-                if (comp == 2) {
-                    convert<int8_t, 1, 2>(target, source, count, stride);
-                } else if (comp == 3) {
-                    convert<int8_t, 1, 3>(target, source, count, stride);
-                } else {
-                    convert<int8_t, 1>(target, source, count, comp, stride);
-                }
+                dispatch<int8_t, 1>(target, source, count, comp, stride);
             }
             return required;
         }
         case ComponentType::UBYTE: {
             const uint32_t stride = mConfig.inputStrideBytes ? mConfig.inputStrideBytes : comp;
             if (mConfig.normalized) {
-                if (comp == 2) {
-                    convert<uint8_t, 255, 2>(target, source, count, stride);
-                } else if (comp == 3) {
-                    convert<uint8_t, 255, 3>(target, source, count, stride);
-                } else {
-                    convert<uint8_t, 255>(target, source, count, comp, stride);
-                }
+                dispatch<uint8_t, 255>(target, source, count, comp, stride);
             } else {
-                if (comp == 2) {
-                    convert<uint8_t, 1, 2>(target, source, count, stride);
-                } else if (comp == 3) {
-                    convert<uint8_t, 1, 3>(target, source, count, stride);
-                } else {
-                    convert<uint8_t, 1>(target, source, count, comp, stride);
-                }
+                dispatch<uint8_t, 1>(target, source, count, comp, stride);
             }
             return required;
         }
         case ComponentType::SHORT: {
             const uint32_t stride = mConfig.inputStrideBytes ? mConfig.inputStrideBytes : (2 * comp);
             if (mConfig.normalized) {
-                if (comp == 2) {
-                    convertClamped<int16_t, 32767, 2>(target, source, count, stride);
-                } else if (comp == 3) {
-                    convertClamped<int16_t, 32767, 3>(target, source, count, stride);
-                } else {
-                    convertClamped<int16_t, 32767>(target, source, count, comp, stride);
-                }
+                dispatch<int16_t, 32767, true>(target, source, count, comp, stride);
             } else {
-                if (comp == 2) {
-                    convert<int16_t, 1, 2>(target, source, count, stride);
-                } else if (comp == 3) {
-                    convert<int16_t, 1, 3>(target, source, count, stride);
-                } else {
-                    convert<int16_t, 1>(target, source, count, comp, stride);
-                }
+                dispatch<int16_t, 1>(target, source, count, comp, stride);
             }
             return required;
         }
         case ComponentType::USHORT: {
             const uint32_t stride = mConfig.inputStrideBytes ? mConfig.inputStrideBytes : (2 * comp);
             if (mConfig.normalized) {
-                if (comp == 2) {
-                    convert<uint16_t, 65535, 2>(target, source, count, stride);
-                } else if (comp == 3) {
-                    convert<uint16_t, 65535, 3>(target, source, count, stride);
-                } else {
-                    convert<uint16_t, 65535>(target, source, count, comp, stride);
-                }
+                dispatch<uint16_t, 65535>(target, source, count, comp, stride);
             } else {
-                if (comp == 2) {
-                    convert<uint16_t, 1, 2>(target, source, count, stride);
-                } else if (comp == 3) {
-                    convert<uint16_t, 1, 3>(target, source, count, stride);
-                } else {
-                    convert<uint16_t, 1>(target, source, count, comp, stride);
-                }
+                dispatch<uint16_t, 1>(target, source, count, comp, stride);
             }
             return required;
         }
         case ComponentType::HALF: {
             const uint32_t stride = mConfig.inputStrideBytes ? mConfig.inputStrideBytes : (2 * comp);
-            uint8_t const* srcBytes = (uint8_t const*) source;
-            for (size_t i = 0; i < count; ++i, target += comp, srcBytes += stride) {
-                half const* src = (half const*) srcBytes;
-                for (int n = 0; n < comp; ++n) {
-                    target[n] = float(src[n]);
-                }
-            }
+            dispatchHalf(target, source, count, comp, stride);
             return required;
         }
         case ComponentType::FLOAT: {
             const uint32_t srcStride =
                     mConfig.inputStrideBytes ? mConfig.inputStrideBytes : (4 * comp);
+            // Tightly packed floats need no conversion at all.
+            if (srcStride == 4 * comp) {
+                memcpy(target, source, required);
+                return required;
+            }
             uint8_t const* srcBytes = (uint8_t const*) source;
             for (size_t i = 0; i < count; ++i, target += comp, srcBytes += srcStride) {
                 // This will never break alignment rules because the glTF spec stipulates that the
                 // stride must be a multiple of the component size.
                 float const* src = (float const*) srcBytes;
-                for (int n = 0; n < comp; ++n) {
+                for (uint32_t n = 0; n < comp; ++n) {
                     target[n] = src[n];
                 }
             }
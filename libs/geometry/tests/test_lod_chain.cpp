@@ -0,0 +1,126 @@
+/*
+ * Copyright 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <geometry/LodChain.h>
+
+#include <math/vec3.h>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+using filament::geometry::LodChain;
+using filament::math::float3;
+using filament::math::uint3;
+
+class LodChainTest : public testing::Test {};
+
+// Builds a (cells x cells) grid of quads in the XY plane, two triangles per cell. Being planar,
+// it simplifies aggressively with negligible error.
+static void buildGrid(size_t cells, std::vector<float3>& positions, std::vector<uint3>& triangles) {
+    const size_t verticesPerRow = cells + 1;
+    for (size_t y = 0; y < verticesPerRow; ++y) {
+        for (size_t x = 0; x < verticesPerRow; ++x) {
+            positions.push_back({ float(x), float(y), 0.0f });
+        }
+    }
+    for (size_t y = 0; y < cells; ++y) {
+        for (size_t x = 0; x < cells; ++x) {
+            const uint32_t v0 = uint32_t(y * verticesPerRow + x);
+            const uint32_t v1 = v0 + 1;
+            const uint32_t v2 = v0 + uint32_t(verticesPerRow);
+            const uint32_t v3 = v2 + 1;
+            triangles.push_back({ v0, v1, v2 });
+            triangles.push_back({ v1, v3, v2 });
+        }
+    }
+}
+
+TEST_F(LodChainTest, RequiredArguments) {
+    std::vector<float3> positions;
+    std::vector<uint3> triangles;
+    buildGrid(2, positions, triangles);
+
+    ASSERT_EQ(LodChain::Builder().build(), nullptr);
+    ASSERT_EQ(LodChain::Builder()
+            .positions(positions.data())
+            .vertexCount(positions.size())
+            .build(), nullptr);
+}
+
+TEST_F(LodChainTest, GeneratesChain) {
+    std::vector<float3> positions;
+    std::vector<uint3> triangles;
+    buildGrid(32, positions, triangles);
+
+    std::unique_ptr<LodChain> chain(LodChain::Builder()
+            .positions(positions.data())
+            .vertexCount(positions.size())
+            .triangles(triangles.data())
+            .triangleCount(triangles.size())
+            .lodCount(4)
+            .build());
+    ASSERT_NE(chain, nullptr);
+    ASSERT_GT(chain->getLodCount(), 1u);
+    ASSERT_LE(chain->getLodCount(), 4u);
+    ASSERT_GT(chain->getScale(), 0.0f);
+
+    // level 0 is the input mesh, unchanged
+    ASSERT_EQ(chain->getIndexCount(0), triangles.size() * 3);
+    ASSERT_EQ(chain->getError(0), 0.0f);
+
+    for (size_t lod = 1; lod < chain->getLodCount(); ++lod) {
+        // index counts strictly decrease, errors are monotonic, all indices stay valid
+        ASSERT_LT(chain->getIndexCount(lod), chain->getIndexCount(lod - 1));
+        ASSERT_EQ(chain->getIndexCount(lod) % 3, 0u);
+        ASSERT_GE(chain->getError(lod), chain->getError(lod - 1));
+        ASSERT_LE(chain->getError(lod), 0.1f);
+        for (size_t i = 0; i < chain->getIndexCount(lod); ++i) {
+            ASSERT_LT(chain->getIndices(lod)[i], positions.size());
+        }
+    }
+
+    // a planar grid collapses to very few triangles with near-zero error
+    const size_t last = chain->getLodCount() - 1;
+    ASSERT_LT(chain->getIndexCount(last), chain->getIndexCount(0) / 4);
+    ASSERT_NEAR(chain->getError(last), 0.0f, 1e-3f);
+}
+
+TEST_F(LodChainTest, Indices16) {
+    std::vector<float3> positions;
+    std::vector<uint3> triangles32;
+    buildGrid(16, positions, triangles32);
+    std::vector<filament::math::ushort3> triangles;
+    for (const uint3& t : triangles32) {
+        triangles.push_back({ uint16_t(t.x), uint16_t(t.y), uint16_t(t.z) });
+    }
+
+    std::unique_ptr<LodChain> chain(LodChain::Builder()
+            .positions(positions.data())
+            .vertexCount(positions.size())
+            .triangles(triangles.data())
+            .triangleCount(triangles.size())
+            .build());
+    ASSERT_NE(chain, nullptr);
+    ASSERT_EQ(chain->getIndexCount(0), triangles.size() * 3);
+    ASSERT_GT(chain->getLodCount(), 1u);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
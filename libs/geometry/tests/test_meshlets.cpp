@@ -0,0 +1,172 @@
+/*
+ * Copyright 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <geometry/Meshlets.h>
+
+#include <math/vec3.h>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+using filament::geometry::Meshlets;
+using filament::math::float3;
+using filament::math::uint3;
+
+class MeshletsTest : public testing::Test {};
+
+// Builds a (cells x cells) grid of quads in the XY plane, two triangles per cell.
+static void buildGrid(size_t cells, std::vector<float3>& positions, std::vector<uint3>& triangles) {
+    const size_t verticesPerRow = cells + 1;
+    for (size_t y = 0; y < verticesPerRow; ++y) {
+        for (size_t x = 0; x < verticesPerRow; ++x) {
+            positions.push_back({ float(x), float(y), 0.0f });
+        }
+    }
+    for (size_t y = 0; y < cells; ++y) {
+        for (size_t x = 0; x < cells; ++x) {
+            const uint32_t v0 = uint32_t(y * verticesPerRow + x);
+            const uint32_t v1 = v0 + 1;
+            const uint32_t v2 = v0 + uint32_t(verticesPerRow);
+            const uint32_t v3 = v2 + 1;
+            triangles.push_back({ v0, v1, v2 });
+            triangles.push_back({ v1, v3, v2 });
+        }
+    }
+}
+
+TEST_F(MeshletsTest, RequiredArguments) {
+    std::vector<float3> positions;
+    std::vector<uint3> triangles;
+    buildGrid(2, positions, triangles);
+
+    ASSERT_EQ(Meshlets::Builder().build(), nullptr);
+    ASSERT_EQ(Meshlets::Builder()
+            .positions(positions.data())
+            .vertexCount(positions.size())
+            .build(), nullptr);
+}
+
+TEST_F(MeshletsTest, CoversAllTriangles) {
+    std::vector<float3> positions;
+    std::vector<uint3> triangles;
+    buildGrid(32, positions, triangles);
+
+    std::unique_ptr<Meshlets> meshlets(Meshlets::Builder()
+            .positions(positions.data())
+            .vertexCount(positions.size())
+            .triangles(triangles.data())
+            .triangleCount(triangles.size())
+            .build());
+    ASSERT_NE(meshlets, nullptr);
+    ASSERT_GT(meshlets->getMeshletCount(), 1u);
+
+    size_t triangleCount = 0;
+    std::vector<bool> seen(triangles.size(), false);
+    for (size_t i = 0; i < meshlets->getMeshletCount(); ++i) {
+        const Meshlets::Meshlet& m = meshlets->getMeshlets()[i];
+        ASSERT_LE(m.vertexCount, 64u);
+        ASSERT_LE(m.triangleCount, 124u);
+        triangleCount += m.triangleCount;
+        for (size_t t = 0; t < m.triangleCount; ++t) {
+            // resolve the meshlet-local 8-bit indices back to global vertex indices
+            uint3 triangle;
+            for (size_t k = 0; k < 3; ++k) {
+                const uint8_t local = meshlets->getTriangles()[m.triangleOffset + t * 3 + k];
+                ASSERT_LT(local, m.vertexCount);
+                triangle[k] = meshlets->getVertexIndices()[m.vertexOffset + local];
+                ASSERT_LT(triangle[k], positions.size());
+            }
+            // find it in the source mesh, in any rotation of its vertices
+            bool found = false;
+            for (size_t s = 0; s < triangles.size() && !found; ++s) {
+                const uint3& src = triangles[s];
+                for (size_t r = 0; r < 3 && !found; ++r) {
+                    if (triangle[r] == src.x && triangle[(r + 1) % 3] == src.y &&
+                            triangle[(r + 2) % 3] == src.z) {
+                        ASSERT_FALSE(seen[s]);
+                        seen[s] = found = true;
+                    }
+                }
+            }
+            ASSERT_TRUE(found);
+        }
+    }
+    ASSERT_EQ(triangleCount, triangles.size());
+}
+
+TEST_F(MeshletsTest, Bounds) {
+    std::vector<float3> positions;
+    std::vector<uint3> triangles;
+    buildGrid(32, positions, triangles);
+
+    std::unique_ptr<Meshlets> meshlets(Meshlets::Builder()
+            .positions(positions.data())
+            .vertexCount(positions.size())
+            .triangles(triangles.data())
+            .triangleCount(triangles.size())
+            .coneWeight(0.5f)
+            .build());
+    ASSERT_NE(meshlets, nullptr);
+
+    for (size_t i = 0; i < meshlets->getMeshletCount(); ++i) {
+        const Meshlets::Meshlet& m = meshlets->getMeshlets()[i];
+        const Meshlets::Bounds& b = meshlets->getBounds()[i];
+        ASSERT_GT(b.radius, 0.0f);
+        // every vertex of the meshlet lies within the bounding sphere
+        for (size_t v = 0; v < m.vertexCount; ++v) {
+            const float3 p = positions[meshlets->getVertexIndices()[m.vertexOffset + v]];
+            ASSERT_LE(length(p - b.center), b.radius * 1.001f);
+        }
+        // the grid is planar with all normals +Z, so the cones must be degenerate and
+        // face-culling from behind the plane must succeed
+        ASSERT_NEAR(b.coneAxis.x, 0.0f, 0.01f);
+        ASSERT_NEAR(b.coneAxis.y, 0.0f, 0.01f);
+        ASSERT_NEAR(b.coneAxis.z, 1.0f, 0.01f);
+        const float3 viewPosition = { 16.0f, 16.0f, -100.0f };
+        ASSERT_GE(dot(normalize(b.center - viewPosition), b.coneAxis), b.coneCutoff);
+    }
+}
+
+TEST_F(MeshletsTest, Indices16) {
+    std::vector<float3> positions;
+    std::vector<uint3> triangles32;
+    buildGrid(4, positions, triangles32);
+    std::vector<filament::math::ushort3> triangles;
+    for (const uint3& t : triangles32) {
+        triangles.push_back({ uint16_t(t.x), uint16_t(t.y), uint16_t(t.z) });
+    }
+
+    std::unique_ptr<Meshlets> meshlets(Meshlets::Builder()
+            .positions(positions.data())
+            .vertexCount(positions.size())
+            .triangles(triangles.data())
+            .triangleCount(triangles.size())
+            .build());
+    ASSERT_NE(meshlets, nullptr);
+
+    size_t triangleCount = 0;
+    for (size_t i = 0; i < meshlets->getMeshletCount(); ++i) {
+        triangleCount += meshlets->getMeshlets()[i].triangleCount;
+    }
+    ASSERT_EQ(triangleCount, triangles.size());
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
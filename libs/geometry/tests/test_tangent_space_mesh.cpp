@@ -427,6 +427,92 @@ TEST_F(TangentSpaceMeshTest, Lengyel) {
     TangentSpaceMesh::destroy(mesh);
 }
 
+TEST_F(TangentSpaceMeshTest, IncrementalUpdateFrisvad) {
+    std::vector<float3> normals = TEST_NORMALS;
+    TangentSpaceMesh* mesh = TangentSpaceMesh::Builder()
+            .vertexCount(normals.size())
+            .normals(normals.data())
+            .algorithm(TangentSpaceMesh::Algorithm::FRISVAD)
+            .build();
+
+    std::vector<quatf> quats(mesh->getVertexCount());
+    mesh->getQuats(quats.data());
+
+    // Mutate two normals in place and refresh only those frames.
+    normals[1] = normalize(float3{1, 2, 3});
+    normals[4] = normalize(float3{-1, 0, 1});
+    std::vector<uint32_t> const dirty{1, 4};
+    mesh->updateQuats(dirty.data(), dirty.size(), quats.data());
+
+    // The updated frames should match a full rebuild, and untouched frames should be identical.
+    TangentSpaceMesh* fresh = TangentSpaceMesh::Builder()
+            .vertexCount(normals.size())
+            .normals(normals.data())
+            .algorithm(TangentSpaceMesh::Algorithm::FRISVAD)
+            .build();
+    std::vector<quatf> expected(fresh->getVertexCount());
+    fresh->getQuats(expected.data());
+
+    for (size_t i = 0; i < quats.size(); ++i) {
+        EXPECT_PRED2(isAlmostEqual4, quats[i].xyzw, expected[i].xyzw);
+    }
+
+    // The internal copy should be in sync with the caller's buffer.
+    std::vector<quatf> internal(mesh->getVertexCount());
+    mesh->getQuats(internal.data());
+    for (size_t i = 0; i < quats.size(); ++i) {
+        EXPECT_PRED2(isAlmostEqual4, internal[i].xyzw, quats[i].xyzw);
+    }
+
+    TangentSpaceMesh::destroy(fresh);
+    TangentSpaceMesh::destroy(mesh);
+}
+
+TEST_F(TangentSpaceMeshTest, IncrementalUpdateFlatShading) {
+    std::vector<float3> positions = CUBE_VERTS;
+    TangentSpaceMesh* mesh = TangentSpaceMesh::Builder()
+            .vertexCount(positions.size())
+            .positions(positions.data())
+            .triangleCount(CUBE_TRIANGLES.size())
+            .triangles(CUBE_TRIANGLES.data())
+            .build();
+    ASSERT_TRUE(mesh->remeshed());
+
+    std::vector<quatf> quats(mesh->getVertexCount());
+    mesh->getQuats(quats.data());
+
+    // Deform one corner of the cube; every triangle referencing it must be refreshed.
+    positions[7] = float3{1.5, 1.5, 1.5};
+    std::vector<uint32_t> const dirty{7};
+    mesh->updateQuats(dirty.data(), dirty.size(), quats.data());
+
+    TangentSpaceMesh* fresh = TangentSpaceMesh::Builder()
+            .vertexCount(positions.size())
+            .positions(positions.data())
+            .triangleCount(CUBE_TRIANGLES.size())
+            .triangles(CUBE_TRIANGLES.data())
+            .build();
+    std::vector<quatf> expected(fresh->getVertexCount());
+    fresh->getQuats(expected.data());
+
+    ASSERT_EQ(quats.size(), expected.size());
+    for (size_t i = 0; i < quats.size(); ++i) {
+        EXPECT_PRED2(isAlmostEqual4, quats[i].xyzw, expected[i].xyzw);
+    }
+
+    // The internal positions should track the deformation as well.
+    std::vector<float3> outPositions(mesh->getVertexCount());
+    mesh->getPositions(outPositions.data());
+    std::vector<float3> expectedPositions(fresh->getVertexCount());
+    fresh->getPositions(expectedPositions.data());
+    for (size_t i = 0; i < outPositions.size(); ++i) {
+        EXPECT_PRED2(isAlmostEqual3, outPositions[i], expectedPositions[i]);
+    }
+
+    TangentSpaceMesh::destroy(fresh);
+    TangentSpaceMesh::destroy(mesh);
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
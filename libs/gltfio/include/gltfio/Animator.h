@@ -82,6 +82,22 @@ public:
      */
     void resetBoneMatrices();
 
+    /**
+     * Resamples every animation channel into a uniform-rate track, quantizing rotations to
+     * SNORM16 quaternions. Baked channels skip the keyframe search and cubic-spline math in
+     * applyAnimation(); evaluation becomes a direct fetch plus lerp / slerp. STEP channels
+     * are left untouched so their exact switch times are preserved.
+     *
+     * Baking only reads source animation data and never touches engine state, so it can run
+     * in a background job (e.g. on a utils::JobSystem worker right after the asset loads) as
+     * long as it completes before the animator is first applied.
+     *
+     * @param sampleRateHz Resampling rate. Higher rates track the source splines more
+     *                     faithfully at a proportional memory cost; 30Hz is a good default
+     *                     for typical content.
+     */
+    void bakeAnimations(float sampleRateHz = 30.0f);
+
     /** Returns the number of \c animation definitions in the glTF asset. */
     size_t getAnimationCount() const;
 
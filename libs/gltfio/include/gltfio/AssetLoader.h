@@ -17,6 +17,8 @@
 #ifndef GLTFIO_ASSETLOADER_H
 #define GLTFIO_ASSETLOADER_H
 
+#include <backend/BufferDescriptor.h>
+
 #include <filament/Engine.h>
 #include <filament/Material.h>
 
@@ -24,6 +26,8 @@
 #include <gltfio/FilamentInstance.h>
 #include <gltfio/MaterialProvider.h>
 
+#include <math/vec3.h>
+
 #include <utils/compiler.h>
 
 namespace utils {
@@ -80,6 +84,13 @@ struct AssetConfiguration {
     //! Optional default node name for anonymous nodes
     char* defaultNodeName = nullptr;
 
+    //! Generates simplified shadow-proxy meshes for large renderables. For each non-skinned,
+    //! non-morphed renderable above an internal vertex-count threshold, ResourceLoader decimates
+    //! the geometry into a shadow-only proxy renderable (sharing the original vertex data) and
+    //! the detailed renderable stops casting shadows, greatly reducing shadow-pass vertex cost
+    //! for dense meshes. The proxy entities are part of getEntities().
+    bool generateShadowProxies = false;
+
     //! Optional to enable mikktspace tangents. Lifetime of struct only needs to be maintained for
     //  the duration of the constructor of AssetLoader.
     AssetConfigurationExtended* ext = nullptr;
@@ -177,6 +188,35 @@ public:
      */
     FilamentAsset* createAsset(const uint8_t* bytes, uint32_t nbytes);
 
+    /**
+     * Begins incremental creation of an asset with a single instance.
+     *
+     * Like createAsset(), but only the shared data (vertex buffers, index buffers and materials)
+     * is created before this returns; the entities, transforms and renderables are created by
+     * subsequent calls to pumpAsset(). This lets clients spread the cost of entity creation for
+     * a large scene over several frames instead of blocking for the whole scene.
+     *
+     * Only one incremental load can be in flight per AssetLoader, and no other asset or instance
+     * may be created with this loader until pumpAsset() has returned true. The asset's animator
+     * and skins become available only after the final pump.
+     */
+    FilamentAsset* createAssetIncremental(const uint8_t* bytes, uint32_t nbytes);
+
+    /**
+     * Creates roughly budgetUsec microseconds worth of pending entities for an asset returned by
+     * createAssetIncremental().
+     *
+     * Nodes are processed approximately front-to-back with respect to cameraPosition (in world
+     * space), so that geometry near the camera becomes renderable first; parents are always
+     * created before their children. At least one node is processed per call regardless of the
+     * budget, which guarantees forward progress.
+     *
+     * Returns true when the asset is complete, i.e. when no pending nodes remain. Calling this
+     * with an asset that is not being loaded incrementally logs an error and returns true.
+     */
+    bool pumpAsset(FilamentAsset* asset, uint64_t budgetUsec,
+            const filament::math::float3& cameraPosition);
+
     /**
      * Consumes the contents of a glTF 2.0 file and produces a primary asset with one or more
      * instances. The primary asset has ownership over the instances.
@@ -204,6 +244,17 @@ public:
     FilamentAsset* createInstancedAsset(const uint8_t* bytes, uint32_t numBytes,
             FilamentInstance** instances, size_t numInstances);
 
+    /**
+     * Like createAsset(), but borrows the glTF blob instead of copying it.
+     *
+     * This avoids duplicating the source data in memory, which matters for very large GLB files
+     * that the client has memory-mapped. Vertex and index data are uploaded directly from the
+     * given buffer; the descriptor's release callback is invoked only after every GPU upload
+     * that aliases the blob has completed and the asset's source data has been released, making
+     * it a safe place to unmap the file.
+     */
+    FilamentAsset* createSharedAsset(filament::backend::BufferDescriptor&& glb);
+
     /**
      * Adds a new instance to the asset.
      *
@@ -208,6 +208,11 @@ MaterialProvider* createJitShaderProvider(Engine* engine, bool optimizeShaders =
 /**
  * Creates a material provider that loads a small set of pre-built materials.
  *
+ * For version 1 archives, only the archive metadata is copied and each material package is
+ * decompressed out of the caller's buffer on first use, so the buffer must remain valid for
+ * the provider's lifetime. Archives are typically embedded arrays or memory-mapped files, so
+ * this is rarely a burden. Version 0 archives are copied and impose no lifetime requirement.
+ *
  * @return New material provider that can quickly load a material from a cache.
  *
  * @see createJitShaderProvider
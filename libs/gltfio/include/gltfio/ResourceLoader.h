@@ -49,6 +49,14 @@ struct ResourceConfiguration {
     //! If true, adjusts skinning weights to sum to 1. Well formed glTF files do not need this,
     //! but it is useful for robustness.
     bool normalizeSkinningWeights;
+
+    //! Optional path to an engine-native snapshot of the asset's cooked resources
+    //! (decompressed geometry, converted attributes, generated tangents, bind matrices).
+    //! When set, loadResources() restores buffers from the snapshot if it exists and still
+    //! matches the asset, skipping Draco / meshopt decompression and tangent generation;
+    //! otherwise it cooks normally and writes the snapshot on a background thread so that
+    //! subsequent loads are fast. The string pointer is not retained.
+    const char* snapshotPath = nullptr;
 };
 
 /**
@@ -76,6 +76,16 @@ public:
     enum class TextureFlags : uint64_t {
         NONE = 0,
         sRGB = 1 << 0,
+
+        // Hint that this texture should be decoded before textures pushed without the flag,
+        // e.g. because it is referenced by a material visible in the initial camera frustum.
+        // Providers are free to ignore the hint.
+        PRIORITY_HIGH = 1 << 1,
+
+        // Hint that this texture holds tangent-space normals, letting providers pick an
+        // internal format suited to two-channel data (e.g. EAC_RG11 or BC5 for basis-encoded
+        // sources). Providers are free to ignore the hint.
+        NORMAL_MAP = 1 << 2,
     };
 
     /**
@@ -28,13 +28,16 @@
 
 #include <utils/Log.h>
 
+#include <math/batch.h>
 #include <math/mat4.h>
+#include <math/norm.h>
 #include <math/quat.h>
 #include <math/scalar.h>
 #include <math/vec3.h>
 #include <math/vec4.h>
 
-#include <map>
+#include <algorithm>
+#include <cmath>
 #include <string>
 #include <vector>
 
@@ -45,20 +48,38 @@ using namespace utils;
 
 namespace filament::gltfio {
 
-using TimeValues = map<float, size_t>;
 using SourceValues = vector<float>;
 using BoneVector = vector<mat4f>;
 
 struct Sampler {
-    TimeValues times;
+    // Keyframe timestamps in ascending order. Kept contiguous alongside "values" (i.e. a
+    // structure-of-arrays layout per sampler) so that the hot lookup in applyAnimation is a
+    // cache-friendly binary search rather than a red-black tree traversal. The i-th timestamp
+    // corresponds to the i-th keyframe in "values".
+    SourceValues times;
     SourceValues values;
     enum { LINEAR, STEP, CUBIC } interpolation;
+
+    // Uniform-rate resampled copy of the track, see Animator::bakeAnimations(). Rotations
+    // are quantized to SNORM16 quaternions, everything else stays float. When bakedCount is
+    // non-zero, evaluation fetches the bracketing pair directly instead of searching "times"
+    // and evaluating splines.
+    vector<short4> bakedRotations;
+    SourceValues bakedValues;
+    float bakedStart = 0.0f;
+    float bakedRate = 0.0f;     // samples per second
+    size_t bakedCount = 0;      // 0 when this sampler hasn't been baked
 };
 
 struct Channel {
     const Sampler* sourceData;
     Entity targetEntity;
     enum { TRANSLATION, ROTATION, SCALE, WEIGHTS } transformType;
+
+    // Index of the keyframe pair that was used on the previous frame. Animation time usually
+    // advances by a fraction of a keyframe interval between frames, so the lookup starts here
+    // and only falls back to a binary search when the time jumped somewhere else.
+    mutable size_t cursor = 0;
 };
 
 struct Animation {
@@ -80,6 +101,7 @@ struct AnimatorImpl {
     FixedCapacityVector<mat4f> crossFade;
     void addChannels(const FixedCapacityVector<Entity>& nodeMap, const cgltf_animation& srcAnim,
             Animation& dst);
+    void bakeAnimations(float sampleRateHz);
     void applyAnimation(const Channel& channel, float t, size_t prevIndex, size_t nextIndex);
     void stashCrossFade();
     void applyCrossFade(float alpha);
@@ -100,9 +122,7 @@ static void createSampler(const cgltf_animation_sampler& src, Sampler& dst) {
         timelineFloats = (const float*) (timelineBlob + timelineAccessor->offset +
                 timelineAccessor->buffer_view->offset);
     }
-    for (size_t i = 0, len = timelineAccessor->count; i < len; ++i) {
-        dst.times[timelineFloats[i]] = i;
-    }
+    dst.times.assign(timelineFloats, timelineFloats + timelineAccessor->count);
 
     // Convert source data to float.
     const cgltf_accessor* valuesAccessor = src.output;
@@ -185,6 +205,83 @@ static bool validateAnimation(const cgltf_animation& anim) {
     return true;
 }
 
+// Locates the keyframe pair bracketing the given time and computes the interpolant. Used by
+// the bake step, which visits each track once in order, so a plain binary search is fine.
+static void findKeyframes(SourceValues const& times, float time, size_t& prevIndex,
+        size_t& nextIndex, float& t) {
+    t = 0.0f;
+    if (time <= times.front()) {
+        prevIndex = nextIndex = 0;
+        return;
+    }
+    if (time >= times.back()) {
+        prevIndex = nextIndex = times.size() - 1;
+        return;
+    }
+    prevIndex = std::upper_bound(times.begin(), times.end(), time) - times.begin() - 1;
+    nextIndex = prevIndex + 1;
+    const float deltaTime = times[nextIndex] - times[prevIndex];
+    if (deltaTime > 0) {
+        t = (time - times[prevIndex]) / deltaTime;
+    }
+}
+
+static float3 evaluateVec3(Sampler const& sampler, float time) {
+    size_t prevIndex, nextIndex;
+    float t;
+    findKeyframes(sampler.times, time, prevIndex, nextIndex, t);
+    const float3* srcVec3 = (const float3*) sampler.values.data();
+    if (sampler.interpolation == Sampler::CUBIC) {
+        float3 vert0 = srcVec3[prevIndex * 3 + 1];
+        float3 tang0 = srcVec3[prevIndex * 3 + 2];
+        float3 tang1 = srcVec3[nextIndex * 3];
+        float3 vert1 = srcVec3[nextIndex * 3 + 1];
+        return cubicSpline(vert0, tang0, vert1, tang1, t);
+    }
+    return mix(srcVec3[prevIndex], srcVec3[nextIndex], t);
+}
+
+static quatf evaluateRotation(Sampler const& sampler, float time) {
+    size_t prevIndex, nextIndex;
+    float t;
+    findKeyframes(sampler.times, time, prevIndex, nextIndex, t);
+    const quatf* srcQuat = (const quatf*) sampler.values.data();
+    if (sampler.interpolation == Sampler::CUBIC) {
+        quatf vert0 = srcQuat[prevIndex * 3 + 1];
+        quatf tang0 = srcQuat[prevIndex * 3 + 2];
+        quatf tang1 = srcQuat[nextIndex * 3];
+        quatf vert1 = srcQuat[nextIndex * 3 + 1];
+        return normalize(cubicSpline(vert0, tang0, vert1, tang1, t));
+    }
+    return slerp(srcQuat[prevIndex], srcQuat[nextIndex], t);
+}
+
+static void evaluateWeights(Sampler const& sampler, float time, float* out, size_t count) {
+    size_t prevIndex, nextIndex;
+    float t;
+    findKeyframes(sampler.times, time, prevIndex, nextIndex, t);
+    const float* const samplerValues = sampler.values.data();
+    const size_t valuesPerKeyframe = sampler.values.size() / sampler.times.size();
+    if (sampler.interpolation == Sampler::CUBIC) {
+        const float* const inTangents = samplerValues;
+        const float* const splineVerts = samplerValues + count;
+        const float* const outTangents = samplerValues + count * 2;
+        for (size_t comp = 0; comp < count; ++comp) {
+            float vert0 = splineVerts[comp + prevIndex * valuesPerKeyframe];
+            float tang0 = outTangents[comp + prevIndex * valuesPerKeyframe];
+            float tang1 = inTangents[comp + nextIndex * valuesPerKeyframe];
+            float vert1 = splineVerts[comp + nextIndex * valuesPerKeyframe];
+            out[comp] = cubicSpline(vert0, tang0, vert1, tang1, t);
+        }
+    } else {
+        for (size_t comp = 0; comp < count; ++comp) {
+            float previous = samplerValues[comp + prevIndex * valuesPerKeyframe];
+            float current = samplerValues[comp + nextIndex * valuesPerKeyframe];
+            out[comp] = (1 - t) * previous + t * current;
+        }
+    }
+}
+
 Animator::Animator(FFilamentAsset const* asset, FFilamentInstance* instance) {
     assert(asset->mResourcesLoaded && asset->mSourceAsset);
     mImpl = new AnimatorImpl();
@@ -222,7 +319,7 @@ Animator::Animator(FFilamentAsset const* asset, FFilamentInstance* instance) {
             Sampler& dstSampler = dstAnim.samplers[j];
             createSampler(srcSampler, dstSampler);
             if (dstSampler.times.size() > 1) {
-                float maxtime = (--dstSampler.times.end())->first;
+                float maxtime = dstSampler.times.back();
                 dstAnim.duration = std::max(dstAnim.duration, maxtime);
             }
         }
@@ -238,6 +335,81 @@ Animator::Animator(FFilamentAsset const* asset, FFilamentInstance* instance) {
     }
 }
 
+void Animator::bakeAnimations(float sampleRateHz) {
+    mImpl->bakeAnimations(sampleRateHz);
+}
+
+void AnimatorImpl::bakeAnimations(float sampleRateHz) {
+    for (Animation& anim : animations) {
+        // The transform type lives on the channel, not the sampler, so drive the bake from
+        // the channels; a sampler referenced by several channels is baked once.
+        for (const Channel& channel : anim.channels) {
+            Sampler& sampler = anim.samplers[channel.sourceData - anim.samplers.data()];
+            if (sampler.bakedCount || sampler.times.size() < 2) {
+                continue;
+            }
+            // STEP tracks are already a cheap fetch, and resampling would move their exact
+            // switch times onto the uniform grid.
+            if (sampler.interpolation == Sampler::STEP) {
+                continue;
+            }
+
+            const float start = sampler.times.front();
+            const float duration = sampler.times.back() - start;
+            if (duration <= 0) {
+                continue;
+            }
+            // Choose a step so that the last sample lands exactly on the track's end.
+            const size_t count = std::max(size_t(std::ceil(duration * sampleRateHz)), size_t(1)) + 1;
+            const float step = duration / float(count - 1);
+
+            switch (channel.transformType) {
+                case Channel::ROTATION: {
+                    sampler.bakedRotations.reserve(count);
+                    quatf previous;
+                    for (size_t i = 0; i < count; ++i) {
+                        quatf q = evaluateRotation(sampler, start + float(i) * step);
+                        // keep consecutive samples in the same hemisphere so that the
+                        // runtime slerp always takes the short path
+                        if (i > 0 && dot(q.xyzw, previous.xyzw) < 0) {
+                            q = -q;
+                        }
+                        previous = q;
+                        sampler.bakedRotations.push_back(packSnorm16(q.xyzw));
+                    }
+                    break;
+                }
+                case Channel::TRANSLATION:
+                case Channel::SCALE: {
+                    sampler.bakedValues.reserve(count * 3);
+                    for (size_t i = 0; i < count; ++i) {
+                        const float3 v = evaluateVec3(sampler, start + float(i) * step);
+                        sampler.bakedValues.push_back(v.x);
+                        sampler.bakedValues.push_back(v.y);
+                        sampler.bakedValues.push_back(v.z);
+                    }
+                    break;
+                }
+                case Channel::WEIGHTS: {
+                    size_t components = sampler.values.size() / sampler.times.size();
+                    if (sampler.interpolation == Sampler::CUBIC) {
+                        components /= 3;
+                    }
+                    sampler.bakedValues.resize(components * count);
+                    for (size_t i = 0; i < count; ++i) {
+                        evaluateWeights(sampler, start + float(i) * step,
+                                &sampler.bakedValues[i * components], components);
+                    }
+                    break;
+                }
+            }
+            sampler.bakedStart = start;
+            sampler.bakedRate = float(count - 1) / duration;
+            sampler.bakedCount = count;
+        }
+    }
+}
+
 void Animator::applyCrossFade(size_t previousAnimIndex, float previousAnimTime, float alpha) {
     mImpl->stashCrossFade();
     applyAnimation(previousAnimIndex, previousAnimTime);
@@ -273,28 +445,48 @@ void Animator::applyAnimation(size_t animationIndex, float time) const {
             continue;
         }
 
-        const TimeValues& times = sampler->times;
+        // Baked tracks are uniform-rate, so the bracketing sample pair is a direct
+        // computation; no search and no spline evaluation.
+        if (sampler->bakedCount > 0) {
+            const float position = math::clamp((time - sampler->bakedStart) * sampler->bakedRate,
+                    0.0f, float(sampler->bakedCount - 1));
+            const size_t prev = std::min(size_t(position), sampler->bakedCount - 2);
+            mImpl->applyAnimation(channel, position - float(prev), prev, prev + 1);
+            continue;
+        }
 
-        // Find the first keyframe after the given time, or the keyframe that matches it exactly.
-        TimeValues::const_iterator iter = times.lower_bound(time);
+        const SourceValues& times = sampler->times;
 
-        // Compute the interpolant (between 0 and 1) and determine the keyframe pair.
+        // Determine the keyframe pair bracketing the given time and compute the interpolant
+        // (between 0 and 1). The search starts at the cursor cached on the previous frame and
+        // falls back to a binary search when the time jumped somewhere else.
         float t = 0.0f;
         size_t nextIndex;
         size_t prevIndex;
-        if (iter == times.end()) {
-            nextIndex = times.size() - 1;
-            prevIndex = nextIndex;
-        } else if (iter == times.begin()) {
+        if (time <= times.front()) {
             nextIndex = 0;
             prevIndex = 0;
+        } else if (time >= times.back()) {
+            nextIndex = times.size() - 1;
+            prevIndex = nextIndex;
         } else {
-            TimeValues::const_iterator prev = iter; --prev;
-            nextIndex = iter->second;
-            prevIndex = prev->second;
-            const float nextTime = iter->first;
-            const float prevTime = prev->first;
-            float deltaTime = nextTime - prevTime;
+            size_t cursor = channel.cursor;
+            auto brackets = [&times, time](size_t i) {
+                return times[i] <= time && time < times[i + 1];
+            };
+            if (cursor + 1 >= times.size() || !brackets(cursor)) {
+                if (cursor + 2 < times.size() && brackets(cursor + 1)) {
+                    ++cursor;
+                } else {
+                    cursor = std::upper_bound(times.begin(), times.end(), time)
+                            - times.begin() - 1;
+                }
+            }
+            channel.cursor = cursor;
+            prevIndex = cursor;
+            nextIndex = cursor + 1;
+            const float prevTime = times[prevIndex];
+            float deltaTime = times[nextIndex] - prevTime;
             assert(deltaTime >= 0);
             if (deltaTime > 0) {
                 t = (time - prevTime) / deltaTime;
@@ -434,7 +626,7 @@ void AnimatorImpl::addChannels(const FixedCapacityVector<Entity>& nodeMap,
 void AnimatorImpl::applyAnimation(const Channel& channel, float t, size_t prevIndex,
         size_t nextIndex) {
     const Sampler* sampler = channel.sourceData;
-    const TimeValues& times = sampler->times;
+    const SourceValues& times = sampler->times;
     TrsTransformManager::Instance trsNode = trsTransformManager->getInstance(channel.targetEntity);
     TransformManager::Instance node = transformManager->getInstance(channel.targetEntity);
 
@@ -442,6 +634,12 @@ void AnimatorImpl::applyAnimation(const Channel& channel, float t, size_t prevIn
 
         case Channel::SCALE: {
             float3 scale;
+            if (sampler->bakedCount) {
+                const float3* baked = (const float3*) sampler->bakedValues.data();
+                scale = mix(baked[prevIndex], baked[nextIndex], t);
+                trsTransformManager->setScale(trsNode, scale);
+                break;
+            }
             const float3* srcVec3 = (const float3*) sampler->values.data();
             if (sampler->interpolation == Sampler::CUBIC) {
                 float3 vert0 = srcVec3[prevIndex * 3 + 1];
@@ -450,7 +648,7 @@ void AnimatorImpl::applyAnimation(const Channel& channel, float t, size_t prevIn
                 float3 vert1 = srcVec3[nextIndex * 3 + 1];
                 scale = cubicSpline(vert0, tang0, vert1, tang1, t);
             } else {
-                scale = ((1 - t) * srcVec3[prevIndex]) + (t * srcVec3[nextIndex]);
+                scale = mix(srcVec3[prevIndex], srcVec3[nextIndex], t);
             }
             trsTransformManager->setScale(trsNode, scale);
             break;
@@ -458,6 +656,12 @@ void AnimatorImpl::applyAnimation(const Channel& channel, float t, size_t prevIn
 
         case Channel::TRANSLATION: {
             float3 translation;
+            if (sampler->bakedCount) {
+                const float3* baked = (const float3*) sampler->bakedValues.data();
+                translation = mix(baked[prevIndex], baked[nextIndex], t);
+                trsTransformManager->setTranslation(trsNode, translation);
+                break;
+            }
             const float3* srcVec3 = (const float3*) sampler->values.data();
             if (sampler->interpolation == Sampler::CUBIC) {
                 float3 vert0 = srcVec3[prevIndex * 3 + 1];
@@ -466,7 +670,7 @@ void AnimatorImpl::applyAnimation(const Channel& channel, float t, size_t prevIn
                 float3 vert1 = srcVec3[nextIndex * 3 + 1];
                 translation = cubicSpline(vert0, tang0, vert1, tang1, t);
             } else {
-                translation = ((1 - t) * srcVec3[prevIndex]) + (t * srcVec3[nextIndex]);
+                translation = mix(srcVec3[prevIndex], srcVec3[nextIndex], t);
             }
             trsTransformManager->setTranslation(trsNode, translation);
             break;
@@ -474,6 +678,14 @@ void AnimatorImpl::applyAnimation(const Channel& channel, float t, size_t prevIn
 
         case Channel::ROTATION: {
             quatf rotation;
+            if (sampler->bakedCount) {
+                const float4 q0 = unpackSnorm16(sampler->bakedRotations[prevIndex]);
+                const float4 q1 = unpackSnorm16(sampler->bakedRotations[nextIndex]);
+                rotation = normalize(slerp(
+                        quatf(q0.w, q0.x, q0.y, q0.z), quatf(q1.w, q1.x, q1.y, q1.z), t));
+                trsTransformManager->setRotation(trsNode, rotation);
+                break;
+            }
             const quatf* srcQuat = (const quatf*) sampler->values.data();
             if (sampler->interpolation == Sampler::CUBIC) {
                 quatf vert0 = srcQuat[prevIndex * 3 + 1];
@@ -489,6 +701,16 @@ void AnimatorImpl::applyAnimation(const Channel& channel, float t, size_t prevIn
         }
 
         case Channel::WEIGHTS: {
+            if (sampler->bakedCount) {
+                const size_t components = sampler->bakedValues.size() / sampler->bakedCount;
+                const float* const baked = sampler->bakedValues.data();
+                weights.resize(components);
+                batch::mix(baked + prevIndex * components, baked + nextIndex * components,
+                        t, weights.data(), components);
+                auto ci = renderableManager->getInstance(channel.targetEntity);
+                renderableManager->setMorphWeights(ci, weights.data(), weights.size());
+                return;
+            }
             const float* const samplerValues = sampler->values.data();
             assert(sampler->values.size() % times.size() == 0);
             const int valuesPerKeyframe = sampler->values.size() / times.size();
@@ -32,6 +32,9 @@
 
 #include <zstd.h>
 
+#include <algorithm>
+#include <memory>
+
 #include <stdint.h>
 #include <stddef.h>
 #include <string.h>
@@ -58,19 +61,150 @@ static bool strIsEqual(const CString& a, const char* b) {
     return strncmp(a.c_str(), b, a.size()) == 0;
 }
 
+// Decompresses the byte range [rangeBegin, rangeBegin + rangeSize) of a zstd frame into dst.
+// Frames decompress sequentially, so preceding bytes are produced into a scratch window and
+// discarded; this is still much cheaper than keeping every package resident for the lifetime
+// of the cache.
+static bool decompressRange(const void* src, size_t srcSize,
+        uint64_t rangeBegin, uint64_t rangeSize, uint8_t* dst) {
+    ZSTD_DCtx* const dctx = ZSTD_createDCtx();
+    if (dctx == nullptr) {
+        return false;
+    }
+    constexpr size_t SCRATCH_SIZE = 256 * 1024;
+    auto scratch = std::make_unique<uint8_t[]>(SCRATCH_SIZE);
+    ZSTD_inBuffer input = { src, srcSize, 0 };
+    uint64_t const rangeEnd = rangeBegin + rangeSize;
+    uint64_t decompressedSoFar = 0;
+    bool success = false;
+    while (decompressedSoFar < rangeEnd) {
+        ZSTD_outBuffer output = { scratch.get(), SCRATCH_SIZE, 0 };
+        size_t const ret = ZSTD_decompressStream(dctx, &output, &input);
+        if (ZSTD_isError(ret)) {
+            break;
+        }
+        uint64_t const chunkBegin = decompressedSoFar;
+        uint64_t const chunkEnd = chunkBegin + output.pos;
+        uint64_t const copyBegin = std::max(chunkBegin, rangeBegin);
+        uint64_t const copyEnd = std::min(chunkEnd, rangeEnd);
+        if (copyBegin < copyEnd) {
+            memcpy(dst + (copyBegin - rangeBegin),
+                    scratch.get() + (copyBegin - chunkBegin), copyEnd - copyBegin);
+        }
+        decompressedSoFar = chunkEnd;
+        if (decompressedSoFar >= rangeEnd) {
+            success = true;
+            break;
+        }
+        if (ret == 0 || (output.pos == 0 && input.pos == input.size)) {
+            // the frame ended before covering the requested range
+            break;
+        }
+    }
+    ZSTD_freeDCtx(dctx);
+    return success;
+}
+
 void ArchiveCache::load(const void* archiveData, uint64_t archiveByteCount) {
     assert_invariant(mArchive == nullptr && "Do not call load() twice");
+
+    // Version 1 archives start with uncompressed metadata, so the magic word is readable
+    // directly; version 0 archives are a single zstd frame and thus start with the zstd magic.
+    if (archiveByteCount >= sizeof(ReadableArchive) &&
+            ((ReadableArchive const*) archiveData)->magic == 'UBER') {
+        auto const* source = (uint8_t const*) archiveData;
+        auto const* header = (ReadableArchive const*) archiveData;
+        auto const* specs = (ArchiveSpec const*) (source + header->specsOffset);
+        mPackageOffsets = FixedCapacityVector<uint64_t>(header->specsCount);
+        uint64_t metadataSize = archiveByteCount;
+        for (uint64_t i = 0; i < header->specsCount; ++i) {
+            mPackageOffsets[i] = specs[i].packageOffset;
+            metadataSize = std::min(metadataSize, specs[i].packageOffset);
+        }
+
+        // Only the metadata is copied; the packages are decompressed straight out of the
+        // caller's buffer on first use, so it must outlive the cache (it is typically an
+        // embedded array or a memory-mapped file).
+        mSourceArchive = source;
+        mSourceArchiveSize = archiveByteCount;
+        mArchive = (ReadableArchive*) utils::aligned_alloc(metadataSize, 8);
+        memcpy(mArchive, archiveData, metadataSize);
+
+        convertOffsetsToPointers(mArchive);
+        for (uint64_t i = 0; i < mArchive->specsCount; ++i) {
+            // the conversion aimed the package pointers past the truncated metadata buffer
+            mArchive->specs[i].package = nullptr;
+        }
+
+        mMaterials = FixedCapacityVector<Material*>(mArchive->specsCount, nullptr);
+        return;
+    }
+
     const uint64_t decompSize = ZSTD_getFrameContentSize(archiveData, archiveByteCount);
     if (decompSize == ZSTD_CONTENTSIZE_UNKNOWN || decompSize == ZSTD_CONTENTSIZE_ERROR) {
         PANIC_POSTCONDITION("Decompression error.");
     }
+
+    // Keep the compressed archive around; packages are extracted from it on demand when a spec
+    // is first materialized, see materializeMaterial().
+    mCompressedArchive = FixedCapacityVector<uint8_t>(archiveByteCount);
+    memcpy(mCompressedArchive.data(), archiveData, archiveByteCount);
+
+    // Decompress the whole frame once in order to read the metadata, but retain only the
+    // metadata prefix: the packages are serialized last and dominate the decompressed size,
+    // and typical sessions materialize only a few of them.
     uint64_t* basePointer = (uint64_t*) utils::aligned_alloc(decompSize, 8);
     ZSTD_decompress(basePointer, decompSize, archiveData, archiveByteCount);
-    mArchive = (ReadableArchive*) basePointer;
+
+    auto const* fullArchive = (ReadableArchive const*) basePointer;
+    auto const* specs = (ArchiveSpec const*) ((uint8_t const*) basePointer + fullArchive->specsOffset);
+    mPackageOffsets = FixedCapacityVector<uint64_t>(fullArchive->specsCount);
+    uint64_t metadataSize = decompSize;
+    for (uint64_t i = 0; i < fullArchive->specsCount; ++i) {
+        mPackageOffsets[i] = specs[i].packageOffset;
+        metadataSize = std::min(metadataSize, specs[i].packageOffset);
+    }
+
+    mArchive = (ReadableArchive*) utils::aligned_alloc(metadataSize, 8);
+    memcpy(mArchive, basePointer, metadataSize);
+    utils::aligned_free(basePointer);
+
     convertOffsetsToPointers(mArchive);
+    for (uint64_t i = 0; i < mArchive->specsCount; ++i) {
+        // the conversion aimed the package pointers past the truncated metadata buffer
+        mArchive->specs[i].package = nullptr;
+    }
+
     mMaterials = FixedCapacityVector<Material*>(mArchive->specsCount, nullptr);
 }
 
+Material* ArchiveCache::materializeMaterial(size_t specIndex) {
+    ArchiveSpec const& spec = mArchive->specs[specIndex];
+    FixedCapacityVector<uint8_t> package(spec.packageByteCount);
+    if (mSourceArchive) {
+        // Version 1: each package is its own zstd frame at a known offset. ZSTD_decompress
+        // consumes every frame in its source range, so clamp it to this package's frame.
+        uint64_t const offset = mPackageOffsets[specIndex];
+        size_t const frameSize = ZSTD_findFrameCompressedSize(
+                mSourceArchive + offset, mSourceArchiveSize - offset);
+        if (ZSTD_isError(frameSize)) {
+            PANIC_POSTCONDITION("Decompression error.");
+        }
+        size_t const result = ZSTD_decompress(package.data(), package.size(),
+                mSourceArchive + offset, frameSize);
+        if (ZSTD_isError(result) || result != spec.packageByteCount) {
+            PANIC_POSTCONDITION("Decompression error.");
+        }
+    } else if (!decompressRange(mCompressedArchive.data(), mCompressedArchive.size(),
+            mPackageOffsets[specIndex], spec.packageByteCount, package.data())) {
+        PANIC_POSTCONDITION("Decompression error.");
+    }
+    // Material::Builder copies the package during build(), so the buffer can be transient.
+    return Material::Builder()
+        .package(package.data(), package.size())
+        .build(mEngine);
+}
+
 // This loops though all ubershaders and returns the first one that meets the given requirements.
 Material* ArchiveCache::getMaterial(const ArchiveRequirements& reqs) {
     assert_invariant(mArchive && "Please call load() before requesting any materials.");
@@ -132,9 +266,7 @@ Material* ArchiveCache::getMaterial(const ArchiveRequirements& reqs) {
 
         if (specIsSuitable) {
             if (mMaterials[i] == nullptr) {
-                mMaterials[i] = Material::Builder()
-                    .package(spec.package, spec.packageByteCount)
-                    .build(mEngine);
+                mMaterials[i] = materializeMaterial(i);
             }
 
             return mMaterials[i];
@@ -148,9 +280,7 @@ Material* ArchiveCache::getDefaultMaterial() {
     assert_invariant(!mMaterials.empty() && "Archive must have at least one material.");
     if (!mArchive) return nullptr;
     if (mMaterials[0] == nullptr) {
-        mMaterials[0] = Material::Builder()
-            .package(mArchive->specs[0].package, mArchive->specs[0].packageByteCount)
-            .build(mEngine);
+        mMaterials[0] = materializeMaterial(0);
     }
     return mMaterials[0];
 }
@@ -50,9 +50,22 @@ namespace filament::gltfio {
         FeatureMap getFeatureMap(Material* material) const;
 
     private:
+        Material* materializeMaterial(size_t specIndex);
+
         Engine& mEngine;
         utils::FixedCapacityVector<Material*> mMaterials;
+
+        // Only the archive metadata (specs, flags, flag names) stays decompressed; packages are
+        // pulled out of the compressed archive on demand when a spec is first materialized.
         uberz::ReadableArchive* mArchive = nullptr;
+        utils::FixedCapacityVector<uint8_t> mCompressedArchive;
+        utils::FixedCapacityVector<uint64_t> mPackageOffsets;
+
+        // Version 1 archives are borrowed rather than copied: the caller's buffer (typically an
+        // embedded array or a memory-mapped file) must stay valid for the cache's lifetime, and
+        // each package is an independent zstd frame addressed by mPackageOffsets.
+        const uint8_t* mSourceArchive = nullptr;
+        uint64_t mSourceArchiveSize = 0;
     };
 
     struct ArchiveRequirements {
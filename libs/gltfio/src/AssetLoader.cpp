@@ -58,9 +58,11 @@
 
 #include "downcast.h"
 
+#include <chrono>
 #include <codecvt>
 #include <locale>
 #include <memory>
+#include <vector>
 
 using namespace filament;
 using namespace filament::math;
@@ -90,6 +92,20 @@ static constexpr cgltf_material kDefaultMat = {
     },
 };
 
+static mat4f getLocalMatrix(cgltf_node const* node) {
+    mat4f localTransform;
+    if (node->has_matrix) {
+        memcpy(&localTransform[0][0], &node->matrix[0], 16 * sizeof(float));
+    } else {
+        const float3* translation = (const float3*) &node->translation[0];
+        const quatf* rotation = (const quatf*) &node->rotation[0];
+        const float3* scale = (const float3*) &node->scale[0];
+        localTransform = mat4f::translation(*translation) * mat4f(*rotation) *
+                mat4f::scaling(*scale);
+    }
+    return localTransform;
+}
+
 static std::string getNodeName(cgltf_node const* node, char const* defaultNodeName) {
     auto const getNameImpl = [node, defaultNodeName]() -> char const* {
         if (node->name) return node->name;
@@ -260,7 +276,8 @@ struct FAssetLoader : public AssetLoader {
             mTransformManager(config.engine->getTransformManager()),
             mMaterials(*config.materials),
             mEngine(*config.engine),
-            mDefaultNodeName(config.defaultNodeName) {
+            mDefaultNodeName(config.defaultNodeName),
+            mGenerateShadowProxies(config.generateShadowProxies) {
         if (config.ext) {
             FILAMENT_CHECK_PRECONDITION(AssetConfigurationExtended::isSupported())
                     << "Extend asset loading is not supported on this platform";
@@ -272,6 +289,9 @@ struct FAssetLoader : public AssetLoader {
     FFilamentAsset* createAsset(const uint8_t* bytes, uint32_t nbytes);
     FFilamentAsset* createInstancedAsset(const uint8_t* bytes, uint32_t numBytes,
             FilamentInstance** instances, size_t numInstances);
+    FFilamentAsset* createSharedAsset(backend::BufferDescriptor&& glb);
+    FFilamentAsset* createAssetIncremental(const uint8_t* bytes, uint32_t nbytes);
+    bool pumpAsset(FFilamentAsset* fAsset, uint64_t budgetUsec, float3 cameraPosition);
     FilamentInstance* createInstance(FFilamentAsset* fAsset);
 
     static void destroy(FAssetLoader** loader) noexcept {
@@ -300,7 +320,8 @@ struct FAssetLoader : public AssetLoader {
     }
 
 private:
-    void importSkins(FFilamentInstance* instance, const cgltf_data* srcAsset);
+    void importSkins(FFilamentAsset* fAsset, FFilamentInstance* instance,
+            const cgltf_data* srcAsset);
 
     // Methods used during the first traveral (creation of VertexBuffer, IndexBuffer, etc)
     FFilamentAsset* createRootAsset(const cgltf_data* srcAsset);
@@ -313,6 +334,9 @@ private:
     void createInstances(size_t numInstances, FFilamentAsset* fAsset);
     void recurseEntities(const cgltf_node* node, SceneMask scenes, Entity parent,
             FFilamentAsset* fAsset, FFilamentInstance* instance);
+    Entity createEntity(const cgltf_node* node, SceneMask scenes, Entity parent,
+            FFilamentAsset* fAsset, FFilamentInstance* instance);
+    void finalizeIncrementalAsset();
     void createRenderable(const cgltf_node* node, Entity entity, const char* name,
             FFilamentAsset* fAsset);
     void createLight(const cgltf_light* light, Entity entity, FFilamentAsset* fAsset);
@@ -344,13 +368,33 @@ public:
 
     // Transient state used only for the asset currently being loaded:
     const char* mDefaultNodeName;
+    const bool mGenerateShadowProxies;
     bool mError = false;
     bool mDiagnosticsEnabled = false;
     MaterialInstanceCache mMaterialInstanceCache;
 
+    // Batch-created entities for the instance being created; createEntity() consumes them
+    // instead of taking the entity manager's lock once per node.
+    std::vector<Entity> mEntityPool;
+    size_t mEntityPoolIndex = 0;
+
     // Weak reference to the largest dummy buffer so far in the current loading phase.
     BufferObject* mDummyBufferObject = nullptr;
 
+    // Pending per-node work for an asset created with createAssetIncremental(). Like the
+    // material instance cache, this is transient state, so only one incremental load can be
+    // in flight at a time. The world transform is an approximation used solely for
+    // front-to-back ordering in pumpAsset().
+    struct PendingNode {
+        const cgltf_node* node;
+        SceneMask scenes;
+        Entity parent;
+        mat4f worldTransform;
+    };
+    std::vector<PendingNode> mPendingNodes;
+    FFilamentAsset* mIncrementalAsset = nullptr;
+    FFilamentInstance* mIncrementalInstance = nullptr;
+
 public:
     std::unique_ptr<AssetLoaderExtended> mLoaderExtended;
 };
@@ -417,6 +461,44 @@ FFilamentAsset* FAssetLoader::createInstancedAsset(const uint8_t* bytes, uint32_
     return fAsset;
 }
 
+FFilamentAsset* FAssetLoader::createSharedAsset(backend::BufferDescriptor&& glb) {
+    cgltf_options options {};
+
+    if constexpr (!GLTFIO_USE_FILESYSTEM) {
+        // See createInstancedAsset for an explanation of this custom release callback.
+        options.file.release = [](const cgltf_memory_options*, const cgltf_file_options*, void*) {};
+    }
+
+    // Unlike createInstancedAsset, the source blob is not copied; cgltf's pointers reference
+    // the caller's buffer directly, and the descriptor is stashed in the source asset so the
+    // buffer stays valid (and uploads remain zero-copy) until the last reference goes away.
+    cgltf_data* sourceAsset;
+    cgltf_result result = cgltf_parse(&options, glb.buffer, glb.size, &sourceAsset);
+    if (result != cgltf_result_success) {
+        slog.e << "Unable to parse glTF file." << io::endl;
+        return nullptr;
+    }
+
+    FFilamentAsset* fAsset = createRootAsset(sourceAsset);
+    if (mError) {
+        delete fAsset;
+        mError = false;
+        return nullptr;
+    }
+    fAsset->mSourceAsset->externalData = std::move(glb);
+
+    createInstances(1, fAsset);
+    if (mError) {
+        delete fAsset;
+        mError = false;
+        return nullptr;
+    }
+
+    return fAsset;
+}
+
+static size_t countNodes(const cgltf_node* node) noexcept;
+
 FilamentInstance* FAssetLoader::createInstance(FFilamentAsset* fAsset) {
     if (!fAsset->mSourceAsset) {
         slog.e << "Source data has been released; asset is frozen." << io::endl;
@@ -445,12 +527,29 @@ FilamentInstance* FAssetLoader::createInstance(FFilamentAsset* fAsset) {
         instance->mVariants.push_back({ CString(srcAsset->variants[i].name) });
     }
 
+    // Batch-create the entities for the whole hierarchy with a single EntityManager call,
+    // which takes its lock once instead of once per node. The node count is computed on the
+    // first instantiation and reused afterwards.
+    if (UTILS_UNLIKELY(fAsset->mInstanceEntityCount == 0)) {
+        size_t count = 0;
+        for (const auto& pair : fAsset->mRootNodes) {
+            count += countNodes(pair.first);
+        }
+        fAsset->mInstanceEntityCount = count;
+    }
+    mEntityPool.resize(fAsset->mInstanceEntityCount);
+    mEntityPoolIndex = 0;
+    mEntityManager.create(mEntityPool.size(), mEntityPool.data());
+    instance->mEntities.reserve(fAsset->mInstanceEntityCount);
+
     // For each scene root, recursively create all entities.
     for (const auto& pair : fAsset->mRootNodes) {
         recurseEntities(pair.first, pair.second, instanceRoot, fAsset, instance);
     }
+    assert_invariant(mEntityPoolIndex == mEntityPool.size());
+    mEntityPool.clear();
 
-    importSkins(instance, srcAsset);
+    importSkins(fAsset, instance, srcAsset);
 
     // Now that all entities have been created, the instance can create the animator component.
     // Note that it may need to defer actual creation until external buffers are fully loaded.
@@ -470,6 +569,138 @@ FilamentInstance* FAssetLoader::createInstance(FFilamentAsset* fAsset) {
     return instance;
 }
 
+FFilamentAsset* FAssetLoader::createAssetIncremental(const uint8_t* bytes, uint32_t byteCount) {
+    if (mIncrementalAsset) {
+        slog.e << "An incremental asset is already being loaded." << io::endl;
+        return nullptr;
+    }
+
+    // See createInstancedAsset for an explanation of the parsing and copying performed here.
+    cgltf_options options {};
+    if constexpr (!GLTFIO_USE_FILESYSTEM) {
+        options.file.release = [](const cgltf_memory_options*, const cgltf_file_options*, void*) {};
+    }
+
+    utils::FixedCapacityVector<uint8_t> glbdata(byteCount);
+    std::copy_n(bytes, byteCount, glbdata.data());
+
+    cgltf_data* sourceAsset;
+    cgltf_result result = cgltf_parse(&options, glbdata.data(), byteCount, &sourceAsset);
+    if (result != cgltf_result_success) {
+        slog.e << "Unable to parse glTF file." << io::endl;
+        return nullptr;
+    }
+
+    FFilamentAsset* fAsset = createRootAsset(sourceAsset);
+    if (mError) {
+        delete fAsset;
+        mError = false;
+        return nullptr;
+    }
+    glbdata.swap(fAsset->mSourceAsset->glbData);
+
+    const cgltf_data* srcAsset = fAsset->mSourceAsset->hierarchy;
+    if (srcAsset->scenes == nullptr) {
+        slog.e << "There is no scene in the asset." << io::endl;
+        delete fAsset;
+        return nullptr;
+    }
+
+    auto rootTransform = mTransformManager.getInstance(fAsset->mRoot);
+    Entity instanceRoot = mEntityManager.create();
+    mTransformManager.create(instanceRoot, rootTransform);
+
+    mMaterialInstanceCache = MaterialInstanceCache(srcAsset);
+
+    FFilamentInstance* instance = new FFilamentInstance(instanceRoot, fAsset);
+
+    instance->mVariants.reserve(srcAsset->variants_count);
+    for (cgltf_size i = 0, len = srcAsset->variants_count; i < len; ++i) {
+        instance->mVariants.push_back({ CString(srcAsset->variants[i].name) });
+    }
+
+    // Instead of recursing through the hierarchy, record each scene root; the per-node
+    // entities are created by subsequent calls to pumpAsset().
+    for (const auto& pair : fAsset->mRootNodes) {
+        mPendingNodes.push_back({ pair.first, pair.second, instanceRoot,
+                getLocalMatrix(pair.first) });
+    }
+
+    fAsset->mInstances.push_back(instance);
+    instance->mBoundingBox = fAsset->mBoundingBox;
+
+    mIncrementalAsset = fAsset;
+    mIncrementalInstance = instance;
+    return fAsset;
+}
+
+bool FAssetLoader::pumpAsset(FFilamentAsset* fAsset, uint64_t budgetUsec, float3 cameraPosition) {
+    if (fAsset != mIncrementalAsset) {
+        slog.e << "pumpAsset called with an asset that is not being loaded incrementally."
+                << io::endl;
+        return true;
+    }
+
+    using clock = std::chrono::steady_clock;
+    const clock::time_point deadline = clock::now() + std::chrono::microseconds(budgetUsec);
+
+    // Process nodes approximately front-to-back from the given camera position. Children
+    // discovered during this pump are appended at the back and sorted on the next call, which
+    // keeps parents ahead of their children without re-sorting after every node.
+    std::sort(mPendingNodes.begin(), mPendingNodes.end(),
+            [cameraPosition](const PendingNode& a, const PendingNode& b) {
+                return distance2(a.worldTransform[3].xyz, cameraPosition) <
+                        distance2(b.worldTransform[3].xyz, cameraPosition);
+            });
+
+    size_t processed = 0;
+    while (processed < mPendingNodes.size()) {
+        const PendingNode pending = mPendingNodes[processed++];
+        const Entity entity = createEntity(pending.node, pending.scenes, pending.parent,
+                fAsset, mIncrementalInstance);
+        for (cgltf_size i = 0, len = pending.node->children_count; i < len; ++i) {
+            const cgltf_node* child = pending.node->children[i];
+            mPendingNodes.push_back({ child, pending.scenes, entity,
+                    pending.worldTransform * getLocalMatrix(child) });
+        }
+        if (clock::now() >= deadline) {
+            break;
+        }
+    }
+    mPendingNodes.erase(mPendingNodes.begin(), mPendingNodes.begin() + processed);
+
+    if (!mPendingNodes.empty()) {
+        return false;
+    }
+    finalizeIncrementalAsset();
+    return true;
+}
+
+void FAssetLoader::finalizeIncrementalAsset() {
+    FFilamentAsset* const fAsset = mIncrementalAsset;
+    FFilamentInstance* const instance = mIncrementalInstance;
+    const cgltf_data* srcAsset = fAsset->mSourceAsset->hierarchy;
+
+    importSkins(fAsset, instance, srcAsset);
+
+    // Now that all entities have been created, the instance can create the animator component.
+    instance->createAnimator();
+
+    mMaterialInstanceCache.flush(&instance->mMaterialInstances);
+
+    fAsset->mDependencyGraph.commitEdges();
+
+    // Sort the entities so that the renderable ones come first, just like createInstances().
+    const auto& rm = mEngine.getRenderableManager();
+    std::partition(fAsset->mEntities.begin(), fAsset->mEntities.end(), [&rm](Entity a) {
+        return rm.hasComponent(a);
+    });
+
+    mIncrementalAsset = nullptr;
+    mIncrementalInstance = nullptr;
+    mError = false;
+}
+
 FFilamentAsset* FAssetLoader::createRootAsset(const cgltf_data* srcAsset) {
     SYSTRACE_CALL();
     #if !GLTFIO_DRACO_SUPPORTED
@@ -585,11 +816,29 @@ void FAssetLoader::createInstances(size_t numInstances, FFilamentAsset* fAsset)
     });
 }
 
+static size_t countNodes(const cgltf_node* node) noexcept {
+    size_t count = 1;
+    for (cgltf_size i = 0, len = node->children_count; i < len; ++i) {
+        count += countNodes(node->children[i]);
+    }
+    return count;
+}
+
 void FAssetLoader::recurseEntities(const cgltf_node* node, SceneMask scenes, Entity parent,
         FFilamentAsset* fAsset, FFilamentInstance* instance) {
+    const Entity entity = createEntity(node, scenes, parent, fAsset, instance);
+    for (cgltf_size i = 0, len = node->children_count; i < len; ++i) {
+        recurseEntities(node->children[i], scenes, entity, fAsset, instance);
+    }
+}
+
+Entity FAssetLoader::createEntity(const cgltf_node* node, SceneMask scenes, Entity parent,
+        FFilamentAsset* fAsset, FFilamentInstance* instance) {
     NodeManager& nm = mNodeManager;
     const cgltf_data* srcAsset = fAsset->mSourceAsset->hierarchy;
-    const Entity entity = mEntityManager.create();
+    // the pool is empty on the incremental path, where nodes trickle in via pumpAsset()
+    const Entity entity = UTILS_LIKELY(mEntityPoolIndex < mEntityPool.size()) ?
+            mEntityPool[mEntityPoolIndex++] : mEntityManager.create();
     nm.create(entity);
     const auto nodeInstance = nm.getInstance(entity);
     nm.setSceneMembership(nodeInstance, scenes);
@@ -652,9 +901,7 @@ void FAssetLoader::recurseEntities(const cgltf_node* node, SceneMask scenes, Ent
         createCamera(node->camera, entity, fAsset);
     }
 
-    for (cgltf_size i = 0, len = node->children_count; i < len; ++i) {
-        recurseEntities(node->children[i], scenes, entity, fAsset, instance);
-    }
+    return entity;
 }
 
 void FAssetLoader::createPrimitives(const cgltf_node* node, const char* name,
@@ -888,6 +1135,12 @@ void FAssetLoader::createRenderable(const cgltf_node* node, Entity entity, const
         .receiveShadows(true)
         .build(mEngine, entity);
 
+    // Shadow proxies can't follow skinning or morphing, and they need the source position
+    // data, which is only available once ResourceLoader has run; record a request for it.
+    if (mGenerateShadowProxies && !node->skin && numMorphTargets == 0) {
+        fAsset->mShadowProxyRequests.push_back({ entity, mesh });
+    }
+
     // According to the spec, the mesh may or may not specify default weights, regardless of whether
     // it actually has morph targets. If it has morphing enabled then the default weights are 0. If
     // node weights are provided, they override the ones specified on the mesh.
@@ -1510,6 +1763,7 @@ MaterialInstance* FAssetLoader::createMaterialInstance(const cgltf_material* inp
 
     const TextureProvider::TextureFlags sRGB = TextureProvider::TextureFlags::sRGB;
     const TextureProvider::TextureFlags LINEAR = TextureProvider::TextureFlags::NONE;
+    const TextureProvider::TextureFlags NORMAL = TextureProvider::TextureFlags::NORMAL_MAP;
 
     if (matkey.hasBaseColorTexture) {
         fAsset->addTextureBinding(mi, "baseColorMap", baseColorTexture.texture, sRGB);
@@ -1535,7 +1789,7 @@ MaterialInstance* FAssetLoader::createMaterialInstance(const cgltf_material* inp
     }
 
     if (matkey.hasNormalTexture) {
-        fAsset->addTextureBinding(mi, "normalMap", inputMat->normal_texture.texture, LINEAR);
+        fAsset->addTextureBinding(mi, "normalMap", inputMat->normal_texture.texture, NORMAL);
         if (matkey.hasTextureTransforms) {
             const cgltf_texture_transform& uvt = inputMat->normal_texture.transform;
             auto uvmat = matrixFromUvTransform(uvt.offset, uvt.rotation, uvt.scale);
@@ -1591,7 +1845,7 @@ MaterialInstance* FAssetLoader::createMaterialInstance(const cgltf_material* inp
         }
         if (matkey.hasClearCoatNormalTexture) {
             fAsset->addTextureBinding(mi, "clearCoatNormalMap",
-                    ccConfig.clearcoat_normal_texture.texture, LINEAR);
+                    ccConfig.clearcoat_normal_texture.texture, NORMAL);
             if (matkey.hasTextureTransforms) {
                 const cgltf_texture_transform& uvt = ccConfig.clearcoat_normal_texture.transform;
                 auto uvmat = matrixFromUvTransform(uvt.offset, uvt.rotation, uvt.scale);
@@ -1708,26 +1962,47 @@ MaterialInstance* FAssetLoader::createMaterialInstance(const cgltf_material* inp
     return mi;
 }
 
-void FAssetLoader::importSkins(FFilamentInstance* instance, const cgltf_data* gltf) {
+void FAssetLoader::importSkins(FFilamentAsset* fAsset, FFilamentInstance* instance,
+        const cgltf_data* gltf) {
+    // The skin topology (which nodes are joints and which are skinned) is a property of the
+    // asset, not of the instance. Build it once as node indices; every instance then only
+    // remaps the indices to its own entities, instead of re-walking all nodes.
+    auto& shapes = fAsset->mSkinShapes;
+    if (UTILS_UNLIKELY(shapes.empty() && gltf->skins_count > 0)) {
+        shapes.resize(gltf->skins_count);
+        for (cgltf_size i = 0, len = gltf->nodes_count; i < len; ++i) {
+            const cgltf_node& node = gltf->nodes[i];
+            if (node.skin) {
+                shapes[node.skin - &gltf->skins[0]].targets.push_back(i);
+            }
+        }
+        for (cgltf_size i = 0, len = gltf->skins_count; i < len; ++i) {
+            const cgltf_skin& srcSkin = gltf->skins[i];
+            auto& joints = shapes[i].joints;
+            joints = FixedCapacityVector<cgltf_size>(srcSkin.joints_count);
+            for (cgltf_size j = 0, jlen = srcSkin.joints_count; j < jlen; ++j) {
+                joints[j] = srcSkin.joints[j] - gltf->nodes;
+            }
+        }
+    }
+
     instance->mSkins.reserve(gltf->skins_count);
     instance->mSkins.resize(gltf->skins_count);
     const auto& nodeMap = instance->mNodeMap;
-    for (cgltf_size i = 0, len = gltf->nodes_count; i < len; ++i) {
-        const cgltf_node& node = gltf->nodes[i];
-        Entity entity = nodeMap[i];
-        if (node.skin && entity) {
-            int skinIndex = node.skin - &gltf->skins[0];
-            instance->mSkins[skinIndex].targets.insert(entity);
-        }
-    }
     for (cgltf_size i = 0, len = gltf->skins_count; i < len; ++i) {
         FFilamentInstance::Skin& dstSkin = instance->mSkins[i];
-        const cgltf_skin& srcSkin = gltf->skins[i];
+        const FFilamentAsset::SkinShape& shape = shapes[i];
+
+        for (cgltf_size const nodeIndex : shape.targets) {
+            if (Entity const entity = nodeMap[nodeIndex]; entity) {
+                dstSkin.targets.insert(entity);
+            }
+        }
 
         // Build a list of transformables for this skin, one for each joint.
-        dstSkin.joints = FixedCapacityVector<Entity>(srcSkin.joints_count);
-        for (cgltf_size i = 0, len = srcSkin.joints_count; i < len; ++i) {
-            dstSkin.joints[i] = nodeMap[srcSkin.joints[i] - gltf->nodes];
+        dstSkin.joints = FixedCapacityVector<Entity>(shape.joints.size());
+        for (cgltf_size j = 0, jlen = shape.joints.size(); j < jlen; ++j) {
+            dstSkin.joints[j] = nodeMap[shape.joints[j]];
         }
     }
 }
@@ -1759,6 +2034,19 @@ FilamentAsset* AssetLoader::createInstancedAsset(const uint8_t* bytes, uint32_t
     return downcast(this)->createInstancedAsset(bytes, numBytes, instances, numInstances);
 }
 
+FilamentAsset* AssetLoader::createSharedAsset(backend::BufferDescriptor&& glb) {
+    return downcast(this)->createSharedAsset(std::move(glb));
+}
+
+FilamentAsset* AssetLoader::createAssetIncremental(const uint8_t* bytes, uint32_t nbytes) {
+    return downcast(this)->createAssetIncremental(bytes, nbytes);
+}
+
+bool AssetLoader::pumpAsset(FilamentAsset* asset, uint64_t budgetUsec,
+        const math::float3& cameraPosition) {
+    return downcast(this)->pumpAsset(downcast(asset), budgetUsec, cameraPosition);
+}
+
 FilamentInstance* AssetLoader::createInstance(FilamentAsset* asset) {
     return downcast(this)->createInstance(downcast(asset));
 }
@@ -0,0 +1,201 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "AssetSnapshot.h"
+
+#include <utils/Log.h>
+
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+namespace filament::gltfio {
+
+namespace {
+
+constexpr uint32_t SNAPSHOT_MAGIC = 'F' | 'S' << 8 | 'N' << 16 | 'P' << 24;
+constexpr uint32_t SNAPSHOT_VERSION = 2;
+
+struct SnapshotHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t signature;
+    uint32_t blobCount;
+    uint32_t reserved;
+};
+
+struct SnapshotRecord {
+    uint8_t kind;
+    uint8_t slot[3];    // 24-bit little-endian buffer-slot index, NO_SLOT when not tied to one
+    uint32_t count;
+    uint64_t size;
+};
+
+} // anonymous namespace
+
+AssetSnapshot::AssetSnapshot(std::string path) : mPath(std::move(path)) {}
+
+AssetSnapshot::~AssetSnapshot() {
+    waitForWriter();
+}
+
+void AssetSnapshot::waitForWriter() {
+    if (mWriter.joinable()) {
+        mWriter.join();
+    }
+}
+
+bool AssetSnapshot::load(uint64_t signature) {
+    // A write from a previous load of the same asset may still be in flight.
+    waitForWriter();
+
+    mBlobs.clear();
+    mPayload.reset();
+
+    std::ifstream in(mPath, std::ifstream::in | std::ifstream::binary);
+    if (!in) {
+        return false;
+    }
+    auto payload = std::make_shared<std::vector<uint8_t>>();
+    in.seekg(0, std::ios::end);
+    payload->resize((size_t) in.tellg());
+    in.seekg(0, std::ios::beg);
+    in.read((char*) payload->data(), payload->size());
+    if (!in) {
+        return false;
+    }
+
+    if (payload->size() < sizeof(SnapshotHeader)) {
+        return false;
+    }
+    SnapshotHeader header;
+    memcpy(&header, payload->data(), sizeof(header));
+    if (header.magic != SNAPSHOT_MAGIC || header.version != SNAPSHOT_VERSION) {
+        return false;
+    }
+    if (header.signature != signature) {
+        // the source asset changed since the snapshot was written
+        return false;
+    }
+
+    // division keeps a hostile blobCount from overflowing the record-table size
+    if (header.blobCount > (payload->size() - sizeof(SnapshotHeader)) / sizeof(SnapshotRecord)) {
+        return false;
+    }
+    size_t offset = sizeof(SnapshotHeader) + header.blobCount * sizeof(SnapshotRecord);
+    mBlobs.reserve(header.blobCount);
+    const uint8_t* records = payload->data() + sizeof(SnapshotHeader);
+    for (uint32_t i = 0; i < header.blobCount; i++) {
+        SnapshotRecord record;
+        memcpy(&record, records + i * sizeof(SnapshotRecord), sizeof(record));
+        // subtraction rather than addition, so a size near UINT64_MAX can't wrap past the check
+        if (record.size > payload->size() - offset) {
+            mBlobs.clear();
+            return false;
+        }
+        mBlobs.push_back({
+            .kind = BlobKind(record.kind),
+            .count = record.count,
+            .slot = uint32_t(record.slot[0])
+                    | uint32_t(record.slot[1]) << 8
+                    | uint32_t(record.slot[2]) << 16,
+            .data = payload->data() + offset,
+            .size = (size_t) record.size,
+        });
+        offset += record.size;
+    }
+    mPayload = std::move(payload);
+    return true;
+}
+
+void* AssetSnapshot::acquirePayload() const noexcept {
+    return new Payload(mPayload);
+}
+
+void AssetSnapshot::releaseCallback(void*, size_t, void* user) {
+    delete (Payload*) user;
+}
+
+void AssetSnapshot::beginRecording(uint64_t signature) {
+    waitForWriter();
+    mPending.clear();
+    mSignature = signature;
+    mRecording = true;
+}
+
+void AssetSnapshot::record(BlobKind kind, uint32_t count, const void* data, size_t size,
+        uint32_t slot) {
+    if (!mRecording) {
+        return;
+    }
+    assert(slot <= NO_SLOT);
+    PendingBlob blob{ .kind = kind, .count = count, .slot = slot };
+    blob.data.resize(size);
+    memcpy(blob.data.data(), data, size);
+    mPending.push_back(std::move(blob));
+}
+
+void AssetSnapshot::finishRecording() {
+    if (!mRecording) {
+        return;
+    }
+    mRecording = false;
+    mWriter = std::thread([path = mPath, signature = mSignature,
+            blobs = std::move(mPending)]() {
+        // write to a temporary file first so a crash never leaves a truncated snapshot
+        const std::string tmpPath = path + ".tmp";
+        std::ofstream out(tmpPath, std::ofstream::out | std::ofstream::binary);
+        if (!out) {
+            utils::slog.w << "Unable to write asset snapshot " << path.c_str()
+                    << utils::io::endl;
+            return;
+        }
+        SnapshotHeader header{
+            .magic = SNAPSHOT_MAGIC,
+            .version = SNAPSHOT_VERSION,
+            .signature = signature,
+            .blobCount = (uint32_t) blobs.size(),
+            .reserved = 0,
+        };
+        out.write((const char*) &header, sizeof(header));
+        for (auto const& blob : blobs) {
+            SnapshotRecord record{
+                .kind = (uint8_t) blob.kind,
+                .slot = {
+                    uint8_t(blob.slot),
+                    uint8_t(blob.slot >> 8),
+                    uint8_t(blob.slot >> 16),
+                },
+                .count = blob.count,
+                .size = blob.data.size(),
+            };
+            out.write((const char*) &record, sizeof(record));
+        }
+        for (auto const& blob : blobs) {
+            out.write((const char*) blob.data.data(), blob.data.size());
+        }
+        out.close();
+        if (!out || rename(tmpPath.c_str(), path.c_str())) {
+            utils::slog.w << "Unable to write asset snapshot " << path.c_str()
+                    << utils::io::endl;
+            remove(tmpPath.c_str());
+        }
+    });
+    mPending.clear();
+}
+
+} // namespace filament::gltfio
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GLTFIO_ASSETSNAPSHOT_H
+#define GLTFIO_ASSETSNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace filament::gltfio {
+
+/**
+ * Internal container for an engine-native snapshot of an asset's cooked resources.
+ *
+ * A snapshot holds the exact buffer payloads that ResourceLoader would otherwise have to
+ * re-derive on every load: Draco / meshopt decompressed geometry, attribute data converted
+ * to backend-ready formats, generated tangent frames, and skin bind matrices. Blobs are
+ * stored in the deterministic order ResourceLoader cooks them. Blobs cooked from a buffer
+ * slot additionally carry the slot index, because the restore path cannot re-derive it:
+ * Draco accessors only receive a buffer view when the decode runs, which the restore
+ * skips. Tangent and skin blobs are purely positional.
+ *
+ * The file is validated against a signature computed from the parsed glTF structure; a
+ * mismatch (the source asset changed) makes load() fail and the caller falls back to a
+ * full cook, re-recording the snapshot. Writing happens on a background thread so it never
+ * adds to first-load latency. AssetSnapshot is not thread-safe; all methods other than the
+ * internal writer must be called from the loading thread.
+ */
+class AssetSnapshot {
+public:
+    enum class BlobKind : uint8_t {
+        BUFFER_OBJECT,              // raw vertex data, VertexBuffer::setBufferObjectAt()
+        BUFFER_OBJECT_CONVERTED,    // vertex data unpacked to floats
+        INDEX,                      // raw index data, IndexBuffer::setBuffer()
+        INDEX_FROM_BYTES,           // 8-bit indices widened to 16-bit
+        MORPH_POSITIONS,            // morph target positions, setPositionsAt()
+        TANGENTS_VERTEX,            // generated tangent frames for a vertex buffer slot
+        TANGENTS_MORPH,             // generated tangent frames for a morph target
+        SKIN_MATRICES,              // inverse bind matrices of one skin
+    };
+
+    // marks a blob that isn't tied to a buffer slot (tangents, skins)
+    static constexpr uint32_t NO_SLOT = 0xffffffu;
+
+    struct Blob {
+        BlobKind kind;
+        uint32_t count;             // kind-specific element count (vertices, matrices, ...)
+        uint32_t slot;              // buffer-slot index the blob was cooked from, or NO_SLOT
+        const uint8_t* data;        // points into the snapshot's shared payload
+        size_t size;
+    };
+
+    explicit AssetSnapshot(std::string path);
+    ~AssetSnapshot();
+
+    AssetSnapshot(AssetSnapshot const&) = delete;
+    AssetSnapshot& operator=(AssetSnapshot const&) = delete;
+
+    const std::string& getPath() const noexcept { return mPath; }
+
+    // Reads and validates the snapshot file; returns false if it is missing, malformed, or
+    // was recorded from a different source asset (signature mismatch).
+    bool load(uint64_t signature);
+
+    size_t getBlobCount() const noexcept { return mBlobs.size(); }
+    Blob const& getBlob(size_t index) const noexcept { return mBlobs[index]; }
+
+    // Returns an opaque reference that keeps the loaded payload alive; intended as the
+    // user pointer of a BufferDescriptor with releaseCallback, enabling zero-copy uploads.
+    void* acquirePayload() const noexcept;
+    static void releaseCallback(void* buffer, size_t size, void* user);
+
+    // Recording: record() copies each cooked blob as it is uploaded; finishRecording()
+    // hands the accumulated blobs to a background writer thread.
+    void beginRecording(uint64_t signature);
+    bool isRecording() const noexcept { return mRecording; }
+    void record(BlobKind kind, uint32_t count, const void* data, size_t size,
+            uint32_t slot = NO_SLOT);
+    void finishRecording();
+
+private:
+    using Payload = std::shared_ptr<std::vector<uint8_t>>;
+
+    struct PendingBlob {
+        BlobKind kind;
+        uint32_t count;
+        uint32_t slot;
+        std::vector<uint8_t> data;
+    };
+
+    void waitForWriter();
+
+    const std::string mPath;
+    Payload mPayload;               // shared with in-flight BufferDescriptors
+    std::vector<Blob> mBlobs;
+
+    bool mRecording = false;
+    uint64_t mSignature = 0;
+    std::vector<PendingBlob> mPending;
+    std::thread mWriter;
+};
+
+} // namespace filament::gltfio
+
+#endif // GLTFIO_ASSETSNAPSHOT_H
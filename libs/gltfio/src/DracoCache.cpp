@@ -21,13 +21,16 @@
 #endif
 
 #include <utils/compiler.h>
+#include <utils/Hash.h>
+#include <utils/JobSystem.h>
 #include <utils/Log.h>
 
-#if GLTFIO_DRACO_SUPPORTED
-
 #include <memory>
+#include <mutex>
 #include <vector>
 
+#if GLTFIO_DRACO_SUPPORTED
+
 using std::unique_ptr;
 using std::vector;
 
@@ -37,6 +40,51 @@ using namespace utils;
 
 namespace filament::gltfio {
 
+namespace {
+
+// Process-wide registry of decoded Draco meshes, keyed by a hash of the compressed bytes. See
+// the class comment in DracoCache.h. The registry may be hit from several JobSystem workers at
+// once during DracoCache::prefetch.
+std::mutex sSharedMeshesLock;
+tsl::robin_map<uint64_t, std::weak_ptr<DracoMesh>>& getSharedMeshes() {
+    static tsl::robin_map<uint64_t, std::weak_ptr<DracoMesh>> registry;
+    return registry;
+}
+
+uint64_t computeContentKey(const uint8_t* data, size_t size) {
+    const uint32_t h = hash::murmurSlow(data, size, 42);
+    return (uint64_t(h) << 32u) | uint64_t(size & 0xffffffffu);
+}
+
+std::shared_ptr<DracoMesh> acquireSharedMesh(const uint8_t* data, size_t size) {
+    const uint64_t key = computeContentKey(data, size);
+    auto& registry = getSharedMeshes();
+    {
+        std::lock_guard lock(sSharedMeshesLock);
+        if (auto iter = registry.find(key); iter != registry.end()) {
+            if (auto mesh = iter->second.lock()) {
+                return mesh;
+            }
+        }
+    }
+    // Decode outside the lock. Two workers can race to decode the same content; the first
+    // publisher wins and the loser's result is discarded, which is rare enough not to matter.
+    std::shared_ptr<DracoMesh> mesh(DracoMesh::decode(data, size));
+    if (mesh) {
+        std::lock_guard lock(sSharedMeshesLock);
+        if (auto iter = registry.find(key); iter != registry.end()) {
+            if (auto existing = iter->second.lock()) {
+                return existing;
+            }
+            registry.erase(iter);
+        }
+        registry.emplace(key, mesh);
+    }
+    return mesh;
+}
+
+} // anonymous namespace
+
 DracoMesh* DracoCache::findOrCreateMesh(const cgltf_buffer_view* key) {
     auto iter = mCache.find(key);
     if (iter != mCache.end()) {
@@ -44,9 +92,40 @@ DracoMesh* DracoCache::findOrCreateMesh(const cgltf_buffer_view* key) {
     }
     assert(key->buffer && key->buffer->data);
     const uint8_t* compressedData = key->offset + (uint8_t*) key->buffer->data;
-    DracoMesh* mesh = DracoMesh::decode(compressedData, key->size);
-    mCache.emplace(key, mesh);
-    return mesh;
+    std::shared_ptr<DracoMesh> mesh = acquireSharedMesh(compressedData, key->size);
+    mCache.emplace(key, std::move(mesh));
+    return mCache.find(key)->second.get();
+}
+
+void DracoCache::prefetch(const cgltf_buffer_view* const* views, size_t count, JobSystem& js) {
+    // Pre-insert empty entries so the map cannot rehash while worker jobs fill them in. This
+    // also deduplicates the given list.
+    std::vector<const cgltf_buffer_view*> pending;
+    pending.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const cgltf_buffer_view* view = views[i];
+        if (mCache.find(view) == mCache.end()) {
+            mCache.emplace(view, nullptr);
+            pending.push_back(view);
+        }
+    }
+    JobSystem::Job* parent = js.createJob();
+    for (const cgltf_buffer_view* view : pending) {
+        // A whole-mesh decode can take milliseconds, so run it as a cooperative job: if frame
+        // preparation is in flight when the job gets a worker, it steps aside and is resumed
+        // once the frame work has drained, instead of holding the worker for its duration.
+        js.run(js.createCooperativeJob(parent,
+                [this, view](JobSystem& js, JobSystem::Job*) -> bool {
+            if (UTILS_UNLIKELY(js.shouldYield())) {
+                return false;
+            }
+            assert(view->buffer && view->buffer->data);
+            const uint8_t* compressedData = view->offset + (uint8_t*) view->buffer->data;
+            mCache.find(view).value() = acquireSharedMesh(compressedData, view->size);
+            return true;
+        }));
+    }
+    js.runAndWait(parent);
 }
 
 DracoMesh::DracoMesh(struct DracoMeshDetails* details) : mDetails(details) {}
@@ -27,6 +27,10 @@
 #define GLTFIO_DRACO_SUPPORTED 0
 #endif
 
+namespace utils {
+class JobSystem;
+}
+
 namespace filament::gltfio {
 
 class DracoMesh;
@@ -35,11 +39,21 @@ class DracoMesh;
 //
 // The cache key is the buffer view that holds the compressed data. This allows the loader to
 // avoid duplicated work when a single Draco mesh is referenced from multiple primitives.
+//
+// Decoded meshes are additionally shared between caches (i.e. between assets) through a
+// process-wide registry keyed by a hash of the compressed bytes, so loading the same compressed
+// glTF several times decodes each mesh exactly once. The registry holds weak references only;
+// decoded data lives exactly as long as some asset's cache still references it.
 class DracoCache {
 public:
     DracoMesh* findOrCreateMesh(const cgltf_buffer_view* key);
+
+    // Decodes all not-yet-cached meshes in the given list concurrently over JobSystem workers.
+    // Duplicate views are permitted. Subsequent findOrCreateMesh calls become cheap lookups.
+    void prefetch(const cgltf_buffer_view* const* views, size_t count, utils::JobSystem& js);
+
 private:
-    tsl::robin_map<const cgltf_buffer_view*, std::unique_ptr<DracoMesh>> mCache;
+    tsl::robin_map<const cgltf_buffer_view*, std::shared_ptr<DracoMesh>> mCache;
 };
 
 // Decodes a Draco mesh upon construction and retains the results.
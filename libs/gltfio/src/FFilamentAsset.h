@@ -21,6 +21,8 @@
 #include <gltfio/NodeManager.h>
 #include <gltfio/TrsTransformManager.h>
 
+#include <backend/BufferDescriptor.h>
+
 #include <filament/Engine.h>
 #include <filament/IndexBuffer.h>
 #include <filament/MaterialInstance.h>
@@ -279,6 +281,15 @@ struct FFilamentAsset : public FilamentAsset {
     utils::CString mAssetExtras;
     bool mDetachedFilamentComponents = false;
 
+    // Renderables that want a simplified shadow-proxy (see
+    // AssetConfiguration::generateShadowProxies). Recorded by AssetLoader when the renderable
+    // is created and consumed by ResourceLoader once the vertex data is available.
+    struct ShadowProxyRequest {
+        utils::Entity renderable;
+        const cgltf_mesh* mesh;
+    };
+    std::vector<ShadowProxyRequest> mShadowProxyRequests;
+
     // Sentinels for situations where ResourceLoader needs to generate data.
     const cgltf_accessor mGenerateNormals = {};
     const cgltf_accessor mGenerateTangents = {};
@@ -290,6 +301,13 @@ struct FFilamentAsset : public FilamentAsset {
         cgltf_data* hierarchy;
         DracoCache dracoCache;
         utils::FixedCapacityVector<uint8_t> glbData;
+
+        // Alternative to glbData for clients that own the glTF blob themselves, e.g. as a
+        // memory-mapped file (see AssetLoader::createSharedAsset). The descriptor's release
+        // callback fires when the last reference to the source asset goes away, i.e. after
+        // every GPU upload that aliases the blob has completed, making it a safe place to
+        // unmap the file.
+        filament::backend::BufferDescriptor externalData;
     };
 
     // We used shared ownership for the raw cgltf data in order to permit ResourceLoader to
@@ -321,6 +339,19 @@ struct FFilamentAsset : public FilamentAsset {
     // The mapping from cgltf_mesh to VertexBuffer* (etc) is required when creating new instances.
     MeshCache mMeshCache;
 
+    // Number of entities an instance of this asset creates. Computed on the first
+    // instantiation and reused to batch-create the entities of subsequent instances.
+    size_t mInstanceEntityCount = 0;
+
+    // Immutable per-asset skin topology, expressed as node indices so it can be shared by
+    // all instances: each instance only remaps the indices to its own entities. Built
+    // lazily by FAssetLoader::importSkins().
+    struct SkinShape {
+        utils::FixedCapacityVector<cgltf_size> joints;  // node index of each joint
+        std::vector<cgltf_size> targets;                // nodes skinned by this skin
+    };
+    std::vector<SkinShape> mSkinShapes;
+
     // Asset information that is produced by AssetLoader and consumed by ResourceLoader:
     struct ResourceInfo {
         // Encapsulates VertexBuffer::setBufferAt() or IndexBuffer::setBuffer().
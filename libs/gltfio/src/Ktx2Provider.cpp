@@ -71,8 +71,11 @@ private:
         QueueItemState state;
         atomic<TranscoderState> transcoderState;
         JobSystem::Job* job;
+        bool highPriority;
     };
 
+    void startTranscoderJob(QueueItem* item);
+    void startDeferredJobs();
     void transcodeSingleTexture();
 
     size_t mPushedCount = 0;
@@ -82,15 +85,24 @@ private:
     JobSystem::Job* mDecoderRootJob;
     std::string mRecentPushMessage;
     std::string mRecentPopMessage;
-    std::unique_ptr<ktxreader::Ktx2Reader> mKtxReader;
+    // One reader per content class, each configured with the format preference list that the
+    // probed decision table picked for that class (e.g. EAC_RG11 / BC5 for normal maps).
+    std::unique_ptr<ktxreader::Ktx2Reader>
+            mKtxReaders[3 /* ktxreader::TranscodeTargets::ContentClass count */];
     Engine* const mEngine;
 };
 
 Texture* Ktx2Provider::pushTexture(const uint8_t* data, size_t byteCount,
             const char* mimeType, TextureProvider::TextureFlags flags) {
     using TransferFunction = ktxreader::Ktx2Reader::TransferFunction;
+    using ContentClass = ktxreader::TranscodeTargets::ContentClass;
 
-    auto async = mKtxReader->asyncCreate(data, byteCount,
+    const ContentClass contentClass =
+            any(flags & TextureProvider::TextureFlags::sRGB) ? ContentClass::COLOR :
+            any(flags & TextureProvider::TextureFlags::NORMAL_MAP) ? ContentClass::NORMAL_MAP :
+            ContentClass::NON_COLOR_DATA;
+
+    auto async = mKtxReaders[size_t(contentClass)]->asyncCreate(data, byteCount,
             any(flags & TextureProvider::TextureFlags::sRGB) ?
             TransferFunction::sRGB : TransferFunction::LINEAR);
 
@@ -106,24 +118,47 @@ Texture* Ktx2Provider::pushTexture(const uint8_t* data, size_t byteCount,
     item->async = async;
     item->state = QueueItemState::TRANSCODING;
     item->transcoderState.store(TranscoderState::NOT_STARTED);
+    item->job = nullptr;
+    item->highPriority = any(flags & TextureProvider::TextureFlags::PRIORITY_HIGH);
 
     // On single threaded systems, it is usually fine to create jobs because the job system will
     // simply execute serially. However in our case, we wish to amortize the decoder cost across
     // several frames, so we instead use the updateQueue() method to perform decoding.
     if constexpr (!UTILS_HAS_THREADING) {
-        item->job = nullptr;
         return async->getTexture();
     }
 
-    JobSystem* js = &mEngine->getJobSystem();
-    item->job = jobs::createJob(*js, mDecoderRootJob, [item] {
+    // High priority textures start decoding right away; the others are deferred until the
+    // first updateQueue() call, i.e. until after the whole scene has been pushed. Since the
+    // job system has no notion of priority, this is what lets the high priority items grab
+    // the worker threads first.
+    if (item->highPriority) {
+        startTranscoderJob(item);
+    }
+    return async->getTexture();
+}
+
+void Ktx2Provider::startTranscoderJob(QueueItem* item) {
+    assert_invariant(item->job == nullptr);
+    JobSystem* js = &mEngine->getBackgroundJobSystem();
+    item->job = jobs::createJob(*js, mDecoderRootJob, [item, js] {
         using Result = ktxreader::Ktx2Reader::Result;
-        const bool success = Result::SUCCESS == item->async->doTranscoding();
+        // Distribute the miplevels of this texture over the job system as well, so a single
+        // large texture doesn't serialize on one worker thread.
+        const bool success = Result::SUCCESS == item->async->doTranscoding(*js);
         item->transcoderState.store(success ? TranscoderState::SUCCESS : TranscoderState::ERROR);
     });
-
     js->runAndRetain(item->job);
-    return async->getTexture();
+}
+
+void Ktx2Provider::startDeferredJobs() {
+    if constexpr (UTILS_HAS_THREADING) {
+        for (auto& item : mQueueItems) {
+            if (item->state == QueueItemState::TRANSCODING && item->job == nullptr) {
+                startTranscoderJob(item.get());
+            }
+        }
+    }
 }
 
 Texture* Ktx2Provider::popTexture() {
@@ -141,7 +176,7 @@ Texture* Ktx2Provider::popTexture() {
                 mRecentPopMessage.clear();
             }
             Texture* texture = item->async->getTexture();
-            mKtxReader->asyncDestroy(&item->async);
+            mKtxReaders[0]->asyncDestroy(&item->async);
             item->async = nullptr;
             return texture;
         }
@@ -153,7 +188,13 @@ void Ktx2Provider::updateQueue() {
     if (!UTILS_HAS_THREADING) {
         transcodeSingleTexture();
     }
-    JobSystem* js = &mEngine->getJobSystem();
+    // Backpressure: while the engine is over its staging budget, hold back new decode
+    // jobs -- decoded results are exactly what turns into upload memory. Items already
+    // decoding still upload below, which is what drains the budget.
+    if (!mEngine->isStagingBudgetExceeded()) {
+        startDeferredJobs();
+    }
+    JobSystem* js = &mEngine->getBackgroundJobSystem();
     for (auto& item : mQueueItems) {
         if (item->state != QueueItemState::TRANSCODING) {
             continue;
@@ -184,7 +225,8 @@ void Ktx2Provider::updateQueue() {
 }
 
 void Ktx2Provider::waitForCompletion() {
-    JobSystem& js = mEngine->getJobSystem();
+    startDeferredJobs();
+    JobSystem& js = mEngine->getBackgroundJobSystem();
     for (auto& item : mQueueItems) {
         if (item->job) {
             js.waitAndRelease(item->job);
@@ -193,9 +235,15 @@ void Ktx2Provider::waitForCompletion() {
 }
 
 void Ktx2Provider::cancelDecoding() {
-    // TODO: Currently, Ktx2Provider runs jobs eagerly and JobSystem does not allow cancellation of
-    // in-flight jobs. We should consider throttling the number of simultaneous decoder jobs, which
-    // would allow for actual cancellation.
+    // Items whose job hasn't started yet can be cancelled outright; JobSystem does not allow
+    // cancellation of in-flight jobs, so for those we can only wait.
+    for (auto& item : mQueueItems) {
+        if (item->state == QueueItemState::TRANSCODING && item->job == nullptr) {
+            mKtxReaders[0]->asyncDestroy(&item->async);
+            item->async = nullptr;
+            item->state = QueueItemState::POPPED;
+        }
+    }
     waitForCompletion();
 
     // For cancelled jobs, we need to set the QueueItemState to POPPED and free the decoded data
@@ -204,7 +252,7 @@ void Ktx2Provider::cancelDecoding() {
         if (item->state != QueueItemState::TRANSCODING) {
             continue;
         }
-        mKtxReader->asyncDestroy(&item->async);
+        mKtxReaders[0]->asyncDestroy(&item->async);
         item->async = nullptr;
         item->state = QueueItemState::POPPED;
     }
@@ -231,29 +279,34 @@ void Ktx2Provider::transcodeSingleTexture() {
 }
 
 Ktx2Provider::Ktx2Provider(Engine* engine) : mEngine(engine) {
-    mDecoderRootJob = mEngine->getJobSystem().createJob();
+    mDecoderRootJob = mEngine->getBackgroundJobSystem().createJob();
 #ifdef NDEBUG
     const bool quiet = true;
 #else
     const bool quiet = false;
 #endif
-    mKtxReader.reset(new ktxreader::Ktx2Reader(*engine, quiet));
-
-    mKtxReader->requestFormat(Texture::InternalFormat::ETC2_EAC_SRGBA8);
-    mKtxReader->requestFormat(Texture::InternalFormat::DXT5_SRGBA);
-    mKtxReader->requestFormat(Texture::InternalFormat::DXT5_RGBA);
-
-    // Uncompressed formats are lower priority, so they get added last.
-    mKtxReader->requestFormat(Texture::InternalFormat::SRGB8_A8);
-    mKtxReader->requestFormat(Texture::InternalFormat::RGBA8);
+    // Probe the device's format support once and build per-class target lists, rather than
+    // shipping a conservative list: on devices with ASTC / BPTC / RGTC support this picks
+    // better-suited formats (e.g. two-channel BC5 / EAC_RG11 for normal maps). Each list
+    // already ends with an uncompressed fallback.
+    using TranscodeTargets = ktxreader::TranscodeTargets;
+    using ContentClass = TranscodeTargets::ContentClass;
+    TranscodeTargets const targets =
+            TranscodeTargets::probe(*engine, TranscodeTargets::Policy::PREFER_QUALITY);
+    for (ContentClass contentClass :
+            { ContentClass::COLOR, ContentClass::NORMAL_MAP, ContentClass::NON_COLOR_DATA }) {
+        auto& reader = mKtxReaders[size_t(contentClass)];
+        reader.reset(new ktxreader::Ktx2Reader(*engine, quiet));
+        reader->requestFormats(targets, contentClass);
+    }
 }
 
 Ktx2Provider::~Ktx2Provider() {
     cancelDecoding();
     for (auto& item : mQueueItems) {
-        mKtxReader->asyncDestroy(&item->async);
+        mKtxReaders[0]->asyncDestroy(&item->async);
     }
-    mEngine->getJobSystem().release(mDecoderRootJob);
+    mEngine->getBackgroundJobSystem().release(mDecoderRootJob);
 }
 
 TextureProvider* createKtx2Provider(Engine* engine) {
@@ -17,6 +17,7 @@
 #include <gltfio/ResourceLoader.h>
 #include <gltfio/TextureProvider.h>
 
+#include "AssetSnapshot.h"
 #include "GltfEnums.h"
 #include "FFilamentAsset.h"
 #include "TangentsJob.h"
@@ -31,10 +32,15 @@
 #include <filament/Texture.h>
 #include <filament/VertexBuffer.h>
 #include <filament/MorphTargetBuffer.h>
+#include <filament/RenderableManager.h>
+#include <filament/TransformManager.h>
 
+#include <geometry/LodChain.h>
 #include <geometry/Transcoder.h>
 
 #include <utils/compiler.h>
+#include <utils/EntityManager.h>
+#include <utils/Hash.h>
 #include <utils/JobSystem.h>
 #include <utils/Log.h>
 #include <utils/Systrace.h>
@@ -82,11 +88,17 @@ struct ResourceLoader::Impl {
         mEngine(config.engine),
         mNormalizeSkinningWeights(config.normalizeSkinningWeights),
         mGltfPath(config.gltfPath ? config.gltfPath : ""),
+        mSnapshotPath(config.snapshotPath ? config.snapshotPath : ""),
         mUriDataCache(std::make_shared<UriDataCache>()) {}
 
     Engine* const mEngine;
     bool mNormalizeSkinningWeights;
     std::string mGltfPath;
+    std::string mSnapshotPath;
+
+    // Persistent snapshot of the cooked resources; kept across loads so a pending
+    // background write can complete before the file is read back.
+    std::unique_ptr<AssetSnapshot> mSnapshot;
 
     // User-provided resource data with URI string keys, populated with addResourceData().
     // This is used on platforms without traditional file systems, such as Android, iOS, and WebGL.
@@ -102,8 +114,20 @@ struct ResourceLoader::Impl {
     FFilamentAsset* mAsyncAsset = nullptr;
     size_t mRemainingTextureDownloads = 0;
 
+    AssetSnapshot* getSnapshot() {
+        if (mSnapshotPath.empty()) {
+            return nullptr;
+        }
+        if (!mSnapshot || mSnapshot->getPath() != mSnapshotPath) {
+            mSnapshot = std::make_unique<AssetSnapshot>(mSnapshotPath);
+        }
+        return mSnapshot.get();
+    }
+
     void addResourceData(const char* uri, BufferDescriptor&& buffer);
-    void computeTangents(FFilamentAsset* asset);
+    bool restoreCookedResources(FFilamentAsset* asset, AssetSnapshot& snapshot);
+    void computeTangents(FFilamentAsset* asset, AssetSnapshot* snapshot);
+    void generateShadowProxies(FFilamentAsset* asset);
     void createTextures(FFilamentAsset* asset, bool async);
     void cancelTextureDecoding();
     std::pair<Texture*, CacheResult> getOrCreateTexture(FFilamentAsset* asset, size_t textureIndex,
@@ -188,7 +212,7 @@ inline void normalizeSkinningWeights(cgltf_data const* gltf) {
 }
 
 inline void createSkins(cgltf_data const* gltf, bool normalize,
-        utils::FixedCapacityVector<FFilamentAsset::Skin>& skins) {
+        utils::FixedCapacityVector<FFilamentAsset::Skin>& skins, AssetSnapshot* snapshot) {
     // For each skin, optionally normalize skinning weights and store a copy of the bind matrices.
     if (gltf->skins_count == 0) {
         return;
@@ -219,6 +243,11 @@ inline void createSkins(cgltf_data const* gltf, bool normalize,
             memcpy((uint8_t*) inverseBindMatrices.data(), (const void*) srcBuffer,
                     srcSkin.joints_count * sizeof(mat4f));
         }
+        if (snapshot && snapshot->isRecording()) {
+            snapshot->record(AssetSnapshot::BlobKind::SKIN_MATRICES,
+                    (uint32_t) srcSkin.joints_count, inverseBindMatrices.data(),
+                    srcSkin.joints_count * sizeof(mat4f));
+        }
         FFilamentAsset::Skin skin{
                 .name = std::move(name),
                 .inverseBindMatrices = std::move(inverseBindMatrices),
@@ -228,10 +257,19 @@ inline void createSkins(cgltf_data const* gltf, bool normalize,
 }
 
 inline void uploadBuffers(FFilamentAsset* asset, Engine& engine,
-        UriDataCacheHandle uriDataCache) {
+        UriDataCacheHandle uriDataCache, AssetSnapshot* snapshot) {
     // Upload VertexBuffer and IndexBuffer data to the GPU.
     auto& slots = std::get<FFilamentAsset::ResourceInfo>(asset->mResourceInfo).mBufferSlots;
-    for (auto const& slot: slots) {
+    for (size_t slotIndex = 0, slotCount = slots.size(); slotIndex < slotCount; slotIndex++) {
+        auto const& slot = slots[slotIndex];
+        // Recorded blobs carry the slot index, so the restore walk doesn't depend on which
+        // accessors have buffer views (Draco accessors only get one once decoded).
+        auto const record = [snapshot, slotIndex](AssetSnapshot::BlobKind kind, size_t count,
+                const void* data, size_t size) {
+            if (snapshot && snapshot->isRecording()) {
+                snapshot->record(kind, (uint32_t) count, data, size, (uint32_t) slotIndex);
+            }
+        };
         const cgltf_accessor* accessor = slot.accessor;
         if (!accessor->buffer_view) {
             continue;
@@ -253,6 +291,8 @@ inline void uploadBuffers(FFilamentAsset* asset, Engine& engine,
                 const size_t floatsByteCount = sizeof(float) * floatsCount;
                 float* floatsData = (float*) malloc(floatsByteCount);
                 cgltf_accessor_unpack_floats(accessor, floatsData, floatsCount);
+                record(AssetSnapshot::BlobKind::BUFFER_OBJECT_CONVERTED, accessor->count,
+                        floatsData, floatsByteCount);
                 BufferObject* bo = BufferObject::Builder().size(floatsByteCount).build(engine);
                 asset->mBufferObjects.push_back(bo);
                 bo->setBuffer(engine, BufferDescriptor(floatsData, floatsByteCount, FREE_CALLBACK));
@@ -260,6 +300,7 @@ inline void uploadBuffers(FFilamentAsset* asset, Engine& engine,
                 continue;
             }
 
+            record(AssetSnapshot::BlobKind::BUFFER_OBJECT, accessor->count, data, size);
             BufferObject* bo = BufferObject::Builder().size(size).build(engine);
             asset->mBufferObjects.push_back(bo);
             bo->setBuffer(engine, BufferDescriptor(data, size, uploadCallback,
@@ -271,11 +312,14 @@ inline void uploadBuffers(FFilamentAsset* asset, Engine& engine,
                 const size_t size16 = size * 2;
                 uint16_t* data16 = (uint16_t*) malloc(size16);
                 utility::convertBytesToShorts(data16, data, size);
+                record(AssetSnapshot::BlobKind::INDEX_FROM_BYTES, accessor->count,
+                        data16, size16);
                 IndexBuffer::BufferDescriptor bd(data16, size16, FREE_CALLBACK);
 
                 slot.indexBuffer->setBuffer(engine, std::move(bd));
                 continue;
             }
+            record(AssetSnapshot::BlobKind::INDEX, accessor->count, data, size);
             IndexBuffer::BufferDescriptor bd(data, size, uploadCallback,
                     uploadUserdata(asset, uriDataCache));
             slot.indexBuffer->setBuffer(engine, std::move(bd));
@@ -292,13 +336,18 @@ inline void uploadBuffers(FFilamentAsset* asset, Engine& engine,
             float* floatsData = (float*) malloc(floatsByteCount);
             cgltf_accessor_unpack_floats(accessor, floatsData, floatsCount);
             if (accessor->type == cgltf_type_vec3) {
+                record(AssetSnapshot::BlobKind::MORPH_POSITIONS, slot.morphTargetCount,
+                        floatsData, slot.morphTargetCount * sizeof(float3));
                 slot.morphTargetBuffer->setPositionsAt(engine, slot.bufferIndex,
                         (const float3*) floatsData,
                         slot.morphTargetCount,
                         slot.morphTargetOffset);
             } else {
+                const size_t count = slot.morphTargetBuffer->getVertexCount();
+                record(AssetSnapshot::BlobKind::MORPH_POSITIONS, count,
+                        data, count * sizeof(float4));
                 slot.morphTargetBuffer->setPositionsAt(engine, slot.bufferIndex,
-                        (const float4*) data, slot.morphTargetBuffer->getVertexCount(),
+                        (const float4*) data, count,
                         slot.morphTargetOffset);
             }
             free(floatsData);
@@ -306,11 +355,15 @@ inline void uploadBuffers(FFilamentAsset* asset, Engine& engine,
         }
 
         if (accessor->type == cgltf_type_vec3) {
+            record(AssetSnapshot::BlobKind::MORPH_POSITIONS, slot.morphTargetCount,
+                    data, slot.morphTargetCount * sizeof(float3));
             slot.morphTargetBuffer->setPositionsAt(engine, slot.bufferIndex, (const float3*) data,
                     slot.morphTargetCount,
                     slot.morphTargetOffset);
         } else {
             assert_invariant(accessor->type == cgltf_type_vec4);
+            record(AssetSnapshot::BlobKind::MORPH_POSITIONS, slot.morphTargetCount,
+                    data, slot.morphTargetCount * sizeof(float4));
             slot.morphTargetBuffer->setPositionsAt(engine, slot.bufferIndex, (const float4*) data,
                     slot.morphTargetCount,
                     slot.morphTargetOffset);
@@ -318,6 +371,32 @@ inline void uploadBuffers(FFilamentAsset* asset, Engine& engine,
     }
 }
 
+// Signature of the parsed structure that snapshot blobs are recorded against. The blobs are
+// consumed positionally, so any structural change to the source asset must change this value.
+uint64_t computeSnapshotSignature(FFilamentAsset const* asset, bool normalizeWeights) noexcept {
+    auto const& slots = std::get<FFilamentAsset::ResourceInfo>(asset->mResourceInfo).mBufferSlots;
+    cgltf_data const* gltf = asset->mSourceAsset->hierarchy;
+    std::vector<uint32_t> words;
+    words.reserve(slots.size() * 4 + gltf->skins_count + 2);
+    words.push_back((uint32_t) slots.size() << 1 | (normalizeWeights ? 1u : 0u));
+    for (auto const& slot : slots) {
+        const cgltf_accessor* accessor = slot.accessor;
+        words.push_back((uint32_t) accessor->count);
+        words.push_back((uint32_t) accessor->component_type << 16 | (uint32_t) accessor->type);
+        words.push_back((uint32_t) slot.bufferIndex << 8
+                | (slot.vertexBuffer ? 1u : 0u)
+                | (slot.indexBuffer ? 2u : 0u)
+                | (slot.morphTargetBuffer ? 4u : 0u));
+        words.push_back(slot.morphTargetOffset << 16 | slot.morphTargetCount);
+    }
+    words.push_back((uint32_t) gltf->skins_count);
+    for (cgltf_size i = 0; i < gltf->skins_count; i++) {
+        words.push_back((uint32_t) gltf->skins[i].joints_count);
+    }
+    uint32_t const hash = utils::hash::murmur3(words.data(), words.size(), 42);
+    return (uint64_t) words.size() << 32 | hash;
+}
+
 } // anonymous namespace
 
 ResourceLoader::ResourceLoader(const ResourceConfiguration& config) : pImpl(new Impl(config)) { }
@@ -329,6 +408,7 @@ ResourceLoader::~ResourceLoader() {
 void ResourceLoader::setConfiguration(const ResourceConfiguration& config) {
     pImpl->mNormalizeSkinningWeights = config.normalizeSkinningWeights;
     pImpl->mGltfPath = config.gltfPath;
+    pImpl->mSnapshotPath = config.snapshotPath ? config.snapshotPath : "";
 }
 
 void ResourceLoader::addResourceData(const char* uri, BufferDescriptor&& buffer) {
@@ -427,28 +507,79 @@ bool ResourceLoader::loadResources(FFilamentAsset* asset, bool async) {
 
     cgltf_data const* gltf = asset->mSourceAsset->hierarchy;
 
+    AssetSnapshot* snapshot = nullptr;
+    bool restored = false;
+    bool weightsNormalized = false;
+
     if (!isExtendedAlgo) {
         utility::loadCgltfBuffers(gltf, pImpl->mGltfPath.c_str(), pImpl->mUriDataCache);
 
-        // Decompress Draco meshes early on, which allows us to exploit subsequent processing such
-        // as tangent generation.
-        DracoCache* dracoCache = &asset->mSourceAsset->dracoCache;
-        auto& primitives = std::get<FFilamentAsset::ResourceInfo>(asset->mResourceInfo).mPrimitives;
-        // Go through every primitive and check if it has a Draco mesh.
-        for (auto& [prim, vertexBuffer]: primitives) {
-            if (!prim->has_draco_mesh_compression) {
-                continue;
+        // If a snapshot of the cooked resources exists and still matches the asset, restore
+        // the buffers from it with bulk uploads and skip decompression, attribute conversion
+        // and tangent generation entirely. Shadow proxies need source position data, so they
+        // force the full path. A failed restore falls through to a full cook, which re-records
+        // the snapshot.
+        snapshot = pImpl->getSnapshot();
+        if (snapshot && asset->mShadowProxyRequests.empty()) {
+            uint64_t const signature = computeSnapshotSignature(asset,
+                    pImpl->mNormalizeSkinningWeights);
+            if (snapshot->load(signature)) {
+                restored = pImpl->restoreCookedResources(asset, *snapshot);
+            }
+            if (!restored) {
+                snapshot->beginRecording(signature);
             }
-            utility::decodeDracoMeshes(gltf, prim, dracoCache);
         }
-        utility::decodeMeshoptCompression((cgltf_data*) gltf);
 
-        uploadBuffers(asset, *pImpl->mEngine, pImpl->mUriDataCache);
+        if (!restored) {
+            // Decompress Draco meshes early on, which allows us to exploit subsequent
+            // processing such as tangent generation.
+            DracoCache* dracoCache = &asset->mSourceAsset->dracoCache;
+            auto& primitives =
+                    std::get<FFilamentAsset::ResourceInfo>(asset->mResourceInfo).mPrimitives;
+            // Decompress all Draco meshes concurrently over JobSystem workers; the per-primitive
+            // loop below then only performs attribute conversion against the cached results.
+            std::vector<const cgltf_buffer_view*> dracoViews;
+            for (auto& [prim, vertexBuffer]: primitives) {
+                if (prim->has_draco_mesh_compression) {
+                    dracoViews.push_back(prim->draco_mesh_compression.buffer_view);
+                }
+            }
+            if (!dracoViews.empty()) {
+                dracoCache->prefetch(dracoViews.data(), dracoViews.size(),
+                        pImpl->mEngine->getJobSystem());
+            }
+            // Go through every primitive and check if it has a Draco mesh.
+            for (auto& [prim, vertexBuffer]: primitives) {
+                if (!prim->has_draco_mesh_compression) {
+                    continue;
+                }
+                utility::decodeDracoMeshes(gltf, prim, dracoCache);
+            }
+            utility::decodeMeshoptCompression((cgltf_data*) gltf);
+
+            // When recording a snapshot, normalize skinning weights before the upload so the
+            // recorded blobs hold the normalized data; createSkins() then must not normalize
+            // them again.
+            if (snapshot && snapshot->isRecording() && pImpl->mNormalizeSkinningWeights) {
+                normalizeSkinningWeights(gltf);
+                weightsNormalized = true;
+            }
+
+            uploadBuffers(asset, *pImpl->mEngine, pImpl->mUriDataCache, snapshot);
 
-        // Compute surface orientation quaternions if necessary. This is similar to sparse data in
-        // that we need to generate the contents of a GPU buffer by processing one or more CPU
-        // buffer(s).
-        pImpl->computeTangents(asset);
+            // Compute surface orientation quaternions if necessary. This is similar to sparse
+            // data in that we need to generate the contents of a GPU buffer by processing one or
+            // more CPU buffer(s).
+            pImpl->computeTangents(asset, snapshot);
+
+            // Generate decimated shadow-proxy renderables if the asset was loaded with
+            // AssetConfiguration::generateShadowProxies. This must happen while the source
+            // position data is still around.
+            if (UTILS_UNLIKELY(!asset->mShadowProxyRequests.empty())) {
+                pImpl->generateShadowProxies(asset);
+            }
+        }
 
         std::get<FFilamentAsset::ResourceInfo>(asset->mResourceInfo).mBufferSlots.clear();
         std::get<FFilamentAsset::ResourceInfo>(asset->mResourceInfo).mPrimitives.clear();
@@ -457,7 +588,14 @@ bool ResourceLoader::loadResources(FFilamentAsset* asset, bool async) {
         ResourceLoaderExtended::loadResources(slots, pImpl->mEngine, asset->mBufferObjects);
     }
 
-    createSkins(gltf, pImpl->mNormalizeSkinningWeights, asset->mSkins);
+    if (!restored) {
+        // restoreCookedResources() rebuilt the skins from the snapshot already.
+        createSkins(gltf, pImpl->mNormalizeSkinningWeights && !weightsNormalized, asset->mSkins,
+                snapshot);
+    }
+    if (snapshot) {
+        snapshot->finishRecording();
+    }
 
     // If any decoding jobs are still underway from a previous load, wait for them to finish.
     for (const auto& iter: pImpl->mTextureProviders) {
@@ -673,9 +811,10 @@ void ResourceLoader::Impl::createTextures(FFilamentAsset* asset, bool async) {
     }
 }
 
-void ResourceLoader::Impl::computeTangents(FFilamentAsset* asset) {
-    SYSTRACE_CALL();
-
+// Builds the list of tangent-generation jobs for the asset. This only walks the parsed
+// structures, so it is also used by the snapshot restore path to route recorded tangent
+// frames to their destinations without running the jobs.
+static std::vector<TangentsJob::Params> collectTangentJobs(FFilamentAsset* asset) {
     const cgltf_accessor* kGenerateTangents = &asset->mGenerateTangents;
     const cgltf_accessor* kGenerateNormals = &asset->mGenerateNormals;
 
@@ -736,19 +875,44 @@ void ResourceLoader::Impl::computeTangents(FFilamentAsset* asset) {
             }
         }
     }
+    return jobParams;
+}
+
+void ResourceLoader::Impl::computeTangents(FFilamentAsset* asset, AssetSnapshot* snapshot) {
+    SYSTRACE_CALL();
 
-    // Kick off jobs for computing tangent frames.
+    using Params = TangentsJob::Params;
+    std::vector<Params> jobParams = collectTangentJobs(asset);
+
+    // Kick off jobs for computing tangent frames. Each job additionally splits its own
+    // per-vertex work over the workers, so a single huge primitive doesn't serialize on
+    // one thread.
     JobSystem* js = &mEngine->getJobSystem();
     JobSystem::Job* parent = js->createJob();
     for (Params& params : jobParams) {
         Params* pptr = &params;
-        js->run(jobs::createJob(*js, parent, [pptr] { TangentsJob::run(pptr); }));
+        pptr->in.jobSystem = js;
+        // Cooperative: a tangent job that hasn't started yet steps aside while frame
+        // preparation is in flight, rather than competing with it for workers.
+        js->run(js->createCooperativeJob(parent,
+                [pptr](JobSystem& js, JobSystem::Job*) -> bool {
+            if (UTILS_UNLIKELY(js.shouldYield())) {
+                return false;
+            }
+            TangentsJob::run(pptr);
+            return true;
+        }));
     }
     js->runAndWait(parent);
 
     // Finally, upload quaternions to the GPU from the main thread.
     for (Params& params : jobParams) {
         if (params.context.vb) {
+            if (snapshot && snapshot->isRecording()) {
+                snapshot->record(AssetSnapshot::BlobKind::TANGENTS_VERTEX,
+                        params.out.vertexCount, params.out.results,
+                        params.out.vertexCount * sizeof(short4));
+            }
             BufferObject* bo = BufferObject::Builder()
                     .size(params.out.vertexCount * sizeof(short4)).build(*mEngine);
             asset->mBufferObjects.push_back(bo);
@@ -757,6 +921,11 @@ void ResourceLoader::Impl::computeTangents(FFilamentAsset* asset) {
             params.context.vb->setBufferObjectAt(*mEngine, params.context.slot, bo);
         } else {
             assert_invariant(params.context.tb);
+            if (snapshot && snapshot->isRecording()) {
+                snapshot->record(AssetSnapshot::BlobKind::TANGENTS_MORPH,
+                        params.out.vertexCount, params.out.results,
+                        params.out.vertexCount * sizeof(short4));
+            }
             params.context.tb->setTangentsAt(*mEngine, params.in.morphTargetIndex,
                     params.out.results, params.out.vertexCount, params.context.offset);
             free(params.out.results);
@@ -764,6 +933,299 @@ void ResourceLoader::Impl::computeTangents(FFilamentAsset* asset) {
     }
 }
 
+bool ResourceLoader::Impl::restoreCookedResources(FFilamentAsset* asset,
+        AssetSnapshot& snapshot) {
+    SYSTRACE_CALL();
+
+    auto& slots = std::get<FFilamentAsset::ResourceInfo>(asset->mResourceInfo).mBufferSlots;
+    std::vector<TangentsJob::Params> const tangentJobs = collectTangentJobs(asset);
+    cgltf_data const* gltf = asset->mSourceAsset->hierarchy;
+    size_t const blobCount = snapshot.getBlobCount();
+
+    auto const isSlotKind = [](AssetSnapshot::BlobKind kind) {
+        switch (kind) {
+            case AssetSnapshot::BlobKind::BUFFER_OBJECT:
+            case AssetSnapshot::BlobKind::BUFFER_OBJECT_CONVERTED:
+            case AssetSnapshot::BlobKind::INDEX:
+            case AssetSnapshot::BlobKind::INDEX_FROM_BYTES:
+            case AssetSnapshot::BlobKind::MORPH_POSITIONS:
+                return true;
+            default:
+                return false;
+        }
+    };
+
+    // Buffer-slot blobs carry the slot index they were cooked from, so the walk doesn't
+    // depend on which accessors have buffer views at restore time -- Draco accessors only
+    // get one when the decode runs, which the restore skips. The signature check makes a
+    // mismatch very unlikely, but validate the whole snapshot before uploading anything so
+    // that bailing out never leaves orphaned BufferObjects behind.
+    size_t next = 0;
+    while (next < blobCount && isSlotKind(snapshot.getBlob(next).kind)) {
+        AssetSnapshot::Blob const& blob = snapshot.getBlob(next++);
+        if (blob.slot >= slots.size()) {
+            return false;
+        }
+        auto const& slot = slots[blob.slot];
+        switch (blob.kind) {
+            case AssetSnapshot::BlobKind::BUFFER_OBJECT:
+            case AssetSnapshot::BlobKind::BUFFER_OBJECT_CONVERTED:
+                if (!slot.vertexBuffer) {
+                    return false;
+                }
+                break;
+            case AssetSnapshot::BlobKind::INDEX:
+            case AssetSnapshot::BlobKind::INDEX_FROM_BYTES:
+                if (!slot.indexBuffer) {
+                    return false;
+                }
+                break;
+            default:
+                if (!slot.morphTargetBuffer || (blob.size != blob.count * sizeof(float4)
+                        && blob.size != blob.count * sizeof(float3))) {
+                    return false;
+                }
+                // a corrupted count would trip the fatal precondition in setPositionsAt()
+                if (size_t(blob.count) + slot.morphTargetOffset >
+                        slot.morphTargetBuffer->getVertexCount()) {
+                    return false;
+                }
+                break;
+        }
+    }
+    size_t const slotBlobCount = next;
+    for (auto const& params: tangentJobs) {
+        if (next >= blobCount) {
+            return false;
+        }
+        AssetSnapshot::Blob const& blob = snapshot.getBlob(next++);
+        // A corrupted count or size would otherwise read out of bounds, or trip the fatal
+        // precondition in setTangentsAt() instead of falling back to a full cook.
+        if (blob.size != blob.count * sizeof(short4)) {
+            return false;
+        }
+        if (params.context.vb) {
+            if (blob.kind != AssetSnapshot::BlobKind::TANGENTS_VERTEX
+                    || blob.count != params.context.vb->getVertexCount()) {
+                return false;
+            }
+        } else {
+            if (blob.kind != AssetSnapshot::BlobKind::TANGENTS_MORPH
+                    || size_t(blob.count) + params.context.offset >
+                            params.context.tb->getVertexCount()) {
+                return false;
+            }
+        }
+    }
+    for (cgltf_size i = 0, len = gltf->skins_count; i < len; ++i) {
+        if (next >= blobCount) {
+            return false;
+        }
+        AssetSnapshot::Blob const& blob = snapshot.getBlob(next++);
+        if (blob.kind != AssetSnapshot::BlobKind::SKIN_MATRICES
+                || blob.count != gltf->skins[i].joints_count
+                || blob.size != blob.count * sizeof(mat4f)) {
+            return false;
+        }
+    }
+    if (next != blobCount) {
+        return false;
+    }
+
+    // Everything lines up; consume the blobs in the same order.
+    Engine& engine = *mEngine;
+    next = 0;
+    while (next < slotBlobCount) {
+        AssetSnapshot::Blob const& blob = snapshot.getBlob(next++);
+        auto const& slot = slots[blob.slot];
+        switch (blob.kind) {
+            case AssetSnapshot::BlobKind::BUFFER_OBJECT:
+            case AssetSnapshot::BlobKind::BUFFER_OBJECT_CONVERTED: {
+                BufferObject* bo = BufferObject::Builder().size(blob.size).build(engine);
+                asset->mBufferObjects.push_back(bo);
+                bo->setBuffer(engine, BufferDescriptor(blob.data, blob.size,
+                        AssetSnapshot::releaseCallback, snapshot.acquirePayload()));
+                slot.vertexBuffer->setBufferObjectAt(engine, slot.bufferIndex, bo);
+                break;
+            }
+            case AssetSnapshot::BlobKind::INDEX:
+            case AssetSnapshot::BlobKind::INDEX_FROM_BYTES: {
+                slot.indexBuffer->setBuffer(engine, IndexBuffer::BufferDescriptor(
+                        blob.data, blob.size,
+                        AssetSnapshot::releaseCallback, snapshot.acquirePayload()));
+                break;
+            }
+            default: {
+                // the element size tells packed float3 data apart from float4 data
+                if (blob.size == blob.count * sizeof(float4)) {
+                    slot.morphTargetBuffer->setPositionsAt(engine, slot.bufferIndex,
+                            (const float4*) blob.data, blob.count, slot.morphTargetOffset);
+                } else {
+                    slot.morphTargetBuffer->setPositionsAt(engine, slot.bufferIndex,
+                            (const float3*) blob.data, blob.count, slot.morphTargetOffset);
+                }
+                break;
+            }
+        }
+    }
+
+    // Recorded tangent frames, in the same order collectTangentJobs() produces them.
+    for (auto const& params: tangentJobs) {
+        AssetSnapshot::Blob const& blob = snapshot.getBlob(next++);
+        if (params.context.vb) {
+            BufferObject* bo = BufferObject::Builder().size(blob.size).build(engine);
+            asset->mBufferObjects.push_back(bo);
+            bo->setBuffer(engine, BufferDescriptor(blob.data, blob.size,
+                    AssetSnapshot::releaseCallback, snapshot.acquirePayload()));
+            params.context.vb->setBufferObjectAt(engine, params.context.slot, bo);
+        } else {
+            params.context.tb->setTangentsAt(engine, params.in.morphTargetIndex,
+                    (const short4*) blob.data, blob.count, params.context.offset);
+        }
+    }
+
+    // Finally the skins; names come from the source, matrices from the snapshot.
+    if (gltf->skins_count > 0) {
+        asset->mSkins.reserve(gltf->skins_count);
+        for (cgltf_size i = 0, len = gltf->skins_count; i < len; ++i) {
+            const cgltf_skin& srcSkin = gltf->skins[i];
+            AssetSnapshot::Blob const& blob = snapshot.getBlob(next++);
+            FixedCapacityVector<mat4f> inverseBindMatrices(srcSkin.joints_count);
+            memcpy((uint8_t*) inverseBindMatrices.data(), blob.data,
+                    srcSkin.joints_count * sizeof(mat4f));
+            asset->mSkins.emplace_back(FFilamentAsset::Skin{
+                    .name = srcSkin.name ? CString(srcSkin.name) : CString(),
+                    .inverseBindMatrices = std::move(inverseBindMatrices),
+            });
+        }
+    }
+
+    return true;
+}
+
+void ResourceLoader::Impl::generateShadowProxies(FFilamentAsset* asset) {
+    SYSTRACE_CALL();
+
+    // below this many vertices a proxy isn't worth its extra draw call
+    constexpr size_t MIN_VERTEX_COUNT = 4096;
+    // four levels at ~1/3 reduction each bottom out at a few percent of the source mesh
+    constexpr size_t PROXY_LOD_COUNT = 4;
+    constexpr float PROXY_REDUCTION_FACTOR = 0.35f;
+
+    Engine& engine = *mEngine;
+    RenderableManager& rcm = engine.getRenderableManager();
+    TransformManager& tcm = engine.getTransformManager();
+    cgltf_data const* gltf = asset->mSourceAsset->hierarchy;
+
+    for (auto const& request : asset->mShadowProxyRequests) {
+        auto const ri = rcm.getInstance(request.renderable);
+        if (!ri) {
+            continue;
+        }
+        const cgltf_mesh* mesh = request.mesh;
+        FixedCapacityVector<Primitive> const& prims = asset->mMeshCache[mesh - gltf->meshes];
+
+        size_t totalVertexCount = 0;
+        for (cgltf_size pi = 0, pc = mesh->primitives_count; pi < pc; ++pi) {
+            for (cgltf_size ai = 0; ai < mesh->primitives[pi].attributes_count; ++ai) {
+                if (mesh->primitives[pi].attributes[ai].type == cgltf_attribute_type_position) {
+                    totalVertexCount += mesh->primitives[pi].attributes[ai].data->count;
+                    break;
+                }
+            }
+        }
+        if (totalVertexCount < MIN_VERTEX_COUNT) {
+            continue;
+        }
+
+        // Decimate each triangle primitive into an index buffer over the original vertex
+        // data; the proxy shares the source VertexBuffer, so no vertex data is duplicated.
+        struct ProxyPrimitive {
+            VertexBuffer* vertices;
+            IndexBuffer* indices;
+            size_t sourceIndex;
+        };
+        std::vector<ProxyPrimitive> proxyPrims;
+        for (cgltf_size pi = 0, pc = mesh->primitives_count; pi < pc; ++pi) {
+            const cgltf_primitive& prim = mesh->primitives[pi];
+            if (prim.type != cgltf_primitive_type_triangles || !prim.indices) {
+                continue;
+            }
+            const cgltf_accessor* positions = nullptr;
+            for (cgltf_size ai = 0; ai < prim.attributes_count; ++ai) {
+                if (prim.attributes[ai].type == cgltf_attribute_type_position) {
+                    positions = prim.attributes[ai].data;
+                    break;
+                }
+            }
+            if (!positions || positions->count == 0) {
+                continue;
+            }
+
+            std::vector<float3> positionData(positions->count);
+            cgltf_accessor_unpack_floats(positions, &positionData[0].x, positions->count * 3);
+
+            size_t const triangleCount = prim.indices->count / 3;
+            std::vector<uint32_t> indexData(triangleCount * 3);
+            for (size_t j = 0, jc = indexData.size(); j < jc; ++j) {
+                indexData[j] = uint32_t(cgltf_accessor_read_index(prim.indices, j));
+            }
+
+            std::unique_ptr<geometry::LodChain> chain{ geometry::LodChain::Builder()
+                    .positions(positionData.data())
+                    .vertexCount(positionData.size())
+                    .triangles((math::uint3 const*) indexData.data())
+                    .triangleCount(triangleCount)
+                    .lodCount(PROXY_LOD_COUNT)
+                    .reductionFactor(PROXY_REDUCTION_FACTOR)
+                    .build() };
+            if (!chain || chain->getLodCount() < 2) {
+                // the primitive couldn't be simplified, keep it shadowing as-is
+                continue;
+            }
+
+            size_t const lod = chain->getLodCount() - 1;
+            size_t const indexCount = chain->getIndexCount(lod);
+            IndexBuffer* indices = IndexBuffer::Builder()
+                    .indexCount(uint32_t(indexCount))
+                    .bufferType(IndexBuffer::IndexType::UINT)
+                    .build(engine);
+            size_t const sizeInBytes = indexCount * sizeof(uint32_t);
+            uint32_t* data = (uint32_t*) malloc(sizeInBytes);
+            memcpy(data, chain->getIndices(lod), sizeInBytes);
+            indices->setBuffer(engine, IndexBuffer::BufferDescriptor(
+                    data, sizeInBytes, FREE_CALLBACK));
+            asset->mIndexBuffers.push_back(indices);
+            proxyPrims.push_back({ prims[pi].vertices, indices, pi });
+        }
+        if (proxyPrims.empty()) {
+            continue;
+        }
+
+        // The proxy casts the shadow in the detailed renderable's place. It inherits the
+        // node's transform and the detailed renderable's bounds and materials (only their
+        // depth variants are ever used).
+        Entity const proxy = asset->mEntityManager->create();
+        RenderableManager::Builder builder(proxyPrims.size());
+        for (size_t i = 0, c = proxyPrims.size(); i < c; ++i) {
+            builder.geometry(i, RenderableManager::PrimitiveType::TRIANGLES,
+                    proxyPrims[i].vertices, proxyPrims[i].indices);
+            builder.material(i, rcm.getMaterialInstanceAt(ri, proxyPrims[i].sourceIndex));
+        }
+        builder
+            .boundingBox(rcm.getAxisAlignedBoundingBox(ri))
+            .culling(true)
+            .castShadows(true)
+            .receiveShadows(false)
+            .shadowOnly(true)
+            .build(engine, proxy);
+        tcm.create(proxy, tcm.getInstance(request.renderable));
+        rcm.setCastShadows(ri, false);
+        asset->mEntities.push_back(proxy);
+    }
+    asset->mShadowProxyRequests.clear();
+}
+
 ResourceLoader::Impl::~Impl() {
     for (const auto& iter : mTextureProviders) {
         iter.second->cancelDecoding();
@@ -125,7 +125,7 @@ Texture* StbProvider::pushTexture(const uint8_t* data, size_t byteCount,
         return texture;
     }
 
-    JobSystem* js = &mEngine->getJobSystem();
+    JobSystem* js = &mEngine->getBackgroundJobSystem();
     info->decoderJob = jobs::createJob(*js, mDecoderRootJob, [info] {
         auto& source = info->sourceBuffer;
         int width, height, comp;
@@ -168,7 +168,7 @@ void StbProvider::updateQueue() {
     if (!UTILS_HAS_THREADING) {
         decodeSingleTexture();
     }
-    JobSystem* js = &mEngine->getJobSystem();
+    JobSystem* js = &mEngine->getBackgroundJobSystem();
     for (auto& info : mTextures) {
         if (info->state != TextureState::DECODING) {
             continue;
@@ -206,7 +206,7 @@ void StbProvider::updateQueue() {
 }
 
 void StbProvider::waitForCompletion() {
-    JobSystem& js = mEngine->getJobSystem();
+    JobSystem& js = mEngine->getBackgroundJobSystem();
     for (auto& info : mTextures) {
         if (info->decoderJob) {
             js.waitAndRelease(info->decoderJob);
@@ -262,17 +262,17 @@ void StbProvider::decodeSingleTexture() {
 }
 
 StbProvider::StbProvider(Engine* engine) : mEngine(engine) {
-    mDecoderRootJob = mEngine->getJobSystem().createJob();
+    mDecoderRootJob = mEngine->getBackgroundJobSystem().createJob();
 #ifndef NDEBUG
     slog.i << "Texture Decoder has "
-            << mEngine->getJobSystem().getThreadCount()
+            << mEngine->getBackgroundJobSystem().getThreadCount()
             << " background threads." << io::endl;
 #endif
 }
 
 StbProvider::~StbProvider() {
     cancelDecoding();
-    mEngine->getJobSystem().release(mDecoderRootJob);
+    mEngine->getBackgroundJobSystem().release(mDecoderRootJob);
 }
 
 TextureProvider* createStbProvider(Engine* engine) {
@@ -76,6 +76,7 @@ void TangentsJob::run(Params* params) {
 
     geometry::SurfaceOrientation::Builder sob;
     sob.vertexCount(vertexCount);
+    sob.jobSystem(params->in.jobSystem);
 
     // Allocate scratch space to store morph deltas.
     if (isMorphTarget) {
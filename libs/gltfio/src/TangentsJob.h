@@ -18,6 +18,10 @@
 
 #include <math/vec4.h>
 
+namespace utils {
+class JobSystem;
+}
+
 namespace filament {
 
 class VertexBuffer;
@@ -40,6 +44,10 @@ struct TangentsJob {
     struct InputParams {
         const cgltf_primitive* prim;
         const int morphTargetIndex = kMorphTargetUnused;
+
+        // Optional JobSystem used to parallelize per-vertex work within this primitive. This is
+        // safe to set even when run() itself executes inside a job of the same JobSystem.
+        utils::JobSystem* jobSystem = nullptr;
     };
 
     // The context of the procedure. These fields are not used by the procedure but are provided as
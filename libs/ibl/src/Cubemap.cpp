@@ -16,6 +16,8 @@
 
 #include <ibl/Cubemap.h>
 
+#include <math/vec4.h>
+
 using namespace filament::math;
 
 namespace filament {
@@ -179,13 +181,14 @@ Cubemap::Texel Cubemap::filterAt(const Image& image, float x, float y) {
 
     const float u = float(x - x0);
     const float v = float(y - y0);
-    const float one_minus_u = 1 - u;
-    const float one_minus_v = 1 - v;
+    // the four bilinear weights computed as a single float4 product, which the compiler can
+    // keep in one SIMD register across the weighted sum below
+    const float4 w = float4{ 1 - u, u, 1 - u, u } * float4{ 1 - v, 1 - v, v, v };
     const Texel& c0 = sampleAt(image.getPixelRef(x0, y0));
     const Texel& c1 = sampleAt(image.getPixelRef(x1, y0));
     const Texel& c2 = sampleAt(image.getPixelRef(x0, y1));
     const Texel& c3 = sampleAt(image.getPixelRef(x1, y1));
-    return (one_minus_u*one_minus_v)*c0 + (u*one_minus_v)*c1 + (one_minus_u*v)*c2 + (u*v)*c3;
+    return w[0]*c0 + w[1]*c1 + w[2]*c2 + w[3]*c3;
 }
 
 Cubemap::Texel Cubemap::filterAtCenter(const Image& image, size_t x0, size_t y0) {
@@ -416,18 +416,17 @@ void CubemapIBL::roughnessFilter(
     });
 
 
-    struct State {
-        // maybe blue-noise instead would look even better
-        std::default_random_engine gen;
-        std::uniform_real_distribution<float> distribution{ -F_PI, F_PI };
-    };
-
-    auto scanline = [&](State& state, size_t y,
+    auto scanline = [&](CubemapUtils::EmptyState&, size_t y,
             Cubemap::Face f, Cubemap::Texel* data, size_t dim) {
         if (UTILS_UNLIKELY(updater)) {
             size_t p = progress.fetch_add(1, std::memory_order_relaxed) + 1;
             updater(0, (float) p / ((float) dim * 6.0f), userdata);
         }
+        // The generator is seeded per scanline so the proc is stateless, which lets process()
+        // tile each face into parallel_for blocks instead of running one thread per face.
+        // maybe blue-noise instead would look even better
+        std::default_random_engine gen(uint32_t(size_t(f) * dim + y));
+        std::uniform_real_distribution<float> distribution{ -F_PI, F_PI };
         mat3 R;
         const size_t numSamples = cache.size();
         for (size_t x = 0; x < dim; ++x, ++data) {
@@ -440,7 +439,7 @@ void CubemapIBL::roughnessFilter(
             R[1] = cross(N, R[0]);
             R[2] = N;
 
-            R *= mat3f::rotation(state.distribution(state.gen), float3{0,0,1});
+            R *= mat3f::rotation(distribution(gen), float3{0,0,1});
 
             float3 Li = 0;
             for (size_t sample = 0; sample < numSamples; sample++) {
@@ -458,9 +457,9 @@ void CubemapIBL::roughnessFilter(
     // don't use the jobsystem unless we have enough work per scanline -- or the overhead of
     // launching jobs will prevail.
     if (dst.getDimensions() * maxNumSamples <= 256) {
-        CubemapUtils::processSingleThreaded<State>(dst, js, std::ref(scanline));
+        CubemapUtils::processSingleThreaded<CubemapUtils::EmptyState>(dst, js, std::ref(scanline));
     } else {
-        CubemapUtils::process<State>(dst, js, std::ref(scanline));
+        CubemapUtils::process<CubemapUtils::EmptyState>(dst, js, std::ref(scanline));
     }
 }
 
@@ -22,6 +22,8 @@
 
 #include <filament/Texture.h>
 
+#include <math/vec3.h>
+
 namespace filament {
 class Engine;
 class View;
@@ -33,6 +35,7 @@ class VertexBuffer;
 class IndexBuffer;
 class Camera;
 class Texture;
+class RenderTarget;
 } // namespace filament
 
 /**
@@ -333,6 +336,95 @@ public:
         uint8_t mLevelCount = 1u;
     };
 
+    /**
+     * ShGenerator computes the 3-band spherical harmonics coefficients of an environment
+     * cubemap entirely on the GPU. The coefficients are convolved by the truncated cos(theta)
+     * and pre-scaled by the reconstruction factors, i.e. they're in the format expected by
+     * IndirectLight::Builder::irradiance(uint8_t, float3 const*).
+     *
+     * The result is delivered asynchronously via a callback invoked on the main thread once
+     * the GPU is done, so computing the coefficients never stalls the rendering pipeline.
+     */
+    class ShGenerator {
+    public:
+
+        /**
+         * Generator configuration.
+         */
+        struct Config {
+            uint16_t sampleDim = 16u;    //!< per-face sample grid dimension (a power-of-two)
+        };
+
+        /**
+         * Generation options for the current environment.
+         */
+        struct Options {
+            bool generateMipmap = true;  //!< set to false if the input environment map already has mipmaps
+        };
+
+        /**
+         * Callback invoked on the main thread when the coefficients are available.
+         * @param sh    array of 9 x float3 coefficients, suitable for
+         *              IndirectLight::Builder::irradiance(3, sh)
+         * @param user  user pointer given to operator()
+         */
+        using Callback = void(*)(filament::math::float3 const* sh, void* user);
+
+        /**
+         * Creates a ShGenerator processor.
+         * @param context IBLPrefilterContext to use
+         * @param config  Configuration of the generator
+         */
+        ShGenerator(IBLPrefilterContext& context, Config config);
+
+        /**
+         * Creates a generator with the default configuration.
+         * @param context IBLPrefilterContext to use
+         */
+        explicit ShGenerator(IBLPrefilterContext& context);
+
+        /**
+         * Destroys all GPU resources created during initialization.
+         */
+        ~ShGenerator() noexcept;
+
+        ShGenerator(ShGenerator const&) = delete;
+        ShGenerator& operator=(ShGenerator const&) = delete;
+        ShGenerator(ShGenerator&& rhs) noexcept;
+        ShGenerator& operator=(ShGenerator&& rhs) noexcept;
+
+        /**
+         * Computes the spherical harmonics coefficients of an environment cubemap.
+         * @param options                   Options for this environment
+         * @param environmentCubemap        Environment cubemap (input). Can't be null.
+         *                                  This cubemap must be SAMPLEABLE and must have all its
+         *                                  levels allocated. If Options.generateMipmap is true,
+         *                                  the mipmap levels will be overwritten, otherwise
+         *                                  it is assumed that all levels are correctly initialized.
+         * @param callback                  Called on the main thread when the coefficients are
+         *                                  ready, typically a few frames later. Can't be null.
+         * @param user                      User pointer passed back to the callback.
+         */
+        void operator()(Options options,
+                filament::Texture const* environmentCubemap,
+                Callback callback, void* user = nullptr);
+
+        /**
+         * Computes the spherical harmonics coefficients of an environment cubemap with the
+         * default options.
+         */
+        void operator()(
+                filament::Texture const* environmentCubemap,
+                Callback callback, void* user = nullptr);
+
+    private:
+        IBLPrefilterContext& mContext;
+        filament::Material* mShMaterial = nullptr;
+        filament::Texture* mShTexture = nullptr;
+        filament::RenderTarget* mRenderTarget = nullptr;
+        uint16_t mSampleDim = 16u;
+    };
+
 private:
     friend class Filter;
     filament::Engine& mEngine;
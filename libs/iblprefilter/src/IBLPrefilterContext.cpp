@@ -43,6 +43,7 @@
 #include <algorithm>
 #include <cmath>
 #include <utility>
+#include <vector>
 
 #include <stddef.h>
 #include <stdint.h>
@@ -672,6 +673,23 @@ Texture* IBLPrefilterContext::SpecularFilter::operator()(
            .texture(RenderTarget::AttachmentPoint::COLOR1, outReflectionsTexture)
            .texture(RenderTarget::AttachmentPoint::COLOR2, outReflectionsTexture);
 
+    // Create every render target up front so that resource creation and destruction don't
+    // interleave with the pass stream below; all mip levels are then issued back-to-back and
+    // nothing reads results back, so the backend can pipeline the whole filter without bubbles.
+    std::vector<RenderTarget*> renderTargets;
+    renderTargets.reserve(2 * size_t(levels));
+    for (size_t lod = 0; lod < levels; lod++) {
+        builder.mipLevel(RenderTarget::AttachmentPoint::COLOR0, lod)
+               .mipLevel(RenderTarget::AttachmentPoint::COLOR1, lod)
+               .mipLevel(RenderTarget::AttachmentPoint::COLOR2, lod);
+        for (size_t i = 0; i < 2; i++) {
+            builder.face(RenderTarget::AttachmentPoint::COLOR0, faces[i][0])
+                   .face(RenderTarget::AttachmentPoint::COLOR1, faces[i][1])
+                   .face(RenderTarget::AttachmentPoint::COLOR2, faces[i][2]);
+            renderTargets.push_back(builder.build(engine));
+        }
+    }
+
     for (size_t lod = 0; lod < levels; lod++) {
         SYSTRACE_NAME("executeFilterLOD");
 
@@ -685,29 +703,165 @@ Texture* IBLPrefilterContext::SpecularFilter::operator()(
             mi->setParameter("lodOffset", std::max(2.0f, options.lodOffset) - log4(omegaP));
         }
 
-        builder.mipLevel(RenderTarget::AttachmentPoint::COLOR0, lod)
-               .mipLevel(RenderTarget::AttachmentPoint::COLOR1, lod)
-               .mipLevel(RenderTarget::AttachmentPoint::COLOR2, lod);
-
         view->setViewport({ 0, 0, dim, dim });
 
         for (size_t i = 0; i < 2; i++) {
             mi->setParameter("side", i == 0 ? 1.0f : -1.0f);
-
-            builder.face(RenderTarget::AttachmentPoint::COLOR0, faces[i][0])
-                   .face(RenderTarget::AttachmentPoint::COLOR1, faces[i][1])
-                   .face(RenderTarget::AttachmentPoint::COLOR2, faces[i][2]);
-
-            RenderTarget* const rt = builder.build(engine);
-            view->setRenderTarget(rt);
+            view->setRenderTarget(renderTargets[lod * 2 + i]);
             renderer->renderStandaloneView(view);
-            engine.destroy(rt);
         }
 
         dim >>= 1;
     }
 
+    for (RenderTarget* const rt : renderTargets) {
+        engine.destroy(rt);
+    }
     engine.destroy(mi);
 
     return outReflectionsTexture;
 }
+
+// ------------------------------------------------------------------------------------------------
+
+IBLPrefilterContext::ShGenerator::ShGenerator(IBLPrefilterContext& context, Config config)
+        : mContext(context),
+          mSampleDim(std::max(config.sampleDim, uint16_t(4u))) {
+
+    SYSTRACE_CALL();
+    using namespace backend;
+
+    Engine& engine = mContext.mEngine;
+
+    mShMaterial = Material::Builder().package(
+            IBLPREFILTER_MATERIALS_SHINTEGRATION_DATA,
+            IBLPREFILTER_MATERIALS_SHINTEGRATION_SIZE).build(engine);
+
+    // one column per SH coefficient. BLIT_SRC is needed for the read-back.
+    mShTexture = Texture::Builder()
+            .sampler(Texture::Sampler::SAMPLER_2D)
+            .format(Texture::InternalFormat::RGBA32F)
+            .usage(Texture::Usage::COLOR_ATTACHMENT | Texture::Usage::BLIT_SRC)
+            .width(9)
+            .height(1)
+            .build(engine);
+
+    mRenderTarget = RenderTarget::Builder()
+            .texture(RenderTarget::AttachmentPoint::COLOR0, mShTexture)
+            .build(engine);
+}
+
+UTILS_NOINLINE
+IBLPrefilterContext::ShGenerator::ShGenerator(IBLPrefilterContext& context)
+        : ShGenerator(context, {}) {
+}
+
+IBLPrefilterContext::ShGenerator::~ShGenerator() noexcept {
+    Engine& engine = mContext.mEngine;
+    engine.destroy(mRenderTarget);
+    engine.destroy(mShTexture);
+    engine.destroy(mShMaterial);
+}
+
+IBLPrefilterContext::ShGenerator::ShGenerator(ShGenerator&& rhs) noexcept
+        : mContext(rhs.mContext) {
+    this->operator=(std::move(rhs));
+}
+
+IBLPrefilterContext::ShGenerator&
+IBLPrefilterContext::ShGenerator::operator=(ShGenerator&& rhs) noexcept {
+    using std::swap;
+    if (this != & rhs) {
+        swap(mShMaterial, rhs.mShMaterial);
+        swap(mShTexture, rhs.mShTexture);
+        swap(mRenderTarget, rhs.mRenderTarget);
+        mSampleDim = rhs.mSampleDim;
+    }
+    return *this;
+}
+
+void IBLPrefilterContext::ShGenerator::operator()(
+        IBLPrefilterContext::ShGenerator::Options options,
+        Texture const* environmentCubemap, Callback callback, void* user) {
+
+    SYSTRACE_CALL();
+    using namespace backend;
+
+    FILAMENT_CHECK_PRECONDITION(environmentCubemap != nullptr) << "environmentCubemap is null!";
+
+    FILAMENT_CHECK_PRECONDITION(
+            environmentCubemap->getTarget() == Texture::Sampler::SAMPLER_CUBEMAP)
+            << "environmentCubemap must be a cubemap.";
+
+    UTILS_UNUSED_IN_RELEASE
+    const uint8_t maxLevelCount = uint8_t(std::log2(environmentCubemap->getWidth()) + 0.5f) + 1u;
+
+    FILAMENT_CHECK_PRECONDITION(environmentCubemap->getLevels() == maxLevelCount)
+            << "environmentCubemap must have " << +maxLevelCount << " mipmap levels allocated.";
+
+    FILAMENT_CHECK_PRECONDITION(callback != nullptr) << "callback is null!";
+
+    Engine& engine = mContext.mEngine;
+    View* const view = mContext.mView;
+    Renderer* const renderer = mContext.mRenderer;
+    MaterialInstance* const mi = mShMaterial->createInstance();
+
+    RenderableManager& rcm = engine.getRenderableManager();
+    rcm.setMaterialInstanceAt(
+            rcm.getInstance(mContext.mFullScreenQuadEntity), 0, mi);
+
+    // We integrate over the mip level closest to the sample grid; the mip chain effectively
+    // acts as the first stage of the reduction.
+    const float lod = std::max(0.0f,
+            std::log2(float(environmentCubemap->getWidth()) / float(mSampleDim)));
+
+    TextureSampler environmentSampler;
+    environmentSampler.setMagFilter(SamplerMagFilter::LINEAR);
+    environmentSampler.setMinFilter(SamplerMinFilter::LINEAR_MIPMAP_LINEAR);
+
+    mi->setParameter("environment", environmentCubemap, environmentSampler);
+    mi->setParameter("lod", lod);
+    mi->setParameter("sampleDim", float(mSampleDim));
+
+    if (options.generateMipmap) {
+        // We need mipmaps because we're sampling down
+        environmentCubemap->generateMipmaps(engine);
+    }
+
+    view->setRenderTarget(mRenderTarget);
+    view->setViewport({ 0, 0, 9, 1 });
+
+    renderer->renderStandaloneView(view);
+
+    // Read the coefficients back asynchronously. The backend invokes the callback on the main
+    // thread once the GPU has signaled completion of the copy, typically a few frames later,
+    // so nothing here stalls the pipeline.
+    struct ReadbackState {
+        float4 coefficients[9];
+        Callback callback;
+        void* user;
+    };
+    ReadbackState* const state = new ReadbackState{ {}, callback, user };
+
+    renderer->readPixels(mRenderTarget, 0, 0, 9, 1,
+            PixelBufferDescriptor(state->coefficients, sizeof(state->coefficients),
+                    PixelBufferDescriptor::PixelDataFormat::RGBA,
+                    PixelBufferDescriptor::PixelDataType::FLOAT,
+                    [](void*, size_t, void* user) {
+                        ReadbackState* const state = static_cast<ReadbackState*>(user);
+                        float3 sh[9];
+                        for (size_t i = 0; i < 9; i++) {
+                            sh[i] = state->coefficients[i].rgb;
+                        }
+                        state->callback(sh, state->user);
+                        delete state;
+                    }, state));
+
+    engine.destroy(mi);
+}
+
+UTILS_NOINLINE
+void IBLPrefilterContext::ShGenerator::operator()(
+        Texture const* environmentCubemap, Callback callback, void* user) {
+    operator()({}, environmentCubemap, callback, user);
+}
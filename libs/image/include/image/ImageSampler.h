@@ -21,6 +21,8 @@
 
 #include <utils/compiler.h>
 
+#include <functional>
+
 namespace image {
 
 /**
@@ -145,6 +147,18 @@ void computeSingleSample(const LinearImage& source, float x, float y, SingleSamp
 UTILS_PUBLIC
 void generateMipmaps(const LinearImage& source, Filter, LinearImage* result, uint32_t mipCount);
 
+/**
+ * Generates a sequence of miplevels like generateMipmaps, but hands each level to the given
+ * consumer as soon as it is available, and filters each level from the previous one rather than
+ * from the base image. At most two miplevels are resident at any time, so a consumer that encodes
+ * and discards each level keeps the peak memory footprint close to the source image alone, at the
+ * cost of a little quality from the repeated downsampling. Level indices passed to the consumer
+ * follow the generateMipmaps convention: the half-size image is index 0.
+ */
+UTILS_PUBLIC
+void generateMipmapsLowMem(const LinearImage& source, Filter,
+        const std::function<void(LinearImage, uint32_t index)>& consumer, uint32_t mipCount);
+
 /**
  * Returns the number of miplevels it would take to downsample the given image down to 1x1. This
  * number does not include the original image (i.e. mip 0).
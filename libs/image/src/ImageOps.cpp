@@ -16,6 +16,8 @@
 
 #include <image/ImageOps.h>
 
+#include "ImageParallel.h"
+
 #include <math/vec3.h>
 #include <math/vec4.h>
 #include <utils/Panic.h>
@@ -57,16 +59,18 @@ LinearImage horizontalStack(const LinearImage* first, size_t count) {
     LinearImage result(width, height, nchannels);
 
     // Copy over each row of each source image.
-    float* dst = result.getPixelRef();
-    for (int32_t row = 0; row < height; ++row) {
-        for (size_t c = 0; c < count; ++c) {
-            const auto& img = first[c];
-            uint32_t swidth = img.getWidth();
-            float const* src = img.getPixelRef() + row * swidth * nchannels;
-            memcpy(dst, src, swidth * nchannels * sizeof(float));
-            dst += swidth * nchannels;
+    parallelRowBands(height, [&](uint32_t rowBegin, uint32_t rowEnd) {
+        float* dst = result.getPixelRef() + size_t(rowBegin) * width * nchannels;
+        for (uint32_t row = rowBegin; row < rowEnd; ++row) {
+            for (size_t c = 0; c < count; ++c) {
+                const auto& img = first[c];
+                uint32_t swidth = img.getWidth();
+                float const* src = img.getPixelRef() + row * swidth * nchannels;
+                memcpy(dst, src, swidth * nchannels * sizeof(float));
+                dst += swidth * nchannels;
+            }
         }
-    }
+    });
     return result;
 }
 
@@ -94,15 +98,17 @@ LinearImage horizontalFlip(const LinearImage& image) {
     const uint32_t height = image.getHeight();
     const uint32_t channels = image.getChannels();
     LinearImage result(width, height, channels);
-    for (uint32_t row = 0; row < height; ++row) {
-        for (uint32_t col = 0; col < width; ++col) {
-            float* dst = result.getPixelRef(width - 1 - col, row);
-            float const* src = image.getPixelRef(col, row);
-            for (uint32_t c = 0; c < channels; ++c) {
-                dst[c] = src[c];
+    parallelRowBands(height, [&](uint32_t rowBegin, uint32_t rowEnd) {
+        for (uint32_t row = rowBegin; row < rowEnd; ++row) {
+            for (uint32_t col = 0; col < width; ++col) {
+                float* dst = result.getPixelRef(width - 1 - col, row);
+                float const* src = image.getPixelRef(col, row);
+                for (uint32_t c = 0; c < channels; ++c) {
+                    dst[c] = src[c];
+                }
             }
         }
-    }
+    });
     return result;
 }
 
@@ -111,11 +117,13 @@ LinearImage verticalFlip(const LinearImage& image) {
     const uint32_t height = image.getHeight();
     const uint32_t channels = image.getChannels();
     LinearImage result(width, height, channels);
-    for (uint32_t row = 0; row < height; ++row) {
-        float const* src = image.getPixelRef(0, row);
-        float* dst = result.getPixelRef(0, height - 1 - row);
-        memcpy(dst, src, width * channels * sizeof(float));
-    }
+    parallelRowBands(height, [&](uint32_t rowBegin, uint32_t rowEnd) {
+        for (uint32_t row = rowBegin; row < rowEnd; ++row) {
+            float const* src = image.getPixelRef(0, row);
+            float* dst = result.getPixelRef(0, height - 1 - row);
+            memcpy(dst, src, width * channels * sizeof(float));
+        }
+    });
     return result;
 }
 
@@ -126,9 +134,11 @@ LinearImage applyScaleOffset(const LinearImage& image,
     LinearImage result(width, height, image.getChannels());
     auto src = (VecT const*) image.getPixelRef();
     auto dst = (VecT*) result.getPixelRef();
-    for (uint32_t n = 0, end = width * height; n < end; ++n) {
-        dst[n] = scale * src[n] + VecT{offset};
-    }
+    parallelRowBands(height, [&](uint32_t rowBegin, uint32_t rowEnd) {
+        for (size_t n = size_t(rowBegin) * width, end = size_t(rowEnd) * width; n < end; ++n) {
+            dst[n] = scale * src[n] + VecT{offset};
+        }
+    });
     return result;
 }
 
@@ -155,9 +165,14 @@ LinearImage extractChannel(const LinearImage& source, uint32_t channel) {
     LinearImage result(width, height, 1);
     auto src = source.getPixelRef();
     auto dst = result.getPixelRef();
-    for (uint32_t n = 0, npixels = width * height; n < npixels; ++n, ++dst, src += nchan) {
-        dst[0] = src[channel];
-    }
+    parallelRowBands(height, [&](uint32_t rowBegin, uint32_t rowEnd) {
+        float const* s = src + size_t(rowBegin) * width * nchan;
+        float* d = dst + size_t(rowBegin) * width;
+        for (size_t n = 0, count = size_t(rowEnd - rowBegin) * width; n < count;
+                ++n, ++d, s += nchan) {
+            d[0] = s[channel];
+        }
+    });
     return result;
 }
 
@@ -180,15 +195,19 @@ LinearImage combineChannels(LinearImage const* img, size_t count) {
     }
     LinearImage result(width, height, (uint32_t) count);
     float* dst = result.getPixelRef();
-    uint32_t sindex = 0, dindex = 0;
-    while (dindex < width * height * count) {
-        for (size_t c = 0; c < count; ++c, ++dindex) {
-            const LinearImage& plane = img[c];
-            float const* src = plane.getPixelRef();
-            dst[dindex] = src[sindex];
+    parallelRowBands(height, [&](uint32_t rowBegin, uint32_t rowEnd) {
+        size_t sindex = size_t(rowBegin) * width;
+        size_t dindex = sindex * count;
+        size_t const dend = size_t(rowEnd) * width * count;
+        while (dindex < dend) {
+            for (size_t c = 0; c < count; ++c, ++dindex) {
+                const LinearImage& plane = img[c];
+                float const* src = plane.getPixelRef();
+                dst[dindex] = src[sindex];
+            }
+            ++sindex;
         }
-        ++sindex;
-    }
+    });
     return result;
 }
 
@@ -204,15 +223,17 @@ LinearImage transpose(const LinearImage& image) {
     LinearImage result(height, width, channels);
     float const* source = image.getPixelRef();
     float* target = result.getPixelRef();
-    for (uint32_t n = 0; n < width * height; ++n) {
-        const uint32_t i = n / width;
-        const uint32_t j = n % width;
-        float const* src = source + channels * n;
-        float* dst = target + channels * (height * j + i);
-        for (uint32_t c = 0; c < channels; ++c) {
-            dst[c] = src[c];
+    parallelRowBands(height, [&](uint32_t rowBegin, uint32_t rowEnd) {
+        for (size_t n = size_t(rowBegin) * width, end = size_t(rowEnd) * width; n < end; ++n) {
+            const uint32_t i = n / width;
+            const uint32_t j = n % width;
+            float const* src = source + channels * n;
+            float* dst = target + channels * (height * j + i);
+            for (uint32_t c = 0; c < channels; ++c) {
+                dst[c] = src[c];
+            }
         }
-    }
+    });
     return result;
 }
 
@@ -320,15 +341,16 @@ static LinearImage computeHorizontalEdt(const LinearImage& src, LinearImage cx)
     LinearImage tmp1(width + 1, height + 1, 1);
     LinearImage dst(width, height, 1);
 
-    // TODO: use utils::job::parallel_for.
-    for (uint32_t row = 0; row < height; ++row) {
-        const float* f = src.getPixelRef(0, row);
-        float* d = dst.getPixelRef(0, row);
-        float* z = tmp0.getPixelRef(0, row);
-        float* v = tmp1.getPixelRef(0, row);
-        float* i = cx.getPixelRef(0, row);
-        edt(f, d, z, v, i, width);
-    }
+    parallelRowBands(height, [&](uint32_t rowBegin, uint32_t rowEnd) {
+        for (uint32_t row = rowBegin; row < rowEnd; ++row) {
+            const float* f = src.getPixelRef(0, row);
+            float* d = dst.getPixelRef(0, row);
+            float* z = tmp0.getPixelRef(0, row);
+            float* v = tmp1.getPixelRef(0, row);
+            float* i = cx.getPixelRef(0, row);
+            edt(f, d, z, v, i, width);
+        }
+    });
 
     return dst;
 }
@@ -376,21 +398,23 @@ LinearImage edtFromCoordField(const LinearImage& coordField, bool sqrt) {
     const uint32_t width = coordField.getWidth();
     const uint32_t height = coordField.getHeight();
     LinearImage result(width, height, 1);
-    for (int32_t row = 0; row < height; ++row) {
-        const float frow = row;
-        float* dst = result.getPixelRef(0, row);
-        for (uint32_t col = 0; col < width; ++col) {
-            const float fcol = col;
-            const float* coord = coordField.getPixelRef(col, row);
-            const float dx = coord[0] - fcol;
-            const float dy = coord[1] - frow;
-            float distance = dx * dx + dy * dy;
-            if (sqrt) {
-                distance = std::sqrt(distance);
+    parallelRowBands(height, [&](uint32_t rowBegin, uint32_t rowEnd) {
+        for (uint32_t row = rowBegin; row < rowEnd; ++row) {
+            const float frow = row;
+            float* dst = result.getPixelRef(0, row);
+            for (uint32_t col = 0; col < width; ++col) {
+                const float fcol = col;
+                const float* coord = coordField.getPixelRef(col, row);
+                const float dx = coord[0] - fcol;
+                const float dy = coord[1] - frow;
+                float distance = dx * dx + dy * dy;
+                if (sqrt) {
+                    distance = std::sqrt(distance);
+                }
+                dst[col] = distance;
             }
-            dst[col] = distance;
         }
-    }
+    });
     return result;
 }
 
@@ -400,18 +424,20 @@ LinearImage voronoiFromCoordField(const LinearImage& coordField, const LinearIma
     const uint32_t height = src.getHeight();
     const uint32_t channels = src.getChannels();
     LinearImage result(width, height, channels);
-    for (int32_t row = 0; row < height; ++row) {
-        for (uint32_t col = 0; col < width; ++col) {
-            const float* coord = coordField.getPixelRef(col, row);
-            uint32_t srccol = coord[0];
-            uint32_t srcrow = coord[1];
-            float* presult = result.getPixelRef(col, row);
-            const float* psource = src.getPixelRef(srccol, srcrow);
-            for (uint32_t channel = 0; channel < channels; ++channel) {
-                presult[channel] = psource[channel];
+    parallelRowBands(height, [&](uint32_t rowBegin, uint32_t rowEnd) {
+        for (uint32_t row = rowBegin; row < rowEnd; ++row) {
+            for (uint32_t col = 0; col < width; ++col) {
+                const float* coord = coordField.getPixelRef(col, row);
+                uint32_t srccol = coord[0];
+                uint32_t srcrow = coord[1];
+                float* presult = result.getPixelRef(col, row);
+                const float* psource = src.getPixelRef(srccol, srcrow);
+                for (uint32_t channel = 0; channel < channels; ++channel) {
+                    presult[channel] = psource[channel];
+                }
             }
         }
-    }
+    });
     return result;
 }
 
@@ -0,0 +1,33 @@
+/*
+ * Copyright (C) 2018 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ImageParallel.h"
+
+namespace image {
+
+utils::JobSystem& getSharedJobSystem() {
+    // one pool shared by every image operation of the process, sized by the hardware
+    // concurrency; allow a few client threads to be adopted for runAndWait()
+    static utils::JobSystem js(0, 4);
+    // each thread calling into the pool must be adopted exactly once
+    struct Adopter {
+        explicit Adopter(utils::JobSystem& js) { js.adopt(); }
+    };
+    static thread_local Adopter const adopter(js);
+    return js;
+}
+
+} // namespace image
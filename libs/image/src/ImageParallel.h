@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2018 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IMAGE_IMAGEPARALLEL_H
+#define IMAGE_IMAGEPARALLEL_H
+
+#include <utils/JobSystem.h>
+
+#include <algorithm>
+
+#include <stdint.h>
+
+namespace image {
+
+// Returns the thread pool shared by all image operations. Created on first use; the calling
+// thread is adopted into the pool so it can participate in runAndWait().
+utils::JobSystem& getSharedJobSystem();
+
+// Invokes func(rowBegin, rowEnd) over disjoint bands of rows covering [0, height), spreading
+// the bands over the shared thread pool. Small images are processed inline, so the caller
+// doesn't need its own size heuristic. func must be safe to call concurrently for disjoint
+// bands, which is the case for all row-independent image operations.
+template<typename Func>
+void parallelRowBands(uint32_t height, Func func) {
+    using namespace utils;
+
+    // below this, the dispatch overhead isn't worth it
+    constexpr uint32_t MIN_ROWS_PER_BAND = 64;
+
+    JobSystem& js = getSharedJobSystem();
+    uint32_t const maxBands = uint32_t(js.getThreadCount() + 1);
+    uint32_t const bandCount = std::min(maxBands, std::max(1u, height / MIN_ROWS_PER_BAND));
+    if (bandCount <= 1) {
+        func(0u, height);
+        return;
+    }
+
+    uint32_t const rowsPerBand = (height + bandCount - 1) / bandCount;
+    auto* parent = js.createJob();
+    for (uint32_t band = 0; band < bandCount; ++band) {
+        uint32_t const rowBegin = band * rowsPerBand;
+        uint32_t const rowEnd = std::min(height, rowBegin + rowsPerBand);
+        auto* job = jobs::createJob(js, parent, [&func, rowBegin, rowEnd]() {
+            func(rowBegin, rowEnd);
+        });
+        js.run(job);
+    }
+    js.runAndWait(parent);
+}
+
+} // namespace image
+
+#endif // IMAGE_IMAGEPARALLEL_H
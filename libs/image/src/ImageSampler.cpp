@@ -17,10 +17,13 @@
 #include <image/ImageSampler.h>
 #include <image/ImageOps.h>
 
+#include "ImageParallel.h"
+
 #include <math/scalar.h>
 #include <math/vec3.h>
 #include <math/vec4.h>
 
+#include <utils/compiler.h>
 #include <utils/Panic.h>
 
 #include <memory>
@@ -172,22 +175,38 @@ void generateMadProgram(uint32_t ntarget, uint32_t nsource, float left, float ri
     }
 }
 
-// Transforms a MAD program intended for single-channel data into a program intended for
-// multi-channel data.
-void expandMadProgram(uint32_t nchannels, MadProgram* program) {
-    if (nchannels == 1) {
-        return;
+// Executes a single-channel MAD program over one row of multi-channel data. Each instruction
+// touches NCHAN consecutive floats with the same weight; with the channel count known at compile
+// time and no aliasing, the inner loop collapses into a single SIMD multiply-add (SSE/NEON)
+// instead of NCHAN scalar instructions. The stride between consecutive target pixels is a
+// parameter so the caller can write the output transposed, fusing the transpose pass that
+// separable resampling would otherwise need.
+template<uint32_t NCHAN>
+void executeMadProgram(const MadProgram& program,
+        const float* UTILS_RESTRICT sourceRow, float* UTILS_RESTRICT targetRow,
+        uint32_t targetPixelStride) {
+    for (auto mad : program) {
+        const float* UTILS_RESTRICT const s = sourceRow + mad.sourceIndex * NCHAN;
+        float* UTILS_RESTRICT const t = targetRow + mad.targetIndex * targetPixelStride;
+        const float weight = mad.weight;
+        for (uint32_t c = 0; c < NCHAN; ++c) {
+            t[c] += s[c] * weight;
+        }
     }
-    MadProgram result;
-    result.reserve(program->size() * nchannels);
-    for (auto mad : *program) {
-        mad.sourceIndex *= nchannels;
-        mad.targetIndex *= nchannels;
-        for (uint32_t j = 0; j < nchannels; ++j, ++mad.sourceIndex, ++mad.targetIndex) {
-            result.push_back(mad);
+}
+
+// Fallback for channel counts without a specialized kernel.
+void executeMadProgram(const MadProgram& program, uint32_t nchan,
+        const float* UTILS_RESTRICT sourceRow, float* UTILS_RESTRICT targetRow,
+        uint32_t targetPixelStride) {
+    for (auto mad : program) {
+        const float* UTILS_RESTRICT const s = sourceRow + mad.sourceIndex * nchan;
+        float* UTILS_RESTRICT const t = targetRow + mad.targetIndex * targetPixelStride;
+        const float weight = mad.weight;
+        for (uint32_t c = 0; c < nchan; ++c) {
+            t[c] += s[c] * weight;
         }
     }
-    program->swap(result);
 }
 
 FilterFunction createFilterFunction(Filter ftype) {
@@ -211,9 +230,11 @@ template <class VecT>
 void normalizeImpl(LinearImage& image) {
     const uint32_t width = image.getWidth(), height = image.getHeight();
     auto vecs = (VecT*) image.getPixelRef();
-    for (uint32_t n = 0; n < width * height; ++n) {
-        vecs[n] = normalize(vecs[n]);
-    }
+    parallelRowBands(height, [&](uint32_t rowBegin, uint32_t rowEnd) {
+        for (size_t n = size_t(rowBegin) * width, end = size_t(rowEnd) * width; n < end; ++n) {
+            vecs[n] = normalize(vecs[n]);
+        }
+    });
 }
 
 void normalize(LinearImage& image) {
@@ -226,6 +247,11 @@ void normalize(LinearImage& image) {
     }
 }
 
+// Resamples each row of "source" to twidth samples and writes the result transposed, i.e.
+// returns an image of (sheight x twidth). Writing the output transposed fuses the transpose
+// pass that separable resampling needs between (and after) its two 1D passes, so a full 2D
+// resample walks the pixels twice instead of four times. Rows are processed in parallel
+// bands; each source row writes a disjoint column of the output.
 LinearImage resampleImage1D(const LinearImage& source, MadProgram* program,
         uint32_t twidth, Filter filter, float left, float right, float filterRadiusMultiplier) {
     const uint32_t swidth = source.getWidth();
@@ -235,41 +261,57 @@ LinearImage resampleImage1D(const LinearImage& source, MadProgram* program,
     if (filter == Filter::DEFAULT) filter = mag ? Filter::MITCHELL : Filter::LANCZOS;
     const FilterFunction hfn = createFilterFunction(filter);
 
-    // Generate a flat list of multiply-add (MAD) instructions.
+    // Generate a flat list of multiply-add (MAD) instructions. The program stays
+    // single-channel; the channel dimension is handled by the vectorized executors below.
     program->clear();
     generateMadProgram(twidth, swidth, left, right, hfn, filterRadiusMultiplier, program);
-    expandMadProgram(nchan, program);
 
-    // Allocate the target image.
-    LinearImage result(twidth, sheight, nchan);
-    float const* sourceRow = source.getPixelRef();
-    float* targetRow = result.getPixelRef();
+    // Allocate the target image (transposed layout, see above).
+    LinearImage result(sheight, twidth, nchan);
+    float const* const sourceBase = source.getPixelRef();
+    float* const targetBase = result.getPixelRef();
+    const uint32_t targetPixelStride = sheight * nchan;
 
     // The MIN filter is special because it starts with non-zero values and ignores filter weights.
     if (filter == Filter::MINIMUM) {
         for (uint32_t n = 0; n < twidth * sheight * nchan; ++n) {
-            targetRow[n] = std::numeric_limits<float>::max();
+            targetBase[n] = std::numeric_limits<float>::max();
         }
-        for (uint32_t row = 0; row < sheight; ++row) {
-            for (auto mad : *program) {
-                const float a = sourceRow[mad.sourceIndex];
-                const float b = targetRow[mad.targetIndex];
-                targetRow[mad.targetIndex] = std::min(a, b);
+        parallelRowBands(sheight, [&](uint32_t rowBegin, uint32_t rowEnd) {
+            for (uint32_t row = rowBegin; row < rowEnd; ++row) {
+                float const* sourceRow = sourceBase + size_t(row) * swidth * nchan;
+                float* targetRow = targetBase + size_t(row) * nchan;
+                for (auto mad : *program) {
+                    for (uint32_t c = 0; c < nchan; ++c) {
+                        const float a = sourceRow[mad.sourceIndex * nchan + c];
+                        const float b = targetRow[mad.targetIndex * targetPixelStride + c];
+                        targetRow[mad.targetIndex * targetPixelStride + c] = std::min(a, b);
+                    }
+                }
             }
-            targetRow += twidth * nchan;
-            sourceRow += swidth * nchan;
-        }
+        });
         return result;
     }
 
     // Resize the image horizontally by executing the MAD instructions over each row.
-    for (uint32_t row = 0; row < sheight; ++row) {
-        for (auto mad : *program) {
-            targetRow[mad.targetIndex] += sourceRow[mad.sourceIndex] * mad.weight;
+    parallelRowBands(sheight, [&](uint32_t rowBegin, uint32_t rowEnd) {
+        for (uint32_t row = rowBegin; row < rowEnd; ++row) {
+            float const* sourceRow = sourceBase + size_t(row) * swidth * nchan;
+            float* targetRow = targetBase + size_t(row) * nchan;
+            switch (nchan) {
+                case 1: executeMadProgram<1>(*program, sourceRow, targetRow,
+                        targetPixelStride); break;
+                case 2: executeMadProgram<2>(*program, sourceRow, targetRow,
+                        targetPixelStride); break;
+                case 3: executeMadProgram<3>(*program, sourceRow, targetRow,
+                        targetPixelStride); break;
+                case 4: executeMadProgram<4>(*program, sourceRow, targetRow,
+                        targetPixelStride); break;
+                default: executeMadProgram(*program, nchan, sourceRow, targetRow,
+                        targetPixelStride); break;
+            }
         }
-        targetRow += twidth * nchan;
-        sourceRow += swidth * nchan;
-    }
+    });
 
     // Perform post processing for the current pass.
     if (filter == Filter::GAUSSIAN_NORMALS) {
@@ -299,10 +341,12 @@ LinearImage resampleImage(const LinearImage& source, uint32_t width, uint32_t he
     const float top = sampler.sourceRegion.top;
     const float right = sampler.sourceRegion.right;
     const float bottom = sampler.sourceRegion.bottom;
+    // each 1D pass writes its output transposed, so the second pass consumes the first one's
+    // columns as rows and the final image comes out upright with no explicit transpose pass
     MadProgram program;
     LinearImage result;
-    result = transpose(resampleImage1D(source, &program, width, hfilter, left, right, radius));
-    result = transpose(resampleImage1D(result, &program, height, vfilter, top, bottom, radius));
+    result = resampleImage1D(source, &program, width, hfilter, left, right, radius);
+    result = resampleImage1D(result, &program, height, vfilter, top, bottom, radius);
     return result;
 }
 
@@ -322,7 +366,8 @@ void computeSingleSample(const LinearImage& source, float x, float y, SingleSamp
     const float right = x + radius / source.getWidth();
     const float bottom = y + radius / source.getHeight();
     MadProgram program;
-    LinearImage row = transpose(resampleImage1D(source, &program, 1, filter, left, right, radius));
+    // resampleImage1D returns its output transposed, which is what the second pass consumes
+    LinearImage row = resampleImage1D(source, &program, 1, filter, left, right, radius);
     row = resampleImage1D(row, &program, 1, filter, top, bottom, radius);
     if (!result->data) {
         result->data = new float[source.getChannels()];
@@ -348,6 +393,21 @@ void generateMipmaps(const LinearImage& source, Filter filter, LinearImage* resu
     }
 }
 
+void generateMipmapsLowMem(const LinearImage& source, Filter filter,
+        const std::function<void(LinearImage, uint32_t)>& consumer, uint32_t mips) {
+    mips = std::min(mips, getMipmapCount(source));
+    uint32_t width = source.getWidth();
+    uint32_t height = source.getHeight();
+    LinearImage previous = source;
+    for (uint32_t n = 0; n < mips; ++n) {
+        width = std::max(width >> 1u, 1u);
+        height = std::max(height >> 1u, 1u);
+        LinearImage level = resampleImage(previous, width, height, filter);
+        previous = level;
+        consumer(std::move(level), n);
+    }
+}
+
 uint32_t getMipmapCount(const LinearImage& source) {
     uint32_t width = source.getWidth();
     uint32_t height = source.getHeight();
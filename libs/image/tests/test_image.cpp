@@ -362,6 +362,35 @@ TEST_F(ImageTest, Mipmaps) { // NOLINT
     }
 }
 
+TEST_F(ImageTest, MipmapsLowMem) { // NOLINT
+    // Miplevels: 5x10, 2x5, 1x2, 1x1.
+    LinearImage src = createColorFromAscii(
+            "44444 41014 40704 41014 44444 44444 41014 40704 41014 44444");
+    uint32_t count = getMipmapCount(src);
+    ASSERT_EQ(count, 3);
+    vector<LinearImage> mips(count);
+    generateMipmaps(src, Filter::HERMITE, mips.data(), count);
+
+    uint32_t consumed = 0;
+    generateMipmapsLowMem(src, Filter::HERMITE, [&](LinearImage level, uint32_t index) {
+        ASSERT_EQ(index, consumed++);
+        ASSERT_EQ(level.getWidth(), mips[index].getWidth());
+        ASSERT_EQ(level.getHeight(), mips[index].getHeight());
+        if (index == 0) {
+            // the first level is filtered from the source image in both variants, so the
+            // results must be identical
+            float const* a = level.getPixelRef();
+            float const* b = mips[0].getPixelRef();
+            size_t const floatCount =
+                    level.getWidth() * level.getHeight() * level.getChannels();
+            for (size_t i = 0; i < floatCount; ++i) {
+                ASSERT_FLOAT_EQ(a[i], b[i]);
+            }
+        }
+    }, count);
+    ASSERT_EQ(consumed, count);
+}
+
 TEST_F(ImageTest, Ktx) { // NOLINT
     uint8_t foo[] = {1, 2, 3};
     uint8_t* data;
@@ -32,8 +32,58 @@ namespace basist {
     class ktx2_transcoder;
 }
 
+namespace utils {
+    class JobSystem;
+}
+
 namespace ktxreader {
 
+/**
+ * Device-profile-driven selection of transcode target formats.
+ *
+ * Rather than shipping a static, conservative preference list, probe() checks the backend's
+ * actual format support (via Texture::isTextureFormatSupported) once -- typically right after
+ * Engine creation -- and builds an ordered preference list per content class under the given
+ * quality/memory policy. The table only depends on the device and the policy, so it can be
+ * computed once, cached, and shared between readers:
+ *
+ *     auto targets = TranscodeTargets::probe(*engine, TranscodeTargets::Policy::PREFER_QUALITY);
+ *     reader->requestFormats(targets, TranscodeTargets::ContentClass::NORMAL_MAP);
+ */
+class TranscodeTargets {
+    public:
+        enum class ContentClass : uint8_t {
+            COLOR,          //!< albedo, emissive; color data, usually sRGB
+            NORMAL_MAP,     //!< tangent-space normals; prefers two-channel formats
+            NON_COLOR_DATA, //!< occlusion, metallic-roughness, masks; linear multi-channel
+        };
+
+        enum class Policy : uint8_t {
+            PREFER_QUALITY, //!< highest-quality supported format first (ASTC4x4, BC7, BC5)
+            //! smallest supported format per texel first; note that for COLOR this favors
+            //! 4 bpp RGB formats, which drop the alpha channel
+            PREFER_MEMORY,
+        };
+
+        using FormatList = utils::FixedCapacityVector<filament::Texture::InternalFormat>;
+
+        /**
+         * Probes the device and builds the decision table for the given policy.
+         *
+         * Each list ends with an uncompressed fallback, so it is never empty.
+         */
+        static TranscodeTargets probe(filament::Engine& engine, Policy policy) noexcept;
+
+        /** Returns the ordered format preference list for the given content class. */
+        FormatList const& getFormats(ContentClass contentClass) const noexcept {
+            return mFormats[size_t(contentClass)];
+        }
+
+    private:
+        TranscodeTargets() noexcept = default;
+        FormatList mFormats[3];
+};
+
 class Ktx2Reader {
     public:
         using Engine = filament::Engine;
@@ -76,6 +126,15 @@ class Ktx2Reader {
          */
         void unrequestFormat(Texture::InternalFormat format) noexcept;
 
+        /**
+         * Requests the probed target formats for the given content class, in the table's
+         * priority order. Equivalent to calling requestFormat() for each entry.
+         *
+         * Returns SUCCESS if at least one new format was added to the list.
+         */
+        Result requestFormats(TranscodeTargets const& targets,
+                TranscodeTargets::ContentClass contentClass) noexcept;
+
         /**
          * Attempts to create and load a Filament texture from the given KTX2 blob.
          *
@@ -128,9 +187,21 @@ class Ktx2Reader {
              *
              * This does not return until all mipmaps have been transcoded. This is typically
              * called from a background thread.
+             *
+             * The smallest miplevels are transcoded first, so interleaved calls to
+             * uploadImages() on the foreground thread make the texture usable (at reduced
+             * resolution) long before the largest levels have finished.
              */
             Result doTranscoding();
 
+            /**
+             * Same as doTranscoding(), but distributes one transcode job per miplevel over
+             * the given JobSystem, with the smallest levels scheduled first. uploadImages()
+             * can still be called concurrently from the foreground thread to stream levels
+             * in as they become available.
+             */
+            Result doTranscoding(utils::JobSystem& js);
+
             /**
              * Uploads pending mipmaps to the texture.
              *
@@ -19,6 +19,7 @@
 #include <filament/Engine.h>
 #include <filament/Texture.h>
 
+#include <utils/JobSystem.h>
 #include <utils/Log.h>
 
 #include <atomic>
@@ -163,6 +164,53 @@ static Result transcodeImageLevel(ktx2_transcoder& transcoder,
 
 namespace ktxreader {
 
+TranscodeTargets TranscodeTargets::probe(Engine& engine, Policy policy) noexcept {
+    using tif = Texture::InternalFormat;
+    auto select = [&engine](std::initializer_list<tif> candidates) -> FormatList {
+        FormatList list = FormatList::with_capacity(candidates.size());
+        for (tif format : candidates) {
+            if (getFinalFormatInfo(format).isSupported &&
+                    Texture::isTextureFormatSupported(engine, format)) {
+                list.push_back(format);
+            }
+        }
+        return list;
+    };
+    using cc = ContentClass;
+    TranscodeTargets targets;
+    if (policy == Policy::PREFER_QUALITY) {
+        targets.mFormats[size_t(cc::COLOR)] = select({
+                tif::SRGB8_ALPHA8_ASTC_4x4, tif::RGBA_ASTC_4x4,
+                tif::SRGB_ALPHA_BPTC_UNORM, tif::RGBA_BPTC_UNORM,
+                tif::ETC2_EAC_SRGBA8, tif::ETC2_EAC_RGBA8,
+                tif::DXT5_SRGBA, tif::DXT5_RGBA,
+                tif::SRGB8_A8, tif::RGBA8 });
+        targets.mFormats[size_t(cc::NORMAL_MAP)] = select({
+                tif::RED_GREEN_RGTC2, tif::EAC_RG11,
+                tif::RGBA_ASTC_4x4, tif::RGBA_BPTC_UNORM,
+                tif::ETC2_EAC_RGBA8, tif::DXT5_RGBA, tif::RGBA8 });
+        targets.mFormats[size_t(cc::NON_COLOR_DATA)] = select({
+                tif::RGBA_ASTC_4x4, tif::RGBA_BPTC_UNORM,
+                tif::ETC2_EAC_RGBA8, tif::DXT5_RGBA, tif::RGBA8 });
+    } else {
+        targets.mFormats[size_t(cc::COLOR)] = select({
+                tif::DXT1_SRGB, tif::DXT1_RGB,
+                tif::SRGB8_ALPHA8_ASTC_4x4, tif::RGBA_ASTC_4x4,
+                tif::ETC2_EAC_SRGBA8, tif::ETC2_EAC_RGBA8,
+                tif::DXT5_SRGBA, tif::DXT5_RGBA,
+                tif::RGB565, tif::SRGB8_A8, tif::RGBA8 });
+        targets.mFormats[size_t(cc::NORMAL_MAP)] = select({
+                tif::EAC_RG11, tif::RED_GREEN_RGTC2,
+                tif::RGBA_ASTC_4x4, tif::ETC2_EAC_RGBA8,
+                tif::DXT5_RGBA, tif::RGBA8 });
+        targets.mFormats[size_t(cc::NON_COLOR_DATA)] = select({
+                tif::DXT1_RGB, tif::RGBA_ASTC_4x4,
+                tif::ETC2_EAC_RGBA8, tif::DXT5_RGBA,
+                tif::RGB565, tif::RGBA8 });
+    }
+    return targets;
+}
+
 class FAsync : public Async {
 public:
     FAsync(Texture* texture, Engine& engine, ktx2_transcoder* transcoder, Buffer&& buf) :
@@ -170,6 +218,7 @@ public:
             mSourceBuffer(std::move(buf)) {}
     Texture* getTexture() const noexcept { return mTexture; }
     Result doTranscoding();
+    Result doTranscoding(utils::JobSystem& js);
     void uploadImages();
 
 protected:
@@ -221,6 +270,17 @@ Result Ktx2Reader::requestFormat(Texture::InternalFormat format) noexcept {
     return Result::SUCCESS;
 }
 
+Result Ktx2Reader::requestFormats(TranscodeTargets const& targets,
+        TranscodeTargets::ContentClass contentClass) noexcept {
+    bool added = false;
+    for (Texture::InternalFormat format : targets.getFormats(contentClass)) {
+        if (requestFormat(format) == Result::SUCCESS) {
+            added = true;
+        }
+    }
+    return added ? Result::SUCCESS : Result::FORMAT_UNSUPPORTED;
+}
+
 void Ktx2Reader::unrequestFormat(Texture::InternalFormat format) noexcept {
     for (auto iter = mRequestedFormats.begin(); iter != mRequestedFormats.end(); ++iter) {
         if (*iter == format) {
@@ -275,7 +335,10 @@ FAsync::~FAsync() {
 Result FAsync::doTranscoding() {
     ktx2_transcoder_state basisThreadState;
     basisThreadState.clear();
-    for (uint32_t levelIndex = 0, n = mTranscoder->get_levels(); levelIndex < n; levelIndex++) {
+    // Transcode the smallest miplevels first: they are cheap, and if the foreground thread
+    // interleaves calls to uploadImages(), the texture becomes usable (at reduced resolution)
+    // while the large levels are still being transcoded.
+    for (uint32_t levelIndex = mTranscoder->get_levels(); levelIndex-- > 0; ) {
         Texture::PixelBufferDescriptor* pbd;
         Result result = transcodeImageLevel(*mTranscoder, basisThreadState, mTexture->getFormat(),
                 levelIndex, &pbd);
@@ -287,6 +350,31 @@ Result FAsync::doTranscoding() {
     return Result::SUCCESS;
 }
 
+Result FAsync::doTranscoding(utils::JobSystem& js) {
+    std::atomic<Result> result{ Result::SUCCESS };
+    utils::JobSystem::Job* parent = js.createJob();
+    // One job per miplevel. transcode_image_level() is thread-safe as long as each thread
+    // uses its own ktx2_transcoder_state, see the note on mTranscoder above. Jobs are
+    // submitted smallest level first so reduced-resolution data becomes available for
+    // uploadImages() as early as possible.
+    for (uint32_t levelIndex = mTranscoder->get_levels(); levelIndex-- > 0; ) {
+        js.run(utils::jobs::createJob(js, parent, [this, levelIndex, &result]() {
+            ktx2_transcoder_state basisThreadState;
+            basisThreadState.clear();
+            Texture::PixelBufferDescriptor* pbd;
+            Result const r = transcodeImageLevel(*mTranscoder, basisThreadState,
+                    mTexture->getFormat(), levelIndex, &pbd);
+            if (UTILS_LIKELY(r == Result::SUCCESS)) {
+                mTranscoderResults[levelIndex].store(pbd);
+            } else {
+                result.store(r);
+            }
+        }));
+    }
+    js.runAndWait(parent);
+    return result.load();
+}
+
 void FAsync::uploadImages() {
     size_t levelIndex = 0;
     UTILS_NOUNROLL
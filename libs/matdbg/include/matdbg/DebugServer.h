@@ -67,7 +67,20 @@ public:
      */
     void removeMaterial(MaterialKey key);
 
-    using EditCallback = void(*)(void* userdata, const utils::CString& name, const void*, size_t);
+    /**
+     * Publishes the GPU time spent on the given material during the last completed frame.
+     * Called by the engine once per frame when per-material GPU profiling is enabled; the
+     * values are served on "/api/profile".
+     */
+    void updateProfile(MaterialKey key, uint64_t gpuNanos);
+
+    /**
+     * Notifies the engine of an edited material package. `variant` identifies the single shader
+     * variant whose source was replaced, so the engine can rebuild just that variant instead of
+     * the whole material.
+     */
+    using EditCallback = void(*)(void* userdata, const utils::CString& name, const void*, size_t,
+            Variant variant);
     using QueryCallback = void(*)(void* userdata, VariantList* variants);
 
     /**
@@ -103,6 +116,9 @@ private:
     tsl::robin_map<MaterialKey, MaterialRecord> mMaterialRecords;
     mutable utils::Mutex mMaterialRecordsMutex;
 
+    // per-material GPU nanoseconds of the last completed frame, see updateProfile()
+    tsl::robin_map<MaterialKey, uint64_t> mProfileNanos;
+
     utils::CString mHtml;
     utils::CString mJavascript;
     utils::CString mCss;
@@ -386,6 +386,23 @@ bool ApiHandler::handleGet(CivetServer* server, struct mg_connection* conn) {
         return true;
     }
 
+    if (uri == "/api/profile") {
+        std::unique_lock const lock(mServer->mMaterialRecordsMutex);
+        mg_printf(conn, kSuccessHeader.data(), "application/json");
+        mg_printf(conn, "[");
+        int index = 0;
+        for (auto const& pair : mServer->mProfileNanos) {
+            bool const last = (++index) == mServer->mProfileNanos.size();
+            auto const record = mServer->mMaterialRecords.find(pair.first);
+            char const* const name = (record == mServer->mMaterialRecords.end()) ?
+                    "" : record->second.name.c_str_safe();
+            mg_printf(conn, "{ \"matid\": \"%8.8x\", \"name\": \"%s\", \"gpuNanos\": %llu } %s",
+                    pair.first, name, (unsigned long long) pair.second, last ? "" : ",");
+        }
+        mg_printf(conn, "]");
+        return true;
+    }
+
     if (uri == "/api/shader") {
         return handleGetApiShader(conn, request);
     }
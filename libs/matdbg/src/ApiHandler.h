@@ -35,6 +35,7 @@ struct MaterialRecord;
 //    GET /api/material?matid={id}
 //    GET /api/shader?matid={id}&type=[glsl|spirv]&[glindex|vkindex|metalindex]={index}
 //    GET /api/active
+//    GET /api/profile
 //    GET /api/status
 //    POST /api/edit
 //
@@ -211,6 +211,12 @@ DebugServer::addMaterial(const CString& name, const void* data, size_t size, voi
 void DebugServer::removeMaterial(MaterialKey key) {
     std::unique_lock<utils::Mutex> lock(mMaterialRecordsMutex);
     mMaterialRecords.erase(key);
+    mProfileNanos.erase(key);
+}
+
+void DebugServer::updateProfile(MaterialKey key, uint64_t gpuNanos) {
+    std::unique_lock<utils::Mutex> lock(mMaterialRecordsMutex);
+    mProfileNanos[key] = gpuNanos;
 }
 
 const MaterialRecord* DebugServer::getRecord(const MaterialKey& key) const {
@@ -300,7 +306,8 @@ bool DebugServer::handleEditCommand(const MaterialKey& key, backend::Backend api
     material.packageSize = editor.getEditedSize();
 
     if (mEditCallback) {
-        mEditCallback(material.userdata, material.name, material.package, material.packageSize);
+        mEditCallback(material.userdata, material.name, material.package, material.packageSize,
+                info.variant);
     }
 
     return true;
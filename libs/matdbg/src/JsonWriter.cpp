@@ -21,6 +21,7 @@
 #include <backend/DriverEnums.h>
 
 #include <matdbg/JsonWriter.h>
+#include <matdbg/ShaderExtractor.h>
 #include <matdbg/ShaderInfo.h>
 
 #include "CommonWriter.h"
@@ -118,20 +119,31 @@ static bool printParametersInfo(ostream&, const ChunkContainer&) {
     return true;
 }
 
-static void printShaderInfo(ostream& json, const vector<ShaderInfo>& info, const ChunkContainer& container) {
+static void printShaderInfo(ostream& json, const vector<ShaderInfo>& info,
+        const ChunkContainer& container, backend::ShaderLanguage language) {
     MaterialDomain domain = MaterialDomain::SURFACE;
     read(container, ChunkType::MaterialDomain, reinterpret_cast<uint8_t*>(&domain));
+    // the per-variant binary size lets the web UI show the cost delta of an edit
+    ShaderExtractor extractor(language, container.getData(), container.getSize());
+    bool const hasShaders = extractor.parse();
     for (uint64_t i = 0; i < info.size(); ++i) {
         const auto& item = info[i];
         string variantString = formatVariantString(item.variant, domain);
         string ps = (item.pipelineStage == backend::ShaderStage::VERTEX) ? "vertex  " : "fragment";
+        ShaderContent content;
+        size_t size = 0;
+        if (hasShaders &&
+                extractor.getShader(item.shaderModel, item.variant, item.pipelineStage, content)) {
+            size = content.size();
+        }
         json
                 << "    {"
                 << "\"index\": \"" << std::setw(2) << i << "\", "
                 << "\"shaderModel\": \"" << toString(item.shaderModel) << "\", "
                 << "\"pipelineStage\": \"" << ps << "\", "
                 << "\"variantString\": \"" << variantString << "\", "
-                << "\"variant\": " << +item.variant.key << " }"
+                << "\"variant\": " << +item.variant.key << ", "
+                << "\"size\": " << size << " }"
             << ((i == info.size() - 1) ? "\n" : ",\n");
     }
 }
@@ -143,7 +155,7 @@ static bool printGlslInfo(ostream& json, const ChunkContainer& container) {
         return false;
     }
     json << "\"opengl\": [\n";
-    printShaderInfo(json, info, container);
+    printShaderInfo(json, info, container, backend::ShaderLanguage::ESSL3);
     json << "],\n";
     return true;
 }
@@ -155,7 +167,7 @@ static bool printVkInfo(ostream& json, const ChunkContainer& container) {
         return false;
     }
     json << "\"vulkan\": [\n";
-    printShaderInfo(json, info, container);
+    printShaderInfo(json, info, container, backend::ShaderLanguage::SPIRV);
     json << "],\n";
     return true;
 }
@@ -167,7 +179,7 @@ static bool printMetalInfo(ostream& json, const ChunkContainer& container) {
         return false;
     }
     json << "\"metal\": [\n";
-    printShaderInfo(json, info, container);
+    printShaderInfo(json, info, container, backend::ShaderLanguage::MSL);
     json << "],\n";
     return true;
 }
@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_MATH_BATCH_H
+#define TNT_MATH_BATCH_H
+
+#include <math/compiler.h>
+#include <math/mat4.h>
+#include <math/quat.h>
+#include <math/vec3.h>
+#include <math/vec4.h>
+
+#include <stddef.h>
+
+#ifdef __ARM_NEON
+#include <arm_neon.h>
+#endif
+
+namespace filament {
+namespace math {
+
+// Batch kernels operating on contiguous arrays of vectors / quaternions. These exist so that
+// hot loops don't each hand-roll the same "hoist the matrix, iterate" pattern; the matrix (or
+// interpolation parameter) is loaded once and the per-element bodies are written so the
+// compiler can vectorize them (the pointers don't alias, and libmath is compiled with
+// -ffast-math). On aarch64 a few kernels have an explicit NEON path, following the precedent
+// of fast.h / half.h: like everywhere else in this tree, the ISA is selected at compile time.
+namespace batch {
+
+// out[i] = (m * float4{ in[i], 1 }).xyz
+// 'm' must be an affine transform (no perspective divide is performed), which is the common
+// case for model / view matrices. in and out must not overlap.
+template<typename T>
+inline void transformPoints(details::TMat44<T> const& m,
+        details::TVec3<T> const* MATH_RESTRICT in,
+        details::TVec3<T>* MATH_RESTRICT out, size_t count) noexcept {
+    details::TVec3<T> const c0 = m[0].xyz;
+    details::TVec3<T> const c1 = m[1].xyz;
+    details::TVec3<T> const c2 = m[2].xyz;
+    details::TVec3<T> const c3 = m[3].xyz;
+    for (size_t i = 0; i < count; ++i) {
+        details::TVec3<T> const p = in[i];
+        out[i] = c0 * p.x + c1 * p.y + c2 * p.z + c3;
+    }
+}
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+
+// NEON specialization: vld3q/vst3q de-interleave four packed float3 into x/y/z lanes, so each
+// matrix coefficient is applied to four points per fma.
+inline void transformPoints(details::TMat44<float> const& m,
+        details::TVec3<float> const* MATH_RESTRICT in,
+        details::TVec3<float>* MATH_RESTRICT out, size_t count) noexcept {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        float32x4x3_t const p = vld3q_f32(reinterpret_cast<float const*>(in + i));
+        float32x4x3_t r;
+        r.val[0] = vfmaq_n_f32(vfmaq_n_f32(vfmaq_n_f32(
+                vdupq_n_f32(m[3][0]), p.val[0], m[0][0]), p.val[1], m[1][0]), p.val[2], m[2][0]);
+        r.val[1] = vfmaq_n_f32(vfmaq_n_f32(vfmaq_n_f32(
+                vdupq_n_f32(m[3][1]), p.val[0], m[0][1]), p.val[1], m[1][1]), p.val[2], m[2][1]);
+        r.val[2] = vfmaq_n_f32(vfmaq_n_f32(vfmaq_n_f32(
+                vdupq_n_f32(m[3][2]), p.val[0], m[0][2]), p.val[1], m[1][2]), p.val[2], m[2][2]);
+        vst3q_f32(reinterpret_cast<float*>(out + i), r);
+    }
+    details::TVec3<float> const c0 = m[0].xyz;
+    details::TVec3<float> const c1 = m[1].xyz;
+    details::TVec3<float> const c2 = m[2].xyz;
+    details::TVec3<float> const c3 = m[3].xyz;
+    for (; i < count; ++i) {
+        details::TVec3<float> const p = in[i];
+        out[i] = c0 * p.x + c1 * p.y + c2 * p.z + c3;
+    }
+}
+
+#endif // __ARM_NEON && __aarch64__
+
+// out[i] = project(m, in[i]), i.e. the full transform including the perspective divide.
+// Use this when 'm' is (or may be) a projection; for affine matrices prefer transformPoints().
+// in and out must not overlap.
+template<typename T>
+inline void projectPoints(details::TMat44<T> const& m,
+        details::TVec3<T> const* MATH_RESTRICT in,
+        details::TVec3<T>* MATH_RESTRICT out, size_t count) noexcept {
+    details::TVec4<T> const c0 = m[0];
+    details::TVec4<T> const c1 = m[1];
+    details::TVec4<T> const c2 = m[2];
+    details::TVec4<T> const c3 = m[3];
+    for (size_t i = 0; i < count; ++i) {
+        details::TVec3<T> const p = in[i];
+        details::TVec4<T> const r = c0 * p.x + c1 * p.y + c2 * p.z + c3;
+        out[i] = r.xyz * (T(1) / r.w);
+    }
+}
+
+// out[i] = slerp(p[i], q[i], t). Each pair takes the short path, like math::slerp.
+template<typename T>
+inline void slerp(details::TQuaternion<T> const* MATH_RESTRICT p,
+        details::TQuaternion<T> const* MATH_RESTRICT q, T t,
+        details::TQuaternion<T>* MATH_RESTRICT out, size_t count) noexcept {
+    for (size_t i = 0; i < count; ++i) {
+        // found by ADL: slerp() is a friend of TQuaternion
+        out[i] = slerp(p[i], q[i], t);
+    }
+}
+
+// out[i] = nlerp(p[i], q[i], t). Cheaper than slerp and branch-free, so it vectorizes;
+// adequate when consecutive pairs are close (e.g. resampled animation tracks).
+template<typename T>
+inline void nlerp(details::TQuaternion<T> const* MATH_RESTRICT p,
+        details::TQuaternion<T> const* MATH_RESTRICT q, T t,
+        details::TQuaternion<T>* MATH_RESTRICT out, size_t count) noexcept {
+    for (size_t i = 0; i < count; ++i) {
+        // found by ADL: nlerp() is a friend of TQuaternion
+        out[i] = nlerp(p[i], q[i], t);
+    }
+}
+
+// out[i] = a[i] + (b[i] - a[i]) * t, over plain scalar spans (e.g. morph weights).
+template<typename T>
+inline void mix(T const* MATH_RESTRICT a, T const* MATH_RESTRICT b, T t,
+        T* MATH_RESTRICT out, size_t count) noexcept {
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = a[i] + (b[i] - a[i]) * t;
+    }
+}
+
+// Transforms count boxes given in center / half-extent form by the affine transform 'm':
+//   outCenter[i]     = m * center[i]
+//   outHalfExtent[i] = abs(M) * halfExtent[i]     with M = m's upper-left 3x3
+// This is the same math as Aabb::transform() / rigidTransform(), with abs(M) hoisted out of
+// the loop. Input and output arrays must not overlap.
+template<typename T>
+inline void transformBoxes(details::TMat44<T> const& m,
+        details::TVec3<T> const* MATH_RESTRICT center,
+        details::TVec3<T> const* MATH_RESTRICT halfExtent,
+        details::TVec3<T>* MATH_RESTRICT outCenter,
+        details::TVec3<T>* MATH_RESTRICT outHalfExtent, size_t count) noexcept {
+    details::TVec3<T> const c0 = m[0].xyz;
+    details::TVec3<T> const c1 = m[1].xyz;
+    details::TVec3<T> const c2 = m[2].xyz;
+    details::TVec3<T> const c3 = m[3].xyz;
+    details::TVec3<T> const a0 = abs(c0);
+    details::TVec3<T> const a1 = abs(c1);
+    details::TVec3<T> const a2 = abs(c2);
+    for (size_t i = 0; i < count; ++i) {
+        details::TVec3<T> const c = center[i];
+        details::TVec3<T> const h = halfExtent[i];
+        outCenter[i] = c0 * c.x + c1 * c.y + c2 * c.z + c3;
+        outHalfExtent[i] = a0 * h.x + a1 * h.y + a2 * h.z;
+    }
+}
+
+}  // namespace batch
+}  // namespace math
+}  // namespace filament
+
+#endif // TNT_MATH_BATCH_H
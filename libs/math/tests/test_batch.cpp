@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include <math/batch.h>
+#include <math/mat4.h>
+#include <math/quat.h>
+#include <math/vec3.h>
+
+using namespace filament::math;
+
+class BatchTest : public testing::Test {
+protected:
+    // odd count so the NEON path's scalar tail is exercised
+    static constexpr size_t COUNT = 35;
+
+    std::default_random_engine gen{ 82828 };  // NOLINT
+
+    float3 randomPoint() {
+        std::uniform_real_distribution<float> rand(-100.0f, 100.0f);
+        return { rand(gen), rand(gen), rand(gen) };
+    }
+
+    quatf randomRotation() {
+        std::uniform_real_distribution<float> rand(-1.0f, 1.0f);
+        return normalize(quatf{ rand(gen), rand(gen), rand(gen), rand(gen) });
+    }
+};
+
+TEST_F(BatchTest, TransformPoints) {
+    mat4f const m = mat4f::translation(float3{ 1, -2, 3 }) *
+            mat4f::rotation(1.0f, normalize(float3{ 1, 2, 3 })) *
+            mat4f::scaling(float3{ 0.5f, 2.0f, 1.5f });
+
+    float3 in[COUNT];
+    float3 out[COUNT];
+    for (auto& p : in) {
+        p = randomPoint();
+    }
+
+    batch::transformPoints(m, in, out, COUNT);
+
+    for (size_t i = 0; i < COUNT; i++) {
+        float3 const expected = (m * float4{ in[i], 1 }).xyz;
+        EXPECT_NEAR(out[i].x, expected.x, 1e-4);
+        EXPECT_NEAR(out[i].y, expected.y, 1e-4);
+        EXPECT_NEAR(out[i].z, expected.z, 1e-4);
+    }
+}
+
+TEST_F(BatchTest, ProjectPoints) {
+    mat4f const m = mat4f::perspective(45.0f, 1.25f, 0.1f, 100.0f) *
+            mat4f::lookAt(float3{ 4, 3, 5 }, float3{ 0, 0, 0 }, float3{ 0, 1, 0 });
+
+    float3 in[COUNT];
+    float3 out[COUNT];
+    std::uniform_real_distribution<float> rand(-1.0f, 1.0f);
+    for (auto& p : in) {
+        // keep the points inside the view volume, away from w == 0
+        p = { rand(gen), rand(gen), rand(gen) - 3.0f };
+    }
+
+    batch::projectPoints(m, in, out, COUNT);
+
+    for (size_t i = 0; i < COUNT; i++) {
+        float3 const expected = mat4f::project(m, in[i]);
+        EXPECT_NEAR(out[i].x, expected.x, 1e-4);
+        EXPECT_NEAR(out[i].y, expected.y, 1e-4);
+        EXPECT_NEAR(out[i].z, expected.z, 1e-4);
+    }
+}
+
+TEST_F(BatchTest, SlerpNlerp) {
+    quatf p[COUNT];
+    quatf q[COUNT];
+    quatf s[COUNT];
+    quatf n[COUNT];
+    for (size_t i = 0; i < COUNT; i++) {
+        p[i] = randomRotation();
+        q[i] = randomRotation();
+    }
+
+    float const t = 0.37f;
+    batch::slerp(p, q, t, s, COUNT);
+    batch::nlerp(p, q, t, n, COUNT);
+
+    for (size_t i = 0; i < COUNT; i++) {
+        quatf const es = slerp(p[i], q[i], t);
+        quatf const en = nlerp(p[i], q[i], t);
+        EXPECT_FLOAT_EQ(s[i].w, es.w);
+        EXPECT_FLOAT_EQ(s[i].x, es.x);
+        EXPECT_FLOAT_EQ(n[i].w, en.w);
+        EXPECT_FLOAT_EQ(n[i].x, en.x);
+    }
+}
+
+TEST_F(BatchTest, Mix) {
+    float a[COUNT];
+    float b[COUNT];
+    float out[COUNT];
+    std::uniform_real_distribution<float> rand(0.0f, 1.0f);
+    for (size_t i = 0; i < COUNT; i++) {
+        a[i] = rand(gen);
+        b[i] = rand(gen);
+    }
+
+    float const t = 0.25f;
+    batch::mix(a, b, t, out, COUNT);
+
+    for (size_t i = 0; i < COUNT; i++) {
+        EXPECT_NEAR(out[i], (1.0f - t) * a[i] + t * b[i], 1e-6);
+    }
+}
+
+TEST_F(BatchTest, TransformBoxes) {
+    mat4f const m = mat4f::translation(float3{ 2, 0, -1 }) *
+            mat4f::rotation(0.5f, normalize(float3{ 0, 1, 1 }));
+    mat3f const u = m.upperLeft();
+
+    float3 center[COUNT];
+    float3 halfExtent[COUNT];
+    float3 outCenter[COUNT];
+    float3 outHalfExtent[COUNT];
+    std::uniform_real_distribution<float> rand(0.0f, 10.0f);
+    for (size_t i = 0; i < COUNT; i++) {
+        center[i] = randomPoint();
+        halfExtent[i] = { rand(gen), rand(gen), rand(gen) };
+    }
+
+    batch::transformBoxes(m, center, halfExtent, outCenter, outHalfExtent, COUNT);
+
+    for (size_t i = 0; i < COUNT; i++) {
+        float3 const ec = u * center[i] + m[3].xyz;
+        float3 const eh = abs(u[0]) * halfExtent[i].x +
+                abs(u[1]) * halfExtent[i].y + abs(u[2]) * halfExtent[i].z;
+        EXPECT_NEAR(outCenter[i].x, ec.x, 1e-4);
+        EXPECT_NEAR(outCenter[i].y, ec.y, 1e-4);
+        EXPECT_NEAR(outCenter[i].z, ec.z, 1e-4);
+        EXPECT_NEAR(outHalfExtent[i].x, eh.x, 1e-4);
+        EXPECT_NEAR(outHalfExtent[i].y, eh.y, 1e-4);
+        EXPECT_NEAR(outHalfExtent[i].z, eh.z, 1e-4);
+    }
+}
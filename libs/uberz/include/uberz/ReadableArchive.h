@@ -36,6 +36,13 @@ UTILS_WARNING_ENABLE_PADDED
 // Precompiled set of materials bundled with a list of features flags that each material supports.
 // This is the readable counterpart to WriteableArchive.
 // Used by gltfio; users do not need to access this class directly.
+//
+// Version 0 files are one zstd frame containing the entire archive (metadata followed by
+// packages). Version 1 files store the metadata uncompressed at the front of the file and each
+// package as an independent zstd frame, so readers can parse the spec table without touching
+// package bytes (e.g. from a memory-mapped file) and decompress packages on first use. In both
+// versions packageOffset addresses the file (not the decompressed stream for v1) and
+// packageByteCount is the decompressed package size.
 struct ReadableArchive {
     uint32_t magic;
     uint32_t version;
@@ -244,18 +244,45 @@ FixedCapacityVector<uint8_t> WritableArchive::serialize() const {
         }
     }
     size_t filamatOffset = byteCount;
+
+    // Version 1 archives keep their metadata (header, spec table, flags, names) uncompressed
+    // at the front of the file and store each package as an independent zstd frame. Readers
+    // can then parse the spec table without touching any package bytes, and decompress each
+    // package on first use, directly out of a memory-mapped file if desired.
+
+    // Maximum zstd compression is slow, but that's okay since uberz is invoked during the
+    // build, not at run time. However in debug builds it is debilitatingly slow, and we're
+    // fine with larger archives, so we use minimum compression.
+#ifdef NDEBUG
+    const int compressionLevel = ZSTD_maxCLevel();
+#else
+    const int compressionLevel = ZSTD_minCLevel();
+#endif
+
+    auto compressedPackages =
+            FixedCapacityVector<FixedCapacityVector<uint8_t>>::with_capacity(mMaterials.size());
     for (const auto& mat : mMaterials) {
-        byteCount += mat.package.size();
+        FixedCapacityVector<uint8_t> frame(ZSTD_compressBound(mat.package.size()));
+        size_t const zstdResult = ZSTD_compress(frame.data(), frame.size(),
+                mat.package.data(), mat.package.size(), compressionLevel);
+        if (ZSTD_isError(zstdResult)) {
+            PANIC_POSTCONDITION("Error during archive compression: %s",
+                    ZSTD_getErrorName(zstdResult));
+        }
+        frame.resize(zstdResult);
+        byteCount += zstdResult;
+        compressedPackages.push_back(std::move(frame));
     }
 
     ReadableArchive archive;
     archive.magic = 'UBER';
-    archive.version = 0;
+    archive.version = 1;
     archive.specsCount = mMaterials.size();
     archive.specsOffset = sizeof(ReadableArchive);
 
     auto specs = FixedCapacityVector<ArchiveSpec>::with_capacity(mMaterials.size());
     size_t flagCount = 0;
+    size_t matIndex = 0;
     for (const auto& mat : mMaterials) {
         ArchiveSpec spec = {};
         spec.shadingModel = mat.shadingModel;
@@ -265,7 +292,7 @@ FixedCapacityVector<uint8_t> WritableArchive::serialize() const {
         spec.packageByteCount = mat.package.size();
         spec.packageOffset = filamatOffset;
         specs.push_back(spec);
-        filamatOffset += mat.package.size();
+        filamatOffset += compressedPackages[matIndex++].size();
         flagCount += mat.flags.size();
     }
 
@@ -301,31 +328,13 @@ FixedCapacityVector<uint8_t> WritableArchive::serialize() const {
     writeCursor += sizeof(ArchiveFlag) * flags.size();
     memcpy(writeCursor, flagNames.data(), charCount);
     writeCursor += charCount;
-    for (const auto& mat : mMaterials) {
-        memcpy(writeCursor, mat.package.data(), mat.package.size());
-        writeCursor += mat.package.size();
+    for (const auto& frame : compressedPackages) {
+        memcpy(writeCursor, frame.data(), frame.size());
+        writeCursor += frame.size();
     }
     assert_invariant(writeCursor - outputBuf.data() == outputBuf.size());
 
-    FixedCapacityVector<uint8_t> compressedBuf(ZSTD_compressBound(outputBuf.size()));
-
-    // Maximum zstd compression is slow, but that's okay since uberz is invoked during the build,
-    // not at run time.  However in debug builds it is debilitatingly slow, and we're fine with
-    // larger archives, so we use minimum compression.
-#ifdef NDEBUG
-    const int compressionLevel = ZSTD_maxCLevel();
-#else
-    const int compressionLevel = ZSTD_minCLevel();
-#endif
-
-    size_t zstdResult = ZSTD_compress(compressedBuf.data(), compressedBuf.size(), outputBuf.data(),
-            outputBuf.size(), compressionLevel);
-    if (ZSTD_isError(zstdResult)) {
-        PANIC_POSTCONDITION("Error during archive compression: %s", ZSTD_getErrorName(zstdResult));
-    }
-
-    compressedBuf.resize(zstdResult);
-    return compressedBuf;
+    return outputBuf;
 }
 
 void WritableArchive::setShadingModel(Shading sm) {
@@ -608,12 +608,16 @@ struct HighWatermark {
     void onReset() noexcept;
     void onRewind(void const* addr) noexcept;
     uint32_t getHighWatermark() const noexcept { return mHighWaterMark; }
+    uint32_t getOverflowCount() const noexcept { return mOverflowCount; }
+    // starts a new measurement window, e.g. to observe recent rather than all-time peaks
+    void resetHighWatermark() noexcept { mHighWaterMark = mCurrent; }
 protected:
     const char* mName = nullptr;
     void* mBase = nullptr;
     uint32_t mSize = 0;
     uint32_t mCurrent = 0;
     uint32_t mHighWaterMark = 0;
+    uint32_t mOverflowCount = 0;
 };
 
 // This just fills buffers with known values to help catch uninitialized access and use after free.
@@ -651,6 +655,9 @@ struct DebugAndHighWatermark : protected HighWatermark, protected Debug {
         HighWatermark::onRewind(addr);
         Debug::onRewind(addr);
     }
+    using HighWatermark::getHighWatermark;
+    using HighWatermark::getOverflowCount;
+    using HighWatermark::resetHighWatermark;
 };
 
 } // namespace TrackingPolicy
@@ -31,6 +31,7 @@
 #include <tsl/robin_map.h>
 
 #include <atomic>
+#include <chrono>
 #include <functional>
 #include <mutex>
 #include <type_traits>
@@ -313,6 +314,84 @@ public:
         run(p, id);
     }
 
+    /*
+     * Schedules a job to be automatically run() when another job (and all its children)
+     * finishes, instead of blocking a thread with waitAndRelease() to chain them.
+     *
+     * Must be called before any flavor of run() on `job`. At most one continuation can be
+     * attached to a given job. The continuation is run on the thread that finishes `job`;
+     * it must not be run manually -- like run(), this call consumes it.
+     */
+    void runOnCompletion(Job* job, Job*& continuation) noexcept;
+    void runOnCompletion(Job* job, Job*&& continuation) noexcept {
+        Job* p = continuation;
+        runOnCompletion(job, p);
+    }
+
+    /*
+     * Cooperative yielding for long-running jobs
+     * ------------------------------------------
+     * Jobs always run to completion, so a long job (e.g. asset decompression) holds its
+     * worker thread for its whole duration and can starve latency-critical work sharing the
+     * pool. Instead of over-subscribing threads, such jobs can be written as resumable
+     * segments: the job's functor polls shouldYield() at convenient checkpoints and, when it
+     * returns true, saves its progress and returns false to give up its worker; the remainder
+     * is re-enqueued automatically once the urgent work has drained. Returning true from the
+     * functor signals completion.
+     *
+     * Urgency is signaled with a nestable scope, typically around frame preparation:
+     *     js.raiseUrgentWork();
+     *     ... create and run latency-critical jobs ...
+     *     js.lowerUrgentWork();    // yielded segments resume here
+     *
+     * The functor must be movable: yielding moves it into the job created for the next
+     * segment. All segments are parented to the original parent, so waiters must wait on
+     * the parent; waiting on the job itself would return after its first segment.
+     */
+
+    // Marks the start of a scope during which cooperative jobs are asked to yield.
+    // Can be called from any thread.
+    void raiseUrgentWork() noexcept;
+
+    // Closes a scope opened with raiseUrgentWork() and, when the last scope closes,
+    // re-enqueues the yielded segments. Must be called from a thread owned by JobSystem's
+    // thread pool (see adopt()).
+    void lowerUrgentWork() noexcept;
+
+    // Whether cooperative jobs should yield at their next checkpoint. Can be called from
+    // any thread, but is only meaningful from within a job's function.
+    bool shouldYield() const noexcept {
+        return mUrgentWorkScopes.load(std::memory_order_relaxed) != 0;
+    }
+
+    // creates a cooperative job from a functor passed by value; the functor returns true
+    // when the work is complete, or false to yield (see above)
+    template<typename T>
+    Job* createCooperativeJob(Job* parent, T functor) noexcept {
+        static_assert(sizeof(functor) <= sizeof(Job::storage), "functor too large");
+        Job* job = create(parent, [](void* storage, JobSystem& js, Job* job) {
+            T* const that = static_cast<T*>(storage);
+            if (UTILS_LIKELY(that->operator()(js, job))) {
+                that->~T();
+                return;
+            }
+            // the functor yielded: move the remainder into a fresh job parented like this
+            // one -- so waiters on the parent keep waiting -- and park it until the urgent
+            // work that triggered the yield has drained.
+            Job* const parent = job->parent == 0x7FFF ? nullptr :
+                    &js.mJobStorageBase[job->parent];
+            Job* const next = js.createCooperativeJob(parent, std::move(*that));
+            that->~T();
+            if (UTILS_LIKELY(next)) {
+                js.park(next);
+            }
+        });
+        if (job) {
+            new(job->storage) T(std::move(functor));
+        }
+        return job;
+    }
+
     /*
      * Add job to this thread's execution queue and keep a reference to it.
      * The current thread must be owned by JobSystem's thread pool. See adopt().
@@ -362,6 +441,15 @@ public:
     static void setThreadPriority(Priority priority) noexcept;
     static void setThreadAffinityById(size_t id) noexcept;
 
+    // Restricts the current thread to the set of cores in cpuMask (one bit per cpu id).
+    static void setThreadAffinityByMask(uint64_t cpuMask) noexcept;
+
+    // Restricts all of this JobSystem's worker threads to the set of cores in cpuMask
+    // (one bit per cpu id), e.g. to keep latency-critical jobs on the "big" cores of
+    // heterogeneous CPUs. Adopted threads are not affected. This is a hint; it's a no-op
+    // on platforms without thread-affinity support.
+    void setWorkerAffinityByMask(uint64_t cpuMask) noexcept;
+
     size_t getParallelSplitCount() const noexcept {
         return mParallelSplitCount;
     }
@@ -421,6 +509,7 @@ private:
     Job* allocateJob() noexcept;
     JobSystem::ThreadState* getStateToStealFrom(JobSystem::ThreadState& state) noexcept;
     static bool hasJobCompleted(Job const* job) noexcept;
+    Job* takeContinuation(Job const* job) noexcept;
 
     void requestExit() noexcept;
     bool exitRequested() const noexcept;
@@ -431,6 +520,9 @@ private:
     Job* steal(JobSystem::ThreadState& state) noexcept;
     void finish(Job* job) noexcept;
 
+    void park(Job* job) noexcept;
+    void flushYieldedJobs() noexcept;
+
     void put(WorkQueue& workQueue, Job* job) noexcept;
     Job* pop(WorkQueue& workQueue) noexcept;
     Job* steal(WorkQueue& workQueue) noexcept;
@@ -468,6 +560,17 @@ private:
 
     Mutex mThreadMapLock; // this should have very little contention
     tsl::robin_map<std::thread::id, ThreadState *> mThreadMap;
+
+    // continuations are rare, finish() only looks at the map when the count is non-zero
+    std::atomic<uint32_t> mContinuationCount = { 0 };
+    Mutex mContinuationLock; // this should have very little contention
+    tsl::robin_map<uint16_t, Job*> mContinuations;
+
+    // cooperative jobs only yield while an urgent-work scope is active, so this list is
+    // empty most of the time and the lock has very little contention
+    std::atomic<uint32_t> mUrgentWorkScopes = { 0 };
+    Mutex mYieldedLock;
+    std::vector<Job*> mYieldedJobs;
 };
 
 // -------------------------------------------------------------------------------------------------
@@ -513,6 +616,14 @@ JobSystem::Job* createJob(JobSystem& js, JobSystem::Job* parent,
 
 namespace details {
 
+// detects splitters that want to be fed per-chunk execution timings
+template<typename S, typename = void>
+struct is_timed_splitter : std::false_type {};
+
+template<typename S>
+struct is_timed_splitter<S, std::void_t<decltype(
+        std::declval<S&>().onChunkExecuted(uint32_t(0), uint64_t(0)))>> : std::true_type {};
+
 template<typename S, typename F>
 struct ParallelForJobData {
     using SplitterType = S;
@@ -557,7 +668,15 @@ right_side:
         } else {
 execute:
             // we're done splitting, do the real work here!
-            functor(start, count);
+            if constexpr (is_timed_splitter<SplitterType>::value) {
+                auto const t0 = std::chrono::steady_clock::now();
+                functor(start, count);
+                auto const t1 = std::chrono::steady_clock::now();
+                splitter.onChunkExecuted(count, uint64_t(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()));
+            } else {
+                functor(start, count);
+            }
         }
     }
 
@@ -609,6 +728,51 @@ public:
     }
 };
 
+// A splitter that calibrates its own grain size, targeting chunks of approximately
+// TARGET_MICROSECONDS of work each. The per-item cost is measured when chunks execute
+// and blended into a State object that the caller keeps alive across invocations
+// (typically across frames), so the grain converges after a few uses and adapts to the
+// device instead of being hand-tuned like CountSplitter's COUNT.
+template<size_t TARGET_MICROSECONDS = 50, size_t MAX_SPLITS = 12>
+class TimingSplitter {
+    // per-item cost is stored in 1/1024ths of a nanosecond, so that items cheaper
+    // than a nanosecond don't round down to "free"
+    static constexpr size_t FIXED_SHIFT = 10;
+
+public:
+    class State {
+        friend class TimingSplitter;
+        std::atomic<uint64_t> scaledNanosPerItem = { 0 };
+    };
+
+    explicit TimingSplitter(State& state) noexcept: mState(&state) {}
+
+    bool split(size_t splits, size_t count) const noexcept {
+        uint64_t const costPerItem = mState->scaledNanosPerItem.load(std::memory_order_relaxed);
+        if (UTILS_UNLIKELY(costPerItem == 0)) {
+            // not calibrated yet, split all the way down so we gather timings quickly
+            return splits < MAX_SPLITS && count >= 2;
+        }
+        uint64_t const grain = ((TARGET_MICROSECONDS * 1000u) << FIXED_SHIFT) / costPerItem;
+        return splits < MAX_SPLITS && count >= 2 * (grain > 1 ? grain : 1);
+    }
+
+    void onChunkExecuted(uint32_t count, uint64_t nanos) noexcept {
+        if (UTILS_UNLIKELY(count == 0)) {
+            return;
+        }
+        uint64_t const cost = (nanos << FIXED_SHIFT) / count;
+        // exponential moving average; a lost update between load and store just drops
+        // one sample, which is fine for a heuristic
+        uint64_t const current = mState->scaledNanosPerItem.load(std::memory_order_relaxed);
+        uint64_t const next = current ? (current * 7 + cost) / 8 : cost;
+        mState->scaledNanosPerItem.store(next, std::memory_order_relaxed);
+    }
+
+private:
+    State* mState;
+};
+
 } // namespace jobs
 } // namespace utils
 
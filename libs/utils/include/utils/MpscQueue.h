@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_UTILS_MPSCQUEUE_H
+#define TNT_UTILS_MPSCQUEUE_H
+
+#include <utils/architecture.h>
+
+#include <atomic>
+#include <utility>
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace utils {
+
+/*
+ * A templated, lockless, bounded multi-producer single-consumer queue
+ *
+ *
+ *      head                         tail
+ *       v                             v
+ *       |----|----|----|----|----|----|
+ *    drain(), pop()               push()
+ *  single consumer thread         any thread
+ *
+ * Each slot carries a sequence number (Vyukov-style), so producers never touch the
+ * consumer's index and vice-versa; head and tail live on their own cache lines.
+ *
+ * References:
+ * - https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+ */
+template<typename TYPE, size_t COUNT>
+class MpscQueue {
+    static_assert(!(COUNT & (COUNT - 1)), "COUNT must be a power of two");
+    static constexpr size_t MASK = COUNT - 1;
+
+    struct Cell {
+        std::atomic<uint64_t> sequence;
+        TYPE item;
+    };
+
+    // written by producers with a CAS, read by the consumer only to compute size()
+    alignas(CACHELINE_SIZE) std::atomic<uint64_t> mTail = { 0 };
+
+    // only ever accessed by the consumer thread
+    alignas(CACHELINE_SIZE) uint64_t mHead = 0;
+
+    alignas(CACHELINE_SIZE) Cell mItems[COUNT];
+
+public:
+    using value_type = TYPE;
+
+    MpscQueue() noexcept {
+        for (size_t i = 0; i < COUNT; i++) {
+            mItems[i].sequence.store(uint64_t(i), std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(MpscQueue const&) = delete;
+    MpscQueue& operator=(MpscQueue const&) = delete;
+
+    // Attempts to enqueue an item. Returns false if the queue is full. Can be called
+    // from any thread.
+    inline bool push(TYPE item) noexcept;
+
+    // Dequeues a single item. Returns false if the queue is empty. Must only be called
+    // from the consumer thread.
+    inline bool pop(TYPE& out) noexcept;
+
+    // Dequeues everything currently in the queue, invoking consumer(TYPE&&) for each
+    // item, and returns the number of items drained. Must only be called from the
+    // consumer thread. Items pushed concurrently with the drain are picked up either
+    // by this call or the next one.
+    template<typename CONSUMER>
+    inline size_t drain(CONSUMER&& consumer) noexcept;
+
+    size_t getSize() const noexcept { return COUNT; }
+
+    // for debugging only...
+    size_t getCount() const noexcept {
+        uint64_t const tail = mTail.load(std::memory_order_relaxed);
+        return size_t(tail - mHead);
+    }
+};
+
+template<typename TYPE, size_t COUNT>
+bool MpscQueue<TYPE, COUNT>::push(TYPE item) noexcept {
+    uint64_t pos = mTail.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell& cell = mItems[pos & MASK];
+        uint64_t const seq = cell.sequence.load(std::memory_order_acquire);
+        int64_t const diff = int64_t(seq) - int64_t(pos);
+        if (diff == 0) {
+            // the slot is free, try to claim it
+            if (mTail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                cell.item = std::move(item);
+                // publish the item to the consumer
+                cell.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+            // CAS failed, `pos` was reloaded, try again
+        } else if (diff < 0) {
+            // the slot is still occupied by an item the consumer hasn't drained
+            return false;
+        } else {
+            // another producer claimed this slot, catch up
+            pos = mTail.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+template<typename TYPE, size_t COUNT>
+bool MpscQueue<TYPE, COUNT>::pop(TYPE& out) noexcept {
+    Cell& cell = mItems[mHead & MASK];
+    uint64_t const seq = cell.sequence.load(std::memory_order_acquire);
+    if (int64_t(seq) - int64_t(mHead + 1) != 0) {
+        // empty, or a producer has claimed the slot but not published it yet
+        return false;
+    }
+    out = std::move(cell.item);
+    // hand the slot back to the producers, for the next time the indices wrap around
+    cell.sequence.store(mHead + COUNT, std::memory_order_release);
+    ++mHead;
+    return true;
+}
+
+template<typename TYPE, size_t COUNT>
+template<typename CONSUMER>
+size_t MpscQueue<TYPE, COUNT>::drain(CONSUMER&& consumer) noexcept {
+    size_t drained = 0;
+    for (;;) {
+        Cell& cell = mItems[mHead & MASK];
+        uint64_t const seq = cell.sequence.load(std::memory_order_acquire);
+        if (int64_t(seq) - int64_t(mHead + 1) != 0) {
+            break;
+        }
+        consumer(std::move(cell.item));
+        cell.sequence.store(mHead + COUNT, std::memory_order_release);
+        ++mHead;
+        ++drained;
+    }
+    return drained;
+}
+
+} // namespace utils
+
+#endif // TNT_UTILS_MPSCQUEUE_H
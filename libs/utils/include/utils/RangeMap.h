@@ -180,6 +180,17 @@ public:
      */
     size_t rangeCount() const noexcept { return mMap.size(); }
 
+    /**
+     * Invokes the given functor for each interval in ascending key order, passing the
+     * interval and the value it maps to.
+     */
+    template<typename F>
+    void forEachRange(F&& func) const noexcept {
+        for (ConstIterator iter = begin(); iter != end(); ++iter) {
+            func(getRange(iter), getValue(iter));
+        }
+    }
+
 private:
 
     using Map = std::map<KeyType, std::pair<Range<KeyType>, ValueType>>;
@@ -226,18 +226,27 @@ protected:
     template<typename REMOVE>
     void gc(const EntityManager& em,
             REMOVE&& removeComponent) noexcept {
-        gc(em, 4, std::forward<REMOVE>(removeComponent));
+        gc(em, 4, size_t(-1), std::forward<REMOVE>(removeComponent));
     }
 
     template<typename REMOVE>
     void gc(const EntityManager& em, size_t ratio,
             REMOVE&& removeComponent) noexcept {
+        gc(em, ratio, size_t(-1), std::forward<REMOVE>(removeComponent));
+    }
+
+    // `budget` caps the number of components removed by this sweep, so the cost of a mass
+    // destruction can be spread over several frames instead of compacting the storage for
+    // all the dead entities at once; the remainder is picked up by later sweeps.
+    template<typename REMOVE>
+    void gc(const EntityManager& em, size_t ratio, size_t budget,
+            REMOVE&& removeComponent) noexcept {
         Entity const* const pEntities = begin<ENTITY_INDEX>();
         size_t count = getComponentCount();
         size_t aliveInARow = 0;
         default_random_engine& rng = mRng;
         UTILS_NOUNROLL
-        while (count && aliveInARow < ratio) {
+        while (count && budget && aliveInARow < ratio) {
             assert_invariant(count == getComponentCount());
             // note: using the modulo favorizes lower number
             size_t const i = rng() % count;
@@ -249,6 +258,7 @@ protected:
             }
             removeComponent(entity);
             aliveInARow = 0;
+            budget--;
             count--;
         }
     }
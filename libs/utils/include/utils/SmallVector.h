@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_UTILS_SMALLVECTOR_H
+#define TNT_UTILS_SMALLVECTOR_H
+
+#include <utils/compiler.h>
+#include <utils/debug.h>
+
+#include <memory>
+#include <utility>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace utils {
+
+/*
+ * A growable vector that stores its first N elements in-object and only allocates from the
+ * heap once it grows past N. Intended for hot-path bookkeeping where the common case is
+ * known to be small (e.g. the render targets declared by a frame graph pass), so that the
+ * per-frame malloc/free traffic of a regular vector disappears.
+ *
+ * Unlike FixedCapacityVector, the capacity is not fixed: exceeding the inline storage is
+ * legal and spills to the heap with geometric growth. The implementation supports only
+ * what the hot paths need; in particular it's movable but not copyable.
+ */
+template<typename T, size_t N>
+class UTILS_PUBLIC SmallVector {
+    static_assert(N > 0, "SmallVector needs a non-zero inline capacity");
+
+public:
+    using value_type = T;
+    using reference = T&;
+    using const_reference = T const&;
+    using size_type = uint32_t;
+    using iterator = T*;
+    using const_iterator = T const*;
+
+    SmallVector() noexcept = default;
+
+    SmallVector(SmallVector const&) = delete;
+    SmallVector& operator=(SmallVector const&) = delete;
+
+    SmallVector(SmallVector&& rhs) noexcept {
+        if (rhs.onHeap()) {
+            // steal the heap storage
+            mData = rhs.mData;
+            mSize = rhs.mSize;
+            mCapacity = rhs.mCapacity;
+            rhs.mData = rhs.inlineStorage();
+            rhs.mSize = 0;
+            rhs.mCapacity = N;
+        } else {
+            mSize = rhs.mSize;
+            std::uninitialized_move(rhs.begin(), rhs.end(), begin());
+            rhs.clear();
+        }
+    }
+
+    SmallVector& operator=(SmallVector&& rhs) noexcept {
+        if (this != &rhs) {
+            this->~SmallVector();
+            new(this) SmallVector(std::move(rhs));
+        }
+        return *this;
+    }
+
+    ~SmallVector() noexcept {
+        std::destroy(begin(), end());
+        if (onHeap()) {
+            std::allocator<T>().deallocate(mData, mCapacity);
+        }
+    }
+
+    size_t size() const noexcept { return mSize; }
+    size_t capacity() const noexcept { return mCapacity; }
+    bool empty() const noexcept { return mSize == 0; }
+
+    T* data() noexcept { return mData; }
+    T const* data() const noexcept { return mData; }
+
+    iterator begin() noexcept { return mData; }
+    iterator end() noexcept { return mData + mSize; }
+    const_iterator begin() const noexcept { return mData; }
+    const_iterator end() const noexcept { return mData + mSize; }
+
+    reference operator[](size_t i) noexcept {
+        assert_invariant(i < mSize);
+        return mData[i];
+    }
+
+    const_reference operator[](size_t i) const noexcept {
+        assert_invariant(i < mSize);
+        return mData[i];
+    }
+
+    reference back() noexcept { return mData[mSize - 1]; }
+    const_reference back() const noexcept { return mData[mSize - 1]; }
+
+    template<typename ... ARGS>
+    reference emplace_back(ARGS&& ... args) {
+        if (UTILS_UNLIKELY(mSize == mCapacity)) {
+            grow();
+        }
+        T* const p = new(mData + mSize) T(std::forward<ARGS>(args)...);
+        mSize++;
+        return *p;
+    }
+
+    void push_back(T const& v) { emplace_back(v); }
+    void push_back(T&& v) { emplace_back(std::move(v)); }
+
+    void pop_back() noexcept {
+        assert_invariant(mSize > 0);
+        mSize--;
+        std::destroy_at(mData + mSize);
+    }
+
+    void clear() noexcept {
+        std::destroy(begin(), end());
+        mSize = 0;
+    }
+
+private:
+    T* inlineStorage() noexcept { return reinterpret_cast<T*>(mStorage); }
+    T const* inlineStorage() const noexcept { return reinterpret_cast<T const*>(mStorage); }
+
+    bool onHeap() const noexcept { return mData != inlineStorage(); }
+
+    UTILS_NOINLINE
+    void grow() {
+        size_type const capacity = mCapacity * 2;
+        T* const data = std::allocator<T>().allocate(capacity);
+        std::uninitialized_move(begin(), end(), data);
+        std::destroy(begin(), end());
+        if (onHeap()) {
+            std::allocator<T>().deallocate(mData, mCapacity);
+        }
+        mData = data;
+        mCapacity = capacity;
+    }
+
+    alignas(T) char mStorage[N * sizeof(T)];
+    T* mData = inlineStorage();
+    size_type mSize = 0;
+    size_type mCapacity = N;
+};
+
+} // namespace utils
+
+#endif // TNT_UTILS_SMALLVECTOR_H
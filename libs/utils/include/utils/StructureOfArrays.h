@@ -19,6 +19,7 @@
 
 #include <type_traits>
 #include <utils/Allocator.h>
+#include <utils/architecture.h>
 #include <utils/compiler.h>
 #include <utils/debug.h>
 #include <utils/Slice.h>
@@ -413,6 +414,43 @@ public:
         });
     }
 
+    /*
+     * Calls f(index, fields...) for each element in [first, last), where fields... are
+     * references into the selected arrays, e.g.:
+     *
+     *   soa.forEachElement<POSITION, RADIUS>(first, last,
+     *           [](size_t i, float3& position, float& radius) { ... });
+     *
+     * Upcoming cache lines of each selected array are software-prefetched, which helps loops
+     * that gather from several arrays and do only a little work per element. A JobSystem-parallel
+     * version with automatic range splitting is obtained by composing with the index-based
+     * jobs::parallel_for() (see JobSystem.h):
+     *
+     *   jobs::parallel_for(js, parent, first, count,
+     *           [&soa, f](uint32_t start, uint32_t count) {
+     *               soa.forEachElement<POSITION, RADIUS>(start, start + count, f);
+     *           }, jobs::CountSplitter<64>());
+     */
+    template<size_t ... ElementIndices, typename F>
+    void forEachElement(size_t first, size_t last, F&& f) {
+        for (size_t i = first; i < last; i++) {
+            // two cache lines ahead is enough to cover the per-element work of typical loops,
+            // without evicting lines we're about to use when many arrays are selected
+            (UTILS_PREFETCH(reinterpret_cast<char const*>(
+                    std::get<ElementIndices>(mArrays) + i) + 2 * CACHELINE_SIZE), ...);
+            f(i, std::get<ElementIndices>(mArrays)[i]...);
+        }
+    }
+
+    template<size_t ... ElementIndices, typename F>
+    void forEachElement(size_t first, size_t last, F&& f) const {
+        for (size_t i = first; i < last; i++) {
+            (UTILS_PREFETCH(reinterpret_cast<char const*>(
+                    data<ElementIndices>() + i) + 2 * CACHELINE_SIZE), ...);
+            f(i, data<ElementIndices>()[i]...);
+        }
+    }
+
     // return a pointer to the first element of the ElementIndex]th array
     template<size_t ElementIndex>
     TypeAt<ElementIndex>* data() noexcept {
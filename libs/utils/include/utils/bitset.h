@@ -85,9 +85,26 @@ public:
         storage[0] = value;
     }
 
+    // number of storage words in a 256-bit block, used to skip fully-clear regions in bulk
+    static constexpr size_t WORDS_PER_BLOCK = 32 / sizeof(T);
+
     template<typename F>
     void forEachSetBit(F exec) const noexcept {
         for (size_t i = 0; i < N; i++) {
+            // skip fully-clear 256-bit blocks with a single load-and-test; sparse masks,
+            // such as per-froxel light lists, are the common case
+            if constexpr (N % WORDS_PER_BLOCK == 0 && N > WORDS_PER_BLOCK) {
+                if (i % WORDS_PER_BLOCK == 0) {
+                    T m = storage[i];
+                    for (size_t j = 1; j < WORDS_PER_BLOCK; j++) {
+                        m |= storage[i + j];
+                    }
+                    if (m == 0) {
+                        i += WORDS_PER_BLOCK - 1;
+                        continue;
+                    }
+                }
+            }
             T v = storage[i];
             while (v) {
                 T k = utils::ctz(v);
@@ -97,6 +114,43 @@ public:
         }
     }
 
+    /*
+     * Writes the indices of all set bits to `indices`, which must have room for
+     * min(count(), maxCount) entries, and returns the number of indices written.
+     * Prefer this to forEachSetBit() when the result is an index list anyway: the
+     * compaction loop is branch-light (one ctz per set bit) and clear 256-bit blocks
+     * are skipped in bulk.
+     */
+    template<typename IndexType>
+    size_t gatherSetBits(IndexType* UTILS_RESTRICT indices,
+            size_t maxCount = BIT_COUNT) const noexcept {
+        size_t n = 0;
+        for (size_t i = 0; i < N; i++) {
+            if constexpr (N % WORDS_PER_BLOCK == 0 && N > WORDS_PER_BLOCK) {
+                if (i % WORDS_PER_BLOCK == 0) {
+                    T m = storage[i];
+                    for (size_t j = 1; j < WORDS_PER_BLOCK; j++) {
+                        m |= storage[i + j];
+                    }
+                    if (m == 0) {
+                        i += WORDS_PER_BLOCK - 1;
+                        continue;
+                    }
+                }
+            }
+            T v = storage[i];
+            while (v) {
+                T const k = utils::ctz(v);
+                v &= v - T(1);  // clears the lowest set bit
+                indices[n++] = IndexType(k + BITS_PER_WORD * i);
+                if (UTILS_UNLIKELY(n >= maxCount)) {
+                    return n;
+                }
+            }
+        }
+        return n;
+    }
+
     size_t size() const noexcept { return N * BITS_PER_WORD; }
 
     bool empty() const noexcept { return none(); }
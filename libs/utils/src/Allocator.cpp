@@ -155,6 +155,11 @@ AtomicFreeList::AtomicFreeList(void* begin, void* end,
 
 void TrackingPolicy::HighWatermark::onAlloc(
         void* p, size_t size, size_t alignment, size_t extra) noexcept {
+    if (UTILS_UNLIKELY(!p)) {
+        // the underlying allocator couldn't satisfy this allocation
+        mOverflowCount++;
+        return;
+    }
     mCurrent += uint32_t(size);
     mHighWaterMark = mCurrent > mHighWaterMark ? mCurrent : mHighWaterMark;
 }
@@ -170,6 +170,37 @@ void JobSystem::setThreadAffinityById(size_t id) noexcept {
 #endif
 }
 
+void JobSystem::setThreadAffinityByMask(uint64_t cpuMask) noexcept {
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (size_t cpu = 0; cpu < 64; cpu++) {
+        if (cpuMask & (uint64_t(1) << cpu)) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    sched_setaffinity(gettid(), sizeof(set), &set);
+#endif
+}
+
+void JobSystem::setWorkerAffinityByMask(uint64_t cpuMask) noexcept {
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (size_t cpu = 0; cpu < 64; cpu++) {
+        if (cpuMask & (uint64_t(1) << cpu)) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    for (size_t i = 0, n = mThreadCount; i < n; i++) {
+        std::thread& thread = mThreadStates[i].thread;
+        if (thread.joinable()) {
+            pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+        }
+    }
+#endif
+}
+
 JobSystem::JobSystem(const size_t userThreadCount, const size_t adoptableThreadsCount) noexcept
     : mJobPool("JobSystem Job pool", MAX_JOB_COUNT * sizeof(Job)),
       mJobStorageBase(static_cast<Job *>(mJobPool.getAllocator().getCurrent()))
@@ -218,6 +249,10 @@ JobSystem::JobSystem(const size_t userThreadCount, const size_t adoptableThreads
 }
 
 JobSystem::~JobSystem() {
+    // urgent-work scopes must be balanced before tearing down, otherwise yielded
+    // cooperative segments would never have resumed
+    assert_invariant(mYieldedJobs.empty());
+
     requestExit();
 
     #pragma nounroll
@@ -480,6 +515,13 @@ void JobSystem::finish(Job* job) noexcept {
             if (waiters) {
                 notify = true;
             }
+            // if a continuation was attached to this job, it becomes runnable now
+            if (UTILS_UNLIKELY(mContinuationCount.load(std::memory_order_relaxed) > 0)) {
+                Job* const continuation = takeContinuation(job);
+                if (continuation) {
+                    put(getState().workQueue, continuation);
+                }
+            }
             Job* const parent = job->parent == 0x7FFF ? nullptr : &storage[job->parent];
             decRef(job);
             job = parent;
@@ -563,6 +605,74 @@ void JobSystem::run(Job*& job, uint8_t id) noexcept {
     job = nullptr;
 }
 
+UTILS_NOINLINE
+JobSystem::Job* JobSystem::takeContinuation(Job const* job) noexcept {
+    Job* continuation = nullptr;
+    std::lock_guard<Mutex> const lock(mContinuationLock);
+    auto pos = mContinuations.find(uint16_t(job - mJobStorageBase));
+    if (pos != mContinuations.end()) {
+        continuation = pos->second;
+        mContinuations.erase(pos);
+        mContinuationCount.fetch_sub(1, std::memory_order_relaxed);
+    }
+    return continuation;
+}
+
+void JobSystem::runOnCompletion(Job* job, Job*& continuation) noexcept {
+    assert(job);
+    assert(continuation);
+    size_t const index = job - mJobStorageBase;
+    assert(index < MAX_JOB_COUNT);
+    std::unique_lock<Mutex> lock(mContinuationLock);
+    UTILS_UNUSED_IN_RELEASE auto const inserted =
+            mContinuations.emplace(uint16_t(index), continuation).second;
+    // at most one continuation can be attached to a job
+    assert(inserted);
+    mContinuationCount.fetch_add(1, std::memory_order_relaxed);
+    lock.unlock();
+
+    // after runOnCompletion() returns, the continuation is virtually invalid
+    // (it'll be run and die on its own)
+    continuation = nullptr;
+}
+
+void JobSystem::raiseUrgentWork() noexcept {
+    mUrgentWorkScopes.fetch_add(1, std::memory_order_relaxed);
+}
+
+void JobSystem::lowerUrgentWork() noexcept {
+    uint32_t const scopes = mUrgentWorkScopes.fetch_sub(1, std::memory_order_relaxed);
+    assert_invariant(scopes > 0);
+    if (scopes == 1) {
+        // the last urgent-work scope closed, resume the yielded segments
+        flushYieldedJobs();
+    }
+}
+
+UTILS_NOINLINE
+void JobSystem::park(Job* job) noexcept {
+    std::unique_lock<Mutex> lock(mYieldedLock);
+    mYieldedJobs.push_back(job);
+    lock.unlock();
+    // if the last urgent-work scope closed while we were parking, its flush may have missed
+    // this job; flushing again here guarantees it can't be stranded
+    if (UTILS_UNLIKELY(!shouldYield())) {
+        flushYieldedJobs();
+    }
+}
+
+UTILS_NOINLINE
+void JobSystem::flushYieldedJobs() noexcept {
+    std::vector<Job*> yielded;
+    {
+        std::lock_guard<Mutex> const lock(mYieldedLock);
+        yielded.swap(mYieldedJobs);
+    }
+    for (Job* job : yielded) {
+        run(job);
+    }
+}
+
 JobSystem::Job* JobSystem::runAndRetain(Job* job) noexcept {
     JobSystem::Job* retained = retain(job);
     run(job);
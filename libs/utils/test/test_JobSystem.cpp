@@ -253,6 +253,75 @@ TEST(JobSystem, JobSystemSequentialChildren) {
 }
 
 
+TEST(JobSystem, JobSystemContinuation) {
+    JobSystem js;
+    js.adopt();
+
+    std::atomic_int order = {0};
+
+    JobSystem::Job* root = js.createJob(nullptr);
+    JobSystem::Job* first = js.createJob(root, [&order](JobSystem&, JobSystem::Job*) {
+        int expected = 0;
+        order.compare_exchange_strong(expected, 1);
+    });
+    JobSystem::Job* continuation = js.createJob(root, [&order](JobSystem&, JobSystem::Job*) {
+        // must see the effects of `first`
+        int expected = 1;
+        order.compare_exchange_strong(expected, 2);
+    });
+
+    js.runOnCompletion(first, continuation);
+    // like run(), runOnCompletion() consumes the continuation
+    EXPECT_EQ(nullptr, continuation);
+
+    js.run(first);
+    js.runAndWait(root);
+
+    EXPECT_EQ(2, order.load());
+
+    js.emancipate();
+}
+
+
+TEST(JobSystem, JobSystemCooperativeYield) {
+    JobSystem js;
+    js.adopt();
+
+    std::atomic_int yields = {0};
+    std::atomic_int runs = {0};
+
+    js.raiseUrgentWork();
+    EXPECT_TRUE(js.shouldYield());
+
+    JobSystem::Job* root = js.createJob(nullptr);
+    JobSystem::Job* job = js.createCooperativeJob(root,
+            [&yields, &runs](JobSystem& js, JobSystem::Job*) -> bool {
+        if (js.shouldYield()) {
+            yields++;
+            return false;
+        }
+        runs++;
+        return true;
+    });
+    js.run(job);
+
+    // wait until the first segment has run and yielded...
+    while (yields.load() == 0) {
+        std::this_thread::yield();
+    }
+
+    // ...then closing the urgent-work scope resumes it
+    js.lowerUrgentWork();
+    js.runAndWait(root);
+
+    EXPECT_FALSE(js.shouldYield());
+    EXPECT_GE(yields.load(), 1);
+    EXPECT_EQ(1, runs.load());
+
+    js.emancipate();
+}
+
+
 TEST(JobSystem, JobSystemParallelFor) {
     JobSystem js;
     js.adopt();
@@ -284,6 +353,34 @@ TEST(JobSystem, JobSystemParallelFor) {
     js.emancipate();
 }
 
+TEST(JobSystem, JobSystemParallelForTimingSplitter) {
+    JobSystem js;
+    js.adopt();
+
+    jobs::TimingSplitter<>::State state;
+
+    std::array<std::atomic_int, 4096> counts{};
+    auto work = [&counts](uint32_t start, uint32_t count) {
+        for (uint32_t i = start; i < start + count; i++) {
+            counts[i]++;
+        }
+    };
+
+    // run a few times so the splitter gets a chance to calibrate; every item must
+    // still be visited exactly once per run, whatever grain size is chosen
+    for (int run = 1; run <= 4; run++) {
+        auto* job = jobs::parallel_for(js, nullptr, 0, uint32_t(counts.size()),
+                std::ref(work), jobs::TimingSplitter<>(state));
+        js.runAndWait(job);
+        for (auto const& c : counts) {
+            EXPECT_EQ(run, c.load());
+        }
+    }
+
+    js.emancipate();
+}
+
+
 TEST(JobSystem, JobSystemDelegates) {
     JobSystem js;
     js.adopt();
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <utils/MpscQueue.h>
+
+#include <thread>
+#include <vector>
+
+using namespace utils;
+
+TEST(MpscQueueTest, SingleThreaded) {
+    MpscQueue<int, 8> queue;
+    EXPECT_EQ(queue.getCount(), 0);
+
+    int v = 0;
+    EXPECT_FALSE(queue.pop(v));
+
+    for (int i = 0; i < 8; i++) {
+        EXPECT_TRUE(queue.push(i));
+    }
+    // queue is now full
+    EXPECT_FALSE(queue.push(8));
+    EXPECT_EQ(queue.getCount(), 8);
+
+    for (int i = 0; i < 8; i++) {
+        EXPECT_TRUE(queue.pop(v));
+        EXPECT_EQ(v, i);
+    }
+    EXPECT_FALSE(queue.pop(v));
+}
+
+TEST(MpscQueueTest, WrapAround) {
+    MpscQueue<int, 4> queue;
+    int v = 0;
+    // cycle through the buffer several times to exercise the sequence wrap-around
+    for (int i = 0; i < 64; i++) {
+        EXPECT_TRUE(queue.push(i));
+        EXPECT_TRUE(queue.push(i + 1000));
+        EXPECT_TRUE(queue.pop(v));
+        EXPECT_EQ(v, i);
+        EXPECT_TRUE(queue.pop(v));
+        EXPECT_EQ(v, i + 1000);
+    }
+}
+
+TEST(MpscQueueTest, Drain) {
+    MpscQueue<int, 16> queue;
+    for (int i = 0; i < 10; i++) {
+        EXPECT_TRUE(queue.push(i));
+    }
+    int sum = 0;
+    size_t const drained = queue.drain([&sum](int&& v) { sum += v; });
+    EXPECT_EQ(drained, 10);
+    EXPECT_EQ(sum, 45);
+    EXPECT_EQ(queue.drain([](int&&) {}), 0);
+}
+
+TEST(MpscQueueTest, MultiProducer) {
+    constexpr size_t PRODUCER_COUNT = 4;
+    constexpr size_t ITEM_COUNT = 1u << 14;
+
+    MpscQueue<size_t, 256> queue;
+
+    std::vector<std::thread> producers;
+    producers.reserve(PRODUCER_COUNT);
+    for (size_t t = 0; t < PRODUCER_COUNT; t++) {
+        producers.emplace_back([&queue] {
+            for (size_t i = 1; i <= ITEM_COUNT; i++) {
+                while (!queue.push(i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    size_t drained = 0;
+    size_t sum = 0;
+    while (drained < PRODUCER_COUNT * ITEM_COUNT) {
+        drained += queue.drain([&sum](size_t&& v) { sum += v; });
+    }
+
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    EXPECT_EQ(drained, PRODUCER_COUNT * ITEM_COUNT);
+    EXPECT_EQ(sum, PRODUCER_COUNT * (ITEM_COUNT * (ITEM_COUNT + 1)) / 2);
+    EXPECT_EQ(queue.getCount(), 0);
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <utils/SmallVector.h>
+
+#include <memory>
+
+using namespace utils;
+
+TEST(SmallVectorTest, Simple) {
+    SmallVector<int, 4> v;
+    EXPECT_TRUE(v.empty());
+    EXPECT_EQ(0, v.size());
+    EXPECT_EQ(4, v.capacity());
+
+    for (int i = 0; i < 4; i++) {
+        v.push_back(i);
+    }
+    EXPECT_EQ(4, v.size());
+    EXPECT_EQ(4, v.capacity());     // still inline
+    EXPECT_EQ(3, v.back());
+
+    // exceeding the inline storage spills to the heap
+    for (int i = 4; i < 100; i++) {
+        v.push_back(i);
+    }
+    EXPECT_EQ(100, v.size());
+    EXPECT_GE(v.capacity(), 100);
+    for (int i = 0; i < 100; i++) {
+        EXPECT_EQ(i, v[i]);
+    }
+
+    int sum = 0;
+    for (int const i : v) {
+        sum += i;
+    }
+    EXPECT_EQ(4950, sum);
+
+    v.pop_back();
+    EXPECT_EQ(99, v.size());
+    EXPECT_EQ(98, v.back());
+
+    v.clear();
+    EXPECT_TRUE(v.empty());
+}
+
+TEST(SmallVectorTest, NonTrivialElements) {
+    SmallVector<std::shared_ptr<int>, 2> v;
+    auto p = std::make_shared<int>(42);
+    for (int i = 0; i < 8; i++) {
+        v.push_back(p);
+    }
+    EXPECT_EQ(9, p.use_count());
+    v.pop_back();
+    EXPECT_EQ(8, p.use_count());
+    v.clear();
+    EXPECT_EQ(1, p.use_count());
+}
+
+TEST(SmallVectorTest, Move) {
+    // inline -> inline
+    SmallVector<std::unique_ptr<int>, 4> a;
+    a.emplace_back(std::make_unique<int>(1));
+    a.emplace_back(std::make_unique<int>(2));
+    SmallVector<std::unique_ptr<int>, 4> b(std::move(a));
+    EXPECT_EQ(0, a.size());
+    EXPECT_EQ(2, b.size());
+    EXPECT_EQ(2, *b[1]);
+
+    // heap -> steal the storage
+    SmallVector<std::unique_ptr<int>, 2> c;
+    for (int i = 0; i < 6; i++) {
+        c.emplace_back(std::make_unique<int>(i));
+    }
+    SmallVector<std::unique_ptr<int>, 2> d(std::move(c));
+    EXPECT_EQ(0, c.size());
+    EXPECT_EQ(2, c.capacity());
+    EXPECT_EQ(6, d.size());
+    EXPECT_EQ(5, *d[5]);
+
+    SmallVector<std::unique_ptr<int>, 2> e;
+    e.emplace_back(std::make_unique<int>(9));
+    e = std::move(d);
+    EXPECT_EQ(6, e.size());
+    EXPECT_EQ(5, *e[5]);
+}
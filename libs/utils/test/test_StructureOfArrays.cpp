@@ -183,3 +183,32 @@ TEST(StructureOfArraysTest, MoveOnly) {
     EXPECT_EQ(*soa.elementAt<1>(1).get(), 2);
 }
 
+
+TEST(StructureOfArraysTest, ForEachElement) {
+    SoA soa;
+    soa.setCapacity(16);
+    soa.resize(10);
+    for (size_t i = 0; i < 10; i++) {
+        soa.elementAt<0>(i) = float(i);
+        soa.elementAt<1>(i) = double(i) * 2.0;
+    }
+
+    // only the selected arrays are passed, by reference
+    soa.forEachElement<0, 1>(2, 10, [](size_t i, float& f, double& d) {
+        EXPECT_EQ(f, float(i));
+        f += 1.0f;
+        d = double(f);
+    });
+
+    // elements outside [first, last) are untouched
+    EXPECT_EQ(soa.elementAt<0>(1), 1.0f);
+    EXPECT_EQ(soa.elementAt<1>(1), 2.0);
+    EXPECT_EQ(soa.elementAt<0>(2), 3.0f);
+    EXPECT_EQ(soa.elementAt<1>(9), 10.0);
+
+    // const version passes const references
+    SoA const& csoa = soa;
+    double sum = 0.0;
+    csoa.forEachElement<1>(0, 10, [&sum](size_t, double const& d) { sum += d; });
+    EXPECT_EQ(sum, 54.0);
+}
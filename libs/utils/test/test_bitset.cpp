@@ -205,3 +205,34 @@ TEST(BitSetTest, NotOperator) {
     EXPECT_TRUE(b3[0]);
     EXPECT_TRUE(b3[2]);
 }
+
+TEST(BitSetTest, GatherSetBits) {
+    bitset256 b;
+    b.set(1);
+    b.set(63);
+    b.set(130);
+    b.set(255);
+
+    uint8_t indices[256];
+    EXPECT_EQ(4, b.gatherSetBits(indices));
+    EXPECT_EQ(1, indices[0]);
+    EXPECT_EQ(63, indices[1]);
+    EXPECT_EQ(130, indices[2]);
+    EXPECT_EQ(255, indices[3]);
+
+    // gathering is clamped to maxCount entries
+    EXPECT_EQ(2, b.gatherSetBits(indices, 2));
+    EXPECT_EQ(1, indices[0]);
+    EXPECT_EQ(63, indices[1]);
+
+    // forEachSetBit() visits the same bits in the same order
+    size_t n = 0;
+    b.forEachSetBit([&](size_t bit) {
+        EXPECT_EQ(indices[n], bit);
+        n++;
+    });
+    EXPECT_EQ(4, n);
+
+    bitset256 empty;
+    EXPECT_EQ(0, empty.gatherSetBits(indices));
+}
@@ -19,6 +19,9 @@
 
 #include <viewer/AutomationSpec.h>
 
+#include <string>
+#include <vector>
+
 namespace filament {
 
 class ColorGrading;
@@ -82,6 +85,54 @@ public:
          * If true, the tick function writes out a settings JSON file before advancing.
          */
         bool exportSettings = false;
+
+        /**
+         * If true, each test case is run as a benchmark: automation holds every case for a
+         * fixed number of warmup frames followed by a fixed number of measured frames, records
+         * CPU and GPU frame times, and writes percentile statistics to a JSON file when the
+         * last case finishes. sleepDuration and minFrameCount are ignored in this mode.
+         */
+        bool benchmark = false;
+
+        /**
+         * Number of frames to discard at the beginning of each benchmark case, letting GPU
+         * clocks and caches settle after the settings change.
+         */
+        int benchmarkWarmupFrames = 60;
+
+        /**
+         * Number of frames measured for each benchmark case.
+         */
+        int benchmarkMeasuredFrames = 240;
+
+        /**
+         * Path of the JSON report written when the benchmark completes.
+         */
+        std::string benchmarkOutput = "benchmark.json";
+    };
+
+    /**
+     * Frame time statistics over the measured frames of one benchmark case, in milliseconds.
+     */
+    struct BenchmarkStats {
+        double minMilliseconds = 0.0;
+        double maxMilliseconds = 0.0;
+        double meanMilliseconds = 0.0;
+        double p50Milliseconds = 0.0;
+        double p95Milliseconds = 0.0;
+        double p99Milliseconds = 0.0;
+    };
+
+    /**
+     * Benchmark result for a single test case.
+     */
+    struct BenchmarkCaseResult {
+        std::string name;
+        size_t testIndex = 0;
+        size_t cpuSampleCount = 0;
+        size_t gpuSampleCount = 0;
+        BenchmarkStats cpu;
+        BenchmarkStats gpu;
     };
 
     /**
@@ -227,6 +278,23 @@ public:
     static void exportScreenshot(View* view, Renderer* renderer, std::string filename,
             bool autoclose, AutomationEngine* automationEngine);
 
+    /**
+     * Writes a machine-readable JSON report for a completed benchmark run.
+     *
+     * @param results  Per-case results, as returned by getBenchmarkResults().
+     * @param filename Desired JSON filename.
+     */
+    static void exportBenchmark(const std::vector<BenchmarkCaseResult>& results,
+            const char* filename);
+
+    /**
+     * Returns the results of all benchmark cases completed so far. Only populated when
+     * Options::benchmark is enabled.
+     */
+    const std::vector<BenchmarkCaseResult>& getBenchmarkResults() const {
+        return mBenchmarkResults;
+    }
+
     Options getOptions() const { return mOptions; }
     bool isRunning() const { return mIsRunning; }
     size_t currentTest() const { return mCurrentTest; }
@@ -255,6 +323,13 @@ private:
     bool mTerminated = false;
     bool mOwnsSettings = false;
 
+    std::vector<BenchmarkCaseResult> mBenchmarkResults;
+    std::vector<double> mBenchmarkCpuSamples;
+    std::vector<double> mBenchmarkGpuSamples;
+
+    void applyCurrentTest(Engine* engine, const ViewerContent& content);
+    void tickBenchmark(Engine* engine, const ViewerContent& content, float deltaTime);
+
 public:
     // For internal use from a screenshot callback.
     void requestClose() { mShouldClose = true; }
@@ -26,6 +26,8 @@
 #include <utils/Log.h>
 #include <utils/Path.h>
 
+#include <algorithm>
+#include <cmath>
 #include <iomanip>
 #include <fstream>
 #include <sstream>
@@ -197,32 +199,40 @@ ViewerOptions AutomationEngine::getViewerOptions() const {
     return mSettings->viewer;
 }
 
-void AutomationEngine::tick(Engine* engine, const ViewerContent& content, float deltaTime) {
-    const auto activateTest = [this, engine, content]() {
-        mElapsedTime = 0;
-        mElapsedFrames = 0;
-        mSpec->get(mCurrentTest, mSettings);
-        viewer::applySettings(engine, mSettings->view, content.view);
-        for (size_t i = 0; i < content.materialCount; i++) {
-            viewer::applySettings(engine, mSettings->material, content.materials[i]);
-        }
-        if (mOptions.verbose) {
-            utils::slog.i << "Running test " << mCurrentTest << utils::io::endl;
-        }
-    };
+void AutomationEngine::applyCurrentTest(Engine* engine, const ViewerContent& content) {
+    mElapsedTime = 0;
+    mElapsedFrames = 0;
+    mSpec->get(mCurrentTest, mSettings);
+    viewer::applySettings(engine, mSettings->view, content.view);
+    for (size_t i = 0; i < content.materialCount; i++) {
+        viewer::applySettings(engine, mSettings->material, content.materials[i]);
+    }
+    if (mOptions.verbose) {
+        utils::slog.i << "Running test " << mCurrentTest << utils::io::endl;
+    }
+}
 
+void AutomationEngine::tick(Engine* engine, const ViewerContent& content, float deltaTime) {
     if (!mIsRunning) {
         if (mRequestStart) {
             if ((mBatchModeEnabled && mBatchModeAllowed) || !mBatchModeEnabled) {
                 mIsRunning = true;
                 mRequestStart = false;
                 mCurrentTest = 0;
-                activateTest();
+                mBenchmarkResults.clear();
+                mBenchmarkCpuSamples.clear();
+                mBenchmarkGpuSamples.clear();
+                applyCurrentTest(engine, content);
             }
         }
         return;
     }
 
+    if (mOptions.benchmark) {
+        tickBenchmark(engine, content, deltaTime);
+        return;
+    }
+
     mElapsedTime += deltaTime;
     mElapsedFrames++;
 
@@ -258,7 +268,120 @@ void AutomationEngine::tick(Engine* engine, const ViewerContent& content, float
 
     // Increment the case number and apply the next round of settings.
     mCurrentTest++;
-    activateTest();
+    applyCurrentTest(engine, content);
+}
+
+static AutomationEngine::BenchmarkStats computeStats(std::vector<double>& samples) {
+    AutomationEngine::BenchmarkStats stats;
+    if (samples.empty()) {
+        return stats;
+    }
+    std::sort(samples.begin(), samples.end());
+    const size_t n = samples.size();
+    const auto percentile = [&samples, n](double p) {
+        // nearest-rank on the sorted samples
+        size_t rank = size_t(std::ceil(p * double(n)));
+        return samples[std::min(rank > 0 ? rank - 1 : 0, n - 1)];
+    };
+    double sum = 0.0;
+    for (double s : samples) {
+        sum += s;
+    }
+    stats.minMilliseconds = samples.front();
+    stats.maxMilliseconds = samples.back();
+    stats.meanMilliseconds = sum / double(n);
+    stats.p50Milliseconds = percentile(0.50);
+    stats.p95Milliseconds = percentile(0.95);
+    stats.p99Milliseconds = percentile(0.99);
+    return stats;
+}
+
+void AutomationEngine::tickBenchmark(Engine* engine, const ViewerContent& content,
+        float deltaTime) {
+    mElapsedTime += deltaTime;
+    mElapsedFrames++;
+
+    // The first benchmarkWarmupFrames are discarded so that settings changes, shader
+    // compilation and GPU clock ramping do not pollute the measurement.
+    if (mElapsedFrames > mOptions.benchmarkWarmupFrames) {
+        mBenchmarkCpuSamples.push_back(double(deltaTime) * 1000.0);
+        const auto history = content.renderer->getFrameInfoHistory(1);
+        if (!history.empty() && history[0].frameTime > 0) {
+            // GPU time measured by the backend timer queries, in ms.
+            mBenchmarkGpuSamples.push_back(double(history[0].frameTime) / 1e6);
+        }
+    }
+
+    if (mElapsedFrames < mOptions.benchmarkWarmupFrames + mOptions.benchmarkMeasuredFrames) {
+        return;
+    }
+
+    BenchmarkCaseResult result;
+    result.name = mSpec->getName(mCurrentTest);
+    result.testIndex = mCurrentTest;
+    result.cpuSampleCount = mBenchmarkCpuSamples.size();
+    result.gpuSampleCount = mBenchmarkGpuSamples.size();
+    result.cpu = computeStats(mBenchmarkCpuSamples);
+    result.gpu = computeStats(mBenchmarkGpuSamples);
+    mBenchmarkResults.push_back(result);
+    mBenchmarkCpuSamples.clear();
+    mBenchmarkGpuSamples.clear();
+
+    if (mOptions.verbose) {
+        utils::slog.i << "Benchmark case " << mCurrentTest << " (" << result.name.c_str() << "): "
+                << "cpu p50 = " << result.cpu.p50Milliseconds << " ms, "
+                << "cpu p95 = " << result.cpu.p95Milliseconds << " ms, "
+                << "gpu p50 = " << result.gpu.p50Milliseconds << " ms, "
+                << "gpu p95 = " << result.gpu.p95Milliseconds << " ms"
+                << utils::io::endl;
+    }
+
+    if (mCurrentTest == mSpec->size() - 1) {
+        exportBenchmark(mBenchmarkResults, mOptions.benchmarkOutput.c_str());
+        mIsRunning = false;
+        if (mBatchModeEnabled) {
+            mShouldClose = true;
+        }
+        return;
+    }
+
+    mCurrentTest++;
+    applyCurrentTest(engine, content);
+}
+
+void AutomationEngine::exportBenchmark(const std::vector<BenchmarkCaseResult>& results,
+        const char* filename) {
+    const auto writeStats = [](std::ostream& out, const BenchmarkStats& stats) {
+        out << "{ "
+            << "\"min\": " << stats.minMilliseconds << ", "
+            << "\"max\": " << stats.maxMilliseconds << ", "
+            << "\"mean\": " << stats.meanMilliseconds << ", "
+            << "\"p50\": " << stats.p50Milliseconds << ", "
+            << "\"p95\": " << stats.p95Milliseconds << ", "
+            << "\"p99\": " << stats.p99Milliseconds << " }";
+    };
+    std::ofstream out(filename);
+    if (!out) {
+        gStatus = "Failed to export benchmark file.";
+        return;
+    }
+    out << std::setprecision(6) << std::fixed;
+    out << "{\n  \"unit\": \"milliseconds\",\n  \"cases\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchmarkCaseResult& result = results[i];
+        out << "    {\n"
+            << "      \"name\": \"" << result.name << "\",\n"
+            << "      \"index\": " << result.testIndex << ",\n"
+            << "      \"cpuSampleCount\": " << result.cpuSampleCount << ",\n"
+            << "      \"gpuSampleCount\": " << result.gpuSampleCount << ",\n"
+            << "      \"cpu\": ";
+        writeStats(out, result.cpu);
+        out << ",\n      \"gpu\": ";
+        writeStats(out, result.gpu);
+        out << "\n    }" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+    gStatus = "Exported benchmark to '" + std::string(filename) + "'.";
 }
 
 const char* AutomationEngine::getStatusMessage() const {
@@ -58,6 +58,7 @@ struct Mesh {
 class MeshWriter {
     uint32_t mFlags;
     void optimize(Mesh& mesh);
+    void quantizePositions(Mesh& mesh, const Box& aabb);
 public:
     MeshWriter(uint32_t flags) : mFlags(flags) {}
     bool serialize(std::ostream&, Mesh& mesh);
@@ -48,6 +48,7 @@ bool g_interleaved = false;
 bool g_snormUVs = false;
 bool g_compression = false;
 bool g_ignore_uv1 = false;
+bool g_quantize_positions = false;
 
 Mesh g_mesh;
 float2 g_minUV = float2(std::numeric_limits<float>::max());
@@ -167,7 +168,10 @@ void processNode(const aiScene* scene, const aiNode* node, std::vector<Part>& me
                     if (uv0) {
                         q = mat3f::packTangentFrame({tangents[j], bitangents[j], normals[j]});
                     } else {
-                        q = quatf(0, 0, 0, 1);
+                        // No UVs means assimp couldn't compute tangents; pack the identity frame
+                        // instead of a raw quaternion so w keeps the bias away from 0 that the
+                        // shader needs to recover the reflection sign after SNORM16 quantization.
+                        q = mat3f::packTangentFrame(mat3f{});
                     }
                     color = colors ? colors[j] : float4(1.0f);
                     Vertex vertex {
@@ -271,6 +275,10 @@ static void printUsage(const char* name) {
                     "       interleaves mesh attributes\n\n"
                     "   --compress, -c\n"
                     "       enable compression\n\n"
+                    "   --quantize-positions, -q\n"
+                    "       quantize positions to SNORM16 on the mesh AABB grid and print the\n"
+                    "       maximum quantization error (the dequantization transform is stored\n"
+                    "       in the file and re-applied by MeshReader)\n\n"
                     "   --ignore-uv1, -g\n"
                     "       Ignore the second set of UV coordinates\n\n"
 
@@ -295,12 +303,13 @@ static void license() {
 }
 
 static int handleArguments(int argc, char* argv[]) {
-    static constexpr const char* OPTSTR = "hilcg";
+    static constexpr const char* OPTSTR = "hilcgq";
     static const struct option OPTIONS[] = {
             { "help",        no_argument, 0, 'h' },
             { "license",     no_argument, 0, 'l' },
             { "interleaved", no_argument, 0, 'i' },
             { "compress",    no_argument, 0, 'c' },
+            { "quantize-positions", no_argument, 0, 'q' },
             { "ignore-uv1",  no_argument, 0, 'g' },
             { 0, 0, 0, 0 }  // termination of the option list
     };
@@ -329,6 +338,9 @@ static int handleArguments(int argc, char* argv[]) {
             case 'g':
                 g_ignore_uv1 = true;
                 break;
+            case 'q':
+                g_quantize_positions = true;
+                break;
         }
     }
 
@@ -441,6 +453,9 @@ int main(int argc, char* argv[]) {
     if (g_compression) {
         flags |= filamesh::COMPRESSION;
     }
+    if (g_quantize_positions) {
+        flags |= filamesh::POSITION_SNORM16;
+    }
     MeshWriter(flags).serialize(out, g_mesh);
 
     out.flush();
@@ -16,7 +16,15 @@
 
 #include "GlslMinify.h"
 
+#include <utils/Path.h>
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <mutex>
 #include <regex>
+#include <thread>
 
 namespace glslminifier {
 
@@ -69,4 +77,79 @@ std::string minifyGlsl(const std::string& glsl, GlslMinifyOptions options) noexc
     return minified;
 }
 
+static bool runBatchJob(const GlslBatchJob& job, GlslMinifyOptions options,
+        std::mutex& errorMutex) {
+    std::ifstream inStream(job.inputPath, std::ios::binary);
+    if (!inStream) {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        std::cerr << "Unable to read " << job.inputPath << std::endl;
+        return false;
+    }
+    std::string inputStr((std::istreambuf_iterator<char>(inStream)),
+            std::istreambuf_iterator<char>());
+
+    std::string result = minifyGlsl(inputStr, options);
+
+    if (!job.lineDirectiveName.empty()) {
+        // We must check for support for the line directive, otherwise drivers may complain if they
+        // don't support it.
+        std::string lineDirective =
+                std::string("#if defined(GL_GOOGLE_cpp_style_line_directive)\n") +
+                "#line 0 \"" + job.lineDirectiveName + "\"\n" +
+                "#endif\n";
+        result.insert(0, lineDirective);
+    }
+
+    // Create the output path if it doesn't exist already. mkdirRecursive tolerates races with
+    // other workers creating the same directory.
+    const utils::Path outputDir = utils::Path(job.outputPath).getParent();
+    if (!outputDir.exists()) {
+        outputDir.mkdirRecursive();
+    }
+
+    std::ofstream outStream(job.outputPath, std::ios::binary);
+    if (!outStream) {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        std::cerr << "Unable to open " << job.outputPath << std::endl;
+        return false;
+    }
+    outStream << result;
+    return true;
+}
+
+size_t minifyGlslBatch(const std::vector<GlslBatchJob>& jobs, GlslMinifyOptions options,
+        unsigned int threadCount) noexcept {
+    if (jobs.empty()) {
+        return 0;
+    }
+
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threadCount = std::min(threadCount, (unsigned int) jobs.size());
+
+    std::atomic<size_t> nextJob(0);
+    std::atomic<size_t> failures(0);
+    std::mutex errorMutex;
+
+    auto worker = [&]() {
+        for (size_t i = nextJob.fetch_add(1); i < jobs.size(); i = nextJob.fetch_add(1)) {
+            if (!runBatchJob(jobs[i], options, errorMutex)) {
+                failures.fetch_add(1);
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(threadCount);
+    for (unsigned int i = 0; i < threadCount; i++) {
+        workers.emplace_back(worker);
+    }
+    for (auto& w: workers) {
+        w.join();
+    }
+
+    return failures.load();
+}
+
 } // namespace glslminifier
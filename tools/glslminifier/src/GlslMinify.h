@@ -14,8 +14,10 @@
  * limitations under the License.
  */
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #ifndef TNT_GLSLMINIFY_H
 #define TNT_GLSLMINIFY_H
@@ -40,6 +42,24 @@ enum GlslMinifyOptions : uint32_t {
 std::string minifyGlsl(const std::string& glsl,
         GlslMinifyOptions options = GlslMinifyOptions::ALL) noexcept;
 
+// A single file to minify as part of a batch.
+struct GlslBatchJob {
+    std::string inputPath;
+    std::string outputPath;
+    // When non-empty, a #line directive with this name is inserted at the top of the output
+    // (see the --line option).
+    std::string lineDirectiveName;
+};
+
+// Minifies a set of files within a single process, spreading the jobs over worker threads and
+// sharing the compiled regular expressions. This avoids the per-file process-spawn and regex
+// compilation overhead of invoking the tool once per shader.
+// threadCount == 0 selects the number of hardware threads. Returns the number of jobs that
+// failed; errors are reported on stderr.
+size_t minifyGlslBatch(const std::vector<GlslBatchJob>& jobs,
+        GlslMinifyOptions options = GlslMinifyOptions::ALL,
+        unsigned int threadCount = 0) noexcept;
+
 } // namespace glslminifier
 
 #endif //TNT_GLSLMINIFY_H
@@ -20,9 +20,13 @@
 
 #include <getopt/getopt.h>
 
+#include <algorithm>
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
+#include <sstream>
 #include <string>
+#include <vector>
 
 using namespace std;
 using namespace utils;
@@ -34,6 +38,9 @@ static const char* g_inputFile = "";
 GlslMinifyOptions g_optimizationLevel = GlslMinifyOptions::ALL;
 static bool g_outputLineDirectives = false;
 static std::string g_lineDirectiveName;
+static bool g_batchMode = false;
+static std::string g_batchManifest;
+static unsigned int g_jobCount = 0;
 
 static const char* USAGE = R"TXT(
 GLSLMINIFIER minifies GLSL shader code by removing comments, blank lines and indentation.
@@ -57,10 +64,18 @@ Options:
            #line 0 "foobar.h"
            #endif
        This option is meant to be used with -Onone optimization.
+   --batch, -b [manifest]
+       Minify a batch of files in a single process, spreading the work over worker threads.
+       Each line of the manifest is "<input> <output> [line directive name]"; blank lines and
+       lines starting with # are ignored. Pass - to read the manifest from stdin.
+   --jobs, -j [count]
+       Number of worker threads used in batch mode. Defaults to the number of hardware threads.
 
 Example:
     GLSLMINIFIER -o output.fs.min input.fs
     > Output file: output.fs.min
+    GLSLMINIFIER -b manifest.txt -j 8
+    > Minifies every input/output pair listed in manifest.txt using 8 threads.
 )TXT";
 
 static void printUsage(const char* name) {
@@ -85,13 +100,15 @@ static void license() {
 }
 
 static int handleArguments(int argc, char* argv[]) {
-    static constexpr const char* OPTSTR = "hLo:O:l:";
+    static constexpr const char* OPTSTR = "hLo:O:l:b:j:";
     static const struct option OPTIONS[] = {
             { "help",                 no_argument, nullptr, 'h' },
             { "license",              no_argument, nullptr, 'L' },
             { "output",         required_argument, nullptr, 'o' },
             { "optimization",   required_argument, nullptr, 'O' },
             { "line",           required_argument, nullptr, 'l' },
+            { "batch",          required_argument, nullptr, 'b' },
+            { "jobs",           required_argument, nullptr, 'j' },
             { nullptr, 0, nullptr, 0 }  // termination of the option list
     };
 
@@ -123,14 +140,61 @@ static int handleArguments(int argc, char* argv[]) {
                 g_outputLineDirectives = true;
                 g_lineDirectiveName = arg;
                 break;
+            case 'b':
+                g_batchMode = true;
+                g_batchManifest = arg;
+                break;
+            case 'j':
+                g_jobCount = (unsigned int) std::max(0, atoi(optarg));
+                break;
         }
     }
 
     return optind;
 }
 
+static int runBatchMode() {
+    istream* manifest = &cin;
+    ifstream manifestFile;
+    if (g_batchManifest != "-") {
+        manifestFile.open(g_batchManifest);
+        if (!manifestFile) {
+            cerr << "Unable to read manifest " << g_batchManifest << endl;
+            return 1;
+        }
+        manifest = &manifestFile;
+    }
+
+    std::vector<GlslBatchJob> jobs;
+    string line;
+    while (std::getline(*manifest, line)) {
+        istringstream tokens(line);
+        GlslBatchJob job;
+        if (!(tokens >> job.inputPath) || job.inputPath[0] == '#') {
+            // Skip blank lines and comments.
+            continue;
+        }
+        if (!(tokens >> job.outputPath)) {
+            cerr << "Malformed manifest line: " << line << endl;
+            return 1;
+        }
+        tokens >> job.lineDirectiveName;
+        jobs.push_back(std::move(job));
+    }
+
+    const size_t failures = minifyGlslBatch(jobs, g_optimizationLevel, g_jobCount);
+    if (failures > 0) {
+        cerr << failures << " file(s) could not be minified." << endl;
+        return 1;
+    }
+    return 0;
+}
+
 int main(int argc, char* argv[]) {
     const int optionIndex = handleArguments(argc, argv);
+    if (g_batchMode) {
+        return runBatchMode();
+    }
     const int numArgs = argc - optionIndex;
     if (numArgs < 1) {
         printUsage(argv[0]);
@@ -18,7 +18,9 @@
 
 #include "GlslMinify.h"
 
+#include <fstream>
 #include <string>
+#include <vector>
 
 using std::string;
 
@@ -124,6 +126,38 @@ TEST_F(GlslminifierTest, TrailingNewline) {
     EXPECT_EQ(minifyGlsl(glsl, GlslMinifyOptions::STRIP_INDENTATION), glsl);
 }
 
+TEST_F(GlslminifierTest, BatchMinify) {
+    const string dir = testing::TempDir();
+    const string glsl = "void main() { // comment\n    gl_FragColor = vec4(1.0);\n}\n";
+    const string expected = "void main() {\ngl_FragColor = vec4(1.0);\n}\n";
+
+    std::vector<GlslBatchJob> jobs;
+    for (int i = 0; i < 4; i++) {
+        const string input = dir + "/batch_input_" + std::to_string(i) + ".fs";
+        const string output = dir + "/batch_output_" + std::to_string(i) + ".fs.min";
+        std::ofstream out(input, std::ios::binary);
+        out << glsl;
+        jobs.push_back({ input, output, "" });
+    }
+
+    EXPECT_EQ(minifyGlslBatch(jobs, GlslMinifyOptions::ALL, 2), 0u);
+
+    for (const auto& job : jobs) {
+        std::ifstream in(job.outputPath, std::ios::binary);
+        ASSERT_TRUE(bool(in));
+        string result((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        EXPECT_EQ(result, expected);
+    }
+}
+
+TEST_F(GlslminifierTest, BatchMinifyMissingInput) {
+    const string dir = testing::TempDir();
+    std::vector<GlslBatchJob> jobs = {
+        { dir + "/does_not_exist.fs", dir + "/does_not_exist.fs.min", "" },
+    };
+    EXPECT_EQ(minifyGlslBatch(jobs, GlslMinifyOptions::ALL, 1), 1u);
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -86,6 +86,10 @@ static void usage(char* name) {
             "           directionalLighting, dynamicLighting, shadowReceiver, skinning, vsm, fog,"
             "           ssr (screen-space reflections), stereo\n"
             "       This variant filter is merged with the filter from the material, if any\n\n"
+            "   --cache-dir, -c\n"
+            "       Cache compiled material packages in the given directory.\n"
+            "       Entries are keyed by the material source, its includes and the compilation\n"
+            "       flags; a cache hit skips compilation entirely.\n\n"
             "   --version, -v\n"
             "       Print the material version number\n\n"
             "Internal use and debugging only:\n"
@@ -181,7 +185,7 @@ static void parseDefine(std::string defineString, Config::StringReplacementMap&
 }
 
 bool CommandlineConfig::parse() {
-    static constexpr const char* OPTSTR = "hLxo:f:dm:a:l:p:D:T:P:OSEr:vV:gtwF1R";
+    static constexpr const char* OPTSTR = "hLxo:f:dm:a:l:p:c:D:T:P:OSEr:vV:gtwF1R";
     static const struct option OPTIONS[] = {
             { "help",                    no_argument, nullptr, 'h' },
             { "license",                 no_argument, nullptr, 'L' },
@@ -198,6 +202,7 @@ bool CommandlineConfig::parse() {
             { "api",               required_argument, nullptr, 'a' },
             { "feature-level",     required_argument, nullptr, 'l' },
             { "no-essl1",                no_argument, nullptr, '1' },
+            { "cache-dir",         required_argument, nullptr, 'c' },
             { "define",            required_argument, nullptr, 'D' },
             { "template",          required_argument, nullptr, 'T' },
             { "material-parameter",required_argument, nullptr, 'P' },
@@ -286,6 +291,9 @@ bool CommandlineConfig::parse() {
             case '1':
                 mIncludeEssl1 = false;
                 break;
+            case 'c':
+                mCacheDirectory = arg;
+                break;
             case 'D':
                 parseDefine(arg, mDefines);
                 break;
@@ -16,17 +16,22 @@
 
 #include "MaterialCompiler.h"
 
+#include <fstream>
 #include <memory>
 #include <iostream>
+#include <sstream>
 #include <utility>
 
 #include <filamat/MaterialBuilder.h>
 
 #include <filamat/Enums.h>
 
+#include <utils/Hash.h>
 #include <utils/Log.h>
 #include <utils/JobSystem.h>
 
+#include "Includes.h"
+
 #include "DirIncluder.h"
 #include "MaterialLexeme.h"
 #include "MaterialLexer.h"
@@ -53,6 +58,62 @@ static constexpr const char* CONFIG_KEY_FRAGMENT_SHADER = "fragment";
 static constexpr const char* CONFIG_KEY_COMPUTE_SHADER = "compute";
 static constexpr const char* CONFIG_KEY_TOOL = "tool";
 
+// Flattens the material source by resolving its include directives, so that the cache key
+// covers the contents of included files, not just their names. Falls back to the raw source
+// if resolution fails; the compilation itself will then report the actual error.
+static std::string flattenMaterialSource(const char* buffer, size_t size,
+        const utils::Path& materialFilePath) {
+    DirIncluder includer;
+    includer.setIncludeDirectory(materialFilePath.getParent());
+
+    IncludeResult source {
+            .includeName = utils::CString(materialFilePath.getName().c_str()),
+            .text = utils::CString(buffer, size),
+            .name = utils::CString("")
+    };
+    if (!::filamat::resolveIncludes(source, includer, {})) {
+        return { buffer, size };
+    }
+    return { source.text.c_str(), source.text.size() };
+}
+
+// Computes the name of the cache entry for this compilation. Every input that affects the
+// generated package must contribute to the key: the material version, the resolved source
+// and each builder setting driven by the command line.
+static std::string computeCacheKey(const std::string& source, const Config& config) {
+    std::ostringstream key;
+    key << filament::MATERIAL_VERSION
+        << '/' << uint32_t(config.getPlatform())
+        << '/' << uint32_t(config.getTargetApi())
+        << '/' << uint32_t(config.getOptimizationLevel())
+        << '/' << uint32_t(config.getFeatureLevel())
+        << '/' << config.getVariantFilter()
+        << '/' << config.isDebug()
+        << '/' << config.includeEssl1()
+        << '/' << config.noSamplerValidation();
+    for (const auto& define : config.getDefines()) {
+        key << "/D" << define.first << '=' << define.second;
+    }
+    for (const auto& macro : config.getTemplateMap()) {
+        key << "/T" << macro.first << '=' << macro.second;
+    }
+    for (const auto& parameter : config.getMaterialParameters()) {
+        key << "/P" << parameter.first << '=' << parameter.second;
+    }
+    key << '/' << source;
+
+    std::string const input = key.str();
+    const uint8_t* const data = reinterpret_cast<const uint8_t*>(input.data());
+    // Two independently seeded 32-bit hashes; a single murmur is too collision-prone for
+    // content addressing.
+    uint32_t const lo = utils::hash::murmurSlow(data, input.size(), 0u);
+    uint32_t const hi = utils::hash::murmurSlow(data, input.size(), 0x9e3779b9u);
+
+    char name[32];
+    snprintf(name, sizeof(name), "%08x%08x.filamat", hi, lo);
+    return name;
+}
+
 MaterialCompiler::MaterialCompiler() {
     mConfigProcessor[CONFIG_KEY_MATERIAL] = &MaterialCompiler::processMaterial;
     mConfigProcessor[CONFIG_KEY_VERTEX_SHADER] = &MaterialCompiler::processVertexShader;
@@ -422,6 +483,25 @@ bool MaterialCompiler::run(const Config& config) {
         return false;
     }
 
+    // With all compilation inputs known, probe the on-disk cache if one was configured.
+    utils::Path cacheEntry;
+    if (!config.getCacheDirectory().empty()) {
+        std::string const source = flattenMaterialSource(buffer.get(), size, materialFilePath);
+        cacheEntry = utils::Path(config.getCacheDirectory()) + computeCacheKey(source, config);
+        if (cacheEntry.isFile()) {
+            std::ifstream in(cacheEntry.getPath(), std::ios::binary | std::ios::ate);
+            if (in) {
+                size_t const packageSize = size_t(in.tellg());
+                Package cached(packageSize);
+                in.seekg(0);
+                if (in.read(reinterpret_cast<char*>(cached.getData()), packageSize)) {
+                    MaterialBuilder::shutdown();
+                    return writePackage(cached, config);
+                }
+            }
+        }
+    }
+
     JobSystem js;
     js.adopt();
 
@@ -435,6 +515,15 @@ bool MaterialCompiler::run(const Config& config) {
         std::cerr << "Could not compile material " << input->getName() << std::endl;
         return false;
     }
+
+    if (!cacheEntry.isEmpty()) {
+        // Best effort: failing to populate the cache is not a compilation failure.
+        utils::Path(config.getCacheDirectory()).mkdirRecursive();
+        std::ofstream out(cacheEntry.getPath(), std::ios::binary | std::ios::trunc);
+        if (out) {
+            out.write(reinterpret_cast<const char*>(package.getData()), package.getSize());
+        }
+    }
     return writePackage(package, config);
 }
 
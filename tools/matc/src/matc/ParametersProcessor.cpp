@@ -1224,7 +1224,8 @@ static bool processRefractionType(MaterialBuilder& builder, const JsonishValue&
     return true;
 }
 
-static bool processVariantFilter(MaterialBuilder& builder, const JsonishValue& value) {
+static bool parseUserVariantList(const JsonishValue& value, const char* paramName,
+        filament::UserVariantFilterMask* outMask) {
     // We avoid using an initializer list for this particular map to avoid build errors that are
     // due to static initialization ordering.
     using filament::Variant;
@@ -1241,14 +1242,14 @@ static bool processVariantFilter(MaterialBuilder& builder, const JsonishValue& v
         return strToEnum;
     }();
 
-    filament::UserVariantFilterMask variantFilter = {};
+    filament::UserVariantFilterMask mask = {};
     const JsonishArray* jsonArray = value.toJsonArray();
     const auto& elements = jsonArray->getElements();
 
     for (size_t i = 0; i < elements.size(); i++) {
         auto elementValue = elements[i];
         if (elementValue->getType() != JsonishValue::Type::STRING) {
-            std::cerr << "variant_filter: array index " << i <<
+            std::cerr << paramName << ": array index " << i <<
                       " is not a STRING. found:" <<
                       JsonishValue::typeToString(elementValue->getType()) << std::endl;
             return false;
@@ -1256,17 +1257,35 @@ static bool processVariantFilter(MaterialBuilder& builder, const JsonishValue& v
 
         const std::string& s = elementValue->toJsonString()->getString();
         if (!isStringValidEnum(strToEnum, s)) {
-            std::cerr << "variant_filter: variant " << s <<
+            std::cerr << paramName << ": variant " << s <<
                       " is not a valid variant" << std::endl;
         }
 
-        variantFilter |= (uint32_t)strToEnum.at(s);
+        mask |= (uint32_t)strToEnum.at(s);
     }
 
+    *outMask = mask;
+    return true;
+}
+
+static bool processVariantFilter(MaterialBuilder& builder, const JsonishValue& value) {
+    filament::UserVariantFilterMask variantFilter = {};
+    if (!parseUserVariantList(value, "variant_filter", &variantFilter)) {
+        return false;
+    }
     builder.variantFilter(variantFilter);
     return true;
 }
 
+static bool processUsages(MaterialBuilder& builder, const JsonishValue& value) {
+    filament::UserVariantFilterMask usages = {};
+    if (!parseUserVariantList(value, "usages", &usages)) {
+        return false;
+    }
+    builder.variantUsages(usages);
+    return true;
+}
+
 ParametersProcessor::ParametersProcessor() {
     using Type = JsonishValue::Type;
     mParameters["name"]                          = { &processName, Type::STRING };
@@ -1295,6 +1314,7 @@ ParametersProcessor::ParametersProcessor() {
     mParameters["transparentShadow"]             = { &processTransparentShadow, Type::BOOL };
     mParameters["shadingModel"]                  = { &processShading, Type::STRING };
     mParameters["variantFilter"]                 = { &processVariantFilter, Type::ARRAY };
+    mParameters["usages"]                        = { &processUsages, Type::ARRAY };
     mParameters["specularAntiAliasing"]          = { &processSpecularAntiAliasing, Type::BOOL };
     mParameters["specularAntiAliasingVariance"]  = { &processSpecularAntiAliasingVariance, Type::NUMBER };
     mParameters["specularAntiAliasingThreshold"] = { &processSpecularAntiAliasingThreshold, Type::NUMBER };
@@ -57,6 +57,7 @@ static bool g_ktx1Container = false;
 static bool g_ktx2Container = false;
 static bool g_sourceIsLinear = false;
 static bool g_quietMode = false;
+static bool g_lowMem = false;
 static uint32_t g_mipLevelCount = 0;
 
 static const char* USAGE = R"TXT(
@@ -96,6 +97,10 @@ Options:
    --mip-levels=N, -m N
        specifies the number of mip levels to generate
        if 0 (default), all levels are generated
+   --low-mem, -w
+       generate each miplevel from the previous one and consume it immediately,
+       greatly reducing peak memory for very large images
+       (slightly lower quality; not supported with ktx2 output)
    --compression=COMPRESSION, -c COMPRESSION
        format specific compression:
            KTX, PNG, Radiance: Ignored
@@ -151,7 +156,7 @@ static void license() {
 }
 
 static int handleArguments(int argc, char* argv[]) {
-    static constexpr const char* OPTSTR = "hLlgpf:c:k:saqm:";
+    static constexpr const char* OPTSTR = "hLlgpf:c:k:saqm:w";
     static const struct option OPTIONS[] = {
             { "help",                 no_argument, 0, 'h' },
             { "license",              no_argument, 0, 'L' },
@@ -165,6 +170,7 @@ static int handleArguments(int argc, char* argv[]) {
             { "add-alpha",            no_argument, 0, 'a' },
             { "quiet",                no_argument, 0, 'q' },
             { "mip-levels",     required_argument, 0, 'm' },
+            { "low-mem",              no_argument, 0, 'w' },
             { 0, 0, 0, 0 }  // termination of the option list
     };
 
@@ -206,6 +212,9 @@ static int handleArguments(int argc, char* argv[]) {
             case 'q':
                 g_quietMode = true;
                 break;
+            case 'w':
+                g_lowMem = true;
+                break;
             case 'f':
                 if (arg == "png") {
                     g_format = ImageEncoder::Format::PNG;
@@ -321,10 +330,18 @@ int main(int argc, char* argv[]) {
         puts("Generating miplevels...");
     }
 
+    if (g_lowMem && g_ktx2Container) {
+        cerr << "Warning: --low-mem is not supported with ktx2 output, ignoring." << endl;
+        g_lowMem = false;
+    }
+
     uint32_t count = getMipmapCount(sourceImage);
     count = g_mipLevelCount == 0 ? count : min(g_mipLevelCount - 1, count);
-    vector<LinearImage> miplevels(count);
-    generateMipmaps(sourceImage, g_filter, miplevels.data(), count);
+    vector<LinearImage> miplevels;
+    if (!g_lowMem) {
+        miplevels.resize(count);
+        generateMipmaps(sourceImage, g_filter, miplevels.data(), count);
+    }
 
     if (g_ktx1Container) {
         if (!g_quietMode) {
@@ -334,7 +351,7 @@ int main(int argc, char* argv[]) {
         // The libimage API does not include the original image in the mip array,
         // which might make sense when generating individual files, but for a KTX
         // bundle, we want to include level 0, so add 1 to the KTX level count.
-        Ktx1Bundle container(1 + miplevels.size(), 1, false);
+        Ktx1Bundle container(1 + count, 1, false);
         auto& info = container.info();
         info = {
             .endianness = Ktx1Bundle::ENDIAN_DEFAULT,
@@ -396,8 +413,16 @@ int main(int argc, char* argv[]) {
                     container.info().glTypeSize * componentCount);
         };
         addLevel(sourceImage);
-        for (auto image : miplevels) {
-            addLevel(image);
+        if (g_lowMem) {
+            // each level is quantized into the container and its float data released before
+            // the next one is computed
+            generateMipmapsLowMem(sourceImage, g_filter,
+                    [&addLevel](LinearImage image, uint32_t) { addLevel(std::move(image)); },
+                    count);
+        } else {
+            for (auto image : miplevels) {
+                addLevel(image);
+            }
         }
         vector<uint8_t> fileContents(container.getSerializedLength());
         container.serialize(fileContents.data(), fileContents.size());
@@ -462,11 +487,11 @@ int main(int argc, char* argv[]) {
 
     char path[256];
     uint32_t mip = 1; // start at 1 because 0 is the original image
-    for (auto image : miplevels) {
+    auto writeMip = [&](LinearImage image) -> bool {
         int result = snprintf(path, sizeof(path), outputPattern.c_str(), mip++);
         if (result < 0 || result >= sizeof(path)) {
             cerr << "Output pattern is too long." << endl;
-            return 1;
+            return false;
         }
         Path(path).getParent().mkdirRecursive();
         ofstream outputStream(path, ios::binary | ios::trunc);
@@ -478,15 +503,32 @@ int main(int argc, char* argv[]) {
             }
             if (!ImageEncoder::encode(outputStream, g_format, image, g_compressionString, path)) {
                 cerr << "An error occurred while encoding the image." << endl;
-                return 1;
+                return false;
             }
             outputStream.close();
             if (!outputStream) {
                 cerr << "An error occurred while writing the output file: " << path << endl;
-                return 1;
+                return false;
+            }
+        }
+        return true;
+    };
+    bool writeSucceeded = true;
+    if (g_lowMem) {
+        // each level is written to disk and released before the next one is computed
+        generateMipmapsLowMem(sourceImage, g_filter, [&](LinearImage image, uint32_t) {
+            writeSucceeded = writeSucceeded && writeMip(std::move(image));
+        }, count);
+    } else {
+        for (auto image : miplevels) {
+            if (!(writeSucceeded = writeMip(std::move(image)))) {
+                break;
             }
         }
     }
+    if (!writeSucceeded) {
+        return 1;
+    }
 
     if (g_createGallery) {
         if (!g_quietMode) {
@@ -506,7 +548,7 @@ int main(int argc, char* argv[]) {
             return 1;
         }
         html << tag << std::endl;
-        for (auto image: miplevels) {
+        for (uint32_t i = 0; i < count; i++) {
             snprintf(path, sizeof(path), outputPattern.c_str(), mip++);
             result = snprintf(tag, sizeof(tag), pattern, path, width, height);
             if (result < 0 || result >= sizeof(tag)) {